@@ -37,6 +37,7 @@
 #include "SEGGER_RTT.h"
 #include "SEGGER_SYSVIEW.h"
 #include "SEGGER_SYSVIEW_configuration.h"
+#include "framerate_impl.h"
 #endif
 #include "LLNET_NETWORK_MEM.h"
 #ifdef VALIDATION_BUILD
@@ -310,13 +311,8 @@ int app_main(void)
 
 
 #if (defined(ENABLE_SYSTEM_VIEW)) && (1 == SEGGER_SYSVIEW_POST_MORTEM_MODE)
-	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
-	/*
-	* Magic number described in section B2.3.10 of
-	* ARM CoreSight Architecture Specification document (v3.0)
-	*/
-	DWT->LAR = 0xC5ACCE55;
-	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	/* Enable the cycles counter */
+	(void)framerate_impl_get_cycles();
 
 	xTaskCreate( xStartPostMortemAnalysis, "SV_Post_Mortem", SYSVIEW_LAUNCH_PM_TASK_STACK_SIZE, NULL, SYSVIEW_LAUNCH_PM_TASK_PRIORITY, NULL);
 #endif
@@ -496,18 +492,20 @@ static void MPU_Config (void)
   HAL_MPU_ConfigRegion(&MPU_InitStruct);
 
 #if !defined(VALIDATION_BUILD) && !defined(IPERF_BUILD)
-  if(display_stack_start < display_stack_end) {
-        /* Configure the MPU region for SDRAM address space used for display buffers (write-through, no write allocate) */
-        /* This region should always be last */
+  /* Configure the MPU regions for SDRAM address space used for display buffers (write-through, no write allocate) */
+  /* These regions should always be last: one 512KB region for the double buffering, two for the triple buffering */
+  uint32_t display_region_number = MPU_REGION_NUMBER6;
+  for(uint32_t display_region = display_stack_start; (display_region < display_stack_end) && (display_region_number <= MPU_REGION_NUMBER7); display_region += 0x80000) {
         MPU_InitStruct.AccessPermission = MPU_REGION_FULL_ACCESS;
-        MPU_InitStruct.BaseAddress = display_stack_start;
+        MPU_InitStruct.BaseAddress = display_region;
         MPU_InitStruct.Size = MPU_REGION_SIZE_512KB;
         MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
         MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
         MPU_InitStruct.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
         MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_ENABLE;
-        MPU_InitStruct.Number = MPU_REGION_NUMBER6;
+        MPU_InitStruct.Number = display_region_number;
         HAL_MPU_ConfigRegion(&MPU_InitStruct);
+        display_region_number++;
   }
 #endif
 
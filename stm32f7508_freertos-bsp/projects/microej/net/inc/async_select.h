@@ -30,6 +30,17 @@ typedef enum
   SELECT_WRITE
 }select_operation;
 
+/** @brief Fairness counters of an async_select shard (see async_select_get_shard_statistics()). */
+typedef struct
+{
+  uint32_t selects;		// select() calls of the shard task
+  uint32_t requests;	// requests added
+  uint32_t ready;		// requests done because their file descriptor was ready
+  uint32_t timeouts;	// requests done because their timeout was reached
+  uint32_t used;		// requests waiting
+  uint32_t max_used;	// highest number of requests waiting at the same time
+}async_select_shard_statistics_t;
+
 
 /**
  * @brief Executes asynchronously an I/0 operation on the given file descriptor.
@@ -86,6 +97,19 @@ void async_select_notify_closed_fd(int32_t fd);
  */
 void async_select_update_notified_requests(int32_t fd, uint8_t on_read, uint8_t on_write, uint8_t on_error);
 
+/**
+ * @brief Gets the fairness counters of an async_select shard.
+ * The file descriptors are shared out between ASYNC_SELECT_SHARD_COUNT shards, each managed by its own
+ * async_select task: comparing the counters of the shards shows how the load is balanced.
+ *
+ * @param[in] shard the index of the shard (0 to ASYNC_SELECT_SHARD_COUNT - 1).
+ * @param[out] statistics the counters to fill.
+ * @param[in] reset 1 to reset the counters (and the highest number of waiting requests); 0 otherwise.
+ *
+ * @return 0 on success, -1 if the shard does not exist.
+ */
+int32_t async_select_get_shard_statistics(int32_t shard, async_select_shard_statistics_t* statistics, uint8_t reset);
+
 #ifdef __cplusplus
 	}
 #endif
@@ -33,7 +33,7 @@
  * This value must not be changed by the user of the CCO.
  * This value must be incremented by the implementor of the CCO when a configuration define is added, deleted or modified.
  */
-#define ASYNC_SELECT_CONFIGURATION_VERSION (4)
+#define ASYNC_SELECT_CONFIGURATION_VERSION (6)
 
 
 #define ASYNC_SELECT_TIMEOUT_CACHE_SIZE LLNET_MAX_SOCKETS
@@ -57,7 +57,32 @@
 #define MAX_NB_ASYNC_SELECT (16)
 
 /**
- * @brief async_select task stack size in bytes.
+ * @brief First file descriptor indexed by the async_select component.
+ *
+ * The requests are indexed by file descriptor: only the file descriptors from ASYNC_SELECT_FD_INDEX_START
+ * to (ASYNC_SELECT_FD_INDEX_START + ASYNC_SELECT_FD_INDEX_SIZE - 1) can be used with async_select().
+ */
+#define ASYNC_SELECT_FD_INDEX_START (LLNET_SOCKFD_START_IDX)
+
+/**
+ * @brief Number of file descriptors indexed by the async_select component.
+ */
+#define ASYNC_SELECT_FD_INDEX_SIZE (LLNET_MAX_SOCKETS)
+
+/**
+ * @brief Number of async_select shards (1 to 4).
+ *
+ * The file descriptors are shared out between the shards ((fd - ASYNC_SELECT_FD_INDEX_START) modulo
+ * ASYNC_SELECT_SHARD_COUNT). Each shard has its own async_select task, with its own select() and its own
+ * notification pipe or socket, so that a busy socket only delays the notifications of its own shard.
+ * In notification socket mode, each shard uses a socket.
+ *
+ * Requires: USE_ASYNC_SELECT_THREAD
+ */
+#define ASYNC_SELECT_SHARD_COUNT (1)
+
+/**
+ * @brief async_select task stack size in bytes (for each shard).
  *
  * Requires: USE_ASYNC_SELECT_THREAD
  */
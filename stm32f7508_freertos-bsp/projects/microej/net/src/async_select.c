@@ -34,7 +34,7 @@
  * the configuration async_select_configuration.h must be updated based on the one provided
  * by the new CCO version.
  */
-#if ASYNC_SELECT_CONFIGURATION_VERSION != 4
+#if ASYNC_SELECT_CONFIGURATION_VERSION != 6
 
 	#error "Version of the configuration file async_select_configuration.h is not compatible with this implementation."
 
@@ -47,9 +47,95 @@ typedef struct async_select_Request{
 	// Absolute time for timeout in milliseconds, 0 if no timeout
 	int64_t absolute_timeout_ms;
 	select_operation operation;
+	// Scoped resource of the request (see async_select_free_used_request_by_handle())
+	uint32_t handle;
+	// Index in the timeout heap, -1 if the request is not in the heap
+	int32_t timeout_heap_index;
+	// true while the request is in the file descriptor index
+	bool used;
+	// Next request in the free FIFO or next request on the same file descriptor
 	struct async_select_Request* next;
+	// Previous request on the same file descriptor
+	struct async_select_Request* previous;
 } async_select_Request;
 
+/**
+ * @brief Bits of the request handle used for the index of the request in the pool, the
+ * other bits count the allocations of the request.
+ */
+#define ASYNC_SELECT_HANDLE_INDEX_BITS	(16)
+#define ASYNC_SELECT_HANDLE_INDEX_MASK	((1U << ASYNC_SELECT_HANDLE_INDEX_BITS) - 1U)
+
+#if MAX_NB_ASYNC_SELECT > ASYNC_SELECT_HANDLE_INDEX_MASK
+	#error "MAX_NB_ASYNC_SELECT is too high for the request handles."
+#endif
+
+/**
+ * @brief Returns true if the file descriptor can be indexed.
+ */
+#define ASYNC_SELECT_FD_IS_INDEXED(fd)	(((fd) >= ASYNC_SELECT_FD_INDEX_START) && ((fd) < (ASYNC_SELECT_FD_INDEX_START + ASYNC_SELECT_FD_INDEX_SIZE)))
+
+#if ASYNC_SELECT_SHARD_COUNT < 1 || ASYNC_SELECT_SHARD_COUNT > 4
+	#error "ASYNC_SELECT_SHARD_COUNT must be between 1 and 4."
+#endif
+
+/**
+ * @brief Returns the shard of the file descriptor (the file descriptor must be indexed).
+ */
+#define ASYNC_SELECT_FD_SHARD(fd)	(&shards[((fd) - ASYNC_SELECT_FD_INDEX_START) % ASYNC_SELECT_SHARD_COUNT])
+
+/** @brief  An async_select shard: the requests of the file descriptors managed by one async_select task */
+typedef struct async_select_Shard{
+	/**
+	 * @brief Binary min-heap of the used requests that have a timeout, ordered by absolute timeout.
+	 */
+	async_select_Request* timeout_heap[MAX_NB_ASYNC_SELECT];
+	/**
+	 * @brief Number of requests in the timeout heap.
+	 */
+	int32_t timeout_heap_size;
+	/**
+	 * @brief Fairness counters of the shard.
+	 */
+	async_select_shard_statistics_t statistics;
+
+#ifdef USE_ASYNC_SELECT_THREAD
+	/**
+	 * @brief File descriptor set of the SELECT_READ requests, updated when a request is added or removed.
+	 */
+	fd_set requests_read_fds;
+	/**
+	 * @brief File descriptor set of the SELECT_WRITE requests, updated when a request is added or removed.
+	 */
+	fd_set requests_write_fds;
+	/**
+	 * @brief Highest file descriptor of the used requests, -1 if there is no used request.
+	 */
+	int32_t max_request_fd;
+	/**
+	 * @brief File descriptor set for SELECT_READ requests (select() result).
+	 */
+	fd_set read_fds;
+	/**
+	 * @brief File descriptor set for SELECT_WRITE requests (select() result).
+	 */
+	fd_set write_fds;
+	/**
+	 * @brief Number of request file descriptors ready in read_fds and write_fds, -1 if unknown.
+	 */
+	int32_t ready_fds_count;
+	/**
+	 * @brief Used to unblock select() function call.
+	 */
+#ifdef ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
+	int8_t pipe_fds_initialized;
+	int32_t pipe_fds[2];
+#else
+	volatile int32_t notify_fd_cache;
+#endif //ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
+#endif //USE_ASYNC_SELECT_THREAD
+} async_select_Shard;
+
 
 /**
  * @brief Enter critical section for the async_select component.
@@ -76,16 +162,27 @@ extern int64_t LLMJVM_IMPL_getCurrentTime__Z(uint8_t system);
  * See implementations for descriptions.
  */
 #ifdef USE_ASYNC_SELECT_THREAD
-static void async_select_do_select(void);
-static void async_select_notify_select(void);
-static int32_t async_select_get_notify_fd(void);
+static void async_select_do_select(async_select_Shard* shard);
+static void async_select_notify_select(async_select_Shard* shard);
+static int32_t async_select_get_notify_fd(async_select_Shard* shard);
+static void async_select_update_selected_requests(async_select_Shard* shard);
 static void async_select_time_ms_to_timeval(int64_t time_ms, struct timeval* time_timeval);
 #endif //USE_ASYNC_SELECT_THREAD
 static async_select_Request* async_select_allocate_request(void);
-static async_select_Request* async_select_free_used_request(async_select_Request* request, async_select_Request* previous_request_in_used_fifo);
-static void async_select_free_used_request_by_java_thread_id(int32_t java_thread_id);
+static void async_select_free_used_request(async_select_Request* request);
+static void async_select_free_used_request_by_handle(void* resource);
 static void async_select_free_unused_request(async_select_Request* request);
 static void async_select_add_new_request(async_select_Request* request);
+static void async_select_update_fd_requests(int32_t fd, bool on_read, bool on_write, bool on_error);
+static void async_select_update_timeout_requests(async_select_Shard* shard, int64_t current_time_ms);
+static void async_select_resume_request(async_select_Request* request, bool timeout_reached);
+static void async_select_index_add(async_select_Request* request);
+static void async_select_index_remove(async_select_Request* request);
+static void async_select_timeout_heap_add(async_select_Request* request);
+static void async_select_timeout_heap_remove(async_select_Request* request);
+static void async_select_timeout_heap_sift_up(async_select_Shard* shard, int32_t index);
+static void async_select_timeout_heap_sift_down(async_select_Shard* shard, int32_t index);
+static void async_select_timeout_heap_swap(async_select_Shard* shard, int32_t index1, int32_t index2);
 void async_select_request_fifo_init(void);
 
 /**
@@ -97,34 +194,14 @@ static async_select_Request all_requests[MAX_NB_ASYNC_SELECT];
  */
 static async_select_Request* free_requests_fifo;
 /**
- * @brief Linked-list of used requests.
- */
-static async_select_Request* used_requests_fifo;
-
-#ifdef USE_ASYNC_SELECT_THREAD
-/**
- * @brief File descriptor set for SELECT_READ requests.
+ * @brief Used requests indexed by file descriptor (from ASYNC_SELECT_FD_INDEX_START). The requests on the same
+ * file descriptor are linked with their next and previous fields.
  */
-static fd_set read_fds;
+static async_select_Request* fd_requests[ASYNC_SELECT_FD_INDEX_SIZE];
 /**
- * @brief File descriptor set for SELECT_WRITE requests.
+ * @brief The shards. A file descriptor is managed by the shard ASYNC_SELECT_FD_SHARD(fd).
  */
-static fd_set write_fds;
-/**
- * @brief Used to unblock select() function call.
- */
-
-#ifdef ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
-
-static int8_t pipe_fds_initialized = 0;
-static int32_t pipe_fds[2];
-
-#else
-
-volatile static int32_t notify_fd_cache = -1;
-
-#endif //ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
-#endif //USE_ASYNC_SELECT_THREAD
+static async_select_Shard shards[ASYNC_SELECT_SHARD_COUNT];
 
 /**
  * @brief set to one once the FIFOs are initialized.
@@ -168,6 +245,11 @@ int32_t async_select(int32_t fd, select_operation operation, int64_t absolute_ti
 		return -1;
 	}
 
+	if(!ASYNC_SELECT_FD_IS_INDEXED(fd)){
+		SNI_throwNativeIOException(-1, "async_select invalid fd");
+		return -1;
+	}
+
 	async_select_Request* request = async_select_allocate_request();
 	if(request == NULL){
 		// No request available :-(
@@ -198,8 +280,8 @@ int32_t async_select(int32_t fd, select_operation operation, int64_t absolute_ti
 	//unregister the previous scoped resource if any
 	SNI_unregisterScopedResource();
 	//register a scoped resource for the created async request
-	//the java thread is used as the resource id. It will be used to lookup the associated request and then free the request
-	if(SNI_OK != SNI_registerScopedResource((void*)java_thread_id, (SNI_closeFunction)async_select_free_used_request_by_java_thread_id, NULL)){
+	//the request handle is used as the resource id. It will be used to lookup the associated request and then free the request
+	if(SNI_OK != SNI_registerScopedResource((void*)(uintptr_t)request->handle, async_select_free_used_request_by_handle, NULL)){
 		//registration fail
 		SNI_throwNativeIOException(-1, "async_select cannot register scoped resource");
 		//free the allocated request
@@ -230,13 +312,34 @@ void async_select_request_fifo_init(){
 	async_select_lock();
 	if(async_select_fifo_initialized == 0){
 		free_requests_fifo = &all_requests[0];
-		for(int i=0 ; i<MAX_NB_ASYNC_SELECT-1 ; i++){
-			all_requests[i].next = &all_requests[i+1];
+		for(int i=0 ; i<MAX_NB_ASYNC_SELECT ; i++){
+			all_requests[i].next = (i < MAX_NB_ASYNC_SELECT-1) ? &all_requests[i+1] : NULL;
+			all_requests[i].handle = (uint32_t)i;
+			all_requests[i].timeout_heap_index = -1;
+			all_requests[i].used = false;
 		}
-		all_requests[MAX_NB_ASYNC_SELECT-1].next = NULL;
 
-		// Init used requests FIFO
-		used_requests_fifo = NULL;
+		// Init used requests index
+		for(int i=0 ; i<ASYNC_SELECT_FD_INDEX_SIZE ; i++){
+			fd_requests[i] = NULL;
+		}
+
+		// Init shards
+		for(int i=0 ; i<ASYNC_SELECT_SHARD_COUNT ; i++){
+			async_select_Shard* shard = &shards[i];
+			shard->timeout_heap_size = 0;
+			memset(&shard->statistics, 0, sizeof(shard->statistics));
+#ifdef USE_ASYNC_SELECT_THREAD
+			FD_ZERO(&shard->requests_read_fds);
+			FD_ZERO(&shard->requests_write_fds);
+			shard->max_request_fd = -1;
+#ifdef ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
+			shard->pipe_fds_initialized = 0;
+#else
+			shard->notify_fd_cache = -1;
+#endif //ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
+#endif //USE_ASYNC_SELECT_THREAD
+		}
 		async_select_fifo_initialized = 1;
 	}
 	async_select_unlock();
@@ -250,41 +353,78 @@ void async_select_request_fifo_init(){
  */
 void async_select_notify_closed_fd(int32_t fd){
 #if defined(USE_ASYNC_SELECT_THREAD) && !defined(ASYNC_SELECT_CLOSE_UNBLOCK_SELECT)
-	// Search for the file descriptor in the used requests FIFO.
+	// Search for the file descriptor in the used requests index.
 	// For the requests that match the given fd, set the timeout
 	async_select_lock();
 
-	async_select_Request* request = used_requests_fifo;
-	while(request != NULL){
-		if(request->fd == fd){
+	if(ASYNC_SELECT_FD_IS_INDEXED(fd)){
+		async_select_Request* request = fd_requests[fd - ASYNC_SELECT_FD_INDEX_START];
+		while(request != NULL){
 			// Modify timeout value so that when the task will check this request
 			// it will detect a timeout.
+			async_select_timeout_heap_remove(request);
 			request->absolute_timeout_ms = 1;
+			async_select_timeout_heap_add(request);
+			request = request->next;
 		}
-		request = request->next;
 	}
 
 	async_select_unlock();
 
-	async_select_notify_select();
+	if(ASYNC_SELECT_FD_IS_INDEXED(fd)){
+		async_select_notify_select(ASYNC_SELECT_FD_SHARD(fd));
+	}
 #else
 	// If the close unblock the select we don't need to do anything here
 	(void)fd;
 #endif	// defined(USE_ASYNC_SELECT_THREAD) && !defined(ASYNC_SELECT_CLOSE_UNBLOCK_SELECT)
 }
 
+/**
+ * @brief Gets the fairness counters of an async_select shard.
+ *
+ * @param[in] shard the index of the shard (0 to ASYNC_SELECT_SHARD_COUNT - 1).
+ * @param[out] statistics the counters to fill.
+ * @param[in] reset 1 to reset the counters (and the highest number of waiting requests); 0 otherwise.
+ *
+ * @return 0 on success, -1 if the shard does not exist.
+ */
+int32_t async_select_get_shard_statistics(int32_t shard, async_select_shard_statistics_t* statistics, uint8_t reset){
+
+	if(shard < 0 || shard >= ASYNC_SELECT_SHARD_COUNT){
+		return -1;
+	}
+
+	async_select_lock();
+	async_select_shard_statistics_t* shard_statistics = &shards[shard].statistics;
+	*statistics = *shard_statistics;
+	if(reset){
+		uint32_t used = shard_statistics->used;
+		memset(shard_statistics, 0, sizeof(*shard_statistics));
+		shard_statistics->used = used;
+		shard_statistics->max_used = used;
+	}
+	async_select_unlock();
+
+	return 0;
+}
+
 #ifdef USE_ASYNC_SELECT_THREAD
 /**
- * @brief The entry point for the async_select task.
- * This function must be called from a dedicated task.
+ * @brief The entry point for the async_select task of a shard.
+ * This function must be called from a dedicated task for each shard.
+ *
+ * @param[in] args the index of the shard (0 to ASYNC_SELECT_SHARD_COUNT - 1).
  */
-void async_select_task_main(){
+void async_select_task_main(void* args){
+
+	async_select_Shard* shard = &shards[(int32_t)(uintptr_t)args];
 
 	while(true){
 		// Execute a select().
-		async_select_do_select();
+		async_select_do_select(shard);
 		// Update the received request depending on the select() results.
-		async_select_update_notified_requests(-1, 0, 0, 0);
+		async_select_update_selected_requests(shard);
 	}
 }
 
@@ -293,21 +433,21 @@ void async_select_task_main(){
  * we want to notify the async_select task that a new request has been
  * sent.
  */
-static int32_t async_select_get_notify_fd(){
+static int32_t async_select_get_notify_fd(async_select_Shard* shard){
 
 
 #ifdef ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
 
-	if(pipe_fds_initialized == 0){
-		if(pipe(pipe_fds) == -1 ||
-			LLNET_set_non_blocking(pipe_fds[0]) != 0 ||
-			LLNET_set_non_blocking(pipe_fds[1]) != 0){
+	if(shard->pipe_fds_initialized == 0){
+		if(pipe(shard->pipe_fds) == -1 ||
+			LLNET_set_non_blocking(shard->pipe_fds[0]) != 0 ||
+			LLNET_set_non_blocking(shard->pipe_fds[1]) != 0){
 			//error : can not create the pipe
 			return -1;
 		}
-		pipe_fds_initialized = 1;
+		shard->pipe_fds_initialized = 1;
 	}
-	return pipe_fds[0];
+	return shard->pipe_fds[0];
 
 #else
 
@@ -315,7 +455,7 @@ static int32_t async_select_get_notify_fd(){
 	// middle of async_select_notify_select() (i.e. notify_fd_cache has been set to -1 but socket
 	// has not been closed yet).
 	async_select_lock();
-	int32_t notify_fd = notify_fd_cache;
+	int32_t notify_fd = shard->notify_fd_cache;
 	async_select_unlock();
 	if(notify_fd != -1){
 		// fd already exists
@@ -351,7 +491,7 @@ static int32_t async_select_get_notify_fd(){
 			ret = llnet_listen(notify_fd, 1);
 			if(ret != -1){
 				// Save it for next time to avoid a new creation.
-				notify_fd_cache = notify_fd;
+				shard->notify_fd_cache = notify_fd;
 				return notify_fd;
 			}
 		}
@@ -368,24 +508,15 @@ static int32_t async_select_get_notify_fd(){
 /**
  * @brief Executes the select() operation for the file descriptors referenced by the received requests.
  */
-static void async_select_do_select(){
+static void async_select_do_select(async_select_Shard* shard){
 
-	async_select_Request* request;
-
-	int32_t notify_fd = async_select_get_notify_fd();
-	// Used to save the highest fd found in the requests.
-	int32_t max_request_fd = notify_fd;
+	int32_t notify_fd = async_select_get_notify_fd(shard);
+	// Used to save the highest fd to select.
+	int32_t max_select_fd = notify_fd;
 	// Used to save the lower timeout found in the requests.
 	int64_t min_absolute_timeout_ms = INT64_MAX;
 
-	FD_ZERO(&read_fds);
-	FD_ZERO(&write_fds);
-
-	// add the notify file descriptor to the read select list
-	if(notify_fd != -1){
-		FD_SET(notify_fd, &read_fds);
-	}
-	else {
+	if(notify_fd == -1){
 		// We were not able to create the socket to unlock the select.
 		// To prevent an infinite lock of the select we will poll for
 		// incoming messages by setting a timeout to the select.
@@ -394,30 +525,26 @@ static void async_select_do_select(){
 	}
 
 	// -----------------------------------------------------------------
-	// Add read/write waiting operations in file descriptors select list
+	// Copy read/write waiting operations in file descriptors select list
 	// -----------------------------------------------------------------
-	request = used_requests_fifo;
-	while(request != NULL){
-		int32_t request_fd = request->fd;
-		if(request_fd > max_request_fd){
-			// Save the highest fd
-			max_request_fd = request_fd;
-		}
-
-		int64_t request_absolute_timeout_ms = request->absolute_timeout_ms;
-		if(request_absolute_timeout_ms != 0 && request_absolute_timeout_ms < min_absolute_timeout_ms){
-			// Save the lowest timeout
-			min_absolute_timeout_ms = request_absolute_timeout_ms;
-		}
-
-		if(request->operation == SELECT_READ){
-			FD_SET(request_fd, &read_fds);
-		}
-		else { // operation == SELECT_WRITE
-			FD_SET(request_fd, &write_fds);
-		}
+	// The file descriptor sets of the requests are updated when a request is added or removed.
+	async_select_lock();
+	shard->read_fds = shard->requests_read_fds;
+	shard->write_fds = shard->requests_write_fds;
+	if(shard->max_request_fd > max_select_fd){
+		// Save the highest fd
+		max_select_fd = shard->max_request_fd;
+	}
+	// The root of the timeout heap has the lowest timeout
+	if(shard->timeout_heap_size > 0 && shard->timeout_heap[0]->absolute_timeout_ms < min_absolute_timeout_ms){
+		min_absolute_timeout_ms = shard->timeout_heap[0]->absolute_timeout_ms;
+	}
+	shard->statistics.selects++;
+	async_select_unlock();
 
-		request = request->next;
+	// add the notify file descriptor to the read select list
+	if(notify_fd != -1){
+		FD_SET(notify_fd, &shard->read_fds);
 	}
 
 	// -----------------------------
@@ -455,7 +582,17 @@ static void async_select_do_select(){
 	//  Do the select
 	// --------------
 	LLNET_DEBUG_TRACE("async_select: select (timeout sec=%d usec=%d)\n", (int32_t)select_timeout.tv_sec, (int32_t)select_timeout.tv_usec);
-	int32_t res = select(max_request_fd+1, &read_fds, &write_fds, NULL, select_timeout_ptr);
+	int32_t res = select(max_select_fd+1, &shard->read_fds, &shard->write_fds, NULL, select_timeout_ptr);
+
+	// The notify file descriptor is not a request file descriptor
+	shard->ready_fds_count = res;
+	if(res > 0 && notify_fd != -1 && FD_ISSET(notify_fd, &shard->read_fds)){
+		shard->ready_fds_count--;
+	}
+	else if(res < 0){
+		// Browse all the file descriptors
+		shard->ready_fds_count = -1;
+	}
 
 	if(res >= 0 || llnet_errno(-1) == EBADF){
 		//errno == EBADF when one of fd in the fdset is invalid/closed
@@ -464,7 +601,7 @@ static void async_select_do_select(){
 
 #ifdef ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
 		//check if notify_fd is selected and cleanup the pipe
-		if(FD_ISSET(notify_fd, &read_fds)){
+		if(FD_ISSET(notify_fd, &shard->read_fds)){
 			//cleanup pipe
 			char bytes[1];
 			while(read(notify_fd, (void*)bytes, 1) > 0); //non blocking pipe fds
@@ -488,114 +625,338 @@ static void async_select_do_select(){
  */
 void async_select_update_notified_requests(int32_t fd, uint8_t on_read, uint8_t on_write, uint8_t on_error){
 
-	async_select_Request* request;
-	async_select_Request* previous_request = NULL;
 	int64_t current_time_ms = async_select_get_current_time_ms();
 
 	async_select_lock();
-	// Browse all the requests to find which have been modified
-	request = used_requests_fifo;
-	while(request != NULL){
+	if(ASYNC_SELECT_FD_IS_INDEXED(fd)){
+		async_select_update_fd_requests(fd, on_read, on_write, on_error);
+	}
 
-		int32_t request_fd = request->fd;
-		bool request_timeout_reached;
+	for(int32_t i=0 ; i<ASYNC_SELECT_SHARD_COUNT ; i++){
+		async_select_update_timeout_requests(&shards[i], current_time_ms);
+	}
+	async_select_unlock();
+}
 
-		// Check if timeout has been reached.
-		if(request->absolute_timeout_ms != 0 && request->absolute_timeout_ms <= current_time_ms){
-			request_timeout_reached = true;
-		}
-		else {
-			request_timeout_reached = false;
-		}
 #ifdef USE_ASYNC_SELECT_THREAD
+/**
+ * @brief Updates the requests of the given shard depending on the select() results.
+ */
+static void async_select_update_selected_requests(async_select_Shard* shard){
 
-		(void)fd;
-		(void)on_read;
-		(void)on_write;
-		(void)on_error;
+	int64_t current_time_ms = async_select_get_current_time_ms();
 
-		if((request->operation == SELECT_READ && FD_ISSET(request_fd, &read_fds))  // data received
-		|| (request->operation == SELECT_WRITE && FD_ISSET(request_fd, &write_fds))	// or data can be sent
-#else
-		if(((request_fd == fd)
-		&& (((request->operation == SELECT_READ) && on_read) 	// data received
-		|| ((request->operation == SELECT_WRITE) && on_write) 	// or data can be sent
-		|| on_error)) 											// socket error
-#endif //USE_ASYNC_SELECT_THREAD
-		|| (request_timeout_reached) // or timeout reached
-		){
-			// Request done.
-			LLNET_DEBUG_TRACE("async_select: request done for fd=0x%X operation=%s notify thread 0x%X (%s)\n", request_fd, request->operation==SELECT_READ ? "read":"write", request->java_thread_id, request_timeout_reached==true ? "timeout":"no timeout");
-			SNI_resumeJavaThread(request->java_thread_id);
-			request = async_select_free_used_request(request, previous_request);
-			//previous_request is still the same because we have removed request from the used FIFO
-		}
-		else {
-			previous_request = request;
-			request = request->next;
+	async_select_lock();
+
+	// Browse the selected file descriptors of the shard to find the requests done
+	int32_t request_fd = ASYNC_SELECT_FD_INDEX_START + (int32_t)(shard - &shards[0]);
+	while(request_fd <= shard->max_request_fd && shard->ready_fds_count != 0){
+		bool fd_on_read = FD_ISSET(request_fd, &shard->read_fds) ? true : false;		// data received
+		bool fd_on_write = FD_ISSET(request_fd, &shard->write_fds) ? true : false;	// or data can be sent
+		if(fd_on_read || fd_on_write){
+			if(shard->ready_fds_count > 0){
+				shard->ready_fds_count -= (fd_on_read ? 1 : 0) + (fd_on_write ? 1 : 0);
+			}
+			async_select_update_fd_requests(request_fd, fd_on_read, fd_on_write, false);
 		}
+		request_fd += ASYNC_SELECT_SHARD_COUNT;
 	}
+
+	async_select_update_timeout_requests(shard, current_time_ms);
 	async_select_unlock();
 }
+#endif //USE_ASYNC_SELECT_THREAD
+
+/**
+ * @brief Resumes the requests of the given shard whose timeout has been reached, lowest timeout first.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_update_timeout_requests(async_select_Shard* shard, int64_t current_time_ms){
+
+	while(shard->timeout_heap_size > 0 && shard->timeout_heap[0]->absolute_timeout_ms <= current_time_ms){
+		async_select_resume_request(shard->timeout_heap[0], true);
+	}
+}
 
 /**
- * @brief Remove the given request from the used FIFO and put it in the free FIFO.
+ * @brief Resumes the requests on the given file descriptor that are done.
  *
  * This function is NOT thread safe.
  *
- * @return the next request in the used FIFO.
+ * @param[in] fd The file descriptor.
+ * @param[in] on_read true if the file descriptor is ready for "read" operation; false otherwise.
+ * @param[in] on_write true if the file descriptor is ready for "write" operation; false otherwise.
+ * @param[in] on_error true if an error has occurred on the file descriptor.
  */
-static async_select_Request* async_select_free_used_request(async_select_Request* request, async_select_Request* previous_request_in_used_fifo){
+static void async_select_update_fd_requests(int32_t fd, bool on_read, bool on_write, bool on_error){
 
-	async_select_Request* next_request;
+	async_select_Request* request = fd_requests[fd - ASYNC_SELECT_FD_INDEX_START];
+	while(request != NULL){
+		// request is removed from the index when it is done
+		async_select_Request* next_request = request->next;
 
-	next_request = request->next;
+		if(((request->operation == SELECT_READ) && on_read) 	// data received
+		|| ((request->operation == SELECT_WRITE) && on_write) 	// or data can be sent
+		|| on_error){ 											// socket error
+			async_select_resume_request(request, false);
+		}
 
-	// Remove the request from the used FIFO
-	if(previous_request_in_used_fifo != NULL){
-		previous_request_in_used_fifo->next = next_request;
+		request = next_request;
 	}
-	else{
-		// The request was the first in the used list
-		used_requests_fifo = next_request;
+}
+
+/**
+ * @brief Resumes the Java thread of the given request and frees the request.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_resume_request(async_select_Request* request, bool timeout_reached){
+	// Request done.
+	LLNET_DEBUG_TRACE("async_select: request done for fd=0x%X operation=%s notify thread 0x%X (%s)\n", request->fd, request->operation==SELECT_READ ? "read":"write", request->java_thread_id, timeout_reached==true ? "timeout":"no timeout");
+	SNI_resumeJavaThread(request->java_thread_id);
+
+	async_select_shard_statistics_t* statistics = &ASYNC_SELECT_FD_SHARD(request->fd)->statistics;
+	if(timeout_reached){
+		statistics->timeouts++;
 	}
+	else {
+		statistics->ready++;
+	}
+	async_select_free_used_request(request);
+}
+
+/**
+ * @brief Remove the given request from the used requests index and put it in the free FIFO.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_free_used_request(async_select_Request* request){
+
+	// Remove the request from the used requests index
+	async_select_index_remove(request);
 
 	// Add the request into the free FIFO
 	request->next = free_requests_fifo;
 	free_requests_fifo = request;
-
-	return next_request;
 }
 
 /**
- * @brief Remove the request associated with the given java thread id 
- * from the used FIFO and put it in the free FIFO.
+ * @brief Remove the request associated with the given scoped resource (request handle)
+ * from the used requests index and put it in the free FIFO.
  *
  * This function is thread safe.
  *
  */
-static void async_select_free_used_request_by_java_thread_id(int32_t java_thread_id){
+static void async_select_free_used_request_by_handle(void* resource){
+	uint32_t handle = (uint32_t)(uintptr_t)resource;
+
 	async_select_lock();
-	async_select_Request* previous_request = NULL;
-	async_select_Request* request = used_requests_fifo;
+	async_select_Request* request = &all_requests[handle & ASYNC_SELECT_HANDLE_INDEX_MASK];
 
-	// Browse all the requests to find which one is associated with the java thread id
-	while(request != NULL){
-		if(request->java_thread_id == java_thread_id){
-			//request found
-			async_select_free_used_request(request, previous_request);
-			//break here since there is no more than 1 request by java thread id
+	// The request may have been done, and even allocated again, before the scoped resource is closed:
+	// the handle changes on each allocation.
+	if(request->used && request->handle == handle){
+		async_select_free_used_request(request);
+	}
+	async_select_unlock();
+}
+
+/**
+ * @brief Add the given request in the used requests index: in the requests of its file descriptor,
+ * in the timeout heap and in the file descriptor sets.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_index_add(async_select_Request* request){
+
+	int32_t fd = request->fd;
+	async_select_Shard* shard = ASYNC_SELECT_FD_SHARD(fd);
+	async_select_Request** fd_first_request = &fd_requests[fd - ASYNC_SELECT_FD_INDEX_START];
+
+	request->previous = NULL;
+	request->next = *fd_first_request;
+	if(*fd_first_request != NULL){
+		(*fd_first_request)->previous = request;
+	}
+	*fd_first_request = request;
+	request->used = true;
+
+	shard->statistics.requests++;
+	shard->statistics.used++;
+	if(shard->statistics.used > shard->statistics.max_used){
+		shard->statistics.max_used = shard->statistics.used;
+	}
+
+	if(request->absolute_timeout_ms != 0){
+		async_select_timeout_heap_add(request);
+	}
+
+#ifdef USE_ASYNC_SELECT_THREAD
+	if(request->operation == SELECT_READ){
+		FD_SET(fd, &shard->requests_read_fds);
+	}
+	else { // operation == SELECT_WRITE
+		FD_SET(fd, &shard->requests_write_fds);
+	}
+
+	if(fd > shard->max_request_fd){
+		// Save the highest fd
+		shard->max_request_fd = fd;
+	}
+#endif //USE_ASYNC_SELECT_THREAD
+}
+
+/**
+ * @brief Remove the given request from the used requests index.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_index_remove(async_select_Request* request){
+
+	int32_t fd = request->fd;
+	async_select_Shard* shard = ASYNC_SELECT_FD_SHARD(fd);
+
+	if(request->previous != NULL){
+		request->previous->next = request->next;
+	}
+	else {
+		// The request was the first of its file descriptor
+		fd_requests[fd - ASYNC_SELECT_FD_INDEX_START] = request->next;
+	}
+	if(request->next != NULL){
+		request->next->previous = request->previous;
+	}
+	request->used = false;
+	shard->statistics.used--;
+
+	async_select_timeout_heap_remove(request);
+
+#ifdef USE_ASYNC_SELECT_THREAD
+	// Keep the file descriptor in its set if another request waits for the same operation
+	bool same_operation = false;
+	async_select_Request* fd_request = fd_requests[fd - ASYNC_SELECT_FD_INDEX_START];
+	while(fd_request != NULL && !same_operation){
+		same_operation = (fd_request->operation == request->operation);
+		fd_request = fd_request->next;
+	}
+
+	if(!same_operation){
+		if(request->operation == SELECT_READ){
+			FD_CLR(fd, &shard->requests_read_fds);
+		}
+		else { // operation == SELECT_WRITE
+			FD_CLR(fd, &shard->requests_write_fds);
+		}
+	}
+
+	if(fd == shard->max_request_fd){
+		// Search the new highest fd of the shard
+		while(shard->max_request_fd >= ASYNC_SELECT_FD_INDEX_START && fd_requests[shard->max_request_fd - ASYNC_SELECT_FD_INDEX_START] == NULL){
+			shard->max_request_fd -= ASYNC_SELECT_SHARD_COUNT;
+		}
+		if(shard->max_request_fd < ASYNC_SELECT_FD_INDEX_START){
+			shard->max_request_fd = -1;
+		}
+	}
+#endif //USE_ASYNC_SELECT_THREAD
+}
+
+/**
+ * @brief Add the given request in the timeout heap.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_timeout_heap_add(async_select_Request* request){
+
+	async_select_Shard* shard = ASYNC_SELECT_FD_SHARD(request->fd);
+	int32_t index = shard->timeout_heap_size;
+
+	shard->timeout_heap_size++;
+	shard->timeout_heap[index] = request;
+	request->timeout_heap_index = index;
+	async_select_timeout_heap_sift_up(shard, index);
+}
+
+/**
+ * @brief Remove the given request from the timeout heap, if it is in the heap.
+ *
+ * This function is NOT thread safe.
+ */
+static void async_select_timeout_heap_remove(async_select_Request* request){
+
+	async_select_Shard* shard = ASYNC_SELECT_FD_SHARD(request->fd);
+	int32_t index = request->timeout_heap_index;
+
+	if(index >= 0){
+		request->timeout_heap_index = -1;
+		shard->timeout_heap_size--;
+
+		if(index != shard->timeout_heap_size){
+			// Move the last request of the heap in place of the removed one
+			shard->timeout_heap[index] = shard->timeout_heap[shard->timeout_heap_size];
+			shard->timeout_heap[index]->timeout_heap_index = index;
+			async_select_timeout_heap_sift_down(shard, index);
+			async_select_timeout_heap_sift_up(shard, index);
+		}
+	}
+}
+
+/**
+ * @brief Move up the request at the given index of the timeout heap until its parent has a lower timeout.
+ */
+static void async_select_timeout_heap_sift_up(async_select_Shard* shard, int32_t index){
+
+	while(index > 0){
+		int32_t parent = (index - 1) / 2;
+		if(shard->timeout_heap[index]->absolute_timeout_ms >= shard->timeout_heap[parent]->absolute_timeout_ms){
 			break;
-		}else{
-			previous_request = request;
-			request = request->next;
 		}
+		async_select_timeout_heap_swap(shard, index, parent);
+		index = parent;
 	}
-	async_select_unlock();
 }
+
+/**
+ * @brief Move down the request at the given index of the timeout heap until its children have a higher timeout.
+ */
+static void async_select_timeout_heap_sift_down(async_select_Shard* shard, int32_t index){
+
+	while(true){
+		int32_t lowest = index;
+		int32_t left = (2 * index) + 1;
+		int32_t right = left + 1;
+
+		if(left < shard->timeout_heap_size && shard->timeout_heap[left]->absolute_timeout_ms < shard->timeout_heap[lowest]->absolute_timeout_ms){
+			lowest = left;
+		}
+		if(right < shard->timeout_heap_size && shard->timeout_heap[right]->absolute_timeout_ms < shard->timeout_heap[lowest]->absolute_timeout_ms){
+			lowest = right;
+		}
+		if(lowest == index){
+			break;
+		}
+		async_select_timeout_heap_swap(shard, index, lowest);
+		index = lowest;
+	}
+}
+
+/**
+ * @brief Swap two requests of the timeout heap.
+ */
+static void async_select_timeout_heap_swap(async_select_Shard* shard, int32_t index1, int32_t index2){
+
+	async_select_Request* request = shard->timeout_heap[index1];
+
+	shard->timeout_heap[index1] = shard->timeout_heap[index2];
+	shard->timeout_heap[index1]->timeout_heap_index = index1;
+	shard->timeout_heap[index2] = request;
+	request->timeout_heap_index = index2;
+}
+
 /**
  * @brief Put the given request in the free FIFO.
- * The request must not be in the used FIFO.
+ * The request must not be in the used requests index.
  *
  * This function is thread safe.
  */
@@ -616,21 +977,20 @@ static void async_select_free_unused_request(async_select_Request* request){
 static void async_select_add_new_request(async_select_Request* request){
 
 	async_select_lock();
-	// Add the request in the used FIFO
-	request->next = used_requests_fifo;
-	used_requests_fifo = request;
+	// Add the request in the used requests index
+	async_select_index_add(request);
 	async_select_unlock();
         
 #ifdef USE_ASYNC_SELECT_THREAD
-	// Notify the async_select task
-	async_select_notify_select();
+	// Notify the async_select task of the request
+	async_select_notify_select(ASYNC_SELECT_FD_SHARD(request->fd));
 #endif //USE_ASYNC_SELECT_THREAD
 }
 
 /**
  * @brief Find a free request and returns it.
- * The returned request is not put it in the used requests FIFO.
- * It must be either put in the used requests FIFO using async_select_send_new_request()
+ * The returned request is not put it in the used requests index.
+ * It must be either put in the used requests index using async_select_add_new_request()
  * or put back in the free requests FIFO on error using async_select_free_unused_request().
  *
  * This function is thread safe.
@@ -645,6 +1005,8 @@ static async_select_Request* async_select_allocate_request(){
 	if(new_request != NULL){
 		// Remove the request from the free FIFO
 		free_requests_fifo = new_request->next;
+		// New handle: the scoped resource of a previous allocation no longer matches this request
+		new_request->handle += (1U << ASYNC_SELECT_HANDLE_INDEX_BITS);
 	}
 	// else: no request available
 
@@ -659,17 +1021,17 @@ static async_select_Request* async_select_allocate_request(){
  *
  * @return 0 on success, a negative value on error.
  */
-static void async_select_notify_select(){
+static void async_select_notify_select(async_select_Shard* shard){
 
 	int32_t res = 0;
 	int32_t notify_fd;
 
 #ifdef ASYNC_SELECT_USE_PIPE_FOR_NOTIFICATION
 
-	if(pipe_fds_initialized == 1){
+	if(shard->pipe_fds_initialized == 1){
 		//Write through the pipe to cancel the current (or the next) blocking select operation.
 		char bytes[1] = {1};
-		notify_fd = pipe_fds[1];
+		notify_fd = shard->pipe_fds[1];
 		res = write(notify_fd, (void*)bytes, 1); //pipe_fds[1] refers to the write end of the pipe.
 	}
 	else {
@@ -680,14 +1042,14 @@ static void async_select_notify_select(){
 
 	async_select_lock();
 
-	notify_fd = notify_fd_cache;
+	notify_fd = shard->notify_fd_cache;
 	if(notify_fd != -1){
 		// async_select task is blocked on select operation. Call
 		// close function on notify_fd socket to unblock the select.
 		// WARNING: these two operations must be atomic because we don't want
 		// the async_selec task to create a new socket while we have not closed
 		// this one.
-		notify_fd_cache = -1;
+		shard->notify_fd_cache = -1;
 		res = llnet_close(notify_fd);
 	}
 	// else:
@@ -31,17 +31,28 @@ extern void async_select_request_fifo_init(void);
 
 #ifdef USE_ASYNC_SELECT_THREAD
 /**
- * @brief The entry point for the async_select task.
- * This function must be called from a dedicated task.
+ * @brief The entry point for the async_select task of a shard.
+ * This function must be called from a dedicated task for each shard.
+ *
+ * @param[in] args the index of the shard (0 to ASYNC_SELECT_SHARD_COUNT - 1).
  */
-extern void async_select_task_main(void);
+extern void async_select_task_main(void* args);
 
-static int32_t async_select_start_task(void);
+static int32_t async_select_start_task(int32_t shard, OSAL_task_stack_t stack);
 
 /**
- * @brief Stack of the async_select task.
+ * @brief Stacks of the async_select tasks (one per shard).
  */
 OSAL_task_stack_declare(async_select_task_stack, ASYNC_SELECT_TASK_STACK_SIZE);
+#if ASYNC_SELECT_SHARD_COUNT > 1
+OSAL_task_stack_declare(async_select_task_stack_1, ASYNC_SELECT_TASK_STACK_SIZE);
+#endif
+#if ASYNC_SELECT_SHARD_COUNT > 2
+OSAL_task_stack_declare(async_select_task_stack_2, ASYNC_SELECT_TASK_STACK_SIZE);
+#endif
+#if ASYNC_SELECT_SHARD_COUNT > 3
+OSAL_task_stack_declare(async_select_task_stack_3, ASYNC_SELECT_TASK_STACK_SIZE);
+#endif
 #endif //USE_ASYNC_SELECT_THREAD
 
 /*
@@ -51,9 +62,9 @@ void async_select_lock(void);
 void async_select_unlock(void);
 
 /**
- * @brief async_select OS task.
+ * @brief async_select OS tasks (one per shard).
  */
-static OSAL_task_handle_t async_select_task;
+static OSAL_task_handle_t async_select_task[ASYNC_SELECT_SHARD_COUNT];
 /**
  * @brief Mutex used for critical sections.
  */
@@ -74,22 +85,37 @@ int32_t async_select_init(){
 	async_select_request_fifo_init();
 
 #ifdef USE_ASYNC_SELECT_THREAD
-	//start async select task
-	if(async_select_start_task() != 0){
+	//start async select tasks
+	if(async_select_start_task(0, async_select_task_stack) != 0){
 		return -1;
 	}
+#if ASYNC_SELECT_SHARD_COUNT > 1
+	if(async_select_start_task(1, async_select_task_stack_1) != 0){
+		return -1;
+	}
+#endif
+#if ASYNC_SELECT_SHARD_COUNT > 2
+	if(async_select_start_task(2, async_select_task_stack_2) != 0){
+		return -1;
+	}
+#endif
+#if ASYNC_SELECT_SHARD_COUNT > 3
+	if(async_select_start_task(3, async_select_task_stack_3) != 0){
+		return -1;
+	}
+#endif
 #endif //USE_ASYNC_SELECT_THREAD
 	return 0;
 }
 
 #ifdef USE_ASYNC_SELECT_THREAD
 /**
- * @brief Start RTOS task and init RTOS specific structures.
+ * @brief Start the RTOS task of a shard and init RTOS specific structures.
  */
-static int32_t async_select_start_task(){
+static int32_t async_select_start_task(int32_t shard, OSAL_task_stack_t stack){
 	OSAL_status_t status;
 	
-	status = OSAL_task_create((OSAL_task_entry_point_t)async_select_task_main, ASYNC_SELECT_TASK_NAME, async_select_task_stack, ASYNC_SELECT_TASK_PRIORITY, NULL, &async_select_task);
+	status = OSAL_task_create((OSAL_task_entry_point_t)async_select_task_main, ASYNC_SELECT_TASK_NAME, stack, ASYNC_SELECT_TASK_PRIORITY, (void*)(uintptr_t)shard, &async_select_task[shard]);
 
 	if(status == OSAL_OK){
 		return 0;
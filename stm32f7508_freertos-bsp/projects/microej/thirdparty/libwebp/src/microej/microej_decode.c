@@ -1,8 +1,217 @@
-// Copyright 2021-2022 MicroEJ Corp. All rights reserved.
+// Copyright 2021-2024 MicroEJ Corp. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be found with this software.
 
 #include "src/microej/microej_decode.h"
 #include "src/webp/decode.h"
+#include "src/dsp/dsp.h"
+#include "src/utils/utils.h"
+
+// -----------------------------------------------------------------------------
+// 16-bit formats
+
+#ifdef MICROEJ_DECODE_WEBP_DITHERING
+// 4x4 Bayer matrix: thresholds from 0 to 15
+static const uint8_t kBayer4x4[4][4] = {
+	{  0,  8,  2, 10 },
+	{ 12,  4, 14,  6 },
+	{  3, 11,  1,  9 },
+	{ 15,  7, 13,  5 },
+};
+
+// Adds a part of the quantization step (1 << bits_lost) to the component according to
+// the pixel position before dropping the bits_lost lowest bits.
+static inline uint32_t Dither(uint32_t value, uint32_t threshold, uint32_t bits_lost) {
+	uint32_t v = value + ((threshold << bits_lost) >> 4);
+	return (v > 255u) ? 255u : v;
+}
+#endif
+
+// Converts a row of BGRA pixels (MODE_BGRA) in a MicroUI 16-bit format.
+static void ConvertRow(const uint8_t* bgra, uint16_t* dst, int width, int y, MICROUI_ImageFormat format) {
+	for (int x = 0; x < width; x++) {
+		uint32_t b = bgra[0];
+		uint32_t g = bgra[1];
+		uint32_t r = bgra[2];
+		uint32_t a = bgra[3];
+		bgra += 4;
+
+#ifdef MICROEJ_DECODE_WEBP_DITHERING
+		const uint32_t threshold = kBayer4x4[y & 3][x & 3];
+		if (MICROUI_IMAGE_FORMAT_RGB565 == format) {
+			r = Dither(r, threshold, 3);
+			g = Dither(g, threshold, 2);
+			b = Dither(b, threshold, 3);
+		}
+		else if (MICROUI_IMAGE_FORMAT_ARGB4444 == format) {
+			r = Dither(r, threshold, 4);
+			g = Dither(g, threshold, 4);
+			b = Dither(b, threshold, 4);
+			a = Dither(a, threshold, 4);
+		}
+		else {
+			// ARGB1555: the alpha is not dithered (one bit)
+			r = Dither(r, threshold, 3);
+			g = Dither(g, threshold, 3);
+			b = Dither(b, threshold, 3);
+		}
+#else
+		(void)y;
+#endif
+
+		uint32_t pixel;
+		if (MICROUI_IMAGE_FORMAT_RGB565 == format) {
+			pixel = ((r & 0xf8u) << 8) | ((g & 0xfcu) << 3) | (b >> 3);
+		}
+		else if (MICROUI_IMAGE_FORMAT_ARGB4444 == format) {
+			pixel = ((a & 0xf0u) << 8) | ((r & 0xf0u) << 4) | (g & 0xf0u) | (b >> 4);
+		}
+		else {
+			pixel = ((a >= 0x80u) ? 0x8000u : 0u) | ((r & 0xf8u) << 7) | ((g & 0xf8u) << 2) | (b >> 3);
+		}
+		*dst++ = (uint16_t)pixel;
+	}
+}
+
+// Converts in place the 16-bit pixels written by libwebp (MODE_RGB_565 or
+// MODE_RGBA_4444) in the MicroUI format (RGB565 or ARGB4444, native endianness).
+static void FixRows(uint8_t* buffer, uint32_t stride, int width, int height, MICROUI_ImageFormat format) {
+	for (int y = 0; y < height; y++) {
+		uint8_t* src = buffer + ((uint32_t)y * stride);
+		uint16_t* dst = (uint16_t*)src;
+		for (int x = 0; x < width; x++) {
+#if (WEBP_SWAP_16BIT_CSP == 1)
+			const uint32_t first = src[1];
+			const uint32_t second = src[0];
+#else
+			const uint32_t first = src[0];
+			const uint32_t second = src[1];
+#endif
+			src += 2;
+			if (MICROUI_IMAGE_FORMAT_RGB565 == format) {
+				// first: RRRRRGGG, second: GGGBBBBB
+				*dst++ = (uint16_t)((first << 8) | second);
+			}
+			else {
+				// first: RRRRGGGG, second: BBBBAAAA
+				*dst++ = (uint16_t)(((second & 0xfu) << 12) | (first << 4) | (second >> 4));
+			}
+		}
+	}
+}
+
+// Decodes the image in the given buffer.
+static int DecodeInto(uint8_t* addr, uint32_t length, WebPDecoderConfig* config, WEBP_CSP_MODE mode, uint8_t* buffer, uint32_t stride, uint32_t size) {
+	config->output.colorspace = mode;
+	config->output.is_external_memory = 1;
+	config->output.u.RGBA.rgba = buffer;
+	config->output.u.RGBA.stride = (int)stride;
+	config->output.u.RGBA.size = size;
+	return VP8_STATUS_OK == WebPDecode(addr, length, config);
+}
+
+// Gets the MicroUI format of the decoded image.
+static MICROUI_ImageFormat SelectFormat(MICROUI_ImageFormat expectedFormat, const WebPBitstreamFeatures* bitstream, bool* isFullyOpaque) {
+	MICROUI_ImageFormat format;
+	switch(expectedFormat) {
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		// the alpha channel (if any) is dropped
+		format = MICROUI_IMAGE_FORMAT_RGB565;
+		*isFullyOpaque = true;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+		format = expectedFormat;
+		*isFullyOpaque = !(bitstream->has_alpha);
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		// requested format: the 24-bit colors are kept
+		format = MICROUI_IMAGE_FORMAT_ARGB8888;
+		*isFullyOpaque = !(bitstream->has_alpha);
+		break;
+	default:
+#ifdef MICROEJ_DECODE_WEBP_OPAQUE_RGB565
+		// opaque image: use the display format (half the size of ARGB8888)
+		format = bitstream->has_alpha ? MICROUI_IMAGE_FORMAT_ARGB8888 : MICROUI_IMAGE_FORMAT_RGB565;
+#else
+		format = MICROUI_IMAGE_FORMAT_ARGB8888;
+#endif
+		*isFullyOpaque = !(bitstream->has_alpha);
+		break;
+	}
+	return format;
+}
+
+// Tells whether libwebp can write the pixels straight into the image (the 16-bit
+// pixels are fixed in place, see FixRows()) or whether the image has to be decoded in
+// a temporary BGRA buffer and converted (dithering or format not supported by libwebp).
+static bool IsDirect(MICROUI_ImageFormat format) {
+#ifdef MICROEJ_DECODE_WEBP_DITHERING
+	return MICROUI_IMAGE_FORMAT_ARGB8888 == format;
+#else
+	return MICROUI_IMAGE_FORMAT_ARGB1555 != format;
+#endif
+}
+
+// Gets the libwebp mode to decode straight into the image.
+static WEBP_CSP_MODE GetDirectMode(MICROUI_ImageFormat format) {
+	WEBP_CSP_MODE mode;
+	if (MICROUI_IMAGE_FORMAT_RGB565 == format) {
+		mode = MODE_RGB_565;
+	}
+	else if (MICROUI_IMAGE_FORMAT_ARGB4444 == format) {
+		mode = MODE_RGBA_4444;
+	}
+	else {
+		mode = MODE_BGRA;
+	}
+	return mode;
+}
+
+// Converts the rows [first, last[ decoded by libwebp in the MicroUI format.
+static void FinishRows(MICROUI_Image* data, const uint8_t* bgra, int first, int last) {
+	uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(data);
+	const uint32_t stride = LLUI_DISPLAY_getStrideInBytes(data);
+	const MICROUI_ImageFormat format = (MICROUI_ImageFormat)data->format;
+
+	if (NULL != bgra) {
+		const uint32_t bgra_stride = (uint32_t)data->width * 4u;
+		for (int y = first; y < last; y++) {
+			ConvertRow(bgra + ((uint32_t)y * bgra_stride), (uint16_t*)(buffer + ((uint32_t)y * stride)), data->width, y, format);
+		}
+	}
+	else if (MICROUI_IMAGE_FORMAT_ARGB8888 != format) {
+		FixRows(buffer + ((uint32_t)first * stride), stride, data->width, last - first, format);
+	}
+	else {
+		// nothing to do: libwebp has written the final pixels
+	}
+}
+
+// Decodes the image in BGRA in a temporary buffer (in the images heap) and converts it
+// in the MicroUI 16-bit format.
+static LLUI_DISPLAY_Status DecodeAndConvert(uint8_t* addr, uint32_t length, WebPDecoderConfig* config, MICROUI_Image* data) {
+	LLUI_DISPLAY_Status ret;
+	const int width = data->width;
+	const int height = data->height;
+	const uint32_t bgra_stride = (uint32_t)width * 4u;
+	uint8_t* bgra = (uint8_t*)WebPSafeMalloc((uint64_t)height, bgra_stride);
+
+	if (NULL == bgra) {
+		ret = LLUI_DISPLAY_OUT_OF_MEMORY;
+	}
+	else {
+		if (!DecodeInto(addr, length, config, MODE_BGRA, bgra, bgra_stride, bgra_stride * (uint32_t)height)) {
+			ret = LLUI_DISPLAY_NOK;
+		}
+		else {
+			FinishRows(data, bgra, 0, height);
+			ret = LLUI_DISPLAY_OK;
+		}
+		WebPSafeFree(bgra);
+	}
+	return ret;
+}
 
 // -----------------------------------------------------------------------------
 
@@ -25,48 +234,201 @@ LLUI_DISPLAY_Status MICROEJ_DECODE_webp(uint8_t* addr, uint32_t length, MICROUI_
 		}
 		else {
 
-			WEBP_CSP_MODE format;
-			switch(expectedFormat) {
-			default:
-			case MICROUI_IMAGE_FORMAT_ARGB8888:
-			case MICROUI_IMAGE_FORMAT_ARGB1555:
-			case MICROUI_IMAGE_FORMAT_ARGB4444: // XXX to check with MODE_RGBA_4444
-			case MICROUI_IMAGE_FORMAT_RGB888:
-			case MICROUI_IMAGE_FORMAT_A8:
-				format = MODE_BGRA;
-				expectedFormat = MICROUI_IMAGE_FORMAT_ARGB8888;
-				*isFullyOpaque = !(bitstream->has_alpha);
-				break;
-				// not functional yet
-				//	case MICROUI_IMAGE_FORMAT_RGB565:
-				//		format = MODE_RGB_565;
-				//		*isFullyOpaque = true;
-				// break;
-			}
+			MICROUI_ImageFormat format = SelectFormat(expectedFormat, bitstream, isFullyOpaque);
 
 			// fill image data
 			data->width = bitstream->width;
 			data->height = bitstream->height;
-			data->format = expectedFormat;
+			data->format = format;
 
 			// allocate space in images heap
 			if (!LLUI_DISPLAY_allocateImageBuffer(data, 0)) {
 				ret = LLUI_DISPLAY_OUT_OF_MEMORY;
 			}
-			else {
-
-				uint8_t* ret_addr;
-				if (MODE_RGB_565 == format)	{
-					// not functional yet
-					ret_addr = WebPDecodeBGRInto(addr, length, LLUI_DISPLAY_getBufferAddress(data), LLUI_DISPLAY_getStrideInBytes(data) * data->height, LLUI_DISPLAY_getStrideInBytes(data));
+			else if (IsDirect(format)) {
+				// libwebp writes the pixels straight into the image
+				uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(data);
+				uint32_t stride = LLUI_DISPLAY_getStrideInBytes(data);
+				if (DecodeInto(addr, length, &config, GetDirectMode(format), buffer, stride, stride * data->height)) {
+					FinishRows(data, NULL, 0, data->height);
+					ret = LLUI_DISPLAY_OK;
 				}
 				else {
-					ret_addr = WebPDecodeBGRAInto(addr, length, LLUI_DISPLAY_getBufferAddress(data), LLUI_DISPLAY_getStrideInBytes(data) * data->height, LLUI_DISPLAY_getStrideInBytes(data));
+					ret = LLUI_DISPLAY_NOK;
 				}
+			}
+			else {
+				ret = DecodeAndConvert(addr, length, &config, data);
+			}
+		}
+	}
+	return ret;
+}
+
+// -----------------------------------------------------------------------------
+// Streaming decoder
 
-				ret = ret_addr != LLUI_DISPLAY_getBufferAddress(data) ? LLUI_DISPLAY_NOK : LLUI_DISPLAY_OK;
+// Creates the incremental decoder once the header has been received.
+static MICROEJ_DECODE_webp_status StreamCreateDecoder(MICROEJ_DECODE_webp_stream* stream) {
+	MICROEJ_DECODE_webp_status ret = MICROEJ_DECODE_WEBP_ERROR;
+	WebPBitstreamFeatures* const bitstream = &stream->config.input;
+	MICROUI_Image* data = stream->data;
+
+	if (!bitstream->has_animation) {
+		MICROUI_ImageFormat format = SelectFormat(stream->expected_format, bitstream, &stream->is_fully_opaque);
+		data->width = bitstream->width;
+		data->height = bitstream->height;
+		data->format = format;
+
+		if (!LLUI_DISPLAY_allocateImageBuffer(data, 0)) {
+			ret = MICROEJ_DECODE_WEBP_OUT_OF_MEMORY;
+		}
+		else {
+			stream->allocated = true;
+
+			uint8_t* buffer;
+			uint32_t stride;
+			WEBP_CSP_MODE mode;
+			if (IsDirect(format)) {
+				buffer = LLUI_DISPLAY_getBufferAddress(data);
+				stride = LLUI_DISPLAY_getStrideInBytes(data);
+				mode = GetDirectMode(format);
+			}
+			else {
+				stride = (uint32_t)data->width * 4u;
+				stream->bgra = (uint8_t*)WebPSafeMalloc((uint64_t)data->height, stride);
+				buffer = stream->bgra;
+				mode = MODE_BGRA;
 			}
+
+			if (NULL != buffer) {
+				stream->config.output.colorspace = mode;
+				stream->config.output.is_external_memory = 1;
+				stream->config.output.u.RGBA.rgba = buffer;
+				stream->config.output.u.RGBA.stride = (int)stride;
+				stream->config.output.u.RGBA.size = stride * data->height;
+				stream->idec = WebPIDecode(NULL, 0, &stream->config);
+			}
+			ret = (NULL == stream->idec) ? MICROEJ_DECODE_WEBP_OUT_OF_MEMORY : MICROEJ_DECODE_WEBP_SUSPENDED;
+		}
+	}
+	return ret;
+}
+
+// Gives the data to the incremental decoder and finishes the new decoded rows.
+static MICROEJ_DECODE_webp_status StreamDecode(MICROEJ_DECODE_webp_stream* stream, const uint8_t* chunk, uint32_t length) {
+	MICROEJ_DECODE_webp_status ret;
+	VP8StatusCode status = WebPIAppend(stream->idec, chunk, length);
+
+	if ((VP8_STATUS_OK == status) || (VP8_STATUS_SUSPENDED == status)) {
+		int last_y = 0;
+		(void)WebPIDecGetRGB(stream->idec, &last_y, NULL, NULL, NULL);
+		if (last_y > (int)stream->rows) {
+			FinishRows(stream->data, stream->bgra, (int)stream->rows, last_y);
+			stream->rows = (uint32_t)last_y;
 		}
+		ret = (VP8_STATUS_OK == status) ? MICROEJ_DECODE_WEBP_DONE : MICROEJ_DECODE_WEBP_SUSPENDED;
+	}
+	else if (VP8_STATUS_OUT_OF_MEMORY == status) {
+		ret = MICROEJ_DECODE_WEBP_OUT_OF_MEMORY;
+	}
+	else {
+		ret = MICROEJ_DECODE_WEBP_ERROR;
+	}
+	return ret;
+}
+
+void MICROEJ_DECODE_webp_stream_start(MICROEJ_DECODE_webp_stream* stream, MICROUI_ImageFormat expectedFormat, MICROUI_Image* data) {
+	memset(stream, 0, sizeof(*stream));
+	stream->expected_format = expectedFormat;
+	stream->data = data;
+	stream->status = WebPInitDecoderConfig(&stream->config) ? MICROEJ_DECODE_WEBP_SUSPENDED : MICROEJ_DECODE_WEBP_ERROR;
+}
+
+MICROEJ_DECODE_webp_status MICROEJ_DECODE_webp_stream_append(MICROEJ_DECODE_webp_stream* stream, const uint8_t* chunk, uint32_t length) {
+	if ((MICROEJ_DECODE_WEBP_SUSPENDED == stream->status) && (length > 0u)) {
+		if (NULL == stream->idec) {
+			// the image buffer cannot be allocated before knowing the image size:
+			// keep the first bytes until the header is complete
+			uint32_t header_length = MICROEJ_DECODE_WEBP_STREAM_HEADER_SIZE - stream->header_size;
+			header_length = (length < header_length) ? length : header_length;
+			memcpy(&stream->header[stream->header_size], chunk, header_length);
+			stream->header_size += header_length;
+
+			VP8StatusCode status = WebPGetFeatures(stream->header, stream->header_size, &stream->config.input);
+			if (VP8_STATUS_OK == status) {
+				stream->status = StreamCreateDecoder(stream);
+				if (MICROEJ_DECODE_WEBP_SUSPENDED == stream->status) {
+					// give the header and the rest of the chunk to the decoder
+					stream->status = StreamDecode(stream, stream->header, stream->header_size);
+					if ((MICROEJ_DECODE_WEBP_SUSPENDED == stream->status) && (length > header_length)) {
+						stream->status = StreamDecode(stream, chunk + header_length, length - header_length);
+					}
+				}
+			}
+			else if ((VP8_STATUS_NOT_ENOUGH_DATA != status) || (MICROEJ_DECODE_WEBP_STREAM_HEADER_SIZE == stream->header_size)) {
+				// invalid header or header too large
+				stream->status = MICROEJ_DECODE_WEBP_ERROR;
+			}
+			else {
+				// wait for the next chunk
+			}
+		}
+		else {
+			stream->status = StreamDecode(stream, chunk, length);
+		}
+	}
+	return stream->status;
+}
+
+uint32_t MICROEJ_DECODE_webp_stream_get_rows(const MICROEJ_DECODE_webp_stream* stream) {
+	return stream->rows;
+}
+
+bool MICROEJ_DECODE_webp_stream_end(MICROEJ_DECODE_webp_stream* stream, bool* isFullyOpaque) {
+	bool done = MICROEJ_DECODE_WEBP_DONE == stream->status;
+
+	WebPIDelete(stream->idec);
+	stream->idec = NULL;
+	WebPSafeFree(stream->bgra);
+	stream->bgra = NULL;
+
+	if (done) {
+		*isFullyOpaque = stream->is_fully_opaque;
+	}
+	else {
+		if (stream->allocated) {
+			// the image is not complete
+			LLUI_DISPLAY_freeImageBuffer(stream->data);
+			stream->allocated = false;
+		}
+		stream->status = MICROEJ_DECODE_WEBP_ERROR;
+	}
+	return done;
+}
+
+LLUI_DISPLAY_Status MICROEJ_DECODE_webp_read(MICROEJ_DECODE_webp_reader reader, void* context, uint8_t* chunk, uint32_t chunkSize, MICROUI_ImageFormat expectedFormat, MICROUI_Image* data, bool* isFullyOpaque) {
+	MICROEJ_DECODE_webp_stream stream;
+	MICROEJ_DECODE_webp_status status;
+	int32_t length;
+
+	// the chunk buffer is reused: each chunk is decoded before reading the next one
+	MICROEJ_DECODE_webp_stream_start(&stream, expectedFormat, data);
+	do {
+		length = reader(context, chunk, chunkSize);
+		status = (length < 0) ? MICROEJ_DECODE_WEBP_ERROR : MICROEJ_DECODE_webp_stream_append(&stream, chunk, (uint32_t)length);
+	} while ((MICROEJ_DECODE_WEBP_SUSPENDED == status) && (length > 0));
+
+	LLUI_DISPLAY_Status ret;
+	if (MICROEJ_DECODE_webp_stream_end(&stream, isFullyOpaque)) {
+		ret = LLUI_DISPLAY_OK;
+	}
+	else if (MICROEJ_DECODE_WEBP_OUT_OF_MEMORY == status) {
+		ret = LLUI_DISPLAY_OUT_OF_MEMORY;
+	}
+	else {
+		// invalid image, read error or end of the data before the end of the image
+		ret = LLUI_DISPLAY_NOK;
 	}
 	return ret;
 }
@@ -1,20 +1,118 @@
-// Copyright 2021-2023 MicroEJ Corp. All rights reserved.
+// Copyright 2021-2024 MicroEJ Corp. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be found with this software.
 
 #ifndef WEBP_MICROEJ_MICROEJ_DECODE_H_
 #define WEBP_MICROEJ_MICROEJ_DECODE_H_
 
 #include "LLUI_DISPLAY_impl.h"
+#include "src/webp/decode.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+//------------------------------------------------------------------------------
+// Configuration
+
+// Opaque images decoded without an explicit expected format (display format, undefined
+// format or a format the decoder does not support) are decoded in RGB565, the display
+// format: they use half the images heap and are copied (not blended) in the display
+// buffer. The images requested in ARGB8888 or RGB888 keep their 24-bit colors and are
+// decoded in ARGB8888. Comment this define to decode in ARGB8888 all the images
+// without a 16-bit expected format.
+#define MICROEJ_DECODE_WEBP_OPAQUE_RGB565
+
+// Uncomment this define to apply an ordered dithering (4x4 Bayer matrix) when
+// decoding in RGB565, ARGB4444 or ARGB1555. The image is decoded in a temporary
+// ARGB8888 buffer allocated in the images heap.
+//#define MICROEJ_DECODE_WEBP_DITHERING
+
+// Size of the buffer that keeps the first bytes of a streamed image until its header
+// (RIFF, VP8X and VP8/VP8L chunk headers) is complete.
+#define MICROEJ_DECODE_WEBP_STREAM_HEADER_SIZE (64)
+
 //------------------------------------------------------------------------------
 // MicroEJ WEBP decoder entry point
 
+// Decodes a WEBP image in the expected format. The RGB565, ARGB4444, ARGB1555 and
+// ARGB8888 formats are supported; RGB888 is decoded in ARGB8888 and the other formats
+// are decoded in ARGB8888 or RGB565 (see MICROEJ_DECODE_WEBP_OPAQUE_RGB565).
+
 LLUI_DISPLAY_Status MICROEJ_DECODE_webp(uint8_t* addr, uint32_t length, MICROUI_ImageFormat expectedFormat, MICROUI_Image* data, bool* isFullyOpaque);
 
+//------------------------------------------------------------------------------
+// MicroEJ WEBP streaming decoder
+
+// The image is decoded while its data is received (file read in chunks, socket,
+// etc.): the rows are written in the image buffer (allocated in the images heap as
+// soon as the header is received) as the chunks are decoded. Usage:
+//
+//   MICROEJ_DECODE_webp_stream stream;
+//   MICROEJ_DECODE_webp_stream_start(&stream, expectedFormat, data);
+//   do {
+//     length = read(chunk, sizeof(chunk));
+//     status = MICROEJ_DECODE_webp_stream_append(&stream, chunk, length);
+//     // MICROEJ_DECODE_webp_stream_get_rows(&stream) rows out of data->height are decoded
+//   } while ((MICROEJ_DECODE_WEBP_SUSPENDED == status) && (length > 0));
+//   ok = MICROEJ_DECODE_webp_stream_end(&stream, &isFullyOpaque);
+
+typedef enum {
+	MICROEJ_DECODE_WEBP_DONE,          // the image is fully decoded
+	MICROEJ_DECODE_WEBP_SUSPENDED,     // waiting for more data
+	MICROEJ_DECODE_WEBP_ERROR,         // invalid or unsupported (animated) image
+	MICROEJ_DECODE_WEBP_OUT_OF_MEMORY, // images heap full
+} MICROEJ_DECODE_webp_status;
+
+// Decoding state, to be considered opaque.
+typedef struct {
+	WebPIDecoder* idec;
+	WebPDecoderConfig config;
+	MICROUI_Image* data;
+	MICROUI_ImageFormat expected_format;
+	MICROEJ_DECODE_webp_status status;
+	uint8_t* bgra;        // temporary buffer when the image is converted
+	uint32_t rows;        // number of rows available in the image buffer
+	uint32_t header_size;
+	bool allocated;
+	bool is_fully_opaque;
+	uint8_t header[MICROEJ_DECODE_WEBP_STREAM_HEADER_SIZE];
+} MICROEJ_DECODE_webp_stream;
+
+// Initializes the streaming decoder. The image buffer is allocated later, when the
+// image header is received.
+void MICROEJ_DECODE_webp_stream_start(MICROEJ_DECODE_webp_stream* stream, MICROUI_ImageFormat expectedFormat, MICROUI_Image* data);
+
+// Decodes the next chunk of data. The chunk can be released when the function
+// returns. Returns MICROEJ_DECODE_WEBP_SUSPENDED while more data is required.
+MICROEJ_DECODE_webp_status MICROEJ_DECODE_webp_stream_append(MICROEJ_DECODE_webp_stream* stream, const uint8_t* chunk, uint32_t length);
+
+// Gets the number of rows (from the top of the image) already decoded.
+uint32_t MICROEJ_DECODE_webp_stream_get_rows(const MICROEJ_DECODE_webp_stream* stream);
+
+// Releases the decoding resources. Returns true when the image has been fully
+// decoded; otherwise the image buffer is freed.
+bool MICROEJ_DECODE_webp_stream_end(MICROEJ_DECODE_webp_stream* stream, bool* isFullyOpaque);
+
+//------------------------------------------------------------------------------
+// MicroEJ WEBP chunked loader
+
+// Reads at most length bytes of the encoded image in buffer (file opened with
+// LLFS_File_IMPL_open(), socket, etc.). Returns the number of bytes read, 0 at the end
+// of the data or a negative value on error.
+typedef int32_t (*MICROEJ_DECODE_webp_reader)(void* context, uint8_t* buffer, uint32_t length);
+
+// Decodes the image read by the reader in chunks of chunkSize bytes in the chunk buffer
+// given by the caller: the whole encoded image is never held in memory (the incremental
+// decoder keeps only the data it has not consumed yet). Returns the same status as
+// MICROEJ_DECODE_webp(); the image buffer is freed on error. Reader of a file of the
+// file system (LLFS_EOF is the end of the file):
+//
+//   static int32_t read_file(void* context, uint8_t* buffer, uint32_t length) {
+//     int32_t read = LLFS_File_IMPL_read(*(int32_t*)context, buffer, 0, (int32_t)length);
+//     return (LLFS_EOF == read) ? 0 : read;
+//   }
+LLUI_DISPLAY_Status MICROEJ_DECODE_webp_read(MICROEJ_DECODE_webp_reader reader, void* context, uint8_t* chunk, uint32_t chunkSize, MICROUI_ImageFormat expectedFormat, MICROUI_Image* data, bool* isFullyOpaque);
+
 //------------------------------------------------------------------------------
 
 #ifdef __cplusplus
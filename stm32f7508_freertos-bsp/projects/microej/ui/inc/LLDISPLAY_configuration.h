@@ -46,4 +46,73 @@
  */
 #define LLDISPLAY_BPP DRAWING_DMA2D_BPP
 
+/**
+ * Comment / uncomment it to disable / enable the triple buffering.
+ *
+ * By default the display uses two buffers: after a flush, the Graphics Engine waits
+ * for the next vertical blanking (end of the restore copy) before drawing the next frame.
+ * With three buffers, the next frame is drawn in the third buffer as soon as the restore
+ * copy is done, while the LTDC still scans out the previous buffer. The Graphics Engine
+ * only waits for the vertical blanking when it renders faster than the display refresh.
+ *
+ * The display buffers section requires 1MB instead of 512KB in SDRAM (see MPU_Config()
+ * in main.c).
+ */
+//#define LLDISPLAY_TRIPLE_BUFFERING
+
+/**
+ * Comment / uncomment it to disable / enable the dirty regions tracking (see display_dirty_regions.h).
+ *
+ * When enabled, the copy from frame buffer to back buffer performed after each flush is
+ * limited to the rectangles drawn during the frame instead of their bounding box.
+ * Disabled by default.
+ */
+//#define DISPLAY_DIRTY_REGIONS_ENABLED
+
+/**
+ * Comment / uncomment it to declare that the Graphics Engine does not / does draw in the
+ * display buffer without reporting the drawing to the dirty regions tracker.
+ *
+ * The drawings of the painters, of the glyph atlas (see ui_glyph_atlas.h), of the display
+ * list and of the layer compositor are reported with their rectangles. The strings drawn
+ * by the software font renderer of the Graphics Engine are not: such a string only
+ * extends the flush bounding box. When it lands between two tracked rectangles, it is not
+ * restored in the back buffer (ghosting). Uncomment it when the application draws such
+ * strings outside the clip of the widget background drawn below them: every frame then
+ * falls back on the flush bounding box (the tracker only gathers the statistics).
+ */
+//#define DISPLAY_DIRTY_REGIONS_ENGINE_DRAWINGS
+
+/**
+ * Comment / uncomment it to disable / enable the overlay plane (see display_overlay.h).
+ *
+ * When enabled, the display buffers are scanned out by the LTDC background layer and
+ * the foreground layer shows an image above them with its own position and opacity
+ * (Java class com.microej.ui.Overlay). The foreground layer is disabled while no
+ * overlay is shown: it costs no memory bandwidth.
+ */
+//#define DISPLAY_OVERLAY_ENABLED
+
+/**
+ * Uncomment it to print the CPU time of the overlay updates (average of
+ * DISPLAY_OVERLAY_BENCHMARK_UPDATES updates) and the time until the LTDC applies the
+ * hiding of a closed image (see display_overlay.h). Requires FRAMERATE_ENABLED.
+ */
+//#define DISPLAY_OVERLAY_BENCHMARK
+#define DISPLAY_OVERLAY_BENCHMARK_UPDATES (256U)
+
+/**
+ * Default scan line at which the line scheduler resumes the MicroUI task (see
+ * display_line_scheduler.h): 0 is the first line of the display, 272 (the display height)
+ * is the end of the scan-out of the frame.
+ */
+#define DISPLAY_LINE_SCHEDULER_LINE 272
+
+/**
+ * Number of lines the LTDC scans while the application draws an area in the front
+ * buffer (one line lasts about 59us: 32 lines are 1.9ms). An area closer to the beam
+ * is drawn after the beam has left it.
+ */
+#define DISPLAY_LINE_SCHEDULER_MARGIN 32
+
 #endif
@@ -12,12 +12,36 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "stm32f7508_discovery.h"
+#include "input_ring.h"
 
 /* API -----------------------------------------------------------------------*/
 
 void BUTTONS_MANAGER_initialize(void);
-void BUTTONS_MANAGER_interrupt(Button_TypeDef Button);
+
+/*
+ * Manage the button interrupt line (EXTI): the button state is pushed in the buttons ring.
+ * @return MICROEJ_TRUE when the IO task has to send the buttons events
+ */
+uint8_t BUTTONS_MANAGER_interrupt(Button_TypeDef Button);
+
 void BUTTONS_MANAGER_enable_interrupts(void);
 void BUTTONS_MANAGER_disable_interrupts(void);
 
+/*
+ * Return the ring of the buttons events (consumer: the IO task).
+ */
+INPUT_RING_t* BUTTONS_MANAGER_get_ring(void);
+
+/*
+ * Send a buttons event of the ring to the buttons helper (IO task, in the MicroUI input
+ * critical section).
+ */
+void BUTTONS_MANAGER_dispatch(const INPUT_RING_event_t* event);
+
+/*
+ * Send the current buttons state when buttons events have been lost (IO task, in the
+ * MicroUI input critical section).
+ */
+void BUTTONS_MANAGER_resync(void);
+
 #endif
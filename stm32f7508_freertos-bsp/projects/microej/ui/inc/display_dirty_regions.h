@@ -0,0 +1,119 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef _DISPLAY_DIRTY_REGIONS
+#define _DISPLAY_DIRTY_REGIONS
+
+/*
+ * Keeps a small list of non-overlapping rectangles modified in the back buffer during
+ * a frame. At flush time, the list replaces the single bounding box given by the
+ * Graphics Engine so that the restore copy (frame buffer to back buffer) only copies
+ * the pixels really drawn.
+ *
+ * The painters (LLUI_PAINTER_impl.c, LLDW_PAINTER_impl.c) report the region of each
+ * drawing. Some drawings are performed internally by the Graphics Engine (strings for
+ * instance) and are not reported: such a drawing may land anywhere in the bounding box,
+ * including between two tracked rectangles. The tracker falls back on the flush bounding
+ * box when:
+ * - DISPLAY_DIRTY_REGIONS_ENGINE_DRAWINGS is defined (the Graphics Engine may draw
+ * without reporting during any frame),
+ * - a drawing of the frame has been declared as unreported (see
+ * DISPLAY_DIRTY_REGIONS_add_unreported()),
+ * - the tracked rectangles do not cover the flush bounding box.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "LLUI_PAINTER_impl.h"
+#include "LLDISPLAY_configuration.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Maximum number of rectangles kept per frame. When the list is full, the two
+ * rectangles whose union costs the least are merged.
+ */
+#ifndef DISPLAY_DIRTY_REGIONS_MAX
+#define DISPLAY_DIRTY_REGIONS_MAX 8
+#endif
+
+/*
+ * Two rectangles are merged when their union adds fewer pixels than this value.
+ * This value represents the cost of one more DMA2D transfer (setup and interrupt)
+ * expressed in pixels.
+ */
+#ifndef DISPLAY_DIRTY_REGIONS_MERGE_COST
+#define DISPLAY_DIRTY_REGIONS_MERGE_COST 512
+#endif
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * A rectangle; bounds are inclusive.
+ */
+typedef struct
+{
+	uint16_t x1;
+	uint16_t y1;
+	uint16_t x2;
+	uint16_t y2;
+} DISPLAY_DIRTY_REGIONS_rect_t;
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Adds a rectangle to the current frame. The rectangle is merged with the
+ * rectangles already in the list according to the merge cost.
+ */
+void DISPLAY_DIRTY_REGIONS_add(uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2);
+
+/*
+ * Declares a drawing in the display buffer whose region is not reported: the current
+ * frame falls back on the flush bounding box.
+ */
+void DISPLAY_DIRTY_REGIONS_add_unreported(void);
+
+/*
+ * Adds the current clip of the graphics context to the current frame. Does nothing
+ * when the graphics context does not target the display buffer or when the dirty
+ * regions tracking is disabled. The first call of a frame on the display buffer starts
+ * the frame render time (see framerate_frame_drawing()).
+ */
+void DISPLAY_DIRTY_REGIONS_add_clip(MICROUI_GraphicsContext* gc);
+
+/*
+ * Retrieves the rectangles drawn during the frame being flushed and starts a new frame.
+ *
+ * @param xmin, ymin, xmax, ymax the flush bounding box given by the Graphics Engine
+ * @param rects the array to fill, DISPLAY_DIRTY_REGIONS_MAX entries
+ *
+ * @return the number of rectangles in the array (at least 1)
+ */
+uint32_t DISPLAY_DIRTY_REGIONS_flush(uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, DISPLAY_DIRTY_REGIONS_rect_t* rects);
+
+/*
+ * Updates the copied bytes and rectangles counters with the rectangles really copied
+ * by the restore copy.
+ *
+ * @param rects the rectangles copied
+ * @param count the number of rectangles
+ * @param bpp the number of bits per pixel of the buffers
+ */
+void DISPLAY_DIRTY_REGIONS_account(DISPLAY_DIRTY_REGIONS_rect_t* rects, uint32_t count, uint32_t bpp);
+
+/*
+ * Returns the number of bytes copied by the restore copy of the last flushed frame.
+ */
+uint32_t DISPLAY_DIRTY_REGIONS_get_copied_bytes(void);
+
+/*
+ * Returns the number of rectangles copied by the restore copy of the last flushed frame.
+ */
+uint32_t DISPLAY_DIRTY_REGIONS_get_copied_rects(void);
+
+#endif	// _DISPLAY_DIRTY_REGIONS
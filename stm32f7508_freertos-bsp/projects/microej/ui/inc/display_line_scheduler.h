@@ -0,0 +1,112 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef _DISPLAY_LINE_SCHEDULER
+#define _DISPLAY_LINE_SCHEDULER
+
+/*
+ * Synchronizes the renderer with the scan-out of the LTDC. The LTDC line interrupt
+ * resumes the Java thread waiting for a scan line (DISPLAY_LINE_SCHEDULER_LINE by
+ * default): the renderer starts its frames at a known position of the beam.
+ *
+ * With the front buffer drawing (double buffering only), the Graphics Engine draws in
+ * the displayed buffer: the flush returns immediately, without swapping the buffers nor
+ * copying the frame, and the drawings are visible at the next pass of the beam. Before
+ * drawing an area, the renderer calls DISPLAY_LINE_SCHEDULER_wait_area(): when the area
+ * lies below the current scan line (with DISPLAY_LINE_SCHEDULER_MARGIN lines ahead), the
+ * renderer draws at once and the area is displayed in the current refresh; otherwise the
+ * renderer waits for the beam to leave the area ("chases the beam") and the area is
+ * displayed in the next refresh. Compared to the double buffering (drawing, flush,
+ * vertical blanking, restore copy), a touch feedback is displayed up to one frame
+ * earlier.
+ *
+ *   Vsync.setFrontBufferDrawing(true); // on touch pressed, applied at next flush
+ *   ...
+ *   Vsync.waitArea(y, height);
+ *   drawFeedback(g, y, height);
+ *   display.flush();
+ *   ...
+ *   Vsync.setFrontBufferDrawing(false); // on touch released
+ *
+ * The other buffer is updated (one copy of the area drawn in front buffer) at the
+ * first flush after the front buffer drawing has been disabled.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sni.h"
+#include "LLDISPLAY_configuration.h"
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Returns the line scanned by the LTDC: 0 is the first line of the display, negative
+ * values are the vertical synchronization and back porch lines, values greater than or
+ * equal to the display height are the front porch lines.
+ */
+int32_t DISPLAY_LINE_SCHEDULER_get_line(void);
+
+/*
+ * Sets the line waited by DISPLAY_LINE_SCHEDULER_wait_line() (0 to display height).
+ */
+void DISPLAY_LINE_SCHEDULER_set_line(int32_t line);
+
+/*
+ * Suspends the current Java thread until the LTDC scans the line set by
+ * DISPLAY_LINE_SCHEDULER_set_line() (the thread is resumed after the end of the native).
+ *
+ * @return false when another Java thread is already waiting for a line
+ */
+bool DISPLAY_LINE_SCHEDULER_wait_line(void);
+
+/*
+ * Tells whether the LTDC will not scan the given lines during the next
+ * DISPLAY_LINE_SCHEDULER_MARGIN lines.
+ *
+ * @param y1, y2 the first and last lines of the area
+ */
+bool DISPLAY_LINE_SCHEDULER_is_area_safe(int32_t y1, int32_t y2);
+
+/*
+ * Suspends the current Java thread until the area can be drawn in the front buffer
+ * without tearing (see DISPLAY_LINE_SCHEDULER_is_area_safe()): returns at once when the
+ * area lies below the current scan line, waits for the beam to leave the area otherwise.
+ *
+ * @param y1, y2 the first and last lines of the area
+ *
+ * @return false when another Java thread is already waiting for a line
+ */
+bool DISPLAY_LINE_SCHEDULER_wait_area(int32_t y1, int32_t y2);
+
+/*
+ * Enables or disables the front buffer drawing (applied at the next flush).
+ */
+void DISPLAY_LINE_SCHEDULER_set_front_buffer_drawing(bool enable);
+
+/*
+ * Tells whether the front buffer drawing is enabled (see LLUI_DISPLAY_IMPL_flush()).
+ */
+bool DISPLAY_LINE_SCHEDULER_is_front_buffer_drawing(void);
+
+/*
+ * LTDC line interrupt: resumes the waiting Java thread. Called by
+ * HAL_LTDC_LineEventCallback().
+ */
+void DISPLAY_LINE_SCHEDULER_line_event(void);
+
+/*
+ * Natives of the class "com.microej.ui.Vsync" (see the functions above).
+ */
+jint Java_com_microej_ui_Vsync_getScanLine(void);
+void Java_com_microej_ui_Vsync_setLine(jint line);
+jboolean Java_com_microej_ui_Vsync_waitLine(void);
+jboolean Java_com_microej_ui_Vsync_waitArea(jint y, jint height);
+void Java_com_microej_ui_Vsync_setFrontBufferDrawing(jboolean enable);
+
+#endif
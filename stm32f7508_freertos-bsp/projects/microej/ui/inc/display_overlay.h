@@ -0,0 +1,111 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef _DISPLAY_OVERLAY
+#define _DISPLAY_OVERLAY
+
+/*
+ * Shows a MicroUI image (a cursor, a video window, a status bar, a popup) on the second
+ * LTDC layer, above the display buffers. The LTDC blends the overlay during the scan-out
+ * with its own position, pixel format and opacity: moving or fading the overlay only
+ * updates some LTDC registers at the next vertical blanking. Nothing is drawn, restored
+ * nor flushed in the display buffers.
+ *
+ * The LTDC reads the overlay directly from the image: the image must stay opened while
+ * it is shown (the overlay is hidden when the image is closed). When the CPU draws in the
+ * image, the application calls DISPLAY_OVERLAY_update() to write the data cache back in
+ * memory.
+ *
+ * Moving the overlay costs the update of the layer registers and no flush, whereas an
+ * image drawn in the display buffers is restored, drawn and flushed at each step. The
+ * CPU time of an update and the time until the LTDC applies it are printed when
+ * DISPLAY_OVERLAY_BENCHMARK is defined (LLDISPLAY_configuration.h): measure them on the
+ * board before choosing the overlay for an animation.
+ *
+ * Enabled by DISPLAY_OVERLAY_ENABLED (LLDISPLAY_configuration.h). The functions are
+ * called by the Graphics Engine task (natives).
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "LLUI_PAINTER_impl.h"
+#include "LLDISPLAY_configuration.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * LTDC layer of the display buffers (background layer) and of the overlay (foreground
+ * layer) when the overlay is enabled.
+ */
+#define DISPLAY_OVERLAY_BACKGROUND_LAYER 0
+#define DISPLAY_OVERLAY_LAYER 1
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Initializes the overlay plane. Called by LLUI_DISPLAY_IMPL_initialize().
+ */
+void DISPLAY_OVERLAY_initialize(void);
+
+/*
+ * Notifies the LTDC registers reload. Called by the LTDC reload interrupt.
+ */
+void DISPLAY_OVERLAY_reload_event(void);
+
+/*
+ * Shows an image on the overlay plane. The image replaces the overlay shown before.
+ * The position may be partially outside the display.
+ *
+ * @param image the image: ARGB8888, RGB888, RGB565, ARGB1555 or ARGB4444
+ * @param x, y the image position in the display
+ * @param alpha the overlay opacity (0 to 255), multiplied by the pixels' alpha
+ *
+ * @return false when the overlay is disabled or when the image format is not supported
+ * by the LTDC
+ */
+bool DISPLAY_OVERLAY_show(MICROUI_Image* image, int32_t x, int32_t y, uint32_t alpha);
+
+/*
+ * Moves the overlay.
+ */
+void DISPLAY_OVERLAY_move(int32_t x, int32_t y);
+
+/*
+ * Sets the overlay opacity (0 to 255). The LTDC layer is disabled when the opacity is 0.
+ */
+void DISPLAY_OVERLAY_set_opacity(uint32_t alpha);
+
+/*
+ * Writes the data cache back in the overlay image: must be called after the CPU has
+ * drawn in the image (the DMA2D drawings are written in memory).
+ */
+void DISPLAY_OVERLAY_update(void);
+
+/*
+ * Hides the overlay.
+ */
+void DISPLAY_OVERLAY_hide(void);
+
+/*
+ * Hides the overlay when it shows the given image. Called when the image is closed:
+ * returns when the LTDC does not read the image anymore (the task waits for the reload
+ * interrupt, at most one frame).
+ */
+void DISPLAY_OVERLAY_free_image(MICROUI_Image* image);
+
+/*
+ * Natives of the class "com.microej.ui.Overlay" (see the functions above).
+ */
+jboolean Java_com_microej_ui_Overlay_show(MICROUI_Image* image, jint x, jint y, jint alpha);
+void Java_com_microej_ui_Overlay_move(jint x, jint y);
+void Java_com_microej_ui_Overlay_setOpacity(jint alpha);
+void Java_com_microej_ui_Overlay_update(void);
+void Java_com_microej_ui_Overlay_hide(void);
+
+#endif
@@ -109,4 +109,13 @@ int32_t EVENT_GENERATOR_touch_released(void);
  */
 int32_t EVENT_GENERATOR_state_changed(int32_t stateID, int32_t stateValue);
 
+/*
+ * Notify to the event generator a gesture has been recognized (see touch_gesture.h). Only
+ * available when the generic event generator GESTURES is declared in microui.xml.
+ * @param events the gesture event data
+ * @param length the number of data, TOUCH_GESTURE_EVENT_SIZE
+ * @return {@link LLUI_INPUT_OK} if all events have been added, {@link LLUI_INPUT_NOK} otherwise
+ */
+int32_t EVENT_GENERATOR_gesture(int32_t* events, int32_t length);
+
 #endif
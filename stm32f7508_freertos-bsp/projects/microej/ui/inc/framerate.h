@@ -18,6 +18,23 @@
 #define FRAMERATE_OK 0
 #define FRAMERATE_ERROR -1
 
+/*
+ * Frame-time metrics (see framerate_get_percentile())
+ * - render: from the first drawing in the back buffer to the flush
+ * - flush latency: from the flush to the vertical blanking that displays the frame
+ * - restore: duration of the copy from frame buffer to back buffer after the flush
+ */
+#define FRAMERATE_METRIC_RENDER 0
+#define FRAMERATE_METRIC_FLUSH_LATENCY 1
+#define FRAMERATE_METRIC_RESTORE 2
+#define FRAMERATE_METRICS 3
+
+/*
+ * Pacing modes (see framerate_set_pacing())
+ */
+#define FRAMERATE_PACING_OFF 0
+#define FRAMERATE_PACING_ADAPTIVE 1
+
 /* API -----------------------------------------------------------------------*/
 
 /*
@@ -35,6 +52,53 @@ void framerate_increment(void);
  */
 uint32_t framerate_get(void);
 
+/*
+ * Start the render time of the frame (first drawing in the back buffer since the last
+ * flush; next calls are ignored)
+ */
+void framerate_frame_drawing(void);
+
+/*
+ * Record the times of the frame being flushed and of the previous frame, and apply the
+ * pacing (may sleep before returning)
+ *
+ * @param restore_cycles the duration of the restore copy of the previous frame in CPU
+ * cycles (0 when unknown)
+ */
+void framerate_frame_flush(uint32_t restore_cycles);
+
+/*
+ * Record the flush latency: the flushed frame is displayed (called under interrupt at
+ * the vertical blanking)
+ */
+void framerate_frame_vsync(void);
+
+/*
+ * Return a percentile of a metric over the last FRAMERATE_HISTOGRAM_FRAMES frames, in
+ * microseconds (upper bound of the histogram bucket), 0 when no frame has been recorded
+ *
+ * @param metric FRAMERATE_METRIC_RENDER, FRAMERATE_METRIC_FLUSH_LATENCY or FRAMERATE_METRIC_RESTORE
+ * @param percentile the percentile (1 to 100: 50, 95, 99...)
+ */
+uint32_t framerate_get_percentile(int32_t metric, int32_t percentile);
+
+/*
+ * Set the pacing mode. In adaptive mode, when the frames would miss the vertical
+ * blanking (p95 of render and restore times greater than the refresh period), the
+ * rendering is capped to a divisor of the panel refresh rate: the flush waits until
+ * the frame period is elapsed, so the frames are delivered at a regular rate and the
+ * CPU is released in the meantime.
+ *
+ * @param mode FRAMERATE_PACING_OFF or FRAMERATE_PACING_ADAPTIVE
+ */
+int32_t framerate_set_pacing(int32_t mode);
+
+/*
+ * Return the current divisor of the panel refresh rate (1 when the rendering is not
+ * capped)
+ */
+uint32_t framerate_get_pacing_divisor(void);
+
 /* Default Java API ----------------------------------------------------------*/
 
 #ifndef javaFramerateInit
@@ -43,5 +107,14 @@ uint32_t framerate_get(void);
 #ifndef javaFramerateGet
 #define javaFramerateGet		Java_com_is2t_debug_Framerate_get
 #endif
+#ifndef javaFramerateGetPercentile
+#define javaFramerateGetPercentile		Java_com_is2t_debug_Framerate_getPercentile
+#endif
+#ifndef javaFramerateSetPacing
+#define javaFramerateSetPacing		Java_com_is2t_debug_Framerate_setPacing
+#endif
+#ifndef javaFramerateGetPacingDivisor
+#define javaFramerateGetPacingDivisor		Java_com_is2t_debug_Framerate_getPacingDivisor
+#endif
 
 #endif	// _FRAMERATE_INTERN
@@ -15,4 +15,36 @@
  */
 #define FRAMERATE_ENABLED
 
+/*
+ * Number of frames in the rolling window of the frame-time histograms (at most 65535)
+ */
+#define FRAMERATE_HISTOGRAM_FRAMES 120
+
+/*
+ * Width of a bucket of the frame-time histograms, in microseconds
+ */
+#define FRAMERATE_HISTOGRAM_BUCKET_US 250
+
+/*
+ * Number of buckets of the frame-time histograms (at most 256). The last bucket holds
+ * all the times greater than its lower bound (32ms by default).
+ */
+#define FRAMERATE_HISTOGRAM_BUCKETS 128
+
+/*
+ * Refresh period of the panel, in microseconds. RK043FN48H: 566 x 286 pixels (with the
+ * synchronization and porch areas) at 9.6MHz (see BSP_LCD_ClockConfig()).
+ */
+#define FRAMERATE_PANEL_REFRESH_US 16862
+
+/*
+ * Adaptive pacing: maximum divisor of the panel refresh rate (4: 15 frames per second)
+ */
+#define FRAMERATE_PACING_MAX_DIVISOR 4
+
+/*
+ * Adaptive pacing: number of frames between two updates of the divisor
+ */
+#define FRAMERATE_PACING_PERIOD 30
+
 #endif
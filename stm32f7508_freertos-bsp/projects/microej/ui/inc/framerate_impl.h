@@ -38,4 +38,16 @@ void framerate_impl_sleep(uint32_t ms);
 
 #endif	// FRAMERATE_ENABLED
 
+/*
+ * Return the value of a free-running cycles counter (the counter is enabled by the
+ * first call). Available even when the framerate is disabled: the other modules that
+ * measure times use this counter too.
+ */
+uint32_t framerate_impl_get_cycles(void);
+
+/*
+ * Convert a number of cycles to microseconds
+ */
+uint32_t framerate_impl_cycles_to_us(uint32_t cycles);
+
 #endif	// _FRAMERATE_IMPL
@@ -0,0 +1,119 @@
+/*
+ * C
+ *
+ * Copyright 2014-2020 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef _GRAYSCALE
+#define _GRAYSCALE
+
+/*
+ * Converts the images in grayscale. The gray level of a pixel is a weighted sum of its
+ * channels (16 bits weights); the 4, 5 and 6 bits channels are expanded in 8 bits
+ * first. The RGB565 pixels are read and written two by two.
+ *
+ * All the MicroUI formats can be read:
+ * - the formats with colors (ARGB8888, RGB888, RGB565, ARGB1555, ARGB4444, their
+ *   premultiplied variants and LARGB8888) are converted with the selected algorithm,
+ * - the formats with levels only (A1 to A8, C1 to C4, AC11 to AC44) are already gray:
+ *   the level of a pixel is its gray level (an alpha mask becomes a white on black
+ *   image) and the alpha of the AC formats is kept.
+ * The destination formats are ARGB8888, RGB888, RGB565, ARGB1555, ARGB4444 (and their
+ * premultiplied variants) and A8 (the gray level over black).
+ *
+ * The source and the destination may be the same image when they have the same format.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "LLUI_PAINTER_impl.h"
+#include "LLDISPLAY_configuration.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define GRAYSCALE_ALGO_1	1	// (r + g + b) / 3
+#define GRAYSCALE_ALGO_2	2	// r * 0.299 + g * 0.587 + b * 0.114 (ITU-R BT.601)
+#define GRAYSCALE_ALGO_3	3	// r * 0.2126 + g * 0.7152 + b * 0.0722 (ITU-R BT.709)
+
+/*
+ * Values returned by the conversion
+ */
+#define GRAYSCALE_OK 0
+#define GRAYSCALE_ERROR_FORMAT -1		// source or destination format not supported
+#define GRAYSCALE_ERROR_SIZE -2			// region larger than the source or the destination
+#define GRAYSCALE_ERROR_ALGORITHM -3	// unknown algorithm
+#define GRAYSCALE_ERROR_CLOSED -4		// source or destination closed
+
+/*
+ * Format of the display buffers (replaces MICROUI_IMAGE_FORMAT_DISPLAY)
+ */
+#if LLDISPLAY_BPP == 16
+#define GRAYSCALE_DISPLAY_FORMAT MICROUI_IMAGE_FORMAT_RGB565
+#elif LLDISPLAY_BPP == 24
+#define GRAYSCALE_DISPLAY_FORMAT MICROUI_IMAGE_FORMAT_RGB888
+#elif LLDISPLAY_BPP == 32
+#define GRAYSCALE_DISPLAY_FORMAT MICROUI_IMAGE_FORMAT_ARGB8888
+#else
+#error "Define 'LLDISPLAY_BPP' is required (16, 24 or 32)"
+#endif
+
+#include "grayscale_conf.h"
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * An image to convert (independent of the Graphics Engine)
+ */
+typedef struct
+{
+	uint8_t* buffer;		// first pixel
+	const uint32_t* lut;	// colors of the LARGB8888 format (NULL for the other formats)
+	uint32_t stride;		// in bytes
+	uint32_t width;
+	uint32_t height;
+	uint8_t format;			// MICROUI_ImageFormat (not MICROUI_IMAGE_FORMAT_DISPLAY)
+} grayscale_image_t;
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Select the algorithm
+ *
+ * @return GRAYSCALE_OK or GRAYSCALE_ERROR_ALGORITHM
+ */
+int32_t grayscale_set_algorithm(int32_t algorithm);
+
+/*
+ * Convert the top-left region of an image in grayscale in another image
+ *
+ * @param width, height the size of the region
+ *
+ * @return GRAYSCALE_OK or an error (see GRAYSCALE_ERROR_xxx)
+ */
+int32_t grayscale_convert(const grayscale_image_t* src, const grayscale_image_t* dest, uint32_t width, uint32_t height);
+
+/*
+ * Fill an image descriptor from a MicroUI image
+ *
+ * @return GRAYSCALE_OK or GRAYSCALE_ERROR_CLOSED
+ */
+int32_t grayscale_get_image(MICROUI_Image* image, grayscale_image_t* desc);
+
+#ifdef GRAYSCALE_BENCHMARK
+/*
+ * Convert an image with each algorithm and print the average durations. The content of
+ * the destination is lost. The selected algorithm is kept.
+ */
+void grayscale_benchmark(const grayscale_image_t* src, const grayscale_image_t* dest);
+#endif
+
+/*
+ * Natives of the class "com.is2t.microui.util.Grayscale": convertToGrayScale() converts
+ * the region (0, 0, w, h) of src in dest, setAlgorithm() selects the algorithm of the
+ * next conversions. The errors are printed (see GRAYSCALE_ERROR_xxx).
+ */
+void Java_com_is2t_microui_util_Grayscale_convertToGrayScale(MICROUI_Image* src, MICROUI_Image* dest, jint w, jint h);
+void Java_com_is2t_microui_util_Grayscale_setAlgorithm(jint algorithm);
+
+#endif	// _GRAYSCALE
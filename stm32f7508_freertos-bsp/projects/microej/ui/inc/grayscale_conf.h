@@ -0,0 +1,51 @@
+/*
+ * C
+ *
+ * Copyright 2014-2020 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef _GRAYSCALE_CONF
+#define _GRAYSCALE_CONF
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Algorithm used until the first call to grayscale_set_algorithm(): GRAYSCALE_ALGO_1,
+ * GRAYSCALE_ALGO_2 or GRAYSCALE_ALGO_3 (see grayscale.h)
+ */
+#define GRAYSCALE_ALGO GRAYSCALE_ALGO_3
+
+/*
+ * Comment / uncomment it to disable / enable the DMA2D output pass: the CPU computes the
+ * gray levels in small AL88 tiles and the DMA2D writes them in the destination format
+ * through a grayscale CLUT. Only for the destination formats written by the DMA2D
+ * (ARGB8888, RGB888, RGB565, ARGB1555 and ARGB4444).
+ */
+#define GRAYSCALE_DMA2D_ENABLED
+
+/*
+ * Number of AL88 pixels of a tile of the DMA2D output pass (at least one line of the
+ * image). Two tiles are allocated: the CPU fills a tile while the DMA2D converts the
+ * other one. Both tiles (4KB) fit in the data cache.
+ */
+#define GRAYSCALE_DMA2D_TILE_PIXELS 1024
+
+/*
+ * Minimum number of pixels of a conversion to use the DMA2D output pass. Below, the
+ * CPU writes the destination.
+ */
+#define GRAYSCALE_DMA2D_MIN_PIXELS 4096
+
+/*
+ * Uncomment it to run the benchmark of the three algorithms during the display
+ * initialization (see grayscale_benchmark()). The results are printed on the standard
+ * output. Requires FRAMERATE_ENABLED (cycles counter).
+ */
+//#define GRAYSCALE_BENCHMARK
+
+/*
+ * Number of conversions per algorithm of the benchmark. The results are the averages.
+ */
+#define GRAYSCALE_BENCHMARK_LOOPS 8
+
+#endif	// _GRAYSCALE_CONF
@@ -0,0 +1,108 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef _INPUT_RING
+#define _INPUT_RING
+
+/*
+ * Single-producer / single-consumer lock-free ring of input events. Each input interrupt
+ * (buttons, touch) pushes its events in its own ring; the IO task is the only consumer:
+ * it merges the rings in time order and sends the events to MicroUI (see io_task.c).
+ * The interrupts never enter the MicroUI input critical section.
+ *
+ * The producer only writes the head and the consumer only writes the tail: no lock and
+ * no interrupt masking are required. When a ring is full, the producer drops the event
+ * and counts it; the consumer detects it (see INPUT_RING_overflowed()) and resynchronizes
+ * the input state.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "touch_gesture.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Number of events of a ring (power of two)
+ */
+#define INPUT_RING_SIZE	16
+
+/*
+ * Event types
+ */
+#define INPUT_RING_BUTTON_PRESSED	0	// id: the button ID
+#define INPUT_RING_BUTTON_RELEASED	1	// id: the button ID
+#define INPUT_RING_TOUCH			2	// id: the number of points (0: released)
+
+/* Structs -------------------------------------------------------------------*/
+
+typedef struct
+{
+	uint32_t time;			// time of the event (see INPUT_RING_get_time())
+	uint32_t read_time;		// touch: end of the read of the sample
+	uint8_t type;
+	uint8_t id;
+	TOUCH_GESTURE_point_t points[TOUCH_GESTURE_MAX_POINTS];	// touch: the fingers
+} INPUT_RING_event_t;
+
+typedef struct
+{
+	volatile uint32_t head;		// events pushed (written by the producer only)
+	volatile uint32_t tail;		// events popped (written by the consumer only)
+	volatile uint32_t dropped;	// events dropped (written by the producer only)
+	uint32_t dropped_seen;		// events dropped already notified to the consumer
+	INPUT_RING_event_t events[INPUT_RING_SIZE];
+} INPUT_RING_t;
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Return the time base of the input events in microseconds (same time base as
+ * TOUCH_HELPER_get_time()).
+ */
+uint32_t INPUT_RING_get_time(void);
+
+/*
+ * Empty the ring. Must be called before the producer and the consumer start.
+ */
+void INPUT_RING_initialize(INPUT_RING_t* ring);
+
+/*
+ * Add an event (producer).
+ * @return false when the ring is full: the event is dropped
+ */
+bool INPUT_RING_push(INPUT_RING_t* ring, const INPUT_RING_event_t* event);
+
+/*
+ * Return the oldest event of the ring (consumer).
+ * @return the event, NULL when the ring is empty
+ */
+INPUT_RING_event_t* INPUT_RING_peek(INPUT_RING_t* ring);
+
+/*
+ * Remove the oldest event of the ring (consumer), after INPUT_RING_peek().
+ */
+void INPUT_RING_pop(INPUT_RING_t* ring);
+
+/*
+ * Select the ring that holds the oldest event: merges several rings in time order
+ * (consumer).
+ * @param rings the rings
+ * @param count the number of rings
+ * @return the index of the ring, -1 when all the rings are empty
+ */
+int32_t INPUT_RING_oldest(INPUT_RING_t* const* rings, uint32_t count);
+
+/*
+ * Check whether events have been dropped since the last call (consumer).
+ * @return true when the consumer has to resynchronize the input state
+ */
+bool INPUT_RING_overflowed(INPUT_RING_t* ring);
+
+#endif
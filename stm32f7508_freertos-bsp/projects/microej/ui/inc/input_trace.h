@@ -0,0 +1,144 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef _INPUT_TRACE
+#define _INPUT_TRACE
+
+/*
+ * Latency tracing of the touch events, from the touch interrupt to the MicroUI pump.
+ * Each touch event added to the MicroUI queue is timestamped at each stage of the input
+ * pipeline (time base: TOUCH_HELPER_get_time()):
+ * - sample: the FT5336 interrupt (EXTI) signals the sample,
+ * - read: the sample registers have been read (I2C DMA, at once or deferred by the IO
+ *   task when the sampling rate is limited),
+ * - queued: the IO task gives the sample to the touch helper (see input_ring.h), which
+ *   adds the event to the MicroUI queue (a move can be kept by the coalescing),
+ * - dispatched: the MicroUI pump reads the event to give it to the Java event generator.
+ *
+ * The latency of each stage is recorded in a rolling histogram. The tracing also gives
+ * the high-water mark of the MicroUI queue.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "input_trace_conf.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Latency stages (see INPUT_TRACE_get_percentile())
+ */
+#define INPUT_TRACE_STAGE_READ 0		// from the sample to the end of its read
+#define INPUT_TRACE_STAGE_HELPER 1		// from the end of the read to the MicroUI queue
+#define INPUT_TRACE_STAGE_QUEUE 2		// from the MicroUI queue to the MicroUI pump
+#define INPUT_TRACE_STAGE_TOTAL 3		// from the sample to the MicroUI pump
+#define INPUT_TRACE_STAGES 4
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * Statistics of the MicroUI queue
+ */
+typedef struct
+{
+	uint32_t size;				// size of the MicroUI queue (events and data)
+	uint32_t high_water_mark;	// maximum number of elements not read by the MicroUI pump
+	uint32_t full;				// elements not added because the queue was full
+	uint32_t untraced;			// touch events not traced (more than INPUT_TRACE_EVENTS_IN_FLIGHT)
+} INPUT_TRACE_queue_statistics_t;
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Notify the MicroUI queue has been initialized (called by the queue logger).
+ * @param size the size of the queue
+ */
+void INPUT_TRACE_queue_init(uint32_t size);
+
+/*
+ * Notify an element has been added to the MicroUI queue (called by the queue logger).
+ * @param length the number of elements not read by the MicroUI pump
+ */
+void INPUT_TRACE_queue_add(uint32_t length);
+
+/*
+ * Notify an element has not been added because the MicroUI queue is full (called by the
+ * queue logger).
+ */
+void INPUT_TRACE_queue_full(void);
+
+/*
+ * Start the trace of a touch event just added to the MicroUI queue.
+ * @param index the index of the event in the queue
+ * @param sample_time the time of the touch sample
+ * @param read_time the end of the read of the touch sample
+ */
+void INPUT_TRACE_event_added(uint32_t index, uint32_t sample_time, uint32_t read_time);
+
+/*
+ * Notify an event has been read by the MicroUI pump (called by the queue logger): ends
+ * the trace of the event, if any.
+ * @param index the index of the event in the queue
+ */
+void INPUT_TRACE_event_read(uint32_t index);
+
+/*
+ * Return a percentile of the latency of a stage over the last
+ * INPUT_TRACE_HISTOGRAM_EVENTS events, in microseconds (upper bound of the histogram
+ * bucket), 0 when no event has been traced.
+ *
+ * @param stage INPUT_TRACE_STAGE_READ, INPUT_TRACE_STAGE_HELPER, INPUT_TRACE_STAGE_QUEUE
+ * or INPUT_TRACE_STAGE_TOTAL
+ * @param percentile the percentile (1 to 100: 50, 95, 99...)
+ */
+uint32_t INPUT_TRACE_get_percentile(int32_t stage, int32_t percentile);
+
+/*
+ * Copy the latency histogram of a stage: the bucket i counts the events of the window
+ * with a latency between i and i+1 times INPUT_TRACE_HISTOGRAM_BUCKET_US.
+ *
+ * @param stage the stage (see INPUT_TRACE_get_percentile())
+ * @param buckets the array to fill
+ * @param length the length of the array (at most INPUT_TRACE_HISTOGRAM_BUCKETS are set)
+ * @return the number of events in the window
+ */
+uint32_t INPUT_TRACE_get_histogram(int32_t stage, uint16_t* buckets, uint32_t length);
+
+/*
+ * Get the statistics of the MicroUI queue.
+ * @param stats the statistics to fill
+ * @param reset MICROEJ_TRUE to reset the high-water mark and the counters
+ */
+void INPUT_TRACE_get_queue_statistics(INPUT_TRACE_queue_statistics_t* stats, uint8_t reset);
+
+/*
+ * Clear the latency histograms.
+ */
+void INPUT_TRACE_reset(void);
+
+/*
+ * Print the percentiles and the histograms of the stages and the statistics of the
+ * MicroUI queue (see LLUI_DEBUG_TRACE).
+ */
+void INPUT_TRACE_dump(void);
+
+/* Default Java API ----------------------------------------------------------*/
+
+#ifndef javaInputTraceGetPercentile
+#define javaInputTraceGetPercentile		Java_com_is2t_debug_InputTrace_getPercentile
+#endif
+#ifndef javaInputTraceGetQueueHighWaterMark
+#define javaInputTraceGetQueueHighWaterMark		Java_com_is2t_debug_InputTrace_getQueueHighWaterMark
+#endif
+#ifndef javaInputTraceReset
+#define javaInputTraceReset		Java_com_is2t_debug_InputTrace_reset
+#endif
+#ifndef javaInputTraceDump
+#define javaInputTraceDump		Java_com_is2t_debug_InputTrace_dump
+#endif
+
+#endif	// _INPUT_TRACE
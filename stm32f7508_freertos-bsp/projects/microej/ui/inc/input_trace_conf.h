@@ -0,0 +1,56 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef _INPUT_TRACE_CONF
+#define _INPUT_TRACE_CONF
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "touch_helper_configuration.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Comment / uncomment it to disable / enable the tracing of the touch events and of the
+ * MicroUI queue. Requires the MicroUI queue logger (MICROUIEVENTDECODER_ENABLED in
+ * microui_event_decoder_conf.h).
+ */
+#define INPUT_TRACE_ENABLED
+
+/*
+ * The tracing replaces the touch-to-event latency statistics of the touch helper: a
+ * configuration which still defines TOUCH_LATENCY_ENABLED (touch_helper_configuration.h)
+ * enables it. The touch-to-event latency is the INPUT_TRACE_STAGE_TOTAL stage; the
+ * latency fields of TOUCH_HELPER_statistics_t are removed.
+ */
+#if defined(TOUCH_LATENCY_ENABLED) && !defined(INPUT_TRACE_ENABLED)
+#define INPUT_TRACE_ENABLED
+#endif
+
+/*
+ * Number of events in the rolling window of the latency histograms (at most 65535)
+ */
+#define INPUT_TRACE_HISTOGRAM_EVENTS 128
+
+/*
+ * Width of a bucket of the latency histograms, in microseconds
+ */
+#define INPUT_TRACE_HISTOGRAM_BUCKET_US 250
+
+/*
+ * Number of buckets of the latency histograms (at most 256). The last bucket holds all
+ * the latencies greater than its lower bound (50ms by default).
+ */
+#define INPUT_TRACE_HISTOGRAM_BUCKETS 200
+
+/*
+ * Number of touch events traced at the same time (added to the MicroUI queue and not
+ * read yet by the MicroUI pump). With the coalescing of the moves, there are rarely more
+ * than three (press, move and release).
+ */
+#define INPUT_TRACE_EVENTS_IN_FLIGHT 8
+
+#endif
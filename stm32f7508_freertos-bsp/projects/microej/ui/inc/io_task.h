@@ -21,4 +21,10 @@
  */
 uint8_t IO_TASK_create_task(void);
 
+/**
+ * @brief  Wake up the IO task from an interrupt: the task sends the events of the input
+ * rings to MicroUI and calls TOUCH_MANAGER_work()
+ */
+void IO_TASK_wake_up_from_isr(void);
+
 #endif
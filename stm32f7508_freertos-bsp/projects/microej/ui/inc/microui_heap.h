@@ -21,11 +21,25 @@
 // -----------------------------------------------------------------------------
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#include "LLUI_DISPLAY_impl.h"
+#include "microui_heap_conf.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// -----------------------------------------------------------------------------
+// Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Number of elements of the free blocks histogram (see
+ * MICROUI_HEAP_free_blocks_histogram()).
+ */
+#define MICROUI_HEAP_HISTOGRAM_SIZE (6U)
+
 // -----------------------------------------------------------------------------
 // API
 // -----------------------------------------------------------------------------
@@ -57,6 +71,127 @@ uint32_t MICROUI_HEAP_free_space(void);
  */
 uint32_t MICROUI_HEAP_number_of_allocated_blocks(void);
 
+/*
+ * @brief Returns the size in bytes of the largest free block of the best fit
+ * allocator: the largest image buffer that can be allocated (minus the block header
+ * and footer).
+ *
+ * Returns 0 when the metrics are not available (more than MICROUI_HEAP_TRACKED_BLOCKS
+ * blocks allocated by the best fit allocator).
+ */
+uint32_t MICROUI_HEAP_largest_free_block(void);
+
+/*
+ * @brief Fills the histogram of the free blocks of the best fit allocator. The
+ * element i is the number of free blocks whose size is lower than (1024 << (2 * i))
+ * bytes (and higher than or equal to the previous limit); the last element counts the
+ * free blocks larger than or equal to 256KB:
+ * 	- [0]: < 1KB
+ * 	- [1]: < 4KB
+ * 	- [2]: < 16KB
+ * 	- [3]: < 64KB
+ * 	- [4]: < 256KB
+ * 	- [5]: >= 256KB
+ *
+ * A lot of small free blocks with a small largest free block means that the heap is
+ * fragmented.
+ *
+ * @param[out] histogram the array to fill.
+ *
+ * @return false when the metrics are not available (see MICROUI_HEAP_largest_free_block()).
+ */
+bool MICROUI_HEAP_free_blocks_histogram(uint32_t histogram[MICROUI_HEAP_HISTOGRAM_SIZE]);
+
+/*
+ * @brief Tells whether an address is in the MicroUI image heap: the pixels of the images
+ * decoded at runtime and of the BufferedImages, whose content can change at the same
+ * address.
+ *
+ * @param[in] addr the address to check.
+ *
+ * @return true when the address is in the heap.
+ */
+bool MICROUI_HEAP_contains(const uint8_t* addr);
+
+/*
+ * @brief Returns the number of closed images moved by the heap compaction (see
+ * MICROUI_HEAP_COMPACTION_ENABLED).
+ */
+uint32_t MICROUI_HEAP_compaction_moves(void);
+
+/*
+ * @brief Returns the number of pages of the small blocks area in use (see
+ * MICROUI_HEAP_SLAB_ENABLED).
+ */
+uint32_t MICROUI_HEAP_number_of_used_pages(void);
+
+/*
+ * @brief Returns the number of decodings avoided by the decoded images cache (see
+ * MICROUI_HEAP_CACHE_ENABLED).
+ */
+uint32_t MICROUI_HEAP_cache_hits(void);
+
+/*
+ * @brief Returns the number of images decoded because they were not in the decoded
+ * images cache.
+ */
+uint32_t MICROUI_HEAP_cache_misses(void);
+
+/*
+ * @brief Returns the number of closed images freed by the decoded images cache
+ * (budget exceeded, heap full or no more entries).
+ */
+uint32_t MICROUI_HEAP_cache_evictions(void);
+
+/*
+ * @brief Returns the size in bytes of the closed images kept by the decoded images
+ * cache. This size is not included in MICROUI_HEAP_free_space().
+ */
+uint32_t MICROUI_HEAP_cache_size(void);
+
+/*
+ * @brief Gives back the pixels of an image already decoded, closed by the application
+ * and still in the cache. The image buffer is allocated (in place of the cached one)
+ * and the image data is filled.
+ *
+ * @param[in] addr the encoded image address.
+ * @param[in] length the encoded image size in bytes.
+ * @param[in] expectedFormat the format requested to the decoder.
+ * @param[out] image the MicroUI image to fill.
+ * @param[out] isFullyOpaque true when the cached image is fully opaque.
+ *
+ * @return true when the image has been found; false when it must be decoded.
+ */
+bool MICROUI_HEAP_cache_get(uint8_t* addr, uint32_t length, uint8_t expectedFormat, MICROUI_Image* image, bool* isFullyOpaque);
+
+/*
+ * @brief Starts the decoding of an image not found in the cache: the next allocation is
+ * considered as the image buffer. Must be followed by MICROUI_HEAP_cache_stop().
+ *
+ * @param[in] addr the encoded image address.
+ * @param[in] length the encoded image size in bytes.
+ * @param[in] expectedFormat the format requested to the decoder.
+ */
+void MICROUI_HEAP_cache_start(uint8_t* addr, uint32_t length, uint8_t expectedFormat);
+
+/*
+ * @brief Ends the decoding of the image. A decoded image is added to the cache.
+ *
+ * @param[in] image the decoded MicroUI image.
+ * @param[in] isFullyOpaque true when the decoded image is fully opaque.
+ * @param[in] decoded true when the image has been successfully decoded.
+ */
+void MICROUI_HEAP_cache_stop(MICROUI_Image* image, bool isFullyOpaque, bool decoded);
+
+/*
+ * @brief Notifies the cache that the pixels of an opened image are modified (the
+ * destination of a conversion, see grayscale.c): the image is no longer given back by
+ * MICROUI_HEAP_cache_get() and its buffer is freed when the image is closed.
+ *
+ * @param[in] image the modified MicroUI image.
+ */
+void MICROUI_HEAP_cache_modified(MICROUI_Image* image);
+
 // -----------------------------------------------------------------------------
 // EOF
 // -----------------------------------------------------------------------------
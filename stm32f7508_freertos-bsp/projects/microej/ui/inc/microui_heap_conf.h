@@ -0,0 +1,135 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief This file allows to configure the implementation of LLUI_DISPLAY_HEAP_impl.c.
+ * @author MicroEJ Developer Team
+ * @version 3.1.0
+ * @since MicroEJ UI Pack 13.1.0
+ */
+
+#if !defined MICROUI_HEAP_CONF_H
+#define MICROUI_HEAP_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Defines
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief When defined, the images decoded at runtime (see LLUI_DISPLAY_IMPL_decodeImage())
+ * are kept in the images heap after being closed by the application. When the same
+ * encoded image is decoded again in the same format, the cached pixels are given
+ * back without decoding the image.
+ *
+ * The cached images are freed (least recently used first) when their total size
+ * exceeds MICROUI_HEAP_CACHE_BUDGET or when an allocation fails.
+ *
+ * By default the cache is enabled.
+ */
+#define MICROUI_HEAP_CACHE_ENABLED
+
+/*
+ * @brief Maximum size in bytes of the closed images kept in the images heap.
+ */
+#define MICROUI_HEAP_CACHE_BUDGET (128U * 1024U)
+
+/*
+ * @brief Maximum number of decoded images followed by the cache (opened and closed
+ * images).
+ */
+#define MICROUI_HEAP_CACHE_ENTRIES (16U)
+
+/*
+ * @brief Read-only memory of the application resources (QSPI flash, see the linker
+ * file). An encoded image in this area is identified by its address and its length:
+ * it is hashed only when its address is not found in the cache. The other encoded
+ * images (loaded in RAM, their buffer may be reused) are identified by the hash of their
+ * content.
+ */
+#define MICROUI_HEAP_CACHE_RESOURCES_START (0x90000000U)
+#define MICROUI_HEAP_CACHE_RESOURCES_END (0x91000000U)
+
+/*
+ * @brief When defined, the closed images kept by the cache (see MICROUI_HEAP_CACHE_ENABLED)
+ * are moved with the DMA2D to merge the free blocks around them when an allocation fails
+ * (before freeing them) and when the heap is fragmented after a free. The images used by
+ * the application cannot be moved: the Graphics Engine owns their addresses.
+ *
+ * By default the compaction is enabled.
+ */
+#define MICROUI_HEAP_COMPACTION_ENABLED
+
+/*
+ * @brief Fragmentation (percentage of the free space outside the largest free block)
+ * above which the heap is compacted after a free.
+ */
+#define MICROUI_HEAP_COMPACTION_THRESHOLD (50U)
+
+/*
+ * @brief Maximum number of closed images moved by a free when the heap is fragmented:
+ * bounds the duration of a free (a move waits for the DMA2D copy of the image). The
+ * next frees go on with the compaction. A failed allocation moves as many images as
+ * required.
+ */
+#define MICROUI_HEAP_COMPACTION_MOVES_PER_FREE (1U)
+
+#if defined(MICROUI_HEAP_COMPACTION_ENABLED) && !defined(MICROUI_HEAP_CACHE_ENABLED)
+#error "The heap compaction requires the decoded images cache (MICROUI_HEAP_CACHE_ENABLED)"
+#endif
+
+/*
+ * @brief When defined, the small blocks (up to 1024 bytes: decoders' structures and
+ * scratch buffers, Huffman tables, small images) are allocated in an area reserved at
+ * the beginning of the heap. This area is divided in pages, each page holds blocks
+ * of the same size (32, 64, 128, 256, 512 or 1024 bytes). The other blocks (pixels
+ * buffers) are allocated by the best fit allocator, in the rest of the heap, which is
+ * no longer fragmented by the small blocks. When the small blocks area is full, the
+ * small blocks are allocated by the best fit allocator.
+ *
+ * By default the small blocks area is enabled.
+ */
+#define MICROUI_HEAP_SLAB_ENABLED
+
+/*
+ * @brief Size in bytes of the small blocks area.
+ */
+#define MICROUI_HEAP_SLAB_SIZE (64U * 1024U)
+
+/*
+ * @brief Size in bytes of a page of the small blocks area.
+ */
+#define MICROUI_HEAP_SLAB_PAGE_SIZE (4U * 1024U)
+
+/*
+ * @brief Maximum number of blocks allocated by the best fit allocator that are tracked
+ * to compute the fragmentation metrics (see MICROUI_HEAP_largest_free_block()) and to
+ * find the free areas around the closed images (see MICROUI_HEAP_COMPACTION_ENABLED).
+ * The array of tracked blocks uses 4 bytes per block.
+ *
+ * When more blocks are allocated, the metrics are not available
+ * (MICROUI_HEAP_largest_free_block() returns 0, MICROUI_HEAP_free_blocks_histogram()
+ * returns false) and the heap is not compacted until enough blocks are freed. With the
+ * small blocks area (see MICROUI_HEAP_SLAB_ENABLED), the best fit allocator holds the
+ * blocks larger than 1024 bytes (pixels buffers): 128 blocks cover the images
+ * opened at the same time by most applications. Increase this value for an application
+ * that keeps more decoded images or buffered images.
+ */
+#define MICROUI_HEAP_TRACKED_BLOCKS (128U)
+
+// -----------------------------------------------------------------------------
+// EOF
+// -----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // MICROUI_HEAP_CONF_H
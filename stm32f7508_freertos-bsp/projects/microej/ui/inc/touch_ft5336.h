@@ -0,0 +1,108 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef _TOUCH_FT5336
+#define _TOUCH_FT5336
+
+/*
+ * Sampling state machine of the FT5336 touch controller. The FT5336 (trigger mode)
+ * raises its interrupt line when a new touch sample is available; the state machine
+ * decides when the sample registers are read and decodes them. It does not access the
+ * hardware: the touch manager starts the registers reads (I2C DMA) and gives the
+ * results back, so the state machine can be run with a simulated controller.
+ *
+ * All the functions must be called with the touch interrupts masked or from these
+ * interrupts (they have the same priority).
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "touch_gesture.h"
+#include "input_ring.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Registers read for each sample: TD_STATUS and the registers of the first
+ * TOUCH_GESTURE_MAX_POINTS touch points (Pn_XH, Pn_XL, Pn_YH, Pn_YL, Pn_WEIGHT and
+ * Pn_MISC); the second point is only used by the gesture recognizer
+ */
+#define TOUCH_FT5336_REG_FIRST	0x02
+#define TOUCH_FT5336_REG_COUNT	(1 + (6 * TOUCH_GESTURE_MAX_POINTS))
+
+/*
+ * Delay returned by TOUCH_FT5336_work() when there is nothing to schedule
+ */
+#define TOUCH_FT5336_NO_DELAY	UINT32_MAX
+
+/* Enums ---------------------------------------------------------------------*/
+
+typedef enum
+{
+	TOUCH_FT5336_NONE,	// nothing to do
+	TOUCH_FT5336_READ,	// start a read of the sample registers
+	TOUCH_FT5336_WAKE,	// call TOUCH_FT5336_work() from a task
+} TOUCH_FT5336_action_t;
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Reset the state machine: touch released, no read in progress.
+ */
+void TOUCH_FT5336_initialize(void);
+
+/*
+ * Notify the state machine the FT5336 has a new sample (interrupt line).
+ * @param now the current time in microseconds
+ * @return the action to perform
+ */
+TOUCH_FT5336_action_t TOUCH_FT5336_data_ready(uint32_t now);
+
+/*
+ * Notify the state machine the sample registers have been read.
+ * @param regs the TOUCH_FT5336_REG_COUNT registers from TOUCH_FT5336_REG_FIRST
+ * @param now the current time in microseconds
+ * @param sample the touch event to fill with the decoded sample
+ * @return the action to perform (a new read when a sample is pending)
+ */
+TOUCH_FT5336_action_t TOUCH_FT5336_read_done(const uint8_t* regs, uint32_t now, INPUT_RING_event_t* sample);
+
+/*
+ * Notify the state machine the read of the sample registers has failed. The read is
+ * retried later.
+ * @return the action to perform
+ */
+TOUCH_FT5336_action_t TOUCH_FT5336_read_error(void);
+
+/*
+ * Notify the state machine a sample has been lost (the touch ring was full): the current
+ * sample is read again by the next call to TOUCH_FT5336_work().
+ * @param now the current time in microseconds
+ */
+void TOUCH_FT5336_resync(uint32_t now);
+
+/*
+ * Run the deferred actions: the samples received too early (see TOUCH_SAMPLING_RATE_HZ)
+ * and the check of the pressed touch (see TOUCH_RELEASE_TIMEOUT_MS).
+ * @param now the current time in microseconds
+ * @param delay the delay in microseconds before the next call, TOUCH_FT5336_NO_DELAY
+ * when the next call can wait for a TOUCH_FT5336_WAKE action
+ * @return TOUCH_FT5336_READ or TOUCH_FT5336_NONE
+ */
+TOUCH_FT5336_action_t TOUCH_FT5336_work(uint32_t now, uint32_t* delay);
+
+/*
+ * Decode the sample registers. The released points are skipped.
+ * @param regs the TOUCH_FT5336_REG_COUNT registers from TOUCH_FT5336_REG_FIRST
+ * @param points the TOUCH_GESTURE_MAX_POINTS touch points on the display
+ * @return the number of points set, 0 when the touch is released
+ */
+uint32_t TOUCH_FT5336_decode(const uint8_t* regs, TOUCH_GESTURE_point_t* points);
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef _TOUCH_GESTURE
+#define _TOUCH_GESTURE
+
+/*
+ * Native gesture recognizer. It receives the touch points of each sample (up to two
+ * fingers) and sends one compact event per gesture to a MicroUI generic event generator
+ * (see EVENT_GENERATOR_gesture()), in addition to the press, move and release events of
+ * the touch event generator.
+ *
+ * A gesture event holds three 32-bit values:
+ * - [0]: gesture type (bits 31-24, see TOUCH_GESTURE_xxx) and flags (bits 23-0, see
+ *   TOUCH_GESTURE_FLAG_xxx),
+ * - [1]: position: x (bits 31-16) and y (bits 15-0),
+ * - [2]: value: the velocity of a fling in pixels per second (vx: signed bits 31-16,
+ *   vy: signed bits 15-0), the scale of a pinch in 1/256 (256: the distance between the
+ *   fingers at the start of the pinch), 0 for a long press.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "touch_helper_configuration.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Gesture types
+ */
+#define TOUCH_GESTURE_LONG_PRESS	1	// one finger held still (position: the finger)
+#define TOUCH_GESTURE_FLING			2	// one finger released while moving (position: the release point)
+#define TOUCH_GESTURE_PINCH			3	// two fingers moving apart or together (position: the center)
+
+/*
+ * Gesture flags
+ */
+#define TOUCH_GESTURE_FLAG_END		0x000001	// last event of a pinch (a finger has been released)
+
+#define TOUCH_GESTURE_EVENT_SIZE	3
+
+/*
+ * Maximum number of touch points managed by the recognizer
+ */
+#define TOUCH_GESTURE_MAX_POINTS	2
+
+/* Structs -------------------------------------------------------------------*/
+
+typedef struct
+{
+	uint16_t x;
+	uint16_t y;
+} TOUCH_GESTURE_point_t;
+
+/* API -----------------------------------------------------------------------*/
+
+/*
+ * Reset the recognizer: no finger on the touch panel.
+ */
+void TOUCH_GESTURE_initialize(void);
+
+/*
+ * Notify the recognizer of a touch sample. Must be called in the same context as the
+ * touch helper.
+ * @param points the fingers on the touch panel (the first one is the touch helper's one)
+ * @param count the number of fingers, 0 when the touch is released
+ * @param time the sample time in microseconds (see TOUCH_HELPER_get_time())
+ */
+void TOUCH_GESTURE_update(const TOUCH_GESTURE_point_t* points, uint32_t count, uint32_t time);
+
+#endif
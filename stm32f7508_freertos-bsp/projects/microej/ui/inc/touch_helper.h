@@ -13,8 +13,32 @@
 
 #include <stdint.h>
 
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * Statistics of the touch events
+ */
+typedef struct
+{
+	uint32_t moves;				// move events added to the MicroUI queue
+	uint32_t coalesced;			// moves replaced by a newer move before being sent
+} TOUCH_HELPER_statistics_t;
+
 /* API -----------------------------------------------------------------------*/
 
+/*
+ * Return the time base of the touch samples in microseconds.
+ */
+uint32_t TOUCH_HELPER_get_time(void);
+
+/*
+ * Set the times of the sample notified by the next call to TOUCH_HELPER_pressed() or
+ * TOUCH_HELPER_released() (see input_trace.h).
+ * @param time the sample time (see TOUCH_HELPER_get_time())
+ * @param read_time the end of the read of the sample
+ */
+void TOUCH_HELPER_set_sample_time(uint32_t time, uint32_t read_time);
+
 /*
  * Notify to an event handler a touch has been pressed.
  * @param x the pointer X coordinate
@@ -34,4 +58,24 @@ void TOUCH_HELPER_moved(int32_t x, int32_t y);
  */
 void TOUCH_HELPER_released(void);
 
+/*
+ * Notify an event has been added to the MicroUI queue (called by the queue logger).
+ * @param index the index of the event in the queue
+ */
+void TOUCH_HELPER_queue_added(uint32_t index);
+
+/*
+ * Notify an event has been read from the MicroUI queue by the MicroUI pump (called by
+ * the queue logger).
+ * @param index the index of the event in the queue
+ */
+void TOUCH_HELPER_queue_read(uint32_t index);
+
+/*
+ * Get the statistics of the touch events.
+ * @param stats the statistics to fill
+ * @param reset MICROEJ_TRUE to reset the statistics
+ */
+void TOUCH_HELPER_get_statistics(TOUCH_HELPER_statistics_t* stats, uint8_t reset);
+
 #endif
@@ -17,4 +17,39 @@
 // Number of pixels to generate a move after a move
 #define MOVE_PIXEL_LIMIT		2
 
+// Maximum sampling rate of the touch controller while the touch is pressed (Hz): the
+// samples signaled faster are read at the end of the sampling period
+#define TOUCH_SAMPLING_RATE_HZ	120
+
+// Delay without sample after which a pressed touch is read again (ms): a lost "put up"
+// sample would keep the touch pressed
+#define TOUCH_RELEASE_TIMEOUT_MS	100
+
+// Comment / uncomment it to disable / enable the coalescing of the move events: a move
+// is not added to the MicroUI queue while the previous move has not been read by the
+// MicroUI pump; its coordinates are kept and replaced by the next ones. Requires the
+// MicroUI queue logger (MICROUIEVENTDECODER_ENABLED in microui_event_decoder_conf.h).
+#define TOUCH_MOVE_COALESCING_ENABLED
+
+// Uncomment it to enable the gesture recognizer (see touch_gesture.h). The gesture events
+// are sent to the generic event generator MICROUI_EVENTGEN_GESTURES: declare it in the
+// platform configuration (microui.xml) with the application's event generator class:
+//   <eventgenerator name="GESTURES" class="com.mycompany.GestureEventGenerator"/>
+//#define TOUCH_GESTURE_ENABLED
+
+// Delay a finger stays still before a long press (ms)
+#define TOUCH_GESTURE_LONG_PRESS_MS		500
+
+// Distance a finger can move and still be considered still (pixels)
+#define TOUCH_GESTURE_SLOP				8
+
+// Duration of the moves used to compute the velocity of a fling (ms)
+#define TOUCH_GESTURE_FLING_WINDOW_MS	100
+
+// Minimum velocity of a fling (pixels per second)
+#define TOUCH_GESTURE_FLING_VELOCITY	300
+
+// Minimum scale change between two pinch events (1/256)
+#define TOUCH_GESTURE_PINCH_STEP		8
+
 #endif
@@ -12,11 +12,38 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include <stdint.h>
+#include "input_ring.h"
 
 /* API -----------------------------------------------------------------------*/
 
 void TOUCH_MANAGER_initialize(void);
+
+/*
+ * Manage the touch controller interrupt line (EXTI).
+ * @return MICROEJ_TRUE when the IO task has to call TOUCH_MANAGER_work()
+ */
 uint8_t TOUCH_MANAGER_interrupt(void);
-uint8_t TOUCH_MANAGER_work(void );
+
+/*
+ * Run the deferred touch reads (IO task), and read the touch state again when a sample
+ * has been lost.
+ * @return the delay in microseconds before the next call, TOUCH_FT5336_NO_DELAY when
+ * the next call waits for a touch interrupt
+ */
+uint32_t TOUCH_MANAGER_work(void);
+
+/*
+ * Return the ring of the touch samples (consumer: the IO task).
+ */
+INPUT_RING_t* TOUCH_MANAGER_get_ring(void);
+
+/*
+ * Send a touch sample of the ring to the touch helper and to the gesture recognizer
+ * (IO task, in the MicroUI input critical section).
+ */
+void TOUCH_MANAGER_dispatch(const INPUT_RING_event_t* event);
+
+void TOUCH_MANAGER_enable_interrupts(void);
+void TOUCH_MANAGER_disable_interrupts(void);
 
 #endif
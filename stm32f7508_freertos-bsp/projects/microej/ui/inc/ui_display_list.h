@@ -0,0 +1,229 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_DISPLAY_LIST_H
+#define UI_DISPLAY_LIST_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Records the static regions of the screens (backgrounds, frames, labels) and
+ * draws them again with a single DMA2D copy.
+ *
+ * The drawings of a region are surrounded by "UI_DISPLAY_LIST_begin()" and
+ * "UI_DISPLAY_LIST_end()". The first time, the drawings are performed as usual and their
+ * sequence (drawing, arguments, color and clip) is folded in a hash; at the end, the
+ * region's pixels are copied in a buffer allocated in the images heap. The next times,
+ * the drawings are not performed, only hashed: when the hash is the same, the buffer is
+ * copied in the region. Otherwise "UI_DISPLAY_LIST_end()" returns false and the
+ * application must draw the region again (the drawings are then recorded):
+ *
+ *   do {
+ *       DisplayList.begin(g, x, y, width, height);
+ *       drawChrome(g);
+ *   } while (!DisplayList.end(g));
+ *
+ * The recorded drawings are the drawings of LLUI_PAINTER_impl.c and LLDW_PAINTER_impl.c
+ * (and of ui_glyph_atlas.c) in the graphics context of the region. The application must
+ * respect these rules:
+ * - the drawings must cover the whole region (the pixels drawn before are replaced),
+ * - the images drawn in the region must not change (the images are identified by their
+ *   pixels address), otherwise the region must be invalidated (see
+ *   "UI_DISPLAY_LIST_invalidate()"),
+ * - the regions must not be nested.
+ *
+ * The other drawings are not hashed: the strings drawn by the Graphics Engine, the
+ * drawings of the BSP that notify the display list (see "UI_DISPLAY_LIST_notify_drawing()")
+ * and the drawings of the images of the images heap (BufferedImages, decoded images). A
+ * region that holds such a drawing is not recorded: it is drawn as usual until it is
+ * invalidated.
+ *
+ * The display list is used by the Graphics Engine task only (drawings). The regions are
+ * recorded in the graphics contexts in the display format only.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <LLUI_PAINTER_impl.h>
+#include <sni.h>
+
+#include "ui_display_list_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Display list counters (see "UI_DISPLAY_LIST_get_statistics()").
+ */
+typedef struct {
+	uint32_t hits; // regions copied from their buffer
+	uint32_t renders; // regions drawn and recorded
+	uint32_t misses; // regions drawn again because their drawings have changed
+	uint32_t uncached; // regions drawn without being recorded (too small, no memory, etc.)
+	uint32_t invalidations; // recorded regions invalidated by the application
+} UI_DISPLAY_LIST_statistics_t;
+
+// --------------------------------------------------------------------------------
+// Public API
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Starts the drawings of a region. The region is clipped by the clip of the
+ * graphics context. Must be called by a drawing native (see
+ * "LLUI_DISPLAY_requestDrawing()").
+ *
+ * @param[in] gc the destination.
+ * @param[in] x the region's X coordinate.
+ * @param[in] y the region's Y coordinate.
+ * @param[in] width the region's width.
+ * @param[in] height the region's height.
+ */
+void UI_DISPLAY_LIST_begin(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height);
+
+/*
+ * @brief Ends the drawings of the region: records the region or copies its buffer.
+ * Must be called by a drawing native (see "LLUI_DISPLAY_requestDrawing()").
+ *
+ * @param[in] gc the destination.
+ * @param[out] status DRAWING_RUNNING when the DMA2D copies the region, DRAWING_DONE
+ * otherwise.
+ *
+ * @return false when the drawings have not been performed: the region must be drawn
+ * again.
+ */
+bool UI_DISPLAY_LIST_end(MICROUI_GraphicsContext* gc, DRAWING_Status* status);
+
+/*
+ * @brief Requests a drawing (see "LLUI_DISPLAY_requestDrawing()") and records it when
+ * a region is started in the graphics context. Called by the painters instead of
+ * "LLUI_DISPLAY_requestDrawing()".
+ *
+ * @param[in] gc the destination.
+ * @param[in] callback the native to call again when the Graphics Engine is busy.
+ * @param[in] drawing the drawing identifier.
+ * @param[in] args the drawing's arguments.
+ * @param[in] count the number of arguments.
+ *
+ * @return true when the drawing must be performed, false otherwise (like
+ * "LLUI_DISPLAY_requestDrawing()"; the drawing status is already set when the drawing
+ * is not performed because its region is copied).
+ */
+bool UI_DISPLAY_LIST_request_drawing(MICROUI_GraphicsContext* gc, SNI_callback callback, uint32_t drawing, const jint* args, uint32_t count);
+
+/*
+ * @brief Gives a drawing argument that identifies an image: its pixels address, size and
+ * format. The next drawing is not hashed when the image is in the images heap (see
+ * "MICROUI_HEAP_contains()").
+ *
+ * @param[in] img the image.
+ *
+ * @return the image identifier (0 when no region is started).
+ */
+jint UI_DISPLAY_LIST_image(MICROUI_Image* img);
+
+/*
+ * @brief Notifies a drawing that is not hashed (see "UI_DISPLAY_LIST_request_drawing()"):
+ * when it is performed in the started region, the region is not copied back and is drawn
+ * as usual until it is invalidated. Called by the BSP drawings that do not use the
+ * painters (layers composition, grayscale conversion, etc.).
+ *
+ * @param[in] img the destination.
+ * @param[in] x1 the top-left X coordinate of the drawing.
+ * @param[in] y1 the top-left Y coordinate of the drawing.
+ * @param[in] x2 the bottom-right X coordinate of the drawing.
+ * @param[in] y2 the bottom-right Y coordinate of the drawing.
+ */
+void UI_DISPLAY_LIST_notify_drawing(MICROUI_Image* img, jint x1, jint y1, jint x2, jint y2);
+
+/*
+ * @brief Gives a drawing argument that identifies a float value.
+ *
+ * @param[in] value the value.
+ *
+ * @return the value's bits.
+ */
+static inline jint UI_DISPLAY_LIST_float(jfloat value) {
+	jint bits;
+	(void)memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/*
+ * @brief Folds some data in a hash (FNV-1a). Gives a drawing argument that identifies
+ * a sequence of values (characters, etc.).
+ *
+ * @param[in] hash the current hash (0 for a new hash).
+ * @param[in] data the data.
+ * @param[in] size the data size in bytes.
+ *
+ * @return the new hash.
+ */
+uint32_t UI_DISPLAY_LIST_hash(uint32_t hash, const void* data, uint32_t size);
+
+/*
+ * @brief Invalidates the recorded regions that intersect a rectangle: these regions are
+ * drawn and recorded again the next time (the regions that hold some drawings that are
+ * not hashed are recorded again too). Must be called by the Graphics Engine task
+ * (in a native).
+ *
+ * @param[in] x the rectangle's X coordinate.
+ * @param[in] y the rectangle's Y coordinate.
+ * @param[in] width the rectangle's width.
+ * @param[in] height the rectangle's height.
+ */
+void UI_DISPLAY_LIST_invalidate(jint x, jint y, jint width, jint height);
+
+/*
+ * @brief Gets the display list counters since the last reset.
+ *
+ * @param[out] statistics the counters.
+ */
+void UI_DISPLAY_LIST_get_statistics(UI_DISPLAY_LIST_statistics_t* statistics);
+
+/*
+ * @brief Resets the display list counters.
+ */
+void UI_DISPLAY_LIST_reset_statistics(void);
+
+/*
+ * @brief Native of "com.microej.ui.DisplayList.begin(GraphicsContext, int, int, int, int)"
+ * (see "UI_DISPLAY_LIST_begin()").
+ */
+void Java_com_microej_ui_DisplayList_begin(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height);
+
+/*
+ * @brief Native of "com.microej.ui.DisplayList.end(GraphicsContext)" (see
+ * "UI_DISPLAY_LIST_end()").
+ */
+jboolean Java_com_microej_ui_DisplayList_end(MICROUI_GraphicsContext* gc);
+
+/*
+ * @brief Native of "com.microej.ui.DisplayList.invalidate(int, int, int, int)" (see
+ * "UI_DISPLAY_LIST_invalidate()").
+ */
+void Java_com_microej_ui_DisplayList_invalidate(jint x, jint y, jint width, jint height);
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // UI_DISPLAY_LIST_H
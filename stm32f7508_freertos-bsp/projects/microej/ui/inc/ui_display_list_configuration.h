@@ -0,0 +1,56 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef UI_DISPLAY_LIST_CONFIGURATION_H
+#define UI_DISPLAY_LIST_CONFIGURATION_H
+
+/**
+ * @file
+ * @brief This file provides the configuration of ui_display_list.c.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Maximum number of recorded regions. When all the regions are used, the region
+ * used the least recently is recorded again for the new region.
+ */
+#define UI_DISPLAY_LIST_REGIONS (8U)
+
+/*
+ * @brief Minimum number of pixels of a recorded region (after the clip). A smaller region
+ * is drawn as usual: drawing it costs less than keeping its pixels.
+ */
+#define UI_DISPLAY_LIST_MIN_PIXELS (1024U)
+
+/*
+ * @brief Define this value to detect the strings drawn by the Graphics Engine in the
+ * recorded regions: the region's pixels are hashed at the beginning and at the end of
+ * the verification (the Graphics Engine drawings are the only ones performed in between).
+ * A region whose pixels have changed is drawn as usual until it is invalidated. Comment
+ * this value when the regions hold no string drawn by the Graphics Engine.
+ */
+#define UI_DISPLAY_LIST_CHECK_PIXELS
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_DISPLAY_LIST_CONFIGURATION_H
@@ -0,0 +1,116 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_DRAWING_BLEND_H
+#define UI_DRAWING_BLEND_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Software blending kernels in a RGB565 destination: blending of RGB565, ARGB8888
+ * and A8 lines, fill with an opacity and conversions between RGB565 and ARGB8888.
+ *
+ * The kernels process one line of pixels. They are used by ui_drawing_dma2d.c to draw
+ * a band of the large images with the CPU while the DMA2D draws the rest of the image
+ * (see DRAWING_DMA2D_SPLIT_MIN_PIXELS).
+ *
+ * The channels are blended with 8 bits of precision:
+ *   c = (fg * a + bg * (255 - a)) / 255 (rounded)
+ * On the cores with the DSP extension (Cortex-M7), both products and the sum are computed
+ * by one "__SMLAD" instruction per channel. Without the DSP extension (Linux host for
+ * instance), the same arithmetic is written in C: both implementations give the same
+ * pixels.
+ *
+ * The kernels do not depend on MicroUI nor on the STM32 HAL.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// --------------------------------------------------------------------------------
+// API
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Blends a line of RGB565 pixels with an opacity. The line is copied when the
+ * opacity is 255.
+ *
+ * @param[in] dest the destination pixels
+ * @param[in] src the source pixels
+ * @param[in] count the number of pixels
+ * @param[in] alpha the opacity to apply (0 to 255)
+ */
+void UI_DRAWING_BLEND_rgb565(uint16_t* dest, const uint16_t* src, uint32_t count, uint32_t alpha);
+
+/*
+ * @brief Blends a line of ARGB8888 pixels: the alpha of each pixel is multiplied by the
+ * opacity.
+ *
+ * @param[in] dest the destination pixels
+ * @param[in] src the source pixels
+ * @param[in] count the number of pixels
+ * @param[in] alpha the opacity to apply (0 to 255)
+ */
+void UI_DRAWING_BLEND_argb8888(uint16_t* dest, const uint32_t* src, uint32_t count, uint32_t alpha);
+
+/*
+ * @brief Blends a color through a line of A8 pixels: the alpha of each pixel is
+ * multiplied by the opacity.
+ *
+ * @param[in] dest the destination pixels
+ * @param[in] src the source alpha values
+ * @param[in] count the number of pixels
+ * @param[in] color the color to blend (RGB888, the alpha is ignored)
+ * @param[in] alpha the opacity to apply (0 to 255)
+ */
+void UI_DRAWING_BLEND_a8(uint16_t* dest, const uint8_t* src, uint32_t count, uint32_t color, uint32_t alpha);
+
+/*
+ * @brief Fills a line with a color and an opacity.
+ *
+ * @param[in] dest the destination pixels
+ * @param[in] count the number of pixels
+ * @param[in] color the color to blend (RGB888, the alpha is ignored)
+ * @param[in] alpha the opacity to apply (0 to 255)
+ */
+void UI_DRAWING_BLEND_fill(uint16_t* dest, uint32_t count, uint32_t color, uint32_t alpha);
+
+/*
+ * @brief Converts a line of ARGB8888 pixels in RGB565 pixels (the alpha is ignored).
+ *
+ * @param[in] dest the destination pixels
+ * @param[in] src the source pixels
+ * @param[in] count the number of pixels
+ */
+void UI_DRAWING_BLEND_argb8888_to_rgb565(uint16_t* dest, const uint32_t* src, uint32_t count);
+
+/*
+ * @brief Converts a line of RGB565 pixels in opaque ARGB8888 pixels.
+ *
+ * @param[in] dest the destination pixels
+ * @param[in] src the source pixels
+ * @param[in] count the number of pixels
+ */
+void UI_DRAWING_BLEND_rgb565_to_argb8888(uint32_t* dest, const uint16_t* src, uint32_t count);
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_DRAWING_BLEND_H
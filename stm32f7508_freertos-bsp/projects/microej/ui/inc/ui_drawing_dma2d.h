@@ -22,6 +22,17 @@ extern "C" {
  * "UI_DRAWING_drawImage()" functions. The third feature "memcpy" is useful when a copy from frame
  * buffer to back buffer is required after the call to "LLUI_DISPLAY_IMPL_flush()".
  *
+ * The scaled and rotated image drawings are implemented in ui_drawing_dma2d_transform.c: the
+ * CPU samples the image in small tiles and the DMA2D blends the tiles (see
+ * "UI_DRAWING_DMA2D_blend_tile()").
+ *
+ * The filled rounded rectangles, circles and ellipses are implemented in
+ * ui_drawing_dma2d_shapes.c: the DMA2D fills the interior rectangles and the software
+ * draws the curved edges (see "UI_DRAWING_DMA2D_fill_tile()").
+ *
+ * The strings drawn with a glyph atlas (see ui_glyph_atlas.h) are blended glyph per glyph
+ * from the atlas in the foreground color (see "UI_DRAWING_DMA2D_blend_alpha()").
+ *
  * How to use this library:
  * - Set the define DRAWING_DMA2D_BPP to 16, 24 or 32 (project global define)
  * - Set the define STM32F4XX, STM32F7XX or STM32H7XX (project global define)
@@ -30,6 +41,17 @@ extern "C" {
  * - Redirect the STM32 DMA2D interrupt routine to "UI_DRAWING_DMA2D_IRQHandler()"
  * - Call "UI_DRAWING_DMA2D_configure_memcpy()" in "LLUI_DISPLAY_IMPL_flush()" before enabling LCD interrupt (optional).
  * - Call "UI_DRAWING_DMA2D_start_memcpy()" in LCD interrupt (optional).
+ * - To copy several rectangles instead of one, fill an array with "UI_DRAWING_DMA2D_prepare_memcpy()"
+ *   and call "UI_DRAWING_DMA2D_configure_memcpy_list()" instead of "UI_DRAWING_DMA2D_configure_memcpy()".
+ *
+ * The large images are shared between the DMA2D and the CPU: the CPU draws the bottom
+ * lines with the software kernels of ui_drawing_blend.h while the DMA2D draws the other
+ * lines (see DRAWING_DMA2D_SPLIT_CPU_SHARE).
+ *
+ * The DMA2D operations are queued (see DRAWING_DMA2D_QUEUE_SIZE): a drawing that requires
+ * several DMA2D operations queues all of them without waiting, and the DMA2D interrupt
+ * starts the next operation by writing the DMA2D registers. The Graphics Engine is notified
+ * at the end of the last operation of each drawing.
  *
  * @author MicroEJ Developer Team
  * @version 4.1.0
@@ -68,9 +90,16 @@ extern "C" {
  */
   
 #define UI_DRAWING_DMA2D_fillRectangle UI_DRAWING_fillRectangle
+#define UI_DRAWING_DMA2D_fillRoundedRectangle UI_DRAWING_fillRoundedRectangle
+#define UI_DRAWING_DMA2D_fillEllipse UI_DRAWING_fillEllipse
+#define UI_DRAWING_DMA2D_fillCircle UI_DRAWING_fillCircle
 #define UI_DRAWING_DMA2D_drawImage UI_DRAWING_drawImage
 #define UI_DRAWING_DMA2D_copyImage UI_DRAWING_copyImage
 #define UI_DRAWING_DMA2D_drawRegion UI_DRAWING_drawRegion
+#define UI_DRAWING_DMA2D_drawRotatedImageNearestNeighbor UI_DRAWING_drawRotatedImageNearestNeighbor
+#define UI_DRAWING_DMA2D_drawRotatedImageBilinear UI_DRAWING_drawRotatedImageBilinear
+#define UI_DRAWING_DMA2D_drawScaledImageNearestNeighbor UI_DRAWING_drawScaledImageNearestNeighbor
+#define UI_DRAWING_DMA2D_drawScaledImageBilinear UI_DRAWING_drawScaledImageBilinear
 
 #else // !defined(LLUI_GC_SUPPORTED_FORMATS) || (LLUI_GC_SUPPORTED_FORMATS <= 1)
 
@@ -81,9 +110,16 @@ extern "C" {
  */
 
 #define UI_DRAWING_DMA2D_fillRectangle UI_DRAWING_fillRectangle_0
+#define UI_DRAWING_DMA2D_fillRoundedRectangle UI_DRAWING_fillRoundedRectangle_0
+#define UI_DRAWING_DMA2D_fillEllipse UI_DRAWING_fillEllipse_0
+#define UI_DRAWING_DMA2D_fillCircle UI_DRAWING_fillCircle_0
 #define UI_DRAWING_DMA2D_drawImage UI_DRAWING_drawImage_0
 #define UI_DRAWING_DMA2D_copyImage UI_DRAWING_copyImage_0
 #define UI_DRAWING_DMA2D_drawRegion UI_DRAWING_drawRegion_0
+#define UI_DRAWING_DMA2D_drawRotatedImageNearestNeighbor UI_DRAWING_drawRotatedImageNearestNeighbor_0
+#define UI_DRAWING_DMA2D_drawRotatedImageBilinear UI_DRAWING_drawRotatedImageBilinear_0
+#define UI_DRAWING_DMA2D_drawScaledImageNearestNeighbor UI_DRAWING_drawScaledImageNearestNeighbor_0
+#define UI_DRAWING_DMA2D_drawScaledImageBilinear UI_DRAWING_drawScaledImageBilinear_0
 
 #endif // !defined(LLUI_GC_SUPPORTED_FORMATS) || (LLUI_GC_SUPPORTED_FORMATS <= 1)
 
@@ -101,8 +137,24 @@ typedef struct {
 	uint8_t* dest_address;
 	uint16_t width;
 	uint16_t height;
+	uint16_t offset; // number of pixels to skip at the end of each line (stride - width)
 } DRAWING_DMA2D_memcpy;
 
+/*
+ * @brief DMA2D jobs queue and activity counters. The times are expressed in CPU cycles.
+ */
+typedef struct {
+	uint32_t jobs; // number of queued jobs
+	uint32_t queue_depth; // number of jobs in the queue (running job included)
+	uint32_t queue_depth_max; // maximum number of jobs in the queue
+	uint32_t queue_full; // number of times a drawing has waited for a free job
+	uint32_t memcpy_dropped; // number of memcpy lists not started because the queue was full (see UI_DRAWING_DMA2D_start_memcpy())
+	uint64_t idle_cycles; // time the DMA2D has been idle
+	uint64_t busy_cycles; // time the DMA2D has been running
+	uint32_t memcpy_cycles; // duration of the last memcpy list (restore copy after a flush), from its queuing
+	uint32_t cpu_pixels; // number of pixels drawn by the CPU while the DMA2D was drawing the rest of the image
+} DRAWING_DMA2D_statistics_t;
+
 // --------------------------------------------------------------------------------
 // Public API
 // --------------------------------------------------------------------------------
@@ -116,10 +168,10 @@ typedef struct {
 void UI_DRAWING_DMA2D_initialize(void* binary_semaphore_handle);
 
 /*
- * @brief STM32 HAL DMA2D implementation. DMA2D IRQ handler must call this function.
- * This function calls the STM32 HAL DMA2D "HAL_DMA2D_IRQHandler()" function. Then it
- * calls the LLUI_DISPLAY "LLUI_DISPLAY_notifyAsynchronousDrawingEnd" or "LLUI_DISPLAY_flushDone"
- * callbacks to notify the graphical engine about the current status.
+ * @brief STM32 DMA2D implementation. DMA2D IRQ handler must call this function.
+ * This function acknowledges the end of the current job and starts the next queued
+ * job. Then it calls the LLUI_DISPLAY "LLUI_DISPLAY_notifyAsynchronousDrawingEnd" or
+ * "LLUI_DISPLAY_flushDone" callbacks to notify the graphical engine about the current status.
  */
 void UI_DRAWING_DMA2D_IRQHandler(void);
 
@@ -137,13 +189,272 @@ void UI_DRAWING_DMA2D_IRQHandler(void);
  */
 void UI_DRAWING_DMA2D_configure_memcpy(uint8_t* srcAddr, uint8_t* destAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t stride, DRAWING_DMA2D_memcpy* memcpy_data);
 
+/*
+ * @brief Fills the memcpy data to copy a rectangle without configuring the DMA2D. The
+ * memcpy data must then be given to "UI_DRAWING_DMA2D_configure_memcpy_list()".
+ *
+ * @param[in] srcAddr the address of the buffer to copy.
+ * @param[in] destAddr the address of the destination buffer.
+ * @param[in] xmin the top-left X coordinate of the rectangle to copy.
+ * @param[in] ymin the top-left Y coordinate of the rectangle to copy.
+ * @param[in] xmax the bottom-right X coordinate of the rectangle to copy.
+ * @param[in] ymax the bottom-right Y coordinate of the rectangle to copy.
+ * @param[in] stride the buffer row stride in pixels (usually equal to the buffer width)
+ * @param[out] memcpy_data the internal representation of the memcpy to perform.
+ */
+void UI_DRAWING_DMA2D_prepare_memcpy(uint8_t* srcAddr, uint8_t* destAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t stride, DRAWING_DMA2D_memcpy* memcpy_data);
+
+/*
+ * @brief Configures the copy of several rectangles from frame buffer to back buffer
+ * just after a flush. The rectangles are copied one after the other (the DMA2D
+ * interrupt starts the next copy) and "LLUI_DISPLAY_flushDone()" is called after
+ * the last copy.
+ *
+ * The array must stay valid until the end of the last copy.
+ *
+ * @param[in] memcpy_data the array of memcpy to perform (see "UI_DRAWING_DMA2D_prepare_memcpy()").
+ * @param[in] count the number of elements in the array (at least 1).
+ */
+void UI_DRAWING_DMA2D_configure_memcpy_list(DRAWING_DMA2D_memcpy* memcpy_data, uint32_t count);
+
 /*
  * @brief Starts the copy previously configured by a call to "DRAWING_DMA2D_configure_memcpy()".
+ * Never waits (called under interrupt): when the jobs queue is not empty, which is a
+ * misuse, the copy is dropped and "LLUI_DISPLAY_flushDone()" is called at once.
  *
  * @param[in] memcpy_data the internal representation of the memcpy to perform.
  */
 void UI_DRAWING_DMA2D_start_memcpy(DRAWING_DMA2D_memcpy* memcyp_data);
 
+/*
+ * @brief Gets the DMA2D jobs queue and activity counters since the last reset.
+ *
+ * @param[out] statistics the counters.
+ */
+void UI_DRAWING_DMA2D_get_statistics(DRAWING_DMA2D_statistics_t* statistics);
+
+/*
+ * @brief Resets the DMA2D jobs queue and activity counters.
+ */
+void UI_DRAWING_DMA2D_reset_statistics(void);
+
+/*
+ * @brief Starts a drawing made of several tiles blended by "UI_DRAWING_DMA2D_blend_tile()".
+ * This function sets the drawing limits and prepares the destination region.
+ *
+ * @param[in] gc the destination.
+ * @param[in] x1 the top-left X coordinate of the region to draw.
+ * @param[in] y1 the top-left Y coordinate of the region to draw.
+ * @param[in] x2 the bottom-right X coordinate of the region to draw.
+ * @param[in] y2 the bottom-right Y coordinate of the region to draw.
+ */
+void UI_DRAWING_DMA2D_start_tiles(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2);
+
+/*
+ * @brief Queues the blending of an ARGB8888 tile in the destination. The tile must not
+ * be modified until the end of the job (see "UI_DRAWING_DMA2D_wait_job()").
+ *
+ * The last tile of the drawing notifies the Graphics Engine: the drawing function must
+ * return DRAWING_RUNNING.
+ *
+ * @param[in] gc the destination.
+ * @param[in] tile the tile's pixels (the stride is the tile's width).
+ * @param[in] x the destination X coordinate.
+ * @param[in] y the destination Y coordinate.
+ * @param[in] width the tile's width.
+ * @param[in] height the tile's height.
+ * @param[in] alpha the opacity to apply.
+ * @param[in] last true when this tile is the last tile of the drawing.
+ *
+ * @return the identifier of the DMA2D job.
+ */
+uint32_t UI_DRAWING_DMA2D_blend_tile(MICROUI_GraphicsContext* gc, uint32_t* tile, jint x, jint y, jint width, jint height, jint alpha, bool last);
+
+/*
+ * @brief Queues the blending of a region of an A8 or A4 buffer in the destination
+ * in the foreground color of the graphics context (glyphs, see ui_glyph_atlas.h). The
+ * drawing must be started by "UI_DRAWING_DMA2D_start_tiles()". The buffer must be in
+ * memory (see ui_drawing_dma2d_cache.h) and must not be modified until the end of
+ * the job (see "UI_DRAWING_DMA2D_wait_job()").
+ *
+ * For the A4 format, the region's X coordinate and width must be even: the DMA2D reads
+ * the lines from a byte boundary.
+ *
+ * The last region of the drawing notifies the Graphics Engine: the drawing function must
+ * return DRAWING_RUNNING.
+ *
+ * @param[in] gc the destination.
+ * @param[in] buffer the alpha buffer's address.
+ * @param[in] stride the alpha buffer's stride in pixels.
+ * @param[in] bpp the alpha buffer's number of bits per pixel: 8 or 4.
+ * @param[in] x_src the region's X coordinate in the alpha buffer.
+ * @param[in] y_src the region's Y coordinate in the alpha buffer.
+ * @param[in] width the region's width.
+ * @param[in] height the region's height.
+ * @param[in] x the destination X coordinate.
+ * @param[in] y the destination Y coordinate.
+ * @param[in] last true when this region is the last region of the drawing.
+ *
+ * @return the identifier of the DMA2D job.
+ */
+uint32_t UI_DRAWING_DMA2D_blend_alpha(MICROUI_GraphicsContext* gc, uint8_t* buffer, uint32_t stride, uint32_t bpp, jint x_src, jint y_src, jint width, jint height, jint x, jint y, bool last);
+
+/*
+ * @brief Queues the filling of a rectangle with the foreground color of the graphics
+ * context (interior of the shapes, see ui_drawing_dma2d_shapes.c). The drawing must be
+ * started by "UI_DRAWING_DMA2D_start_tiles()".
+ *
+ * The last rectangle of the drawing notifies the Graphics Engine: the drawing function
+ * must return DRAWING_RUNNING.
+ *
+ * @param[in] gc the destination.
+ * @param[in] x1 the top-left X coordinate of the rectangle.
+ * @param[in] y1 the top-left Y coordinate of the rectangle.
+ * @param[in] x2 the bottom-right X coordinate of the rectangle.
+ * @param[in] y2 the bottom-right Y coordinate of the rectangle.
+ * @param[in] last true when this rectangle is the last rectangle of the drawing.
+ *
+ * @return the identifier of the DMA2D job.
+ */
+uint32_t UI_DRAWING_DMA2D_fill_tile(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, bool last);
+
+/*
+ * @brief Waits for the end of a DMA2D job.
+ *
+ * @param[in] job the identifier returned by "UI_DRAWING_DMA2D_blend_tile()" or
+ * "UI_DRAWING_DMA2D_blend_alpha()".
+ */
+void UI_DRAWING_DMA2D_wait_job(uint32_t job);
+
+/*
+ * @brief Queues the loading of an ARGB8888 CLUT in the foreground CLUT of the DMA2D.
+ * The CLUT is used by the next "UI_DRAWING_DMA2D_convert()" jobs. The CLUT must not be
+ * modified until the end of the job (see "UI_DRAWING_DMA2D_wait_job()").
+ *
+ * @param[in] clut the colors.
+ * @param[in] size the number of colors (1 to 256).
+ *
+ * @return the identifier of the job.
+ */
+uint32_t UI_DRAWING_DMA2D_load_clut(uint32_t* clut, uint32_t size);
+
+/*
+ * @brief Queues the conversion of a buffer of indexed pixels (L8 or AL88) through the
+ * CLUT loaded by "UI_DRAWING_DMA2D_load_clut()" in a rectangle of another format (see
+ * grayscale.c). The buffer is written by the CPU and must not be modified until the end
+ * of the job (see "UI_DRAWING_DMA2D_wait_job()"). The data cache is not invalidated over
+ * the destination at the end of the job.
+ *
+ * @param[in] src the source pixels (stride: width).
+ * @param[in] src_format the source format (CM_L8 or CM_AL88).
+ * @param[in] src_bpp the source bpp (8 or 16).
+ * @param[in] dest the address of the first destination pixel.
+ * @param[in] dest_stride the destination stride in pixels.
+ * @param[in] dest_format the destination format (DMA2D output format).
+ * @param[in] dest_bpp the destination bpp.
+ * @param[in] width the width of the rectangle.
+ * @param[in] height the height of the rectangle.
+ *
+ * @return the identifier of the job.
+ */
+uint32_t UI_DRAWING_DMA2D_convert(uint8_t* src, uint32_t src_format, uint32_t src_bpp, uint8_t* dest, uint32_t dest_stride, uint32_t dest_format, uint32_t dest_bpp, jint width, jint height);
+
+/*
+ * @brief Copies a memory block with the DMA2D and waits for the end of the copy. The
+ * copy is queued after the pending drawings. The blocks must not overlap.
+ *
+ * @param[in] dest the destination address.
+ * @param[in] src the source address.
+ * @param[in] size the number of bytes to copy.
+ */
+void UI_DRAWING_DMA2D_move(uint8_t* dest, uint8_t* src, uint32_t size);
+
+/*
+ * @brief Queues the copy of a region of a buffer in another buffer; both buffers are in
+ * the display format (recorded regions, see ui_display_list.h). The regions must not
+ * overlap and the source must not be modified until the end of the copy.
+ *
+ * The copy notifies the Graphics Engine: the drawing function must return the returned
+ * status. When the destination is a graphics context, the drawing limits must be set
+ * before (see "LLUI_DISPLAY_setDrawingLimits()").
+ *
+ * @param[in] dest the destination buffer's address.
+ * @param[in] dest_stride the destination buffer's stride in pixels.
+ * @param[in] x_dest the destination X coordinate.
+ * @param[in] y_dest the destination Y coordinate.
+ * @param[in] src the source buffer's address.
+ * @param[in] src_stride the source buffer's stride in pixels.
+ * @param[in] x_src the region's X coordinate in the source buffer.
+ * @param[in] y_src the region's Y coordinate in the source buffer.
+ * @param[in] width the region's width.
+ * @param[in] height the region's height.
+ *
+ * @return DRAWING_RUNNING.
+ */
+DRAWING_Status UI_DRAWING_DMA2D_copy_region(uint8_t* dest, uint32_t dest_stride, jint x_dest, jint y_dest, uint8_t* src, uint32_t src_stride, jint x_src, jint y_src, jint width, jint height);
+
+/*
+ * @brief Queues the blending of a region of a layer (see ui_layer_compositor.h) in a
+ * graphics context in the display format. The drawing must be started by
+ * "UI_DRAWING_DMA2D_start_tiles()".
+ *
+ * The last region of the drawing notifies the Graphics Engine: the drawing function
+ * must return DRAWING_RUNNING.
+ *
+ * @param[in] gc the destination.
+ * @param[in] buffer the layer's buffer.
+ * @param[in] stride the layer's stride in pixels.
+ * @param[in] format the layer's format: MICROUI_IMAGE_FORMAT_A8 or MICROUI_IMAGE_FORMAT_ARGB4444.
+ * @param[in] x_src the region's X coordinate in the layer.
+ * @param[in] y_src the region's Y coordinate in the layer.
+ * @param[in] width the region's width.
+ * @param[in] height the region's height.
+ * @param[in] x the destination X coordinate.
+ * @param[in] y the destination Y coordinate.
+ * @param[in] alpha the opacity to apply.
+ * @param[in] color the color applied on the alpha values (A8 format only).
+ * @param[in] last true when this region is the last region of the drawing.
+ *
+ * @return the identifier of the DMA2D job.
+ */
+uint32_t UI_DRAWING_DMA2D_blend_layer(MICROUI_GraphicsContext* gc, uint8_t* buffer, uint32_t stride, jbyte format, jint x_src, jint y_src, jint width, jint height, jint x, jint y, jint alpha, jint color, bool last);
+
+/*
+ * @brief Fills a rectangle of a graphics context in the ARGB4444 format (see
+ * ui_drawing_layers.c) with a color; the color's alpha is written as is (a transparent
+ * color clears the rectangle). The rectangle must be in the clip.
+ *
+ * @param[in] gc the destination.
+ * @param[in] x1 the top-left X coordinate.
+ * @param[in] y1 the top-left Y coordinate.
+ * @param[in] x2 the bottom-right X coordinate.
+ * @param[in] y2 the bottom-right Y coordinate.
+ * @param[in] color the color (ARGB8888).
+ *
+ * @return DRAWING_RUNNING.
+ */
+DRAWING_Status UI_DRAWING_DMA2D_fill_layer(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, uint32_t color);
+
+/*
+ * @brief Queues the drawing of an image in a graphics context in the display format or
+ * in the ARGB4444 format (see ui_drawing_layers.c). The region must be in the clip.
+ *
+ * @param[in] gc the destination.
+ * @param[in] image the source.
+ * @param[in] x_src the region's X coordinate in the image.
+ * @param[in] y_src the region's Y coordinate in the image.
+ * @param[in] width the region's width.
+ * @param[in] height the region's height.
+ * @param[in] x_dest the destination X coordinate.
+ * @param[in] y_dest the destination Y coordinate.
+ * @param[in] alpha the opacity to apply.
+ *
+ * @return true when the drawing is queued (the drawing function must return
+ * DRAWING_RUNNING), false when the image's format is not supported by the DMA2D (nothing
+ * is drawn).
+ */
+bool UI_DRAWING_DMA2D_blend_image(MICROUI_GraphicsContext* gc, MICROUI_Image* image, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha);
+
 // --------------------------------------------------------------------------------
 // ui_drawing.h API
 // (the function names differ according to the available number of destination formats)
@@ -154,6 +465,21 @@ void UI_DRAWING_DMA2D_start_memcpy(DRAWING_DMA2D_memcpy* memcyp_data);
  */
 DRAWING_Status UI_DRAWING_DMA2D_fillRectangle(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2);
 
+/*
+ * @brief Implementation of fillRoundedRectangle over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_fillRoundedRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight);
+
+/*
+ * @brief Implementation of fillEllipse over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_fillEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height);
+
+/*
+ * @brief Implementation of fillCircle over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_fillCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter);
+
 /*
  * @brief Implementation of drawImage over the DMA2D. See ui_drawing.h
  */
@@ -169,6 +495,26 @@ DRAWING_Status UI_DRAWING_DMA2D_copyImage(MICROUI_GraphicsContext* gc, MICROUI_I
  */
 DRAWING_Status UI_DRAWING_DMA2D_drawRegion(MICROUI_GraphicsContext* gc, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha);
 
+/*
+ * @brief Implementation of drawRotatedImageNearestNeighbor over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_drawRotatedImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha);
+
+/*
+ * @brief Implementation of drawRotatedImageBilinear over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_drawRotatedImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha);
+
+/*
+ * @brief Implementation of drawScaledImageNearestNeighbor over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_drawScaledImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha);
+
+/*
+ * @brief Implementation of drawScaledImageBilinear over the DMA2D. See ui_drawing.h
+ */
+DRAWING_Status UI_DRAWING_DMA2D_drawScaledImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha);
+
 // --------------------------------------------------------------------------------
 // EOF
 // --------------------------------------------------------------------------------
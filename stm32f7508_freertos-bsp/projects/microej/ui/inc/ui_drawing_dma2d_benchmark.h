@@ -0,0 +1,67 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_DRAWING_DMA2D_BENCHMARK_H
+#define UI_DRAWING_DMA2D_BENCHMARK_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Benchmark of the data cache maintenance performed around the DMA2D blits:
+ * maintenance of the whole data cache (clean before the blit, clean and invalidate
+ * after the blit) versus maintenance of the source and destination rectangles only
+ * (see ui_drawing_dma2d_cache.h).
+ *
+ * For several blit sizes (from a small icon to the full screen), the benchmark prints:
+ * - the CPU cycles spent in the cache maintenance of one blit,
+ * - the CPU cycles spent to read again some unrelated data that was in the cache before
+ * the maintenance (the cost of evicting the "hot" data),
+ * - the number of cache line operations of the ranged maintenance (to adjust
+ * DRAWING_DMA2D_CACHE_RANGE_MAX_LINES).
+ *
+ * The results are only meaningful when the buffers are in a cacheable memory region
+ * (see ui_drawing_dma2d_configuration.h and MPU_Config() in main.c).
+ *
+ * How to use this benchmark:
+ * - Uncomment DRAWING_DMA2D_BENCHMARK in ui_drawing_dma2d_configuration.h
+ * - The benchmark is run by LLUI_DISPLAY_IMPL_initialize() on the display buffers.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// --------------------------------------------------------------------------------
+// Public API
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Runs the benchmark and prints the results. The content of both buffers is
+ * lost.
+ *
+ * @param[in] src the address of the buffer to copy.
+ * @param[in] dest the address of the destination buffer.
+ * @param[in] width the buffers' width in pixels (the stride).
+ * @param[in] height the buffers' height in pixels.
+ */
+void UI_DRAWING_DMA2D_BENCHMARK_run(uint8_t* src, uint8_t* dest, uint32_t width, uint32_t height);
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // UI_DRAWING_DMA2D_BENCHMARK_H
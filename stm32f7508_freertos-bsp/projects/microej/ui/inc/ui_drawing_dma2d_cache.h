@@ -0,0 +1,201 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_DRAWING_DMA2D_CACHE_H
+#define UI_DRAWING_DMA2D_CACHE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Data cache maintenance of the memory areas read and written by the DMA2D.
+ *
+ * The maintenance is performed over the rectangles read and written by the DMA2D
+ * (SCB_xxx_by_Addr()) instead of over the whole data cache: the other data in the cache
+ * (Java heap, network buffers, etc.) stays in the cache. A rectangle is maintained line
+ * by line or as one span (from its first to its last byte), whichever requires the
+ * fewest cache line operations. When a rectangle requires more operations than
+ * DRAWING_DMA2D_CACHE_RANGE_MAX_LINES, the whole data cache is maintained instead.
+ *
+ * These functions are used by ui_drawing_dma2d.c when DRAWING_DMA2D_CACHE_MANAGEMENT
+ * is enabled (see ui_drawing_dma2d_configuration.h).
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef STM32F4XX
+#include "stm32f4xx_hal.h"
+#endif
+
+#ifdef STM32F7XX
+#include "stm32f7xx_hal.h"
+#endif
+
+#ifdef STM32H7XX
+#include "stm32h7xx_hal.h"
+#endif
+
+#include "ui_drawing_dma2d_configuration.h"
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief A rectangle in memory: "height" lines of "width" bytes, the first byte of
+ * each line is "stride" bytes after the first byte of the previous line.
+ */
+typedef struct {
+	uint8_t* address; // address of the first byte of the first line
+	uint32_t width; // line's width in bytes
+	uint32_t height; // number of lines
+	uint32_t stride; // line's stride in bytes
+} DRAWING_DMA2D_CACHE_area_t;
+
+// --------------------------------------------------------------------------------
+// Functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Fills an area from a rectangle of a buffer.
+ *
+ * @param[out] area the area to fill
+ * @param[in] buffer the buffer's address
+ * @param[in] x the rectangle's top-left X coordinate
+ * @param[in] y the rectangle's top-left Y coordinate
+ * @param[in] width the rectangle's width in pixels
+ * @param[in] height the rectangle's height in pixels
+ * @param[in] stride the buffer's stride in pixels
+ * @param[in] bpp the buffer's number of bits per pixel
+ */
+static inline void DRAWING_DMA2D_CACHE_set_area(DRAWING_DMA2D_CACHE_area_t* area, uint8_t* buffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t stride, uint32_t bpp) {
+	uint32_t first_bit = ((y * stride) + x) * bpp;
+	// cppcheck-suppress [misra-c2012-18.4] address += offset
+	area->address = buffer + (first_bit / (uint32_t)8);
+	// round up to include the partial bytes (A4 format)
+	area->width = ((((first_bit % (uint32_t)8) + (width * bpp)) + (uint32_t)7) / (uint32_t)8);
+	area->height = height;
+	area->stride = (stride * bpp) / (uint32_t)8;
+}
+
+// --------------------------------------------------------------------------------
+// Maintenance operations
+// --------------------------------------------------------------------------------
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+
+/*
+ * @brief Size in bytes of a data cache line (Cortex-M7).
+ */
+#define DRAWING_DMA2D_CACHE_LINE_SIZE (32U)
+
+/*
+ * @brief Gets the number of cache line operations required to maintain the area line
+ * by line (returned value) and as one span (span_lines).
+ */
+static inline uint32_t DRAWING_DMA2D_CACHE_get_lines(DRAWING_DMA2D_CACHE_area_t* area, uint32_t* span_lines) {
+	uint32_t line_lines = ((area->width + ((uint32_t)2 * (DRAWING_DMA2D_CACHE_LINE_SIZE - (uint32_t)1))) / DRAWING_DMA2D_CACHE_LINE_SIZE) * area->height;
+	uint32_t span = ((area->height - (uint32_t)1) * area->stride) + area->width;
+	*span_lines = (span + ((uint32_t)2 * (DRAWING_DMA2D_CACHE_LINE_SIZE - (uint32_t)1))) / DRAWING_DMA2D_CACHE_LINE_SIZE;
+	return line_lines;
+}
+
+/*
+ * @brief Cleans (and invalidates) the data cache over an address range.
+ */
+static inline void _drawing_dma2d_cache_range(uint8_t* address, uint32_t size, bool invalidate) {
+	if (invalidate) {
+		// cppcheck-suppress [misra-c2012-11.3] the operation aligns the address on a cache line
+		SCB_CleanInvalidateDCache_by_Addr((uint32_t*)address, (int32_t)size);
+	}
+	else {
+		// cppcheck-suppress [misra-c2012-11.3] the operation aligns the address on a cache line
+		SCB_CleanDCache_by_Addr((uint32_t*)address, (int32_t)size);
+	}
+}
+
+/*
+ * @brief Applies the maintenance on the area, line by line or as one span.
+ *
+ * @param[in] area the area to maintain
+ * @param[in] invalidate true to clean and invalidate, false to clean only
+ * @param[in] max_lines the maximum number of cache line operations
+ *
+ * @return false when the area is too large: the maintenance has not been applied
+ */
+static inline bool DRAWING_DMA2D_CACHE_apply_range(DRAWING_DMA2D_CACHE_area_t* area, bool invalidate, uint32_t max_lines) {
+	bool done = true;
+
+	if ((area->width > (uint32_t)0) && (area->height > (uint32_t)0)) {
+		uint32_t span_lines;
+		uint32_t line_lines = DRAWING_DMA2D_CACHE_get_lines(area, &span_lines);
+
+		if (span_lines <= line_lines) {
+			if (span_lines <= max_lines) {
+				_drawing_dma2d_cache_range(area->address, ((area->height - (uint32_t)1) * area->stride) + area->width, invalidate);
+			}
+			else {
+				done = false;
+			}
+		}
+		else if (line_lines <= max_lines) {
+			uint8_t* line = area->address;
+			for (uint32_t y = 0; y < area->height; y++) {
+				_drawing_dma2d_cache_range(line, area->width, invalidate);
+				// cppcheck-suppress [misra-c2012-18.4] next line
+				line += area->stride;
+			}
+		}
+		else {
+			done = false;
+		}
+	}
+
+	return done;
+}
+
+/*
+ * @brief Cleans the data cache over the area: the data written by the CPU is
+ * written in memory before the DMA2D reads or writes the area.
+ */
+static inline void DRAWING_DMA2D_CACHE_clean(DRAWING_DMA2D_CACHE_area_t* area) {
+	if (!DRAWING_DMA2D_CACHE_apply_range(area, false, DRAWING_DMA2D_CACHE_RANGE_MAX_LINES)) {
+		SCB_CleanDCache();
+	}
+}
+
+/*
+ * @brief Invalidates the data cache over the area: the CPU reads the data written
+ * by the DMA2D. The data is cleaned at the same time because the first and last cache
+ * lines of each line may hold data outside the area.
+ */
+static inline void DRAWING_DMA2D_CACHE_invalidate(DRAWING_DMA2D_CACHE_area_t* area) {
+	if (!DRAWING_DMA2D_CACHE_apply_range(area, true, DRAWING_DMA2D_CACHE_RANGE_MAX_LINES)) {
+		// do not lose the data written by the CPU in other areas
+		SCB_CleanInvalidateDCache();
+	}
+}
+
+#endif // defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // UI_DRAWING_DMA2D_CACHE_H
@@ -47,6 +47,50 @@ extern "C" {
  */ 
 #define DRAWING_DMA2D_CACHE_MANAGEMENT_ENABLED  (1U)
 
+/*
+ * @brief Number of DMA2D jobs (fill, copy, blending, memcpy) the queue can hold. A drawing
+ * made of several DMA2D operations (overlapping copy for instance) queues its operations
+ * without waiting as long as the queue is not full.
+ */
+#define DRAWING_DMA2D_QUEUE_SIZE (16U)
+
+/*
+ * @brief Number of ARGB8888 pixels of a tile of the scaled and rotated image drawings
+ * (see ui_drawing_dma2d_transform.c). Two tiles are allocated: the CPU fills a tile
+ * while the DMA2D blends the other one. Both tiles (4KB) fit in the data cache.
+ */
+#define DRAWING_DMA2D_TRANSFORM_TILE_PIXELS (512U)
+
+/*
+ * @brief Number of pixels per line of a memory block copy (see UI_DRAWING_DMA2D_move()).
+ * The block is copied as lines of this size (the DMA2D limits a line to 16383 pixels)
+ * plus a last partial line.
+ */
+#define DRAWING_DMA2D_MOVE_LINE_SIZE (4096U)
+
+/*
+ * @brief Minimum number of pixels of the interior of a filled rounded rectangle, circle
+ * or ellipse to fill it with the DMA2D (see ui_drawing_dma2d_shapes.c). The smaller shapes
+ * are drawn in software only: the DMA2D jobs and the clipped software drawings of the
+ * edges cost more than the software drawing of the whole shape.
+ */
+#define DRAWING_DMA2D_SHAPES_MIN_PIXELS (1024U)
+
+/*
+ * @brief Share of the lines of a large image drawn by the CPU while the DMA2D draws the
+ * other lines, in 256ths (see ui_drawing_blend.h). Both engines access the SDRAM: the
+ * DMA2D blends about three times faster than the CPU, so the CPU takes a quarter of the
+ * lines. Set 0 to draw the images with the DMA2D only. Only available when the display
+ * format is RGB565.
+ */
+#define DRAWING_DMA2D_SPLIT_CPU_SHARE (64U)
+
+/*
+ * @brief Minimum number of pixels of an image drawing to share it between the DMA2D and
+ * the CPU. Below, the drawing is too short to overlap both engines.
+ */
+#define DRAWING_DMA2D_SPLIT_MIN_PIXELS (16384U)
+
 #if !defined (__DCACHE_PRESENT) || (__DCACHE_PRESENT == 0U)
 
 /*
@@ -134,6 +178,24 @@ extern "C" {
 
 #endif // !defined (__DCACHE_PRESENT) || (__DCACHE_PRESENT == 0U)
 
+/*
+ * @brief When the cache management is enabled, the cache is maintained over the
+ * rectangles read and written by the DMA2D (see ui_drawing_dma2d_cache.h). Above this
+ * number of cache line operations for a rectangle, maintaining the whole data cache
+ * is faster. The STM32F750 data cache is 4KB: 32 sets of 4 ways of 32-byte lines, so
+ * the whole cache is maintained with 128 set/way operations, each one costing about
+ * the same as a by-address operation. The benchmark ui_drawing_dma2d_benchmark.c
+ * measures both methods to adjust this value.
+ */
+#define DRAWING_DMA2D_CACHE_RANGE_MAX_LINES (128U)
+
+/*
+ * @brief Uncomment this define to run the cache maintenance benchmark during the display
+ * initialization (see ui_drawing_dma2d_benchmark.h). The results are printed on the
+ * standard output.
+ */
+//#define DRAWING_DMA2D_BENCHMARK
+
 // --------------------------------------------------------------------------------
 // EOF
 // --------------------------------------------------------------------------------
@@ -0,0 +1,179 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_GLYPH_ATLAS_H
+#define UI_GLYPH_ATLAS_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Draws the strings with the DMA2D from a glyph atlas per font.
+ *
+ * The Graphics Engine draws the strings of the MicroUI fonts (.ejf) in software, glyph
+ * per glyph. With this library, the glyphs of a font are rasterized once in an A8 or A4
+ * atlas allocated in the images heap; a string is then drawn as a batch of DMA2D
+ * blendings (one per glyph) of the atlas in the foreground color, queued without
+ * waiting (see "UI_DRAWING_DMA2D_blend_alpha()").
+ *
+ * The Graphics Engine does not give access to the glyphs of its fonts: each font is
+ * registered with the functions that give the metrics and the alpha values of its
+ * glyphs (generated bitmaps, font engine, etc.). ui_glyph_atlas_sheet.h provides these
+ * functions for the fonts drawn in an A8 or A4 image.
+ *
+ * How to use this library:
+ * - Configure the atlas: see ui_glyph_atlas_configuration.h
+ * - Register the fonts with "UI_GLYPH_ATLAS_register_font()" (after the display
+ *   initialization) or with the native "Java_com_microej_ui_GlyphAtlas_registerFont()"
+ *   (see ui_glyph_atlas_sheet.h)
+ * - Draw the strings with the native "Java_com_microej_ui_GlyphAtlas_drawString()" (or
+ *   with "UI_GLYPH_ATLAS_draw_string()" in a drawing native)
+ * - Check the atlas efficiency with "UI_GLYPH_ATLAS_get_statistics()"
+ *
+ * The atlas is used by the Graphics Engine task only (drawings). The glyphs are drawn
+ * in the graphics contexts in the display format only.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <LLUI_PAINTER_impl.h>
+
+#include "ui_glyph_atlas_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Metrics of a glyph. The glyph's top-left pixel is drawn at (left, top) from
+ * the pen position (the top of the line).
+ */
+typedef struct {
+	uint8_t width; // glyph's width in pixels (0 for a blank glyph)
+	uint8_t height; // glyph's height in pixels (0 for a blank glyph)
+	int8_t left; // X offset of the glyph from the pen position
+	int8_t top; // Y offset of the glyph from the top of the line
+	uint8_t advance; // pen move after the glyph
+} UI_GLYPH_ATLAS_metrics_t;
+
+/*
+ * @brief Gives the metrics of a glyph.
+ *
+ * @param[in] data the font data given at the registration.
+ * @param[in] character the character.
+ * @param[out] metrics the glyph's metrics.
+ *
+ * @return false when the font does not have this character.
+ */
+typedef bool (*UI_GLYPH_ATLAS_get_metrics)(const void* data, uint32_t character, UI_GLYPH_ATLAS_metrics_t* metrics);
+
+/*
+ * @brief Rasterizes a glyph: writes the alpha values (one byte per pixel, 0xff is
+ * opaque) of its "height" lines of "width" pixels.
+ *
+ * @param[in] data the font data given at the registration.
+ * @param[in] character the character.
+ * @param[in] alpha the address of the glyph's top-left pixel.
+ * @param[in] stride the number of bytes between two lines.
+ */
+typedef void (*UI_GLYPH_ATLAS_render)(const void* data, uint32_t character, uint8_t* alpha, uint32_t stride);
+
+/*
+ * @brief A font drawn with an atlas.
+ */
+typedef struct {
+	const void* data; // font data given to the functions
+	UI_GLYPH_ATLAS_get_metrics get_metrics;
+	UI_GLYPH_ATLAS_render render;
+	uint32_t bpp; // atlas's number of bits per pixel: 8 (A8) or 4 (A4)
+} UI_GLYPH_ATLAS_font_t;
+
+/*
+ * @brief Glyph atlas counters (see "UI_GLYPH_ATLAS_get_statistics()").
+ */
+typedef struct {
+	uint32_t hits; // glyphs drawn from the atlas
+	uint32_t misses; // glyphs rasterized in the atlas
+	uint32_t resets; // atlases emptied because they were full
+	uint32_t missing; // glyphs not drawn (unknown characters, glyphs too large)
+	uint32_t strings; // strings drawn
+} UI_GLYPH_ATLAS_statistics_t;
+
+// --------------------------------------------------------------------------------
+// Public API
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Registers a font. The font structure must stay valid until the font is
+ * unregistered. The atlas is allocated when the font draws its first string.
+ *
+ * @param[in] font the font.
+ *
+ * @return the font identifier, or -1 when UI_GLYPH_ATLAS_FONTS fonts are already
+ * registered or when the font is not valid.
+ */
+int32_t UI_GLYPH_ATLAS_register_font(const UI_GLYPH_ATLAS_font_t* font);
+
+/*
+ * @brief Unregisters a font and frees its atlas. Must be called by the Graphics Engine
+ * task (in a native).
+ *
+ * @param[in] font the font identifier.
+ */
+void UI_GLYPH_ATLAS_unregister_font(int32_t font);
+
+/*
+ * @brief Draws a string: the pen starts at (x, y), the top-left corner of the line.
+ * Must be called by a drawing native (see "LLUI_DISPLAY_requestDrawing()").
+ *
+ * @param[in] gc the destination.
+ * @param[in] font the font identifier.
+ * @param[in] chars the characters.
+ * @param[in] length the number of characters.
+ * @param[in] x the X coordinate of the pen.
+ * @param[in] y the Y coordinate of the top of the line.
+ *
+ * @return DRAWING_RUNNING when the DMA2D draws the glyphs, DRAWING_DONE otherwise.
+ */
+DRAWING_Status UI_GLYPH_ATLAS_draw_string(MICROUI_GraphicsContext* gc, int32_t font, const jchar* chars, uint32_t length, jint x, jint y);
+
+/*
+ * @brief Gets the glyph atlas counters since the last reset.
+ *
+ * @param[out] statistics the counters.
+ */
+void UI_GLYPH_ATLAS_get_statistics(UI_GLYPH_ATLAS_statistics_t* statistics);
+
+/*
+ * @brief Resets the glyph atlas counters.
+ */
+void UI_GLYPH_ATLAS_reset_statistics(void);
+
+/*
+ * @brief Native of "com.microej.ui.GlyphAtlas.drawString(GraphicsContext, int, char[], int,
+ * int, int, int)": draws the characters [offset, offset + length[ of the array (see
+ * "UI_GLYPH_ATLAS_draw_string()").
+ */
+void Java_com_microej_ui_GlyphAtlas_drawString(MICROUI_GraphicsContext* gc, jint font, jchar* chars, jint offset, jint length, jint x, jint y);
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // UI_GLYPH_ATLAS_H
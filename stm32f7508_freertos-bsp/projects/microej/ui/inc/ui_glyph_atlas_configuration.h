@@ -0,0 +1,69 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef UI_GLYPH_ATLAS_CONFIGURATION_H
+#define UI_GLYPH_ATLAS_CONFIGURATION_H
+
+/**
+ * @file
+ * @brief This file provides the configuration of ui_glyph_atlas.c.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Maximum number of fonts registered at the same time (see
+ * "UI_GLYPH_ATLAS_register_font()"). Each font has its own atlas.
+ */
+#define UI_GLYPH_ATLAS_FONTS (4U)
+
+/*
+ * @brief Size in pixels of the atlas of a font. The atlas is allocated in the images
+ * heap when the font draws its first string: 256 x 128 pixels take 32KB in A8 and
+ * 16KB in A4. The width must be even.
+ */
+#define UI_GLYPH_ATLAS_WIDTH (256U)
+#define UI_GLYPH_ATLAS_HEIGHT (128U)
+
+/*
+ * @brief Number of characters an atlas can index (power of two). The atlas is reset
+ * (all its glyphs are rasterized again when drawn) when three quarters of the entries
+ * are used or when a glyph does not fit in the atlas anymore.
+ */
+#define UI_GLYPH_ATLAS_GLYPHS (256U)
+
+/*
+ * @brief Maximum number of rows of glyphs of an atlas. The glyphs of a row have about
+ * the same height.
+ */
+#define UI_GLYPH_ATLAS_SHELVES (16U)
+
+/*
+ * @brief Maximum width and height in pixels of a glyph. A larger glyph is not drawn
+ * (DRAWING_LOG_MISSING_CHARACTER). The scratch buffer used to rasterize the A4 glyphs
+ * and to draw the A4 glyphs cut by the clip takes the square of this size in bytes.
+ */
+#define UI_GLYPH_ATLAS_GLYPH_MAX_SIZE (48U)
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_GLYPH_ATLAS_CONFIGURATION_H
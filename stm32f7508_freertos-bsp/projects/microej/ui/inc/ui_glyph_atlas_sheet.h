@@ -0,0 +1,108 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_GLYPH_ATLAS_SHEET_H
+#define UI_GLYPH_ATLAS_SHEET_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Font provider of the glyph atlas (see ui_glyph_atlas.h): the glyphs are read
+ * from a MicroUI image in A8 or A4 format (font sheet).
+ *
+ * The sheet is a grid of cells of the same size; the cells hold consecutive characters
+ * from left to right, then from top to bottom. A glyph is the smallest box of its cell
+ * that holds all the non-transparent pixels (a transparent cell is a blank glyph, like
+ * the space) and the pen moves of the cell's width after each glyph (monospaced font).
+ * The sheet is generated like any other image (Image Generator, A8 or A4 output format).
+ *
+ * How to use this provider:
+ * - Load the sheet image and keep it opened while the font is registered: the provider
+ *   reads its pixels each time a glyph is rasterized in the atlas
+ * - Register the font with the native "Java_com_microej_ui_GlyphAtlas_registerFont()"
+ * - Draw the strings with the native "Java_com_microej_ui_GlyphAtlas_drawString()"
+ * - Unregister the font with the native "Java_com_microej_ui_GlyphAtlas_unregisterFont()"
+ *   before closing the sheet image
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <LLUI_PAINTER_impl.h>
+
+#include "ui_glyph_atlas.h"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief A font sheet.
+ */
+typedef struct {
+	UI_GLYPH_ATLAS_font_t font; // font given to the atlas (data is the sheet)
+	const uint8_t* pixels; // sheet's pixels
+	uint32_t stride; // number of bytes between two lines of the sheet
+	uint32_t first; // character of the first cell
+	uint32_t count; // number of cells
+	uint32_t columns; // number of cells per line
+	uint32_t cell_width;
+	uint32_t cell_height;
+	int32_t id; // font identifier (-1 when not registered)
+} UI_GLYPH_ATLAS_SHEET_t;
+
+// --------------------------------------------------------------------------------
+// Public API
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Initializes a font sheet (the font is not registered).
+ *
+ * @param[out] sheet the font sheet.
+ * @param[in] image the sheet image (A8 or A4).
+ * @param[in] first the character of the first cell.
+ * @param[in] columns the number of cells per line.
+ * @param[in] rows the number of lines of cells.
+ *
+ * @return false when the image format is not A8 nor A4 or when the grid does not fit the
+ * image.
+ */
+bool UI_GLYPH_ATLAS_SHEET_initialize(UI_GLYPH_ATLAS_SHEET_t* sheet, MICROUI_Image* image, uint32_t first, uint32_t columns, uint32_t rows);
+
+/*
+ * @brief Native of "com.microej.ui.GlyphAtlas.registerFont(Image, int, int, int)":
+ * registers a font sheet (see "UI_GLYPH_ATLAS_SHEET_initialize()").
+ *
+ * @return the font identifier to give to "Java_com_microej_ui_GlyphAtlas_drawString()",
+ * or -1 when the sheet is not valid or when UI_GLYPH_ATLAS_FONTS fonts are already
+ * registered.
+ */
+jint Java_com_microej_ui_GlyphAtlas_registerFont(MICROUI_Image* image, jint first, jint columns, jint rows);
+
+/*
+ * @brief Native of "com.microej.ui.GlyphAtlas.unregisterFont(int)": unregisters a font
+ * registered with "Java_com_microej_ui_GlyphAtlas_registerFont()" and frees its atlas.
+ */
+void Java_com_microej_ui_GlyphAtlas_unregisterFont(jint font);
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // UI_GLYPH_ATLAS_SHEET_H
@@ -0,0 +1,203 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#if !defined UI_LAYER_COMPOSITOR_H
+#define UI_LAYER_COMPOSITOR_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @file
+ * @brief Blends offscreen layers (toasts, popups, dimming layers) in the display buffer
+ * with the DMA2D.
+ *
+ * A layer is a mutable image in the A8 or ARGB4444 format (see ui_drawing_layers.c)
+ * attached to the compositor with a position, an opacity and, for the A8 layers, a
+ * color. "UI_LAYER_COMPOSITOR_compose()" blends the visible regions of the layers in the
+ * clip of the graphics context, in the attachment order (the last attached layer is on
+ * top), with one DMA2D job per layer and a single notification at the end.
+ *
+ * An animated overlay only updates its own state (position, opacity) or its small
+ * layer: the screen underneath is not redrawn for the overlay's content. When a layer
+ * moves, the application restores the region it leaves (the recorded regions of
+ * ui_display_list.h are copied back in one DMA2D job) before composing:
+ *
+ *   int toast = LayerCompositor.attach(toastImage, x, y);
+ *   ...
+ *   LayerCompositor.setOpacity(toast, alpha);
+ *   drawScreen(g); // or only the region under the toast
+ *   LayerCompositor.compose(g);
+ *   display.flush();
+ *
+ * A layer is detached when its image is closed. The compositor is used by the Graphics
+ * Engine task only (natives).
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <LLUI_PAINTER_impl.h>
+#include <sni.h>
+
+#include "ui_layer_compositor_configuration.h"
+
+// -----------------------------------------------------------------------------
+// Types
+// -----------------------------------------------------------------------------
+
+/*
+ * @brief Compositor counters (see "UI_LAYER_COMPOSITOR_get_statistics()").
+ */
+typedef struct {
+	uint32_t compositions; // calls to "UI_LAYER_COMPOSITOR_compose()" that blended at least one layer
+	uint32_t blendings; // layers blended (one DMA2D job each)
+	uint32_t pixels; // pixels blended
+} UI_LAYER_COMPOSITOR_statistics_t;
+
+// --------------------------------------------------------------------------------
+// Public API
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Attaches a layer on top of the other layers. The layer is opaque and its A8
+ * color is white.
+ *
+ * @param[in] image the layer's image: a mutable image in the A8 or ARGB4444 format.
+ * @param[in] x the layer's X coordinate in the display.
+ * @param[in] y the layer's Y coordinate in the display.
+ *
+ * @return the layer identifier, -1 when the image's format is not supported or when
+ * UI_LAYER_COMPOSITOR_LAYERS layers are already attached.
+ */
+jint UI_LAYER_COMPOSITOR_attach(MICROUI_Image* image, jint x, jint y);
+
+/*
+ * @brief Detaches a layer.
+ *
+ * @param[in] layer the layer identifier.
+ */
+void UI_LAYER_COMPOSITOR_detach(jint layer);
+
+/*
+ * @brief Moves a layer.
+ *
+ * @param[in] layer the layer identifier.
+ * @param[in] x the layer's X coordinate in the display.
+ * @param[in] y the layer's Y coordinate in the display.
+ */
+void UI_LAYER_COMPOSITOR_move(jint layer, jint x, jint y);
+
+/*
+ * @brief Sets the opacity of a layer (0: the layer is not blended).
+ *
+ * @param[in] layer the layer identifier.
+ * @param[in] alpha the opacity (0 to 255).
+ */
+void UI_LAYER_COMPOSITOR_set_opacity(jint layer, jint alpha);
+
+/*
+ * @brief Sets the color applied on the alpha values of an A8 layer.
+ *
+ * @param[in] layer the layer identifier.
+ * @param[in] color the color (RGB888).
+ */
+void UI_LAYER_COMPOSITOR_set_color(jint layer, jint color);
+
+/*
+ * @brief Blends the layers in the clip of a graphics context in the display format.
+ * Must be called by a drawing native (see "LLUI_DISPLAY_requestDrawing()").
+ *
+ * @param[in] gc the destination.
+ *
+ * @return DRAWING_RUNNING when the DMA2D blends the layers, DRAWING_DONE otherwise.
+ */
+DRAWING_Status UI_LAYER_COMPOSITOR_compose(MICROUI_GraphicsContext* gc);
+
+/*
+ * @brief Detaches the layer of an image. Called when the image is closed (see
+ * "UI_DRAWING_freeImageResources_1()").
+ *
+ * @param[in] image the closed image.
+ */
+void UI_LAYER_COMPOSITOR_free_image(MICROUI_Image* image);
+
+/*
+ * @brief Gets the compositor counters since the last reset.
+ *
+ * @param[out] statistics the counters.
+ */
+void UI_LAYER_COMPOSITOR_get_statistics(UI_LAYER_COMPOSITOR_statistics_t* statistics);
+
+/*
+ * @brief Resets the compositor counters.
+ */
+void UI_LAYER_COMPOSITOR_reset_statistics(void);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.attach(Image, int, int)" (see
+ * "UI_LAYER_COMPOSITOR_attach()").
+ */
+jint Java_com_microej_ui_LayerCompositor_attach(MICROUI_Image* image, jint x, jint y);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.detach(int)" (see
+ * "UI_LAYER_COMPOSITOR_detach()").
+ */
+void Java_com_microej_ui_LayerCompositor_detach(jint layer);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.move(int, int, int)" (see
+ * "UI_LAYER_COMPOSITOR_move()").
+ */
+void Java_com_microej_ui_LayerCompositor_move(jint layer, jint x, jint y);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.setOpacity(int, int)" (see
+ * "UI_LAYER_COMPOSITOR_set_opacity()").
+ */
+void Java_com_microej_ui_LayerCompositor_setOpacity(jint layer, jint alpha);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.setColor(int, int)" (see
+ * "UI_LAYER_COMPOSITOR_set_color()").
+ */
+void Java_com_microej_ui_LayerCompositor_setColor(jint layer, jint color);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.compose(GraphicsContext)" (see
+ * "UI_LAYER_COMPOSITOR_compose()").
+ */
+void Java_com_microej_ui_LayerCompositor_compose(MICROUI_GraphicsContext* gc);
+
+/*
+ * @brief Native of "com.microej.ui.LayerCompositor.clear(GraphicsContext, int, int, int, int)":
+ * makes a rectangle of a layer transparent (in the clip).
+ *
+ * @param[in] gc the graphics context of the layer's image.
+ * @param[in] x the rectangle's X coordinate.
+ * @param[in] y the rectangle's Y coordinate.
+ * @param[in] width the rectangle's width.
+ * @param[in] height the rectangle's height.
+ */
+void Java_com_microej_ui_LayerCompositor_clear(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height);
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+#endif // UI_LAYER_COMPOSITOR_H
@@ -0,0 +1,40 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef UI_LAYER_COMPOSITOR_CONFIGURATION_H
+#define UI_LAYER_COMPOSITOR_CONFIGURATION_H
+
+/**
+ * @file
+ * @brief This file provides the configuration of ui_layer_compositor.c.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Maximum number of layers attached to the compositor.
+ */
+#define UI_LAYER_COMPOSITOR_LAYERS (4U)
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_LAYER_COMPOSITOR_CONFIGURATION_H
@@ -26,6 +26,12 @@
 // calls ui_drawing functions
 #include "ui_drawing.h"
 
+// reports the drawn regions
+#include "display_dirty_regions.h"
+
+// records the drawings of the static regions
+#include "ui_display_list.h"
+
 // --------------------------------------------------------------------------------
 // Macros and Defines
 // --------------------------------------------------------------------------------
@@ -58,112 +64,140 @@
 // --------------------------------------------------------------------------------
 
 void LLDW_PAINTER_IMPL_drawThickFadedPoint(MICROUI_GraphicsContext* gc, jint x, jint y, jint thickness, jint fade) {
-	if (((thickness > 0) || (fade > 0)) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedPoint)) {
+	const jint args[] = { x, y, thickness, fade };
+	if (((thickness > 0) || (fade > 0)) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedPoint, LOG_DRAW_drawThickFadedPoint, args, 4U)) {
 		LOG_DRAW_START(drawThickFadedPoint);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickFadedPoint(gc, x, y, thickness, fade));
 		LOG_DRAW_END(drawThickFadedPoint);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickFadedLine(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY, jint thickness, jint fade, DRAWING_Cap startCap, DRAWING_Cap endCap) {
-	if (((thickness > 0) || (fade > 0)) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedLine)) {
+	const jint args[] = { startX, startY, endX, endY, thickness, fade, (jint)startCap, (jint)endCap };
+	if (((thickness > 0) || (fade > 0)) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedLine, LOG_DRAW_drawThickFadedLine, args, 8U)) {
 		LOG_DRAW_START(drawThickFadedLine);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickFadedLine(gc, startX, startY, endX, endY, thickness, fade, startCap, endCap));
 		LOG_DRAW_END(drawThickFadedLine);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickFadedCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jint thickness, jint fade) {
-	if (((thickness > 0) || (fade > 0)) && (diameter > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedCircle)) {
+	const jint args[] = { x, y, diameter, thickness, fade };
+	if (((thickness > 0) || (fade > 0)) && (diameter > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedCircle, LOG_DRAW_drawThickFadedCircle, args, 5U)) {
 		LOG_DRAW_START(drawThickFadedCircle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickFadedCircle(gc, x, y, diameter, thickness, fade));
 		LOG_DRAW_END(drawThickFadedCircle);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickFadedCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle, jint thickness, jint fade, DRAWING_Cap start, DRAWING_Cap end) {
-	if (((thickness > 0) || (fade > 0)) && (diameter > 0) && ((int32_t)arcAngle != 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedCircleArc)) {
+	const jint args[] = { x, y, diameter, UI_DISPLAY_LIST_float(startAngle), UI_DISPLAY_LIST_float(arcAngle), thickness, fade, (jint)start, (jint)end };
+	if (((thickness > 0) || (fade > 0)) && (diameter > 0) && ((int32_t)arcAngle != 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedCircleArc, LOG_DRAW_drawThickFadedCircleArc, args, 9U)) {
 		LOG_DRAW_START(drawThickFadedCircleArc);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickFadedCircleArc(gc, x, y, diameter, startAngle, arcAngle, thickness, fade, start, end));
 		LOG_DRAW_END(drawThickFadedCircleArc);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickFadedEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint thickness, jint fade) {
-	if (((thickness > 0) || (fade > 0)) && (width > 0) && (height > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedEllipse)) {
+	const jint args[] = { x, y, width, height, thickness, fade };
+	if (((thickness > 0) || (fade > 0)) && (width > 0) && (height > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickFadedEllipse, LOG_DRAW_drawThickFadedEllipse, args, 6U)) {
 		LOG_DRAW_START(drawThickFadedEllipse);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickFadedEllipse(gc, x, y, width, height, thickness, fade));
 		LOG_DRAW_END(drawThickFadedEllipse);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickLine(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY, jint thickness) {
-	if ((thickness > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickLine)) {
+	const jint args[] = { startX, startY, endX, endY, thickness };
+	if ((thickness > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickLine, LOG_DRAW_drawThickLine, args, 5U)) {
 		LOG_DRAW_START(drawThickLine);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickLine(gc, startX, startY, endX, endY, thickness));
 		LOG_DRAW_END(drawThickLine);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jint thickness) {
-	if ((thickness > 0) && (diameter > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickCircle)) {
+	const jint args[] = { x, y, diameter, thickness };
+	if ((thickness > 0) && (diameter > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickCircle, LOG_DRAW_drawThickCircle, args, 4U)) {
 		LOG_DRAW_START(drawThickCircle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickCircle(gc, x, y, diameter, thickness));
 		LOG_DRAW_END(drawThickCircle);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint thickness) {
-	if ((thickness > 0) && (width > 0) && (height > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickEllipse)) {
+	const jint args[] = { x, y, width, height, thickness };
+	if ((thickness > 0) && (width > 0) && (height > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickEllipse, LOG_DRAW_drawThickEllipse, args, 5U)) {
 		LOG_DRAW_START(drawThickEllipse);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickEllipse(gc, x, y, width, height, thickness));
 		LOG_DRAW_END(drawThickEllipse);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawThickCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle, jint thickness) {
-	if ((thickness > 0) && (diameter > 0) && ((int32_t)arcAngle != 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickCircleArc)) {
+	const jint args[] = { x, y, diameter, UI_DISPLAY_LIST_float(startAngle), UI_DISPLAY_LIST_float(arcAngle), thickness };
+	if ((thickness > 0) && (diameter > 0) && ((int32_t)arcAngle != 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawThickCircleArc, LOG_DRAW_drawThickCircleArc, args, 6U)) {
 		LOG_DRAW_START(drawThickCircleArc);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawThickCircleArc(gc, x, y, diameter, startAngle, arcAngle, thickness));
 		LOG_DRAW_END(drawThickCircleArc);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawFlippedImage(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, DRAWING_Flip transformation, jint alpha) {
-	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawFlippedImage)) {
+	const jint args[] = { UI_DISPLAY_LIST_image(img), regionX, regionY, width, height, x, y, (jint)transformation, alpha };
+	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawFlippedImage, LOG_DRAW_drawFlippedImage, args, 9U)) {
 		LOG_DRAW_START(drawFlippedImage);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawFlippedImage(gc, img, regionX, regionY, width, height, x, y, transformation, alpha));
 		LOG_DRAW_END(drawFlippedImage);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawRotatedImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
-	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawRotatedImageNearestNeighbor)) {
+	const jint args[] = { UI_DISPLAY_LIST_image(img), x, y, rotationX, rotationY, UI_DISPLAY_LIST_float(angle), alpha };
+	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawRotatedImageNearestNeighbor, LOG_DRAW_drawRotatedImageNearestNeighbor, args, 7U)) {
 		LOG_DRAW_START(drawRotatedImageNearestNeighbor);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawRotatedImageNearestNeighbor(gc, img, x, y, rotationX, rotationY, angle, alpha));
 		LOG_DRAW_END(drawRotatedImageNearestNeighbor);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawRotatedImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
-	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawRotatedImageBilinear)) {
+	const jint args[] = { UI_DISPLAY_LIST_image(img), x, y, rotationX, rotationY, UI_DISPLAY_LIST_float(angle), alpha };
+	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawRotatedImageBilinear, LOG_DRAW_drawRotatedImageBilinear, args, 7U)) {
 		LOG_DRAW_START(drawRotatedImageBilinear);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawRotatedImageBilinear(gc, img, x, y, rotationX, rotationY, angle, alpha));
 		LOG_DRAW_END(drawRotatedImageBilinear);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawScaledImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
-	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && (factorX > 0.f) && (factorY > 0.f) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawScaledImageNearestNeighbor)) {
+	const jint args[] = { UI_DISPLAY_LIST_image(img), x, y, UI_DISPLAY_LIST_float(factorX), UI_DISPLAY_LIST_float(factorY), alpha };
+	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && (factorX > 0.f) && (factorY > 0.f) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawScaledImageNearestNeighbor, LOG_DRAW_drawScaledImageNearestNeighbor, args, 6U)) {
 		LOG_DRAW_START(drawScaledImageNearestNeighbor);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawScaledImageNearestNeighbor(gc, img, x, y, factorX, factorY, alpha));
 		LOG_DRAW_END(drawScaledImageNearestNeighbor);
 	}
 }
 
 void LLDW_PAINTER_IMPL_drawScaledImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
-	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && (factorX > 0.f) && (factorY > 0.f) && LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawScaledImageBilinear)) {
+	const jint args[] = { UI_DISPLAY_LIST_image(img), x, y, UI_DISPLAY_LIST_float(factorX), UI_DISPLAY_LIST_float(factorY), alpha };
+	if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0) && (factorX > 0.f) && (factorY > 0.f) && UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLDW_PAINTER_IMPL_drawScaledImageBilinear, LOG_DRAW_drawScaledImageBilinear, args, 6U)) {
 		LOG_DRAW_START(drawScaledImageBilinear);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawScaledImageBilinear(gc, img, x, y, factorX, factorY, alpha));
 		LOG_DRAW_END(drawScaledImageBilinear);
 	}
@@ -21,22 +21,77 @@
 #include "framerate.h"
 #include "interrupts.h"
 #include "ui_drawing_dma2d.h"
+#include "ui_drawing_dma2d_benchmark.h"
 #include "microej_decode.h"
+#include "display_dirty_regions.h"
+#include "microui_heap.h"
+#include "display_overlay.h"
+#include "display_line_scheduler.h"
+#include "grayscale.h"
 
 /* Defines -------------------------------------------------------------------*/
 // Define size to allocate for Display Buffer
 #define BUFFER_SIZE (RK043FN48H_WIDTH * RK043FN48H_HEIGHT * (DRAWING_DMA2D_BPP / 8))
-#define DISPLAY_MEM_SIZE (BUFFER_SIZE*2) /* Because of the double buffering mechanism this is selected like this */
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+#define DISPLAY_BUFFERS 3
+#else
+#define DISPLAY_BUFFERS 2
+#endif
+#define DISPLAY_MEM_SIZE (BUFFER_SIZE*DISPLAY_BUFFERS) /* Because of the double (or triple) buffering mechanism this is selected like this */
 // Declare Display Buffer
 uint8_t display_mem[DISPLAY_MEM_SIZE] __attribute__((section(".DisplayMem")));
 
-#define BACK_BUFFER ((int32_t)&display_mem[0])
+#define BACK_BUFFER ((uintptr_t)&display_mem[0])
 #define FRAME_BUFFER (BACK_BUFFER + BUFFER_SIZE)
 
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+#define THIRD_BUFFER (FRAME_BUFFER + BUFFER_SIZE)
+#define BUFFER_ADDRESS(index) ((uint8_t*)(BACK_BUFFER + ((index) * BUFFER_SIZE)))
+#define NO_BUFFER (-1)
+#define UNKNOWN_FRAME UINT32_MAX
+// number of frames kept in the rectangles history: a buffer is at most 2 frames late
+#define HISTORY_SIZE 2
+#define MEMCPY_MAX (DISPLAY_DIRTY_REGIONS_MAX * HISTORY_SIZE)
+#else
+#define MEMCPY_MAX DISPLAY_DIRTY_REGIONS_MAX
+#endif
+
+#ifdef DISPLAY_OVERLAY_ENABLED
+// the display buffers are scanned out by the background layer, below the overlay plane
+#define DISPLAY_LAYER DISPLAY_OVERLAY_BACKGROUND_LAYER
+#else
+#define DISPLAY_LAYER LTDC_ACTIVE_LAYER
+#endif
+
 /* Global --------------------------------------------------------------------*/
 
-static DRAWING_DMA2D_memcpy dma2d_memcpy;
+static DRAWING_DMA2D_memcpy dma2d_memcpy[MEMCPY_MAX];
 static SemaphoreHandle_t dma2d_sem;
+// a restore copy has been configured by the last flush
+static bool restore_configured;
+
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+// buffer scanned out by the LTDC
+static volatile int32_t displayed_buffer;
+// buffer given to the LTDC and displayed at next vertical blanking
+static volatile int32_t pending_buffer;
+// buffer flushed while another buffer is pending: given to the LTDC at next vertical blanking
+static volatile int32_t queued_buffer;
+// frame number of the content of each buffer
+static uint32_t buffer_frame[DISPLAY_BUFFERS];
+// number of flushed frames
+static uint32_t frame_number;
+// rectangles of the last flushed frames (index: frame_number % HISTORY_SIZE)
+static DISPLAY_DIRTY_REGIONS_rect_t history_rects[HISTORY_SIZE][DISPLAY_DIRTY_REGIONS_MAX];
+static uint32_t history_count[HISTORY_SIZE];
+#else
+// a flush waits for the register reload (the overlay plane reloads the registers too)
+static volatile bool flush_pending;
+// the Graphics Engine draws in the displayed buffer (see display_line_scheduler.h)
+static bool front_drawing;
+// area drawn in the displayed buffer and not in the other buffer (empty when x1 > x2)
+static DISPLAY_DIRTY_REGIONS_rect_t stale_rect;
+#endif
 
 extern LTDC_HandleTypeDef hLtdcHandler;
 
@@ -48,6 +103,87 @@ static void lcd_enable_interrupt(void)
 	HAL_LTDC_Reload(&hLtdcHandler, LTDC_RELOAD_VERTICAL_BLANKING);
 }
 
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+
+static inline int32_t buffer_index(uint8_t* addr)
+{
+	return (int32_t)(((uintptr_t)addr - BACK_BUFFER) / BUFFER_SIZE);
+}
+
+/*
+ * Gives the buffer to the LTDC: it will be displayed at next vertical blanking.
+ */
+static void lcd_show_buffer(int32_t index)
+{
+	pending_buffer = index;
+	HAL_LTDC_SetAddress_NoReload(&hLtdcHandler, (uint32_t)(uintptr_t)BUFFER_ADDRESS(index), DISPLAY_LAYER);
+	lcd_enable_interrupt();
+}
+
+/*
+ * Tells whether the rectangle is inside one of the given rectangles.
+ */
+static bool rect_contained(const DISPLAY_DIRTY_REGIONS_rect_t* rect, const DISPLAY_DIRTY_REGIONS_rect_t* rects, uint32_t count)
+{
+	bool ret = false;
+	for (uint32_t i = 0; !ret && (i < count); i++)
+	{
+		ret = (rects[i].x1 <= rect->x1) && (rects[i].y1 <= rect->y1) && (rects[i].x2 >= rect->x2) && (rects[i].y2 >= rect->y2);
+	}
+	return ret;
+}
+
+/*
+ * Configures the copy of the last flushed frame into the given buffer. The rectangles
+ * to copy are the rectangles drawn since the frame the buffer holds.
+ */
+static void configure_restore(int32_t src, int32_t dest)
+{
+	uint8_t* srcAddr = BUFFER_ADDRESS(src);
+	uint8_t* destAddr = BUFFER_ADDRESS(dest);
+	uint32_t late = frame_number - buffer_frame[dest];
+	DISPLAY_DIRTY_REGIONS_rect_t rects[MEMCPY_MAX];
+	uint32_t count = 0;
+
+	if ((buffer_frame[dest] != UNKNOWN_FRAME) && (late > 0U) && (late <= HISTORY_SIZE))
+	{
+		for (uint32_t f = frame_number - late + 1; f <= frame_number; f++)
+		{
+			uint32_t h = f % HISTORY_SIZE;
+			for (uint32_t i = 0; i < history_count[h]; i++)
+			{
+				// skip the rectangles already copied (full screen frames for instance)
+				if (!rect_contained(&history_rects[h][i], rects, count))
+				{
+					rects[count] = history_rects[h][i];
+					count++;
+				}
+			}
+		}
+	}
+	else
+	{
+		// buffer content is unknown: copy the full buffer
+		rects[0].x1 = 0;
+		rects[0].y1 = 0;
+		rects[0].x2 = RK043FN48H_WIDTH - 1;
+		rects[0].y2 = RK043FN48H_HEIGHT - 1;
+		count = 1;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		UI_DRAWING_DMA2D_prepare_memcpy(srcAddr, destAddr, rects[i].x1, rects[i].y1, rects[i].x2, rects[i].y2, RK043FN48H_WIDTH, &dma2d_memcpy[i]);
+	}
+	DISPLAY_DIRTY_REGIONS_account(rects, count, DRAWING_DMA2D_BPP);
+	buffer_frame[dest] = frame_number;
+
+	UI_DRAWING_DMA2D_configure_memcpy_list(dma2d_memcpy, count);
+	restore_configured = true;
+}
+
+#endif // LLDISPLAY_TRIPLE_BUFFERING
+
 /* Interrupt functions -------------------------------------------------------*/
 
 void DMA2D_IRQHandler(void)
@@ -86,13 +222,58 @@ void HAL_LTDC_ErrorCallback(LTDC_HandleTypeDef *hltdc)
 	}
 }
 
+void HAL_LTDC_LineEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+	// the LTDC scans the line programmed by the line scheduler
+	(void)hltdc;
+	DISPLAY_LINE_SCHEDULER_line_event();
+}
+
 void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc)
 {
 	// LTDC register reload
 	__HAL_LTDC_ENABLE_IT(hltdc, LTDC_IT_RR);
 
-	// launch the copy from backbuffer to lcd buffer
-	UI_DRAWING_DMA2D_start_memcpy(&dma2d_memcpy);
+#ifdef DISPLAY_OVERLAY_ENABLED
+	DISPLAY_OVERLAY_reload_event();
+#endif
+
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+	// no pending buffer: reload requested by the overlay plane only
+	if (pending_buffer != NO_BUFFER)
+	{
+		// the pending buffer is now displayed
+		displayed_buffer = pending_buffer;
+		pending_buffer = NO_BUFFER;
+
+		if (queued_buffer != NO_BUFFER)
+		{
+			// the buffer displayed before is now free: launch the copy into it (already configured)
+			lcd_show_buffer(queued_buffer);
+			queued_buffer = NO_BUFFER;
+			UI_DRAWING_DMA2D_start_memcpy(&dma2d_memcpy[0]);
+		}
+#ifdef FRAMERATE_ENABLED
+		else
+		{
+			// the last flushed buffer is displayed
+			framerate_frame_vsync();
+		}
+#endif
+	}
+#else
+	// no flush pending: reload requested by the overlay plane or by the switch to the
+	// front buffer drawing only
+	if (flush_pending)
+	{
+		flush_pending = false;
+#ifdef FRAMERATE_ENABLED
+		framerate_frame_vsync();
+#endif
+		// launch the copy from backbuffer to lcd buffer
+		UI_DRAWING_DMA2D_start_memcpy(&dma2d_memcpy[0]);
+	}
+#endif
 }
 
 /* API -----------------------------------------------------------------------*/
@@ -101,14 +282,14 @@ void LLUI_DISPLAY_IMPL_initialize(LLUI_DISPLAY_SInitData* init_data)
 {
 	BSP_LCD_Init();
 
-	BSP_LCD_LayerDefaultInit(LTDC_ACTIVE_LAYER, FRAME_BUFFER);
+	BSP_LCD_LayerDefaultInit(DISPLAY_LAYER, FRAME_BUFFER);
 
 #if LLDISPLAY_BPP == 16
-	HAL_LTDC_SetPixelFormat(&hLtdcHandler, LTDC_PIXEL_FORMAT_RGB565, LTDC_ACTIVE_LAYER);
+	HAL_LTDC_SetPixelFormat(&hLtdcHandler, LTDC_PIXEL_FORMAT_RGB565, DISPLAY_LAYER);
 #elif LLDISPLAY_BPP == 24
-	HAL_LTDC_SetPixelFormat(&hLtdcHandler, LTDC_PIXEL_FORMAT_RGB888, LTDC_ACTIVE_LAYER);
+	HAL_LTDC_SetPixelFormat(&hLtdcHandler, LTDC_PIXEL_FORMAT_RGB888, DISPLAY_LAYER);
 #elif LLDISPLAY_BPP == 32
-	HAL_LTDC_SetPixelFormat(&hLtdcHandler, LTDC_PIXEL_FORMAT_ARGB8888, LTDC_ACTIVE_LAYER);
+	HAL_LTDC_SetPixelFormat(&hLtdcHandler, LTDC_PIXEL_FORMAT_ARGB8888, DISPLAY_LAYER);
 #else
 	#error "Define 'LLDISPLAY_BPP' is required (16, 24 or 32)"
 #endif
@@ -116,15 +297,43 @@ void LLUI_DISPLAY_IMPL_initialize(LLUI_DISPLAY_SInitData* init_data)
 	init_data->lcd_width = RK043FN48H_WIDTH;
 	init_data->lcd_height = RK043FN48H_HEIGHT;
 	init_data->back_buffer_address = (uint8_t*)BACK_BUFFER;
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+	displayed_buffer = buffer_index((uint8_t*)FRAME_BUFFER);
+	pending_buffer = NO_BUFFER;
+	queued_buffer = NO_BUFFER;
+	frame_number = 0;
+	// content of the buffers not drawn yet is unknown
+	buffer_frame[buffer_index((uint8_t*)BACK_BUFFER)] = 0;
+	buffer_frame[buffer_index((uint8_t*)FRAME_BUFFER)] = UNKNOWN_FRAME;
+	buffer_frame[buffer_index((uint8_t*)THIRD_BUFFER)] = UNKNOWN_FRAME;
+#endif
 	init_data->binary_semaphore_0 = (LLUI_DISPLAY_binary_semaphore*)xSemaphoreCreateBinary();
 	init_data->binary_semaphore_1 = (LLUI_DISPLAY_binary_semaphore*)xSemaphoreCreateBinary();
 	dma2d_sem = xSemaphoreCreateBinary();
+#ifdef DISPLAY_OVERLAY_ENABLED
+	DISPLAY_OVERLAY_initialize();
+#endif
 	
 	// interruptions
 	HAL_NVIC_SetPriority(LTDC_IRQn, 5, 3);
 	HAL_NVIC_EnableIRQ(LTDC_IRQn);
 
 	UI_DRAWING_DMA2D_initialize((void*)dma2d_sem);
+
+#ifdef DRAWING_DMA2D_BENCHMARK
+	// the display buffers are not displayed yet
+	UI_DRAWING_DMA2D_BENCHMARK_run((uint8_t*)FRAME_BUFFER, (uint8_t*)BACK_BUFFER, RK043FN48H_WIDTH, RK043FN48H_HEIGHT);
+#endif
+
+#ifdef GRAYSCALE_BENCHMARK
+	{
+		// full screen conversions (the display buffers are not displayed yet)
+		grayscale_image_t src = { (uint8_t*)FRAME_BUFFER, NULL, RK043FN48H_WIDTH * (LLDISPLAY_BPP / 8), RK043FN48H_WIDTH, RK043FN48H_HEIGHT, (uint8_t)GRAYSCALE_DISPLAY_FORMAT };
+		grayscale_image_t dest = src;
+		dest.buffer = (uint8_t*)BACK_BUFFER;
+		grayscale_benchmark(&src, &dest);
+	}
+#endif
 }
 
 void LLUI_DISPLAY_IMPL_binarySemaphoreTake(void* sem)
@@ -152,20 +361,133 @@ void LLUI_DISPLAY_IMPL_binarySemaphoreGive(void* sem, bool under_isr)
 
 uint8_t* LLUI_DISPLAY_IMPL_flush(MICROUI_GraphicsContext* gc, uint8_t* srcAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax)
 {
-	uint8_t* destAddr = (srcAddr == (uint8_t*)BACK_BUFFER) ? (uint8_t*)FRAME_BUFFER : (uint8_t*)BACK_BUFFER;
-
 #ifdef FRAMERATE_ENABLED
 	framerate_increment();
+	// the restore copy of the previous frame is done: the Graphics Engine has drawn this frame
+	DRAWING_DMA2D_statistics_t dma2d_statistics;
+	UI_DRAWING_DMA2D_get_statistics(&dma2d_statistics);
+	framerate_frame_flush(restore_configured ? dma2d_statistics.memcpy_cycles : 0);
 #endif
+	restore_configured = false;
+
+#ifdef LLDISPLAY_TRIPLE_BUFFERING
+
+	int32_t src = buffer_index(srcAddr);
+	int32_t dest;
+
+	// keep the rectangles of this frame: the buffers are restored from one or two frames late
+	frame_number++;
+	uint32_t h = frame_number % HISTORY_SIZE;
+	history_count[h] = DISPLAY_DIRTY_REGIONS_flush(xmin, ymin, xmax, ymax, history_rects[h]);
+	buffer_frame[src] = frame_number;
+
+	// prevent the LTDC interrupt from updating the buffers states
+	HAL_NVIC_DisableIRQ(LTDC_IRQn);
 
-	HAL_LTDC_SetAddress(&hLtdcHandler, (uint32_t)srcAddr, LTDC_ACTIVE_LAYER);
-	UI_DRAWING_DMA2D_configure_memcpy(srcAddr, destAddr, xmin, ymin, xmax, ymax, RK043FN48H_WIDTH, &dma2d_memcpy);
+	if (pending_buffer == NO_BUFFER)
+	{
+		// the third buffer is free: the next frame can be drawn in it as soon as the
+		// copy is done, without waiting for the vertical blanking
+		dest = 3 - src - displayed_buffer; // index neither flushed nor displayed (0 + 1 + 2 == 3)
+		configure_restore(src, dest);
+		lcd_show_buffer(src);
+		UI_DRAWING_DMA2D_start_memcpy(&dma2d_memcpy[0]);
+	}
+	else
+	{
+		// all the buffers are in use: the displayed buffer will be free at next vertical
+		// blanking; the copy into it is started by the LTDC interrupt
+		dest = displayed_buffer;
+		queued_buffer = src;
+		configure_restore(src, dest);
+	}
+
+	HAL_NVIC_EnableIRQ(LTDC_IRQn);
+
+	return BUFFER_ADDRESS(dest);
+
+#else // LLDISPLAY_TRIPLE_BUFFERING
+
+	uint8_t* destAddr = (srcAddr == (uint8_t*)BACK_BUFFER) ? (uint8_t*)FRAME_BUFFER : (uint8_t*)BACK_BUFFER;
+
+	// restore only the rectangles drawn during the frame (the bounding box when unknown)
+	DISPLAY_DIRTY_REGIONS_rect_t rects[DISPLAY_DIRTY_REGIONS_MAX];
+	uint32_t count = DISPLAY_DIRTY_REGIONS_flush(xmin, ymin, xmax, ymax, rects);
+
+	if (DISPLAY_LINE_SCHEDULER_is_front_buffer_drawing())
+	{
+		if (!front_drawing)
+		{
+			// display the frame at next vertical blanking (no tearing): the next frames are
+			// drawn in it (no restore copy)
+			front_drawing = true;
+			stale_rect.x1 = UINT16_MAX;
+			stale_rect.y1 = UINT16_MAX;
+			stale_rect.x2 = 0;
+			stale_rect.y2 = 0;
+			HAL_LTDC_SetAddress_NoReload(&hLtdcHandler, (uint32_t)(uintptr_t)srcAddr, DISPLAY_LAYER);
+			lcd_enable_interrupt();
+		}
+		// else: the frame has been drawn in the displayed buffer
+
+		// the other buffer misses this frame
+		for (uint32_t i = 0; i < count; i++)
+		{
+			stale_rect.x1 = rects[i].x1 < stale_rect.x1 ? rects[i].x1 : stale_rect.x1;
+			stale_rect.y1 = rects[i].y1 < stale_rect.y1 ? rects[i].y1 : stale_rect.y1;
+			stale_rect.x2 = rects[i].x2 > stale_rect.x2 ? rects[i].x2 : stale_rect.x2;
+			stale_rect.y2 = rects[i].y2 > stale_rect.y2 ? rects[i].y2 : stale_rect.y2;
+		}
+		DISPLAY_DIRTY_REGIONS_account(rects, 0, DRAWING_DMA2D_BPP);
+
+		// nothing to wait for
+		LLUI_DISPLAY_flushDone(false);
+		return srcAddr;
+	}
+
+	if (front_drawing)
+	{
+		// back to double buffering: restore the frames drawn in the displayed buffer too
+		front_drawing = false;
+		rects[0] = stale_rect;
+		rects[0].x1 = xmin < rects[0].x1 ? (uint16_t)xmin : rects[0].x1;
+		rects[0].y1 = ymin < rects[0].y1 ? (uint16_t)ymin : rects[0].y1;
+		rects[0].x2 = xmax > rects[0].x2 ? (uint16_t)xmax : rects[0].x2;
+		rects[0].y2 = ymax > rects[0].y2 ? (uint16_t)ymax : rects[0].y2;
+		count = 1;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		UI_DRAWING_DMA2D_prepare_memcpy(srcAddr, destAddr, rects[i].x1, rects[i].y1, rects[i].x2, rects[i].y2, RK043FN48H_WIDTH, &dma2d_memcpy[i]);
+	}
+	DISPLAY_DIRTY_REGIONS_account(rects, count, DRAWING_DMA2D_BPP);
+
+	HAL_LTDC_SetAddress(&hLtdcHandler, (uint32_t)(uintptr_t)srcAddr, DISPLAY_LAYER);
+	UI_DRAWING_DMA2D_configure_memcpy_list(dma2d_memcpy, count);
+	restore_configured = true;
+	flush_pending = true;
 	lcd_enable_interrupt();
 
 	return destAddr;
+
+#endif // LLDISPLAY_TRIPLE_BUFFERING
 }
 
 LLUI_DISPLAY_Status LLUI_DISPLAY_IMPL_decodeImage(uint8_t* addr, uint32_t length, jbyte expectedFormat, MICROUI_Image* image, bool* isFullyOpaque)
 {
-	return MICROEJ_DECODE_webp(addr, length, (MICROUI_ImageFormat)expectedFormat, image, isFullyOpaque);
+	LLUI_DISPLAY_Status ret;
+
+	if (MICROUI_HEAP_cache_get(addr, length, (uint8_t)expectedFormat, image, isFullyOpaque))
+	{
+		// image already decoded (and closed)
+		ret = LLUI_DISPLAY_OK;
+	}
+	else
+	{
+		MICROUI_HEAP_cache_start(addr, length, (uint8_t)expectedFormat);
+		ret = MICROEJ_DECODE_webp(addr, length, (MICROUI_ImageFormat)expectedFormat, image, isFullyOpaque);
+		MICROUI_HEAP_cache_stop(image, *isFullyOpaque, LLUI_DISPLAY_OK == ret);
+	}
+	return ret;
 }
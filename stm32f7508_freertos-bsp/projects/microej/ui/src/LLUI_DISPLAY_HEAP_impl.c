@@ -11,6 +11,16 @@
  * MicroUI Graphics Engine. It is using a best fit allocator and provides some additional APIs
  * to retrieve the heap information: total space, free space, number of blocks allocated.
  *
+ * The small blocks are allocated in pages of blocks of the same size, in an area
+ * reserved at the beginning of the heap: they do not fragment the best fit allocator
+ * heap (see MICROUI_HEAP_SLAB_ENABLED).
+ *
+ * The heap also caches the images decoded at runtime: a closed image stays in the heap
+ * (until the cache budget is exceeded or the heap is full) and is given back when the
+ * same encoded image is decoded again (see MICROUI_HEAP_CACHE_ENABLED). The closed images
+ * are moved to merge the free blocks when the heap is fragmented (see
+ * MICROUI_HEAP_COMPACTION_ENABLED).
+ *
  * @see LLUI_DISPLAY_impl.h file comment
  * @author MicroEJ Developer Team
  * @version 3.1.0
@@ -21,8 +31,14 @@
 // Includes
 // -----------------------------------------------------------------------------
 
+#include <stddef.h>
+#include <string.h>
+
 #include "microui_heap.h"
 #include "BESTFIT_ALLOCATOR.h"
+#ifdef MICROUI_HEAP_COMPACTION_ENABLED
+#include "ui_drawing_dma2d.h"
+#endif
 
 // --------------------------------------------------------------------------------
 // Macros and Defines
@@ -40,6 +56,97 @@
  */
 #define BESTFITALLOCATOR_BLOCK_SIZE(block) ((*(uint32_t*)((block)-sizeof(uint32_t))) & 0x7ffffff)
 
+/*
+ * @brief The best fit allocator block header (before the block address).
+ */
+#define BESTFITALLOCATOR_BLOCK_HEADER(block) ((block)-sizeof(uint32_t))
+
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+
+/*
+ * @brief Sizes of the blocks of the small blocks area: from 32 to 1024 bytes.
+ */
+#define SLAB_MIN_BLOCK_SIZE (32U)
+#define SLAB_CLASSES (6U)
+#define SLAB_MAX_BLOCK_SIZE (SLAB_MIN_BLOCK_SIZE << (SLAB_CLASSES - 1U))
+
+#define SLAB_PAGES (MICROUI_HEAP_SLAB_SIZE / MICROUI_HEAP_SLAB_PAGE_SIZE)
+
+/*
+ * @brief Class of a page not used.
+ */
+#define SLAB_PAGE_UNUSED (0xffU)
+
+/*
+ * @brief Alignment of the small blocks area (cache line).
+ */
+#define SLAB_ALIGNMENT (32U)
+
+#endif // MICROUI_HEAP_SLAB_ENABLED
+
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+
+/*
+ * @brief FNV-1a hash parameters.
+ */
+#define CACHE_HASH_OFFSET (2166136261U)
+#define CACHE_HASH_PRIME (16777619U)
+
+#endif // MICROUI_HEAP_CACHE_ENABLED
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+
+/*
+ * @brief A page of the small blocks area. The free blocks are linked (the first word of
+ * a free block is the next free block); the blocks never allocated are after the
+ * carved ones.
+ */
+typedef struct {
+	uint8_t* free_list;
+	uint16_t used;
+	uint16_t carved;
+	uint8_t size_class;
+} slab_page_t;
+
+#endif // MICROUI_HEAP_SLAB_ENABLED
+
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+
+/*
+ * @brief State of a cache entry.
+ */
+typedef enum {
+	CACHE_ENTRY_FREE,     // unused entry
+	CACHE_ENTRY_OPENED,   // the image is used by the application
+	CACHE_ENTRY_CLOSED,   // the image has been closed, its buffer is still allocated
+} cache_entry_state_t;
+
+/*
+ * @brief A decoded image: the key (encoded image address, hash and length, expected
+ * format), the image buffer and the data to give back to the Graphics Engine.
+ */
+typedef struct {
+	const uint8_t* addr;
+	uint32_t hash;
+	uint32_t length;
+	uint8_t expected_format;
+	uint8_t format;
+	bool is_fully_opaque;
+	cache_entry_state_t state;
+	jchar width;
+	jchar height;
+	uint8_t* block;
+	uint32_t size;   // size given to LLUI_DISPLAY_IMPL_image_heap_allocate()
+	uint32_t offset; // offset of the pixels in the block
+	uint32_t last_use;
+} cache_entry_t;
+
+#endif // MICROUI_HEAP_CACHE_ENABLED
+
 // --------------------------------------------------------------------------------
 // Private fields
 // --------------------------------------------------------------------------------
@@ -49,6 +156,471 @@ static uint32_t heap_size;
 static uint32_t free_space;
 static uint32_t allocated_blocks_number;
 
+/*
+ * @brief The start of the heap (see MICROUI_HEAP_contains()).
+ */
+static uint8_t* heap_start_address;
+
+/*
+ * @brief The best fit allocator heap.
+ */
+static uint8_t* bestfit_start;
+static uint8_t* bestfit_limit;
+
+/*
+ * @brief The blocks allocated by the best fit allocator, sorted by address (see
+ * MICROUI_HEAP_largest_free_block()).
+ */
+static uint8_t* tracked_blocks[MICROUI_HEAP_TRACKED_BLOCKS];
+static uint32_t tracked_blocks_number;
+static uint32_t untracked_blocks_number;
+
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+static uint8_t* slab_start;
+static uint8_t* slab_limit;
+static slab_page_t slab_pages[SLAB_PAGES];
+static uint32_t slab_used_pages;
+#endif // MICROUI_HEAP_SLAB_ENABLED
+
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+static cache_entry_t cache_entries[MICROUI_HEAP_CACHE_ENTRIES];
+static uint32_t cache_size;
+static uint32_t cache_clock;
+static uint32_t cache_hits;
+static uint32_t cache_misses;
+static uint32_t cache_evictions;
+static uint32_t compaction_moves;
+
+/*
+ * @brief The closed image to give back on the next allocation (MICROUI_HEAP_cache_get()).
+ */
+static cache_entry_t* cache_reused;
+
+/*
+ * @brief The entry that records the next allocation (MICROUI_HEAP_cache_start()).
+ */
+static cache_entry_t* cache_recording;
+
+/*
+ * @brief The image hashed by MICROUI_HEAP_cache_get() (not hashed again by
+ * MICROUI_HEAP_cache_start()).
+ */
+static const uint8_t* cache_hashed_addr;
+static uint32_t cache_hashed_length;
+static uint32_t cache_hash;
+#endif // MICROUI_HEAP_CACHE_ENABLED
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Returns the index of the first tracked block whose address is higher than or
+ * equal to the given address.
+ */
+static uint32_t _tracked_blocks_search(const uint8_t* block) {
+	uint32_t low = 0;
+	uint32_t high = tracked_blocks_number;
+	while (low < high) {
+		uint32_t middle = (low + high) / 2U;
+		if (tracked_blocks[middle] < block) {
+			low = middle + 1U;
+		}
+		else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+static void _tracked_blocks_add(uint8_t* block) {
+	if (tracked_blocks_number < MICROUI_HEAP_TRACKED_BLOCKS) {
+		uint32_t index = _tracked_blocks_search(block);
+		(void)memmove(&tracked_blocks[index + 1U], &tracked_blocks[index], (tracked_blocks_number - index) * sizeof(uint8_t*));
+		tracked_blocks[index] = block;
+		tracked_blocks_number++;
+	}
+	else {
+		untracked_blocks_number++;
+	}
+}
+
+static void _tracked_blocks_remove(const uint8_t* block) {
+	uint32_t index = _tracked_blocks_search(block);
+	if ((index < tracked_blocks_number) && (block == tracked_blocks[index])) {
+		tracked_blocks_number--;
+		(void)memmove(&tracked_blocks[index], &tracked_blocks[index + 1U], (tracked_blocks_number - index) * sizeof(uint8_t*));
+	}
+	else {
+		untracked_blocks_number--;
+	}
+}
+
+/*
+ * @brief Calls the function for each free area between the blocks allocated by the best
+ * fit allocator. Returns false when some blocks are not tracked.
+ */
+static bool _for_each_free_block(void (*function)(uint32_t size, void* arg), void* arg) {
+	bool ret = 0U == untracked_blocks_number;
+	if (ret) {
+		uint8_t* cursor = bestfit_start;
+		for (uint32_t i = 0; i <= tracked_blocks_number; i++) {
+			uint8_t* end = (i < tracked_blocks_number) ? BESTFITALLOCATOR_BLOCK_HEADER(tracked_blocks[i]) : bestfit_limit;
+			if (end > cursor) {
+				function((uint32_t)(end - cursor), arg);
+			}
+			if (i < tracked_blocks_number) {
+				cursor = end + BESTFITALLOCATOR_BLOCK_SIZE(tracked_blocks[i]);
+			}
+		}
+	}
+	return ret;
+}
+
+static void _largest_free_block(uint32_t size, void* arg) {
+	uint32_t* largest = (uint32_t*)arg;
+	if (size > *largest) {
+		*largest = size;
+	}
+}
+
+static void _free_blocks_histogram(uint32_t size, void* arg) {
+	uint32_t* histogram = (uint32_t*)arg;
+	uint32_t index = 0;
+	while (((index + 1U) < MICROUI_HEAP_HISTOGRAM_SIZE) && (size >= (1024U << (2U * index)))) {
+		index++;
+	}
+	histogram[index]++;
+}
+
+static void _free_blocks_sum(uint32_t size, void* arg) {
+	*(uint32_t*)arg += size;
+}
+
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+
+static bool _slab_contains(const uint8_t* block) {
+	return (block >= slab_start) && (block < slab_limit);
+}
+
+static slab_page_t* _slab_get_page(const uint8_t* block) {
+	return &slab_pages[(uint32_t)(block - slab_start) / MICROUI_HEAP_SLAB_PAGE_SIZE];
+}
+
+static uint32_t _slab_block_size(const slab_page_t* page) {
+	return SLAB_MIN_BLOCK_SIZE << page->size_class;
+}
+
+static uint8_t* _slab_allocate(uint32_t size) {
+	uint8_t* addr = NULL;
+	uint32_t size_class = 0;
+	while ((SLAB_MIN_BLOCK_SIZE << size_class) < size) {
+		size_class++;
+	}
+	uint32_t block_size = SLAB_MIN_BLOCK_SIZE << size_class;
+	uint32_t capacity = MICROUI_HEAP_SLAB_PAGE_SIZE / block_size;
+
+	// a page of this size with a free block, otherwise a page not used
+	slab_page_t* page = NULL;
+	slab_page_t* unused_page = NULL;
+	uint32_t page_index = 0;
+	for (uint32_t i = 0; (NULL == page) && (slab_start < slab_limit) && (i < SLAB_PAGES); i++) {
+		slab_page_t* p = &slab_pages[i];
+		if ((size_class == p->size_class) && (p->used < capacity)) {
+			page = p;
+			page_index = i;
+		}
+		else if ((NULL == unused_page) && (SLAB_PAGE_UNUSED == p->size_class)) {
+			unused_page = p;
+			page_index = i;
+		}
+		else {
+			// page full or used for another size
+		}
+	}
+
+	if ((NULL == page) && (NULL != unused_page)) {
+		page = unused_page;
+		page->size_class = (uint8_t)size_class;
+		page->used = 0;
+		page->carved = 0;
+		page->free_list = NULL;
+		slab_used_pages++;
+	}
+
+	if (NULL != page) {
+		if (NULL != page->free_list) {
+			addr = page->free_list;
+			page->free_list = *(uint8_t**)addr;
+		}
+		else {
+			addr = slab_start + (page_index * MICROUI_HEAP_SLAB_PAGE_SIZE) + ((uint32_t)page->carved * block_size);
+			page->carved++;
+		}
+		page->used++;
+	}
+	return addr;
+}
+
+static void _slab_free(uint8_t* block) {
+	slab_page_t* page = _slab_get_page(block);
+	*(uint8_t**)block = page->free_list;
+	page->free_list = block;
+	page->used--;
+	if (0U == page->used) {
+		// the page can be used for another size
+		page->size_class = SLAB_PAGE_UNUSED;
+		slab_used_pages--;
+	}
+}
+
+#endif // MICROUI_HEAP_SLAB_ENABLED
+
+/*
+ * @brief Tells whether the block has been allocated by the best fit allocator.
+ */
+static bool _is_bestfit_block(const uint8_t* block) {
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+	return !_slab_contains(block);
+#else
+	(void)block;
+	return true;
+#endif
+}
+
+/*
+ * @brief Returns the size used in the heap by the block.
+ */
+static uint32_t _block_size(uint8_t* block) {
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+	return _slab_contains(block) ? _slab_block_size(_slab_get_page(block)) : BESTFITALLOCATOR_BLOCK_SIZE(block);
+#else
+	return BESTFITALLOCATOR_BLOCK_SIZE(block);
+#endif
+}
+
+static uint8_t* _allocate(uint32_t size) {
+	uint8_t* addr = NULL;
+
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+	if ((0U < size) && (size <= SLAB_MAX_BLOCK_SIZE)) {
+		addr = _slab_allocate(size);
+	}
+#endif
+
+	if (NULL == addr) {
+		addr = (uint8_t*)BESTFIT_ALLOCATOR_allocate(&image_heap, (int32_t)size);
+		if (NULL != addr) {
+			_tracked_blocks_add(addr);
+		}
+	}
+
+	if (NULL != addr) {
+		free_space -= _block_size(addr);
+		allocated_blocks_number++;
+	}
+	return addr;
+}
+
+static void _free(uint8_t* block) {
+	free_space += _block_size(block);
+	allocated_blocks_number--;
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+	if (_slab_contains(block)) {
+		_slab_free(block);
+	}
+	else
+#endif
+	{
+		_tracked_blocks_remove(block);
+		BESTFIT_ALLOCATOR_free(&image_heap, (void*)block);
+	}
+}
+
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+
+/*
+ * @brief Tells whether the encoded image is an application resource: the content of a
+ * read-only address never changes, so the address identifies the image.
+ */
+static bool _cache_is_resource(const uint8_t* addr, uint32_t length) {
+	uintptr_t start = (uintptr_t)addr;
+	return (start >= MICROUI_HEAP_CACHE_RESOURCES_START) && (start < MICROUI_HEAP_CACHE_RESOURCES_END)
+			&& (length <= (MICROUI_HEAP_CACHE_RESOURCES_END - start));
+}
+
+static uint32_t _cache_hash(const uint8_t* addr, uint32_t length) {
+	uint32_t hash = CACHE_HASH_OFFSET;
+	for (uint32_t i = 0; i < length; i++) {
+		hash = (hash ^ addr[i]) * CACHE_HASH_PRIME;
+	}
+	return hash;
+}
+
+static cache_entry_t* _cache_find(uint32_t hash, uint32_t length, uint8_t expectedFormat) {
+	cache_entry_t* ret = NULL;
+	for (uint32_t i = 0; (NULL == ret) && (i < MICROUI_HEAP_CACHE_ENTRIES); i++) {
+		cache_entry_t* entry = &cache_entries[i];
+		if ((CACHE_ENTRY_FREE != entry->state) && (hash == entry->hash) && (length == entry->length) && (expectedFormat == entry->expected_format)) {
+			ret = entry;
+		}
+	}
+	return ret;
+}
+
+static cache_entry_t* _cache_find_resource(const uint8_t* addr, uint32_t length, uint8_t expectedFormat) {
+	cache_entry_t* ret = NULL;
+	for (uint32_t i = 0; (NULL == ret) && (i < MICROUI_HEAP_CACHE_ENTRIES); i++) {
+		cache_entry_t* entry = &cache_entries[i];
+		if ((CACHE_ENTRY_FREE != entry->state) && (addr == entry->addr) && (length == entry->length) && (expectedFormat == entry->expected_format)) {
+			ret = entry;
+		}
+	}
+	return ret;
+}
+
+/*
+ * @brief Finds the entry of the encoded image: a resource is found by its address, the
+ * image is hashed only when the address is not known (image in RAM or copy of a resource).
+ * The computed hash is kept for MICROUI_HEAP_cache_start().
+ */
+static cache_entry_t* _cache_lookup(const uint8_t* addr, uint32_t length, uint8_t expectedFormat) {
+	cache_entry_t* entry = _cache_is_resource(addr, length) ? _cache_find_resource(addr, length, expectedFormat) : NULL;
+	if (NULL == entry) {
+		cache_hash = _cache_hash(addr, length);
+		cache_hashed_addr = addr;
+		cache_hashed_length = length;
+		entry = _cache_find(cache_hash, length, expectedFormat);
+	}
+	return entry;
+}
+
+static void _cache_evict_entry(cache_entry_t* entry) {
+	cache_size -= _block_size(entry->block);
+	_free(entry->block);
+	entry->state = CACHE_ENTRY_FREE;
+	cache_evictions++;
+}
+
+/*
+ * @brief Frees the least recently closed image. Returns false when there is no closed image.
+ */
+static bool _cache_evict(void) {
+	cache_entry_t* lru = NULL;
+	for (uint32_t i = 0; i < MICROUI_HEAP_CACHE_ENTRIES; i++) {
+		cache_entry_t* entry = &cache_entries[i];
+		if ((CACHE_ENTRY_CLOSED == entry->state) && ((NULL == lru) || ((int32_t)(entry->last_use - lru->last_use) < 0))) {
+			lru = entry;
+		}
+	}
+
+	if (NULL != lru) {
+		_cache_evict_entry(lru);
+	}
+	return NULL != lru;
+}
+
+#ifdef MICROUI_HEAP_COMPACTION_ENABLED
+
+/*
+ * @brief Gets the free area that the block (tracked by the best fit allocator) leaves
+ * once freed: the block and the free blocks before and after it.
+ */
+static uint32_t _compaction_get_hole(const uint8_t* block, uint8_t** start) {
+	uint32_t index = _tracked_blocks_search(block);
+	uint8_t* end = ((index + 1U) < tracked_blocks_number) ? BESTFITALLOCATOR_BLOCK_HEADER(tracked_blocks[index + 1U]) : bestfit_limit;
+	if (index > 0U) {
+		uint8_t* previous = tracked_blocks[index - 1U];
+		*start = BESTFITALLOCATOR_BLOCK_HEADER(previous) + BESTFITALLOCATOR_BLOCK_SIZE(previous);
+	}
+	else {
+		*start = bestfit_start;
+	}
+	return (uint32_t)(end - *start);
+}
+
+/*
+ * @brief Moves the closed images whose free neighbors would make a free block larger
+ * than the largest one, until the largest free block reaches the given size (including
+ * the block header and footer) or until max_moves images have been moved.
+ */
+static void _compaction_run(uint32_t size, uint32_t max_moves) {
+	uint32_t largest = 0;
+	uint32_t moves = 0;
+	bool available = _for_each_free_block(_largest_free_block, &largest);
+
+	for (uint32_t i = 0; available && (largest < size) && (moves < max_moves) && (i < MICROUI_HEAP_CACHE_ENTRIES); i++) {
+		cache_entry_t* entry = &cache_entries[i];
+		uint8_t* start = NULL;
+		uint32_t hole = 0;
+
+		// only the blocks of the best fit allocator are moved
+		if ((CACHE_ENTRY_CLOSED == entry->state) && _is_bestfit_block(entry->block)) {
+			hole = _compaction_get_hole(entry->block, &start);
+		}
+
+		if (hole > largest) {
+			// the best fit allocator gives the smallest free block large enough: the free
+			// blocks next to the image (at most two) are kept allocated to find another one
+			uint8_t* rejected[2];
+			uint32_t rejected_number = 0;
+			uint8_t* block;
+			do {
+				block = (uint8_t*)BESTFIT_ALLOCATOR_allocate(&image_heap, (int32_t)entry->size);
+				if ((NULL != block) && (BESTFITALLOCATOR_BLOCK_HEADER(block) >= start) && (BESTFITALLOCATOR_BLOCK_HEADER(block) < (start + hole))) {
+					rejected[rejected_number] = block;
+					rejected_number++;
+					block = NULL;
+				}
+				else {
+					break;
+				}
+			} while (rejected_number < 2U);
+
+			if (NULL != block) {
+				UI_DRAWING_DMA2D_move(block, entry->block, entry->size);
+
+				uint32_t old_size = BESTFITALLOCATOR_BLOCK_SIZE(entry->block);
+				uint32_t new_size = BESTFITALLOCATOR_BLOCK_SIZE(block);
+				_tracked_blocks_remove(entry->block);
+				BESTFIT_ALLOCATOR_free(&image_heap, (void*)entry->block);
+				_tracked_blocks_add(block);
+				free_space = (free_space + old_size) - new_size;
+				cache_size = (cache_size + new_size) - old_size;
+				entry->block = block;
+				compaction_moves++;
+				moves++;
+			}
+
+			for (uint32_t r = 0; r < rejected_number; r++) {
+				BESTFIT_ALLOCATOR_free(&image_heap, (void*)rejected[r]);
+			}
+
+			if (NULL != block) {
+				largest = 0;
+				available = _for_each_free_block(_largest_free_block, &largest);
+			}
+		}
+	}
+}
+
+/*
+ * @brief Compacts the heap when the fragmentation exceeds MICROUI_HEAP_COMPACTION_THRESHOLD:
+ * a free moves MICROUI_HEAP_COMPACTION_MOVES_PER_FREE images at most, the next frees go on.
+ */
+static void _compaction_check(void) {
+	uint32_t largest = 0;
+	uint32_t free_size = 0;
+	if (_for_each_free_block(_largest_free_block, &largest) && _for_each_free_block(_free_blocks_sum, &free_size)
+			&& ((free_size - largest) > ((free_size / 100U) * MICROUI_HEAP_COMPACTION_THRESHOLD))) {
+		_compaction_run(UINT32_MAX, MICROUI_HEAP_COMPACTION_MOVES_PER_FREE);
+	}
+}
+
+#endif // MICROUI_HEAP_COMPACTION_ENABLED
+
+#endif // MICROUI_HEAP_CACHE_ENABLED
+
 // --------------------------------------------------------------------------------
 // microui_heap.h functions
 // --------------------------------------------------------------------------------
@@ -65,6 +637,212 @@ uint32_t MICROUI_HEAP_number_of_allocated_blocks(void) {
 	return allocated_blocks_number;
 }
 
+uint32_t MICROUI_HEAP_largest_free_block(void) {
+	uint32_t largest = 0;
+	if (_for_each_free_block(_largest_free_block, &largest) && (largest > 0U)) {
+		// minus the header and the footer
+		largest -= 2U * (uint32_t)sizeof(uint32_t);
+	}
+	return largest;
+}
+
+bool MICROUI_HEAP_free_blocks_histogram(uint32_t histogram[MICROUI_HEAP_HISTOGRAM_SIZE]) {
+	(void)memset(histogram, 0, MICROUI_HEAP_HISTOGRAM_SIZE * sizeof(uint32_t));
+	return _for_each_free_block(_free_blocks_histogram, histogram);
+}
+
+bool MICROUI_HEAP_contains(const uint8_t* addr) {
+	return (heap_start_address <= addr) && (addr < bestfit_limit);
+}
+
+uint32_t MICROUI_HEAP_compaction_moves(void) {
+#ifdef MICROUI_HEAP_COMPACTION_ENABLED
+	return compaction_moves;
+#else
+	return 0;
+#endif
+}
+
+uint32_t MICROUI_HEAP_number_of_used_pages(void) {
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+	return slab_used_pages;
+#else
+	return 0;
+#endif
+}
+
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+
+uint32_t MICROUI_HEAP_cache_hits(void) {
+	return cache_hits;
+}
+
+uint32_t MICROUI_HEAP_cache_misses(void) {
+	return cache_misses;
+}
+
+uint32_t MICROUI_HEAP_cache_evictions(void) {
+	return cache_evictions;
+}
+
+uint32_t MICROUI_HEAP_cache_size(void) {
+	return cache_size;
+}
+
+bool MICROUI_HEAP_cache_get(uint8_t* addr, uint32_t length, uint8_t expectedFormat, MICROUI_Image* image, bool* isFullyOpaque) {
+	bool ret = false;
+	cache_hashed_addr = NULL;
+	cache_entry_t* entry = _cache_lookup(addr, length, expectedFormat);
+
+	if ((NULL != entry) && (CACHE_ENTRY_CLOSED == entry->state)) {
+		image->width = entry->width;
+		image->height = entry->height;
+		image->format = entry->format;
+
+		// the Graphics Engine computes the same buffer size: give back the cached block
+		cache_reused = entry;
+		bool allocated = LLUI_DISPLAY_allocateImageBuffer(image, 0);
+		cache_reused = NULL;
+
+		if (allocated && (CACHE_ENTRY_OPENED == entry->state)) {
+			uint32_t offset = (uint32_t)(LLUI_DISPLAY_getBufferAddress(image) - entry->block);
+			if (offset != entry->offset) {
+				// the block has been moved: the Graphics Engine has aligned the pixels differently
+				(void)memmove(entry->block + offset, entry->block + entry->offset, LLUI_DISPLAY_getStrideInBytes(image) * image->height);
+				entry->offset = offset;
+			}
+			*isFullyOpaque = entry->is_fully_opaque;
+			cache_hits++;
+			ret = true;
+		}
+		else if (allocated) {
+			// unexpected buffer size: the image has to be decoded
+			LLUI_DISPLAY_freeImageBuffer(image);
+			if (CACHE_ENTRY_CLOSED == entry->state) {
+				// the allocation may have evicted the entry to make room
+				_cache_evict_entry(entry);
+			}
+		}
+		else {
+			// heap full (the cached image may have been evicted)
+		}
+	}
+
+	if (!ret) {
+		cache_misses++;
+	}
+	return ret;
+}
+
+void MICROUI_HEAP_cache_start(uint8_t* addr, uint32_t length, uint8_t expectedFormat) {
+	cache_entry_t* entry;
+	if ((addr == cache_hashed_addr) && (length == cache_hashed_length)) {
+		// hashed by MICROUI_HEAP_cache_get()
+		entry = _cache_find(cache_hash, length, expectedFormat);
+	}
+	else {
+		entry = _cache_lookup(addr, length, expectedFormat);
+	}
+	uint32_t hash = cache_hash;
+	cache_hashed_addr = NULL;
+
+	// an image still opened is not cached twice
+	if (NULL == entry) {
+		cache_entry_t* free_entry = NULL;
+		do {
+			for (uint32_t i = 0; (NULL == free_entry) && (i < MICROUI_HEAP_CACHE_ENTRIES); i++) {
+				if (CACHE_ENTRY_FREE == cache_entries[i].state) {
+					free_entry = &cache_entries[i];
+				}
+			}
+		} while ((NULL == free_entry) && _cache_evict());
+
+		if (NULL != free_entry) {
+			free_entry->addr = _cache_is_resource(addr, length) ? addr : NULL;
+			free_entry->hash = hash;
+			free_entry->length = length;
+			free_entry->expected_format = expectedFormat;
+			free_entry->block = NULL;
+			cache_recording = free_entry;
+		}
+	}
+}
+
+void MICROUI_HEAP_cache_stop(MICROUI_Image* image, bool isFullyOpaque, bool decoded) {
+	cache_entry_t* entry = cache_recording;
+	cache_recording = NULL;
+
+	if (decoded && (NULL != entry) && (NULL != entry->block)) {
+		// check that the recorded allocation is the image buffer (and not a decoder's buffer)
+		uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(image);
+		if ((buffer >= entry->block) && (buffer < (entry->block + entry->size))) {
+			entry->format = image->format;
+			entry->width = image->width;
+			entry->height = image->height;
+			entry->is_fully_opaque = isFullyOpaque;
+			entry->offset = (uint32_t)(buffer - entry->block);
+			entry->state = CACHE_ENTRY_OPENED;
+		}
+	}
+}
+
+void MICROUI_HEAP_cache_modified(MICROUI_Image* image) {
+	uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(image);
+	for (uint32_t i = 0; i < MICROUI_HEAP_CACHE_ENTRIES; i++) {
+		cache_entry_t* entry = &cache_entries[i];
+		if ((CACHE_ENTRY_OPENED == entry->state) && (buffer >= entry->block) && (buffer < (entry->block + entry->size))) {
+			// the pixels no longer match the encoded image: the block is freed when the
+			// image is closed
+			entry->state = CACHE_ENTRY_FREE;
+		}
+	}
+}
+
+#else // MICROUI_HEAP_CACHE_ENABLED
+
+uint32_t MICROUI_HEAP_cache_hits(void) {
+	return 0;
+}
+
+uint32_t MICROUI_HEAP_cache_misses(void) {
+	return 0;
+}
+
+uint32_t MICROUI_HEAP_cache_evictions(void) {
+	return 0;
+}
+
+uint32_t MICROUI_HEAP_cache_size(void) {
+	return 0;
+}
+
+bool MICROUI_HEAP_cache_get(uint8_t* addr, uint32_t length, uint8_t expectedFormat, MICROUI_Image* image, bool* isFullyOpaque) {
+	(void)addr;
+	(void)length;
+	(void)expectedFormat;
+	(void)image;
+	(void)isFullyOpaque;
+	return false;
+}
+
+void MICROUI_HEAP_cache_start(uint8_t* addr, uint32_t length, uint8_t expectedFormat) {
+	(void)addr;
+	(void)length;
+	(void)expectedFormat;
+}
+
+void MICROUI_HEAP_cache_stop(MICROUI_Image* image, bool isFullyOpaque, bool decoded) {
+	(void)image;
+	(void)isFullyOpaque;
+	(void)decoded;
+}
+
+void MICROUI_HEAP_cache_modified(MICROUI_Image* image) {
+	(void)image;
+}
+
+#endif // MICROUI_HEAP_CACHE_ENABLED
+
 // --------------------------------------------------------------------------------
 // LLUI_DISPLAY_impl.h functions
 // --------------------------------------------------------------------------------
@@ -73,24 +851,105 @@ uint32_t MICROUI_HEAP_number_of_allocated_blocks(void) {
 void LLUI_DISPLAY_IMPL_image_heap_initialize(uint8_t* heap_start, uint8_t* heap_limit) {
 	heap_size = heap_limit - heap_start - BESTFITALLOCATOR_HEADER_SIZE;
 	free_space = heap_size;
+	heap_start_address = heap_start;
+
+	uint8_t* bestfit_heap_start = heap_start;
+#ifdef MICROUI_HEAP_SLAB_ENABLED
+	for (uint32_t i = 0; i < SLAB_PAGES; i++) {
+		slab_pages[i].size_class = SLAB_PAGE_UNUSED;
+	}
+	slab_used_pages = 0;
+
+	uint8_t* aligned_start = (uint8_t*)((((uintptr_t)heap_start) + SLAB_ALIGNMENT - 1U) & ~(uintptr_t)(SLAB_ALIGNMENT - 1U));
+	if ((uint32_t)(heap_limit - aligned_start) > (2U * MICROUI_HEAP_SLAB_SIZE)) {
+		// the small blocks area is before the best fit allocator heap
+		slab_start = aligned_start;
+		slab_limit = aligned_start + MICROUI_HEAP_SLAB_SIZE;
+		bestfit_heap_start = slab_limit;
+	}
+	else {
+		// heap too small: small blocks area disabled
+		slab_start = NULL;
+		slab_limit = NULL;
+	}
+#endif
+
+	bestfit_start = bestfit_heap_start + BESTFITALLOCATOR_HEADER_SIZE;
+	bestfit_limit = heap_limit;
+	tracked_blocks_number = 0;
+	untracked_blocks_number = 0;
+
 	BESTFIT_ALLOCATOR_new(&image_heap);
-	BESTFIT_ALLOCATOR_initialize(&image_heap, (int32_t)heap_start, (int32_t)heap_limit);
+	// the best fit allocator handles 32-bit addresses
+	BESTFIT_ALLOCATOR_initialize(&image_heap, (int32_t)(uintptr_t)bestfit_heap_start, (int32_t)(uintptr_t)heap_limit);
 }
 
 uint8_t* LLUI_DISPLAY_IMPL_image_heap_allocate(uint32_t size) {
-	uint8_t* addr = (uint8_t*)BESTFIT_ALLOCATOR_allocate(&image_heap, (int32_t)size);
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+	uint8_t* addr;
+	cache_entry_t* reused = cache_reused;
 
-	if ((uint8_t*)0 != addr) {
-		free_space -= BESTFITALLOCATOR_BLOCK_SIZE(addr);
-		allocated_blocks_number++;
+	if ((NULL != reused) && (size == reused->size)) {
+		// image found in the cache
+		cache_reused = NULL;
+		cache_size -= _block_size(reused->block);
+		reused->state = CACHE_ENTRY_OPENED;
+		addr = reused->block;
+	}
+	else {
+		addr = _allocate(size);
+#ifdef MICROUI_HEAP_COMPACTION_ENABLED
+		if ((uint8_t*)0 == addr) {
+			// heap fragmented: try to make room by moving the closed images
+			_compaction_run(size + (2U * (uint32_t)sizeof(uint32_t)), UINT32_MAX);
+			addr = _allocate(size);
+		}
+#endif
+		while (((uint8_t*)0 == addr) && _cache_evict()) {
+			// heap full: retry after freeing a closed image
+			addr = _allocate(size);
+		}
+
+		if (((uint8_t*)0 != addr) && (NULL != cache_recording) && (NULL == cache_recording->block)) {
+			// first allocation of the decoder: the image buffer
+			cache_recording->block = addr;
+			cache_recording->size = size;
+		}
 	}
 	return addr;
+#else
+	return _allocate(size);
+#endif
 }
 
 void LLUI_DISPLAY_IMPL_image_heap_free(uint8_t* block) {
-	free_space += BESTFITALLOCATOR_BLOCK_SIZE(block);
-	allocated_blocks_number--;
-	BESTFIT_ALLOCATOR_free(&image_heap, (void*)block);
+#ifdef MICROUI_HEAP_CACHE_ENABLED
+	cache_entry_t* entry = NULL;
+	for (uint32_t i = 0; (NULL == entry) && (i < MICROUI_HEAP_CACHE_ENTRIES); i++) {
+		if ((CACHE_ENTRY_OPENED == cache_entries[i].state) && (block == cache_entries[i].block)) {
+			entry = &cache_entries[i];
+		}
+	}
+
+	if (NULL != entry) {
+		// image closed: keep it in the heap while the budget allows it
+		entry->state = CACHE_ENTRY_CLOSED;
+		entry->last_use = cache_clock;
+		cache_clock++;
+		cache_size += _block_size(block);
+		while ((cache_size > MICROUI_HEAP_CACHE_BUDGET) && _cache_evict()) {
+			// free the least recently used images
+		}
+	}
+	else {
+		_free(block);
+	}
+#ifdef MICROUI_HEAP_COMPACTION_ENABLED
+	_compaction_check();
+#endif
+#else
+	_free(block);
+#endif
 }
 
 // --------------------------------------------------------------------------------
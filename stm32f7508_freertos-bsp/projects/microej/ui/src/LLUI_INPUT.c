@@ -12,19 +12,26 @@
 #include "microej.h"
 #include "buttons_manager.h"
 #include "touch_manager.h"
+#include "io_task.h"
 #include "interrupts.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
 
+/*
+ * The input interrupts do not send the MicroUI events: they push them in lock-free rings
+ * and the IO task sends them (see input_ring.h). The critical section does not have to
+ * mask the input interrupts; it is recursive because the IO task keeps it while sending
+ * a burst of events.
+ */
 static xSemaphoreHandle g_sem_input;
 
 /* API -----------------------------------------------------------------------*/
 
 void LLUI_INPUT_IMPL_initialize(void)
 {
-	g_sem_input = xSemaphoreCreateBinary();
-	xSemaphoreGive(g_sem_input);
+	g_sem_input = xSemaphoreCreateRecursiveMutex();
 
+	IO_TASK_create_task();
 	BUTTONS_MANAGER_initialize();
 	TOUCH_MANAGER_initialize();
 }
@@ -39,8 +46,7 @@ void LLUI_INPUT_IMPL_enterCriticalSection()
 {
 	if (interrupt_is_in() == MICROEJ_FALSE)
 	{
-		xSemaphoreTake(g_sem_input, portMAX_DELAY);
-		BUTTONS_MANAGER_disable_interrupts();
+		xSemaphoreTakeRecursive(g_sem_input, portMAX_DELAY);
 	}
 }
 
@@ -48,7 +54,6 @@ void LLUI_INPUT_IMPL_leaveCriticalSection()
 {
 	if (interrupt_is_in() == MICROEJ_FALSE)
 	{
-		BUTTONS_MANAGER_enable_interrupts();
-		xSemaphoreGive(g_sem_input);
+		xSemaphoreGiveRecursive(g_sem_input);
 	}
 }
@@ -34,6 +34,10 @@
 // deport event description to another file
 #include "microui_event_decoder.h"
 
+// follows the touch events (coalescing and latency)
+#include "touch_helper.h"
+#include "input_trace.h"
+
 #ifdef MICROUIEVENTDECODER_ENABLED
 
 // -----------------------------------------------------------------------------
@@ -77,20 +81,23 @@ void LLUI_INPUT_IMPL_log_queue_init(uint32_t length) {
 	assert(length <= (uint32_t)QUEUE_LOG_MAX_SIZE);
 	(void)memset((void*)queue_log, 0, length);
 	queue_is_first_element = true;
+	INPUT_TRACE_queue_init(length);
 }
 
 void LLUI_INPUT_IMPL_log_queue_full(uint32_t data) {
 	// queue is full, nothing to log
 	(void)data;
+	INPUT_TRACE_queue_full();
 }
 
 void LLUI_INPUT_IMPL_log_queue_add(uint32_t data, uint32_t index, uint32_t remaining_elements, uint32_t queue_length) {
 	(void)data;
-	(void)queue_length;
+	INPUT_TRACE_queue_add(queue_length);
 
 	if (queue_is_first_element) {
 		// start new event: set the event size in array
 		queue_log[index] = (uint8_t)(remaining_elements + (uint32_t)1);
+		TOUCH_HELPER_queue_added(index);
 	}
 	else {
 		// continue previous event: drop data
@@ -112,7 +119,8 @@ void LLUI_INPUT_IMPL_log_queue_replace(uint32_t old, uint32_t data, uint32_t ind
 void LLUI_INPUT_IMPL_log_queue_read(uint32_t data, uint32_t index) {
 	// event has been read, nothing to log
 	(void)data;
-	(void)index;
+	TOUCH_HELPER_queue_read(index);
+	INPUT_TRACE_event_read(index);
 }
 
 void LLUI_INPUT_IMPL_log_dump(bool log_type, uint32_t log, uint32_t index) {
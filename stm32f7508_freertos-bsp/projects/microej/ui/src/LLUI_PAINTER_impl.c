@@ -29,6 +29,12 @@
 // calls ui_drawing functions
 #include "ui_drawing.h"
 
+// reports the drawn regions
+#include "display_dirty_regions.h"
+
+// records the drawings of the static regions
+#include "ui_display_list.h"
+
 // --------------------------------------------------------------------------------
 // Macros and Defines
 // --------------------------------------------------------------------------------
@@ -89,9 +95,11 @@ static inline void _check_bound(jint max, jint* bound, jint* size, jint* origin)
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_writePixel(MICROUI_GraphicsContext* gc, jint x, jint y) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_writePixel)) {
+	const jint args[] = { x, y };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_writePixel, LOG_DRAW_writePixel, args, 2U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(writePixel);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		if (LLUI_DISPLAY_isPixelInClip(gc, x, y)) {
 			LLUI_DISPLAY_configureClip(gc, false/* point is in clip */);
 			status = UI_DRAWING_writePixel(gc, x, y);
@@ -107,8 +115,10 @@ void LLUI_PAINTER_IMPL_writePixel(MICROUI_GraphicsContext* gc, jint x, jint y) {
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawLine(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawLine)) {
+	const jint args[] = { startX, startY, endX, endY };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawLine, LOG_DRAW_drawLine, args, 4U)) {
 		LOG_DRAW_START(drawLine);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 		// cannot reduce/clip line: may be endX < startX and / or endY < startY
 		LLUI_DISPLAY_setDrawingStatus(UI_DRAWING_drawLine(gc, startX, startY, endX, endY));
 		LOG_DRAW_END(drawLine);
@@ -117,9 +127,11 @@ void LLUI_PAINTER_IMPL_drawLine(MICROUI_GraphicsContext* gc, jint startX, jint s
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawHorizontalLine(MICROUI_GraphicsContext* gc, jint x, jint y, jint length) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawHorizontalLine)) {
+	const jint args[] = { x, y, length };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawHorizontalLine, LOG_DRAW_drawHorizontalLine, args, 3U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawHorizontalLine);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		jint x1 = x;
 		jint x2 = x + length - 1;
@@ -140,9 +152,11 @@ void LLUI_PAINTER_IMPL_drawHorizontalLine(MICROUI_GraphicsContext* gc, jint x, j
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawVerticalLine(MICROUI_GraphicsContext* gc, jint x, jint y, jint length) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawVerticalLine)) {
+	const jint args[] = { x, y, length };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawVerticalLine, LOG_DRAW_drawVerticalLine, args, 3U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawVerticalLine);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		jint y1 = y;
 		jint y2 = y + length - 1;
@@ -163,9 +177,11 @@ void LLUI_PAINTER_IMPL_drawVerticalLine(MICROUI_GraphicsContext* gc, jint x, jin
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawRectangle)) {
+	const jint args[] = { x, y, width, height };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawRectangle, LOG_DRAW_drawRectangle, args, 4U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawRectangle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -189,9 +205,11 @@ void LLUI_PAINTER_IMPL_drawRectangle(MICROUI_GraphicsContext* gc, jint x, jint y
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_fillRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillRectangle)) {
+	const jint args[] = { x, y, width, height };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillRectangle, LOG_DRAW_fillRectangle, args, 4U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillRectangle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		jint x1 = x;
 		jint x2 = x + width - 1;
@@ -215,9 +233,11 @@ void LLUI_PAINTER_IMPL_fillRectangle(MICROUI_GraphicsContext* gc, jint x, jint y
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawRoundedRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawRoundedRectangle)) {
+	const jint args[] = { x, y, width, height, cornerEllipseWidth, cornerEllipseHeight };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawRoundedRectangle, LOG_DRAW_drawRoundedRectangle, args, 6U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawRoundedRectangle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -236,9 +256,11 @@ void LLUI_PAINTER_IMPL_drawRoundedRectangle(MICROUI_GraphicsContext* gc, jint x,
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_fillRoundedRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillRoundedRectangle)) {
+	const jint args[] = { x, y, width, height, cornerEllipseWidth, cornerEllipseHeight };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillRoundedRectangle, LOG_DRAW_fillRoundedRectangle, args, 6U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillRoundedRectangle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -257,9 +279,11 @@ void LLUI_PAINTER_IMPL_fillRoundedRectangle(MICROUI_GraphicsContext* gc, jint x,
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawCircleArc)) {
+	const jint args[] = { x, y, diameter, UI_DISPLAY_LIST_float(startAngle), UI_DISPLAY_LIST_float(arcAngle) };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawCircleArc, LOG_DRAW_drawCircleArc, args, 5U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawCircleArc);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((diameter > 0) && ((int32_t)arcAngle != 0)) {
@@ -278,9 +302,11 @@ void LLUI_PAINTER_IMPL_drawCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawEllipseArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jfloat startAngle, jfloat arcAngle) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawEllipseArc)) {
+	const jint args[] = { x, y, width, height, UI_DISPLAY_LIST_float(startAngle), UI_DISPLAY_LIST_float(arcAngle) };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawEllipseArc, LOG_DRAW_drawEllipseArc, args, 6U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawEllipseArc);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0) && ((int32_t)arcAngle != 0)) {
@@ -299,9 +325,11 @@ void LLUI_PAINTER_IMPL_drawEllipseArc(MICROUI_GraphicsContext* gc, jint x, jint
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_fillCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter, jfloat startAngle, jfloat arcAngle) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillCircleArc)) {
+	const jint args[] = { x, y, diameter, UI_DISPLAY_LIST_float(startAngle), UI_DISPLAY_LIST_float(arcAngle) };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillCircleArc, LOG_DRAW_fillCircleArc, args, 5U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillCircleArc);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((diameter > 0) && ((int32_t)arcAngle != 0)) {
@@ -320,9 +348,11 @@ void LLUI_PAINTER_IMPL_fillCircleArc(MICROUI_GraphicsContext* gc, jint x, jint y
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_fillEllipseArc(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jfloat startAngle, jfloat arcAngle) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillEllipseArc)) {
+	const jint args[] = { x, y, width, height, UI_DISPLAY_LIST_float(startAngle), UI_DISPLAY_LIST_float(arcAngle) };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillEllipseArc, LOG_DRAW_fillEllipseArc, args, 6U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillEllipseArc);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0) && ((int32_t)arcAngle != 0)) {
@@ -341,9 +371,11 @@ void LLUI_PAINTER_IMPL_fillEllipseArc(MICROUI_GraphicsContext* gc, jint x, jint
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawEllipse)) {
+	const jint args[] = { x, y, width, height };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawEllipse, LOG_DRAW_drawEllipse, args, 4U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawEllipse);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -362,9 +394,11 @@ void LLUI_PAINTER_IMPL_drawEllipse(MICROUI_GraphicsContext* gc, jint x, jint y,
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_fillEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillEllipse)) {
+	const jint args[] = { x, y, width, height };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillEllipse, LOG_DRAW_fillEllipse, args, 4U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillEllipse);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if ((width > 0) && (height > 0)) {
@@ -383,9 +417,11 @@ void LLUI_PAINTER_IMPL_fillEllipse(MICROUI_GraphicsContext* gc, jint x, jint y,
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawCircle)) {
+	const jint args[] = { x, y, diameter };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawCircle, LOG_DRAW_drawCircle, args, 3U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(drawCircle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if (diameter > 0) {
@@ -404,9 +440,11 @@ void LLUI_PAINTER_IMPL_drawCircle(MICROUI_GraphicsContext* gc, jint x, jint y, j
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_fillCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillCircle)) {
+	const jint args[] = { x, y, diameter };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_fillCircle, LOG_DRAW_fillCircle, args, 3U)) {
 		DRAWING_Status status;
 		LOG_DRAW_START(fillCircle);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on size and clip are performed after suspend to prevent to perform it several times
 		if (diameter > 0) {
@@ -425,9 +463,11 @@ void LLUI_PAINTER_IMPL_fillCircle(MICROUI_GraphicsContext* gc, jint x, jint y, j
 
 // See the header file for the function documentation
 void LLUI_PAINTER_IMPL_drawImage(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
-	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawImage)) {
+	const jint args[] = { UI_DISPLAY_LIST_image(img), regionX, regionY, width, height, x, y, alpha };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&LLUI_PAINTER_IMPL_drawImage, LOG_DRAW_drawImage, args, 8U)) {
 		DRAWING_Status status = DRAWING_DONE;
 		LOG_DRAW_START(drawImage);
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
 
 		// tests on parameters and clip are performed after suspend to prevent to perform it several times
 		if (!LLUI_DISPLAY_isClosed(img) && (alpha > 0)) {
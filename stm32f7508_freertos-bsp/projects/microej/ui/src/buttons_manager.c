@@ -14,6 +14,7 @@
 #include "interrupts.h"
 #include "LLMJVM.h"
 #include "buttons_helper.h"
+#include "buttons_manager.h"
 
 /* Global --------------------------------------------------------------------*/
 
@@ -23,9 +24,15 @@ static const IRQn_Type BUTTON_IRQn[BUTTONn] = {WAKEUP_BUTTON_EXTI_IRQn};
 static const uint8_t BUTTON_ID[BUTTONn] = {0};
 static const uint8_t BUTTON_REVERSE[BUTTONn] = {MICROEJ_FALSE};
 
+// buttons events of the interrupts, sent by the IO task
+static INPUT_RING_t buttons_ring;
+
 /* Private API ---------------------------------------------------------------*/
 
-static void BUTTONS_MANAGER_event(Button_TypeDef Button)
+/*
+ * Reads the button state
+ */
+static void BUTTONS_MANAGER_read(Button_TypeDef Button, INPUT_RING_event_t* event)
 {
 	uint8_t button_pressed;
 
@@ -61,14 +68,9 @@ static void BUTTONS_MANAGER_event(Button_TypeDef Button)
 		}
 	}
 
-	if (button_pressed == MICROEJ_TRUE)
-	{
-		BUTTONS_HELPER_pressed(BUTTON_ID[Button]);
-	}
-	else
-	{
-		BUTTONS_HELPER_released(BUTTON_ID[Button]);
-	}
+	event->type = (button_pressed == MICROEJ_TRUE) ? INPUT_RING_BUTTON_PRESSED : INPUT_RING_BUTTON_RELEASED;
+	event->id = BUTTON_ID[Button];
+	event->time = INPUT_RING_get_time();
 }
 
 static void BUTTONS_MANAGER_init(Button_TypeDef Button)
@@ -91,13 +93,23 @@ static void BUTTONS_MANAGER_init(Button_TypeDef Button)
 
 /* API -----------------------------------------------------------------------*/
 
-void BUTTONS_MANAGER_interrupt(Button_TypeDef Button)
+uint8_t BUTTONS_MANAGER_interrupt(Button_TypeDef Button)
 {
+  uint8_t wake_up = MICROEJ_FALSE;
+
   if(__HAL_GPIO_EXTI_GET_IT(BUTTON_PIN[Button]) != RESET)
   {
-    BUTTONS_MANAGER_event(Button);
+    INPUT_RING_event_t event;
+    BUTTONS_MANAGER_read(Button, &event);
+
+    // a full ring is resynchronized by the IO task (see BUTTONS_MANAGER_resync())
+    (void)INPUT_RING_push(&buttons_ring, &event);
+    wake_up = MICROEJ_TRUE;
+
     __HAL_GPIO_EXTI_CLEAR_IT(BUTTON_PIN[Button]);
   }
+
+  return wake_up;
 }
 
 void BUTTONS_MANAGER_enable_interrupts(void)
@@ -112,6 +124,36 @@ void BUTTONS_MANAGER_disable_interrupts(void)
 
 void BUTTONS_MANAGER_initialize(void)
 {
+	INPUT_RING_initialize(&buttons_ring);
 	BUTTONS_HELPER_initialize();
 	BUTTONS_MANAGER_init(BUTTON_WAKEUP);
+	BUTTONS_MANAGER_enable_interrupts();
+}
+
+INPUT_RING_t* BUTTONS_MANAGER_get_ring(void)
+{
+	return &buttons_ring;
+}
+
+void BUTTONS_MANAGER_dispatch(const INPUT_RING_event_t* event)
+{
+	if (event->type == INPUT_RING_BUTTON_PRESSED)
+	{
+		BUTTONS_HELPER_pressed(event->id);
+	}
+	else
+	{
+		BUTTONS_HELPER_released(event->id);
+	}
+}
+
+void BUTTONS_MANAGER_resync(void)
+{
+	if (INPUT_RING_overflowed(&buttons_ring))
+	{
+		// events have been lost: send the current state
+		INPUT_RING_event_t event;
+		BUTTONS_MANAGER_read(BUTTON_WAKEUP, &event);
+		BUTTONS_MANAGER_dispatch(&event);
+	}
 }
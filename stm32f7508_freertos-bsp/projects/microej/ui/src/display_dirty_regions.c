@@ -0,0 +1,232 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include "display_dirty_regions.h"
+#include "LLUI_DISPLAY.h"
+#include "framerate.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define RECT_AREA(r) ((uint32_t)((r)->x2 - (r)->x1 + 1) * (uint32_t)((r)->y2 - (r)->y1 + 1))
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+#define MAX(a,b) ((a) > (b) ? (a) : (b))
+
+/* Global --------------------------------------------------------------------*/
+
+#ifdef DISPLAY_DIRTY_REGIONS_ENABLED
+static DISPLAY_DIRTY_REGIONS_rect_t dirty_rects[DISPLAY_DIRTY_REGIONS_MAX];
+static uint32_t dirty_rects_count;
+static bool dirty_unreported;
+#endif
+
+static uint32_t copied_bytes;
+static uint32_t copied_rects;
+
+/* Private API ---------------------------------------------------------------*/
+
+#ifdef DISPLAY_DIRTY_REGIONS_ENABLED
+
+static inline bool _overlap(DISPLAY_DIRTY_REGIONS_rect_t* a, DISPLAY_DIRTY_REGIONS_rect_t* b)
+{
+	return (a->x1 <= b->x2) && (b->x1 <= a->x2) && (a->y1 <= b->y2) && (b->y1 <= a->y2);
+}
+
+static inline void _union(DISPLAY_DIRTY_REGIONS_rect_t* a, DISPLAY_DIRTY_REGIONS_rect_t* b, DISPLAY_DIRTY_REGIONS_rect_t* result)
+{
+	result->x1 = MIN(a->x1, b->x1);
+	result->y1 = MIN(a->y1, b->y1);
+	result->x2 = MAX(a->x2, b->x2);
+	result->y2 = MAX(a->y2, b->y2);
+}
+
+/*
+ * Returns the number of pixels the union of both rectangles adds to the sum of
+ * their areas (the rectangles are not overlapping).
+ */
+static uint32_t _merge_cost(DISPLAY_DIRTY_REGIONS_rect_t* a, DISPLAY_DIRTY_REGIONS_rect_t* b)
+{
+	DISPLAY_DIRTY_REGIONS_rect_t u;
+	_union(a, b, &u);
+	uint32_t areas = RECT_AREA(a) + RECT_AREA(b);
+	uint32_t union_area = RECT_AREA(&u);
+	return union_area > areas ? union_area - areas : 0;
+}
+
+static inline void _remove(uint32_t index)
+{
+	dirty_rects_count--;
+	dirty_rects[index] = dirty_rects[dirty_rects_count];
+}
+
+/*
+ * Merges the candidate with all the rectangles it overlaps or which are cheap to
+ * merge with. The merged rectangles are removed from the list.
+ */
+static void _absorb(DISPLAY_DIRTY_REGIONS_rect_t* candidate)
+{
+	uint32_t i = 0;
+	while (i < dirty_rects_count)
+	{
+		DISPLAY_DIRTY_REGIONS_rect_t* r = &dirty_rects[i];
+		if (_overlap(candidate, r) || (_merge_cost(candidate, r) <= DISPLAY_DIRTY_REGIONS_MERGE_COST))
+		{
+			_union(candidate, r, candidate);
+			_remove(i);
+			// the candidate has grown: check again all the rectangles
+			i = 0;
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+#endif	// DISPLAY_DIRTY_REGIONS_ENABLED
+
+/* API -----------------------------------------------------------------------*/
+
+void DISPLAY_DIRTY_REGIONS_add(uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2)
+{
+#ifdef DISPLAY_DIRTY_REGIONS_ENABLED
+	DISPLAY_DIRTY_REGIONS_rect_t candidate = { (uint16_t)x1, (uint16_t)y1, (uint16_t)x2, (uint16_t)y2 };
+
+	_absorb(&candidate);
+
+	while (dirty_rects_count == DISPLAY_DIRTY_REGIONS_MAX)
+	{
+		// list is full: merge the candidate with the rectangle whose union costs the least
+		uint32_t best = 0;
+		uint32_t best_cost = UINT32_MAX;
+		for (uint32_t i = 0; i < dirty_rects_count; i++)
+		{
+			uint32_t cost = _merge_cost(&candidate, &dirty_rects[i]);
+			if (cost < best_cost)
+			{
+				best_cost = cost;
+				best = i;
+			}
+		}
+		_union(&candidate, &dirty_rects[best], &candidate);
+		_remove(best);
+
+		// the union may overlap other rectangles
+		_absorb(&candidate);
+	}
+
+	dirty_rects[dirty_rects_count] = candidate;
+	dirty_rects_count++;
+#else
+	(void)x1;
+	(void)y1;
+	(void)x2;
+	(void)y2;
+#endif
+}
+
+void DISPLAY_DIRTY_REGIONS_add_unreported(void)
+{
+#ifdef DISPLAY_DIRTY_REGIONS_ENABLED
+	dirty_unreported = true;
+#endif
+}
+
+void DISPLAY_DIRTY_REGIONS_add_clip(MICROUI_GraphicsContext* gc)
+{
+#ifdef FRAMERATE_ENABLED
+	if (LLUI_DISPLAY_isLCD(&gc->image))
+	{
+		// first drawing of the frame: start of the render time
+		framerate_frame_drawing();
+	}
+#endif
+
+#ifdef DISPLAY_DIRTY_REGIONS_ENABLED
+	if (LLUI_DISPLAY_isLCD(&gc->image) && (gc->clip_x1 <= gc->clip_x2) && (gc->clip_y1 <= gc->clip_y2))
+	{
+		DISPLAY_DIRTY_REGIONS_add(gc->clip_x1, gc->clip_y1, gc->clip_x2, gc->clip_y2);
+	}
+#else
+	(void)gc;
+#endif
+}
+
+uint32_t DISPLAY_DIRTY_REGIONS_flush(uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, DISPLAY_DIRTY_REGIONS_rect_t* rects)
+{
+	uint32_t count = 0;
+
+#ifdef DISPLAY_DIRTY_REGIONS_ENABLED
+	DISPLAY_DIRTY_REGIONS_rect_t flush_rect = { (uint16_t)xmin, (uint16_t)ymin, (uint16_t)xmax, (uint16_t)ymax };
+	DISPLAY_DIRTY_REGIONS_rect_t bounds = { UINT16_MAX, UINT16_MAX, 0, 0 };
+
+	// keep the rectangles parts inside the flush bounding box
+	for (uint32_t i = 0; i < dirty_rects_count; i++)
+	{
+		DISPLAY_DIRTY_REGIONS_rect_t* r = &dirty_rects[i];
+		if (_overlap(r, &flush_rect))
+		{
+			DISPLAY_DIRTY_REGIONS_rect_t* out = &rects[count];
+			out->x1 = MAX(r->x1, flush_rect.x1);
+			out->y1 = MAX(r->y1, flush_rect.y1);
+			out->x2 = MIN(r->x2, flush_rect.x2);
+			out->y2 = MIN(r->y2, flush_rect.y2);
+			_union(&bounds, out, &bounds);
+			count++;
+		}
+	}
+
+#ifdef DISPLAY_DIRTY_REGIONS_ENGINE_DRAWINGS
+	// the Graphics Engine may have drawn anywhere in the bounding box (strings)
+	dirty_unreported = true;
+#endif
+
+	if (dirty_unreported || (bounds.x1 != flush_rect.x1) || (bounds.y1 != flush_rect.y1) || (bounds.x2 != flush_rect.x2) || (bounds.y2 != flush_rect.y2))
+	{
+		// some drawings have not been reported: use the flush bounding box
+		count = 0;
+	}
+
+	// start a new frame
+	dirty_rects_count = 0;
+	dirty_unreported = false;
+#endif
+
+	if (count == 0)
+	{
+		rects[0].x1 = (uint16_t)xmin;
+		rects[0].y1 = (uint16_t)ymin;
+		rects[0].x2 = (uint16_t)xmax;
+		rects[0].y2 = (uint16_t)ymax;
+		count = 1;
+	}
+
+	return count;
+}
+
+void DISPLAY_DIRTY_REGIONS_account(DISPLAY_DIRTY_REGIONS_rect_t* rects, uint32_t count, uint32_t bpp)
+{
+	uint32_t pixels = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		pixels += RECT_AREA(&rects[i]);
+	}
+	copied_bytes = (pixels * bpp) / 8;
+	copied_rects = count;
+}
+
+uint32_t DISPLAY_DIRTY_REGIONS_get_copied_bytes(void)
+{
+	return copied_bytes;
+}
+
+uint32_t DISPLAY_DIRTY_REGIONS_get_copied_rects(void)
+{
+	return copied_rects;
+}
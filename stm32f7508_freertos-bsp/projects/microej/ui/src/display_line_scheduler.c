@@ -0,0 +1,177 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "display_line_scheduler.h"
+#include "stm32f7508_discovery_lcd.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * A waiting Java thread is resumed after this delay when the LTDC does not scan the
+ * line (display stopped): three refresh periods.
+ */
+#define LINE_SCHEDULER_TIMEOUT_MS 50
+
+#define NO_THREAD (-1)
+
+/* Global --------------------------------------------------------------------*/
+
+// Java thread waiting for the line event
+static volatile int32_t waiting_thread = NO_THREAD;
+
+// line waited by DISPLAY_LINE_SCHEDULER_wait_line()
+static int32_t scheduler_line = DISPLAY_LINE_SCHEDULER_LINE;
+
+static volatile bool front_buffer_drawing;
+
+extern LTDC_HandleTypeDef hLtdcHandler;
+
+/* Private API ---------------------------------------------------------------*/
+
+/*
+ * Position of the line 0 in the LTDC lines counter (after the vertical synchronization
+ * and back porch lines).
+ */
+static inline int32_t _first_line(void)
+{
+	return (int32_t)hLtdcHandler.Init.AccumulatedVBP + 1;
+}
+
+/*
+ * Number of lines scanned by the LTDC per refresh.
+ */
+static inline int32_t _total_lines(void)
+{
+	return (int32_t)hLtdcHandler.Init.TotalHeigh + 1;
+}
+
+/*
+ * Programs the line interrupt and suspends the current Java thread until the interrupt.
+ */
+static bool _wait(int32_t line)
+{
+	int32_t thread = SNI_getCurrentJavaThreadID();
+	bool ret = (waiting_thread == NO_THREAD) || (waiting_thread == thread);
+
+	if (ret)
+	{
+		int32_t position = line + _first_line();
+		position = position < 0 ? 0 : position;
+		position = position >= _total_lines() ? _total_lines() - 1 : position;
+
+		waiting_thread = thread;
+
+		// prevent the LTDC interrupt from using the HAL handle (triple buffering)
+		HAL_NVIC_DisableIRQ(LTDC_IRQn);
+		HAL_LTDC_ProgramLineEvent(&hLtdcHandler, (uint32_t)position);
+		HAL_NVIC_EnableIRQ(LTDC_IRQn);
+
+		// the thread is not suspended when the interrupt occurs before the end of the native
+		(void)SNI_suspendCurrentJavaThread(LINE_SCHEDULER_TIMEOUT_MS);
+	}
+
+	return ret;
+}
+
+/* API -----------------------------------------------------------------------*/
+
+int32_t DISPLAY_LINE_SCHEDULER_get_line(void)
+{
+	return (int32_t)(hLtdcHandler.Instance->CPSR & LTDC_CPSR_CYPOS) - _first_line();
+}
+
+void DISPLAY_LINE_SCHEDULER_set_line(int32_t line)
+{
+	scheduler_line = line < 0 ? 0 : (line > RK043FN48H_HEIGHT ? RK043FN48H_HEIGHT : line);
+}
+
+bool DISPLAY_LINE_SCHEDULER_wait_line(void)
+{
+	return _wait(scheduler_line);
+}
+
+bool DISPLAY_LINE_SCHEDULER_is_area_safe(int32_t y1, int32_t y2)
+{
+	int32_t total = _total_lines();
+	int32_t beam = DISPLAY_LINE_SCHEDULER_get_line();
+	bool ret = false;
+
+	if ((beam < y1) || (beam > y2))
+	{
+		// lines scanned before the beam reaches the area (in this refresh or in the next one)
+		int32_t lines = ((y1 - beam) + total) % total;
+		ret = lines > DISPLAY_LINE_SCHEDULER_MARGIN;
+	}
+	// else: the beam is in the area
+
+	return ret;
+}
+
+bool DISPLAY_LINE_SCHEDULER_wait_area(int32_t y1, int32_t y2)
+{
+	bool ret = true;
+	if (!DISPLAY_LINE_SCHEDULER_is_area_safe(y1, y2))
+	{
+		// chase the beam: draw just after the LTDC has scanned the area
+		ret = _wait(y2 + 1);
+	}
+	return ret;
+}
+
+void DISPLAY_LINE_SCHEDULER_set_front_buffer_drawing(bool enable)
+{
+	front_buffer_drawing = enable;
+}
+
+bool DISPLAY_LINE_SCHEDULER_is_front_buffer_drawing(void)
+{
+	return front_buffer_drawing;
+}
+
+void DISPLAY_LINE_SCHEDULER_line_event(void)
+{
+	int32_t thread = waiting_thread;
+	if (thread != NO_THREAD)
+	{
+		waiting_thread = NO_THREAD;
+		(void)SNI_resumeJavaThread(thread);
+	}
+}
+
+/* Natives -------------------------------------------------------------------*/
+
+jint Java_com_microej_ui_Vsync_getScanLine(void)
+{
+	return DISPLAY_LINE_SCHEDULER_get_line();
+}
+
+void Java_com_microej_ui_Vsync_setLine(jint line)
+{
+	DISPLAY_LINE_SCHEDULER_set_line(line);
+}
+
+jboolean Java_com_microej_ui_Vsync_waitLine(void)
+{
+	return DISPLAY_LINE_SCHEDULER_wait_line() ? JTRUE : JFALSE;
+}
+
+jboolean Java_com_microej_ui_Vsync_waitArea(jint y, jint height)
+{
+	jboolean ret = JTRUE;
+	if (height > 0)
+	{
+		ret = DISPLAY_LINE_SCHEDULER_wait_area(y, y + height - 1) ? JTRUE : JFALSE;
+	}
+	return ret;
+}
+
+void Java_com_microej_ui_Vsync_setFrontBufferDrawing(jboolean enable)
+{
+	DISPLAY_LINE_SCHEDULER_set_front_buffer_drawing(JFALSE != enable);
+}
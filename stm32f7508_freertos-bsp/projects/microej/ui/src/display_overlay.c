@@ -0,0 +1,389 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include "display_overlay.h"
+#include "stm32f7508_discovery_lcd.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "LLUI_DISPLAY.h"
+#include "ui_drawing.h"
+#include "ui_drawing_dma2d_cache.h"
+
+#ifdef DISPLAY_OVERLAY_BENCHMARK
+#include <stdio.h>
+#include "framerate_impl.h"
+#ifndef FRAMERATE_ENABLED
+#error "DISPLAY_OVERLAY_BENCHMARK requires FRAMERATE_ENABLED (see framerate_conf.h)"
+#endif
+#endif
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * The image shown on the overlay plane.
+ */
+typedef struct
+{
+	uint8_t* buffer; // NULL when the overlay is hidden
+	uint32_t stride; // in pixels
+	uint32_t width;
+	uint32_t height;
+	uint32_t bpp; // in bytes
+	uint32_t pixel_format; // LTDC pixel format
+	int32_t x;
+	int32_t y;
+	uint32_t alpha;
+} overlay_t;
+
+/* Global --------------------------------------------------------------------*/
+
+#ifdef DISPLAY_OVERLAY_ENABLED
+
+static overlay_t overlay;
+
+/*
+ * Given by the LTDC reload interrupt when the configuration written by _apply() is
+ * applied (see DISPLAY_OVERLAY_reload_event()).
+ */
+static SemaphoreHandle_t reload_sem;
+static volatile bool reload_waited;
+
+#ifdef DISPLAY_OVERLAY_BENCHMARK
+static uint32_t benchmark_updates;
+static uint32_t benchmark_update_cycles;
+#endif
+
+extern LTDC_HandleTypeDef hLtdcHandler;
+
+/* Private API ---------------------------------------------------------------*/
+
+/*
+ * Gets the LTDC pixel format and the size of a pixel of a MicroUI format.
+ *
+ * @return false when the LTDC cannot read the format
+ */
+static bool _get_pixel_format(jbyte format, uint32_t* pixel_format, uint32_t* bpp)
+{
+	bool ret = true;
+	switch (format)
+	{
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+		*pixel_format = LTDC_PIXEL_FORMAT_ARGB8888;
+		*bpp = 4;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		*pixel_format = LTDC_PIXEL_FORMAT_RGB888;
+		*bpp = 3;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		*pixel_format = LTDC_PIXEL_FORMAT_RGB565;
+		*bpp = 2;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+		*pixel_format = LTDC_PIXEL_FORMAT_ARGB1555;
+		*bpp = 2;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+		*pixel_format = LTDC_PIXEL_FORMAT_ARGB4444;
+		*bpp = 2;
+		break;
+	default:
+		// A8 (the LTDC A8 format has no color), L8 (requires a CLUT), etc.
+		ret = false;
+		break;
+	}
+	return ret;
+}
+
+/*
+ * Writes the data cache back in the overlay image.
+ */
+static void _clean_cache(void)
+{
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	DRAWING_DMA2D_CACHE_area_t area;
+	DRAWING_DMA2D_CACHE_set_area(&area, overlay.buffer, 0, 0, overlay.width, overlay.height, overlay.stride, overlay.bpp * 8);
+	DRAWING_DMA2D_CACHE_clean(&area);
+#endif
+}
+
+/*
+ * Configures the overlay layer with the visible part of the image and asks the LTDC to
+ * apply the configuration at next vertical blanking.
+ */
+static void _apply(void)
+{
+#ifdef DISPLAY_OVERLAY_BENCHMARK
+	uint32_t t0 = framerate_impl_get_cycles();
+#endif
+	// visible part of the image in the display (x2 and y2 excluded)
+	int32_t x1 = overlay.x < 0 ? 0 : overlay.x;
+	int32_t y1 = overlay.y < 0 ? 0 : overlay.y;
+	int32_t x2 = overlay.x + (int32_t)overlay.width;
+	int32_t y2 = overlay.y + (int32_t)overlay.height;
+	x2 = x2 > RK043FN48H_WIDTH ? RK043FN48H_WIDTH : x2;
+	y2 = y2 > RK043FN48H_HEIGHT ? RK043FN48H_HEIGHT : y2;
+
+	// prevent the LTDC interrupt from using the HAL handle (triple buffering)
+	HAL_NVIC_DisableIRQ(LTDC_IRQn);
+
+	if ((NULL != overlay.buffer) && (overlay.alpha > 0U) && (x1 < x2) && (y1 < y2))
+	{
+		LTDC_LayerCfgTypeDef config;
+		config.WindowX0 = (uint32_t)x1;
+		config.WindowX1 = (uint32_t)x2;
+		config.WindowY0 = (uint32_t)y1;
+		config.WindowY1 = (uint32_t)y2;
+		config.PixelFormat = overlay.pixel_format;
+		config.Alpha = overlay.alpha;
+		config.Alpha0 = 0;
+		config.BlendingFactor1 = LTDC_BLENDING_FACTOR1_PAxCA;
+		config.BlendingFactor2 = LTDC_BLENDING_FACTOR2_PAxCA;
+		// the LTDC starts reading at the first visible pixel; the pitch is the image stride
+		config.FBStartAdress = (uint32_t)overlay.buffer + ((((uint32_t)(y1 - overlay.y) * overlay.stride) + (uint32_t)(x1 - overlay.x)) * overlay.bpp);
+		config.ImageWidth = overlay.stride;
+		config.ImageHeight = (uint32_t)(y2 - y1);
+		config.Backcolor.Blue = 0;
+		config.Backcolor.Green = 0;
+		config.Backcolor.Red = 0;
+		// enables the layer
+		HAL_LTDC_ConfigLayer_NoReload(&hLtdcHandler, &config, DISPLAY_OVERLAY_LAYER);
+	}
+	else
+	{
+		// hidden, transparent or outside the display: the LTDC does not read the layer
+		__HAL_LTDC_LAYER_DISABLE(&hLtdcHandler, DISPLAY_OVERLAY_LAYER);
+	}
+
+	// the display buffers are not flushed: the reload event is ignored by LLUI_DISPLAY.c
+	HAL_LTDC_Reload(&hLtdcHandler, LTDC_RELOAD_VERTICAL_BLANKING);
+
+	HAL_NVIC_EnableIRQ(LTDC_IRQn);
+
+#ifdef DISPLAY_OVERLAY_BENCHMARK
+	benchmark_update_cycles += framerate_impl_get_cycles() - t0;
+	benchmark_updates++;
+	if (DISPLAY_OVERLAY_BENCHMARK_UPDATES == benchmark_updates)
+	{
+		printf("Overlay benchmark: %u us per update (%u updates)\n", (unsigned int)(framerate_impl_cycles_to_us(benchmark_update_cycles) / DISPLAY_OVERLAY_BENCHMARK_UPDATES), (unsigned int)DISPLAY_OVERLAY_BENCHMARK_UPDATES);
+		benchmark_updates = 0;
+		benchmark_update_cycles = 0;
+	}
+#endif
+}
+
+/*
+ * Waits until the LTDC has applied the configuration (the reload is performed at
+ * vertical blanking): the LTDC does not read the previous configuration anymore. The
+ * task sleeps until the reload interrupt (at most one frame).
+ */
+static void _wait_reload(void)
+{
+#ifdef DISPLAY_OVERLAY_BENCHMARK
+	uint32_t t0 = framerate_impl_get_cycles();
+#endif
+	HAL_NVIC_DisableIRQ(LTDC_IRQn);
+	// a reload given before this call is not the awaited one
+	(void)xSemaphoreTake(reload_sem, 0);
+	// the reload may already be done
+	bool pending = 0U != (hLtdcHandler.Instance->SRCR & LTDC_SRCR_VBR);
+	reload_waited = pending;
+	HAL_NVIC_EnableIRQ(LTDC_IRQn);
+
+	if (pending)
+	{
+		(void)xSemaphoreTake(reload_sem, portMAX_DELAY);
+	}
+
+#ifdef DISPLAY_OVERLAY_BENCHMARK
+	printf("Overlay benchmark: %u us until the reload\n", (unsigned int)framerate_impl_cycles_to_us(framerate_impl_get_cycles() - t0));
+#endif
+}
+
+/* API -----------------------------------------------------------------------*/
+
+void DISPLAY_OVERLAY_initialize(void)
+{
+	reload_sem = xSemaphoreCreateBinary();
+}
+
+void DISPLAY_OVERLAY_reload_event(void)
+{
+	// the reload requested by _apply() is done when the LTDC has cleared the request (the
+	// interrupt may be the one of a reload requested before)
+	if (reload_waited && (0U == (hLtdcHandler.Instance->SRCR & LTDC_SRCR_VBR)))
+	{
+		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+		reload_waited = false;
+		xSemaphoreGiveFromISR(reload_sem, &xHigherPriorityTaskWoken);
+		if (xHigherPriorityTaskWoken != pdFALSE)
+		{
+			// Force a context switch here.
+			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		}
+	}
+}
+
+bool DISPLAY_OVERLAY_show(MICROUI_Image* image, int32_t x, int32_t y, uint32_t alpha)
+{
+	uint32_t pixel_format;
+	uint32_t bpp;
+	bool ret = _get_pixel_format(image->format, &pixel_format, &bpp);
+
+	if (ret)
+	{
+		overlay.buffer = LLUI_DISPLAY_getBufferAddress(image);
+		overlay.stride = LLUI_DISPLAY_getStrideInPixels(image);
+		overlay.width = image->width;
+		overlay.height = image->height;
+		overlay.bpp = bpp;
+		overlay.pixel_format = pixel_format;
+		overlay.x = x;
+		overlay.y = y;
+		overlay.alpha = alpha > 0xffU ? 0xffU : alpha;
+		_clean_cache();
+		_apply();
+	}
+	return ret;
+}
+
+void DISPLAY_OVERLAY_move(int32_t x, int32_t y)
+{
+	if ((NULL != overlay.buffer) && ((x != overlay.x) || (y != overlay.y)))
+	{
+		overlay.x = x;
+		overlay.y = y;
+		_apply();
+	}
+}
+
+void DISPLAY_OVERLAY_set_opacity(uint32_t alpha)
+{
+	uint32_t a = alpha > 0xffU ? 0xffU : alpha;
+	if ((NULL != overlay.buffer) && (a != overlay.alpha))
+	{
+		overlay.alpha = a;
+		_apply();
+	}
+}
+
+void DISPLAY_OVERLAY_update(void)
+{
+	if (NULL != overlay.buffer)
+	{
+		_clean_cache();
+	}
+}
+
+void DISPLAY_OVERLAY_hide(void)
+{
+	if (NULL != overlay.buffer)
+	{
+		overlay.buffer = NULL;
+		_apply();
+	}
+}
+
+void DISPLAY_OVERLAY_free_image(MICROUI_Image* image)
+{
+	if ((NULL != overlay.buffer) && (LLUI_DISPLAY_getBufferAddress(image) == overlay.buffer))
+	{
+		// the LTDC must not read the image memory anymore: the image memory is freed
+		// after this call
+		DISPLAY_OVERLAY_hide();
+		_wait_reload();
+	}
+}
+
+/*
+ * Overrides the weak function of ui_drawing.c called when an image in the display format
+ * (or in a format without drawer) is closed.
+ */
+void UI_DRAWING_freeImageResources(MICROUI_Image* image)
+{
+	DISPLAY_OVERLAY_free_image(image);
+}
+
+#else // DISPLAY_OVERLAY_ENABLED
+
+void DISPLAY_OVERLAY_initialize(void)
+{
+	// no overlay plane
+}
+
+void DISPLAY_OVERLAY_reload_event(void)
+{
+	// no overlay plane
+}
+
+bool DISPLAY_OVERLAY_show(MICROUI_Image* image, int32_t x, int32_t y, uint32_t alpha)
+{
+	// no overlay plane
+	(void)image;
+	(void)x;
+	(void)y;
+	(void)alpha;
+	return false;
+}
+
+void DISPLAY_OVERLAY_move(int32_t x, int32_t y)
+{
+	(void)x;
+	(void)y;
+}
+
+void DISPLAY_OVERLAY_set_opacity(uint32_t alpha)
+{
+	(void)alpha;
+}
+
+void DISPLAY_OVERLAY_update(void)
+{
+	// no overlay plane
+}
+
+void DISPLAY_OVERLAY_hide(void)
+{
+	// no overlay plane
+}
+
+void DISPLAY_OVERLAY_free_image(MICROUI_Image* image)
+{
+	(void)image;
+}
+
+#endif // DISPLAY_OVERLAY_ENABLED
+
+/* Natives -------------------------------------------------------------------*/
+
+jboolean Java_com_microej_ui_Overlay_show(MICROUI_Image* image, jint x, jint y, jint alpha)
+{
+	return DISPLAY_OVERLAY_show(image, x, y, alpha < 0 ? 0U : (uint32_t)alpha) ? JTRUE : JFALSE;
+}
+
+void Java_com_microej_ui_Overlay_move(jint x, jint y)
+{
+	DISPLAY_OVERLAY_move(x, y);
+}
+
+void Java_com_microej_ui_Overlay_setOpacity(jint alpha)
+{
+	DISPLAY_OVERLAY_set_opacity(alpha < 0 ? 0U : (uint32_t)alpha);
+}
+
+void Java_com_microej_ui_Overlay_update(void)
+{
+	DISPLAY_OVERLAY_update();
+}
+
+void Java_com_microej_ui_Overlay_hide(void)
+{
+	DISPLAY_OVERLAY_hide();
+}
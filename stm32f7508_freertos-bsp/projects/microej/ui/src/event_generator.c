@@ -110,3 +110,13 @@ int32_t EVENT_GENERATOR_touch_released(void)
 {
 	return LLUI_INPUT_sendTouchReleasedEvent(MICROUI_EVENTGEN_TOUCH);
 }
+
+/* Gestures ------------------------------------------------------------------*/
+
+#ifdef MICROUI_EVENTGEN_GESTURES
+int32_t EVENT_GENERATOR_gesture(int32_t* events, int32_t length)
+{
+	// send a MicroUI generic event (see touch_gesture.h)
+	return LLUI_INPUT_sendEvents(MICROUI_EVENTGEN_GESTURES, events, length);
+}
+#endif
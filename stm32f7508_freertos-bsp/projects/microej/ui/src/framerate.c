@@ -10,16 +10,144 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include "framerate_impl.h"
 
+/* Defines -------------------------------------------------------------------*/
+
+#if FRAMERATE_HISTOGRAM_BUCKETS > 256
+#error "The histogram samples are stored on 8 bits: FRAMERATE_HISTOGRAM_BUCKETS must be at most 256"
+#endif
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * Rolling histogram of a metric: the bucket of each frame of the window is kept to
+ * remove the frame from the histogram when it leaves the window.
+ */
+typedef struct
+{
+	uint16_t buckets[FRAMERATE_HISTOGRAM_BUCKETS];
+	uint8_t samples[FRAMERATE_HISTOGRAM_FRAMES];
+	uint32_t next; // index of the next sample in the window
+	uint32_t count; // number of samples in the window
+} framerate_histogram_t;
+
 /* Globals -------------------------------------------------------------------*/
 
 #ifdef FRAMERATE_ENABLED
 static uint32_t framerate_schedule_time = 0;	// means "not initialised"
 static uint32_t framerate_counter;
 static uint32_t framerate_last;
+
+static framerate_histogram_t framerate_histograms[FRAMERATE_METRICS];
+
+// start of the render time of the frame being drawn
+static bool framerate_drawing;
+static uint32_t framerate_drawing_cycles;
+
+// flush time of the last frame and its latency (set under interrupt)
+static volatile uint32_t framerate_flush_cycles;
+static volatile uint32_t framerate_vsync_latency;
+static volatile bool framerate_vsync;
+
+// pacing state
+static int32_t framerate_pacing_mode = FRAMERATE_PACING_OFF;
+static uint32_t framerate_pacing_divisor = 1;
+static uint32_t framerate_pacing_frames;
 #endif
 
+/* Private API ---------------------------------------------------------------*/
+
+#ifdef FRAMERATE_ENABLED
+
+static void _histogram_add(framerate_histogram_t* histogram, uint32_t us)
+{
+	uint32_t bucket = us / FRAMERATE_HISTOGRAM_BUCKET_US;
+	bucket = bucket < FRAMERATE_HISTOGRAM_BUCKETS ? bucket : FRAMERATE_HISTOGRAM_BUCKETS - 1;
+
+	if (histogram->count == FRAMERATE_HISTOGRAM_FRAMES)
+	{
+		// window is full: remove the oldest frame
+		histogram->buckets[histogram->samples[histogram->next]]--;
+	}
+	else
+	{
+		histogram->count++;
+	}
+
+	histogram->samples[histogram->next] = (uint8_t)bucket;
+	histogram->buckets[bucket]++;
+	histogram->next = (histogram->next + 1) % FRAMERATE_HISTOGRAM_FRAMES;
+}
+
+static uint32_t _histogram_percentile(framerate_histogram_t* histogram, uint32_t percentile)
+{
+	uint32_t ret = 0;
+
+	if (histogram->count > 0)
+	{
+		// rank of the sample in the sorted window (nearest-rank method)
+		uint32_t rank = ((histogram->count * percentile) + 99) / 100;
+		rank = rank > 0 ? rank : 1;
+
+		uint32_t cumulated = 0;
+		uint32_t bucket = 0;
+		while ((cumulated + histogram->buckets[bucket]) < rank)
+		{
+			cumulated += histogram->buckets[bucket];
+			bucket++;
+		}
+		ret = (bucket + 1) * FRAMERATE_HISTOGRAM_BUCKET_US;
+	}
+
+	return ret;
+}
+
+/*
+ * Update the divisor from the time the Graphics Engine needs per frame and wait for
+ * the end of the frame period
+ */
+static void _pace(uint32_t now)
+{
+	framerate_pacing_frames++;
+	if (framerate_pacing_frames >= FRAMERATE_PACING_PERIOD)
+	{
+		framerate_pacing_frames = 0;
+
+		uint32_t cost = _histogram_percentile(&framerate_histograms[FRAMERATE_METRIC_RENDER], 95)
+				+ _histogram_percentile(&framerate_histograms[FRAMERATE_METRIC_RESTORE], 95);
+		uint32_t needed = (cost + FRAMERATE_PANEL_REFRESH_US - 1) / FRAMERATE_PANEL_REFRESH_US;
+		needed = needed > 0 ? needed : 1;
+		needed = needed < FRAMERATE_PACING_MAX_DIVISOR ? needed : FRAMERATE_PACING_MAX_DIVISOR;
+
+		if (needed > framerate_pacing_divisor)
+		{
+			// frames would miss the vertical blanking: slow down at once
+			framerate_pacing_divisor = needed;
+		}
+		else if ((needed < framerate_pacing_divisor) && ((cost * 10) < ((framerate_pacing_divisor - 1) * FRAMERATE_PANEL_REFRESH_US * 9)))
+		{
+			// frames fit in a shorter period with a 10% margin: speed up one step at a time
+			framerate_pacing_divisor--;
+		}
+		// else: keep the current divisor
+	}
+
+	if (framerate_pacing_divisor > 1)
+	{
+		uint32_t elapsed = framerate_impl_cycles_to_us(now - framerate_flush_cycles);
+		uint32_t period = framerate_pacing_divisor * FRAMERATE_PANEL_REFRESH_US;
+		if ((elapsed + 1000) < period)
+		{
+			// wake up before the end of the period (the flush waits for the vertical blanking)
+			framerate_impl_sleep((period - elapsed) / 1000);
+		}
+	}
+}
+
+#endif	// FRAMERATE_ENABLED
+
 /* API -----------------------------------------------------------------------*/
 
 int32_t framerate_init(int32_t schedule_time)
@@ -65,6 +193,105 @@ uint32_t framerate_get(void)
 #endif
 }
 
+void framerate_frame_drawing(void)
+{
+#ifdef FRAMERATE_ENABLED
+	if (!framerate_drawing)
+	{
+		framerate_drawing = true;
+		framerate_drawing_cycles = framerate_impl_get_cycles();
+	}
+#endif
+}
+
+void framerate_frame_flush(uint32_t restore_cycles)
+{
+#ifdef FRAMERATE_ENABLED
+	uint32_t now = framerate_impl_get_cycles();
+
+	if (framerate_drawing)
+	{
+		framerate_drawing = false;
+		_histogram_add(&framerate_histograms[FRAMERATE_METRIC_RENDER], framerate_impl_cycles_to_us(now - framerate_drawing_cycles));
+	}
+	// else: no drawing reported (only strings for instance)
+
+	if (restore_cycles > 0)
+	{
+		// the restore copy of the previous frame is done (the frame has been drawn after it)
+		_histogram_add(&framerate_histograms[FRAMERATE_METRIC_RESTORE], framerate_impl_cycles_to_us(restore_cycles));
+	}
+
+	if (framerate_vsync)
+	{
+		// the previous frame has been displayed
+		framerate_vsync = false;
+		_histogram_add(&framerate_histograms[FRAMERATE_METRIC_FLUSH_LATENCY], framerate_vsync_latency);
+	}
+
+	if (framerate_pacing_mode == FRAMERATE_PACING_ADAPTIVE)
+	{
+		_pace(now);
+		now = framerate_impl_get_cycles();
+	}
+
+	framerate_flush_cycles = now;
+#else
+	(void)restore_cycles;
+#endif
+}
+
+void framerate_frame_vsync(void)
+{
+#ifdef FRAMERATE_ENABLED
+	framerate_vsync_latency = framerate_impl_cycles_to_us(framerate_impl_get_cycles() - framerate_flush_cycles);
+	framerate_vsync = true;
+#endif
+}
+
+uint32_t framerate_get_percentile(int32_t metric, int32_t percentile)
+{
+#ifdef FRAMERATE_ENABLED
+	uint32_t ret = 0;
+	if ((metric >= 0) && (metric < FRAMERATE_METRICS) && (percentile > 0) && (percentile <= 100))
+	{
+		ret = _histogram_percentile(&framerate_histograms[metric], (uint32_t)percentile);
+	}
+	return ret;
+#else
+	(void)metric;
+	(void)percentile;
+	return 0;
+#endif
+}
+
+int32_t framerate_set_pacing(int32_t mode)
+{
+#ifdef FRAMERATE_ENABLED
+	if ((mode != FRAMERATE_PACING_OFF) && (mode != FRAMERATE_PACING_ADAPTIVE))
+	{
+		return FRAMERATE_ERROR;
+	}
+
+	framerate_pacing_mode = mode;
+	framerate_pacing_divisor = 1;
+	framerate_pacing_frames = 0;
+	return FRAMERATE_OK;
+#else
+	(void)mode;
+	return FRAMERATE_ERROR;
+#endif
+}
+
+uint32_t framerate_get_pacing_divisor(void)
+{
+#ifdef FRAMERATE_ENABLED
+	return framerate_pacing_divisor;
+#else
+	return 1;
+#endif
+}
+
 void framerate_task_work(void)
 {
 #ifdef FRAMERATE_ENABLED
@@ -93,3 +320,18 @@ uint32_t javaFramerateGet(void)
 {
 	return framerate_get();
 }
+
+uint32_t javaFramerateGetPercentile(int32_t metric, int32_t percentile)
+{
+	return framerate_get_percentile(metric, percentile);
+}
+
+int32_t javaFramerateSetPacing(int32_t mode)
+{
+	return framerate_set_pacing(mode);
+}
+
+uint32_t javaFramerateGetPacingDivisor(void)
+{
+	return framerate_get_pacing_divisor();
+}
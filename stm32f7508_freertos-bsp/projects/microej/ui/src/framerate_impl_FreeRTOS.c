@@ -10,15 +10,37 @@
  * Implementation for FreeRTOS
  */
 
-#include "framerate_conf.h"
-#ifdef FRAMERATE_ENABLED
-
 /* Includes ------------------------------------------------------------------*/
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "stm32f7xx_hal.h"
 #include "framerate_impl.h"
 
+/* Cycles counter ------------------------------------------------------------*/
+
+uint32_t framerate_impl_get_cycles(void)
+{
+	if (0U == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+	{
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		/*
+		* Magic number described in section B2.3.10 of
+		* ARM CoreSight Architecture Specification document (v3.0)
+		*/
+		DWT->LAR = 0xC5ACCE55;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+	return DWT->CYCCNT;
+}
+
+uint32_t framerate_impl_cycles_to_us(uint32_t cycles)
+{
+	return cycles / (SystemCoreClock / 1000000);
+}
+
+#ifdef FRAMERATE_ENABLED
+
 /* Defines -------------------------------------------------------------------*/
 
 #define FRAMERATE_STACK_SIZE ( 512 )
@@ -39,6 +61,9 @@ static void _framerate_task(void * pvParameters)
 
 int32_t framerate_impl_start_task(void)
 {
+	// the cycles counter measures the frame times
+	(void)framerate_impl_get_cycles();
+
 	BaseType_t xReturn = xTaskCreate( _framerate_task, "FRAMERATE", FRAMERATE_TASK_STACK_SIZE, NULL, FRAMERATE_TASK_PRIORITY, NULL );
 	return xReturn == pdPASS ? FRAMERATE_OK : FRAMERATE_ERROR;
 }
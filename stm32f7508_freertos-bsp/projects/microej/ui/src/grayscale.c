@@ -5,180 +5,774 @@
  * This library is provided in source code for use, modification and test, subject to license terms.
  * Any modification of the source code will break MicroEJ Corp. warranties on the whole library.
  */
-#include <stdint.h>
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+#include "grayscale.h"
 #include "LLUI_DISPLAY.h"
-#include "LLDISPLAY_configuration.h"
-
-#define GRAYSCALE_ALGO_1	1	// (r + g + b)/3
-#define GRAYSCALE_ALGO_2	2	// (r*0.299 + g*0.587 + b*0.144)
-#define GRAYSCALE_ALGO_3	3	// (r*0.2126 + g*0.7152 + b*0.0722)
-
-/* ======================================= */
-#define GRAYSCALE_ALGO	GRAYSCALE_ALGO_3
-/* ======================================= */
-
-#define LCD_ID		0x00
-#define RLE1_ID		0x01
-#define ARGB8888_ID	0x02
-#define RGB888_ID	0x03
-#define RGB565_ID	0x04
-#define ARGB1555_ID	0x05
-#define ARGB4444_ID	0x06
-
-#if GRAYSCALE_ALGO == GRAYSCALE_ALGO_2
-#define RED_FACTOR 306		// 0.299 * 1024
-#define GREEN_FACTOR 601	// 0.587 * 1024
-#define BLUE_FACTOR 117		// 0.114 * 1024
-#define SHIFT_FACTOR 10		// 1024
+#include "display_dirty_regions.h"
+#include "microui_heap.h"
+#include "ui_display_list.h"
+
+#ifdef GRAYSCALE_DMA2D_ENABLED
+#include "ui_drawing_dma2d.h"
+#include "ui_drawing_dma2d_configuration.h"
+#include "ui_drawing_dma2d_cache.h"
+#endif
+
+#ifdef GRAYSCALE_BENCHMARK
+#include "framerate_impl.h"
+#ifndef FRAMERATE_ENABLED
+#error "GRAYSCALE_BENCHMARK requires FRAMERATE_ENABLED (see framerate_conf.h)"
+#endif
 #endif
 
-#if GRAYSCALE_ALGO == GRAYSCALE_ALGO_3
-#define RED_FACTOR 3483			// 0.2126 * 16384
-#define GREEN_FACTOR 11718	// 0.7152 * 16384
-#define BLUE_FACTOR 1183		// 0.0722 * 16384
-#define SHIFT_FACTOR 14			// 16384
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * Number of pixels converted at once by the CPU (a multiple of 8: the chunks of the
+ * formats with less than 8 bits per pixel start on a byte)
+ */
+#define GRAYSCALE_CHUNK_PIXELS 256
+
+/*
+ * Alpha of the intermediate AL88 pixels (alpha in the high byte, gray level in the low
+ * byte) of an opaque pixel
+ */
+#define GRAYSCALE_OPAQUE 0xff00U
+
+/*
+ * The weights of the channels are in 1/65536
+ */
+#define GRAYSCALE_WEIGHT_SHIFT 16
+#define GRAYSCALE_WEIGHT_ROUND (1UL << (GRAYSCALE_WEIGHT_SHIFT - 1))
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * Weights of the red, green and blue channels
+ */
+typedef struct
+{
+	uint32_t r;
+	uint32_t g;
+	uint32_t b;
+} grayscale_weights_t;
+
+/* Global --------------------------------------------------------------------*/
+
+// weights of the red, green and blue channels of each algorithm
+static const grayscale_weights_t weights[3] =
+{
+	{ 21845, 21845, 21845 },	// GRAYSCALE_ALGO_1
+	{ 19595, 38470, 7471 },		// GRAYSCALE_ALGO_2
+	{ 13933, 46871, 4732 },		// GRAYSCALE_ALGO_3
+};
+
+// weights of the selected algorithm (the loops copy them in locals: the compiler would
+// read them again after each store in a buffer)
+static grayscale_weights_t current_weights;
+
+// 0 until an algorithm is selected
+static int32_t current_algorithm;
+
+// AL88 chunk of the CPU conversion
+static uint16_t chunk[GRAYSCALE_CHUNK_PIXELS];
+
+#ifdef GRAYSCALE_DMA2D_ENABLED
+// grayscale CLUT: the DMA2D reads the gray level of the AL88 pixels as an index
+static uint32_t clut[256];
+static bool clut_ready;
+
+// AL88 tiles of the DMA2D output pass
+static uint16_t tiles[2][GRAYSCALE_DMA2D_TILE_PIXELS];
 #endif
 
-#define RGB(r,g,b) (GRAYSCALE_ALGO == GRAYSCALE_ALGO_1 ? ((r) + (g) + (b)) / 3 : ((r) * RED_FACTOR + (g) * GREEN_FACTOR + (b) * BLUE_FACTOR) >> SHIFT_FACTOR)
+/* Private API ---------------------------------------------------------------*/
+
+static inline uint32_t load_16(const uint8_t* addr)
+{
+	uint16_t value;
+	(void)memcpy(&value, addr, sizeof(value));
+	return value;
+}
+
+static inline uint32_t load_32(const uint8_t* addr)
+{
+	uint32_t value;
+	(void)memcpy(&value, addr, sizeof(value));
+	return value;
+}
+
+static inline void store_16(uint8_t* addr, uint32_t value)
+{
+	uint16_t v = (uint16_t)value;
+	(void)memcpy(addr, &v, sizeof(v));
+}
+
+static inline void store_32(uint8_t* addr, uint32_t value)
+{
+	(void)memcpy(addr, &value, sizeof(value));
+}
+
+/*
+ * Gray level of 8-bit channels
+ */
+static inline uint32_t gray_rgb(const grayscale_weights_t* w, uint32_t r, uint32_t g, uint32_t b)
+{
+	return ((r * w->r) + (g * w->g) + (b * w->b) + GRAYSCALE_WEIGHT_ROUND) >> GRAYSCALE_WEIGHT_SHIFT;
+}
+
+/*
+ * The small channels are expanded in 8 bits by copying their high bits in their low bits
+ */
+static inline uint32_t expand_5(uint32_t value)
+{
+	return (value << 3) | (value >> 2);
+}
 
-#define ADDR_OFFSET(format) ((format) == ARGB8888_ID ? 4 : (format) == RGB888_ID ? 3 : 2)
+static inline uint32_t expand_6(uint32_t value)
+{
+	return (value << 2) | (value >> 4);
+}
 
-#if defined( __ICCARM__ ) || defined(__GNUC__)
- #define __STATIC_INLINE  static inline
-#endif // __ICCARM__ || __GNUC__
+static inline uint32_t gray_8888(const grayscale_weights_t* w, uint32_t pixel)
+{
+	return gray_rgb(w, (pixel >> 16) & 0xffU, (pixel >> 8) & 0xffU, pixel & 0xffU);
+}
 
-#if defined( __CC_ARM )
-#define __STATIC_INLINE  static __inline
-#endif // __CC_ARM
+static inline uint32_t gray_565(const grayscale_weights_t* w, uint32_t pixel)
+{
+	return gray_rgb(w, expand_5((pixel >> 11) & 0x1fU), expand_6((pixel >> 5) & 0x3fU), expand_5(pixel & 0x1fU));
+}
 
-static uint8_t get_format(MICROUI_Image* gc)
+static inline uint32_t gray_1555(const grayscale_weights_t* w, uint32_t pixel)
 {
-	// get image format, TODO work item 14458
-	uint8_t format = (MICROUI_ImageFormat)gc->format;
+	return gray_rgb(w, expand_5((pixel >> 10) & 0x1fU), expand_5((pixel >> 5) & 0x1fU), expand_5(pixel & 0x1fU));
+}
+
+static inline uint32_t gray_4444(const grayscale_weights_t* w, uint32_t pixel)
+{
+	return gray_rgb(w, ((pixel >> 8) & 0xfU) * 17U, ((pixel >> 4) & 0xfU) * 17U, (pixel & 0xfU) * 17U);
+}
 
-	// grayscale converter does not manage some image formats
-	if (format == RLE1_ID || format > ARGB4444_ID)
+/*
+ * RGB565 pixel of a gray level
+ */
+static inline uint32_t pack_565(uint32_t gray)
+{
+	return ((gray & 0xf8U) << 8) | ((gray & 0xfcU) << 3) | (gray >> 3);
+}
+
+static inline uint32_t div_255(uint32_t value)
+{
+	uint32_t v = value + 128U;
+	return (v + (v >> 8)) >> 8;
+}
+
+static bool is_premultiplied(uint8_t format)
+{
+	return ((uint8_t)MICROUI_IMAGE_FORMAT_ARGB8888_PRE == format) || ((uint8_t)MICROUI_IMAGE_FORMAT_ARGB1555_PRE == format) || ((uint8_t)MICROUI_IMAGE_FORMAT_ARGB4444_PRE == format);
+}
+
+/*
+ * Gets the layout of the formats with levels only
+ *
+ * @param bpp the bits per pixel
+ * @param alpha_bits the bits of alpha (high bits of the pixel), 0 when the level is the gray level
+ *
+ * @return false when the format is not a format with levels only
+ */
+static bool get_levels_layout(uint8_t format, uint32_t* bpp, uint32_t* alpha_bits)
+{
+	bool ret = true;
+	*alpha_bits = 0;
+	switch (format)
 	{
-		// FIXME: return an error code in Java
-		printf("invalid image format: %d\n", format);
-		while(1);
+	case MICROUI_IMAGE_FORMAT_A1:
+	case MICROUI_IMAGE_FORMAT_C1:
+		*bpp = 1;
+		break;
+	case MICROUI_IMAGE_FORMAT_A2:
+	case MICROUI_IMAGE_FORMAT_C2:
+		*bpp = 2;
+		break;
+	case MICROUI_IMAGE_FORMAT_A4:
+	case MICROUI_IMAGE_FORMAT_C4:
+		*bpp = 4;
+		break;
+	case MICROUI_IMAGE_FORMAT_A8:
+		*bpp = 8;
+		break;
+	case MICROUI_IMAGE_FORMAT_AC11:
+		*bpp = 2;
+		*alpha_bits = 1;
+		break;
+	case MICROUI_IMAGE_FORMAT_AC22:
+		*bpp = 4;
+		*alpha_bits = 2;
+		break;
+	case MICROUI_IMAGE_FORMAT_AC44:
+		*bpp = 8;
+		*alpha_bits = 4;
+		break;
+	default:
+		ret = false;
+		break;
 	}
+	return ret;
+}
 
-	// convert the LCD format in standard format
-	if (format == LCD_ID)
+static bool is_readable(uint8_t format)
+{
+	uint32_t bpp;
+	uint32_t alpha_bits;
+	bool ret;
+	switch (format)
 	{
-#if LLDISPLAY_BPP == 16
-		format = RGB565_ID;
-#elif LLDISPLAY_BPP == 24
-		format = RGB888_ID;
-#elif LLDISPLAY_BPP == 32
-		format = ARGB8888_ID;
-#else
-		#error "Define 'LLDISPLAY_BPP' is required (16, 24 or 32)"
-#endif
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+	case MICROUI_IMAGE_FORMAT_ARGB8888_PRE:
+	case MICROUI_IMAGE_FORMAT_RGB888:
+	case MICROUI_IMAGE_FORMAT_RGB565:
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+	case MICROUI_IMAGE_FORMAT_ARGB1555_PRE:
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+	case MICROUI_IMAGE_FORMAT_ARGB4444_PRE:
+	case MICROUI_IMAGE_FORMAT_LARGB8888:
+		ret = true;
+		break;
+	default:
+		// custom and undefined formats excepted
+		ret = get_levels_layout(format, &bpp, &alpha_bits);
+		break;
 	}
+	return ret;
+}
 
-	return format;
+static bool is_writable(uint8_t format)
+{
+	bool ret;
+	switch (format)
+	{
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+	case MICROUI_IMAGE_FORMAT_ARGB8888_PRE:
+	case MICROUI_IMAGE_FORMAT_RGB888:
+	case MICROUI_IMAGE_FORMAT_RGB565:
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+	case MICROUI_IMAGE_FORMAT_ARGB1555_PRE:
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+	case MICROUI_IMAGE_FORMAT_ARGB4444_PRE:
+	case MICROUI_IMAGE_FORMAT_A8:
+		ret = true;
+		break;
+	default:
+		ret = false;
+		break;
+	}
+	return ret;
 }
 
-__STATIC_INLINE void read_8888(uint32_t addr, uint32_t* a, uint32_t* rgb)
+/*
+ * Reads the pixels of a format with levels only (x is a multiple of 8)
+ */
+static void read_levels(uint8_t format, const uint8_t* line, uint32_t x, uint16_t* al, uint32_t count)
 {
-	uint32_t pix = *((uint32_t*)addr);
-	*a = pix & 0xff000000;
-	*rgb = RGB((pix >> 16) & 0xff, (pix >> 8) & 0xff, pix & 0xff);
+	uint32_t bpp;
+	uint32_t alpha_bits;
+	(void)get_levels_layout(format, &bpp, &alpha_bits);
+
+	uint32_t per_byte = 8U / bpp;
+	uint32_t mask = (1UL << bpp) - 1U;
+	uint32_t color_bits = bpp - alpha_bits;
+	uint32_t color_mask = (1UL << color_bits) - 1U;
+	uint32_t alpha_mask = (1UL << alpha_bits) - 1U;
+	const uint8_t* pixels = &line[(x * bpp) / 8U];
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		// the first pixel of a byte is in the low bits
+		uint32_t pixel = ((uint32_t)pixels[i / per_byte] >> ((i % per_byte) * bpp)) & mask;
+		uint32_t gray = ((pixel & color_mask) * 255U) / color_mask;
+		uint32_t alpha = (0U == alpha_bits) ? 0xffU : (((pixel >> color_bits) & alpha_mask) * 255U) / alpha_mask;
+		al[i] = (uint16_t)((alpha << 8) | gray);
+	}
 }
 
-__STATIC_INLINE void read_888(uint32_t addr, uint32_t* a, uint32_t* rgb)
+/*
+ * Reads pixels in AL88 (x is a multiple of 8)
+ */
+static void read_pixels(const grayscale_image_t* src, const uint8_t* line, uint32_t x, uint16_t* al, uint32_t count)
 {
-	*a = 0xff000000;
-	*rgb = RGB(*((uint8_t*)(addr+2)), *((uint8_t*)(addr+1)), *((uint8_t*)(addr)));
+	const grayscale_weights_t w = current_weights;
+	uint32_t i = 0;
+
+	switch (src->format)
+	{
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+	case MICROUI_IMAGE_FORMAT_ARGB8888_PRE:
+		for (; i < count; i++)
+		{
+			uint32_t pixel = load_32(&line[(x + i) * 4U]);
+			al[i] = (uint16_t)(((pixel >> 16) & 0xff00U) | gray_8888(&w, pixel));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		for (; i < count; i++)
+		{
+			// blue, green and red bytes
+			const uint8_t* pixel = &line[(x + i) * 3U];
+			al[i] = (uint16_t)(GRAYSCALE_OPAQUE | gray_rgb(&w, pixel[2], pixel[1], pixel[0]));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		// two pixels per word (little endian: the first pixel in the low half-word)
+		for (; (i + 1U) < count; i += 2U)
+		{
+			uint32_t pixels = load_32(&line[(x + i) * 2U]);
+			uint32_t out = (GRAYSCALE_OPAQUE | gray_565(&w, pixels & 0xffffU)) | ((GRAYSCALE_OPAQUE | gray_565(&w, pixels >> 16)) << 16);
+			store_32((uint8_t*)&al[i], out);
+		}
+		if (i < count)
+		{
+			al[i] = (uint16_t)(GRAYSCALE_OPAQUE | gray_565(&w, load_16(&line[(x + i) * 2U])));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+	case MICROUI_IMAGE_FORMAT_ARGB1555_PRE:
+		for (; i < count; i++)
+		{
+			uint32_t pixel = load_16(&line[(x + i) * 2U]);
+			al[i] = (uint16_t)(((0U != (pixel & 0x8000U)) ? GRAYSCALE_OPAQUE : 0U) | gray_1555(&w, pixel));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+	case MICROUI_IMAGE_FORMAT_ARGB4444_PRE:
+		for (; i < count; i++)
+		{
+			uint32_t pixel = load_16(&line[(x + i) * 2U]);
+			al[i] = (uint16_t)((((pixel >> 12) * 17U) << 8) | gray_4444(&w, pixel));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_LARGB8888:
+		for (; i < count; i++)
+		{
+			uint32_t pixel = src->lut[line[x + i]];
+			al[i] = (uint16_t)(((pixel >> 16) & 0xff00U) | gray_8888(&w, pixel));
+		}
+		break;
+	default:
+		read_levels(src->format, line, x, al, count);
+		break;
+	}
+}
+
+/*
+ * Converts the gray levels between the premultiplied and the straight alpha formats
+ * (the A8 destination holds the gray level over black: premultiplied)
+ */
+static void adjust_alpha(uint8_t src_format, uint8_t dest_format, uint16_t* al, uint32_t count)
+{
+	bool src_pre = is_premultiplied(src_format);
+	bool dest_pre = is_premultiplied(dest_format) || ((uint8_t)MICROUI_IMAGE_FORMAT_A8 == dest_format);
+
+	if (src_pre && !dest_pre)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t alpha = (uint32_t)al[i] >> 8;
+			uint32_t gray = 0;
+			if (0U != alpha)
+			{
+				gray = (((uint32_t)(al[i] & 0xffU) * 255U) + (alpha / 2U)) / alpha;
+				gray = (gray > 0xffU) ? 0xffU : gray;
+			}
+			al[i] = (uint16_t)((alpha << 8) | gray);
+		}
+	}
+	else if (!src_pre && dest_pre)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t alpha = (uint32_t)al[i] >> 8;
+			al[i] = (uint16_t)((alpha << 8) | div_255((al[i] & 0xffU) * alpha));
+		}
+	}
+	else
+	{
+		// same alpha representation
+	}
 }
 
-__STATIC_INLINE void read_4444(uint32_t addr, uint32_t* a, uint32_t* rgb)
+/*
+ * Writes AL88 pixels
+ */
+static void write_pixels(const grayscale_image_t* dest, uint8_t* line, uint32_t x, const uint16_t* al, uint32_t count)
 {
-	uint32_t data = *((uint16_t*)addr);
-	*a = (data & 0xf000) << 16;
-	*rgb = RGB((data & 0x0f00) >> 4, data & 0x00f0, (data & 0x000f) << 4);
+	uint32_t i = 0;
+
+	switch (dest->format)
+	{
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+	case MICROUI_IMAGE_FORMAT_ARGB8888_PRE:
+		for (; i < count; i++)
+		{
+			uint32_t alpha = (uint32_t)al[i] >> 8;
+			store_32(&line[(x + i) * 4U], (alpha << 24) | ((al[i] & 0xffU) * 0x010101U));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		for (; i < count; i++)
+		{
+			uint8_t gray = (uint8_t)al[i];
+			uint8_t* pixel = &line[(x + i) * 3U];
+			pixel[0] = gray;
+			pixel[1] = gray;
+			pixel[2] = gray;
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		for (; (i + 1U) < count; i += 2U)
+		{
+			store_32(&line[(x + i) * 2U], pack_565(al[i] & 0xffU) | (pack_565(al[i + 1U] & 0xffU) << 16));
+		}
+		if (i < count)
+		{
+			store_16(&line[(x + i) * 2U], pack_565(al[i] & 0xffU));
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+	case MICROUI_IMAGE_FORMAT_ARGB1555_PRE:
+		for (; i < count; i++)
+		{
+			uint32_t gray = ((uint32_t)al[i] & 0xffU) >> 3;
+			store_16(&line[(x + i) * 2U], ((uint32_t)al[i] & 0x8000U) | (gray << 10) | (gray << 5) | gray);
+		}
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+	case MICROUI_IMAGE_FORMAT_ARGB4444_PRE:
+		for (; i < count; i++)
+		{
+			store_16(&line[(x + i) * 2U], ((uint32_t)al[i] & 0xf000U) | ((((uint32_t)al[i] & 0xffU) >> 4) * 0x111U));
+		}
+		break;
+	default:
+		// MICROUI_IMAGE_FORMAT_A8
+		for (; i < count; i++)
+		{
+			line[x + i] = (uint8_t)al[i];
+		}
+		break;
+	}
 }
 
-__STATIC_INLINE void read_1555(uint32_t addr, uint32_t* a, uint32_t* rgb)
+/*
+ * Converts a line of RGB565 pixels in RGB565, two pixels per word
+ */
+static void convert_565(const uint8_t* src, uint8_t* dest, uint32_t count)
 {
-	uint16_t data = *((uint16_t*)addr);
-	*a = ((data & 0x8000) == 0 ? 0x00000000 : 0xff000000);
-	*rgb = RGB((data & 0x7c00) >> 7, (data & 0x03e0) >> 2, (data & 0x001f) << 3);
+	const grayscale_weights_t w = current_weights;
+	uint32_t i = 0;
+	for (; (i + 1U) < count; i += 2U)
+	{
+		uint32_t pixels = load_32(&src[i * 2U]);
+		store_32(&dest[i * 2U], pack_565(gray_565(&w, pixels & 0xffffU)) | (pack_565(gray_565(&w, pixels >> 16)) << 16));
+	}
+	if (i < count)
+	{
+		store_16(&dest[i * 2U], pack_565(gray_565(&w, load_16(&src[i * 2U]))));
+	}
 }
 
-__STATIC_INLINE void read_565(uint32_t addr, uint32_t* a, uint32_t* rgb)
+static void convert_cpu(const grayscale_image_t* src, const grayscale_image_t* dest, uint32_t width, uint32_t height)
 {
-	uint16_t data = *((uint16_t*)addr);
-	*a = 0xff000000;
-	*rgb = RGB((data & 0xf800) >> 8, (data & 0x07e0) >> 3, (data & 0x001f) << 3);
+	bool direct = ((uint8_t)MICROUI_IMAGE_FORMAT_RGB565 == src->format) && ((uint8_t)MICROUI_IMAGE_FORMAT_RGB565 == dest->format);
+
+	for (uint32_t y = 0; y < height; y++)
+	{
+		const uint8_t* src_line = &src->buffer[y * src->stride];
+		uint8_t* dest_line = &dest->buffer[y * dest->stride];
+
+		if (direct)
+		{
+			convert_565(src_line, dest_line, width);
+		}
+		else
+		{
+			for (uint32_t x = 0; x < width; x += GRAYSCALE_CHUNK_PIXELS)
+			{
+				uint32_t count = ((width - x) < GRAYSCALE_CHUNK_PIXELS) ? (width - x) : GRAYSCALE_CHUNK_PIXELS;
+				read_pixels(src, src_line, x, chunk, count);
+				adjust_alpha(src->format, dest->format, chunk, count);
+				write_pixels(dest, dest_line, x, chunk, count);
+			}
+		}
+	}
 }
 
-__STATIC_INLINE void draw_8888(uint32_t addr, uint32_t a, uint32_t rgb)
+#ifdef GRAYSCALE_DMA2D_ENABLED
+
+/*
+ * Gets the DMA2D output format of a destination format
+ *
+ * @return false when the DMA2D cannot write the format
+ */
+static bool get_dma2d_format(uint8_t format, uint32_t* dma2d_format, uint32_t* bpp)
 {
-	*((uint32_t*)addr) = (a | (rgb << 16) | (rgb << 8) | rgb);
+	bool ret = true;
+	switch (format)
+	{
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+	case MICROUI_IMAGE_FORMAT_ARGB8888_PRE:
+		*dma2d_format = DMA2D_ARGB8888;
+		*bpp = 32;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		*dma2d_format = DMA2D_RGB888;
+		*bpp = 24;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		*dma2d_format = DMA2D_RGB565;
+		*bpp = 16;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+	case MICROUI_IMAGE_FORMAT_ARGB1555_PRE:
+		*dma2d_format = DMA2D_ARGB1555;
+		*bpp = 16;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+	case MICROUI_IMAGE_FORMAT_ARGB4444_PRE:
+		*dma2d_format = DMA2D_ARGB4444;
+		*bpp = 16;
+		break;
+	default:
+		// A8: written by the CPU
+		ret = false;
+		break;
+	}
+	return ret;
 }
 
-__STATIC_INLINE void draw_888(uint32_t addr, uint32_t a, uint32_t rgb)
+/*
+ * The CPU computes the AL88 tiles and the DMA2D writes them in the destination
+ * (same truncation of the gray level as write_pixels())
+ */
+static void convert_dma2d(const grayscale_image_t* src, const grayscale_image_t* dest, uint32_t width, uint32_t height, uint32_t dma2d_format, uint32_t bpp)
 {
-	*((uint8_t*)(addr+2)) = rgb;
-	*((uint8_t*)(addr+1)) = rgb;
-	*((uint8_t*)(addr)) = rgb;
+	uint32_t tile_lines = GRAYSCALE_DMA2D_TILE_PIXELS / width;
+	uint32_t dest_stride = (dest->stride * 8U) / bpp;
+	uint32_t tile_jobs[2];
+	uint32_t tile_index = 0;
+
+	if (!clut_ready)
+	{
+		for (uint32_t i = 0; i < 256U; i++)
+		{
+			clut[i] = 0xff000000U | (i * 0x010101U);
+		}
+		clut_ready = true;
+	}
+	tile_jobs[0] = UI_DRAWING_DMA2D_load_clut(clut, 256);
+	tile_jobs[1] = tile_jobs[0];
+
+	for (uint32_t y = 0; y < height; y += tile_lines)
+	{
+		uint32_t lines = ((height - y) < tile_lines) ? (height - y) : tile_lines;
+		uint16_t* tile = tiles[tile_index];
+
+		// the DMA2D does not read the tile anymore
+		UI_DRAWING_DMA2D_wait_job(tile_jobs[tile_index]);
+
+		for (uint32_t l = 0; l < lines; l++)
+		{
+			read_pixels(src, &src->buffer[(y + l) * src->stride], 0, &tile[l * width], width);
+			adjust_alpha(src->format, dest->format, &tile[l * width], width);
+		}
+
+		tile_jobs[tile_index] = UI_DRAWING_DMA2D_convert((uint8_t*)tile, CM_AL88, 16, &dest->buffer[y * dest->stride], dest_stride, dma2d_format, bpp, (jint)width, (jint)lines);
+		tile_index ^= 1U;
+	}
+
+	// the last job is the job of the other tile
+	UI_DRAWING_DMA2D_wait_job(tile_jobs[tile_index ^ 1U]);
+
+#if DRAWING_DMA2D_CACHE_MANAGEMENT == DRAWING_DMA2D_CACHE_MANAGEMENT_ENABLED
+	DRAWING_DMA2D_CACHE_area_t area;
+	DRAWING_DMA2D_CACHE_set_area(&area, dest->buffer, 0, 0, width, height, dest_stride, bpp);
+	DRAWING_DMA2D_CACHE_invalidate(&area);
+#endif
 }
 
-__STATIC_INLINE void draw_4444(uint32_t addr, uint32_t a, uint32_t rgb)
+/*
+ * Tells whether the DMA2D writes the destination
+ */
+static bool use_dma2d(const grayscale_image_t* dest, uint32_t width, uint32_t height, uint32_t* dma2d_format, uint32_t* bpp)
 {
-	rgb &= 0xf0;
-	*((uint16_t*)addr) = ((a >> 16) & 0xf000) | (rgb << 4) | rgb | (rgb >> 4);
+	return ((width * height) >= (uint32_t)GRAYSCALE_DMA2D_MIN_PIXELS) && (width <= (uint32_t)GRAYSCALE_DMA2D_TILE_PIXELS)
+			&& get_dma2d_format(dest->format, dma2d_format, bpp) && (0U == ((dest->stride * 8U) % *bpp));
 }
 
-__STATIC_INLINE void draw_1555(uint32_t addr, uint32_t a, uint32_t rgb)
+#endif // GRAYSCALE_DMA2D_ENABLED
+
+/* API -----------------------------------------------------------------------*/
+
+int32_t grayscale_set_algorithm(int32_t algorithm)
 {
-	*((uint16_t*)addr) = (a == 0 ? 0 : 0x8000) | ((rgb & 0xf8) << 7) | ((rgb & 0xf8) << 2) | (rgb >> 3);
+	int32_t ret = GRAYSCALE_ERROR_ALGORITHM;
+
+	if ((algorithm >= GRAYSCALE_ALGO_1) && (algorithm <= GRAYSCALE_ALGO_3))
+	{
+		current_weights = weights[algorithm - GRAYSCALE_ALGO_1];
+		current_algorithm = algorithm;
+		ret = GRAYSCALE_OK;
+	}
+
+	return ret;
 }
 
-__STATIC_INLINE void draw_565(uint32_t addr, uint32_t a, uint32_t rgb)
+int32_t grayscale_convert(const grayscale_image_t* src, const grayscale_image_t* dest, uint32_t width, uint32_t height)
 {
-	*((uint16_t*)addr) = ((rgb & 0xf8) << 8) | ((rgb & 0xfc) << 3) | (rgb >> 3);
+	int32_t ret = GRAYSCALE_OK;
+
+	if (0 == current_algorithm)
+	{
+		(void)grayscale_set_algorithm(GRAYSCALE_ALGO);
+	}
+
+	if (!is_readable(src->format) || !is_writable(dest->format))
+	{
+		ret = GRAYSCALE_ERROR_FORMAT;
+	}
+	else if ((width > src->width) || (width > dest->width) || (height > src->height) || (height > dest->height))
+	{
+		ret = GRAYSCALE_ERROR_SIZE;
+	}
+	else if ((width > 0U) && (height > 0U))
+	{
+#ifdef GRAYSCALE_DMA2D_ENABLED
+		uint32_t dma2d_format;
+		uint32_t bpp;
+		if (use_dma2d(dest, width, height, &dma2d_format, &bpp))
+		{
+			convert_dma2d(src, dest, width, height, dma2d_format, bpp);
+		}
+		else
+#endif
+		{
+			convert_cpu(src, dest, width, height);
+		}
+	}
+	else
+	{
+		// empty region
+	}
+
+	return ret;
 }
 
-void Java_com_is2t_microui_util_Grayscale_convertToGrayScale (MICROUI_Image* src, MICROUI_Image* dest, uint32_t w, uint32_t h)
+int32_t grayscale_get_image(MICROUI_Image* image, grayscale_image_t* desc)
 {
-	uint32_t src_addr = (uint32_t)LLUI_DISPLAY_getBufferAddress(src);
-	uint32_t dest_addr = (uint32_t)LLUI_DISPLAY_getBufferAddress(dest);
+	int32_t ret = GRAYSCALE_OK;
 
-	uint8_t src_format = get_format(src);
-	uint8_t dest_format = get_format(dest);
+	if (LLUI_DISPLAY_isClosed(image))
+	{
+		ret = GRAYSCALE_ERROR_CLOSED;
+	}
+	else
+	{
+		uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(image);
+		uint32_t lut_size = LLUI_DISPLAY_getLUTSize(image);
+
+		// the pixels follow the LUT
+		desc->lut = (0U == lut_size) ? NULL : (const uint32_t*)buffer;
+		desc->buffer = &buffer[lut_size];
+		desc->stride = LLUI_DISPLAY_getStrideInBytes(image);
+		desc->width = image->width;
+		desc->height = image->height;
+		desc->format = (uint8_t)image->format;
+
+		if ((uint8_t)MICROUI_IMAGE_FORMAT_DISPLAY == desc->format)
+		{
+			desc->format = (uint8_t)GRAYSCALE_DISPLAY_FORMAT;
+		}
+	}
 
-	uint8_t src_offset = ADDR_OFFSET(src_format);
-	uint8_t dest_offset = ADDR_OFFSET(dest_format);
+	return ret;
+}
 
-	uint32_t a = 0;
-	uint32_t rgb = 0;
+#ifdef GRAYSCALE_BENCHMARK
+void grayscale_benchmark(const grayscale_image_t* src, const grayscale_image_t* dest)
+{
+	int32_t algorithm = (0 == current_algorithm) ? GRAYSCALE_ALGO : current_algorithm;
+	uint32_t width = (src->width < dest->width) ? src->width : dest->width;
+	uint32_t height = (src->height < dest->height) ? src->height : dest->height;
 
-	for(int32_t i = w*h; --i>=0;)
+	printf("Grayscale benchmark: %ux%u, format %u to format %u (us per conversion, %u conversions)\n", (unsigned int)width, (unsigned int)height, (unsigned int)src->format, (unsigned int)dest->format, (unsigned int)GRAYSCALE_BENCHMARK_LOOPS);
+
+	for (int32_t a = GRAYSCALE_ALGO_1; a <= GRAYSCALE_ALGO_3; a++)
 	{
-		switch(src_format)
+		(void)grayscale_set_algorithm(a);
+		uint32_t t1 = framerate_impl_get_cycles();
+		for (uint32_t i = 0; i < (uint32_t)GRAYSCALE_BENCHMARK_LOOPS; i++)
 		{
-			case ARGB8888_ID:	read_8888(src_addr, &a, &rgb);	break;
-			case RGB888_ID:		read_888(src_addr, &a, &rgb);	break;
-			case RGB565_ID:		read_565(src_addr, &a, &rgb);	break;
-			case ARGB1555_ID:	read_1555(src_addr, &a, &rgb);	break;
-			case ARGB4444_ID:	read_4444(src_addr, &a, &rgb);	break;
+			(void)grayscale_convert(src, dest, width, height);
 		}
+		uint32_t t2 = framerate_impl_get_cycles();
+		printf("algorithm %d: %u us\n", (int)a, (unsigned int)(framerate_impl_cycles_to_us(t2 - t1) / (uint32_t)GRAYSCALE_BENCHMARK_LOOPS));
+	}
+
+	(void)grayscale_set_algorithm(algorithm);
+}
+#endif // GRAYSCALE_BENCHMARK
+
+/* Natives -------------------------------------------------------------------*/
+
+void Java_com_is2t_microui_util_Grayscale_convertToGrayScale(MICROUI_Image* src, MICROUI_Image* dest, jint w, jint h)
+{
+	grayscale_image_t src_desc;
+	grayscale_image_t dest_desc;
+	int32_t ret = ((w < 0) || (h < 0)) ? GRAYSCALE_ERROR_SIZE : GRAYSCALE_OK;
 
-		switch(dest_format)
+	if (GRAYSCALE_OK == ret)
+	{
+		ret = grayscale_get_image(src, &src_desc);
+	}
+	if (GRAYSCALE_OK == ret)
+	{
+		ret = grayscale_get_image(dest, &dest_desc);
+	}
+	if (GRAYSCALE_OK == ret)
+	{
+		ret = grayscale_convert(&src_desc, &dest_desc, (uint32_t)w, (uint32_t)h);
+	}
+	if ((GRAYSCALE_OK == ret) && (w > 0) && (h > 0))
+	{
+		// a decoded image converted in place is not given back by the images cache
+		MICROUI_HEAP_cache_modified(dest);
+		if (LLUI_DISPLAY_isLCD(dest))
 		{
-			case ARGB8888_ID:	draw_8888(dest_addr, a, rgb);	break;
-			case RGB888_ID:		draw_888(dest_addr, a, rgb);	break;
-			case RGB565_ID:		draw_565(dest_addr, a, rgb);	break;
-			case ARGB1555_ID:	draw_1555(dest_addr, a, rgb);	break;
-			case ARGB4444_ID:	draw_4444(dest_addr, a, rgb);	break;
+			// the conversion does not go through the painters
+			DISPLAY_DIRTY_REGIONS_add(0, 0, (uint32_t)w - 1U, (uint32_t)h - 1U);
 		}
+		UI_DISPLAY_LIST_notify_drawing(dest, 0, 0, w - 1, h - 1);
+	}
 
-		src_addr += src_offset;
-		dest_addr += dest_offset;
+	if (GRAYSCALE_OK != ret)
+	{
+		// the natives return nothing to the application
+		printf("grayscale: conversion error %d\n", (int)ret);
+	}
+}
+
+void Java_com_is2t_microui_util_Grayscale_setAlgorithm(jint algorithm)
+{
+	int32_t ret = grayscale_set_algorithm(algorithm);
+	if (GRAYSCALE_OK != ret)
+	{
+		// the natives return nothing to the application: the previous algorithm is kept
+		printf("grayscale: invalid algorithm %d\n", (int)algorithm);
 	}
 }
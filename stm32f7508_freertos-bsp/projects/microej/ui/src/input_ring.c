@@ -0,0 +1,112 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * The producer writes the event before publishing the new head, and the consumer reads
+ * the event before publishing the new tail. The data memory barriers keep these orders
+ * (they are also compiler barriers): the event is never read while being written.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include "stm32f7xx_hal.h"
+#include "microej_time.h"
+#include "input_ring.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#if (INPUT_RING_SIZE & (INPUT_RING_SIZE - 1)) != 0
+#error "INPUT_RING_SIZE must be a power of two"
+#endif
+
+#define INDEX(i)	((i) & (INPUT_RING_SIZE - 1U))
+
+/* API -----------------------------------------------------------------------*/
+
+uint32_t INPUT_RING_get_time(void)
+{
+	return (uint32_t)(microej_time_get_time_nanos() / 1000);
+}
+
+void INPUT_RING_initialize(INPUT_RING_t* ring)
+{
+	ring->head = 0;
+	ring->tail = 0;
+	ring->dropped = 0;
+	ring->dropped_seen = 0;
+}
+
+bool INPUT_RING_push(INPUT_RING_t* ring, const INPUT_RING_event_t* event)
+{
+	uint32_t head = ring->head;
+	bool ret = (head - ring->tail) < INPUT_RING_SIZE;
+
+	if (ret)
+	{
+		// the consumer has released this event (tail read before the event is written)
+		__DMB();
+		ring->events[INDEX(head)] = *event;
+		__DMB();
+		ring->head = head + 1U;
+	}
+	else
+	{
+		ring->dropped++;
+	}
+
+	return ret;
+}
+
+INPUT_RING_event_t* INPUT_RING_peek(INPUT_RING_t* ring)
+{
+	INPUT_RING_event_t* event = NULL;
+	uint32_t tail = ring->tail;
+
+	if (ring->head != tail)
+	{
+		// head read before the event
+		__DMB();
+		event = &ring->events[INDEX(tail)];
+	}
+
+	return event;
+}
+
+void INPUT_RING_pop(INPUT_RING_t* ring)
+{
+	// event read before it is released to the producer
+	__DMB();
+	ring->tail = ring->tail + 1U;
+}
+
+int32_t INPUT_RING_oldest(INPUT_RING_t* const* rings, uint32_t count)
+{
+	int32_t ret = -1;
+	uint32_t oldest = 0;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		INPUT_RING_event_t* event = INPUT_RING_peek(rings[i]);
+		// the times wrap around: compare their difference
+		if ((event != NULL) && ((ret < 0) || ((int32_t)(event->time - oldest) < 0)))
+		{
+			ret = (int32_t)i;
+			oldest = event->time;
+		}
+	}
+
+	return ret;
+}
+
+bool INPUT_RING_overflowed(INPUT_RING_t* ring)
+{
+	uint32_t dropped = ring->dropped;
+	bool ret = dropped != ring->dropped_seen;
+	ring->dropped_seen = dropped;
+	return ret;
+}
@@ -0,0 +1,352 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * The touch events are added to the MicroUI queue by the IO task and read by the MicroUI
+ * pump, both in the input engine critical section (LLUI_INPUT_IMPL_enterCriticalSection()):
+ * the traces are not protected further.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "LLUI_INPUT_impl.h"
+#include "microej.h"
+#include "input_trace.h"
+#include "touch_helper.h"
+#include "microui_event_decoder_conf.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#if defined(INPUT_TRACE_ENABLED) && !defined(MICROUIEVENTDECODER_ENABLED)
+#error "INPUT_TRACE_ENABLED requires MICROUIEVENTDECODER_ENABLED (see microui_event_decoder_conf.h)"
+#endif
+
+#if INPUT_TRACE_HISTOGRAM_BUCKETS > 256
+#error "The histogram samples are stored on 8 bits: INPUT_TRACE_HISTOGRAM_BUCKETS must be at most 256"
+#endif
+
+/* Structs -------------------------------------------------------------------*/
+
+/*
+ * Rolling histogram of a stage: the bucket of each event of the window is kept to
+ * remove the event from the histogram when it leaves the window.
+ */
+typedef struct
+{
+	uint16_t buckets[INPUT_TRACE_HISTOGRAM_BUCKETS];
+	uint8_t samples[INPUT_TRACE_HISTOGRAM_EVENTS];
+	uint32_t next; // index of the next sample in the window
+	uint32_t count; // number of samples in the window
+} input_trace_histogram_t;
+
+/*
+ * Timestamps of a touch event in the MicroUI queue
+ */
+typedef struct
+{
+	bool used;
+	uint32_t index;			// index of the event in the queue
+	uint32_t sample_time;
+	uint32_t read_time;
+	uint32_t queued_time;
+} input_trace_event_t;
+
+/* Globals -------------------------------------------------------------------*/
+
+#ifdef INPUT_TRACE_ENABLED
+static input_trace_histogram_t input_trace_histograms[INPUT_TRACE_STAGES];
+static input_trace_event_t input_trace_events[INPUT_TRACE_EVENTS_IN_FLIGHT];
+static INPUT_TRACE_queue_statistics_t input_trace_queue;
+#endif
+
+/* Private API ---------------------------------------------------------------*/
+
+#ifdef INPUT_TRACE_ENABLED
+
+static void _histogram_add(input_trace_histogram_t* histogram, uint32_t us)
+{
+	uint32_t bucket = us / INPUT_TRACE_HISTOGRAM_BUCKET_US;
+	bucket = bucket < INPUT_TRACE_HISTOGRAM_BUCKETS ? bucket : INPUT_TRACE_HISTOGRAM_BUCKETS - 1;
+
+	if (histogram->count == INPUT_TRACE_HISTOGRAM_EVENTS)
+	{
+		// window is full: remove the oldest event
+		histogram->buckets[histogram->samples[histogram->next]]--;
+	}
+	else
+	{
+		histogram->count++;
+	}
+
+	histogram->samples[histogram->next] = (uint8_t)bucket;
+	histogram->buckets[bucket]++;
+	histogram->next = (histogram->next + 1) % INPUT_TRACE_HISTOGRAM_EVENTS;
+}
+
+static uint32_t _histogram_percentile(input_trace_histogram_t* histogram, uint32_t percentile)
+{
+	uint32_t ret = 0;
+
+	if (histogram->count > 0)
+	{
+		// rank of the sample in the sorted window (nearest-rank method)
+		uint32_t rank = ((histogram->count * percentile) + 99) / 100;
+		rank = rank > 0 ? rank : 1;
+
+		uint32_t cumulated = 0;
+		uint32_t bucket = 0;
+		while ((cumulated + histogram->buckets[bucket]) < rank)
+		{
+			cumulated += histogram->buckets[bucket];
+			bucket++;
+		}
+		ret = (bucket + 1) * INPUT_TRACE_HISTOGRAM_BUCKET_US;
+	}
+
+	return ret;
+}
+
+static void _histogram_clear(input_trace_histogram_t* histogram)
+{
+	for (uint32_t i = 0; i < INPUT_TRACE_HISTOGRAM_BUCKETS; i++)
+	{
+		histogram->buckets[i] = 0;
+	}
+	histogram->next = 0;
+	histogram->count = 0;
+}
+
+#endif // INPUT_TRACE_ENABLED
+
+/* API -----------------------------------------------------------------------*/
+
+void INPUT_TRACE_queue_init(uint32_t size)
+{
+#ifdef INPUT_TRACE_ENABLED
+	input_trace_queue.size = size;
+	input_trace_queue.high_water_mark = 0;
+	for (uint32_t i = 0; i < INPUT_TRACE_EVENTS_IN_FLIGHT; i++)
+	{
+		input_trace_events[i].used = false;
+	}
+#else
+	(void)size;
+#endif
+}
+
+void INPUT_TRACE_queue_add(uint32_t length)
+{
+#ifdef INPUT_TRACE_ENABLED
+	if (length > input_trace_queue.high_water_mark)
+	{
+		input_trace_queue.high_water_mark = length;
+	}
+#else
+	(void)length;
+#endif
+}
+
+void INPUT_TRACE_queue_full(void)
+{
+#ifdef INPUT_TRACE_ENABLED
+	input_trace_queue.full++;
+#endif
+}
+
+void INPUT_TRACE_event_added(uint32_t index, uint32_t sample_time, uint32_t read_time)
+{
+#ifdef INPUT_TRACE_ENABLED
+	input_trace_event_t* free_event = NULL;
+
+	for (uint32_t i = 0; i < INPUT_TRACE_EVENTS_IN_FLIGHT; i++)
+	{
+		input_trace_event_t* event = &input_trace_events[i];
+		if (event->used && (event->index == index))
+		{
+			// the queue index has been reused: the trace is obsolete
+			event->used = false;
+		}
+		if (!event->used && (free_event == NULL))
+		{
+			free_event = event;
+		}
+	}
+
+	if (free_event != NULL)
+	{
+		free_event->used = true;
+		free_event->index = index;
+		free_event->sample_time = sample_time;
+		free_event->read_time = read_time;
+		free_event->queued_time = TOUCH_HELPER_get_time();
+	}
+	else
+	{
+		input_trace_queue.untraced++;
+	}
+#else
+	(void)index;
+	(void)sample_time;
+	(void)read_time;
+#endif
+}
+
+void INPUT_TRACE_event_read(uint32_t index)
+{
+#ifdef INPUT_TRACE_ENABLED
+	for (uint32_t i = 0; i < INPUT_TRACE_EVENTS_IN_FLIGHT; i++)
+	{
+		input_trace_event_t* event = &input_trace_events[i];
+		if (event->used && (event->index == index))
+		{
+			uint32_t now = TOUCH_HELPER_get_time();
+			event->used = false;
+
+			_histogram_add(&input_trace_histograms[INPUT_TRACE_STAGE_READ], event->read_time - event->sample_time);
+			_histogram_add(&input_trace_histograms[INPUT_TRACE_STAGE_HELPER], event->queued_time - event->read_time);
+			_histogram_add(&input_trace_histograms[INPUT_TRACE_STAGE_QUEUE], now - event->queued_time);
+			_histogram_add(&input_trace_histograms[INPUT_TRACE_STAGE_TOTAL], now - event->sample_time);
+			break;
+		}
+	}
+#else
+	(void)index;
+#endif
+}
+
+uint32_t INPUT_TRACE_get_percentile(int32_t stage, int32_t percentile)
+{
+#ifdef INPUT_TRACE_ENABLED
+	uint32_t ret = 0;
+	if ((stage >= 0) && (stage < INPUT_TRACE_STAGES) && (percentile > 0) && (percentile <= 100))
+	{
+		LLUI_INPUT_IMPL_enterCriticalSection();
+		ret = _histogram_percentile(&input_trace_histograms[stage], (uint32_t)percentile);
+		LLUI_INPUT_IMPL_leaveCriticalSection();
+	}
+	return ret;
+#else
+	(void)stage;
+	(void)percentile;
+	return 0;
+#endif
+}
+
+uint32_t INPUT_TRACE_get_histogram(int32_t stage, uint16_t* buckets, uint32_t length)
+{
+#ifdef INPUT_TRACE_ENABLED
+	uint32_t ret = 0;
+	if ((stage >= 0) && (stage < INPUT_TRACE_STAGES))
+	{
+		input_trace_histogram_t* histogram = &input_trace_histograms[stage];
+		length = length < INPUT_TRACE_HISTOGRAM_BUCKETS ? length : INPUT_TRACE_HISTOGRAM_BUCKETS;
+
+		LLUI_INPUT_IMPL_enterCriticalSection();
+		for (uint32_t i = 0; i < length; i++)
+		{
+			buckets[i] = histogram->buckets[i];
+		}
+		ret = histogram->count;
+		LLUI_INPUT_IMPL_leaveCriticalSection();
+	}
+	return ret;
+#else
+	(void)stage;
+	(void)buckets;
+	(void)length;
+	return 0;
+#endif
+}
+
+void INPUT_TRACE_get_queue_statistics(INPUT_TRACE_queue_statistics_t* stats, uint8_t reset)
+{
+#ifdef INPUT_TRACE_ENABLED
+	LLUI_INPUT_IMPL_enterCriticalSection();
+	*stats = input_trace_queue;
+	if (reset == MICROEJ_TRUE)
+	{
+		input_trace_queue.high_water_mark = 0;
+		input_trace_queue.full = 0;
+		input_trace_queue.untraced = 0;
+	}
+	LLUI_INPUT_IMPL_leaveCriticalSection();
+#else
+	(void)reset;
+	stats->size = 0;
+	stats->high_water_mark = 0;
+	stats->full = 0;
+	stats->untraced = 0;
+#endif
+}
+
+void INPUT_TRACE_reset(void)
+{
+#ifdef INPUT_TRACE_ENABLED
+	LLUI_INPUT_IMPL_enterCriticalSection();
+	for (uint32_t i = 0; i < INPUT_TRACE_STAGES; i++)
+	{
+		_histogram_clear(&input_trace_histograms[i]);
+	}
+	LLUI_INPUT_IMPL_leaveCriticalSection();
+#endif
+}
+
+void INPUT_TRACE_dump(void)
+{
+#ifdef INPUT_TRACE_ENABLED
+	static const char* const names[INPUT_TRACE_STAGES] = { "read", "helper", "queue", "total" };
+	static uint16_t buckets[INPUT_TRACE_HISTOGRAM_BUCKETS];
+	INPUT_TRACE_queue_statistics_t queue;
+
+	for (int32_t stage = 0; stage < INPUT_TRACE_STAGES; stage++)
+	{
+		uint32_t count = INPUT_TRACE_get_histogram(stage, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS);
+		LLUI_DEBUG_TRACE("input %-6s: %u events, p50 %u us, p95 %u us, p99 %u us\n", names[stage], (unsigned int)count,
+				(unsigned int)INPUT_TRACE_get_percentile(stage, 50), (unsigned int)INPUT_TRACE_get_percentile(stage, 95),
+				(unsigned int)INPUT_TRACE_get_percentile(stage, 99));
+		for (uint32_t i = 0; i < INPUT_TRACE_HISTOGRAM_BUCKETS; i++)
+		{
+			if (buckets[i] != 0U)
+			{
+				LLUI_DEBUG_TRACE("  %6u us: %u\n", (unsigned int)(i * INPUT_TRACE_HISTOGRAM_BUCKET_US), (unsigned int)buckets[i]);
+			}
+		}
+	}
+
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_FALSE);
+	LLUI_DEBUG_TRACE("MicroUI queue: high-water mark %u/%u, %u full, %u untraced\n", (unsigned int)queue.high_water_mark,
+			(unsigned int)queue.size, (unsigned int)queue.full, (unsigned int)queue.untraced);
+#endif
+}
+
+/* Java API ------------------------------------------------------------------*/
+
+uint32_t javaInputTraceGetPercentile(int32_t stage, int32_t percentile)
+{
+	return INPUT_TRACE_get_percentile(stage, percentile);
+}
+
+uint32_t javaInputTraceGetQueueHighWaterMark(void)
+{
+	INPUT_TRACE_queue_statistics_t queue;
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_FALSE);
+	return queue.high_water_mark;
+}
+
+void javaInputTraceReset(void)
+{
+	INPUT_TRACE_queue_statistics_t queue;
+	INPUT_TRACE_reset();
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_TRUE);
+}
+
+void javaInputTraceDump(void)
+{
+	INPUT_TRACE_dump();
+}
@@ -8,7 +8,10 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "io_task.h"
+#include "LLUI_INPUT_impl.h"
+#include "input_ring.h"
 #include "touch_manager.h"
+#include "touch_ft5336.h"
 #include "buttons_manager.h"
 #include "stm32f7508_discovery.h"
 #include "microej.h"
@@ -23,6 +26,9 @@
 
 #define IO_TASK_PRIORITY ( 12 )
 
+// rings merged by the IO task: buttons and touch
+#define IO_TASK_RINGS ( 2 )
+
 #if (defined(ENABLE_SYSTEM_VIEW)) && (1 == SEGGER_SYSVIEW_POST_MORTEM_MODE)
 #define IO_TASK_STACK_SIZE (512) // IO_TASK_STACK_SIZE increased: cause stack overflow with SystemView post mortem analysis
 #else
@@ -35,35 +41,65 @@ static xSemaphoreHandle io_task_sem = NULL;
 
 /* Private API ---------------------------------------------------------------*/
 
-static void IO_work(void)
+/*
+ * Converts a delay in microseconds in ticks (rounded up)
+ */
+static TickType_t IO_delay_to_ticks(uint32_t delay)
 {
-	uint8_t poll = MICROEJ_FALSE;
+	TickType_t ticks = portMAX_DELAY;
 
-	do
+	if (delay != TOUCH_FT5336_NO_DELAY)
 	{
-		// manages touch before
-		poll = TOUCH_MANAGER_work();
+		uint32_t tick_us = (uint32_t)portTICK_PERIOD_MS * 1000U;
+		ticks = (TickType_t)((delay + tick_us - 1U) / tick_us);
+	}
 
-		if (poll)
+	return ticks;
+}
+
+/*
+ * Sends the events of the input rings to MicroUI in time order
+ */
+static void IO_TASK_dispatch(void)
+{
+	INPUT_RING_t* const rings[IO_TASK_RINGS] = { BUTTONS_MANAGER_get_ring(), TOUCH_MANAGER_get_ring() };
+	int32_t ring;
+
+	// one critical section for the burst (the MicroUI send functions enter it again)
+	LLUI_INPUT_IMPL_enterCriticalSection();
+
+	while ((ring = INPUT_RING_oldest(rings, IO_TASK_RINGS)) >= 0)
+	{
+		INPUT_RING_event_t* event = INPUT_RING_peek(rings[ring]);
+		if (event->type == INPUT_RING_TOUCH)
 		{
-			vTaskDelay(20);
+			TOUCH_MANAGER_dispatch(event);
 		}
+		else
+		{
+			BUTTONS_MANAGER_dispatch(event);
+		}
+		INPUT_RING_pop(rings[ring]);
+	}
 
-	} while (poll == MICROEJ_TRUE);
+	// the lost touch samples are read again by TOUCH_MANAGER_work()
+	BUTTONS_MANAGER_resync();
+
+	LLUI_INPUT_IMPL_leaveCriticalSection();
 }
 
 static void vIoeExpanderTaskFunction(void *p_arg)
 {
+	TickType_t timeout = portMAX_DELAY;
+
 	while(1)
 	{
-		// Suspend ourselves
-		xSemaphoreTake(io_task_sem, portMAX_DELAY);
+		// Suspend ourselves until an input notification or the next deferred touch read
+		xSemaphoreTake(io_task_sem, timeout);
 
 		// We have been woken up, lets work !
-		IO_work();
-
-		// touch release performed: re-enable the EXTI interrupt
-		HAL_NVIC_EnableIRQ(TS_INT_EXTI_IRQn);
+		IO_TASK_dispatch();
+		timeout = IO_delay_to_ticks(TOUCH_MANAGER_work());
 	}
 }
 
@@ -71,21 +107,16 @@ static void vIoeExpanderTaskFunction(void *p_arg)
 
 void EXTI15_10_IRQHandler(void)
 {
-	BUTTONS_MANAGER_interrupt(BUTTON_WAKEUP);
+	uint8_t wake_up = BUTTONS_MANAGER_interrupt(BUTTON_WAKEUP);
 
 	if (TOUCH_MANAGER_interrupt() == MICROEJ_TRUE)
 	{
-		// send an event to wake up the IOE interrupt management task
-		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-
-		/* Give the semaphore to wakeup LwIP task */
-		xSemaphoreGiveFromISR( io_task_sem, &xHigherPriorityTaskWoken );
+		wake_up = MICROEJ_TRUE;
+	}
 
-		/* Switch tasks if necessary. */
-		if( xHigherPriorityTaskWoken != pdFALSE )
-		{
-			portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
-		}
+	if (wake_up == MICROEJ_TRUE)
+	{
+		IO_TASK_wake_up_from_isr();
 	}
 }
 
@@ -105,3 +136,18 @@ uint8_t IO_TASK_create_task(void)
 
 	return MICROEJ_TRUE;
 }
+
+void IO_TASK_wake_up_from_isr(void)
+{
+	// send an event to wake up the IOE interrupt management task
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	/* Give the semaphore to wakeup the IO task */
+	xSemaphoreGiveFromISR( io_task_sem, &xHigherPriorityTaskWoken );
+
+	/* Switch tasks if necessary. */
+	if( xHigherPriorityTaskWoken != pdFALSE )
+	{
+		portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+	}
+}
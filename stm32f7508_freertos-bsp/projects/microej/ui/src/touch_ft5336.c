@@ -0,0 +1,231 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "touch_ft5336.h"
+#include "touch_helper_configuration.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#ifndef TOUCH_SAMPLING_RATE_HZ
+#error "Please set the define TOUCH_SAMPLING_RATE_HZ in touch_helper_configuration.h"
+#endif
+
+#ifndef TOUCH_RELEASE_TIMEOUT_MS
+#error "Please set the define TOUCH_RELEASE_TIMEOUT_MS in touch_helper_configuration.h"
+#endif
+
+// minimum delay between two reads while the touch is pressed (us)
+#define SAMPLING_PERIOD		(1000000U / (uint32_t)TOUCH_SAMPLING_RATE_HZ)
+
+// delay without sample after which the pressed touch is read again (us)
+#define RELEASE_TIMEOUT		((uint32_t)TOUCH_RELEASE_TIMEOUT_MS * 1000U)
+
+// TD_STATUS: number of touch points (more than 5 is an invalid sample)
+#define TD_STATUS_POINTS(r)	((r) & 0x0fU)
+#define MAX_POINTS			5U
+
+// registers of a touch point: Pn_XH, Pn_XL, Pn_YH, Pn_YL, Pn_WEIGHT and Pn_MISC
+#define POINT_REGS			6U
+
+// Pn_XH: event flag of the touch point
+#define EVENT_FLAG(r)		(((r) >> 6) & 0x03U)
+#define EVENT_PUT_UP		1U
+
+#define POSITION(h,l)		((uint16_t)((((uint32_t)(h) & 0x0fU) << 8) | (uint32_t)(l)))
+
+/* Global --------------------------------------------------------------------*/
+
+static bool reading;			// a read of the sample registers is in progress
+static bool pending;			// a sample has not been read yet
+static bool pressed;			// state of the last read sample
+static uint32_t pending_time;	// time of the oldest sample not read yet
+static uint32_t read_time;		// start of the last read
+static uint32_t read_sample;	// time of the sample of the last read
+static uint32_t pressed_time;	// end of the last read of a pressed touch
+
+/* Private API ---------------------------------------------------------------*/
+
+static TOUCH_FT5336_action_t TOUCH_FT5336_start(uint32_t now, uint32_t sample)
+{
+	reading = true;
+	pending = false;
+	read_time = now;
+	read_sample = sample;
+	return TOUCH_FT5336_READ;
+}
+
+static void TOUCH_FT5336_defer(uint32_t now)
+{
+	if (!pending)
+	{
+		pending = true;
+		pending_time = now;
+	}
+}
+
+/*
+ * The touch is read at TOUCH_SAMPLING_RATE_HZ at most while it is pressed; the press
+ * is read immediately.
+ */
+static bool TOUCH_FT5336_can_read(uint32_t now)
+{
+	return !pressed || ((now - read_time) >= SAMPLING_PERIOD);
+}
+
+/* API -----------------------------------------------------------------------*/
+
+void TOUCH_FT5336_initialize(void)
+{
+	reading = false;
+	pending = false;
+	pressed = false;
+}
+
+TOUCH_FT5336_action_t TOUCH_FT5336_data_ready(uint32_t now)
+{
+	TOUCH_FT5336_action_t action = TOUCH_FT5336_NONE;
+
+	if (reading)
+	{
+		// read it at the end of the current read
+		TOUCH_FT5336_defer(now);
+	}
+	else if (TOUCH_FT5336_can_read(now))
+	{
+		action = TOUCH_FT5336_start(now, pending ? pending_time : now);
+	}
+	else
+	{
+		// too early: the task reads it at the end of the sampling period
+		TOUCH_FT5336_defer(now);
+		action = TOUCH_FT5336_WAKE;
+	}
+
+	return action;
+}
+
+TOUCH_FT5336_action_t TOUCH_FT5336_read_done(const uint8_t* regs, uint32_t now, INPUT_RING_event_t* sample)
+{
+	TOUCH_FT5336_action_t action = TOUCH_FT5336_NONE;
+	bool was_pressed = pressed;
+	uint32_t count;
+
+	reading = false;
+
+	count = TOUCH_FT5336_decode(regs, sample->points);
+	sample->type = INPUT_RING_TOUCH;
+	sample->id = (uint8_t)count;
+	sample->time = read_sample;
+	sample->read_time = now;
+
+	if (count > 0U)
+	{
+		pressed = true;
+		pressed_time = now;
+	}
+	else
+	{
+		pressed = false;
+	}
+
+	if (pending)
+	{
+		action = TOUCH_FT5336_can_read(now) ? TOUCH_FT5336_start(now, pending_time) : TOUCH_FT5336_WAKE;
+	}
+	else if (pressed && !was_pressed)
+	{
+		// the task checks the pressed touch is still pressed (see TOUCH_RELEASE_TIMEOUT_MS)
+		action = TOUCH_FT5336_WAKE;
+	}
+	else
+	{
+		// wait for the next sample
+	}
+
+	return action;
+}
+
+TOUCH_FT5336_action_t TOUCH_FT5336_read_error(void)
+{
+	reading = false;
+
+	// retry at the end of the sampling period
+	TOUCH_FT5336_defer(read_sample);
+	return TOUCH_FT5336_WAKE;
+}
+
+void TOUCH_FT5336_resync(uint32_t now)
+{
+	// read the current sample at the end of the sampling period
+	TOUCH_FT5336_defer(now);
+}
+
+TOUCH_FT5336_action_t TOUCH_FT5336_work(uint32_t now, uint32_t* delay)
+{
+	TOUCH_FT5336_action_t action = TOUCH_FT5336_NONE;
+	*delay = TOUCH_FT5336_NO_DELAY;
+
+	if (reading)
+	{
+		// the end of the read gives the next action
+	}
+	else if (pending)
+	{
+		if ((now - read_time) >= SAMPLING_PERIOD)
+		{
+			action = TOUCH_FT5336_start(now, pending_time);
+		}
+		else
+		{
+			*delay = SAMPLING_PERIOD - (now - read_time);
+		}
+	}
+	else if (pressed)
+	{
+		if ((now - pressed_time) >= RELEASE_TIMEOUT)
+		{
+			// no sample for a while: the "put up" sample may have been lost
+			action = TOUCH_FT5336_start(now, now);
+		}
+		else
+		{
+			*delay = RELEASE_TIMEOUT - (now - pressed_time);
+		}
+	}
+	else
+	{
+		// released: wait for the next press
+	}
+
+	return action;
+}
+
+uint32_t TOUCH_FT5336_decode(const uint8_t* regs, TOUCH_GESTURE_point_t* points)
+{
+	uint32_t td_points = TD_STATUS_POINTS(regs[0]);
+	uint32_t count = 0;
+
+	if (td_points <= MAX_POINTS)
+	{
+		// the registers of the points above TD_STATUS are not up to date
+		for (uint32_t i = 0; (i < td_points) && (i < (uint32_t)TOUCH_GESTURE_MAX_POINTS); i++)
+		{
+			const uint8_t* point = &regs[1U + (i * POINT_REGS)];
+			if (EVENT_FLAG(point[0]) != EVENT_PUT_UP)
+			{
+				// the FT5336 X axis is the display Y axis
+				points[count].x = POSITION(point[2], point[3]);
+				points[count].y = POSITION(point[0], point[1]);
+				count++;
+			}
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,248 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include "touch_gesture.h"
+#include "event_generator.h"
+
+// this h file is created by buildSystemMicroUI step
+#include "microui_constants.h"
+
+#ifdef TOUCH_GESTURE_ENABLED
+
+/* Defines -------------------------------------------------------------------*/
+
+#ifndef MICROUI_EVENTGEN_GESTURES
+#error "TOUCH_GESTURE_ENABLED requires the generic event generator GESTURES (see touch_helper_configuration.h)"
+#endif
+
+// samples of the finger kept to compute the velocity of a fling
+#define HISTORY_SIZE		8
+
+#define LONG_PRESS_DELAY	((uint32_t)TOUCH_GESTURE_LONG_PRESS_MS * 1000U)
+#define FLING_WINDOW		((uint32_t)TOUCH_GESTURE_FLING_WINDOW_MS * 1000U)
+
+// scale of the start of a pinch
+#define SCALE_ONE			256
+
+#define DIFF(a,b)			((a) < (b) ? ((b) - (a)) : ((a) - (b)))
+#define CLAMP_16(v)			((v) > INT16_MAX ? INT16_MAX : ((v) < INT16_MIN ? INT16_MIN : (v)))
+
+/* Structs -------------------------------------------------------------------*/
+
+typedef struct
+{
+	TOUCH_GESTURE_point_t point;
+	uint32_t time;
+} TOUCH_GESTURE_sample_t;
+
+/* Global --------------------------------------------------------------------*/
+
+static uint32_t fingers;					// fingers of the previous sample
+static bool multi_touch;					// two fingers have been seen since the press
+
+static TOUCH_GESTURE_point_t down_point;	// first finger at the press
+static uint32_t down_time;
+static bool still;							// the finger has not left the slop since the press
+static bool long_pressed;					// a long press has been sent since the press
+
+static TOUCH_GESTURE_sample_t history[HISTORY_SIZE];
+static uint32_t history_count;
+static uint32_t history_last;
+
+static bool pinching;
+static uint32_t pinch_distance;				// distance between the fingers at the start of the pinch
+static uint32_t pinch_scale;				// scale of the last pinch event
+static TOUCH_GESTURE_point_t pinch_center;
+
+/* Private API ---------------------------------------------------------------*/
+
+static uint32_t TOUCH_GESTURE_sqrt(uint32_t value)
+{
+	uint32_t root = 0;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > value)
+	{
+		bit >>= 2;
+	}
+
+	while (bit != 0U)
+	{
+		if (value >= (root + bit))
+		{
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+static uint32_t TOUCH_GESTURE_distance(const TOUCH_GESTURE_point_t* p1, const TOUCH_GESTURE_point_t* p2)
+{
+	uint32_t dx = DIFF(p1->x, p2->x);
+	uint32_t dy = DIFF(p1->y, p2->y);
+	return TOUCH_GESTURE_sqrt((dx * dx) + (dy * dy));
+}
+
+static void TOUCH_GESTURE_send(uint32_t type, uint32_t flags, const TOUCH_GESTURE_point_t* point, uint32_t value)
+{
+	int32_t event[TOUCH_GESTURE_EVENT_SIZE];
+	event[0] = (int32_t)((type << 24) | flags);
+	event[1] = (int32_t)(((uint32_t)point->x << 16) | point->y);
+	event[2] = (int32_t)value;
+
+	// send a MicroUI gesture event (don't care if event is lost)
+	(void)EVENT_GENERATOR_gesture(event, TOUCH_GESTURE_EVENT_SIZE);
+}
+
+static void TOUCH_GESTURE_add_history(const TOUCH_GESTURE_point_t* point, uint32_t time)
+{
+	history_last = (history_last + 1U) % HISTORY_SIZE;
+	history[history_last].point = *point;
+	history[history_last].time = time;
+	if (history_count < HISTORY_SIZE)
+	{
+		history_count++;
+	}
+}
+
+/*
+ * Sends a fling when the finger was moving fast enough before its release
+ */
+static void TOUCH_GESTURE_check_fling(void)
+{
+	const TOUCH_GESTURE_sample_t* last = &history[history_last];
+	const TOUCH_GESTURE_sample_t* first = last;
+
+	// oldest sample of the window
+	for (uint32_t i = 1; i < history_count; i++)
+	{
+		const TOUCH_GESTURE_sample_t* sample = &history[(history_last + HISTORY_SIZE - i) % HISTORY_SIZE];
+		if ((last->time - sample->time) > FLING_WINDOW)
+		{
+			break;
+		}
+		first = sample;
+	}
+
+	uint32_t duration = last->time - first->time;
+	if (duration > 0U)
+	{
+		int64_t vx = (((int64_t)last->point.x - (int64_t)first->point.x) * 1000000) / duration;
+		int64_t vy = (((int64_t)last->point.y - (int64_t)first->point.y) * 1000000) / duration;
+		vx = CLAMP_16(vx);
+		vy = CLAMP_16(vy);
+
+		if (((vx * vx) + (vy * vy)) >= ((int64_t)TOUCH_GESTURE_FLING_VELOCITY * TOUCH_GESTURE_FLING_VELOCITY))
+		{
+			TOUCH_GESTURE_send(TOUCH_GESTURE_FLING, 0, &last->point, ((uint32_t)(int32_t)vx << 16) | ((uint32_t)(int32_t)vy & 0xffffU));
+		}
+	}
+}
+
+static void TOUCH_GESTURE_end_pinch(void)
+{
+	if (pinching)
+	{
+		pinching = false;
+		TOUCH_GESTURE_send(TOUCH_GESTURE_PINCH, TOUCH_GESTURE_FLAG_END, &pinch_center, pinch_scale);
+	}
+}
+
+static void TOUCH_GESTURE_update_pinch(const TOUCH_GESTURE_point_t* points)
+{
+	uint32_t distance = TOUCH_GESTURE_distance(&points[0], &points[1]);
+	pinch_center.x = (uint16_t)(((uint32_t)points[0].x + points[1].x) / 2U);
+	pinch_center.y = (uint16_t)(((uint32_t)points[0].y + points[1].y) / 2U);
+
+	if (!pinching)
+	{
+		pinching = true;
+		pinch_distance = (distance == 0U) ? 1U : distance;
+		pinch_scale = SCALE_ONE;
+	}
+	else
+	{
+		uint32_t scale = (distance * SCALE_ONE) / pinch_distance;
+		if (DIFF(scale, pinch_scale) >= (uint32_t)TOUCH_GESTURE_PINCH_STEP)
+		{
+			pinch_scale = scale;
+			TOUCH_GESTURE_send(TOUCH_GESTURE_PINCH, 0, &pinch_center, scale);
+		}
+	}
+}
+
+/* API -----------------------------------------------------------------------*/
+
+void TOUCH_GESTURE_initialize(void)
+{
+	fingers = 0;
+	multi_touch = false;
+	pinching = false;
+	history_count = 0;
+}
+
+void TOUCH_GESTURE_update(const TOUCH_GESTURE_point_t* points, uint32_t count, uint32_t time)
+{
+	if (count == 0U)
+	{
+		// release
+		if ((fingers == 1U) && !multi_touch && !long_pressed && (history_count > 1U))
+		{
+			TOUCH_GESTURE_check_fling();
+		}
+		TOUCH_GESTURE_end_pinch();
+		multi_touch = false;
+		history_count = 0;
+	}
+	else if (count == 1U)
+	{
+		// a second finger may have been released
+		TOUCH_GESTURE_end_pinch();
+
+		if (fingers == 0U)
+		{
+			// press
+			down_point = points[0];
+			down_time = time;
+			still = true;
+			long_pressed = false;
+		}
+
+		TOUCH_GESTURE_add_history(&points[0], time);
+
+		if (still && (((uint32_t)DIFF(points[0].x, down_point.x) > (uint32_t)TOUCH_GESTURE_SLOP) || ((uint32_t)DIFF(points[0].y, down_point.y) > (uint32_t)TOUCH_GESTURE_SLOP)))
+		{
+			still = false;
+		}
+
+		if (still && !long_pressed && !multi_touch && ((time - down_time) >= LONG_PRESS_DELAY))
+		{
+			long_pressed = true;
+			TOUCH_GESTURE_send(TOUCH_GESTURE_LONG_PRESS, 0, &down_point, 0);
+		}
+	}
+	else
+	{
+		multi_touch = true;
+		still = false;
+		TOUCH_GESTURE_update_pinch(points);
+	}
+
+	fingers = count;
+}
+
+#endif // TOUCH_GESTURE_ENABLED
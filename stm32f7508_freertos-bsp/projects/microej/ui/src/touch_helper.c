@@ -24,8 +24,12 @@
 
 #include "LLUI_INPUT.h"
 #include "microej.h"
+#include "input_ring.h"
+#include "touch_helper.h"
 #include "touch_helper_configuration.h"
 #include "event_generator.h"
+#include "input_trace.h"
+#include "microui_event_decoder_conf.h"
 
 /* Defines -------------------------------------------------------------------*/
 
@@ -39,6 +43,15 @@
 #error "Please set the define MOVE_PIXEL_LIMIT in touch_helper_configuration.h"
 #endif
 
+// The coalescing and the tracing follow the touch events in the MicroUI queue
+#if defined(TOUCH_MOVE_COALESCING_ENABLED) && !defined(MICROUIEVENTDECODER_ENABLED)
+#error "TOUCH_MOVE_COALESCING_ENABLED requires MICROUIEVENTDECODER_ENABLED (see microui_event_decoder_conf.h)"
+#endif
+
+#if defined(TOUCH_MOVE_COALESCING_ENABLED) || defined(INPUT_TRACE_ENABLED)
+#define TOUCH_CAPTURE_ENABLED
+#endif
+
 #define DIFF(a,b)					((a) < (b) ? (b-a) : (a-b))
 #define KEEP_COORD(p,n,limit)		(DIFF(p,n) <= limit ? MICROEJ_FALSE : MICROEJ_TRUE)
 #define KEEP_PIXEL(px,x,py,y,limit)	(KEEP_COORD(px,x,limit) || KEEP_COORD(py,y,limit))
@@ -51,8 +64,109 @@ static uint8_t touch_pressed = MICROEJ_FALSE;
 static uint8_t touch_moved = MICROEJ_FALSE;	// == MICROEJ_TRUE after the first "move" event
 static uint16_t previous_touch_x, previous_touch_y;
 
+static uint8_t move_pending = MICROEJ_FALSE;	// == MICROEJ_TRUE when previous_touch_x/y have not been sent
+static uint32_t sample_time;			// time of the sample being notified
+static uint32_t sample_read_time;		// end of the read of the sample being notified
+static uint32_t move_sample_time;		// times of the sample of the pending move
+static uint32_t move_read_time;
+
+#ifdef TOUCH_CAPTURE_ENABLED
+// queue index of the event being added (captured by TOUCH_HELPER_queue_added())
+static uint8_t capture = MICROEJ_FALSE;
+static uint8_t captured = MICROEJ_FALSE;
+static uint32_t captured_index;
+#endif
+
+#ifdef TOUCH_MOVE_COALESCING_ENABLED
+static uint8_t move_queued = MICROEJ_FALSE;	// == MICROEJ_TRUE while a move has not been read by the pump
+static uint32_t move_index;
+#endif
+
+static TOUCH_HELPER_statistics_t statistics;
+
+/* Private API ---------------------------------------------------------------*/
+
+#ifdef TOUCH_CAPTURE_ENABLED
+static void TOUCH_HELPER_start_capture(void)
+{
+	captured = MICROEJ_FALSE;
+	capture = MICROEJ_TRUE;
+}
+
+/*
+ * Follows the event just added to the queue
+ * @param is_move MICROEJ_TRUE for a move event
+ * @param time the time of the event's sample
+ * @param read_time the end of the read of the event's sample
+ */
+static void TOUCH_HELPER_stop_capture(uint8_t is_move, uint32_t time, uint32_t read_time)
+{
+	capture = MICROEJ_FALSE;
+
+	if (captured == MICROEJ_TRUE)
+	{
+#ifdef TOUCH_MOVE_COALESCING_ENABLED
+		if (is_move == MICROEJ_TRUE)
+		{
+			move_queued = MICROEJ_TRUE;
+			move_index = captured_index;
+		}
+#else
+		(void)is_move;
+#endif
+		INPUT_TRACE_event_added(captured_index, time, read_time);
+	}
+}
+#endif
+
+/*
+ * Sends the pending move, if any. With the coalescing, the move is kept until the
+ * previous move has been read by the MicroUI pump, unless force is MICROEJ_TRUE.
+ */
+static void TOUCH_HELPER_send_move(uint8_t force)
+{
+	uint8_t send = move_pending;
+
+#ifdef TOUCH_MOVE_COALESCING_ENABLED
+	if ((move_queued == MICROEJ_TRUE) && (force == MICROEJ_FALSE))
+	{
+		send = MICROEJ_FALSE;
+	}
+#else
+	(void)force;
+#endif
+
+	if (send == MICROEJ_TRUE)
+	{
+		move_pending = MICROEJ_FALSE;
+
+#ifdef TOUCH_CAPTURE_ENABLED
+		TOUCH_HELPER_start_capture();
+#endif
+		// send a MicroUI touch event (don't care if event is lost)
+		if (EVENT_GENERATOR_touch_moved(previous_touch_x, previous_touch_y) == LLUI_INPUT_OK)
+		{
+			statistics.moves++;
+		}
+#ifdef TOUCH_CAPTURE_ENABLED
+		TOUCH_HELPER_stop_capture(MICROEJ_TRUE, move_sample_time, move_read_time);
+#endif
+	}
+}
+
 /* API -----------------------------------------------------------------------*/
 
+uint32_t TOUCH_HELPER_get_time(void)
+{
+	return INPUT_RING_get_time();
+}
+
+void TOUCH_HELPER_set_sample_time(uint32_t time, uint32_t read_time)
+{
+	sample_time = time;
+	sample_read_time = read_time;
+}
+
 void TOUCH_HELPER_pressed(int32_t x, int32_t y)
 {
 	// here, pen is down for sure
@@ -74,20 +188,36 @@ void TOUCH_HELPER_pressed(int32_t x, int32_t y)
 
 		if (keep_pixel == MICROEJ_TRUE)
 		{
+			if (move_pending == MICROEJ_TRUE)
+			{
+				// the pending move is replaced by this one
+				statistics.coalesced++;
+			}
+
 			// store the new pixel
 			previous_touch_x = x;
 			previous_touch_y = y;
 			touch_moved = MICROEJ_TRUE;
-
-			// send a MicroUI touch event (don't care if event is lost)
-			EVENT_GENERATOR_touch_moved(x, y);
+			move_pending = MICROEJ_TRUE;
+			move_sample_time = sample_time;
+			move_read_time = sample_read_time;
 		}
 		// else: same position; no need to send an event
+
+		// send the new pixel or a pixel kept by the coalescing
+		TOUCH_HELPER_send_move(MICROEJ_FALSE);
 	}
 	else
 	{
 		// pen was up => press event
-		if (EVENT_GENERATOR_touch_pressed(x, y) == LLUI_INPUT_OK)
+#ifdef TOUCH_CAPTURE_ENABLED
+		TOUCH_HELPER_start_capture();
+#endif
+		int32_t status = EVENT_GENERATOR_touch_pressed(x, y);
+#ifdef TOUCH_CAPTURE_ENABLED
+		TOUCH_HELPER_stop_capture(MICROEJ_FALSE, sample_time, sample_read_time);
+#endif
+		if (status == LLUI_INPUT_OK)
 		{
 			// the event has been managed: we can store the new touch state
 			// touch is pressed now
@@ -95,6 +225,7 @@ void TOUCH_HELPER_pressed(int32_t x, int32_t y)
 			previous_touch_y = y;
 			touch_pressed = MICROEJ_TRUE;
 			touch_moved = MICROEJ_FALSE;
+			move_pending = MICROEJ_FALSE;
 		}
 		// else: event has been lost: stay in "release" state
 	}
@@ -112,6 +243,9 @@ void TOUCH_HELPER_released(void)
 
 	if (touch_pressed == MICROEJ_TRUE)
 	{
+		// the last position before the release
+		TOUCH_HELPER_send_move(MICROEJ_TRUE);
+
 		// pen was down => release event
 		if (EVENT_GENERATOR_touch_released() == LLUI_INPUT_OK)
 		{
@@ -123,3 +257,41 @@ void TOUCH_HELPER_released(void)
 	}
 	// else: pen was already up
 }
+
+void TOUCH_HELPER_queue_added(uint32_t index)
+{
+#ifdef TOUCH_CAPTURE_ENABLED
+	if (capture == MICROEJ_TRUE)
+	{
+		capture = MICROEJ_FALSE;
+		captured = MICROEJ_TRUE;
+		captured_index = index;
+	}
+#else
+	(void)index;
+#endif
+}
+
+void TOUCH_HELPER_queue_read(uint32_t index)
+{
+#ifdef TOUCH_MOVE_COALESCING_ENABLED
+	if ((move_queued == MICROEJ_TRUE) && (move_index == index))
+	{
+		// the next move can be sent
+		move_queued = MICROEJ_FALSE;
+	}
+#else
+	(void)index;
+#endif
+}
+
+void TOUCH_HELPER_get_statistics(TOUCH_HELPER_statistics_t* stats, uint8_t reset)
+{
+	*stats = statistics;
+
+	if (reset == MICROEJ_TRUE)
+	{
+		statistics.moves = 0;
+		statistics.coalesced = 0;
+	}
+}
@@ -6,6 +6,14 @@
  * Any modification of the source code will break MicroEJ Corp. warranties on the whole library.
  */
 
+/*
+ * The FT5336 raises its interrupt line for each new touch sample (trigger mode). The
+ * interrupt starts a DMA read of the sample registers; the end of the read pushes the
+ * sample in the touch ring from the I2C interrupt. The IO task sends the samples to the
+ * touch helper (which sends the MicroUI events) and runs the deferred reads (see
+ * touch_ft5336.h): nothing is polled while the touch is released.
+ */
+
 /* Includes ------------------------------------------------------------------*/
 
 #include "stm32f7508_discovery_ts.h"
@@ -13,46 +21,157 @@
 #include "microej.h"
 #include "io_task.h"
 #include "touch_helper.h"
+#include "touch_gesture.h"
+#include "touch_ft5336.h"
+#include "touch_manager.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/*
+ * The FT5336 is connected to I2C3 (also configured by the BSP). The I2C3 RX DMA request
+ * is on the DMA1 stream 2, channel 3.
+ */
+#define TOUCH_I2C					I2C3
+#define TOUCH_I2C_TIMING			((uint32_t)0x40912732)	// same timing as the BSP
+#define TOUCH_I2C_EV_IRQn			I2C3_EV_IRQn
+#define TOUCH_I2C_ER_IRQn			I2C3_ER_IRQn
+#define TOUCH_DMA_STREAM			DMA1_Stream2
+#define TOUCH_DMA_CHANNEL			DMA_CHANNEL_3
+#define TOUCH_DMA_IRQn				DMA1_Stream2_IRQn
+
+/*
+ * Same priority as the touch controller interrupt line (BSP_TS_ITConfig()): the touch
+ * interrupts do not preempt each other
+ */
+#define TOUCH_IRQ_PRIORITY			0x0F
+
+/*
+ * Size of the DMA buffer: a data cache line
+ */
+#define TOUCH_DMA_BUFFER_SIZE		32
 
 /* Global --------------------------------------------------------------------*/
 
 static uint8_t touch_initialized = MICROEJ_FALSE;
 
+static I2C_HandleTypeDef touch_i2c;
+static DMA_HandleTypeDef touch_dma;
+
+// sample registers written by the DMA (a whole cache line: invalidated after each read)
+static uint8_t touch_regs[TOUCH_DMA_BUFFER_SIZE] __ALIGNED(32);
+
+// samples read by the I2C interrupt, sent by the IO task
+static INPUT_RING_t touch_ring;
+
 /* Private API ---------------------------------------------------------------*/
 
-static uint8_t TOUCH_MANAGER_GetState(uint16_t* x, uint16_t* y)
+static void TOUCH_MANAGER_initialize_i2c(void)
 {
-	/* Check and update the number of touches active detected */
-	if(ft5336_ts_drv.DetectTouch(TS_I2C_ADDRESS) == 0)
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	touch_dma.Instance = TOUCH_DMA_STREAM;
+	touch_dma.Init.Channel = TOUCH_DMA_CHANNEL;
+	touch_dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	touch_dma.Init.PeriphInc = DMA_PINC_DISABLE;
+	touch_dma.Init.MemInc = DMA_MINC_ENABLE;
+	touch_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	touch_dma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	touch_dma.Init.Mode = DMA_NORMAL;
+	touch_dma.Init.Priority = DMA_PRIORITY_LOW;
+	touch_dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	HAL_DMA_Init(&touch_dma);
+	__HAL_LINKDMA(&touch_i2c, hdmarx, touch_dma);
+
+	// the BSP has configured the pins and the clock of the I2C
+	touch_i2c.Instance = TOUCH_I2C;
+	touch_i2c.Init.Timing = TOUCH_I2C_TIMING;
+	touch_i2c.Init.OwnAddress1 = 0;
+	touch_i2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	touch_i2c.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	touch_i2c.Init.OwnAddress2 = 0;
+	touch_i2c.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	touch_i2c.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+	HAL_I2C_Init(&touch_i2c);
+
+	HAL_NVIC_SetPriority(TOUCH_DMA_IRQn, TOUCH_IRQ_PRIORITY, 0);
+	HAL_NVIC_SetPriority(TOUCH_I2C_EV_IRQn, TOUCH_IRQ_PRIORITY, 0);
+	HAL_NVIC_SetPriority(TOUCH_I2C_ER_IRQn, TOUCH_IRQ_PRIORITY, 0);
+	TOUCH_MANAGER_enable_interrupts();
+}
+
+/*
+ * Performs an action of the state machine (from the touch interrupts or with the
+ * touch interrupts masked)
+ */
+static uint8_t TOUCH_MANAGER_perform(TOUCH_FT5336_action_t action)
+{
+	uint8_t wake_up = MICROEJ_FALSE;
+
+	while (action == TOUCH_FT5336_READ)
+	{
+		SCB_InvalidateDCache_by_Addr((uint32_t*)touch_regs, TOUCH_DMA_BUFFER_SIZE);
+		if (HAL_I2C_Mem_Read_DMA(&touch_i2c, TS_I2C_ADDRESS, TOUCH_FT5336_REG_FIRST, I2C_MEMADD_SIZE_8BIT, touch_regs, TOUCH_FT5336_REG_COUNT) == HAL_OK)
+		{
+			action = TOUCH_FT5336_NONE;
+		}
+		else
+		{
+			action = TOUCH_FT5336_read_error();
+		}
+	}
+
+	if (action == TOUCH_FT5336_WAKE)
 	{
-		return MICROEJ_FALSE;
+		wake_up = MICROEJ_TRUE;
 	}
 
-	/* Get each touch coordinates */
-	uint16_t tx,ty;
-	ft5336_ts_drv.GetXY(TS_I2C_ADDRESS, &tx, &ty);
+	return wake_up;
+}
 
-	*(x) = ty;
-	*(y) = tx;
+/* Interrupt function --------------------------------------------------------*/
 
-	return MICROEJ_TRUE;
+void I2C3_EV_IRQHandler(void)
+{
+	HAL_I2C_EV_IRQHandler(&touch_i2c);
 }
 
-static uint8_t TOUCH_MANAGER_update(void)
+void I2C3_ER_IRQHandler(void)
 {
-	uint16_t x,y;
+	HAL_I2C_ER_IRQHandler(&touch_i2c);
+}
 
-	if (TOUCH_MANAGER_GetState(&x, &y) == MICROEJ_TRUE)
+void DMA1_Stream2_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(touch_i2c.hdmarx);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == &touch_i2c)
 	{
-		// here, pen is down for sure
-		TOUCH_HELPER_pressed(x, y);
-		return MICROEJ_TRUE;
+		INPUT_RING_event_t sample;
+		TOUCH_FT5336_action_t action;
+
+		SCB_InvalidateDCache_by_Addr((uint32_t*)touch_regs, TOUCH_DMA_BUFFER_SIZE);
+		action = TOUCH_FT5336_read_done(touch_regs, TOUCH_HELPER_get_time(), &sample);
+
+		// a full ring is resynchronized by the IO task (see TOUCH_MANAGER_work())
+		(void)INPUT_RING_push(&touch_ring, &sample);
+		(void)TOUCH_MANAGER_perform(action);
+
+		// the IO task sends the sample and runs the deferred actions
+		IO_TASK_wake_up_from_isr();
 	}
-	else
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == &touch_i2c)
 	{
-		// here, pen is up for sure
-		TOUCH_HELPER_released();
-		return MICROEJ_FALSE;
+		if (TOUCH_MANAGER_perform(TOUCH_FT5336_read_error()) == MICROEJ_TRUE)
+		{
+			IO_TASK_wake_up_from_isr();
+		}
 	}
 }
 
@@ -60,39 +179,95 @@ static uint8_t TOUCH_MANAGER_update(void)
 
 void TOUCH_MANAGER_initialize(void)
 {
+	INPUT_RING_initialize(&touch_ring);
+#ifdef TOUCH_GESTURE_ENABLED
+	TOUCH_GESTURE_initialize();
+#endif
 	BSP_TS_Init(BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
 	BSP_TS_ITConfig();
-	IO_TASK_create_task();
+	TOUCH_MANAGER_initialize_i2c();
+	TOUCH_FT5336_initialize();
 	touch_initialized = MICROEJ_TRUE;
 }
 
 uint8_t TOUCH_MANAGER_interrupt(void)
 {
+	uint8_t wake_up = MICROEJ_FALSE;
+
 	if(__HAL_GPIO_EXTI_GET_IT(TS_INT_PIN) != RESET)
 	{
 		__HAL_GPIO_EXTI_CLEAR_IT(TS_INT_PIN);
 
-		// disable the EXTI interrupt until next touch release
-		HAL_NVIC_DisableIRQ(TS_INT_EXTI_IRQn);
+		if (touch_initialized == MICROEJ_TRUE)
+		{
+			// a new sample is available
+			wake_up = TOUCH_MANAGER_perform(TOUCH_FT5336_data_ready(TOUCH_HELPER_get_time()));
+		}
+	}
+
+	return wake_up;
+}
 
-		return MICROEJ_TRUE;
+uint32_t TOUCH_MANAGER_work(void)
+{
+	uint32_t delay = TOUCH_FT5336_NO_DELAY;
+
+	if (touch_initialized == MICROEJ_TRUE)
+	{
+		uint32_t now = TOUCH_HELPER_get_time();
+
+		TOUCH_MANAGER_disable_interrupts();
+		if (INPUT_RING_overflowed(&touch_ring))
+		{
+			// a sample has been lost: read the touch state again
+			TOUCH_FT5336_resync(now);
+		}
+		if (TOUCH_MANAGER_perform(TOUCH_FT5336_work(now, &delay)) == MICROEJ_TRUE)
+		{
+			// the read has not been started: retry at the end of the sampling period
+			delay = 0;
+		}
+		TOUCH_MANAGER_enable_interrupts();
 	}
 
-	return MICROEJ_FALSE;
+	return delay;
+}
+
+INPUT_RING_t* TOUCH_MANAGER_get_ring(void)
+{
+	return &touch_ring;
 }
 
-uint8_t TOUCH_MANAGER_work(void)
+void TOUCH_MANAGER_dispatch(const INPUT_RING_event_t* event)
 {
-	if (touch_initialized == MICROEJ_FALSE)
+	TOUCH_HELPER_set_sample_time(event->time, event->read_time);
+
+	if (event->id > 0U)
 	{
-		return MICROEJ_FALSE;
+		TOUCH_HELPER_pressed(event->points[0].x, event->points[0].y);
+	}
+	else
+	{
+		TOUCH_HELPER_released();
 	}
 
-	// manage touch event
-	uint8_t touch_pressed = TOUCH_MANAGER_update();
+#ifdef TOUCH_GESTURE_ENABLED
+	TOUCH_GESTURE_update(event->points, event->id, event->time);
+#endif
+}
 
-	// clear TS_INT_PIN IRQ in MFX
-	BSP_TS_ITClear();
+void TOUCH_MANAGER_enable_interrupts(void)
+{
+	HAL_NVIC_EnableIRQ(TS_INT_EXTI_IRQn);
+	HAL_NVIC_EnableIRQ(TOUCH_DMA_IRQn);
+	HAL_NVIC_EnableIRQ(TOUCH_I2C_EV_IRQn);
+	HAL_NVIC_EnableIRQ(TOUCH_I2C_ER_IRQn);
+}
 
-	return touch_pressed;
+void TOUCH_MANAGER_disable_interrupts(void)
+{
+	HAL_NVIC_DisableIRQ(TS_INT_EXTI_IRQn);
+	HAL_NVIC_DisableIRQ(TOUCH_DMA_IRQn);
+	HAL_NVIC_DisableIRQ(TOUCH_I2C_EV_IRQn);
+	HAL_NVIC_DisableIRQ(TOUCH_I2C_ER_IRQn);
 }
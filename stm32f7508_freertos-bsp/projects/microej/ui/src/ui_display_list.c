@@ -0,0 +1,469 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the display list (see ui_display_list.h).
+ *
+ * A region is in one of these modes between "UI_DISPLAY_LIST_begin()" and
+ * "UI_DISPLAY_LIST_end()":
+ * - record: the region has no valid buffer; the drawings are performed and hashed, and
+ *   the region's pixels are copied in the buffer at the end,
+ * - verify: the region has a valid buffer; the drawings are only hashed, and the buffer
+ *   is copied in the region at the end when the hash has not changed.
+ *
+ * The drawings are not kept: the Java objects given to the natives (graphics contexts,
+ * images, arrays) can move between two natives. When the drawings have changed, the
+ * application draws the region again.
+ *
+ * Some drawings are not hashed: the strings drawn by the Graphics Engine, the layers
+ * composition, the grayscale conversions and the drawings of the images of the images
+ * heap (their pixels can change at the same address). A region that holds such a drawing
+ * is not copied back: it is marked as unhashed and drawn as usual until it is
+ * invalidated. The BSP drawings notify the display list (see
+ * "UI_DISPLAY_LIST_notify_drawing()"); the Graphics Engine drawings are detected in
+ * verify mode because they change the region's pixels (see UI_DISPLAY_LIST_CHECK_PIXELS).
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <LLUI_DISPLAY.h>
+#include <LLUI_DISPLAY_impl.h>
+
+#include "ui_display_list.h"
+#include "ui_drawing_dma2d.h"
+#include "display_dirty_regions.h"
+#include "microui_heap.h"
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief FNV-1a 32-bit parameters.
+ */
+#define DISPLAY_LIST_FNV_OFFSET (2166136261U)
+#define DISPLAY_LIST_FNV_PRIME (16777619U)
+
+/*
+ * @brief Modes of the started region.
+ */
+#define DISPLAY_LIST_IDLE (0U) // no region is started (or the region is not recorded)
+#define DISPLAY_LIST_RECORD (1U) // the drawings are performed and hashed
+#define DISPLAY_LIST_VERIFY (2U) // the drawings are only hashed
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief A recorded region.
+ */
+typedef struct {
+	jint x; // region given by the application (region's key)
+	jint y;
+	jint width;
+	jint height;
+	jint x1; // region after the clip
+	jint y1;
+	jint x2;
+	jint y2;
+	uint8_t* pixels; // region's buffer (NULL when not allocated)
+	uint32_t size; // buffer's size in bytes
+	uint32_t hash; // hash of the recorded drawings
+	uint32_t drawings; // number of recorded drawings
+	uint32_t last_use; // value of g_uses when the region has been used
+	bool used; // the entry holds a region
+	bool valid; // the buffer holds the region's pixels
+	bool unhashed; // the region holds some drawings that are not hashed
+} display_list_region_t;
+
+// --------------------------------------------------------------------------------
+// Private fields
+// --------------------------------------------------------------------------------
+
+static display_list_region_t g_regions[UI_DISPLAY_LIST_REGIONS];
+
+/*
+ * @brief Started region, its mode, its destination buffer and the hash of its drawings.
+ */
+static display_list_region_t* g_region;
+static uint32_t g_mode;
+static uint8_t* g_target;
+static uint32_t g_hash;
+static uint32_t g_drawings;
+
+/*
+ * @brief Set when a drawing that is not hashed has been performed in the started region.
+ */
+static bool g_unhashed;
+
+/*
+ * @brief Set when the image given by "UI_DISPLAY_LIST_image()" is in the images heap.
+ */
+static bool g_mutable;
+
+#ifdef UI_DISPLAY_LIST_CHECK_PIXELS
+/*
+ * @brief Hash of the region's pixels when the region has been started in verify mode.
+ */
+static uint32_t g_pixels;
+#endif
+
+/*
+ * @brief Number of started regions (least recently used region).
+ */
+static uint32_t g_uses;
+
+/*
+ * @brief Display list counters (see UI_DISPLAY_LIST_get_statistics()).
+ */
+static UI_DISPLAY_LIST_statistics_t g_statistics;
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Folds a value in the hash of the started region.
+ */
+static inline void _display_list_fold(jint value) {
+	g_hash = UI_DISPLAY_LIST_hash(g_hash, &value, sizeof(value));
+}
+
+#ifdef UI_DISPLAY_LIST_CHECK_PIXELS
+/*
+ * @brief Hashes the pixels of a region in the destination.
+ */
+static uint32_t _display_list_hash_pixels(MICROUI_GraphicsContext* gc, const display_list_region_t* region) {
+	uint32_t stride = (LLUI_DISPLAY_getStrideInPixels(&gc->image) * (uint32_t)DRAWING_DMA2D_BPP) / 8U;
+	uint32_t size = ((uint32_t)(region->x2 - region->x1 + 1) * (uint32_t)DRAWING_DMA2D_BPP) / 8U;
+	const uint8_t* row = LLUI_DISPLAY_getBufferAddress(&gc->image) + ((uint32_t)region->y1 * stride) + (((uint32_t)region->x1 * (uint32_t)DRAWING_DMA2D_BPP) / 8U);
+	uint32_t hash = 0;
+	for (jint y = region->y1; y <= region->y2; y++) {
+		hash = UI_DISPLAY_LIST_hash(hash, row, size);
+		row += stride;
+	}
+	return hash;
+}
+#endif
+
+/*
+ * @brief Frees the buffer of a region.
+ */
+static void _display_list_free(display_list_region_t* region) {
+	if (NULL != region->pixels) {
+		LLUI_DISPLAY_IMPL_image_heap_free(region->pixels);
+		region->pixels = NULL;
+		region->size = 0;
+	}
+	region->valid = false;
+}
+
+/*
+ * @brief Gets the entry of a region: the entry of the same region, a free entry or the
+ * entry used the least recently.
+ */
+static display_list_region_t* _display_list_get(jint x, jint y, jint width, jint height) {
+	display_list_region_t* region = NULL;
+	display_list_region_t* oldest = &g_regions[0];
+
+	for (uint32_t i = 0; (NULL == region) && (i < UI_DISPLAY_LIST_REGIONS); i++) {
+		display_list_region_t* entry = &g_regions[i];
+		if (entry->used && (entry->x == x) && (entry->y == y) && (entry->width == width) && (entry->height == height)) {
+			region = entry;
+		}
+		else if (!oldest->used) {
+			// keep the first free entry
+		}
+		else if (!entry->used || ((int32_t)(entry->last_use - oldest->last_use) < 0)) {
+			oldest = entry;
+		}
+		else {
+			// entry used more recently
+		}
+	}
+
+	if (NULL == region) {
+		region = oldest;
+		region->used = true;
+		region->valid = false;
+		region->unhashed = false;
+		region->x = x;
+		region->y = y;
+		region->width = width;
+		region->height = height;
+	}
+
+	region->last_use = g_uses;
+	return region;
+}
+
+/*
+ * @brief Allocates the buffer of the started region. The buffers of the other regions
+ * that are not valid are freed when the images heap is full.
+ */
+static bool _display_list_allocate(display_list_region_t* region, uint32_t size) {
+	if ((NULL != region->pixels) && (region->size != size)) {
+		_display_list_free(region);
+	}
+
+	if (NULL == region->pixels) {
+		region->pixels = (uint8_t*)LLUI_DISPLAY_IMPL_image_heap_allocate(size);
+		if (NULL == region->pixels) {
+			for (uint32_t i = 0; i < UI_DISPLAY_LIST_REGIONS; i++) {
+				if (!g_regions[i].valid) {
+					_display_list_free(&g_regions[i]);
+				}
+			}
+			region->pixels = (uint8_t*)LLUI_DISPLAY_IMPL_image_heap_allocate(size);
+		}
+		region->size = (NULL != region->pixels) ? size : 0U;
+	}
+
+	return NULL != region->pixels;
+}
+
+// --------------------------------------------------------------------------------
+// ui_display_list.h functions
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void UI_DISPLAY_LIST_begin(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
+	if (DISPLAY_LIST_IDLE != g_mode) {
+		// nested regions: the started region goes on
+		LLUI_DISPLAY_reportError(gc, DRAWING_LOG_LIBRARY_INCIDENT);
+	}
+	else {
+		jint x1 = x;
+		jint y1 = y;
+		jint x2 = x + width - 1;
+		jint y2 = y + height - 1;
+
+		g_region = NULL;
+		g_uses++;
+
+		if ((width <= 0) || (height <= 0) || !LLUI_DISPLAY_clipRectangle(gc, &x1, &y1, &x2, &y2)) {
+			// nothing to draw
+		}
+		else if (!LLUI_DISPLAY_isDisplayFormat(gc->image.format) || ((uint32_t)((x2 - x1 + 1) * (y2 - y1 + 1)) < UI_DISPLAY_LIST_MIN_PIXELS)) {
+			// the DMA2D only copies the display format; the small regions are drawn as usual
+			g_statistics.uncached++;
+		}
+		else {
+			display_list_region_t* region = _display_list_get(x, y, width, height);
+			if (region->unhashed) {
+				// the region holds some drawings that are not hashed: drawn as usual
+				g_statistics.uncached++;
+			}
+			else {
+				if (region->valid && ((region->x1 != x1) || (region->y1 != y1) || (region->x2 != x2) || (region->y2 != y2))) {
+					// the clip has changed: the buffer does not hold the same pixels
+					region->valid = false;
+				}
+				region->x1 = x1;
+				region->y1 = y1;
+				region->x2 = x2;
+				region->y2 = y2;
+
+				g_region = region;
+				g_mode = region->valid ? DISPLAY_LIST_VERIFY : DISPLAY_LIST_RECORD;
+				g_target = LLUI_DISPLAY_getBufferAddress(&gc->image);
+				g_hash = 0;
+				g_drawings = 0;
+				g_unhashed = false;
+#ifdef UI_DISPLAY_LIST_CHECK_PIXELS
+				if (DISPLAY_LIST_VERIFY == g_mode) {
+					// the previous drawings are finished (see LLUI_DISPLAY_requestDrawing())
+					g_pixels = _display_list_hash_pixels(gc, region);
+				}
+#endif
+			}
+		}
+	}
+}
+
+// See the header file for the function documentation
+bool UI_DISPLAY_LIST_end(MICROUI_GraphicsContext* gc, DRAWING_Status* status) {
+	bool drawn = true;
+	display_list_region_t* region = g_region;
+
+	*status = DRAWING_DONE;
+
+#ifdef UI_DISPLAY_LIST_CHECK_PIXELS
+	if ((DISPLAY_LIST_VERIFY == g_mode) && (g_pixels != _display_list_hash_pixels(gc, region))) {
+		// the hashed drawings have been skipped: the Graphics Engine has drawn in the region
+		g_unhashed = true;
+	}
+#endif
+
+	if (DISPLAY_LIST_VERIFY == g_mode) {
+		if (!g_unhashed && (g_hash == region->hash) && (g_drawings == region->drawings)) {
+			jint width = region->x2 - region->x1 + 1;
+			g_statistics.hits++;
+			LLUI_DISPLAY_setDrawingLimits(region->x1, region->y1, region->x2, region->y2);
+			if (LLUI_DISPLAY_isLCD(&gc->image)) {
+				DISPLAY_DIRTY_REGIONS_add((uint32_t)region->x1, (uint32_t)region->y1, (uint32_t)region->x2, (uint32_t)region->y2);
+			}
+			*status = UI_DRAWING_DMA2D_copy_region(LLUI_DISPLAY_getBufferAddress(&gc->image), LLUI_DISPLAY_getStrideInPixels(&gc->image), region->x1, region->y1, region->pixels, (uint32_t)width, 0, 0, width, region->y2 - region->y1 + 1);
+		}
+		else {
+			// the drawings have been skipped: the application draws the region again (recorded
+			// or drawn as usual when it holds some drawings that are not hashed)
+			g_statistics.misses++;
+			region->valid = false;
+			region->unhashed = g_unhashed;
+			drawn = false;
+		}
+	}
+	else if (DISPLAY_LIST_RECORD == g_mode) {
+		jint width = region->x2 - region->x1 + 1;
+		jint height = region->y2 - region->y1 + 1;
+		if (g_unhashed) {
+			// the region's pixels cannot be identified by the hash: not copied back
+			region->unhashed = true;
+			g_statistics.uncached++;
+		}
+		else if (_display_list_allocate(region, ((uint32_t)width * (uint32_t)height * (uint32_t)DRAWING_DMA2D_BPP) / 8U)) {
+			// the drawings are finished (see LLUI_DISPLAY_requestDrawing()): copy the region
+			g_statistics.renders++;
+			region->hash = g_hash;
+			region->drawings = g_drawings;
+			region->valid = true;
+			*status = UI_DRAWING_DMA2D_copy_region(region->pixels, (uint32_t)width, 0, 0, LLUI_DISPLAY_getBufferAddress(&gc->image), LLUI_DISPLAY_getStrideInPixels(&gc->image), region->x1, region->y1, width, height);
+		}
+		else {
+			g_statistics.uncached++;
+		}
+	}
+	else {
+		// region not recorded: the drawings have been performed
+	}
+
+	g_mode = DISPLAY_LIST_IDLE;
+	g_region = NULL;
+
+	return drawn;
+}
+
+// See the header file for the function documentation
+bool UI_DISPLAY_LIST_request_drawing(MICROUI_GraphicsContext* gc, SNI_callback callback, uint32_t drawing, const jint* args, uint32_t count) {
+	bool draw = LLUI_DISPLAY_requestDrawing(gc, callback);
+
+	if (draw && (DISPLAY_LIST_IDLE != g_mode) && (LLUI_DISPLAY_getBufferAddress(&gc->image) == g_target)) {
+		_display_list_fold((jint)drawing);
+		_display_list_fold(gc->foreground_color);
+		_display_list_fold(((jint)gc->clip_x1 << 16) | ((jint)gc->clip_y1 & 0xffff));
+		_display_list_fold(((jint)gc->clip_x2 << 16) | ((jint)gc->clip_y2 & 0xffff));
+		g_hash = UI_DISPLAY_LIST_hash(g_hash, args, count * sizeof(jint));
+		g_drawings++;
+		// the pixels of an image of the images heap are not hashed
+		g_unhashed |= g_mutable;
+
+		if (DISPLAY_LIST_VERIFY == g_mode) {
+			// the region will be copied: requestDrawing() has been called and accepted,
+			// notify the end of empty drawing
+			LLUI_DISPLAY_setDrawingStatus(DRAWING_DONE);
+			draw = false;
+		}
+	}
+
+	g_mutable = false;
+	return draw;
+}
+
+// See the header file for the function documentation
+jint UI_DISPLAY_LIST_image(MICROUI_Image* img) {
+	uint32_t hash = 0;
+	if (DISPLAY_LIST_IDLE != g_mode) {
+		uint8_t* pixels = LLUI_DISPLAY_getBufferAddress(img);
+		jint format = (jint)img->format;
+		hash = UI_DISPLAY_LIST_hash(hash, (const void*)&pixels, sizeof(pixels));
+		hash = UI_DISPLAY_LIST_hash(hash, &img->width, sizeof(img->width));
+		hash = UI_DISPLAY_LIST_hash(hash, &img->height, sizeof(img->height));
+		hash = UI_DISPLAY_LIST_hash(hash, &format, sizeof(format));
+		g_mutable = MICROUI_HEAP_contains(pixels);
+	}
+	return (jint)hash;
+}
+
+// See the header file for the function documentation
+void UI_DISPLAY_LIST_notify_drawing(MICROUI_Image* img, jint x1, jint y1, jint x2, jint y2) {
+	display_list_region_t* region = g_region;
+	if ((DISPLAY_LIST_IDLE != g_mode) && (LLUI_DISPLAY_getBufferAddress(img) == g_target) && (region->x1 <= x2) && (x1 <= region->x2) && (region->y1 <= y2) && (y1 <= region->y2)) {
+		g_unhashed = true;
+	}
+}
+
+// See the header file for the function documentation
+uint32_t UI_DISPLAY_LIST_hash(uint32_t hash, const void* data, uint32_t size) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	uint32_t h = (0U == hash) ? DISPLAY_LIST_FNV_OFFSET : hash;
+	for (uint32_t i = 0; i < size; i++) {
+		h ^= (uint32_t)bytes[i];
+		h *= DISPLAY_LIST_FNV_PRIME;
+	}
+	return h;
+}
+
+// See the header file for the function documentation
+void UI_DISPLAY_LIST_invalidate(jint x, jint y, jint width, jint height) {
+	jint x2 = x + width - 1;
+	jint y2 = y + height - 1;
+	for (uint32_t i = 0; i < UI_DISPLAY_LIST_REGIONS; i++) {
+		display_list_region_t* region = &g_regions[i];
+		if ((region->valid || region->unhashed) && (region->x1 <= x2) && (x <= region->x2) && (region->y1 <= y2) && (y <= region->y2)) {
+			// the buffer is kept to record the region again
+			region->valid = false;
+			region->unhashed = false;
+			g_statistics.invalidations++;
+		}
+	}
+}
+
+// See the header file for the function documentation
+void UI_DISPLAY_LIST_get_statistics(UI_DISPLAY_LIST_statistics_t* statistics) {
+	*statistics = g_statistics;
+}
+
+// See the header file for the function documentation
+void UI_DISPLAY_LIST_reset_statistics(void) {
+	(void)memset(&g_statistics, 0, sizeof(g_statistics));
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_DisplayList_begin(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
+	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&Java_com_microej_ui_DisplayList_begin)) {
+		UI_DISPLAY_LIST_begin(gc, x, y, width, height);
+		LLUI_DISPLAY_setDrawingStatus(DRAWING_DONE);
+	}
+}
+
+// See the header file for the function documentation
+jboolean Java_com_microej_ui_DisplayList_end(MICROUI_GraphicsContext* gc) {
+	jboolean drawn = JTRUE;
+	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&Java_com_microej_ui_DisplayList_end)) {
+		DRAWING_Status status;
+		drawn = UI_DISPLAY_LIST_end(gc, &status) ? JTRUE : JFALSE;
+		LLUI_DISPLAY_setDrawingStatus(status);
+	}
+	return drawn;
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_DisplayList_invalidate(jint x, jint y, jint width, jint height) {
+	UI_DISPLAY_LIST_invalidate(x, y, width, height);
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
@@ -0,0 +1,202 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the software blending kernels (see ui_drawing_blend.h).
+ *
+ * The pixels are blended in the RGB888 format: a RGB565 pixel is expanded in a word
+ * 0x00RRGGBB (the high bits of each channel are copied in its low bits), blended and
+ * packed back in RGB565 (the low bits are dropped).
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "ui_drawing_blend.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+// CMSIS intrinsic __SMLAD
+#include "stm32f7xx.h"
+#define DRAWING_BLEND_DSP
+#endif
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Expands a RGB565 pixel in a RGB888 word.
+ */
+static inline uint32_t _drawing_blend_expand(uint16_t pixel) {
+	uint32_t r = ((uint32_t)pixel >> 11) & 0x1fU;
+	uint32_t g = ((uint32_t)pixel >> 5) & 0x3fU;
+	uint32_t b = (uint32_t)pixel & 0x1fU;
+	return (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+/*
+ * @brief Packs a RGB888 word (or an ARGB8888 pixel) in a RGB565 pixel.
+ */
+static inline uint16_t _drawing_blend_pack(uint32_t color) {
+	return (uint16_t)(((color >> 8) & 0xf800U) | ((color >> 5) & 0x07e0U) | ((color >> 3) & 0x001fU));
+}
+
+/*
+ * @brief Divides by 255 a value already rounded (+128), without division.
+ */
+static inline uint32_t _drawing_blend_div255(uint32_t value) {
+	return (value + (value >> 8)) >> 8;
+}
+
+/*
+ * @brief Multiplies two alpha values (0 to 255).
+ */
+static inline uint32_t _drawing_blend_multiply_alpha(uint32_t a1, uint32_t a2) {
+	return _drawing_blend_div255((a1 * a2) + 128U);
+}
+
+/*
+ * @brief Blends a channel: the weights are the foreground alpha in the high half-word
+ * and its complement (255 - alpha) in the low half-word.
+ */
+static inline uint32_t _drawing_blend_channel(uint32_t fg, uint32_t bg, uint32_t weights) {
+#ifdef DRAWING_BLEND_DSP
+	// fg * alpha + bg * (255 - alpha) + 128 in one instruction
+	uint32_t value = __SMLAD((fg << 16) | bg, weights, 128U);
+#else
+	uint32_t value = (fg * (weights >> 16)) + (bg * (weights & 0xffffU)) + 128U;
+#endif
+	return _drawing_blend_div255(value);
+}
+
+/*
+ * @brief Blends two RGB888 words (alpha: 1 to 254). All the alpha values are rounded
+ * the same way, like the DMA2D: the pixels blended by the CPU and by the DMA2D in the
+ * same drawing do not differ.
+ */
+static inline uint32_t _drawing_blend_pixel(uint32_t fg, uint32_t bg, uint32_t alpha) {
+	uint32_t weights = (alpha << 16) | (255U - alpha);
+	uint32_t ret = _drawing_blend_channel((fg >> 16) & 0xffU, (bg >> 16) & 0xffU, weights) << 16;
+	ret |= _drawing_blend_channel((fg >> 8) & 0xffU, (bg >> 8) & 0xffU, weights) << 8;
+	ret |= _drawing_blend_channel(fg & 0xffU, bg & 0xffU, weights);
+	return ret;
+}
+
+/*
+ * @brief Blends a color in a RGB565 pixel.
+ */
+static inline void _drawing_blend_color(uint16_t* dest, uint32_t color, uint32_t alpha) {
+	if (0xffU == alpha) {
+		*dest = _drawing_blend_pack(color);
+	}
+	else if (0U != alpha) {
+		*dest = _drawing_blend_pack(_drawing_blend_pixel(color & 0xffffffU, _drawing_blend_expand(*dest), alpha));
+	}
+	else {
+		// transparent: nothing to draw
+	}
+}
+
+// --------------------------------------------------------------------------------
+// ui_drawing_blend.h functions
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void UI_DRAWING_BLEND_rgb565(uint16_t* dest, const uint16_t* src, uint32_t count, uint32_t alpha) {
+	if (0xffU == alpha) {
+		(void)memcpy(dest, src, count * sizeof(uint16_t));
+	}
+	else if (0U != alpha) {
+		for (uint32_t i = 0; i < count; i++) {
+			dest[i] = _drawing_blend_pack(_drawing_blend_pixel(_drawing_blend_expand(src[i]), _drawing_blend_expand(dest[i]), alpha));
+		}
+	}
+	else {
+		// transparent: nothing to draw
+	}
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_BLEND_argb8888(uint16_t* dest, const uint32_t* src, uint32_t count, uint32_t alpha) {
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t pixel = src[i];
+		uint32_t a = pixel >> 24;
+		if (0xffU != alpha) {
+			a = _drawing_blend_multiply_alpha(a, alpha);
+		}
+		_drawing_blend_color(&dest[i], pixel, a);
+	}
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_BLEND_a8(uint16_t* dest, const uint8_t* src, uint32_t count, uint32_t color, uint32_t alpha) {
+	uint32_t i = 0;
+	while (i < count) {
+		uint32_t alphas = 1;
+		if ((count - i) >= 4U) {
+			// unaligned load of four alpha values (supported by the Cortex-M7)
+			(void)memcpy(&alphas, &src[i], sizeof(alphas));
+		}
+
+		if (0U == alphas) {
+			// four transparent pixels (antialiased glyphs and shapes)
+			i += 4U;
+		}
+		else {
+			uint32_t a = src[i];
+			if (0xffU != alpha) {
+				a = _drawing_blend_multiply_alpha(a, alpha);
+			}
+			_drawing_blend_color(&dest[i], color, a);
+			i++;
+		}
+	}
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_BLEND_fill(uint16_t* dest, uint32_t count, uint32_t color, uint32_t alpha) {
+	if (0xffU == alpha) {
+		uint16_t pixel = _drawing_blend_pack(color);
+		for (uint32_t i = 0; i < count; i++) {
+			dest[i] = pixel;
+		}
+	}
+	else if (0U != alpha) {
+		uint32_t fg = color & 0xffffffU;
+		for (uint32_t i = 0; i < count; i++) {
+			dest[i] = _drawing_blend_pack(_drawing_blend_pixel(fg, _drawing_blend_expand(dest[i]), alpha));
+		}
+	}
+	else {
+		// transparent: nothing to draw
+	}
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_BLEND_argb8888_to_rgb565(uint16_t* dest, const uint32_t* src, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		dest[i] = _drawing_blend_pack(src[i]);
+	}
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_BLEND_rgb565_to_argb8888(uint32_t* dest, const uint16_t* src, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		dest[i] = 0xff000000U | _drawing_blend_expand(src[i]);
+	}
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
@@ -20,10 +20,15 @@
 // Includes
 // --------------------------------------------------------------------------------
 
+#include <assert.h>
+
 #include "ui_drawing_dma2d.h"
 #include "ui_drawing_dma2d_configuration.h"
+#include "ui_drawing_dma2d_cache.h"
+#include "ui_drawing_blend.h"
 #include "ui_drawing_soft.h"
 #include "ui_image_drawing.h"
+#include "framerate_impl.h"
 
 // --------------------------------------------------------------------------------
 // Defines
@@ -48,7 +53,34 @@
 #ifndef DRAWING_DMA2D_CACHE_MANAGEMENT
 #error "Please define the DRAWING_DMA2D_CACHE_MANAGEMENT in drawing_dma2d_configuration.h"
 #endif
-    
+
+/*
+ * @brief Ensures the configuration of the jobs queue.
+ */
+#ifndef DRAWING_DMA2D_QUEUE_SIZE
+#error "Please define the DRAWING_DMA2D_QUEUE_SIZE in drawing_dma2d_configuration.h"
+#endif
+
+/*
+ * @brief Ensures the configuration of the drawings shared between the DMA2D and the CPU.
+ */
+#ifndef DRAWING_DMA2D_SPLIT_CPU_SHARE
+#error "Please define the DRAWING_DMA2D_SPLIT_CPU_SHARE in drawing_dma2d_configuration.h"
+#endif
+
+/*
+ * @brief DMA2D interrupts enabled for each job: transfer complete, transfer error and
+ * configuration error (an error ends the job as well to not lock the Graphics Engine).
+ */
+#define DRAWING_DMA2D_IT_FLAGS (DMA2D_CR_TCIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE)
+#define DRAWING_DMA2D_ISR_FLAGS (DMA2D_ISR_TCIF | DMA2D_ISR_TEIF | DMA2D_ISR_CEIF | DMA2D_ISR_CTCIF | DMA2D_ISR_CAEIF)
+
+/*
+ * @brief DMA2D interrupts enabled for a CLUT loading job: CLUT transfer complete and
+ * CLUT access error (in addition to the errors of DRAWING_DMA2D_IT_FLAGS).
+ */
+#define DRAWING_DMA2D_CLUT_IT_FLAGS (DMA2D_CR_CTCIE | DMA2D_CR_CAEIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE)
+
 // --------------------------------------------------------------------------------
 // Types
 // --------------------------------------------------------------------------------
@@ -77,8 +109,35 @@ typedef struct {
 	jint alpha; // opacity to apply
 	uint32_t src_dma2d_format; // source image's format in DMA2D format
 	uint32_t src_bpp; // source image's bpp
+	uint32_t dest_dma2d_format; // destination's format in DMA2D format
+	uint32_t dest_bpp; // destination's bpp
+	DRAWING_DMA2D_CACHE_area_t dest_area; // destination's region to invalidate at the end of the drawing
 } DRAWING_DMA2D_blending_t;
 
+/*
+ * @brief A DMA2D job: the values of the DMA2D registers to perform a fill, a copy or
+ * a blending. The job is started by writing the registers, without using the HAL.
+ */
+typedef struct {
+	uint32_t mode; // DMA2D_R2M, DMA2D_M2M or DMA2D_M2M_BLEND
+	uint32_t fgmar; // foreground address
+	uint32_t fgor; // foreground line offset
+	uint32_t fgpfccr; // foreground format, alpha mode and alpha
+	uint32_t fgcolr; // foreground color (A4 and A8 formats)
+	uint32_t fgcmar; // foreground CLUT address (CLUT loading job), 0 for the other jobs
+	uint32_t bgmar; // background address
+	uint32_t bgor; // background line offset
+	uint32_t ocolr; // output color (fill)
+	uint32_t omar; // output address
+	uint32_t oor; // output line offset
+	uint32_t opfccr; // output format (display format excepted for the layers, see ui_drawing_layers.c)
+	uint32_t nlr; // pixels per line and number of lines
+	DRAWING_DMA2D_memcpy* memcpy_next; // next rectangle of a memcpy list (NULL for the other jobs)
+	uint32_t memcpy_remaining; // number of rectangles not started yet in the memcpy list
+	t_drawing_notification notification; // called at the end of the job (NULL when it is not the last job of a drawing)
+	DRAWING_DMA2D_CACHE_area_t dest_area; // region to invalidate before calling the notification (memcpy list excepted)
+} DRAWING_DMA2D_job_t;
+
 // --------------------------------------------------------------------------------
 // Private fields
 // --------------------------------------------------------------------------------
@@ -89,27 +148,67 @@ typedef struct {
 static DMA2D_HandleTypeDef g_hdma2d;
 
 /*
- * @brief Next notification to call after DMA2D work.
+ * @brief Jobs queue (ring buffer). The jobs are added at head by the Graphics Engine
+ * task (or by the LCD interrupt for the memcpy) and removed at tail by the DMA2D
+ * interrupt which starts the next job. The job at tail is the running job.
  */
-static t_drawing_notification g_callback_notification;
+static DRAWING_DMA2D_job_t g_queue[DRAWING_DMA2D_QUEUE_SIZE];
+static uint32_t g_queue_head;
+static volatile uint32_t g_queue_tail;
+static volatile uint32_t g_queue_count;
 
 /*
- * @brief This boolean is set to true before launching a DMA2D action and back to
- * false during DMA2D interrupt. It allows to know if the DMA2D is running or not.
+ * @brief This boolean is set to true when a job is started and back to false when
+ * the DMA2D interrupt finds the queue empty. It allows to know if the DMA2D is running or not.
  */
-static bool g_dma2d_running;
+static volatile bool g_dma2d_running;
 
 /*
- * @brief Binary semaphore used to lock a DMA2D user when DMA2D is already running.
+ * @brief Binary semaphore used to lock a DMA2D user when the queue is full or when it
+ * waits for the end of the DMA2D work.
  */
 static void* g_dma2d_semaphore;
 
+/*
+ * @brief Memcpy list configured by UI_DRAWING_DMA2D_configure_memcpy_list() and queued
+ * by UI_DRAWING_DMA2D_start_memcpy().
+ */
+static uint32_t g_memcpy_count;
+
+/*
+ * @brief Cycle counter value when the memcpy list has been queued.
+ */
+static uint32_t g_memcpy_cycles;
+
+/*
+ * @brief Queue and DMA2D activity counters (see UI_DRAWING_DMA2D_get_statistics()).
+ */
+static DRAWING_DMA2D_statistics_t g_statistics;
+
+/*
+ * @brief Cycle counter value when the DMA2D became idle or busy.
+ */
+static uint32_t g_state_cycles;
+
+/*
+ * @brief Number of jobs added in the queue and number of jobs finished. The jobs are
+ * finished in the queue order: a job is finished when g_jobs_done reaches the value of
+ * g_jobs_queued just after its addition (see UI_DRAWING_DMA2D_wait_job()).
+ */
+static uint32_t g_jobs_queued;
+static volatile uint32_t g_jobs_done;
+
+/*
+ * @brief Destination region of the tiles drawing in progress (see UI_DRAWING_DMA2D_start_tiles()).
+ */
+static DRAWING_DMA2D_CACHE_area_t g_tiles_area;
+
 // --------------------------------------------------------------------------------
 // Private functions
 // --------------------------------------------------------------------------------
 
 /*
- * @brief Ensures DMA2D previous work is done before returning.
+ * @brief Ensures DMA2D previous work (all the queued jobs) is done before returning.
  */
 static inline void _drawing_dma2d_wait(void) {
 	while(g_dma2d_running) {
@@ -118,7 +217,22 @@ static inline void _drawing_dma2d_wait(void) {
 }
 
 /*
- * @brief Invalidates the cache.
+ * @brief Updates the idle or busy time with the time spent since the last DMA2D state change.
+ */
+static inline void _drawing_dma2d_account_time(bool was_running) {
+	uint32_t now = framerate_impl_get_cycles();
+	uint32_t elapsed = now - g_state_cycles;
+	g_state_cycles = now;
+	if (was_running) {
+		g_statistics.busy_cycles += elapsed;
+	}
+	else {
+		g_statistics.idle_cycles += elapsed;
+	}
+}
+
+/*
+ * @brief Invalidates the cache over a region written by the DMA2D.
  *
  * After each DMA_2D transfer, the data cache must be invalidated because the
  * graphics memory is in the memory which is defined "cache enabled" in the MPU
@@ -127,14 +241,16 @@ static inline void _drawing_dma2d_wait(void) {
  *
  * This feature is only required on STM32 CPUs that hold a cache.
  */
-static inline void _invalidateDCache(void) {
+static inline void _invalidateDCache(DRAWING_DMA2D_CACHE_area_t* area) {
 #if DRAWING_DMA2D_CACHE_MANAGEMENT == DRAWING_DMA2D_CACHE_MANAGEMENT_ENABLED
-	SCB_InvalidateDCache();
+	DRAWING_DMA2D_CACHE_invalidate(area);
+#else
+	(void)area;
 #endif
 }
 
 /*
- * @brief Cleans the cache.
+ * @brief Cleans the cache over a region read or written by the DMA2D.
  *
  * Before each DMA_2D transfer, the data cache must be cleaned because the
  * graphics memory is in the memory which is defined "cache enabled" in the MPU
@@ -142,19 +258,147 @@ static inline void _invalidateDCache(void) {
  *
  * This feature is only required on STM32 CPUs that hold a cache.
  */
-static inline void _cleanDCache(void) {
+static inline void _cleanDCache(DRAWING_DMA2D_CACHE_area_t* area) {
 #if DRAWING_DMA2D_CACHE_MANAGEMENT == DRAWING_DMA2D_CACHE_MANAGEMENT_ENABLED
-	SCB_CleanDCache();
+	DRAWING_DMA2D_CACHE_clean(area);
+#else
+	(void)area;
 #endif
 }
 
 /*
- * @brief Notify the DMA2D has finished previous job.
+ * @brief Fills the cache areas of a memcpy.
  */
-static inline void _drawing_dma2d_done(void) {
-	g_dma2d_running = false;
-	_invalidateDCache();
-	LLUI_DISPLAY_IMPL_binarySemaphoreGive(g_dma2d_semaphore, true);
+static inline void _drawing_dma2d_memcpy_areas(DRAWING_DMA2D_memcpy* memcpy_data, DRAWING_DMA2D_CACHE_area_t* src_area, DRAWING_DMA2D_CACHE_area_t* dest_area) {
+	uint32_t stride = (uint32_t)memcpy_data->width + (uint32_t)memcpy_data->offset;
+	DRAWING_DMA2D_CACHE_set_area(src_area, memcpy_data->src_address, 0, 0, memcpy_data->width, memcpy_data->height, stride, DRAWING_DMA2D_BPP);
+	DRAWING_DMA2D_CACHE_set_area(dest_area, memcpy_data->dest_address, 0, 0, memcpy_data->width, memcpy_data->height, stride, DRAWING_DMA2D_BPP);
+}
+
+/*
+ * @brief Converts a MicroUI color (ARGB8888) in the DMA2D output format (register OCOLR).
+ */
+static inline uint32_t _drawing_dma2d_convert_color(uint32_t color) {
+#if DRAWING_DMA2D_BPP == 16
+	return ((color & 0xf80000U) >> 8) | ((color & 0xfc00U) >> 5) | ((color & 0xf8U) >> 3);
+#elif DRAWING_DMA2D_BPP == 24
+	return color & 0xffffffU;
+#else
+	return color;
+#endif
+}
+
+/*
+ * @brief Writes the registers of the job and starts the DMA2D. When the job is a
+ * memcpy list, the next rectangle of the list is loaded in the job first.
+ */
+static void _drawing_dma2d_job_start(DRAWING_DMA2D_job_t* job) {
+	if (NULL != job->memcpy_next) {
+		DRAWING_DMA2D_memcpy* memcpy_data = job->memcpy_next;
+		// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+		job->fgmar = (uint32_t)memcpy_data->src_address;
+		// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+		job->omar = (uint32_t)memcpy_data->dest_address;
+		job->fgor = memcpy_data->offset;
+		job->oor = memcpy_data->offset;
+		job->nlr = ((uint32_t)memcpy_data->width << DMA2D_NLR_PL_Pos) | memcpy_data->height;
+		// cppcheck-suppress [misra-c2012-18.4] next element of the list
+		job->memcpy_next = memcpy_data + 1;
+		--job->memcpy_remaining;
+	}
+
+	DMA2D_TypeDef* dma2d = g_hdma2d.Instance;
+
+	if ((uint32_t)0 != job->fgcmar) {
+		// CLUT loading: started by the foreground format register, not by the control register
+		dma2d->FGCMAR = job->fgcmar;
+		dma2d->CR = DRAWING_DMA2D_CLUT_IT_FLAGS;
+		dma2d->FGPFCCR = job->fgpfccr | DMA2D_FGPFCCR_START;
+	}
+	else {
+		dma2d->FGMAR = job->fgmar;
+		dma2d->FGOR = job->fgor;
+		dma2d->FGPFCCR = job->fgpfccr;
+		dma2d->FGCOLR = job->fgcolr;
+		dma2d->BGMAR = job->bgmar;
+		dma2d->BGOR = job->bgor;
+		dma2d->OCOLR = job->ocolr;
+		dma2d->OMAR = job->omar;
+		dma2d->OOR = job->oor;
+		dma2d->OPFCCR = job->opfccr;
+		dma2d->NLR = job->nlr;
+		dma2d->CR = job->mode | DRAWING_DMA2D_IT_FLAGS | DMA2D_CR_START;
+	}
+}
+
+/*
+ * @brief Gets the next free job of the queue without waiting: returns NULL when the
+ * queue is full. Can be called under interrupt.
+ *
+ * The job must be filled and then queued by _drawing_dma2d_job_commit().
+ */
+static DRAWING_DMA2D_job_t* _drawing_dma2d_job_try_allocate(void) {
+	if (g_queue_count == (uint32_t)DRAWING_DMA2D_QUEUE_SIZE) {
+		return NULL;
+	}
+
+	DRAWING_DMA2D_job_t* job = &g_queue[g_queue_head];
+	job->fgcolr = 0;
+	job->fgcmar = 0;
+	job->bgmar = 0;
+	job->bgor = 0;
+	job->ocolr = 0;
+	job->opfccr = DRAWING_DMA2D_FORMAT;
+	job->memcpy_next = NULL;
+	job->memcpy_remaining = 0;
+	job->notification = NULL;
+	return job;
+}
+
+/*
+ * @brief Gets the next free job of the queue. Waits for the end of the oldest job
+ * when the queue is full: must not be called under interrupt (see
+ * _drawing_dma2d_job_try_allocate()).
+ *
+ * The job must be filled and then queued by _drawing_dma2d_job_commit().
+ */
+static DRAWING_DMA2D_job_t* _drawing_dma2d_job_allocate(void) {
+	if (g_queue_count == (uint32_t)DRAWING_DMA2D_QUEUE_SIZE) {
+		g_statistics.queue_full++;
+		while (g_queue_count == (uint32_t)DRAWING_DMA2D_QUEUE_SIZE) {
+			LLUI_DISPLAY_IMPL_binarySemaphoreTake(g_dma2d_semaphore);
+		}
+	}
+	return _drawing_dma2d_job_try_allocate();
+}
+
+/*
+ * @brief Adds the job returned by _drawing_dma2d_job_allocate() in the queue and starts
+ * it immediately when the DMA2D is idle.
+ */
+static void _drawing_dma2d_job_commit(void) {
+	// the DMA2D interrupt must not see an intermediate state of the queue
+	HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+
+	DRAWING_DMA2D_job_t* job = &g_queue[g_queue_head];
+	g_queue_head = (g_queue_head + (uint32_t)1) % (uint32_t)DRAWING_DMA2D_QUEUE_SIZE;
+	g_queue_count++;
+	g_jobs_queued++;
+
+	g_statistics.jobs++;
+	if (g_queue_count > g_statistics.queue_depth_max) {
+		g_statistics.queue_depth_max = g_queue_count;
+	}
+
+	if (!g_dma2d_running) {
+		// DMA2D is idle: this job is the queue's tail
+		_drawing_dma2d_account_time(false);
+		g_dma2d_running = true;
+		_drawing_dma2d_job_start(job);
+	}
+	// else: the job will be started by the DMA2D interrupt
+
+	HAL_NVIC_EnableIRQ(DMA2D_IRQn);
 }
 
 /*
@@ -174,6 +418,21 @@ static inline void _drawing_dma2d_configure_alpha_image_data(MICROUI_GraphicsCon
 	*(alphaAndColor) |= (gc->foreground_color & 0xffffff);
 }
 
+/*
+ * @brief Sets the destination format: the display format or ARGB4444 (the only other
+ * destination format drawn by the DMA2D, see ui_drawing_layers.c).
+ */
+static inline void _drawing_dma2d_configure_destination(MICROUI_GraphicsContext* gc, DRAWING_DMA2D_blending_t* dma2d_blending_data) {
+	if (LLUI_DISPLAY_isDisplayFormat(gc->image.format)) {
+		dma2d_blending_data->dest_dma2d_format = DRAWING_DMA2D_FORMAT;
+		dma2d_blending_data->dest_bpp = DRAWING_DMA2D_BPP;
+	}
+	else {
+		dma2d_blending_data->dest_dma2d_format = DMA2D_ARGB4444;
+		dma2d_blending_data->dest_bpp = 16;
+	}
+}
+
 /*
  * @brief Tells is the image to draw in the graphics context is compatible with the DMA2D.
  *
@@ -290,69 +549,112 @@ static bool _drawing_dma2d_is_image_compatible_with_dma2d(MICROUI_GraphicsContex
 		dma2d_blending_data->x_dest = data_x_dest;
 		dma2d_blending_data->y_dest = y_dest;
 		dma2d_blending_data->alpha = alpha;
-
-		_cleanDCache();
+		_drawing_dma2d_configure_destination(gc, dma2d_blending_data);
+
+		// the DMA2D reads the source and reads / writes the destination
+		DRAWING_DMA2D_CACHE_area_t src_area;
+		DRAWING_DMA2D_CACHE_set_area(&src_area, dma2d_blending_data->src_address, data_x_src, y_src, data_width, height, dma2d_blending_data->src_stride, dma2d_blending_data->src_bpp);
+		DRAWING_DMA2D_CACHE_set_area(&dma2d_blending_data->dest_area, dma2d_blending_data->dest_address, data_x_dest, y_dest, data_width, height, dma2d_blending_data->dest_stride, dma2d_blending_data->dest_bpp);
+		_cleanDCache(&src_area);
+		_cleanDCache(&dma2d_blending_data->dest_area);
 	}
 
 	return is_dma2d_compatible;
 }
 
 /*
- * @brief Configures the DMA2D to draw an image.
- *
- * This function ensures that the DMA2D is free before configuring the DMA2D.
+ * @brief Queues a DMA2D job to draw an image.
  *
  * @param[in] dma2d_blending_data the blending configuration
+ * @param[in] notification the function to call at the end of the job, NULL when the
+ * drawing is not finished after this job.
  */
-static void _drawing_dma2d_blending_configure(DRAWING_DMA2D_blending_t* dma2d_blending_data) {
+static void _drawing_dma2d_blending_queue(DRAWING_DMA2D_blending_t* dma2d_blending_data, t_drawing_notification notification) {
+	uint8_t* srcAddr = _drawing_dma2d_adjust_address(dma2d_blending_data->src_address, dma2d_blending_data->x_src, dma2d_blending_data->y_src, dma2d_blending_data->src_stride, dma2d_blending_data->src_bpp);
+	uint8_t* destAddr = _drawing_dma2d_adjust_address(dma2d_blending_data->dest_address, dma2d_blending_data->x_dest, dma2d_blending_data->y_dest, dma2d_blending_data->dest_stride, dma2d_blending_data->dest_bpp);
+	uint32_t dest_format = dma2d_blending_data->dest_dma2d_format;
+	uint32_t alpha = (uint32_t)dma2d_blending_data->alpha;
+	uint32_t color = 0;
+
+	if ((CM_A4 == dma2d_blending_data->src_dma2d_format) || (CM_A8 == dma2d_blending_data->src_dma2d_format)) {
+		// alpha contains both the global alpha and the color
+		color = alpha & 0xffffffU;
+		alpha >>= 24;
+	}
 
-	_drawing_dma2d_wait();
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
 
-	// de-init DMA2D
-	HAL_DMA2D_DeInit(&g_hdma2d);
+	// foreground: the image
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->fgmar = (uint32_t)srcAddr;
+	job->fgor = dma2d_blending_data->src_stride - (uint32_t)dma2d_blending_data->width;
+	job->fgcolr = color;
 
-	// configure background
-	g_hdma2d.LayerCfg[0].InputOffset = dma2d_blending_data->dest_stride - dma2d_blending_data->width;
-	g_hdma2d.LayerCfg[0].InputColorMode = DRAWING_DMA2D_FORMAT;
-	g_hdma2d.LayerCfg[0].AlphaMode = DMA2D_NO_MODIF_ALPHA;
-	g_hdma2d.LayerCfg[0].InputAlpha = 255;
-	HAL_DMA2D_ConfigLayer(&g_hdma2d, 0);
+	if ((dest_format == dma2d_blending_data->src_dma2d_format) && ((uint32_t)0xff == alpha) && (dest_format != DMA2D_ARGB8888) && (dest_format != DMA2D_ARGB4444)) {
+		// opaque image in the destination format: copy it (the destination is not read)
+		job->mode = DMA2D_M2M;
+		job->fgpfccr = dma2d_blending_data->src_dma2d_format;
+	}
+	else {
+		job->mode = DMA2D_M2M_BLEND;
+		job->fgpfccr = dma2d_blending_data->src_dma2d_format | (DMA2D_COMBINE_ALPHA << DMA2D_FGPFCCR_AM_Pos) | (alpha << DMA2D_FGPFCCR_ALPHA_Pos);
 
-	// configure foreground
-	HAL_DMA2D_DisableCLUT(&g_hdma2d, 1);
-	g_hdma2d.LayerCfg[1].InputOffset = dma2d_blending_data->src_stride - dma2d_blending_data->width;
-	g_hdma2d.LayerCfg[1].InputColorMode = dma2d_blending_data->src_dma2d_format;
-	g_hdma2d.LayerCfg[1].AlphaMode = DMA2D_COMBINE_ALPHA;
-	g_hdma2d.LayerCfg[1].InputAlpha = dma2d_blending_data->alpha;
-	HAL_DMA2D_ConfigLayer(&g_hdma2d, 1);
+		// background: the destination
+		// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+		job->bgmar = (uint32_t)destAddr;
+		job->bgor = dma2d_blending_data->dest_stride - (uint32_t)dma2d_blending_data->width;
+	}
 
-	// configure DMA2D
-	g_hdma2d.Init.Mode = DMA2D_M2M_BLEND;
-	g_hdma2d.Init.OutputOffset = dma2d_blending_data->dest_stride - dma2d_blending_data->width;
-	HAL_DMA2D_Init(&g_hdma2d) ;
+	// output: the destination
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->omar = (uint32_t)destAddr;
+	job->oor = dma2d_blending_data->dest_stride - (uint32_t)dma2d_blending_data->width;
+	job->opfccr = dest_format;
+	job->nlr = ((uint32_t)dma2d_blending_data->width << DMA2D_NLR_PL_Pos) | (uint32_t)dma2d_blending_data->height;
 
-	// configure environment (useless if false is returned)
-	g_callback_notification = &LLUI_DISPLAY_notifyAsynchronousDrawingEnd;
+	job->notification = notification;
+	job->dest_area = dma2d_blending_data->dest_area;
+	_drawing_dma2d_job_commit();
 }
 
 /*
- * @brief Starts the DMA2D drawing previously configured thanks _drawing_dma2d_blending_configure().
+ * @brief Queues a DMA2D job to fill a rectangle with the foreground color.
  *
- * @param[in] dma2d_blending_data the blending configuration
+ * @param[in] gc the destination
+ * @param[in] x1 the top-left X coordinate
+ * @param[in] y1 the top-left Y coordinate
+ * @param[in] x2 the bottom-right X coordinate
+ * @param[in] y2 the bottom-right Y coordinate
+ * @param[in] dest_area the region to invalidate at the end of the drawing
+ * @param[in] notification the function to call at the end of the job, NULL when the
+ * drawing is not finished after this job.
  */
-static inline void _drawing_dma2d_blending_start(DRAWING_DMA2D_blending_t* dma2d_blending_data){
-	uint8_t* srcAddr = _drawing_dma2d_adjust_address(dma2d_blending_data->src_address, dma2d_blending_data->x_src, dma2d_blending_data->y_src, dma2d_blending_data->src_stride, dma2d_blending_data->src_bpp);
-	uint8_t* destAddr = _drawing_dma2d_adjust_address(dma2d_blending_data->dest_address, dma2d_blending_data->x_dest, dma2d_blending_data->y_dest, dma2d_blending_data->dest_stride, DRAWING_DMA2D_BPP);
-	g_dma2d_running = true;
+static void _drawing_dma2d_fill_queue(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, DRAWING_DMA2D_CACHE_area_t* dest_area, t_drawing_notification notification) {
+	uint32_t rectangle_width = x2 - x1 + 1;
+	uint32_t rectangle_height = y2 - y1 + 1;
+	uint32_t stride = LLUI_DISPLAY_getStrideInPixels(&gc->image);
+	uint8_t* destination_address = _drawing_dma2d_adjust_address(LLUI_DISPLAY_getBufferAddress(&gc->image), x1, y1, stride, DRAWING_DMA2D_BPP);
 
-	// cppcheck-suppress [misra-c2012-11.4] allow cast address in u32 (see HAL_DMA2D_BlendingStart_IT())
-	HAL_DMA2D_BlendingStart_IT(&g_hdma2d, (uint32_t)srcAddr, (uint32_t)destAddr, (uint32_t)destAddr, dma2d_blending_data->width, dma2d_blending_data->height);
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+	job->mode = DMA2D_R2M;
+	job->fgpfccr = 0;
+	job->fgmar = 0;
+	job->fgor = 0;
+	job->ocolr = _drawing_dma2d_convert_color(gc->foreground_color);
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->omar = (uint32_t)destination_address;
+	job->oor = stride - rectangle_width;
+	job->nlr = (rectangle_width << DMA2D_NLR_PL_Pos) | rectangle_height;
+	job->notification = notification;
+	job->dest_area = *dest_area;
+	_drawing_dma2d_job_commit();
 }
 
 /*
  * @brief Draws a region of an image at another position.
  *
- * This function draws block per block to prevent the overlapping in X.
+ * This function draws block per block to prevent the overlapping in X. The blocks
+ * are queued in order: the DMA2D draws them one after the other.
  *
  * @param[in] dma2d_blending_data the blending configuration
  */
@@ -360,36 +662,31 @@ static void _drawing_dma2d_overlap_horizontal(DRAWING_DMA2D_blending_t* dma2d_bl
 
 	// retrieve band's width
 	jint width = dma2d_blending_data->width;
-	dma2d_blending_data->width = dma2d_blending_data->x_dest - dma2d_blending_data->x_src;
-	_drawing_dma2d_blending_configure(dma2d_blending_data);
+	jint band = dma2d_blending_data->x_dest - dma2d_blending_data->x_src;
 
-	// go to x + band width
+	// go to x + width
 	dma2d_blending_data->x_src += width;
-	dma2d_blending_data->x_dest = dma2d_blending_data->x_src + dma2d_blending_data->width;
+	dma2d_blending_data->x_dest += width;
 
 	while (width > 0) {
 
 		// adjust band's width
-		if (width < dma2d_blending_data->width){
-			dma2d_blending_data->width = width;
-			_drawing_dma2d_blending_configure(dma2d_blending_data);
-		}
+		dma2d_blending_data->width = (width < band) ? width : band;
 
 		// adjust src & dest positions
 		dma2d_blending_data->x_src -= dma2d_blending_data->width;
 		dma2d_blending_data->x_dest -= dma2d_blending_data->width;
 
-		_drawing_dma2d_wait();
-		_drawing_dma2d_blending_start(dma2d_blending_data);
-
 		width -= dma2d_blending_data->width;
+		_drawing_dma2d_blending_queue(dma2d_blending_data, (width > 0) ? NULL : &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
 	}
 }
 
 /*
  * @brief Draws a region of an image at another position.
  *
- * This function draws block per block to prevent the overlapping in Y.
+ * This function draws block per block to prevent the overlapping in Y. The blocks
+ * are queued in order: the DMA2D draws them one after the other.
  *
  * @param[in] dma2d_blending_data the blending configuration
  */
@@ -397,29 +694,140 @@ static void _drawing_dma2d_overlap_vertical(DRAWING_DMA2D_blending_t* dma2d_blen
 
 	// retrieve band's height
 	jint height = dma2d_blending_data->height;
-	dma2d_blending_data->height = dma2d_blending_data->y_dest - dma2d_blending_data->y_src;
-	_drawing_dma2d_blending_configure(dma2d_blending_data);
+	jint band = dma2d_blending_data->y_dest - dma2d_blending_data->y_src;
 
-	// go to x + band height
+	// go to y + height
 	dma2d_blending_data->y_src += height;
-	dma2d_blending_data->y_dest = dma2d_blending_data->y_src + dma2d_blending_data->height;
+	dma2d_blending_data->y_dest += height;
 
 	while (height > 0) {
 
 		// adjust band's height
-		if (height < dma2d_blending_data->height){
-			dma2d_blending_data->height = height;
-			// no need to configure again the DMA2D
-		}
+		dma2d_blending_data->height = (height < band) ? height : band;
 
 		// adjust src & dest positions
 		dma2d_blending_data->y_src -= dma2d_blending_data->height;
 		dma2d_blending_data->y_dest -= dma2d_blending_data->height;
 
-		_drawing_dma2d_wait();
-		_drawing_dma2d_blending_start(dma2d_blending_data);
-
 		height -= dma2d_blending_data->height;
+		_drawing_dma2d_blending_queue(dma2d_blending_data, (height > 0) ? NULL : &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
+	}
+}
+
+#if DRAWING_DMA2D_BPP == 16
+
+/*
+ * @brief Gets the number of lines of an image drawing to draw with the CPU while the
+ * DMA2D draws the other lines (see DRAWING_DMA2D_SPLIT_CPU_SHARE).
+ *
+ * The CPU draws the bottom lines with the software kernels (see ui_drawing_blend.h):
+ * RGB565, ARGB8888 and A8 images in the display format only. When the cache management
+ * is enabled, the two bands must not share a cache line: the DMA2D interrupt cleans and
+ * invalidates the band of the DMA2D while the CPU writes its band.
+ *
+ * @param[in] dma2d_blending_data the blending configuration
+ *
+ * @return 0 when the drawing is not split
+ */
+static jint _drawing_dma2d_split_lines(DRAWING_DMA2D_blending_t* dma2d_blending_data) {
+	jint lines = 0;
+	uint32_t src_format = dma2d_blending_data->src_dma2d_format;
+	uint32_t pixels = (uint32_t)dma2d_blending_data->width * (uint32_t)dma2d_blending_data->height;
+
+	if ((DRAWING_DMA2D_FORMAT == dma2d_blending_data->dest_dma2d_format)
+			&& ((CM_RGB565 == src_format) || (CM_ARGB8888 == src_format) || (CM_A8 == src_format))
+			&& (dma2d_blending_data->src_address != dma2d_blending_data->dest_address)
+			&& (pixels >= DRAWING_DMA2D_SPLIT_MIN_PIXELS)) {
+		lines = (jint)(((uint32_t)dma2d_blending_data->height * DRAWING_DMA2D_SPLIT_CPU_SHARE) / (uint32_t)256);
+	}
+
+#if DRAWING_DMA2D_CACHE_MANAGEMENT == DRAWING_DMA2D_CACHE_MANAGEMENT_ENABLED
+	// cppcheck-suppress [misra-c2012-11.4] cast address to check its alignment
+	if (((((uint32_t)dma2d_blending_data->dest_address) % DRAWING_DMA2D_CACHE_LINE_SIZE) != (uint32_t)0)
+			|| (((dma2d_blending_data->dest_stride * (uint32_t)2) % DRAWING_DMA2D_CACHE_LINE_SIZE) != (uint32_t)0)) {
+		lines = 0;
+	}
+#endif
+
+	return lines;
+}
+
+/*
+ * @brief Draws an image with the CPU (see _drawing_dma2d_split_lines()).
+ *
+ * @param[in] dma2d_blending_data the blending configuration
+ */
+static void _drawing_dma2d_blend_cpu(DRAWING_DMA2D_blending_t* dma2d_blending_data) {
+	uint8_t* src = _drawing_dma2d_adjust_address(dma2d_blending_data->src_address, dma2d_blending_data->x_src, dma2d_blending_data->y_src, dma2d_blending_data->src_stride, dma2d_blending_data->src_bpp);
+	uint8_t* dest = _drawing_dma2d_adjust_address(dma2d_blending_data->dest_address, dma2d_blending_data->x_dest, dma2d_blending_data->y_dest, dma2d_blending_data->dest_stride, dma2d_blending_data->dest_bpp);
+	uint32_t src_line = (dma2d_blending_data->src_stride * dma2d_blending_data->src_bpp) / (uint32_t)8;
+	uint32_t dest_line = (dma2d_blending_data->dest_stride * dma2d_blending_data->dest_bpp) / (uint32_t)8;
+	uint32_t width = (uint32_t)dma2d_blending_data->width;
+	uint32_t alpha = (uint32_t)dma2d_blending_data->alpha;
+	uint32_t color = 0;
+
+	if (CM_A8 == dma2d_blending_data->src_dma2d_format) {
+		// alpha contains both the global alpha and the color
+		color = alpha & 0xffffffU;
+		alpha >>= 24;
+	}
+
+	for (jint y = 0; y < dma2d_blending_data->height; y++) {
+		switch (dma2d_blending_data->src_dma2d_format) {
+		case CM_RGB565:
+			// cppcheck-suppress [misra-c2012-11.3] the lines are arrays of pixels
+			UI_DRAWING_BLEND_rgb565((uint16_t*)dest, (uint16_t*)src, width, alpha);
+			break;
+		case CM_ARGB8888:
+			// cppcheck-suppress [misra-c2012-11.3] the lines are arrays of pixels
+			UI_DRAWING_BLEND_argb8888((uint16_t*)dest, (uint32_t*)src, width, alpha);
+			break;
+		default:
+			// CM_A8
+			// cppcheck-suppress [misra-c2012-11.3] the line is an array of pixels
+			UI_DRAWING_BLEND_a8((uint16_t*)dest, src, width, color, alpha);
+			break;
+		}
+		// cppcheck-suppress [misra-c2012-18.4] next line
+		src += src_line;
+		// cppcheck-suppress [misra-c2012-18.4] next line
+		dest += dest_line;
+	}
+}
+
+#endif // DRAWING_DMA2D_BPP == 16
+
+/*
+ * @brief Queues a DMA2D job to draw an image. A large image may be shared between the
+ * DMA2D and the CPU: the DMA2D draws the top lines while the CPU draws the bottom lines.
+ * The DMA2D job notifies the end of the drawing: the Graphics Engine does not start the
+ * next drawing before the end of this function (CPU band drawn).
+ *
+ * @param[in] dma2d_blending_data the blending configuration
+ */
+static void _drawing_dma2d_draw_image(DRAWING_DMA2D_blending_t* dma2d_blending_data) {
+#if DRAWING_DMA2D_BPP == 16
+	jint cpu_lines = _drawing_dma2d_split_lines(dma2d_blending_data);
+
+	if (cpu_lines > 0) {
+		DRAWING_DMA2D_blending_t cpu_band = *dma2d_blending_data;
+
+		// the DMA2D band: the interrupt invalidates only its lines
+		dma2d_blending_data->height -= cpu_lines;
+		DRAWING_DMA2D_CACHE_set_area(&dma2d_blending_data->dest_area, dma2d_blending_data->dest_address, dma2d_blending_data->x_dest, dma2d_blending_data->y_dest, dma2d_blending_data->width, dma2d_blending_data->height, dma2d_blending_data->dest_stride, dma2d_blending_data->dest_bpp);
+		_drawing_dma2d_blending_queue(dma2d_blending_data, &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
+
+		// the CPU band, drawn while the DMA2D is running
+		cpu_band.y_src += dma2d_blending_data->height;
+		cpu_band.y_dest += dma2d_blending_data->height;
+		cpu_band.height = cpu_lines;
+		_drawing_dma2d_blend_cpu(&cpu_band);
+		g_statistics.cpu_pixels += (uint32_t)cpu_band.width * (uint32_t)cpu_lines;
+	}
+	else
+#endif
+	{
+		_drawing_dma2d_blending_queue(dma2d_blending_data, &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
 	}
 }
 
@@ -429,14 +837,57 @@ static void _drawing_dma2d_overlap_vertical(DRAWING_DMA2D_blending_t* dma2d_blen
 
 // See the header file for the function documentation
 void UI_DRAWING_DMA2D_IRQHandler(void) {
-	// notify STM32 HAL
-	HAL_DMA2D_IRQHandler(&g_hdma2d);
+	DMA2D_TypeDef* dma2d = g_hdma2d.Instance;
+	uint32_t flags = dma2d->ISR & DRAWING_DMA2D_ISR_FLAGS;
+
+	if (flags != (uint32_t)0) {
+		// acknowledge the job end (an error ends the job too)
+		dma2d->IFCR = flags;
+
+		DRAWING_DMA2D_job_t* job = &g_queue[g_queue_tail];
+
+		if (job->memcpy_remaining > (uint32_t)0) {
+			// memcpy list not finished yet: copy the next rectangle
+			_drawing_dma2d_job_start(job);
+		}
+		else {
+			t_drawing_notification notification = job->notification;
+
+			// remove the job from the queue and chain the next one
+			g_queue_tail = (g_queue_tail + (uint32_t)1) % (uint32_t)DRAWING_DMA2D_QUEUE_SIZE;
+			g_queue_count--;
+			g_jobs_done++;
+			if (g_queue_count > (uint32_t)0) {
+				_drawing_dma2d_job_start(&g_queue[g_queue_tail]);
+			}
+			else {
+				_drawing_dma2d_account_time(true);
+				g_dma2d_running = false;
+			}
 
-	// notify DMA2D users
-	_drawing_dma2d_done();
+			if (NULL != notification) {
+				// end of a drawing: notify graphical engine
+				if (NULL != job->memcpy_next) {
+					g_statistics.memcpy_cycles = framerate_impl_get_cycles() - g_memcpy_cycles;
+					// cppcheck-suppress [misra-c2012-18.4] first element of the list
+					DRAWING_DMA2D_memcpy* memcpy_data = job->memcpy_next - g_memcpy_count;
+					for (uint32_t i = 0; i < g_memcpy_count; i++) {
+						DRAWING_DMA2D_CACHE_area_t src_area;
+						DRAWING_DMA2D_CACHE_area_t dest_area;
+						_drawing_dma2d_memcpy_areas(&memcpy_data[i], &src_area, &dest_area);
+						_invalidateDCache(&dest_area);
+					}
+				}
+				else {
+					_invalidateDCache(&job->dest_area);
+				}
+				notification(true);
+			}
 
-	// notify graphical engine
-	g_callback_notification(true);
+			// notify DMA2D users (free job or end of work)
+			LLUI_DISPLAY_IMPL_binarySemaphoreGive(g_dma2d_semaphore, true);
+		}
+	}
 }
 
 // --------------------------------------------------------------------------------
@@ -448,94 +899,460 @@ void UI_DRAWING_DMA2D_initialize(void* binary_semaphore_handle) {
 	// configure globals
 	g_dma2d_running = false;
 	g_dma2d_semaphore = binary_semaphore_handle;
+	g_queue_head = 0;
+	g_queue_tail = 0;
+	g_queue_count = 0;
+	g_jobs_queued = 0;
+	g_jobs_done = 0;
+
+	// the cycle counter measures the DMA2D idle and busy times
+	UI_DRAWING_DMA2D_reset_statistics();
 
 	// configure DMA2D IRQ handler
 	HAL_NVIC_SetPriority(DMA2D_IRQn, 5, 3);
 	HAL_NVIC_EnableIRQ(DMA2D_IRQn);
 
-	// configure DMA2D
+	// configure DMA2D once (clock); the jobs write the other registers
+	g_hdma2d.Init.Mode = DMA2D_M2M;
 	g_hdma2d.Init.ColorMode = DRAWING_DMA2D_FORMAT;
+	g_hdma2d.Init.OutputOffset = 0;
 	g_hdma2d.Instance = DMA2D;
+	HAL_DMA2D_Init(&g_hdma2d);
 }
 
 // See the header file for the function documentation
-void UI_DRAWING_DMA2D_configure_memcpy(uint8_t* srcAddr, uint8_t* destAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t stride, DRAWING_DMA2D_memcpy* memcpy_data) {
-	_drawing_dma2d_wait();
+void UI_DRAWING_DMA2D_get_statistics(DRAWING_DMA2D_statistics_t* statistics) {
+	HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+	// include the time elapsed in the current state
+	_drawing_dma2d_account_time(g_dma2d_running);
+	*statistics = g_statistics;
+	statistics->queue_depth = g_queue_count;
+	HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_reset_statistics(void) {
+	HAL_NVIC_DisableIRQ(DMA2D_IRQn);
+	g_statistics.jobs = 0;
+	g_statistics.queue_depth = 0;
+	g_statistics.queue_depth_max = g_queue_count;
+	g_statistics.queue_full = 0;
+	g_statistics.memcpy_dropped = 0;
+	g_statistics.idle_cycles = 0;
+	g_statistics.busy_cycles = 0;
+	g_statistics.memcpy_cycles = 0;
+	g_statistics.cpu_pixels = 0;
+	g_state_cycles = framerate_impl_get_cycles();
+	HAL_NVIC_EnableIRQ(DMA2D_IRQn);
+}
 
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_prepare_memcpy(uint8_t* srcAddr, uint8_t* destAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t stride, DRAWING_DMA2D_memcpy* memcpy_data) {
 	uint32_t width = (xmax - xmin + (uint32_t)1);
 	uint32_t height = (ymax - ymin + (uint32_t)1);
 
-	// de-init DMA2D
-	HAL_DMA2D_DeInit(&g_hdma2d);
-
-	// configure foreground
-	g_hdma2d.LayerCfg[1].InputOffset = stride - width;
-	g_hdma2d.LayerCfg[1].InputColorMode = DRAWING_DMA2D_FORMAT;
-	HAL_DMA2D_ConfigLayer(&g_hdma2d, 1);
-
-	// configure DMA2D
-	g_hdma2d.Init.Mode  = DMA2D_M2M;
-	g_hdma2d.Init.OutputOffset = stride - width;
-	HAL_DMA2D_Init(&g_hdma2d) ;
-
-	// configure given structure (to give later to DRAWING_DMA2D_start_memcpy())
 	memcpy_data->src_address = _drawing_dma2d_adjust_address(srcAddr, xmin, ymin, stride, DRAWING_DMA2D_BPP);
 	memcpy_data->dest_address = _drawing_dma2d_adjust_address(destAddr, xmin, ymin, stride, DRAWING_DMA2D_BPP);
 	memcpy_data->width = width;
 	memcpy_data->height = height;
+	memcpy_data->offset = stride - width;
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_configure_memcpy_list(DRAWING_DMA2D_memcpy* memcpy_data, uint32_t count) {
+	(void)memcpy_data;
 
-	// configure environment
-	g_callback_notification = &LLUI_DISPLAY_flushDone;
-	g_dma2d_running = true;
+	// the memcpy is queued under interrupt: ensure the queue is empty
+	_drawing_dma2d_wait();
+
+	// configure environment (the list is queued by UI_DRAWING_DMA2D_start_memcpy())
+	g_memcpy_count = count;
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_configure_memcpy(uint8_t* srcAddr, uint8_t* destAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t stride, DRAWING_DMA2D_memcpy* memcpy_data) {
+	UI_DRAWING_DMA2D_prepare_memcpy(srcAddr, destAddr, xmin, ymin, xmax, ymax, stride, memcpy_data);
+	UI_DRAWING_DMA2D_configure_memcpy_list(memcpy_data, 1);
 }
 
 // See the header file for the function documentation
 void UI_DRAWING_DMA2D_start_memcpy(DRAWING_DMA2D_memcpy* memcpy_data) {
-	_cleanDCache();
-	HAL_DMA2D_Start_IT(
-			&g_hdma2d,
-			// cppcheck-suppress [misra-c2012-11.4] cast address as expectded by DMA2D driver
-			(uint32_t)(memcpy_data->src_address),
-			// cppcheck-suppress [misra-c2012-11.4] cast address as expectded by DMA2D driver
-			(uint32_t)(memcpy_data->dest_address),
-			memcpy_data->width,
-			memcpy_data->height
-	);
+	for (uint32_t i = 0; i < g_memcpy_count; i++) {
+		DRAWING_DMA2D_CACHE_area_t src_area;
+		DRAWING_DMA2D_CACHE_area_t dest_area;
+		_drawing_dma2d_memcpy_areas(&memcpy_data[i], &src_area, &dest_area);
+		_cleanDCache(&src_area);
+		_cleanDCache(&dest_area);
+	}
+
+	// called by the LTDC interrupt: the job cannot wait for a free slot. The queue is
+	// empty (UI_DRAWING_DMA2D_configure_memcpy_list() has waited for the end of the
+	// drawings and the Graphics Engine waits for the end of the flush).
+	assert(0U == g_queue_count);
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_try_allocate();
+	if (NULL == job) {
+		// the previous frame is not restored: the Graphics Engine must not wait forever
+		g_statistics.memcpy_dropped++;
+		LLUI_DISPLAY_flushDone(true);
+		return;
+	}
+	job->mode = DMA2D_M2M;
+	job->fgpfccr = DRAWING_DMA2D_FORMAT;
+	// addresses, offsets and sizes are loaded from the list when starting each rectangle
+	job->memcpy_next = memcpy_data;
+	job->memcpy_remaining = g_memcpy_count;
+	job->notification = &LLUI_DISPLAY_flushDone;
+	g_memcpy_cycles = framerate_impl_get_cycles();
+	_drawing_dma2d_job_commit();
 }
 
-// --------------------------------------------------------------------------------
-// ui_drawing.h / ui_drawing_dma2d.h functions
-// (the function names differ according to the available number of destination formats)
-// --------------------------------------------------------------------------------
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_start_tiles(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
+
+	// the tiles are blended in this region: clean it once for all the tiles
+	DRAWING_DMA2D_CACHE_set_area(&g_tiles_area, LLUI_DISPLAY_getBufferAddress(&gc->image), x1, y1, x2 - x1 + 1, y2 - y1 + 1, LLUI_DISPLAY_getStrideInPixels(&gc->image), DRAWING_DMA2D_BPP);
+	_cleanDCache(&g_tiles_area);
+}
 
 // See the header file for the function documentation
-DRAWING_Status UI_DRAWING_DMA2D_fillRectangle(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+uint32_t UI_DRAWING_DMA2D_blend_tile(MICROUI_GraphicsContext* gc, uint32_t* tile, jint x, jint y, jint width, jint height, jint alpha, bool last) {
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	// the tile has just been written by the CPU (whatever the configuration of the
+	// display memory): the DMA2D must read it from the memory
+	DRAWING_DMA2D_CACHE_area_t tile_area;
+	// cppcheck-suppress [misra-c2012-11.3] the tile is a buffer of bytes for the cache
+	DRAWING_DMA2D_CACHE_set_area(&tile_area, (uint8_t*)tile, 0, 0, width, height, width, 32);
+	(void)DRAWING_DMA2D_CACHE_apply_range(&tile_area, false, UINT32_MAX);
+#endif
 
-	_drawing_dma2d_wait();
+	DRAWING_DMA2D_blending_t dma2d_blending_data;
+	MICROUI_Image* dest = &gc->image;
+	// cppcheck-suppress [misra-c2012-11.3] the tile is a buffer of bytes for the DMA2D
+	dma2d_blending_data.src_address = (uint8_t*)tile;
+	dma2d_blending_data.dest_address = LLUI_DISPLAY_getBufferAddress(dest);
+	dma2d_blending_data.src_stride = width;
+	dma2d_blending_data.dest_stride = LLUI_DISPLAY_getStrideInPixels(dest);
+	dma2d_blending_data.dest_width = dest->width;
+	dma2d_blending_data.dest_height = dest->height;
+	dma2d_blending_data.x_src = 0;
+	dma2d_blending_data.y_src = 0;
+	dma2d_blending_data.width = width;
+	dma2d_blending_data.height = height;
+	dma2d_blending_data.x_dest = x;
+	dma2d_blending_data.y_dest = y;
+	dma2d_blending_data.alpha = alpha;
+	dma2d_blending_data.src_dma2d_format = CM_ARGB8888;
+	dma2d_blending_data.src_bpp = 32;
+	dma2d_blending_data.dest_dma2d_format = DRAWING_DMA2D_FORMAT;
+	dma2d_blending_data.dest_bpp = DRAWING_DMA2D_BPP;
+	// the last job invalidates the whole region of the drawing
+	dma2d_blending_data.dest_area = g_tiles_area;
+
+	_drawing_dma2d_blending_queue(&dma2d_blending_data, last ? &LLUI_DISPLAY_notifyAsynchronousDrawingEnd : NULL);
+
+	return g_jobs_queued;
+}
 
-	LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
+// See the header file for the function documentation
+uint32_t UI_DRAWING_DMA2D_blend_alpha(MICROUI_GraphicsContext* gc, uint8_t* buffer, uint32_t stride, uint32_t bpp, jint x_src, jint y_src, jint width, jint height, jint x, jint y, bool last) {
+	DRAWING_DMA2D_blending_t dma2d_blending_data;
+	MICROUI_Image* dest = &gc->image;
+	jint alpha = 0xff;
+
+	// the foreground color is applied on the alpha values
+	_drawing_dma2d_configure_alpha_image_data(gc, &alpha);
+
+	dma2d_blending_data.src_address = buffer;
+	dma2d_blending_data.dest_address = LLUI_DISPLAY_getBufferAddress(dest);
+	dma2d_blending_data.src_stride = stride;
+	dma2d_blending_data.dest_stride = LLUI_DISPLAY_getStrideInPixels(dest);
+	dma2d_blending_data.dest_width = dest->width;
+	dma2d_blending_data.dest_height = dest->height;
+	dma2d_blending_data.x_src = x_src;
+	dma2d_blending_data.y_src = y_src;
+	dma2d_blending_data.width = width;
+	dma2d_blending_data.height = height;
+	dma2d_blending_data.x_dest = x;
+	dma2d_blending_data.y_dest = y;
+	dma2d_blending_data.alpha = alpha;
+	dma2d_blending_data.src_dma2d_format = ((uint32_t)4 == bpp) ? CM_A4 : CM_A8;
+	dma2d_blending_data.src_bpp = bpp;
+	dma2d_blending_data.dest_dma2d_format = DRAWING_DMA2D_FORMAT;
+	dma2d_blending_data.dest_bpp = DRAWING_DMA2D_BPP;
+	// the last job invalidates the whole region of the drawing
+	dma2d_blending_data.dest_area = g_tiles_area;
+
+	_drawing_dma2d_blending_queue(&dma2d_blending_data, last ? &LLUI_DISPLAY_notifyAsynchronousDrawingEnd : NULL);
+
+	return g_jobs_queued;
+}
 
+// See the header file for the function documentation
+uint32_t UI_DRAWING_DMA2D_fill_tile(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, bool last) {
+	// the last job invalidates the whole region of the drawing
+	_drawing_dma2d_fill_queue(gc, x1, y1, x2, y2, &g_tiles_area, last ? &LLUI_DISPLAY_notifyAsynchronousDrawingEnd : NULL);
+	return g_jobs_queued;
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_wait_job(uint32_t job) {
+	// the difference handles the counters wrap
+	while ((int32_t)(job - g_jobs_done) > 0) {
+		LLUI_DISPLAY_IMPL_binarySemaphoreTake(g_dma2d_semaphore);
+	}
+}
+
+// See the header file for the function documentation
+uint32_t UI_DRAWING_DMA2D_load_clut(uint32_t* clut, uint32_t size) {
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	// the CLUT may have just been written by the CPU
+	DRAWING_DMA2D_CACHE_area_t clut_area;
+	// cppcheck-suppress [misra-c2012-11.3] the CLUT is a buffer of bytes for the cache
+	DRAWING_DMA2D_CACHE_set_area(&clut_area, (uint8_t*)clut, 0, 0, size, 1, size, 32);
+	(void)DRAWING_DMA2D_CACHE_apply_range(&clut_area, false, UINT32_MAX);
+#endif
+
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+	job->mode = DMA2D_M2M_PFC;
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->fgcmar = (uint32_t)clut;
+	// ARGB8888 CLUT (CCM = 0)
+	job->fgpfccr = CM_L8 | ((size - (uint32_t)1) << DMA2D_FGPFCCR_CS_Pos);
+	job->fgmar = 0;
+	job->fgor = 0;
+	job->omar = 0;
+	job->oor = 0;
+	job->nlr = 0;
+	_drawing_dma2d_job_commit();
+
+	return g_jobs_queued;
+}
+
+// See the header file for the function documentation
+uint32_t UI_DRAWING_DMA2D_convert(uint8_t* src, uint32_t src_format, uint32_t src_bpp, uint8_t* dest, uint32_t dest_stride, uint32_t dest_format, uint32_t dest_bpp, jint width, jint height) {
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	// the source has just been written by the CPU (whatever the configuration of the
+	// display memory): the DMA2D must read it from the memory
+	DRAWING_DMA2D_CACHE_area_t src_area;
+	DRAWING_DMA2D_CACHE_set_area(&src_area, src, 0, 0, width, height, width, src_bpp);
+	(void)DRAWING_DMA2D_CACHE_apply_range(&src_area, false, UINT32_MAX);
+#endif
+
+	DRAWING_DMA2D_CACHE_area_t dest_area;
+	DRAWING_DMA2D_CACHE_set_area(&dest_area, dest, 0, 0, width, height, dest_stride, dest_bpp);
+	_cleanDCache(&dest_area);
+
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+	job->mode = DMA2D_M2M_PFC;
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->fgmar = (uint32_t)src;
+	job->fgor = 0;
+	// the DMA2D keeps the CLUT loaded by UI_DRAWING_DMA2D_load_clut() in its internal memory
+	job->fgpfccr = src_format;
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->omar = (uint32_t)dest;
+	job->oor = dest_stride - (uint32_t)width;
+	job->opfccr = dest_format;
+	job->nlr = ((uint32_t)width << DMA2D_NLR_PL_Pos) | (uint32_t)height;
+	_drawing_dma2d_job_commit();
+
+	return g_jobs_queued;
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_move(uint8_t* dest, uint8_t* src, uint32_t size) {
+	// the DMA2D copies pixels in the display format:
+	// lines of DRAWING_DMA2D_MOVE_LINE_SIZE pixels and then the last partial line; the
+	// last bytes are copied by the CPU
+	uint32_t pixel_size = (uint32_t)DRAWING_DMA2D_BPP / (uint32_t)8;
+	uint32_t pixels = size / pixel_size;
+	uint32_t lines = pixels / DRAWING_DMA2D_MOVE_LINE_SIZE;
+	uint32_t rest = pixels % DRAWING_DMA2D_MOVE_LINE_SIZE;
+	uint32_t copied = pixels * pixel_size;
+
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	// the images heap is cached whatever the configuration of the display memory: the
+	// DMA2D must read the source from the memory and no dirty cache line must be written
+	// back over the copy (a range operation per cache line, the blocks are one span)
+	DRAWING_DMA2D_CACHE_area_t src_area;
+	DRAWING_DMA2D_CACHE_area_t dest_area;
+	DRAWING_DMA2D_CACHE_set_area(&src_area, src, 0, 0, copied, 1, copied, 8);
+	DRAWING_DMA2D_CACHE_set_area(&dest_area, dest, 0, 0, copied, 1, copied, 8);
+	(void)DRAWING_DMA2D_CACHE_apply_range(&src_area, false, UINT32_MAX);
+	(void)DRAWING_DMA2D_CACHE_apply_range(&dest_area, true, UINT32_MAX);
+#endif
+
+	if (lines > (uint32_t)0) {
+		DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+		job->mode = DMA2D_M2M;
+		// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+		job->fgmar = (uint32_t)src;
+		job->fgor = 0;
+		job->fgpfccr = DRAWING_DMA2D_FORMAT;
+		// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+		job->omar = (uint32_t)dest;
+		job->oor = 0;
+		job->nlr = (DRAWING_DMA2D_MOVE_LINE_SIZE << DMA2D_NLR_PL_Pos) | lines;
+		_drawing_dma2d_job_commit();
+	}
+
+	if (rest > (uint32_t)0) {
+		uint32_t offset = lines * DRAWING_DMA2D_MOVE_LINE_SIZE * pixel_size;
+		DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+		job->mode = DMA2D_M2M;
+		// cppcheck-suppress [misra-c2012-11.4,misra-c2012-18.4] cast address as expected by DMA2D registers
+		job->fgmar = (uint32_t)(src + offset);
+		job->fgor = 0;
+		job->fgpfccr = DRAWING_DMA2D_FORMAT;
+		// cppcheck-suppress [misra-c2012-11.4,misra-c2012-18.4] cast address as expected by DMA2D registers
+		job->omar = (uint32_t)(dest + offset);
+		job->oor = 0;
+		job->nlr = (rest << DMA2D_NLR_PL_Pos) | (uint32_t)1;
+		_drawing_dma2d_job_commit();
+	}
+
+	UI_DRAWING_DMA2D_wait_job(g_jobs_queued);
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	// the CPU reads the moved pixels from the memory
+	(void)DRAWING_DMA2D_CACHE_apply_range(&dest_area, true, UINT32_MAX);
+#endif
+
+	for (uint32_t i = copied; i < size; i++) {
+		dest[i] = src[i];
+	}
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_copy_region(uint8_t* dest, uint32_t dest_stride, jint x_dest, jint y_dest, uint8_t* src, uint32_t src_stride, jint x_src, jint y_src, jint width, jint height) {
+	DRAWING_DMA2D_CACHE_area_t src_area;
+	DRAWING_DMA2D_CACHE_area_t dest_area;
+	DRAWING_DMA2D_CACHE_set_area(&src_area, src, x_src, y_src, width, height, src_stride, DRAWING_DMA2D_BPP);
+	DRAWING_DMA2D_CACHE_set_area(&dest_area, dest, x_dest, y_dest, width, height, dest_stride, DRAWING_DMA2D_BPP);
+	_cleanDCache(&src_area);
+	_cleanDCache(&dest_area);
+
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+	job->mode = DMA2D_M2M;
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->fgmar = (uint32_t)_drawing_dma2d_adjust_address(src, x_src, y_src, src_stride, DRAWING_DMA2D_BPP);
+	job->fgor = src_stride - (uint32_t)width;
+	job->fgpfccr = DRAWING_DMA2D_FORMAT;
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->omar = (uint32_t)_drawing_dma2d_adjust_address(dest, x_dest, y_dest, dest_stride, DRAWING_DMA2D_BPP);
+	job->oor = dest_stride - (uint32_t)width;
+	job->nlr = ((uint32_t)width << DMA2D_NLR_PL_Pos) | (uint32_t)height;
+	job->notification = &LLUI_DISPLAY_notifyAsynchronousDrawingEnd;
+	job->dest_area = dest_area;
+	_drawing_dma2d_job_commit();
+
+	return DRAWING_RUNNING;
+}
+
+// See the header file for the function documentation
+uint32_t UI_DRAWING_DMA2D_blend_layer(MICROUI_GraphicsContext* gc, uint8_t* buffer, uint32_t stride, jbyte format, jint x_src, jint y_src, jint width, jint height, jint x, jint y, jint alpha, jint color, bool last) {
+	DRAWING_DMA2D_blending_t dma2d_blending_data;
+	MICROUI_Image* dest = &gc->image;
+
+	if (MICROUI_IMAGE_FORMAT_A8 == format) {
+		// alpha contains both the global alpha and the color
+		dma2d_blending_data.alpha = (alpha << 24) | (color & 0xffffff);
+		dma2d_blending_data.src_dma2d_format = CM_A8;
+		dma2d_blending_data.src_bpp = 8;
+	}
+	else {
+		dma2d_blending_data.alpha = alpha;
+		dma2d_blending_data.src_dma2d_format = CM_ARGB4444;
+		dma2d_blending_data.src_bpp = 16;
+	}
+
+	// the layer has been drawn by the CPU and / or by the DMA2D
+	DRAWING_DMA2D_CACHE_area_t src_area;
+	DRAWING_DMA2D_CACHE_set_area(&src_area, buffer, x_src, y_src, width, height, stride, dma2d_blending_data.src_bpp);
+	_cleanDCache(&src_area);
+
+	dma2d_blending_data.src_address = buffer;
+	dma2d_blending_data.dest_address = LLUI_DISPLAY_getBufferAddress(dest);
+	dma2d_blending_data.src_stride = stride;
+	dma2d_blending_data.dest_stride = LLUI_DISPLAY_getStrideInPixels(dest);
+	dma2d_blending_data.dest_width = dest->width;
+	dma2d_blending_data.dest_height = dest->height;
+	dma2d_blending_data.x_src = x_src;
+	dma2d_blending_data.y_src = y_src;
+	dma2d_blending_data.width = width;
+	dma2d_blending_data.height = height;
+	dma2d_blending_data.x_dest = x;
+	dma2d_blending_data.y_dest = y;
+	dma2d_blending_data.dest_dma2d_format = DRAWING_DMA2D_FORMAT;
+	dma2d_blending_data.dest_bpp = DRAWING_DMA2D_BPP;
+	// the last job invalidates the whole region of the drawing
+	dma2d_blending_data.dest_area = g_tiles_area;
+
+	_drawing_dma2d_blending_queue(&dma2d_blending_data, last ? &LLUI_DISPLAY_notifyAsynchronousDrawingEnd : NULL);
+
+	return g_jobs_queued;
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_fill_layer(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, uint32_t color) {
 	uint32_t rectangle_width = x2 - x1 + 1;
 	uint32_t rectangle_height = y2 - y1 + 1;
 	uint32_t stride = LLUI_DISPLAY_getStrideInPixels(&gc->image);
+	uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(&gc->image);
 
-	// de-init DMA2D
-	HAL_DMA2D_DeInit(&g_hdma2d);
+	LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
 
-	// configure DMA2D
-	g_hdma2d.Init.Mode = DMA2D_R2M;
-	g_hdma2d.Init.OutputOffset = stride - rectangle_width;
-	HAL_DMA2D_Init(&g_hdma2d);
+	DRAWING_DMA2D_CACHE_area_t dest_area;
+	DRAWING_DMA2D_CACHE_set_area(&dest_area, buffer, x1, y1, rectangle_width, rectangle_height, stride, 16);
+	_cleanDCache(&dest_area);
+
+	DRAWING_DMA2D_job_t* job = _drawing_dma2d_job_allocate();
+	job->mode = DMA2D_R2M;
+	job->fgpfccr = 0;
+	job->fgmar = 0;
+	job->fgor = 0;
+	job->ocolr = ((color & 0xf0000000U) >> 16) | ((color & 0xf00000U) >> 12) | ((color & 0xf000U) >> 8) | ((color & 0xf0U) >> 4);
+	// cppcheck-suppress [misra-c2012-11.4] cast address as expected by DMA2D registers
+	job->omar = (uint32_t)_drawing_dma2d_adjust_address(buffer, x1, y1, stride, 16);
+	job->oor = stride - rectangle_width;
+	job->opfccr = DMA2D_ARGB4444;
+	job->nlr = (rectangle_width << DMA2D_NLR_PL_Pos) | rectangle_height;
+	job->notification = &LLUI_DISPLAY_notifyAsynchronousDrawingEnd;
+	job->dest_area = dest_area;
+	_drawing_dma2d_job_commit();
 
-	// configure environment
-	g_callback_notification = &LLUI_DISPLAY_notifyAsynchronousDrawingEnd;
-	g_dma2d_running = true;
+	return DRAWING_RUNNING;
+}
 
-	// start DMA2D
-	_cleanDCache();
-	uint8_t* destination_address = _drawing_dma2d_adjust_address(LLUI_DISPLAY_getBufferAddress(&gc->image), x1, y1, stride, DRAWING_DMA2D_BPP);
-	// cppcheck-suppress [misra-c2012-11.4] allow cast address in u32 (see HAL_DMA2D_Start_IT())
-	HAL_DMA2D_Start_IT(&g_hdma2d, gc->foreground_color, (uint32_t)destination_address, rectangle_width, rectangle_height);
+// See the header file for the function documentation
+bool UI_DRAWING_DMA2D_blend_image(MICROUI_GraphicsContext* gc, MICROUI_Image* image, jint x_src, jint y_src, jint width, jint height, jint x_dest, jint y_dest, jint alpha) {
+	DRAWING_DMA2D_blending_t dma2d_blending_data;
+	// the odd bands of the A4 images are drawn in software (display format only)
+	bool blended = (MICROUI_IMAGE_FORMAT_A4 != image->format) && _drawing_dma2d_is_image_compatible_with_dma2d(gc, image, x_src, y_src, width, height, x_dest, y_dest, alpha, &dma2d_blending_data);
+
+	if (blended) {
+		LLUI_DISPLAY_setDrawingLimits(x_dest, y_dest, x_dest + width - 1, y_dest + height - 1);
+		_drawing_dma2d_blending_queue(&dma2d_blending_data, &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
+	}
+
+	return blended;
+}
+
+// --------------------------------------------------------------------------------
+// ui_drawing.h / ui_drawing_dma2d.h functions
+// (the function names differ according to the available number of destination formats)
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_fillRectangle(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+
+	LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
+
+	DRAWING_DMA2D_CACHE_area_t dest_area;
+	DRAWING_DMA2D_CACHE_set_area(&dest_area, LLUI_DISPLAY_getBufferAddress(&gc->image), x1, y1, x2 - x1 + 1, y2 - y1 + 1, LLUI_DISPLAY_getStrideInPixels(&gc->image), DRAWING_DMA2D_BPP);
+	_cleanDCache(&dest_area);
+
+	_drawing_dma2d_fill_queue(gc, x1, y1, x2, y2, &dest_area, &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
 
 	return DRAWING_RUNNING;
 }
@@ -548,8 +1365,7 @@ DRAWING_Status UI_DRAWING_DMA2D_drawImage(MICROUI_GraphicsContext* gc, MICROUI_I
 
 	if (_drawing_dma2d_is_image_compatible_with_dma2d(gc, image, x_src, y_src, width, height, x_dest, y_dest, alpha, &dma2d_blending_data)){
 		LLUI_DISPLAY_setDrawingLimits(dma2d_blending_data.x_dest, dma2d_blending_data.y_dest, dma2d_blending_data.x_dest + dma2d_blending_data.width - 1, dma2d_blending_data.y_dest + dma2d_blending_data.height - 1);
-		_drawing_dma2d_blending_configure(&dma2d_blending_data);
-		_drawing_dma2d_blending_start(&dma2d_blending_data);
+		_drawing_dma2d_draw_image(&dma2d_blending_data);
 		ret = DRAWING_RUNNING;
 	}
 	else {
@@ -594,8 +1410,7 @@ DRAWING_Status UI_DRAWING_DMA2D_drawRegion(MICROUI_GraphicsContext* gc, jint x_s
 		}
 		else {
 			// draw source on itself applying an opacity and without overlap
-			_drawing_dma2d_blending_configure(&dma2d_blending_data);
-			_drawing_dma2d_blending_start(&dma2d_blending_data);
+			_drawing_dma2d_blending_queue(&dma2d_blending_data, &LLUI_DISPLAY_notifyAsynchronousDrawingEnd);
 		}
 		ret = DRAWING_RUNNING;
 	}
@@ -0,0 +1,189 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Benchmark of the data cache maintenance performed around the DMA2D blits.
+ * See ui_drawing_dma2d_benchmark.h.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <stdio.h>
+
+#include "ui_drawing_dma2d_benchmark.h"
+#include "ui_drawing_dma2d_configuration.h"
+#include "ui_drawing_dma2d_cache.h"
+#include "framerate_impl.h"
+
+#if defined(DRAWING_DMA2D_BENCHMARK) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Number of blits per size. The results are the averages.
+ */
+#define BENCHMARK_LOOPS (16U)
+
+/*
+ * @brief Size of the unrelated data in the cache (half of the STM32F750 data cache).
+ */
+#define BENCHMARK_HOT_DATA_SIZE (2048U)
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Cumulated results of a maintenance method.
+ */
+typedef struct {
+	uint32_t maintenance_cycles;
+	uint32_t reload_cycles;
+} benchmark_result_t;
+
+// --------------------------------------------------------------------------------
+// Private fields
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Blit sizes: icon, widget, quarter of the screen and full screen (limited
+ * to the buffers' size).
+ */
+static const uint16_t g_sizes[][2] = {
+		{ 16, 16 },
+		{ 64, 64 },
+		{ 240, 136 },
+		{ UINT16_MAX, UINT16_MAX },
+};
+
+/*
+ * @brief Unrelated data the application uses while the DMA2D draws (Java heap, network
+ * buffers, etc.).
+ */
+static volatile uint32_t g_hot_data[BENCHMARK_HOT_DATA_SIZE / sizeof(uint32_t)];
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Reads the unrelated data.
+ */
+static uint32_t _benchmark_read_hot_data(void) {
+	uint32_t sum = 0;
+	for (uint32_t i = 0; i < (BENCHMARK_HOT_DATA_SIZE / sizeof(uint32_t)); i++) {
+		sum += g_hot_data[i];
+	}
+	return sum;
+}
+
+/*
+ * @brief Simulates a software drawing in the area: the CPU writes each line.
+ */
+static void _benchmark_write_area(DRAWING_DMA2D_CACHE_area_t* area, uint8_t value) {
+	uint8_t* line = area->address;
+	for (uint32_t y = 0; y < area->height; y++) {
+		for (uint32_t x = 0; x < area->width; x++) {
+			line[x] = value;
+		}
+		// cppcheck-suppress [misra-c2012-18.4] next line
+		line += area->stride;
+	}
+}
+
+/*
+ * @brief Performs the maintenance of one blit and the reading of the unrelated data,
+ * and cumulates the cycles.
+ */
+static void _benchmark_blit(DRAWING_DMA2D_CACHE_area_t* src_area, DRAWING_DMA2D_CACHE_area_t* dest_area, bool ranged, benchmark_result_t* result) {
+	// the CPU has drawn in the source and uses the unrelated data
+	_benchmark_write_area(src_area, (uint8_t)result->maintenance_cycles);
+	(void)_benchmark_read_hot_data();
+
+	uint32_t t0 = framerate_impl_get_cycles();
+	if (ranged) {
+		// before the blit
+		(void)DRAWING_DMA2D_CACHE_apply_range(src_area, false, UINT32_MAX);
+		(void)DRAWING_DMA2D_CACHE_apply_range(dest_area, false, UINT32_MAX);
+		// after the blit
+		(void)DRAWING_DMA2D_CACHE_apply_range(dest_area, true, UINT32_MAX);
+	}
+	else {
+		// before the blit
+		SCB_CleanDCache();
+		// after the blit
+		SCB_CleanInvalidateDCache();
+	}
+	uint32_t t1 = framerate_impl_get_cycles();
+	(void)_benchmark_read_hot_data();
+	uint32_t t2 = framerate_impl_get_cycles();
+
+	result->maintenance_cycles += t1 - t0;
+	result->reload_cycles += t2 - t1;
+}
+
+// --------------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_BENCHMARK_run(uint8_t* src, uint8_t* dest, uint32_t width, uint32_t height) {
+	printf("DMA2D cache maintenance benchmark (cycles per blit, %u blits per size)\n", (unsigned int)BENCHMARK_LOOPS);
+
+	for (uint32_t s = 0; s < (sizeof(g_sizes) / sizeof(g_sizes[0])); s++) {
+		uint32_t blit_width = (g_sizes[s][0] < width) ? g_sizes[s][0] : width;
+		uint32_t blit_height = (g_sizes[s][1] < height) ? g_sizes[s][1] : height;
+
+		// blit at the middle of the buffers (lines not aligned on cache lines)
+		uint32_t x = (width - blit_width) / (uint32_t)2;
+		uint32_t y = (height - blit_height) / (uint32_t)2;
+		DRAWING_DMA2D_CACHE_area_t src_area;
+		DRAWING_DMA2D_CACHE_area_t dest_area;
+		DRAWING_DMA2D_CACHE_set_area(&src_area, src, x, y, blit_width, blit_height, width, DRAWING_DMA2D_BPP);
+		DRAWING_DMA2D_CACHE_set_area(&dest_area, dest, x, y, blit_width, blit_height, width, DRAWING_DMA2D_BPP);
+
+		benchmark_result_t whole = { 0, 0 };
+		benchmark_result_t ranged = { 0, 0 };
+		for (uint32_t i = 0; i < BENCHMARK_LOOPS; i++) {
+			_benchmark_blit(&src_area, &dest_area, false, &whole);
+			_benchmark_blit(&src_area, &dest_area, true, &ranged);
+		}
+
+		uint32_t span_lines;
+		uint32_t line_lines = DRAWING_DMA2D_CACHE_get_lines(&dest_area, &span_lines);
+		printf("%ux%u: whole cache %u (hot data reload %u), ranged %u (hot data reload %u), %u cache line operations per rectangle\n",
+				(unsigned int)blit_width, (unsigned int)blit_height,
+				(unsigned int)(whole.maintenance_cycles / BENCHMARK_LOOPS), (unsigned int)(whole.reload_cycles / BENCHMARK_LOOPS),
+				(unsigned int)(ranged.maintenance_cycles / BENCHMARK_LOOPS), (unsigned int)(ranged.reload_cycles / BENCHMARK_LOOPS),
+				(unsigned int)((span_lines < line_lines) ? span_lines : line_lines));
+	}
+}
+
+#else
+
+// See the header file for the function documentation
+void UI_DRAWING_DMA2D_BENCHMARK_run(uint8_t* src, uint8_t* dest, uint32_t width, uint32_t height) {
+	// benchmark disabled or MCU without data cache
+	(void)src;
+	(void)dest;
+	(void)width;
+	(void)height;
+}
+
+#endif // defined(DRAWING_DMA2D_BENCHMARK) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
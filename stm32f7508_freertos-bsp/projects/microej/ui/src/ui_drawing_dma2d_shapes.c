@@ -0,0 +1,306 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the ui_drawing.h filled rounded rectangle, circle and ellipse
+ * drawings over the STM32 DMA2D (ChromART).
+ *
+ * A shape is split in rectangles fully inside the shape (the interior) and in edge
+ * rectangles holding the curved edges:
+ * - rounded rectangle: the middle band and the top and bottom bands between the corners
+ *   are filled by the DMA2D, the four corners are drawn in software;
+ * - circle and ellipse: the inscribed rectangle is filled by the DMA2D, the four bands
+ *   around it are drawn in software.
+ *
+ * The edges are drawn by the software drawer, the clip being reduced to each edge
+ * rectangle: the pixels are exactly the ones of the software drawing of the whole shape.
+ * The edges are drawn before queuing the DMA2D fills (the DMA2D region is cleaned in the
+ * data cache after the software drawings). The interior rectangles keep a safety margin
+ * of one pixel with the shape's edges.
+ *
+ * The shapes whose interior is smaller than DRAWING_DMA2D_SHAPES_MIN_PIXELS are drawn in
+ * software only.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include "ui_drawing_dma2d.h"
+#include "ui_drawing_dma2d_configuration.h"
+#include "ui_drawing_soft.h"
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Maximum number of interior and edge rectangles of a shape.
+ */
+#define SHAPES_MAX_INTERIOR (3U)
+#define SHAPES_MAX_EDGES (4U)
+
+/*
+ * @brief Half side of the rectangle inscribed in an ellipse, for a diameter of 512
+ * pixels: 512 / (2 * sqrt(2)).
+ */
+#define SHAPES_INSCRIBED_FACTOR (181)
+#define SHAPES_INSCRIBED_SHIFT (9)
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief A rectangle (coordinates included).
+ */
+typedef struct {
+	jint x1;
+	jint y1;
+	jint x2;
+	jint y2;
+} shapes_rect_t;
+
+struct shapes_shape;
+
+/*
+ * @brief Draws the whole shape in software (in the current clip).
+ */
+typedef DRAWING_Status (*t_shapes_soft_fill)(MICROUI_GraphicsContext* gc, const struct shapes_shape* shape);
+
+/*
+ * @brief A shape and its decomposition.
+ */
+typedef struct shapes_shape {
+	jint x;
+	jint y;
+	jint width;
+	jint height;
+	jint corner_width; // rounded rectangle only
+	jint corner_height; // rounded rectangle only
+	t_shapes_soft_fill soft_fill;
+	shapes_rect_t interior[SHAPES_MAX_INTERIOR];
+	uint32_t interior_count;
+	shapes_rect_t edges[SHAPES_MAX_EDGES];
+	uint32_t edges_count;
+} shapes_shape_t;
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Intersects two rectangles.
+ *
+ * @return false when the intersection is empty.
+ */
+static bool _shapes_intersect(const shapes_rect_t* a, const shapes_rect_t* b, shapes_rect_t* intersection) {
+	intersection->x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+	intersection->y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+	intersection->x2 = (a->x2 < b->x2) ? a->x2 : b->x2;
+	intersection->y2 = (a->y2 < b->y2) ? a->y2 : b->y2;
+	return (intersection->x1 <= intersection->x2) && (intersection->y1 <= intersection->y2);
+}
+
+/*
+ * @brief Adds a rectangle to a list.
+ */
+static inline void _shapes_add(shapes_rect_t* list, uint32_t* count, jint x1, jint y1, jint x2, jint y2) {
+	shapes_rect_t* rect = &list[*count];
+	rect->x1 = x1;
+	rect->y1 = y1;
+	rect->x2 = x2;
+	rect->y2 = y2;
+	(*count)++;
+}
+
+static DRAWING_Status _shapes_soft_fill_rounded_rectangle(MICROUI_GraphicsContext* gc, const shapes_shape_t* shape) {
+	return UI_DRAWING_SOFT_fillRoundedRectangle(gc, shape->x, shape->y, shape->width, shape->height, shape->corner_width, shape->corner_height);
+}
+
+static DRAWING_Status _shapes_soft_fill_ellipse(MICROUI_GraphicsContext* gc, const shapes_shape_t* shape) {
+	return UI_DRAWING_SOFT_fillEllipse(gc, shape->x, shape->y, shape->width, shape->height);
+}
+
+static DRAWING_Status _shapes_soft_fill_circle(MICROUI_GraphicsContext* gc, const shapes_shape_t* shape) {
+	return UI_DRAWING_SOFT_fillCircle(gc, shape->x, shape->y, shape->width);
+}
+
+/*
+ * @brief Draws a shape: the edges in software and the interior with the DMA2D.
+ */
+static DRAWING_Status _shapes_fill(MICROUI_GraphicsContext* gc, const shapes_shape_t* shape) {
+	DRAWING_Status status;
+	shapes_rect_t clip = { gc->clip_x1, gc->clip_y1, gc->clip_x2, gc->clip_y2 };
+	shapes_rect_t fills[SHAPES_MAX_INTERIOR];
+	uint32_t fills_count = 0;
+	uint32_t pixels = 0;
+
+	for (uint32_t i = 0; i < shape->interior_count; i++) {
+		shapes_rect_t* fill = &fills[fills_count];
+		if (_shapes_intersect(&shape->interior[i], &clip, fill)) {
+			pixels += (uint32_t)((fill->x2 - fill->x1) + 1) * (uint32_t)((fill->y2 - fill->y1) + 1);
+			fills_count++;
+		}
+	}
+
+	if (pixels < DRAWING_DMA2D_SHAPES_MIN_PIXELS) {
+		status = shape->soft_fill(gc, shape);
+	}
+	else {
+		bool clip_enabled = LLUI_DISPLAY_isClipEnabled(gc);
+		jint flags = gc->drawing_log_flags;
+		shapes_rect_t bounds = { shape->x, shape->y, (shape->x + shape->width) - 1, (shape->y + shape->height) - 1 };
+		shapes_rect_t region;
+
+		// the software draws the edges first
+		for (uint32_t i = 0; i < shape->edges_count; i++) {
+			if (_shapes_intersect(&shape->edges[i], &clip, &region)) {
+				LLUI_DISPLAY_setClip(gc, region.x1, region.y1, (region.x2 - region.x1) + 1, (region.y2 - region.y1) + 1);
+				LLUI_DISPLAY_configureClip(gc, true);
+				(void)shape->soft_fill(gc, shape);
+			}
+		}
+
+		// restore the clip; the application's clip has not changed
+		LLUI_DISPLAY_setClip(gc, clip.x1, clip.y1, (clip.x2 - clip.x1) + 1, (clip.y2 - clip.y1) + 1);
+		LLUI_DISPLAY_configureClip(gc, clip_enabled);
+		if (0 == (flags & DRAWING_LOG_CLIP_MODIFIED)) {
+			gc->drawing_log_flags &= ~DRAWING_LOG_CLIP_MODIFIED;
+		}
+
+		// the interior is filled by the DMA2D (the region is cleaned after the software drawings)
+		(void)_shapes_intersect(&bounds, &clip, &region);
+		UI_DRAWING_DMA2D_start_tiles(gc, region.x1, region.y1, region.x2, region.y2);
+		for (uint32_t i = 0; i < fills_count; i++) {
+			(void)UI_DRAWING_DMA2D_fill_tile(gc, fills[i].x1, fills[i].y1, fills[i].x2, fills[i].y2, i == (fills_count - (uint32_t)1));
+		}
+		status = DRAWING_RUNNING;
+	}
+
+	return status;
+}
+
+/*
+ * @brief Splits an ellipse: the inscribed rectangle and the four bands around it.
+ */
+static DRAWING_Status _shapes_fill_ellipse(MICROUI_GraphicsContext* gc, shapes_shape_t* shape) {
+	DRAWING_Status status;
+	jint x = shape->x;
+	jint y = shape->y;
+	jint x2 = (x + shape->width) - 1;
+	jint y2 = (y + shape->height) - 1;
+	// half sides of the inscribed rectangle, minus the safety pixel
+	jint half_width = ((shape->width * SHAPES_INSCRIBED_FACTOR) >> SHAPES_INSCRIBED_SHIFT) - 1;
+	jint half_height = ((shape->height * SHAPES_INSCRIBED_FACTOR) >> SHAPES_INSCRIBED_SHIFT) - 1;
+
+	if ((half_width > 0) && (half_height > 0)) {
+		// around the center (between two pixels when the size is even)
+		jint ix1 = (x + (shape->width / 2)) - half_width;
+		jint ix2 = x + ((shape->width - 1) / 2) + half_width;
+		jint iy1 = (y + (shape->height / 2)) - half_height;
+		jint iy2 = y + ((shape->height - 1) / 2) + half_height;
+
+		_shapes_add(shape->interior, &shape->interior_count, ix1, iy1, ix2, iy2);
+		_shapes_add(shape->edges, &shape->edges_count, x, y, x2, iy1 - 1);
+		_shapes_add(shape->edges, &shape->edges_count, x, iy2 + 1, x2, y2);
+		_shapes_add(shape->edges, &shape->edges_count, x, iy1, ix1 - 1, iy2);
+		_shapes_add(shape->edges, &shape->edges_count, ix2 + 1, iy1, x2, iy2);
+		status = _shapes_fill(gc, shape);
+	}
+	else {
+		status = shape->soft_fill(gc, shape);
+	}
+
+	return status;
+}
+
+// --------------------------------------------------------------------------------
+// ui_drawing.h functions
+// (the function names differ according to the available number of destination formats)
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_fillRoundedRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight) {
+	DRAWING_Status status;
+	shapes_shape_t shape;
+	jint x2 = (x + width) - 1;
+	jint y2 = (y + height) - 1;
+	// size of the corners: the radius of the corner ellipse plus the safety pixel
+	jint corner_width = ((cornerEllipseWidth > 0) ? ((cornerEllipseWidth + 1) / 2) : 0) + 1;
+	jint corner_height = ((cornerEllipseHeight > 0) ? ((cornerEllipseHeight + 1) / 2) : 0) + 1;
+
+	shape.x = x;
+	shape.y = y;
+	shape.width = width;
+	shape.height = height;
+	shape.corner_width = cornerEllipseWidth;
+	shape.corner_height = cornerEllipseHeight;
+	shape.soft_fill = &_shapes_soft_fill_rounded_rectangle;
+	shape.interior_count = 0;
+	shape.edges_count = 0;
+
+	if ((2 * corner_height) < height) {
+		// the middle band has the full width
+		_shapes_add(shape.interior, &shape.interior_count, x, y + corner_height, x2, y2 - corner_height);
+
+		if ((2 * corner_width) < width) {
+			// top and bottom bands between the corners
+			_shapes_add(shape.interior, &shape.interior_count, x + corner_width, y, x2 - corner_width, (y + corner_height) - 1);
+			_shapes_add(shape.interior, &shape.interior_count, x + corner_width, (y2 - corner_height) + 1, x2 - corner_width, y2);
+			_shapes_add(shape.edges, &shape.edges_count, x, y, (x + corner_width) - 1, (y + corner_height) - 1);
+			_shapes_add(shape.edges, &shape.edges_count, (x2 - corner_width) + 1, y, x2, (y + corner_height) - 1);
+			_shapes_add(shape.edges, &shape.edges_count, x, (y2 - corner_height) + 1, (x + corner_width) - 1, y2);
+			_shapes_add(shape.edges, &shape.edges_count, (x2 - corner_width) + 1, (y2 - corner_height) + 1, x2, y2);
+		}
+		else {
+			// the corners join: top and bottom bands
+			_shapes_add(shape.edges, &shape.edges_count, x, y, x2, (y + corner_height) - 1);
+			_shapes_add(shape.edges, &shape.edges_count, x, (y2 - corner_height) + 1, x2, y2);
+		}
+		status = _shapes_fill(gc, &shape);
+	}
+	else {
+		status = UI_DRAWING_SOFT_fillRoundedRectangle(gc, x, y, width, height, cornerEllipseWidth, cornerEllipseHeight);
+	}
+
+	return status;
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_fillEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
+	shapes_shape_t shape;
+	shape.x = x;
+	shape.y = y;
+	shape.width = width;
+	shape.height = height;
+	shape.soft_fill = &_shapes_soft_fill_ellipse;
+	shape.interior_count = 0;
+	shape.edges_count = 0;
+	return _shapes_fill_ellipse(gc, &shape);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_fillCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter) {
+	shapes_shape_t shape;
+	shape.x = x;
+	shape.y = y;
+	shape.width = diameter;
+	shape.height = diameter;
+	shape.soft_fill = &_shapes_soft_fill_circle;
+	shape.interior_count = 0;
+	shape.edges_count = 0;
+	return _shapes_fill_ellipse(gc, &shape);
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
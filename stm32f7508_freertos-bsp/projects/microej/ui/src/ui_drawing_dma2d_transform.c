@@ -0,0 +1,519 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the ui_drawing.h scaled and rotated image drawings over the
+ * STM32 DMA2D (ChromART).
+ *
+ * The DMA2D can neither scale nor rotate: the CPU samples the source image (nearest
+ * neighbor or bilinear) into a small ARGB8888 tile and the DMA2D blends the tile into
+ * the destination, applying the opacity. Two tiles are used alternately: the CPU samples
+ * a tile while the DMA2D blends the other one. The tiles of a rotated image that are
+ * fully transparent are not blended.
+ *
+ * When the image cannot be drawn this way (custom format, image drawn in itself), the
+ * software implementation is used instead.
+ *
+ * This file is not placed in ITCM like ui_drawing_dma2d.c (see the linker file): the
+ * sampling code is larger than the DMA2D driver.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <math.h>
+
+#include "ui_drawing_dma2d.h"
+#include "ui_drawing_dma2d_configuration.h"
+#include "dw_drawing_soft.h"
+#include "ui_image_drawing.h"
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief The coordinates in the source image are fixed-point numbers (16.16).
+ */
+#define TRANSFORM_FIXED_SHIFT (16)
+#define TRANSFORM_FIXED_ONE ((int32_t)1 << TRANSFORM_FIXED_SHIFT)
+#define TRANSFORM_FIXED_HALF (TRANSFORM_FIXED_ONE / 2)
+
+/*
+ * @brief The bilinear weights are 8-bit numbers.
+ */
+#define TRANSFORM_WEIGHT_SHIFT (8)
+#define TRANSFORM_WEIGHT_ONE ((uint32_t)1 << TRANSFORM_WEIGHT_SHIFT)
+
+/*
+ * @brief Number of tiles the CPU and the DMA2D use alternately.
+ */
+#define TRANSFORM_TILES (2U)
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+struct DRAWING_DMA2D_transform;
+
+/*
+ * @brief Reads a pixel of the source image and converts it in ARGB8888.
+ */
+typedef uint32_t (*t_transform_read)(const struct DRAWING_DMA2D_transform* transform, int32_t x, int32_t y);
+
+/*
+ * @brief The source image and the inverse transformation: a destination pixel (X,Y)
+ * samples the source image at (u0 + X * du_dx + Y * du_dy, v0 + X * dv_dx + Y * dv_dy).
+ */
+typedef struct DRAWING_DMA2D_transform {
+	uint8_t* address; // source image's address
+	uint32_t stride; // source image's stride in pixels
+	int32_t width; // source image's width
+	int32_t height; // source image's height
+	uint32_t color; // color of the A4 and A8 images
+	t_transform_read read; // reads a pixel according to the image's format
+	bool bilinear; // bilinear or nearest neighbor sampling
+	bool clamp; // outside the image: nearest edge pixel (scaling) or transparent pixel (rotation)
+	float u0; // source X coordinate of the destination pixel (0,0)
+	float v0; // source Y coordinate of the destination pixel (0,0)
+	float du_dx;
+	float dv_dx;
+	float du_dy;
+	float dv_dy;
+} DRAWING_DMA2D_transform_t;
+
+// --------------------------------------------------------------------------------
+// Private fields
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief The tiles: they are read by the DMA2D and aligned on the data cache lines.
+ */
+static uint32_t g_tiles[TRANSFORM_TILES][DRAWING_DMA2D_TRANSFORM_TILE_PIXELS] __ALIGNED(32);
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+static uint32_t _transform_read_argb8888(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	// cppcheck-suppress [misra-c2012-11.3] the image's buffer holds 32-bit pixels
+	const uint32_t* pixels = (const uint32_t*)transform->address;
+	return pixels[((uint32_t)y * transform->stride) + (uint32_t)x];
+}
+
+static uint32_t _transform_read_rgb888(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	const uint8_t* pixel = &transform->address[(((uint32_t)y * transform->stride) + (uint32_t)x) * (uint32_t)3];
+	return 0xff000000U | ((uint32_t)pixel[2] << 16) | ((uint32_t)pixel[1] << 8) | (uint32_t)pixel[0];
+}
+
+static uint32_t _transform_read_rgb565(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	// cppcheck-suppress [misra-c2012-11.3] the image's buffer holds 16-bit pixels
+	uint32_t c = ((const uint16_t*)transform->address)[((uint32_t)y * transform->stride) + (uint32_t)x];
+	uint32_t r = (c >> 11) & 0x1fU;
+	uint32_t g = (c >> 5) & 0x3fU;
+	uint32_t b = c & 0x1fU;
+	return 0xff000000U | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+static uint32_t _transform_read_argb1555(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	// cppcheck-suppress [misra-c2012-11.3] the image's buffer holds 16-bit pixels
+	uint32_t c = ((const uint16_t*)transform->address)[((uint32_t)y * transform->stride) + (uint32_t)x];
+	uint32_t a = ((c & 0x8000U) != 0U) ? 0xffU : 0U;
+	uint32_t r = (c >> 10) & 0x1fU;
+	uint32_t g = (c >> 5) & 0x1fU;
+	uint32_t b = c & 0x1fU;
+	return (a << 24) | (((r << 3) | (r >> 2)) << 16) | (((g << 3) | (g >> 2)) << 8) | ((b << 3) | (b >> 2));
+}
+
+static uint32_t _transform_read_argb4444(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	// cppcheck-suppress [misra-c2012-11.3] the image's buffer holds 16-bit pixels
+	uint32_t c = ((const uint16_t*)transform->address)[((uint32_t)y * transform->stride) + (uint32_t)x];
+	// 0xN -> 0xNN
+	return (((c >> 12) & 0xfU) * 0x11000000U) | (((c >> 8) & 0xfU) * 0x110000U) | (((c >> 4) & 0xfU) * 0x1100U) | ((c & 0xfU) * 0x11U);
+}
+
+static uint32_t _transform_read_a8(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	return ((uint32_t)transform->address[((uint32_t)y * transform->stride) + (uint32_t)x] << 24) | transform->color;
+}
+
+static uint32_t _transform_read_a4(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	uint32_t index = ((uint32_t)y * transform->stride) + (uint32_t)x;
+	// first pixel in the low nibble (same order as the DMA2D)
+	uint32_t a = ((uint32_t)transform->address[index / (uint32_t)2] >> ((index & 1U) * (uint32_t)4)) & 0xfU;
+	return ((a * (uint32_t)0x11) << 24) | transform->color;
+}
+
+/*
+ * @brief Gets the function that reads the pixels of the image.
+ *
+ * @return NULL when the image format is not supported.
+ */
+static t_transform_read _transform_get_reader(MICROUI_Image* img) {
+	t_transform_read read;
+	switch (img->format) {
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+		read = &_transform_read_argb8888;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		read = &_transform_read_rgb888;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		read = &_transform_read_rgb565;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+		read = &_transform_read_argb1555;
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+		read = &_transform_read_argb4444;
+		break;
+	case MICROUI_IMAGE_FORMAT_A8:
+		read = &_transform_read_a8;
+		break;
+	case MICROUI_IMAGE_FORMAT_A4:
+		read = &_transform_read_a4;
+		break;
+	default:
+		// custom format: let the image drawer do the drawing
+		read = NULL;
+		break;
+	}
+	return read;
+}
+
+/*
+ * @brief Initializes the transformation's source image.
+ *
+ * @return false when the DMA2D cannot be used.
+ */
+static bool _transform_initialize(DRAWING_DMA2D_transform_t* transform, MICROUI_GraphicsContext* gc, MICROUI_Image* img, bool bilinear) {
+	transform->read = _transform_get_reader(img);
+	transform->address = LLUI_DISPLAY_getBufferAddress(img);
+	transform->stride = LLUI_DISPLAY_getStrideInPixels(img);
+	transform->width = (int32_t)img->width;
+	transform->height = (int32_t)img->height;
+	transform->color = gc->foreground_color & 0xffffffU;
+	transform->bilinear = bilinear;
+	// the image must not change while it is drawn in several tiles
+	return (NULL != transform->read) && (img != &gc->image);
+}
+
+/*
+ * @brief Reads a pixel which may be outside the image (bilinear sampling).
+ */
+static inline uint32_t _transform_read_edge(const DRAWING_DMA2D_transform_t* transform, int32_t x, int32_t y) {
+	int32_t cx = (x < 0) ? 0 : ((x >= transform->width) ? (transform->width - 1) : x);
+	int32_t cy = (y < 0) ? 0 : ((y >= transform->height) ? (transform->height - 1) : y);
+	uint32_t pixel = transform->read(transform, cx, cy);
+	if (!transform->clamp && ((cx != x) || (cy != y))) {
+		// keep the color of the edge to not darken the antialiased border
+		pixel &= 0xffffffU;
+	}
+	return pixel;
+}
+
+/*
+ * @brief Interpolates two ARGB8888 pixels (two channels at once).
+ */
+static inline uint32_t _transform_interpolate(uint32_t p0, uint32_t p1, uint32_t weight) {
+	uint32_t w0 = TRANSFORM_WEIGHT_ONE - weight;
+	uint32_t rb = ((((p0 & 0xff00ffU) * w0) + ((p1 & 0xff00ffU) * weight)) >> TRANSFORM_WEIGHT_SHIFT) & 0xff00ffU;
+	uint32_t ag = ((((p0 >> 8) & 0xff00ffU) * w0) + (((p1 >> 8) & 0xff00ffU) * weight)) & 0xff00ff00U;
+	return ag | rb;
+}
+
+/*
+ * @brief Floor of a 16.16 fixed-point number.
+ */
+static inline int32_t _transform_floor(int32_t value) {
+	return (value >= 0) ? (value >> TRANSFORM_FIXED_SHIFT) : -(((-value) + (TRANSFORM_FIXED_ONE - 1)) >> TRANSFORM_FIXED_SHIFT);
+}
+
+/*
+ * @brief Samples the source image at a 16.16 position (the centers of the pixels are at +0.5).
+ */
+static inline uint32_t _transform_sample(const DRAWING_DMA2D_transform_t* transform, int32_t u, int32_t v) {
+	uint32_t pixel;
+
+	if (!transform->bilinear) {
+		int32_t x = _transform_floor(u);
+		int32_t y = _transform_floor(v);
+		if ((x >= 0) && (y >= 0) && (x < transform->width) && (y < transform->height)) {
+			pixel = transform->read(transform, x, y);
+		}
+		else if (transform->clamp) {
+			pixel = _transform_read_edge(transform, x, y);
+		}
+		else {
+			pixel = 0;
+		}
+	}
+	else {
+		// interpolate the four pixels around the position
+		int32_t us = u - TRANSFORM_FIXED_HALF;
+		int32_t vs = v - TRANSFORM_FIXED_HALF;
+		int32_t x = _transform_floor(us);
+		int32_t y = _transform_floor(vs);
+
+		if ((x < -1) || (y < -1) || (x >= transform->width) || (y >= transform->height)) {
+			// the four pixels are outside the image
+			pixel = transform->clamp ? _transform_read_edge(transform, x, y) : 0U;
+		}
+		else {
+			uint32_t wx = ((uint32_t)(us - (x * TRANSFORM_FIXED_ONE))) >> (TRANSFORM_FIXED_SHIFT - TRANSFORM_WEIGHT_SHIFT);
+			uint32_t wy = ((uint32_t)(vs - (y * TRANSFORM_FIXED_ONE))) >> (TRANSFORM_FIXED_SHIFT - TRANSFORM_WEIGHT_SHIFT);
+			uint32_t top;
+			uint32_t bottom;
+			if ((x >= 0) && (y >= 0) && (x < (transform->width - 1)) && (y < (transform->height - 1))) {
+				// fast path: inside the image
+				top = _transform_interpolate(transform->read(transform, x, y), transform->read(transform, x + 1, y), wx);
+				bottom = _transform_interpolate(transform->read(transform, x, y + 1), transform->read(transform, x + 1, y + 1), wx);
+			}
+			else {
+				top = _transform_interpolate(_transform_read_edge(transform, x, y), _transform_read_edge(transform, x + 1, y), wx);
+				bottom = _transform_interpolate(_transform_read_edge(transform, x, y + 1), _transform_read_edge(transform, x + 1, y + 1), wx);
+			}
+			pixel = _transform_interpolate(top, bottom, wy);
+		}
+	}
+
+	return pixel;
+}
+
+/*
+ * @brief Converts a source coordinate in a 16.16 fixed-point number.
+ */
+static inline int32_t _transform_to_fixed(float value) {
+	return (int32_t)(value * (float)TRANSFORM_FIXED_ONE);
+}
+
+/*
+ * @brief Samples a tile.
+ *
+ * @return false when all the pixels of the tile are transparent.
+ */
+static bool _transform_fill_tile(const DRAWING_DMA2D_transform_t* transform, uint32_t* tile, int32_t x, int32_t y, int32_t width, int32_t height) {
+	int32_t du = _transform_to_fixed(transform->du_dx);
+	int32_t dv = _transform_to_fixed(transform->dv_dx);
+	uint32_t opacity = 0;
+	uint32_t* pixel = tile;
+
+	for (int32_t j = 0; j < height; j++) {
+		// compute the start of each line in floating point to not cumulate the errors
+		float line = (float)(y + j);
+		int32_t u = _transform_to_fixed(transform->u0 + ((float)x * transform->du_dx) + (line * transform->du_dy));
+		int32_t v = _transform_to_fixed(transform->v0 + ((float)x * transform->dv_dx) + (line * transform->dv_dy));
+		for (int32_t i = 0; i < width; i++) {
+			uint32_t p = _transform_sample(transform, u, v);
+			opacity |= p;
+			*pixel = p;
+			// cppcheck-suppress [misra-c2012-18.4] next pixel
+			pixel++;
+			u += du;
+			v += dv;
+		}
+	}
+
+	return (opacity >> 24) != 0U;
+}
+
+/*
+ * @brief Draws the region (x1,y1)-(x2,y2) of the destination tile per tile. The CPU
+ * samples a tile while the DMA2D blends the previous one.
+ *
+ * @return the drawing status.
+ */
+static DRAWING_Status _transform_draw(MICROUI_GraphicsContext* gc, DRAWING_DMA2D_transform_t* transform, jint x1, jint y1, jint x2, jint y2, jint alpha) {
+	DRAWING_Status ret = DRAWING_DONE;
+
+	// clip the region
+	jint cx1 = (x1 > gc->clip_x1) ? x1 : gc->clip_x1;
+	jint cy1 = (y1 > gc->clip_y1) ? y1 : gc->clip_y1;
+	jint cx2 = (x2 < gc->clip_x2) ? x2 : gc->clip_x2;
+	jint cy2 = (y2 < gc->clip_y2) ? y2 : gc->clip_y2;
+
+	if ((cx1 <= cx2) && (cy1 <= cy2)) {
+		jint region_width = cx2 - cx1 + 1;
+		jint tile_width = (region_width < (jint)DRAWING_DMA2D_TRANSFORM_TILE_PIXELS) ? region_width : (jint)DRAWING_DMA2D_TRANSFORM_TILE_PIXELS;
+		jint tile_height = (jint)DRAWING_DMA2D_TRANSFORM_TILE_PIXELS / tile_width;
+		uint32_t tile_jobs[TRANSFORM_TILES] = { 0U, 0U };
+		bool tile_busy[TRANSFORM_TILES] = { false, false };
+		uint32_t tile_index = 0;
+
+		UI_DRAWING_DMA2D_start_tiles(gc, cx1, cy1, cx2, cy2);
+
+		for (jint y = cy1; y <= cy2; y += tile_height) {
+			jint height = ((cy2 - y + 1) < tile_height) ? (cy2 - y + 1) : tile_height;
+			for (jint x = cx1; x <= cx2; x += tile_width) {
+				jint width = ((cx2 - x + 1) < tile_width) ? (cx2 - x + 1) : tile_width;
+				bool last = ((y + height) > cy2) && ((x + width) > cx2);
+				uint32_t* tile = g_tiles[tile_index];
+
+				if (tile_busy[tile_index]) {
+					// the DMA2D may still read this tile
+					UI_DRAWING_DMA2D_wait_job(tile_jobs[tile_index]);
+				}
+
+				// the last tile is always blended: it notifies the end of the drawing
+				if (_transform_fill_tile(transform, tile, x, y, width, height) || last) {
+					tile_jobs[tile_index] = UI_DRAWING_DMA2D_blend_tile(gc, tile, x, y, width, height, alpha, last);
+					tile_busy[tile_index] = true;
+					tile_index = (tile_index + 1U) % TRANSFORM_TILES;
+				}
+			}
+		}
+		ret = DRAWING_RUNNING;
+	}
+
+	return ret;
+}
+
+/*
+ * @brief Draws a scaled image: the destination pixel (X,Y) samples the image at
+ * ((X + 0.5 - x) / factorX, (Y + 0.5 - y) / factorY).
+ */
+static DRAWING_Status _transform_draw_scaled(MICROUI_GraphicsContext* gc, DRAWING_DMA2D_transform_t* transform, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
+	jint width = (jint)((float)transform->width * factorX);
+	jint height = (jint)((float)transform->height * factorY);
+
+	transform->clamp = true;
+	transform->du_dx = 1.f / factorX;
+	transform->dv_dx = 0.f;
+	transform->du_dy = 0.f;
+	transform->dv_dy = 1.f / factorY;
+	transform->u0 = (0.5f - (float)x) * transform->du_dx;
+	transform->v0 = (0.5f - (float)y) * transform->dv_dy;
+
+	return _transform_draw(gc, transform, x, y, x + width - 1, y + height - 1, alpha);
+}
+
+/*
+ * @brief Draws a rotated image. The angle is in degrees, counter-clockwise on the display.
+ * The image pixel (a,b) is drawn at the rotation of (x + a, y + b) around (rotationX, rotationY).
+ */
+static DRAWING_Status _transform_draw_rotated(MICROUI_GraphicsContext* gc, DRAWING_DMA2D_transform_t* transform, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
+	float radians = angle * (3.14159265f / 180.f);
+	float cos_a = cosf(radians);
+	float sin_a = sinf(radians);
+	float rx = (float)rotationX;
+	float ry = (float)rotationY;
+
+	// destination bounds: rotation of the image's corners
+	float xmin = (float)INT16_MAX;
+	float ymin = (float)INT16_MAX;
+	float xmax = (float)INT16_MIN;
+	float ymax = (float)INT16_MIN;
+	for (uint32_t corner = 0; corner < 4U; corner++) {
+		float dx = (float)(x + (((corner & 1U) != 0U) ? transform->width : 0)) - rx;
+		float dy = (float)(y + (((corner & 2U) != 0U) ? transform->height : 0)) - ry;
+		float px = rx + (dx * cos_a) + (dy * sin_a);
+		float py = ry - (dx * sin_a) + (dy * cos_a);
+		xmin = (px < xmin) ? px : xmin;
+		xmax = (px > xmax) ? px : xmax;
+		ymin = (py < ymin) ? py : ymin;
+		ymax = (py > ymax) ? py : ymax;
+	}
+
+	// inverse rotation: the destination pixel (X,Y) samples the image at
+	// (cos * (X + 0.5 - rx) - sin * (Y + 0.5 - ry) + rx - x, sin * (X + 0.5 - rx) + cos * (Y + 0.5 - ry) + ry - y)
+	transform->clamp = false;
+	transform->du_dx = cos_a;
+	transform->dv_dx = sin_a;
+	transform->du_dy = -sin_a;
+	transform->dv_dy = cos_a;
+	transform->u0 = (cos_a * (0.5f - rx)) - (sin_a * (0.5f - ry)) + rx - (float)x;
+	transform->v0 = (sin_a * (0.5f - rx)) + (cos_a * (0.5f - ry)) + ry - (float)y;
+
+	// the bilinear sampling draws the pixels whose center is less than half a pixel outside the image
+	jint margin = transform->bilinear ? 1 : 0;
+	return _transform_draw(gc, transform, (jint)floorf(xmin) - margin, (jint)floorf(ymin) - margin, (jint)ceilf(xmax), (jint)ceilf(ymax), alpha);
+}
+
+// --------------------------------------------------------------------------------
+// ui_drawing.h / ui_drawing_dma2d.h functions
+// (the function names differ according to the available number of destination formats)
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_drawRotatedImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
+	DRAWING_Status ret;
+	DRAWING_DMA2D_transform_t transform;
+
+	if (_transform_initialize(&transform, gc, img, false)) {
+		ret = _transform_draw_rotated(gc, &transform, x, y, rotationX, rotationY, angle, alpha);
+	}
+	else {
+#if !defined(LLUI_IMAGE_CUSTOM_FORMATS)
+		ret = DW_DRAWING_SOFT_drawRotatedImageNearestNeighbor(gc, img, x, y, rotationX, rotationY, angle, alpha);
+#else
+		ret = UI_IMAGE_DRAWING_drawRotatedNearestNeighbor(gc, img, x, y, rotationX, rotationY, angle, alpha);
+#endif
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_drawRotatedImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha) {
+	DRAWING_Status ret;
+	DRAWING_DMA2D_transform_t transform;
+
+	if (_transform_initialize(&transform, gc, img, true)) {
+		ret = _transform_draw_rotated(gc, &transform, x, y, rotationX, rotationY, angle, alpha);
+	}
+	else {
+#if !defined(LLUI_IMAGE_CUSTOM_FORMATS)
+		ret = DW_DRAWING_SOFT_drawRotatedImageBilinear(gc, img, x, y, rotationX, rotationY, angle, alpha);
+#else
+		ret = UI_IMAGE_DRAWING_drawRotatedBilinear(gc, img, x, y, rotationX, rotationY, angle, alpha);
+#endif
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_drawScaledImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
+	DRAWING_Status ret;
+	DRAWING_DMA2D_transform_t transform;
+
+	if (_transform_initialize(&transform, gc, img, false)) {
+		ret = _transform_draw_scaled(gc, &transform, x, y, factorX, factorY, alpha);
+	}
+	else {
+#if !defined(LLUI_IMAGE_CUSTOM_FORMATS)
+		ret = DW_DRAWING_SOFT_drawScaledImageNearestNeighbor(gc, img, x, y, factorX, factorY, alpha);
+#else
+		ret = UI_IMAGE_DRAWING_drawScaledNearestNeighbor(gc, img, x, y, factorX, factorY, alpha);
+#endif
+	}
+	return ret;
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_DMA2D_drawScaledImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha) {
+	DRAWING_Status ret;
+	DRAWING_DMA2D_transform_t transform;
+
+	if (_transform_initialize(&transform, gc, img, true)) {
+		ret = _transform_draw_scaled(gc, &transform, x, y, factorX, factorY, alpha);
+	}
+	else {
+#if !defined(LLUI_IMAGE_CUSTOM_FORMATS)
+		ret = DW_DRAWING_SOFT_drawScaledImageBilinear(gc, img, x, y, factorX, factorY, alpha);
+#else
+		ret = UI_IMAGE_DRAWING_drawScaledBilinear(gc, img, x, y, factorX, factorY, alpha);
+#endif
+	}
+	return ret;
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
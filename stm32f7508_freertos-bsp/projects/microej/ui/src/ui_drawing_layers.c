@@ -0,0 +1,582 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the drawers "1" and "2" (see ui_drawing.h): the formats of the
+ * offscreen layers blended in the display buffer by ui_layer_compositor.c.
+ *
+ * - Drawer "1", A8 (masks: dimming layers, shadows): the pixels are replaced by the
+ *   luminance of the foreground color (white: opaque, black: transparent). The DMA2D
+ *   cannot write in the A8 format: the drawings are performed by the CPU.
+ * - Drawer "2", ARGB4444 (overlays: toasts, popups): the pixels are replaced by the
+ *   foreground color (opaque). The rectangles are filled and the images are drawn by
+ *   the DMA2D, the other drawings are performed by the CPU.
+ *
+ * The supported drawings are the pixels, the lines, the rectangles, the filled rounded
+ * rectangles, circles and ellipses (not anti-aliased, like the MicroUI software
+ * drawings) and the images: A8 images in the A8 layers, the images supported by the
+ * DMA2D (A4 excepted) in the ARGB4444 layers. The other drawings report
+ * DRAWING_LOG_NOT_IMPLEMENTED (see ui_drawing_stub.h).
+ *
+ * The MicroUI colors are opaque: the layers are cleared by
+ * "Java_com_microej_ui_LayerCompositor_clear()".
+ *
+ * The drawers require LLUI_GC_SUPPORTED_FORMATS to be 3 (2: A8 drawer only).
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "ui_drawing.h"
+#include "ui_drawing_stub.h"
+#include "ui_drawing_dma2d.h"
+#include "ui_layer_compositor.h"
+#include "display_overlay.h"
+
+#if defined(LLUI_GC_SUPPORTED_FORMATS) && (LLUI_GC_SUPPORTED_FORMATS > 1)
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Alignment of the layers' buffers and of their size: the cache line size. The
+ * cache maintenance of the DMA2D drawings in a layer does not touch the data around.
+ */
+#define LAYERS_ALIGNMENT (32U)
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief The destination of a CPU drawing.
+ */
+typedef struct {
+	uint8_t* buffer;
+	uint32_t stride; // in pixels
+	bool a8; // A8 or ARGB4444
+	uint32_t value; // foreground color in the destination format
+	jint clip_x1;
+	jint clip_y1;
+	jint clip_x2;
+	jint clip_y2;
+} layers_target_t;
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Prepares a CPU drawing in a graphics context.
+ */
+static void _layers_target(MICROUI_GraphicsContext* gc, layers_target_t* target) {
+	uint32_t color = (uint32_t)gc->foreground_color;
+	target->buffer = LLUI_DISPLAY_getBufferAddress(&gc->image);
+	target->stride = LLUI_DISPLAY_getStrideInPixels(&gc->image);
+	target->a8 = (MICROUI_IMAGE_FORMAT_A8 == gc->image.format);
+	if (target->a8) {
+		// luminance
+		target->value = ((((color >> 16) & 0xffU) * 77U) + (((color >> 8) & 0xffU) * 150U) + ((color & 0xffU) * 29U)) >> 8;
+	}
+	else {
+		target->value = 0xf000U | ((color & 0xf00000U) >> 12) | ((color & 0xf000U) >> 8) | ((color & 0xf0U) >> 4);
+	}
+	target->clip_x1 = gc->clip_x1;
+	target->clip_y1 = gc->clip_y1;
+	target->clip_x2 = gc->clip_x2;
+	target->clip_y2 = gc->clip_y2;
+}
+
+/*
+ * @brief Sets the drawing limits (see "LLUI_DISPLAY_setDrawingLimits()") clipped to the
+ * clip of the graphics context: the clip is inside the destination, the limits of a shape
+ * that goes beyond the destination are not given to the Graphics Engine.
+ */
+static void _layers_set_drawing_limits(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	jint xmin = (x1 > gc->clip_x1) ? x1 : gc->clip_x1;
+	jint ymin = (y1 > gc->clip_y1) ? y1 : gc->clip_y1;
+	jint xmax = (x2 < gc->clip_x2) ? x2 : gc->clip_x2;
+	jint ymax = (y2 < gc->clip_y2) ? y2 : gc->clip_y2;
+
+	if ((xmin <= xmax) && (ymin <= ymax)) {
+		LLUI_DISPLAY_setDrawingLimits(xmin, ymin, xmax, ymax);
+	}
+}
+
+/*
+ * @brief Writes the pixels [x1, x2] of a line (clipped).
+ */
+static void _layers_span(const layers_target_t* target, jint x1, jint x2, jint y) {
+	jint xmin = (x1 > target->clip_x1) ? x1 : target->clip_x1;
+	jint xmax = (x2 < target->clip_x2) ? x2 : target->clip_x2;
+
+	if ((y >= target->clip_y1) && (y <= target->clip_y2) && (xmin <= xmax)) {
+		uint32_t offset = ((uint32_t)y * target->stride) + (uint32_t)xmin;
+		uint32_t length = (uint32_t)(xmax - xmin) + 1U;
+		if (target->a8) {
+			(void)memset(target->buffer + offset, (int)target->value, length);
+		}
+		else {
+			// cppcheck-suppress [misra-c2012-11.3] the ARGB4444 buffer is aligned (see LAYERS_ALIGNMENT)
+			uint16_t* pixels = ((uint16_t*)target->buffer) + offset;
+			for (uint32_t i = 0; i < length; i++) {
+				pixels[i] = (uint16_t)target->value;
+			}
+		}
+	}
+}
+
+/*
+ * @brief Integer square root.
+ */
+static uint32_t _layers_sqrt(uint64_t value) {
+	uint64_t root = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+	uint64_t rest = value;
+
+	while (bit > rest) {
+		bit >>= 2;
+	}
+	while (bit != 0U) {
+		if (rest >= (root + bit)) {
+			rest -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t)root;
+}
+
+/*
+ * @brief Gives the pixels [*x1, *x2] of a row of an ellipse (relatively to the ellipse's
+ * left border). A pixel belongs to the ellipse when its center is in the ellipse; the
+ * row is empty when *x1 > *x2.
+ *
+ * @param[in] width the ellipse's width.
+ * @param[in] height the ellipse's height.
+ * @param[in] row the row (0 to height - 1).
+ */
+static void _layers_ellipse_row(jint width, jint height, jint row, jint* x1, jint* x2) {
+	// distances to the center in half pixels: dx² / width² + dy² / height² <= 1
+	int64_t dy = (int64_t)((2 * row) + 1 - height);
+	int64_t w2 = (int64_t)width * width;
+	int64_t h2 = (int64_t)height * height;
+	jint dx = (jint)_layers_sqrt((uint64_t)((w2 * (h2 - (dy * dy))) / h2));
+	*x1 = (width - dx) / 2;
+	*x2 = ((width - 1) + dx) / 2;
+}
+
+/*
+ * @brief Fills a rounded rectangle (an ellipse when the corners are as large as the
+ * rectangle).
+ */
+static DRAWING_Status _layers_fill_rounded_rectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint corner_width, jint corner_height) {
+	layers_target_t target;
+	jint cw = (corner_width < width) ? corner_width : width;
+	jint ch = (corner_height < height) ? corner_height : height;
+	jint top = ((cw > 0) && (ch > 0)) ? (ch / 2) : 0;
+	jint bottom = height - top;
+
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, x, y, (x + width) - 1, (y + height) - 1);
+
+	for (jint row = 0; row < height; row++) {
+		jint inset = 0;
+		if ((row < top) || (row >= bottom)) {
+			jint x1;
+			jint x2;
+			_layers_ellipse_row(cw, ch, (row < top) ? row : (row - (height - ch)), &x1, &x2);
+			inset = x1;
+		}
+		_layers_span(&target, x + inset, (x + width) - 1 - inset, y + row);
+	}
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_write_pixel(MICROUI_GraphicsContext* gc, jint x, jint y) {
+	layers_target_t target;
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, x, y, x, y);
+	_layers_span(&target, x, x, y);
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_draw_line(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY) {
+	layers_target_t target;
+	jint dx = (endX > startX) ? (endX - startX) : (startX - endX);
+	jint dy = (endY > startY) ? (startY - endY) : (endY - startY);
+	jint sx = (endX > startX) ? 1 : -1;
+	jint sy = (endY > startY) ? 1 : -1;
+	jint error = dx + dy;
+	jint x = startX;
+	jint y = startY;
+
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, (startX < endX) ? startX : endX, (startY < endY) ? startY : endY, (startX > endX) ? startX : endX, (startY > endY) ? startY : endY);
+
+	// Bresenham
+	for (;;) {
+		_layers_span(&target, x, x, y);
+		if ((x == endX) && (y == endY)) {
+			break;
+		}
+		jint error2 = 2 * error;
+		if (error2 >= dy) {
+			error += dy;
+			x += sx;
+		}
+		if (error2 <= dx) {
+			error += dx;
+			y += sy;
+		}
+	}
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_draw_horizontal_line(MICROUI_GraphicsContext* gc, jint x1, jint x2, jint y) {
+	layers_target_t target;
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, x1, y, x2, y);
+	_layers_span(&target, x1, x2, y);
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_draw_vertical_line(MICROUI_GraphicsContext* gc, jint x, jint y1, jint y2) {
+	layers_target_t target;
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, x, y1, x, y2);
+	for (jint y = y1; y <= y2; y++) {
+		_layers_span(&target, x, x, y);
+	}
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_draw_rectangle(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	layers_target_t target;
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, x1, y1, x2, y2);
+	_layers_span(&target, x1, x2, y1);
+	for (jint y = y1 + 1; y < y2; y++) {
+		_layers_span(&target, x1, x1, y);
+		_layers_span(&target, x2, x2, y);
+	}
+	if (y2 > y1) {
+		_layers_span(&target, x1, x2, y2);
+	}
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_fill_rectangle(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	// the rectangle is in the clip
+	layers_target_t target;
+	_layers_target(gc, &target);
+	_layers_set_drawing_limits(gc, x1, y1, x2, y2);
+	for (jint y = y1; y <= y2; y++) {
+		_layers_span(&target, x1, x2, y);
+	}
+	return DRAWING_DONE;
+}
+
+/*
+ * @brief Copies a region of an image in the same format (without blending). The lines
+ * are copied in the order that supports the overlap when the image is the destination.
+ */
+static DRAWING_Status _layers_copy(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y) {
+	uint32_t pixel_size = (MICROUI_IMAGE_FORMAT_A8 == gc->image.format) ? 1U : 2U;
+	uint8_t* dest = LLUI_DISPLAY_getBufferAddress(&gc->image);
+	uint8_t* src = LLUI_DISPLAY_getBufferAddress(img);
+	uint32_t dest_stride = LLUI_DISPLAY_getStrideInPixels(&gc->image) * pixel_size;
+	uint32_t src_stride = LLUI_DISPLAY_getStrideInPixels(img) * pixel_size;
+	uint32_t size = (uint32_t)width * pixel_size;
+	bool down = y > regionY;
+
+	_layers_set_drawing_limits(gc, x, y, (x + width) - 1, (y + height) - 1);
+	for (jint i = 0; i < height; i++) {
+		jint line = down ? (height - 1 - i) : i;
+		uint8_t* dest_line = dest + ((uint32_t)(y + line) * dest_stride) + ((uint32_t)x * pixel_size);
+		uint8_t* src_line = src + ((uint32_t)(regionY + line) * src_stride) + ((uint32_t)regionX * pixel_size);
+		(void)memmove(dest_line, src_line, size);
+	}
+	return DRAWING_DONE;
+}
+
+/*
+ * @brief Draws an A8 image in an A8 layer: the coverages are combined.
+ */
+static DRAWING_Status _layers_draw_a8(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	uint8_t* dest = LLUI_DISPLAY_getBufferAddress(&gc->image);
+	uint8_t* src = LLUI_DISPLAY_getBufferAddress(img);
+	uint32_t dest_stride = LLUI_DISPLAY_getStrideInPixels(&gc->image);
+	uint32_t src_stride = LLUI_DISPLAY_getStrideInPixels(img);
+
+	_layers_set_drawing_limits(gc, x, y, (x + width) - 1, (y + height) - 1);
+	for (jint line = 0; line < height; line++) {
+		uint8_t* dest_line = dest + ((uint32_t)(y + line) * dest_stride) + (uint32_t)x;
+		uint8_t* src_line = src + ((uint32_t)(regionY + line) * src_stride) + (uint32_t)regionX;
+		for (jint i = 0; i < width; i++) {
+			uint32_t coverage = ((uint32_t)src_line[i] * (uint32_t)alpha) / 255U;
+			dest_line[i] = (uint8_t)(coverage + ((dest_line[i] * (255U - coverage)) / 255U));
+		}
+	}
+	return DRAWING_DONE;
+}
+
+static DRAWING_Status _layers_draw_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	DRAWING_Status status;
+	if (MICROUI_IMAGE_FORMAT_A8 == gc->image.format) {
+		if ((MICROUI_IMAGE_FORMAT_A8 == img->format) && (img != &gc->image)) {
+			status = _layers_draw_a8(gc, img, regionX, regionY, width, height, x, y, alpha);
+		}
+		else {
+			status = UI_DRAWING_STUB_drawImage(gc, img, regionX, regionY, width, height, x, y, alpha);
+		}
+	}
+	else if ((img != &gc->image) && UI_DRAWING_DMA2D_blend_image(gc, img, regionX, regionY, width, height, x, y, alpha)) {
+		status = DRAWING_RUNNING;
+	}
+	else {
+		status = UI_DRAWING_STUB_drawImage(gc, img, regionX, regionY, width, height, x, y, alpha);
+	}
+	return status;
+}
+
+static DRAWING_Status _layers_copy_image(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y) {
+	return (img->format == gc->image.format) ?
+			_layers_copy(gc, img, regionX, regionY, width, height, x, y)
+			: _layers_draw_image(gc, img, regionX, regionY, width, height, x, y, 0xff);
+}
+
+static DRAWING_Status _layers_draw_region(MICROUI_GraphicsContext* gc, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	return (0xff == alpha) ?
+			_layers_copy(gc, &gc->image, regionX, regionY, width, height, x, y)
+			: UI_DRAWING_STUB_drawRegion(gc, regionX, regionY, width, height, x, y, alpha);
+}
+
+static void _layers_adjust_characteristics(uint32_t* data_size, uint32_t* data_alignment) {
+	*data_size = (*data_size + (LAYERS_ALIGNMENT - 1U)) & ~(LAYERS_ALIGNMENT - 1U);
+	if (*data_alignment < LAYERS_ALIGNMENT) {
+		*data_alignment = LAYERS_ALIGNMENT;
+	}
+}
+
+// --------------------------------------------------------------------------------
+// ui_drawing.h functions: drawer "1" (A8)
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+bool UI_DRAWING_is_drawer_1(jbyte image_format) {
+	return (jbyte)MICROUI_IMAGE_FORMAT_A8 == image_format;
+}
+
+// See the header file for the function documentation
+uint32_t UI_DRAWING_getNewImageStrideInBytes_1(jbyte image_format, uint32_t width, uint32_t height, uint32_t default_stride) {
+	(void)image_format;
+	(void)width;
+	(void)height;
+	return default_stride;
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_adjustNewImageCharacteristics_1(jbyte image_format, uint32_t width, uint32_t height, uint32_t* data_size, uint32_t* data_alignment) {
+	(void)image_format;
+	(void)width;
+	(void)height;
+	_layers_adjust_characteristics(data_size, data_alignment);
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_initializeNewImage_1(MICROUI_Image* image) {
+	(void)image;
+	// nothing to initialize
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_freeImageResources_1(MICROUI_Image* image) {
+	UI_LAYER_COMPOSITOR_free_image(image);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_writePixel_1(MICROUI_GraphicsContext* gc, jint x, jint y) {
+	return _layers_write_pixel(gc, x, y);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawLine_1(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY) {
+	return _layers_draw_line(gc, startX, startY, endX, endY);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawHorizontalLine_1(MICROUI_GraphicsContext* gc, jint x1, jint x2, jint y) {
+	return _layers_draw_horizontal_line(gc, x1, x2, y);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawVerticalLine_1(MICROUI_GraphicsContext* gc, jint x, jint y1, jint y2) {
+	return _layers_draw_vertical_line(gc, x, y1, y2);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawRectangle_1(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	return _layers_draw_rectangle(gc, x1, y1, x2, y2);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillRectangle_1(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	return _layers_fill_rectangle(gc, x1, y1, x2, y2);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillRoundedRectangle_1(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight) {
+	return _layers_fill_rounded_rectangle(gc, x, y, width, height, cornerEllipseWidth, cornerEllipseHeight);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillEllipse_1(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
+	return _layers_fill_rounded_rectangle(gc, x, y, width, height, width, height);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillCircle_1(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter) {
+	return _layers_fill_rounded_rectangle(gc, x, y, diameter, diameter, diameter, diameter);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawImage_1(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	return _layers_draw_image(gc, img, regionX, regionY, width, height, x, y, alpha);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_copyImage_1(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y) {
+	return _layers_copy_image(gc, img, regionX, regionY, width, height, x, y);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawRegion_1(MICROUI_GraphicsContext* gc, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	return _layers_draw_region(gc, regionX, regionY, width, height, x, y, alpha);
+}
+
+#if (LLUI_GC_SUPPORTED_FORMATS > 2)
+
+// --------------------------------------------------------------------------------
+// ui_drawing.h functions: drawer "2" (ARGB4444)
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+bool UI_DRAWING_is_drawer_2(jbyte image_format) {
+	return (jbyte)MICROUI_IMAGE_FORMAT_ARGB4444 == image_format;
+}
+
+// See the header file for the function documentation
+uint32_t UI_DRAWING_getNewImageStrideInBytes_2(jbyte image_format, uint32_t width, uint32_t height, uint32_t default_stride) {
+	(void)image_format;
+	(void)width;
+	(void)height;
+	return default_stride;
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_adjustNewImageCharacteristics_2(jbyte image_format, uint32_t width, uint32_t height, uint32_t* data_size, uint32_t* data_alignment) {
+	(void)image_format;
+	(void)width;
+	(void)height;
+	_layers_adjust_characteristics(data_size, data_alignment);
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_initializeNewImage_2(MICROUI_Image* image) {
+	(void)image;
+	// nothing to initialize
+}
+
+// See the header file for the function documentation
+void UI_DRAWING_freeImageResources_2(MICROUI_Image* image) {
+	UI_LAYER_COMPOSITOR_free_image(image);
+	// an ARGB4444 image can be shown on the overlay plane
+	DISPLAY_OVERLAY_free_image(image);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_writePixel_2(MICROUI_GraphicsContext* gc, jint x, jint y) {
+	return _layers_write_pixel(gc, x, y);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawLine_2(MICROUI_GraphicsContext* gc, jint startX, jint startY, jint endX, jint endY) {
+	return _layers_draw_line(gc, startX, startY, endX, endY);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawHorizontalLine_2(MICROUI_GraphicsContext* gc, jint x1, jint x2, jint y) {
+	return _layers_draw_horizontal_line(gc, x1, x2, y);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawVerticalLine_2(MICROUI_GraphicsContext* gc, jint x, jint y1, jint y2) {
+	return _layers_draw_vertical_line(gc, x, y1, y2);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawRectangle_2(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	return _layers_draw_rectangle(gc, x1, y1, x2, y2);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillRectangle_2(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2) {
+	// the rectangle is in the clip
+	return UI_DRAWING_DMA2D_fill_layer(gc, x1, y1, x2, y2, 0xff000000U | (uint32_t)gc->foreground_color);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillRoundedRectangle_2(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight) {
+	return _layers_fill_rounded_rectangle(gc, x, y, width, height, cornerEllipseWidth, cornerEllipseHeight);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillEllipse_2(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
+	return _layers_fill_rounded_rectangle(gc, x, y, width, height, width, height);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_fillCircle_2(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter) {
+	return _layers_fill_rounded_rectangle(gc, x, y, diameter, diameter, diameter, diameter);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawImage_2(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	return _layers_draw_image(gc, img, regionX, regionY, width, height, x, y, alpha);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_copyImage_2(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint regionX, jint regionY, jint width, jint height, jint x, jint y) {
+	return _layers_copy_image(gc, img, regionX, regionY, width, height, x, y);
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_DRAWING_drawRegion_2(MICROUI_GraphicsContext* gc, jint regionX, jint regionY, jint width, jint height, jint x, jint y, jint alpha) {
+	return _layers_draw_region(gc, regionX, regionY, width, height, x, y, alpha);
+}
+
+#endif // #if (LLUI_GC_SUPPORTED_FORMATS > 2)
+
+#endif // #if defined(LLUI_GC_SUPPORTED_FORMATS) && (LLUI_GC_SUPPORTED_FORMATS > 1)
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
@@ -0,0 +1,567 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the glyph atlas (see ui_glyph_atlas.h).
+ *
+ * Each font has a block in the images heap: a table of the characters (open addressing)
+ * followed by the atlas. The glyphs are placed in rows (shelves) from the top of the
+ * atlas; when the atlas or the table is full, the atlas is emptied once the DMA2D jobs
+ * that read it are finished.
+ *
+ * A string is drawn in two passes: the first pass computes the glyphs in the clip and the
+ * region to draw, the second pass rasterizes the missing glyphs and queues one DMA2D job
+ * per glyph; only the last job notifies the Graphics Engine.
+ *
+ * The DMA2D reads the A4 lines from a byte boundary: an A4 glyph cut by the clip on an odd
+ * column is converted in A8 in a scratch buffer before being blended.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+#include <LLUI_DISPLAY_impl.h>
+#include <sni.h>
+
+#include "ui_glyph_atlas.h"
+#include "ui_display_list.h"
+#include "ui_drawing_dma2d.h"
+#include "ui_drawing_dma2d_cache.h"
+#include "display_dirty_regions.h"
+
+// --------------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------------
+
+#if ((UI_GLYPH_ATLAS_GLYPHS & (UI_GLYPH_ATLAS_GLYPHS - 1U)) != 0U)
+#error "UI_GLYPH_ATLAS_GLYPHS must be a power of two"
+#endif
+
+#if ((UI_GLYPH_ATLAS_WIDTH & 1U) != 0U)
+#error "UI_GLYPH_ATLAS_WIDTH must be even"
+#endif
+
+#if (UI_GLYPH_ATLAS_GLYPH_MAX_SIZE >= UI_GLYPH_ATLAS_WIDTH) || (UI_GLYPH_ATLAS_GLYPH_MAX_SIZE > UI_GLYPH_ATLAS_HEIGHT)
+#error "UI_GLYPH_ATLAS_GLYPH_MAX_SIZE must be lower than the atlas size"
+#endif
+
+/*
+ * @brief Flags of a character entry.
+ */
+#define GLYPH_ATLAS_USED (0x01U) // the entry holds a character
+#define GLYPH_ATLAS_MISSING (0x02U) // unknown character or glyph too large
+#define GLYPH_ATLAS_RASTERIZED (0x04U) // the glyph is in the atlas
+
+/*
+ * @brief The table is full when three quarters of its entries are used (the probing
+ * sequences stay short).
+ */
+#define GLYPH_ATLAS_TABLE_FULL ((UI_GLYPH_ATLAS_GLYPHS * 3U) / 4U)
+
+/*
+ * @brief The height of the rows is a multiple of this value: the glyphs with about the
+ * same height share the same row.
+ */
+#define GLYPH_ATLAS_SHELF_ROUNDING (4U)
+
+/*
+ * @brief Identifier of the strings in the recorded regions (see ui_display_list.h).
+ */
+#define GLYPH_ATLAS_DRAWING (300U)
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief A character of the table.
+ */
+typedef struct {
+	jchar character;
+	uint8_t flags;
+	UI_GLYPH_ATLAS_metrics_t metrics;
+	uint16_t x; // glyph's position in the atlas
+	uint16_t y;
+} glyph_entry_t;
+
+/*
+ * @brief A row of glyphs: the glyphs are placed from the left.
+ */
+typedef struct {
+	uint16_t y;
+	uint16_t height;
+	uint16_t x; // first free column
+} glyph_shelf_t;
+
+/*
+ * @brief A registered font and its atlas.
+ */
+typedef struct {
+	const UI_GLYPH_ATLAS_font_t* font; // NULL when the slot is free
+	uint8_t* block; // characters table and atlas (NULL until the first drawing)
+	uint8_t* pixels; // atlas (after the table in the block)
+	uint32_t last_job; // last DMA2D job that reads the atlas
+	uint32_t entries; // number of used entries of the table
+	uint32_t shelves; // number of rows
+	uint32_t next_y; // top of the next row
+	glyph_shelf_t shelf[UI_GLYPH_ATLAS_SHELVES];
+} glyph_atlas_t;
+
+/*
+ * @brief A glyph to draw: the region in the destination and in the atlas.
+ */
+typedef struct {
+	jint x1; // region in the destination
+	jint y1;
+	jint x2;
+	jint y2;
+	jint x_src; // region's top-left corner in the atlas
+	jint y_src;
+	bool scratch; // A4 region on an odd column: converted in A8 before being blended
+} glyph_region_t;
+
+// --------------------------------------------------------------------------------
+// Private fields
+// --------------------------------------------------------------------------------
+
+static glyph_atlas_t g_atlases[UI_GLYPH_ATLAS_FONTS];
+
+/*
+ * @brief Buffer to rasterize the A4 glyphs and to convert the A4 regions in A8, and
+ * the last DMA2D job that reads it.
+ */
+static uint8_t g_scratch[UI_GLYPH_ATLAS_GLYPH_MAX_SIZE * UI_GLYPH_ATLAS_GLYPH_MAX_SIZE];
+static uint32_t g_scratch_job;
+
+static UI_GLYPH_ATLAS_statistics_t g_statistics;
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Gets the characters table of an atlas.
+ */
+static inline glyph_entry_t* _glyph_atlas_table(glyph_atlas_t* atlas) {
+	// cppcheck-suppress [misra-c2012-11.3] the table is at the beginning of the block
+	return (glyph_entry_t*)atlas->block;
+}
+
+/*
+ * @brief Gets the width in pixels of the glyph in the atlas: the A4 glyphs start on a
+ * byte boundary.
+ */
+static inline uint32_t _glyph_atlas_slot_width(const glyph_atlas_t* atlas, const glyph_entry_t* entry) {
+	uint32_t width = entry->metrics.width;
+	return ((uint32_t)4 == atlas->font->bpp) ? ((width + (uint32_t)1) & ~(uint32_t)1) : width;
+}
+
+/*
+ * @brief Cleans the data cache over a region written by the CPU and read by the DMA2D.
+ *
+ * @param[in] buffer the buffer's address.
+ * @param[in] bpp the buffer's number of bits per pixel.
+ * @param[in] internal true for a buffer in the internal RAM (always cached), false for
+ * the images heap (cached like the display buffers).
+ */
+static void _glyph_atlas_clean(uint8_t* buffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t stride, uint32_t bpp, bool internal) {
+#if defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+	DRAWING_DMA2D_CACHE_area_t area;
+	DRAWING_DMA2D_CACHE_set_area(&area, buffer, x, y, width, height, stride, bpp);
+	if (internal) {
+		(void)DRAWING_DMA2D_CACHE_apply_range(&area, false, UINT32_MAX);
+	}
+#if DRAWING_DMA2D_CACHE_MANAGEMENT == DRAWING_DMA2D_CACHE_MANAGEMENT_ENABLED
+	else {
+		DRAWING_DMA2D_CACHE_clean(&area);
+	}
+#endif
+#else
+	(void)buffer;
+	(void)x;
+	(void)y;
+	(void)width;
+	(void)height;
+	(void)stride;
+	(void)bpp;
+	(void)internal;
+#endif
+}
+
+/*
+ * @brief Empties an atlas once the DMA2D does not read it anymore.
+ */
+static void _glyph_atlas_reset(glyph_atlas_t* atlas) {
+	UI_DRAWING_DMA2D_wait_job(atlas->last_job);
+	(void)memset(atlas->block, 0, UI_GLYPH_ATLAS_GLYPHS * sizeof(glyph_entry_t));
+	atlas->entries = 0;
+	atlas->shelves = 0;
+	atlas->next_y = 0;
+}
+
+/*
+ * @brief Allocates the block of an atlas in the images heap (first drawing).
+ *
+ * @return false when the images heap is full.
+ */
+static bool _glyph_atlas_allocate(glyph_atlas_t* atlas) {
+	if (NULL == atlas->block) {
+		uint32_t table_size = UI_GLYPH_ATLAS_GLYPHS * sizeof(glyph_entry_t);
+		uint32_t pixels_size = (UI_GLYPH_ATLAS_WIDTH * UI_GLYPH_ATLAS_HEIGHT * atlas->font->bpp) / (uint32_t)8;
+		atlas->block = LLUI_DISPLAY_IMPL_image_heap_allocate(table_size + pixels_size);
+		if (NULL != atlas->block) {
+			// cppcheck-suppress [misra-c2012-18.4] the atlas is after the table
+			atlas->pixels = atlas->block + table_size;
+			atlas->last_job = 0;
+			_glyph_atlas_reset(atlas);
+		}
+	}
+	return NULL != atlas->block;
+}
+
+/*
+ * @brief Gets the entry of a character, adds it when the character is not in the table.
+ * Adding a character may empty the atlas.
+ */
+static glyph_entry_t* _glyph_atlas_get(glyph_atlas_t* atlas, jchar character) {
+	glyph_entry_t* table = _glyph_atlas_table(atlas);
+	uint32_t mask = UI_GLYPH_ATLAS_GLYPHS - (uint32_t)1;
+	uint32_t index = (uint32_t)character & mask;
+
+	while ((0U != (table[index].flags & GLYPH_ATLAS_USED)) && (character != table[index].character)) {
+		index = (index + (uint32_t)1) & mask;
+	}
+
+	glyph_entry_t* entry = &table[index];
+	if (0U == (entry->flags & GLYPH_ATLAS_USED)) {
+		if (atlas->entries >= GLYPH_ATLAS_TABLE_FULL) {
+			_glyph_atlas_reset(atlas);
+			entry = _glyph_atlas_get(atlas, character);
+		}
+		else {
+			const UI_GLYPH_ATLAS_font_t* font = atlas->font;
+			entry->character = character;
+			entry->flags = GLYPH_ATLAS_USED;
+			if (!font->get_metrics(font->data, (uint32_t)character, &entry->metrics)
+					|| (entry->metrics.width > UI_GLYPH_ATLAS_GLYPH_MAX_SIZE) || (entry->metrics.height > UI_GLYPH_ATLAS_GLYPH_MAX_SIZE)) {
+				(void)memset(&entry->metrics, 0, sizeof(UI_GLYPH_ATLAS_metrics_t));
+				entry->flags |= GLYPH_ATLAS_MISSING;
+			}
+			atlas->entries++;
+		}
+	}
+
+	return entry;
+}
+
+/*
+ * @brief Finds a place for a glyph in the atlas: in the lowest row high enough or
+ * in a new row.
+ *
+ * @return false when the atlas is full.
+ */
+static bool _glyph_atlas_place(glyph_atlas_t* atlas, glyph_entry_t* entry) {
+	uint32_t width = _glyph_atlas_slot_width(atlas, entry);
+	uint32_t height = entry->metrics.height;
+	glyph_shelf_t* shelf = NULL;
+
+	for (uint32_t i = 0; i < atlas->shelves; i++) {
+		glyph_shelf_t* candidate = &atlas->shelf[i];
+		if ((candidate->height >= height) && ((candidate->x + width) <= UI_GLYPH_ATLAS_WIDTH)
+				&& ((NULL == shelf) || (candidate->height < shelf->height))) {
+			shelf = candidate;
+		}
+	}
+
+	if (NULL == shelf) {
+		uint32_t shelf_height = ((height + GLYPH_ATLAS_SHELF_ROUNDING) - (uint32_t)1) & ~(GLYPH_ATLAS_SHELF_ROUNDING - (uint32_t)1);
+		if ((atlas->next_y + shelf_height) > UI_GLYPH_ATLAS_HEIGHT) {
+			shelf_height = height;
+		}
+		if ((atlas->shelves < UI_GLYPH_ATLAS_SHELVES) && ((atlas->next_y + shelf_height) <= UI_GLYPH_ATLAS_HEIGHT)) {
+			shelf = &atlas->shelf[atlas->shelves];
+			shelf->y = (uint16_t)atlas->next_y;
+			shelf->height = (uint16_t)shelf_height;
+			shelf->x = 0;
+			atlas->shelves++;
+			atlas->next_y += shelf_height;
+		}
+	}
+
+	if (NULL != shelf) {
+		entry->x = shelf->x;
+		entry->y = shelf->y;
+		shelf->x += (uint16_t)width;
+	}
+
+	return NULL != shelf;
+}
+
+/*
+ * @brief Rasterizes a glyph in the atlas (the atlas is emptied when it is full).
+ *
+ * @return the character's entry (the entry given may have been removed).
+ */
+static glyph_entry_t* _glyph_atlas_rasterize(glyph_atlas_t* atlas, glyph_entry_t* entry) {
+	glyph_entry_t* ret = entry;
+
+	if (0U != (ret->flags & GLYPH_ATLAS_RASTERIZED)) {
+		g_statistics.hits++;
+	}
+	else {
+		const UI_GLYPH_ATLAS_font_t* font = atlas->font;
+
+		if (!_glyph_atlas_place(atlas, ret)) {
+			// a glyph is never larger than the atlas
+			jchar character = ret->character;
+			_glyph_atlas_reset(atlas);
+			g_statistics.resets++;
+			ret = _glyph_atlas_get(atlas, character);
+			(void)_glyph_atlas_place(atlas, ret);
+		}
+
+		uint32_t width = ret->metrics.width;
+		uint32_t height = ret->metrics.height;
+
+		if ((uint32_t)8 == font->bpp) {
+			// cppcheck-suppress [misra-c2012-18.4] address of the glyph in the atlas
+			font->render(font->data, (uint32_t)ret->character, atlas->pixels + (((uint32_t)ret->y * UI_GLYPH_ATLAS_WIDTH) + ret->x), UI_GLYPH_ATLAS_WIDTH);
+		}
+		else {
+			// rasterize in A8 and pack two pixels per byte (the first pixel in the low bits)
+			UI_DRAWING_DMA2D_wait_job(g_scratch_job);
+			font->render(font->data, (uint32_t)ret->character, g_scratch, width);
+
+			uint8_t* line = &atlas->pixels[(((uint32_t)ret->y * UI_GLYPH_ATLAS_WIDTH) + ret->x) / (uint32_t)2];
+			for (uint32_t y = 0; y < height; y++) {
+				const uint8_t* alpha = &g_scratch[y * width];
+				for (uint32_t x = 0; x < width; x += (uint32_t)2) {
+					uint32_t high = ((x + (uint32_t)1) < width) ? ((uint32_t)alpha[x + (uint32_t)1] >> 4) : (uint32_t)0;
+					line[x / (uint32_t)2] = (uint8_t)(((uint32_t)alpha[x] >> 4) | (high << 4));
+				}
+				line = &line[UI_GLYPH_ATLAS_WIDTH / (uint32_t)2];
+			}
+		}
+
+		_glyph_atlas_clean(atlas->pixels, ret->x, ret->y, _glyph_atlas_slot_width(atlas, ret), height, UI_GLYPH_ATLAS_WIDTH, font->bpp, false);
+		ret->flags |= GLYPH_ATLAS_RASTERIZED;
+		g_statistics.misses++;
+	}
+
+	return ret;
+}
+
+/*
+ * @brief Computes the region of a glyph to draw.
+ *
+ * @param[in] gc the destination.
+ * @param[in] atlas the font's atlas.
+ * @param[in] entry the glyph.
+ * @param[in] x the X coordinate of the pen.
+ * @param[in] y the Y coordinate of the top of the line.
+ * @param[out] region the region to draw.
+ *
+ * @return false when the glyph is blank or outside the clip.
+ */
+static bool _glyph_atlas_clip(MICROUI_GraphicsContext* gc, const glyph_atlas_t* atlas, const glyph_entry_t* entry, jint x, jint y, glyph_region_t* region) {
+	bool visible = false;
+
+	if ((entry->metrics.width > 0U) && (entry->metrics.height > 0U)) {
+		jint gx = x + entry->metrics.left;
+		jint gy = y + entry->metrics.top;
+		region->x1 = gx;
+		region->y1 = gy;
+		region->x2 = (gx + (jint)entry->metrics.width) - 1;
+		region->y2 = (gy + (jint)entry->metrics.height) - 1;
+		visible = LLUI_DISPLAY_clipRectangle(gc, &region->x1, &region->y1, &region->x2, &region->y2);
+		// the position in the atlas is relative to the glyph's top-left corner until the glyph is rasterized
+		region->x_src = region->x1 - gx;
+		region->y_src = region->y1 - gy;
+		region->scratch = false;
+
+		if (visible && ((uint32_t)4 == atlas->font->bpp)) {
+			jint width = (region->x2 - region->x1) + 1;
+			if ((0 == (region->x_src & 1)) && (0 != (width & 1))
+					&& (region->x2 == ((gx + (jint)entry->metrics.width) - 1)) && (region->x2 < gc->clip_x2)) {
+				// the glyph's last column is odd: draw the transparent column after it
+				region->x2++;
+			}
+			else {
+				region->scratch = (0 != ((region->x_src | width) & 1));
+			}
+		}
+	}
+
+	return visible;
+}
+
+/*
+ * @brief Queues the blending of a glyph region.
+ */
+static void _glyph_atlas_blend(MICROUI_GraphicsContext* gc, glyph_atlas_t* atlas, const glyph_entry_t* entry, const glyph_region_t* region, bool last) {
+	jint width = (region->x2 - region->x1) + 1;
+	jint height = (region->y2 - region->y1) + 1;
+	jint x_src = region->x_src + (jint)entry->x;
+	jint y_src = region->y_src + (jint)entry->y;
+
+	if (region->scratch) {
+		// convert the A4 region in A8
+		UI_DRAWING_DMA2D_wait_job(g_scratch_job);
+		for (jint y = 0; y < height; y++) {
+			const uint8_t* line = &atlas->pixels[((uint32_t)(y_src + y) * UI_GLYPH_ATLAS_WIDTH) / (uint32_t)2];
+			uint8_t* alpha = &g_scratch[y * width];
+			for (jint x = 0; x < width; x++) {
+				uint32_t column = (uint32_t)(x_src + x);
+				uint32_t value = ((uint32_t)line[column / (uint32_t)2] >> ((column & (uint32_t)1) * (uint32_t)4)) & (uint32_t)0xf;
+				alpha[x] = (uint8_t)(value * (uint32_t)0x11);
+			}
+		}
+		_glyph_atlas_clean(g_scratch, 0, 0, (uint32_t)width, (uint32_t)height, (uint32_t)width, 8, true);
+		g_scratch_job = UI_DRAWING_DMA2D_blend_alpha(gc, g_scratch, (uint32_t)width, 8, 0, 0, width, height, region->x1, region->y1, last);
+	}
+	else {
+		atlas->last_job = UI_DRAWING_DMA2D_blend_alpha(gc, atlas->pixels, UI_GLYPH_ATLAS_WIDTH, atlas->font->bpp, x_src, y_src, width, height, region->x1, region->y1, last);
+	}
+}
+
+// --------------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+int32_t UI_GLYPH_ATLAS_register_font(const UI_GLYPH_ATLAS_font_t* font) {
+	int32_t id = -1;
+
+	if ((NULL != font) && (NULL != font->get_metrics) && (NULL != font->render) && (((uint32_t)8 == font->bpp) || ((uint32_t)4 == font->bpp))) {
+		for (uint32_t i = 0; (-1 == id) && (i < UI_GLYPH_ATLAS_FONTS); i++) {
+			if (NULL == g_atlases[i].font) {
+				g_atlases[i].font = font;
+				g_atlases[i].block = NULL;
+				id = (int32_t)i;
+			}
+		}
+	}
+
+	return id;
+}
+
+// See the header file for the function documentation
+void UI_GLYPH_ATLAS_unregister_font(int32_t font) {
+	if ((font >= 0) && ((uint32_t)font < UI_GLYPH_ATLAS_FONTS) && (NULL != g_atlases[font].font)) {
+		glyph_atlas_t* atlas = &g_atlases[font];
+		if (NULL != atlas->block) {
+			UI_DRAWING_DMA2D_wait_job(atlas->last_job);
+			LLUI_DISPLAY_IMPL_image_heap_free(atlas->block);
+			atlas->block = NULL;
+		}
+		atlas->font = NULL;
+	}
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_GLYPH_ATLAS_draw_string(MICROUI_GraphicsContext* gc, int32_t font, const jchar* chars, uint32_t length, jint x, jint y) {
+	DRAWING_Status status = DRAWING_DONE;
+	glyph_atlas_t* atlas = ((font >= 0) && ((uint32_t)font < UI_GLYPH_ATLAS_FONTS)) ? &g_atlases[font] : NULL;
+
+	if ((NULL == atlas) || (NULL == atlas->font)) {
+		LLUI_DISPLAY_reportError(gc, DRAWING_LOG_LIBRARY_INCIDENT);
+	}
+	else if (!LLUI_DISPLAY_isDisplayFormat(gc->image.format)) {
+		// the DMA2D only draws in the display format
+		LLUI_DISPLAY_reportWarning(gc, DRAWING_LOG_NOT_IMPLEMENTED);
+	}
+	else if (!_glyph_atlas_allocate(atlas)) {
+		LLUI_DISPLAY_reportError(gc, DRAWING_LOG_OUT_OF_MEMORY);
+	}
+	else {
+		glyph_region_t region;
+		jint x1 = INT32_MAX;
+		jint y1 = INT32_MAX;
+		jint x2 = INT32_MIN;
+		jint y2 = INT32_MIN;
+		uint32_t last = length;
+		jint pen = x;
+
+		g_statistics.strings++;
+
+		// first pass: the last glyph to draw (it notifies the Graphics Engine) and the region to draw
+		for (uint32_t i = 0; i < length; i++) {
+			glyph_entry_t* entry = _glyph_atlas_get(atlas, chars[i]);
+			if (0U != (entry->flags & GLYPH_ATLAS_MISSING)) {
+				g_statistics.missing++;
+				LLUI_DISPLAY_reportWarning(gc, DRAWING_LOG_MISSING_CHARACTER);
+			}
+			else if (_glyph_atlas_clip(gc, atlas, entry, pen, y, &region)) {
+				last = i;
+				x1 = (region.x1 < x1) ? region.x1 : x1;
+				y1 = (region.y1 < y1) ? region.y1 : y1;
+				x2 = (region.x2 > x2) ? region.x2 : x2;
+				y2 = (region.y2 > y2) ? region.y2 : y2;
+			}
+			else {
+				// blank glyph or glyph outside the clip
+			}
+			pen += (jint)entry->metrics.advance;
+		}
+
+		if (last < length) {
+			// second pass: rasterize the missing glyphs and queue the blendings
+			UI_DRAWING_DMA2D_start_tiles(gc, x1, y1, x2, y2);
+			pen = x;
+			for (uint32_t i = 0; i <= last; i++) {
+				glyph_entry_t* entry = _glyph_atlas_get(atlas, chars[i]);
+				if (_glyph_atlas_clip(gc, atlas, entry, pen, y, &region)) {
+					entry = _glyph_atlas_rasterize(atlas, entry);
+					_glyph_atlas_blend(gc, atlas, entry, &region, i == last);
+				}
+				pen += (jint)entry->metrics.advance;
+			}
+			status = DRAWING_RUNNING;
+		}
+	}
+
+	return status;
+}
+
+// See the header file for the function documentation
+void UI_GLYPH_ATLAS_get_statistics(UI_GLYPH_ATLAS_statistics_t* statistics) {
+	*statistics = g_statistics;
+}
+
+// See the header file for the function documentation
+void UI_GLYPH_ATLAS_reset_statistics(void) {
+	(void)memset(&g_statistics, 0, sizeof(g_statistics));
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_GlyphAtlas_drawString(MICROUI_GraphicsContext* gc, jint font, jchar* chars, jint offset, jint length, jint x, jint y) {
+	bool valid = (offset >= 0) && (length >= 0) && ((offset + length) <= SNI_getArrayLength(chars));
+	const jint args[] = { font, valid ? (jint)UI_DISPLAY_LIST_hash(0U, &chars[offset], (uint32_t)length * sizeof(jchar)) : 0, x, y };
+	if (UI_DISPLAY_LIST_request_drawing(gc, (SNI_callback)&Java_com_microej_ui_GlyphAtlas_drawString, GLYPH_ATLAS_DRAWING, args, 4U)) {
+		DRAWING_Status status = DRAWING_DONE;
+		DISPLAY_DIRTY_REGIONS_add_clip(gc);
+		if (!valid) {
+			LLUI_DISPLAY_reportError(gc, DRAWING_LOG_LIBRARY_INCIDENT);
+		}
+		else {
+			status = UI_GLYPH_ATLAS_draw_string(gc, font, &chars[offset], (uint32_t)length, x, y);
+		}
+		LLUI_DISPLAY_setDrawingStatus(status);
+	}
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
@@ -0,0 +1,212 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the font sheets (see ui_glyph_atlas_sheet.h).
+ *
+ * The metrics of a glyph are computed when the glyph enters the atlas: the cell is
+ * scanned for its non-transparent pixels.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "ui_glyph_atlas_sheet.h"
+
+// --------------------------------------------------------------------------------
+// Private fields
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief The sheets registered by the natives (one per atlas at most).
+ */
+static UI_GLYPH_ATLAS_SHEET_t g_sheets[UI_GLYPH_ATLAS_FONTS];
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Gets the alpha value (0xff is opaque) of a pixel of the sheet.
+ */
+static uint8_t _glyph_atlas_sheet_alpha(const UI_GLYPH_ATLAS_SHEET_t* sheet, uint32_t x, uint32_t y) {
+	const uint8_t* line = &sheet->pixels[y * sheet->stride];
+	uint8_t alpha;
+	if ((uint32_t)8 == sheet->font.bpp) {
+		alpha = line[x];
+	}
+	else {
+		// two pixels per byte, the first pixel in the low bits
+		alpha = (uint8_t)((((uint32_t)line[x / (uint32_t)2] >> ((x & (uint32_t)1) * (uint32_t)4)) & (uint32_t)0xf) * (uint32_t)0x11);
+	}
+	return alpha;
+}
+
+/*
+ * @brief Gets the top-left pixel of the cell of a character in the sheet.
+ *
+ * @return false when the sheet does not have this character.
+ */
+static bool _glyph_atlas_sheet_cell(const UI_GLYPH_ATLAS_SHEET_t* sheet, uint32_t character, uint32_t* x, uint32_t* y) {
+	bool ret = (character >= sheet->first) && ((character - sheet->first) < sheet->count);
+	if (ret) {
+		uint32_t cell = character - sheet->first;
+		*x = (cell % sheet->columns) * sheet->cell_width;
+		*y = (cell / sheet->columns) * sheet->cell_height;
+	}
+	return ret;
+}
+
+/*
+ * @brief Implementation of UI_GLYPH_ATLAS_get_metrics: the smallest box of the cell that
+ * holds the non-transparent pixels.
+ */
+static bool _glyph_atlas_sheet_get_metrics(const void* data, uint32_t character, UI_GLYPH_ATLAS_metrics_t* metrics) {
+	const UI_GLYPH_ATLAS_SHEET_t* sheet = (const UI_GLYPH_ATLAS_SHEET_t*)data;
+	uint32_t cell_x;
+	uint32_t cell_y;
+	bool ret = _glyph_atlas_sheet_cell(sheet, character, &cell_x, &cell_y);
+
+	if (ret) {
+		uint32_t x1 = sheet->cell_width;
+		uint32_t y1 = sheet->cell_height;
+		uint32_t x2 = 0;
+		uint32_t y2 = 0;
+
+		for (uint32_t y = 0; y < sheet->cell_height; y++) {
+			for (uint32_t x = 0; x < sheet->cell_width; x++) {
+				if (0U != _glyph_atlas_sheet_alpha(sheet, cell_x + x, cell_y + y)) {
+					x1 = (x < x1) ? x : x1;
+					y1 = (y < y1) ? y : y1;
+					x2 = (x > x2) ? x : x2;
+					y2 = (y > y2) ? y : y2;
+				}
+			}
+		}
+
+		(void)memset(metrics, 0, sizeof(UI_GLYPH_ATLAS_metrics_t));
+		if (x1 <= x2) {
+			metrics->width = (uint8_t)((x2 - x1) + (uint32_t)1);
+			metrics->height = (uint8_t)((y2 - y1) + (uint32_t)1);
+			metrics->left = (int8_t)x1;
+			metrics->top = (int8_t)y1;
+		}
+		// else: blank glyph
+		metrics->advance = (uint8_t)sheet->cell_width;
+	}
+
+	return ret;
+}
+
+/*
+ * @brief Implementation of UI_GLYPH_ATLAS_render: copies the glyph's box in A8.
+ */
+static void _glyph_atlas_sheet_render(const void* data, uint32_t character, uint8_t* alpha, uint32_t stride) {
+	const UI_GLYPH_ATLAS_SHEET_t* sheet = (const UI_GLYPH_ATLAS_SHEET_t*)data;
+	UI_GLYPH_ATLAS_metrics_t metrics;
+	uint32_t cell_x;
+	uint32_t cell_y;
+
+	if (_glyph_atlas_sheet_get_metrics(data, character, &metrics) && _glyph_atlas_sheet_cell(sheet, character, &cell_x, &cell_y)) {
+		cell_x += (uint32_t)metrics.left;
+		cell_y += (uint32_t)metrics.top;
+		for (uint32_t y = 0; y < metrics.height; y++) {
+			uint8_t* line = &alpha[y * stride];
+			for (uint32_t x = 0; x < metrics.width; x++) {
+				line[x] = _glyph_atlas_sheet_alpha(sheet, cell_x + x, cell_y + y);
+			}
+		}
+	}
+}
+
+// --------------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+bool UI_GLYPH_ATLAS_SHEET_initialize(UI_GLYPH_ATLAS_SHEET_t* sheet, MICROUI_Image* image, uint32_t first, uint32_t columns, uint32_t rows) {
+	bool ret = false;
+	uint32_t bpp = 0;
+
+	if ((uint8_t)MICROUI_IMAGE_FORMAT_A8 == (uint8_t)image->format) {
+		bpp = 8;
+	}
+	else if ((uint8_t)MICROUI_IMAGE_FORMAT_A4 == (uint8_t)image->format) {
+		bpp = 4;
+	}
+	else {
+		// not a font sheet
+	}
+
+	if ((0U != bpp) && (columns > 0U) && (rows > 0U) && (columns <= (uint32_t)image->width) && (rows <= (uint32_t)image->height)) {
+		sheet->font.data = sheet;
+		sheet->font.get_metrics = &_glyph_atlas_sheet_get_metrics;
+		sheet->font.render = &_glyph_atlas_sheet_render;
+		sheet->font.bpp = bpp;
+		sheet->pixels = LLUI_DISPLAY_getBufferAddress(image);
+		sheet->stride = LLUI_DISPLAY_getStrideInBytes(image);
+		sheet->first = first;
+		sheet->count = columns * rows;
+		sheet->columns = columns;
+		sheet->cell_width = (uint32_t)image->width / columns;
+		sheet->cell_height = (uint32_t)image->height / rows;
+		sheet->id = -1;
+		// the advance is stored on 8 bits
+		ret = sheet->cell_width <= (uint32_t)UINT8_MAX;
+	}
+
+	return ret;
+}
+
+// See the header file for the function documentation
+jint Java_com_microej_ui_GlyphAtlas_registerFont(MICROUI_Image* image, jint first, jint columns, jint rows) {
+	UI_GLYPH_ATLAS_SHEET_t* sheet = NULL;
+	jint id = -1;
+
+	for (uint32_t i = 0; (NULL == sheet) && (i < UI_GLYPH_ATLAS_FONTS); i++) {
+		if (NULL == g_sheets[i].font.data) {
+			sheet = &g_sheets[i];
+		}
+	}
+
+	if ((NULL != sheet) && (first >= 0) && (columns > 0) && (rows > 0)
+			&& UI_GLYPH_ATLAS_SHEET_initialize(sheet, image, (uint32_t)first, (uint32_t)columns, (uint32_t)rows)) {
+		sheet->id = UI_GLYPH_ATLAS_register_font(&sheet->font);
+		id = sheet->id;
+		if (-1 == id) {
+			// the atlases are used by other fonts: the sheet slot stays free
+			sheet->font.data = NULL;
+		}
+	}
+
+	return id;
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_GlyphAtlas_unregisterFont(jint font) {
+	for (uint32_t i = 0; i < UI_GLYPH_ATLAS_FONTS; i++) {
+		UI_GLYPH_ATLAS_SHEET_t* sheet = &g_sheets[i];
+		if ((NULL != sheet->font.data) && (font == sheet->id)) {
+			UI_GLYPH_ATLAS_unregister_font(font);
+			sheet->font.data = NULL;
+			sheet->id = -1;
+		}
+	}
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
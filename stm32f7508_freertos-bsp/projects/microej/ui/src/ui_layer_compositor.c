@@ -0,0 +1,312 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * @file
+ * @brief Implementation of the layer compositor (see ui_layer_compositor.h).
+ *
+ * The compositor keeps the buffer of each layer, not its image: the Java objects given to
+ * the natives can move between two natives but the buffer of a mutable image does not
+ * move until the image is closed.
+ *
+ * @author MicroEJ Developer Team
+ * @version 4.1.0
+ */
+
+// --------------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <LLUI_DISPLAY.h>
+
+#include "ui_layer_compositor.h"
+#include "ui_drawing_dma2d.h"
+#include "display_dirty_regions.h"
+#include "ui_display_list.h"
+
+// --------------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief An attached layer.
+ */
+typedef struct {
+	uint8_t* buffer; // NULL when the layer is not attached
+	uint32_t stride; // in pixels
+	jbyte format;
+	jint width;
+	jint height;
+	jint x;
+	jint y;
+	jint alpha;
+	jint color;
+} compositor_layer_t;
+
+/*
+ * @brief A region of a layer to blend (coordinates in the display, included).
+ */
+typedef struct {
+	compositor_layer_t* layer;
+	jint x1;
+	jint y1;
+	jint x2;
+	jint y2;
+} compositor_region_t;
+
+// --------------------------------------------------------------------------------
+// Private fields
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief The layers and their order (bottom to top): indices in g_layers.
+ */
+static compositor_layer_t g_layers[UI_LAYER_COMPOSITOR_LAYERS];
+static uint8_t g_order[UI_LAYER_COMPOSITOR_LAYERS];
+static uint32_t g_count;
+
+/*
+ * @brief Compositor counters (see UI_LAYER_COMPOSITOR_get_statistics()).
+ */
+static UI_LAYER_COMPOSITOR_statistics_t g_statistics;
+
+// --------------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------------
+
+/*
+ * @brief Gets an attached layer.
+ *
+ * @return NULL when the identifier is not valid.
+ */
+static compositor_layer_t* _compositor_get(jint layer) {
+	compositor_layer_t* ret = NULL;
+	if ((layer >= 0) && ((uint32_t)layer < UI_LAYER_COMPOSITOR_LAYERS) && (NULL != g_layers[layer].buffer)) {
+		ret = &g_layers[layer];
+	}
+	return ret;
+}
+
+// --------------------------------------------------------------------------------
+// ui_layer_compositor.h functions
+// --------------------------------------------------------------------------------
+
+// See the header file for the function documentation
+jint UI_LAYER_COMPOSITOR_attach(MICROUI_Image* image, jint x, jint y) {
+	jint ret = -1;
+
+	if (((jbyte)MICROUI_IMAGE_FORMAT_A8 == image->format) || ((jbyte)MICROUI_IMAGE_FORMAT_ARGB4444 == image->format)) {
+		for (uint32_t i = 0; (ret < 0) && (i < UI_LAYER_COMPOSITOR_LAYERS); i++) {
+			compositor_layer_t* layer = &g_layers[i];
+			if (NULL == layer->buffer) {
+				layer->buffer = LLUI_DISPLAY_getBufferAddress(image);
+				layer->stride = LLUI_DISPLAY_getStrideInPixels(image);
+				layer->format = image->format;
+				layer->width = (jint)image->width;
+				layer->height = (jint)image->height;
+				layer->x = x;
+				layer->y = y;
+				layer->alpha = 0xff;
+				layer->color = 0xffffff;
+				g_order[g_count] = (uint8_t)i;
+				g_count++;
+				ret = (jint)i;
+			}
+		}
+	}
+
+	return ret;
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_detach(jint layer) {
+	compositor_layer_t* l = _compositor_get(layer);
+	if (NULL != l) {
+		l->buffer = NULL;
+		uint32_t j = 0;
+		for (uint32_t i = 0; i < g_count; i++) {
+			if ((jint)g_order[i] != layer) {
+				g_order[j] = g_order[i];
+				j++;
+			}
+		}
+		g_count = j;
+	}
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_move(jint layer, jint x, jint y) {
+	compositor_layer_t* l = _compositor_get(layer);
+	if (NULL != l) {
+		l->x = x;
+		l->y = y;
+	}
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_set_opacity(jint layer, jint alpha) {
+	compositor_layer_t* l = _compositor_get(layer);
+	if (NULL != l) {
+		l->alpha = (alpha < 0) ? 0 : ((alpha > 0xff) ? 0xff : alpha);
+	}
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_set_color(jint layer, jint color) {
+	compositor_layer_t* l = _compositor_get(layer);
+	if (NULL != l) {
+		l->color = color & 0xffffff;
+	}
+}
+
+// See the header file for the function documentation
+DRAWING_Status UI_LAYER_COMPOSITOR_compose(MICROUI_GraphicsContext* gc) {
+	DRAWING_Status status = DRAWING_DONE;
+
+	if (!LLUI_DISPLAY_isDisplayFormat(gc->image.format)) {
+		// the DMA2D blends the layers in the display format only
+		LLUI_DISPLAY_reportError(gc, DRAWING_LOG_FORBIDDEN);
+	}
+	else {
+		compositor_region_t regions[UI_LAYER_COMPOSITOR_LAYERS];
+		uint32_t count = 0;
+		jint x1 = gc->clip_x2;
+		jint y1 = gc->clip_y2;
+		jint x2 = gc->clip_x1;
+		jint y2 = gc->clip_y1;
+
+		// visible regions of the layers in the clip
+		for (uint32_t i = 0; i < g_count; i++) {
+			compositor_layer_t* layer = &g_layers[g_order[i]];
+			compositor_region_t* region = &regions[count];
+			region->layer = layer;
+			region->x1 = (layer->x > gc->clip_x1) ? layer->x : gc->clip_x1;
+			region->y1 = (layer->y > gc->clip_y1) ? layer->y : gc->clip_y1;
+			region->x2 = ((layer->x + layer->width - 1) < gc->clip_x2) ? (layer->x + layer->width - 1) : gc->clip_x2;
+			region->y2 = ((layer->y + layer->height - 1) < gc->clip_y2) ? (layer->y + layer->height - 1) : gc->clip_y2;
+			if ((layer->alpha > 0) && (region->x1 <= region->x2) && (region->y1 <= region->y2)) {
+				x1 = (region->x1 < x1) ? region->x1 : x1;
+				y1 = (region->y1 < y1) ? region->y1 : y1;
+				x2 = (region->x2 > x2) ? region->x2 : x2;
+				y2 = (region->y2 > y2) ? region->y2 : y2;
+				count++;
+			}
+		}
+
+		if (count > 0U) {
+			if (LLUI_DISPLAY_isLCD(&gc->image)) {
+				DISPLAY_DIRTY_REGIONS_add((uint32_t)x1, (uint32_t)y1, (uint32_t)x2, (uint32_t)y2);
+			}
+			UI_DISPLAY_LIST_notify_drawing(&gc->image, x1, y1, x2, y2);
+
+			// one DMA2D job per layer, the last one notifies the Graphics Engine
+			UI_DRAWING_DMA2D_start_tiles(gc, x1, y1, x2, y2);
+			for (uint32_t i = 0; i < count; i++) {
+				compositor_region_t* region = &regions[i];
+				compositor_layer_t* layer = region->layer;
+				jint width = region->x2 - region->x1 + 1;
+				jint height = region->y2 - region->y1 + 1;
+				(void)UI_DRAWING_DMA2D_blend_layer(gc, layer->buffer, layer->stride, layer->format, region->x1 - layer->x, region->y1 - layer->y, width, height, region->x1, region->y1, layer->alpha, layer->color, i == (count - 1U));
+				g_statistics.pixels += (uint32_t)width * (uint32_t)height;
+			}
+			g_statistics.compositions++;
+			g_statistics.blendings += count;
+			status = DRAWING_RUNNING;
+		}
+	}
+
+	return status;
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_free_image(MICROUI_Image* image) {
+	uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(image);
+	for (uint32_t i = 0; i < UI_LAYER_COMPOSITOR_LAYERS; i++) {
+		if (buffer == g_layers[i].buffer) {
+			UI_LAYER_COMPOSITOR_detach((jint)i);
+		}
+	}
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_get_statistics(UI_LAYER_COMPOSITOR_statistics_t* statistics) {
+	*statistics = g_statistics;
+}
+
+// See the header file for the function documentation
+void UI_LAYER_COMPOSITOR_reset_statistics(void) {
+	(void)memset(&g_statistics, 0, sizeof(g_statistics));
+}
+
+// See the header file for the function documentation
+jint Java_com_microej_ui_LayerCompositor_attach(MICROUI_Image* image, jint x, jint y) {
+	return UI_LAYER_COMPOSITOR_attach(image, x, y);
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_LayerCompositor_detach(jint layer) {
+	UI_LAYER_COMPOSITOR_detach(layer);
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_LayerCompositor_move(jint layer, jint x, jint y) {
+	UI_LAYER_COMPOSITOR_move(layer, x, y);
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_LayerCompositor_setOpacity(jint layer, jint alpha) {
+	UI_LAYER_COMPOSITOR_set_opacity(layer, alpha);
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_LayerCompositor_setColor(jint layer, jint color) {
+	UI_LAYER_COMPOSITOR_set_color(layer, color);
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_LayerCompositor_compose(MICROUI_GraphicsContext* gc) {
+	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&Java_com_microej_ui_LayerCompositor_compose)) {
+		LLUI_DISPLAY_setDrawingStatus(UI_LAYER_COMPOSITOR_compose(gc));
+	}
+}
+
+// See the header file for the function documentation
+void Java_com_microej_ui_LayerCompositor_clear(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height) {
+	if (LLUI_DISPLAY_requestDrawing(gc, (SNI_callback)&Java_com_microej_ui_LayerCompositor_clear)) {
+		DRAWING_Status status = DRAWING_DONE;
+		jint x1 = x;
+		jint y1 = y;
+		jint x2 = x + width - 1;
+		jint y2 = y + height - 1;
+
+		if ((width > 0) && (height > 0) && LLUI_DISPLAY_clipRectangle(gc, &x1, &y1, &x2, &y2)) {
+			if ((jbyte)MICROUI_IMAGE_FORMAT_ARGB4444 == gc->image.format) {
+				status = UI_DRAWING_DMA2D_fill_layer(gc, x1, y1, x2, y2, 0);
+			}
+			else if ((jbyte)MICROUI_IMAGE_FORMAT_A8 == gc->image.format) {
+				// the DMA2D cannot write in the A8 format
+				uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(&gc->image);
+				uint32_t stride = LLUI_DISPLAY_getStrideInPixels(&gc->image);
+				LLUI_DISPLAY_setDrawingLimits(x1, y1, x2, y2);
+				for (jint line = y1; line <= y2; line++) {
+					(void)memset(buffer + ((uint32_t)line * stride) + (uint32_t)x1, 0, (uint32_t)(x2 - x1) + 1U);
+				}
+			}
+			else {
+				LLUI_DISPLAY_reportError(gc, DRAWING_LOG_FORBIDDEN);
+			}
+		}
+
+		LLUI_DISPLAY_setDrawingStatus(status);
+	}
+}
+
+// --------------------------------------------------------------------------------
+// EOF
+// --------------------------------------------------------------------------------
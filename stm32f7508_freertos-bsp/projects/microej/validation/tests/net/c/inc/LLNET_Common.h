@@ -0,0 +1,63 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef LLNET_COMMON_H
+#define LLNET_COMMON_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/*
+ * Host version of the LLNET common definitions used by async_select.c: the BSD sockets
+ * of the host replace lwIP and the file descriptors of the host are indexed (0 to
+ * FD_SETSIZE - 1).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sni.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "async_select.h"
+
+#define LLNET_SOCKFD_START_IDX (0)
+#define LLNET_MAX_SOCKETS (FD_SETSIZE)
+
+#define LLNET_AF_IPV4	(0x1)
+#define LLNET_AF_IPV6	(0x2)
+#define LLNET_AF (LLNET_AF_IPV4)
+
+#define llnet_bind			bind
+#define llnet_close			close
+#define llnet_htonl			htonl
+#define llnet_htons			htons
+#define llnet_listen		listen
+#define llnet_socket		socket
+#define llnet_errno(fd)		((int32_t)errno)
+
+#define LLNET_DEBUG_TRACE(...) ((void) 0)
+
+/**
+ * @brief Sets the given file descriptor in non-blocking mode.
+ *
+ * @return 0 on success, a negative value on error.
+ */
+int32_t LLNET_set_non_blocking(int32_t fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
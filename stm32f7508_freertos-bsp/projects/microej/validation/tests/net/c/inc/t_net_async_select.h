@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_NET_ASYNC_SELECT_H
+#define __T_NET_ASYNC_SELECT_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the requests index of async_select (async_select.c): read and
+ *  write requests on the same socket, requests removed by their scoped resource (even
+ *  when the request has been allocated again), the order of the timeouts given by the
+ *  timeout heap, the closed file descriptors and the rejected requests (file descriptor
+ *  out of ASYNC_SELECT_FD_INDEX_START/SIZE, pool exhausted). It prints the bookkeeping time
+ *  of a wakeup (select() stubbed) with 500 and 1000 idle requests when the ready file
+ *  descriptor is the highest or the lowest one.
+ */
+TestRef T_NET_ASYNC_SELECT_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
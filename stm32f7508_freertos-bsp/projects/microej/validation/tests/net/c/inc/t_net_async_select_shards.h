@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_NET_ASYNC_SELECT_SHARDS_H
+#define __T_NET_ASYNC_SELECT_SHARDS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the async_select shards (async_select.c): the shard of a file
+ *  descriptor ((fd - ASYNC_SELECT_FD_INDEX_START) % ASYNC_SELECT_SHARD_COUNT), a ready
+ *  socket found by the task of its shard only and the fairness counters with their reset.
+ *  It prints the wakeup latency of a probe socket while 8 always ready sockets flood the
+ *  shard 0 (one host thread per async_select task).
+ */
+TestRef T_NET_ASYNC_SELECT_SHARDS_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_NET_MAIN_H
+#define __T_NET_MAIN_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* public function declaration */
+
+/**
+ * @brief this function is the entry point for the NET port test suite. The tests check
+ * async_select.c with the sockets of the host instead of lwIP; they run on a Linux host
+ * (see x_net_host.c and LLNET_Common.h):
+ *
+ * gcc -pthread -I inc -I ../../../../SW4STM32/platform/inc -idirafter ../../../../net/inc
+ *     $(find src ../../../framework/c/embunit/embUnit -name "*.c") -o t_net && ./t_net
+ *
+ * The BSP headers of the net folder are searched after the host headers (the BSP provides
+ * its own unistd.h and netinet/in.h for lwIP). async_select runs 4 shards; add
+ * -DX_NET_ASYNC_SELECT_SHARD_COUNT=1 for a single async_select task like the BSP.
+ *
+ * By default, the executed test sequence is :
+ *		-# the async_select requests index tests and bookkeeping benchmark
+ *		-# the async_select shards tests and probe latency benchmark (host threads)
+ */
+void T_NET_main(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
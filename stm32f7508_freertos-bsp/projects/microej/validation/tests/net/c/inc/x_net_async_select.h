@@ -0,0 +1,83 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_NET_ASYNC_SELECT_H
+#define __X_NET_ASYNC_SELECT_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sys/select.h>
+#include "LLNET_Common.h"
+#include "async_select.h"
+#include "async_select_configuration.h"
+
+/*
+ * async_select.c is built with the BSP configuration (async_select_configuration.h) and
+ * the host file descriptors (see LLNET_Common.h); the host build selects the pipe
+ * notification. The pool of requests holds the idle requests of the benchmarks.
+ */
+#undef MAX_NB_ASYNC_SELECT
+#define MAX_NB_ASYNC_SELECT (1024)
+
+/**
+ * @brief Number of async_select shards of the host build: the highest one by default, set
+ * -DX_NET_ASYNC_SELECT_SHARD_COUNT=1 to run the tests and the benchmarks with a single
+ * async_select task like the BSP.
+ */
+#ifndef X_NET_ASYNC_SELECT_SHARD_COUNT
+#define X_NET_ASYNC_SELECT_SHARD_COUNT (4)
+#endif
+#undef ASYNC_SELECT_SHARD_COUNT
+#define ASYNC_SELECT_SHARD_COUNT X_NET_ASYNC_SELECT_SHARD_COUNT
+
+/**
+ * @brief Resets async_select: no request, the notification pipes are closed and the
+ * counters of the shards are cleared.
+ */
+void X_NET_ASYNC_SELECT_reset(void);
+
+/**
+ * @brief Runs one loop of the async_select task of the given shard (select() then the
+ * update of the requests). The shard is notified first so that select() returns at once
+ * when no file descriptor is ready.
+ */
+void X_NET_ASYNC_SELECT_wakeup(int32_t shard);
+
+/**
+ * @brief Replaces select() by a stub that returns at once with the given ready file
+ * descriptors (read operations), to measure the bookkeeping of async_select only.
+ *
+ * @param ready_fds the file descriptors ready for read
+ * @param ready_count the number of file descriptors in ready_fds
+ */
+void X_NET_ASYNC_SELECT_stub_select(const fd_set* ready_fds, int32_t ready_count);
+
+/**
+ * @brief Gives select() back to the host.
+ */
+void X_NET_ASYNC_SELECT_release_select(void);
+
+/**
+ * @brief Starts the async_select tasks (one host thread per shard).
+ */
+void X_NET_ASYNC_SELECT_start_tasks(void);
+
+/**
+ * @brief Stops the async_select tasks (cancelled in select()). No request must wait.
+ */
+void X_NET_ASYNC_SELECT_stop_tasks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_NET_HOST_H
+#define __X_NET_HOST_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Number of Java threads simulated by the SNI stubs (identifiers 0 to
+ * X_NET_HOST_THREADS - 1).
+ */
+#define X_NET_HOST_THREADS 16
+
+/**
+ * @brief Number of resumed Java threads kept in order (see X_NET_HOST_get_resumed()).
+ */
+#define X_NET_HOST_RESUMES 64U
+
+/**
+ * @brief Resets the SNI stubs: no resumed thread, no exception, no scoped resource, the
+ * suspend succeeds and the system time is 0.
+ */
+void X_NET_HOST_reset(void);
+
+/**
+ * @brief Sets the identifier of the Java thread run by the calling host thread (SNI_ERROR
+ * when the caller is not the VM task).
+ */
+void X_NET_HOST_set_thread(int32_t thread);
+
+/**
+ * @brief Sets the system time returned by LLMJVM_IMPL_getCurrentTime__Z() in milliseconds.
+ */
+void X_NET_HOST_set_time(int64_t time_ms);
+
+/**
+ * @brief Makes SNI_suspendCurrentJavaThreadWithCallback() fail.
+ */
+void X_NET_HOST_set_suspend_error(bool error);
+
+/**
+ * @brief Closes the scoped resource of the given Java thread like the VM does when the
+ * native method returns.
+ */
+void X_NET_HOST_close_scoped_resource(int32_t thread);
+
+/**
+ * @brief Gets the Java threads resumed since the last reset, in the order of the resumes.
+ *
+ * @param threads the resumed threads (the first X_NET_HOST_RESUMES ones)
+ * @param size the size of threads
+ *
+ * @return the number of resumes
+ */
+uint32_t X_NET_HOST_get_resumed(int32_t* threads, uint32_t size);
+
+/**
+ * @brief Waits until the given Java thread is resumed (one resume is consumed per call).
+ */
+void X_NET_HOST_wait_resumed(int32_t thread);
+
+/**
+ * @brief Returns the number of NativeIOException thrown since the last reset.
+ */
+uint32_t X_NET_HOST_get_exceptions(void);
+
+/**
+ * @brief Returns the time of the host monotonic clock in nanoseconds.
+ */
+uint64_t X_NET_HOST_get_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
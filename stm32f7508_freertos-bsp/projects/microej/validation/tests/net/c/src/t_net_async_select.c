@@ -0,0 +1,246 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_net_async_select.h"
+#include "x_net_async_select.h"
+#include "x_net_host.h"
+
+/*
+ * The requests on the sockets of the host are done by X_NET_ASYNC_SELECT_wakeup() (the
+ * loop of the tasks); the other tests use file descriptors which are not opened (from
+ * T_NET_ASYNC_SELECT_FD) and never reach select().
+ */
+#define T_NET_ASYNC_SELECT_FD 100
+#define T_NET_ASYNC_SELECT_BENCHMARK_LOOPS 20000U
+
+static int32_t T_NET_ASYNC_SELECT_request(int32_t thread, int32_t fd, select_operation operation, int64_t timeout_ms)
+{
+	X_NET_HOST_set_thread(thread);
+	return async_select(fd, operation, timeout_ms, NULL, NULL);
+}
+
+static int32_t T_NET_ASYNC_SELECT_shard(int32_t fd)
+{
+	return (fd - ASYNC_SELECT_FD_INDEX_START) % ASYNC_SELECT_SHARD_COUNT;
+}
+
+/*
+ * The requests waiting in all the shards.
+ */
+static uint32_t T_NET_ASYNC_SELECT_used(void)
+{
+	async_select_shard_statistics_t statistics;
+	uint32_t used = 0;
+	for (int32_t i = 0; i < ASYNC_SELECT_SHARD_COUNT; i++)
+	{
+		(void)async_select_get_shard_statistics(i, &statistics, 0);
+		used += statistics.used;
+	}
+	return used;
+}
+
+static void T_NET_ASYNC_SELECT_setUp(void)
+{
+	X_NET_HOST_reset();
+	X_NET_ASYNC_SELECT_reset();
+}
+
+static void T_NET_ASYNC_SELECT_tearDown(void)
+{
+	X_NET_ASYNC_SELECT_release_select();
+}
+
+static void T_NET_ASYNC_SELECT_addRemove(void)
+{
+	int a[2];
+	int b[2];
+	int32_t resumed[X_NET_HOST_RESUMES];
+
+	TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, a));
+	TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, b));
+
+	// read and write on the same socket
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(1, a[0], SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(2, a[0], SELECT_WRITE, 0));
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(3, b[0], SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(3, T_NET_ASYNC_SELECT_used());
+
+	// a connected socket can be written at once, the read waits for data
+	X_NET_ASYNC_SELECT_wakeup(T_NET_ASYNC_SELECT_shard(a[0]));
+	TEST_ASSERT_EQUAL_INT(1, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+	TEST_ASSERT_EQUAL_INT(2, resumed[0]);
+
+	TEST_ASSERT_EQUAL_INT(1, write(a[1], "x", 1));
+	X_NET_ASYNC_SELECT_wakeup(T_NET_ASYNC_SELECT_shard(a[0]));
+	TEST_ASSERT_EQUAL_INT(2, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+	TEST_ASSERT_EQUAL_INT(1, resumed[1]);
+	TEST_ASSERT_EQUAL_INT(1, T_NET_ASYNC_SELECT_used());
+
+	// the native method returns before the socket is ready: its request is removed
+	X_NET_HOST_close_scoped_resource(1);
+	X_NET_HOST_close_scoped_resource(2);
+	X_NET_HOST_close_scoped_resource(3);
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_used());
+
+	TEST_ASSERT_EQUAL_INT(1, write(b[1], "x", 1));
+	X_NET_ASYNC_SELECT_wakeup(T_NET_ASYNC_SELECT_shard(b[0]));
+	TEST_ASSERT_EQUAL_INT(2, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+
+	(void)close(a[0]);
+	(void)close(a[1]);
+	(void)close(b[0]);
+	(void)close(b[1]);
+}
+
+static void T_NET_ASYNC_SELECT_timeouts(void)
+{
+	static const int64_t timeouts[] = { 500, 100, 300, 0, 200, 400 };
+	int32_t resumed[X_NET_HOST_RESUMES];
+
+	// the file descriptors of one shard: one timeout heap
+	for (int32_t i = 0; i < 6; i++)
+	{
+		int32_t fd = T_NET_ASYNC_SELECT_FD + (i * ASYNC_SELECT_SHARD_COUNT);
+		TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(i + 1, fd, SELECT_READ, timeouts[i]));
+	}
+
+	// removed from the middle of the heap
+	X_NET_HOST_close_scoped_resource(3);
+	// no timeout: the closed file descriptor is given the lowest timeout
+	async_select_notify_closed_fd(T_NET_ASYNC_SELECT_FD + (3 * ASYNC_SELECT_SHARD_COUNT));
+
+	X_NET_HOST_set_time(250);
+	async_select_update_notified_requests(-1, 0, 0, 0);
+	TEST_ASSERT_EQUAL_INT(3, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+	TEST_ASSERT_EQUAL_INT(4, resumed[0]);
+	TEST_ASSERT_EQUAL_INT(2, resumed[1]);
+	TEST_ASSERT_EQUAL_INT(5, resumed[2]);
+
+	X_NET_HOST_set_time(450);
+	async_select_update_notified_requests(-1, 0, 0, 0);
+	TEST_ASSERT_EQUAL_INT(4, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+	TEST_ASSERT_EQUAL_INT(6, resumed[3]);
+
+	X_NET_HOST_set_time(1000);
+	async_select_update_notified_requests(-1, 0, 0, 0);
+	TEST_ASSERT_EQUAL_INT(5, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+	TEST_ASSERT_EQUAL_INT(1, resumed[4]);
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_used());
+}
+
+static void T_NET_ASYNC_SELECT_errors(void)
+{
+	// not called by the VM task
+	TEST_ASSERT_EQUAL_INT(-1, T_NET_ASYNC_SELECT_request(SNI_ERROR, T_NET_ASYNC_SELECT_FD, SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(0, X_NET_HOST_get_exceptions());
+
+	// the file descriptors out of the index
+	TEST_ASSERT_EQUAL_INT(-1, T_NET_ASYNC_SELECT_request(1, ASYNC_SELECT_FD_INDEX_START - 1, SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(-1, T_NET_ASYNC_SELECT_request(1, ASYNC_SELECT_FD_INDEX_START + ASYNC_SELECT_FD_INDEX_SIZE, SELECT_WRITE, 0));
+	TEST_ASSERT_EQUAL_INT(2, X_NET_HOST_get_exceptions());
+
+	// the request is freed when the thread cannot be suspended
+	X_NET_HOST_set_suspend_error(true);
+	TEST_ASSERT_EQUAL_INT(-1, T_NET_ASYNC_SELECT_request(1, T_NET_ASYNC_SELECT_FD, SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(3, X_NET_HOST_get_exceptions());
+	X_NET_HOST_set_suspend_error(false);
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_used());
+
+	// pool exhausted
+	for (int32_t i = 0; i < MAX_NB_ASYNC_SELECT; i++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(1, T_NET_ASYNC_SELECT_FD + (i % 500), SELECT_READ, 1000 + i));
+	}
+	TEST_ASSERT_EQUAL_INT(-1, T_NET_ASYNC_SELECT_request(1, T_NET_ASYNC_SELECT_FD, SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(4, X_NET_HOST_get_exceptions());
+	TEST_ASSERT_EQUAL_INT(MAX_NB_ASYNC_SELECT, T_NET_ASYNC_SELECT_used());
+}
+
+static void T_NET_ASYNC_SELECT_handle(void)
+{
+	int32_t resumed[X_NET_HOST_RESUMES];
+
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(1, T_NET_ASYNC_SELECT_FD, SELECT_READ, 10));
+	X_NET_HOST_set_time(20);
+	async_select_update_notified_requests(-1, 0, 0, 0);
+	TEST_ASSERT_EQUAL_INT(1, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+
+	// the request of the thread 1 is allocated again before its scoped resource is closed
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(2, T_NET_ASYNC_SELECT_FD + 1, SELECT_READ, 0));
+	X_NET_HOST_close_scoped_resource(1);
+	TEST_ASSERT_EQUAL_INT(1, T_NET_ASYNC_SELECT_used());
+
+	async_select_update_notified_requests(T_NET_ASYNC_SELECT_FD + 1, 1, 0, 0);
+	TEST_ASSERT_EQUAL_INT(2, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+	TEST_ASSERT_EQUAL_INT(2, resumed[1]);
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_used());
+}
+
+/*
+ * Idle requests (with a timeout far away) on consecutive file descriptors and one request
+ * ready at each wakeup on the lowest or the highest file descriptor.
+ */
+static void T_NET_ASYNC_SELECT_bookkeeping(int32_t idle, bool hot_highest)
+{
+	int32_t hot_fd = hot_highest ? (ASYNC_SELECT_FD_INDEX_START + idle + 1) : (ASYNC_SELECT_FD_INDEX_START + 1);
+	int32_t idle_fd = hot_highest ? (ASYNC_SELECT_FD_INDEX_START + 1) : (ASYNC_SELECT_FD_INDEX_START + 2);
+	fd_set ready_fds;
+	uint64_t total_ns = 0;
+
+	X_NET_HOST_reset();
+	X_NET_ASYNC_SELECT_reset();
+	for (int32_t i = 0; i < idle; i++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(1, idle_fd + i, SELECT_READ, 1000000));
+	}
+
+	FD_ZERO(&ready_fds);
+	FD_SET(hot_fd, &ready_fds);
+	X_NET_ASYNC_SELECT_stub_select(&ready_fds, 1);
+	for (uint32_t i = 0; i < T_NET_ASYNC_SELECT_BENCHMARK_LOOPS; i++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_request(2, hot_fd, SELECT_READ, 0));
+		uint64_t t0 = X_NET_HOST_get_time_ns();
+		X_NET_ASYNC_SELECT_wakeup(T_NET_ASYNC_SELECT_shard(hot_fd));
+		total_ns += X_NET_HOST_get_time_ns() - t0;
+	}
+	X_NET_ASYNC_SELECT_release_select();
+
+	TEST_ASSERT_EQUAL_INT(T_NET_ASYNC_SELECT_BENCHMARK_LOOPS, X_NET_HOST_get_resumed(NULL, 0));
+	TEST_ASSERT_EQUAL_INT((uint32_t)idle, T_NET_ASYNC_SELECT_used());
+
+	uint32_t ns = (uint32_t)(total_ns / T_NET_ASYNC_SELECT_BENCHMARK_LOOPS);
+	printf("%4d idle requests, hot fd %s: %u.%02u us per wakeup\n", (int)idle, hot_highest ? "highest" : "lowest ",
+			(unsigned int)(ns / 1000U), (unsigned int)((ns % 1000U) / 10U));
+}
+
+static void T_NET_ASYNC_SELECT_benchmark(void)
+{
+	printf("async_select bookkeeping, select() stubbed, %d shard(s)\n", ASYNC_SELECT_SHARD_COUNT);
+	T_NET_ASYNC_SELECT_bookkeeping(500, true);
+	T_NET_ASYNC_SELECT_bookkeeping(500, false);
+	T_NET_ASYNC_SELECT_bookkeeping(1000, true);
+	T_NET_ASYNC_SELECT_bookkeeping(1000, false);
+}
+
+TestRef T_NET_ASYNC_SELECT_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Add and remove", T_NET_ASYNC_SELECT_addRemove),
+		new_TestFixture("Timeouts order", T_NET_ASYNC_SELECT_timeouts),
+		new_TestFixture("Errors", T_NET_ASYNC_SELECT_errors),
+		new_TestFixture("Request handle", T_NET_ASYNC_SELECT_handle),
+		new_TestFixture("Bookkeeping benchmark", T_NET_ASYNC_SELECT_benchmark),
+	};
+
+	EMB_UNIT_TESTCALLER(asyncSelectTest, "Async_select_tests", T_NET_ASYNC_SELECT_setUp, T_NET_ASYNC_SELECT_tearDown, fixtures);
+
+	return (TestRef)&asyncSelectTest;
+}
@@ -0,0 +1,293 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/socket.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_net_async_select_shards.h"
+#include "x_net_async_select.h"
+#include "x_net_host.h"
+
+/*
+ * The file descriptors from T_NET_ASYNC_SELECT_SHARDS_FD are not opened and never reach
+ * select().
+ */
+#define T_NET_ASYNC_SELECT_SHARDS_FD 100
+#define T_NET_ASYNC_SELECT_SHARDS_FLOODERS 8
+#define T_NET_ASYNC_SELECT_SHARDS_PROBE_THREAD (T_NET_ASYNC_SELECT_SHARDS_FLOODERS + 1)
+#define T_NET_ASYNC_SELECT_SHARDS_PROBES 1000U
+
+static atomic_bool flooding;
+static int flood_fds[T_NET_ASYNC_SELECT_SHARDS_FLOODERS][2];
+
+static int32_t T_NET_ASYNC_SELECT_SHARDS_request(int32_t thread, int32_t fd, select_operation operation, int64_t timeout_ms)
+{
+	X_NET_HOST_set_thread(thread);
+	return async_select(fd, operation, timeout_ms, NULL, NULL);
+}
+
+static int32_t T_NET_ASYNC_SELECT_SHARDS_shard(int32_t fd)
+{
+	return (fd - ASYNC_SELECT_FD_INDEX_START) % ASYNC_SELECT_SHARD_COUNT;
+}
+
+/*
+ * Moves the socket to a file descriptor of the given shard.
+ */
+static int T_NET_ASYNC_SELECT_SHARDS_move(int fd, int32_t shard)
+{
+	int target = fd + 1;
+	while (T_NET_ASYNC_SELECT_SHARDS_shard(fd) != shard)
+	{
+		int moved = fcntl(fd, F_DUPFD, target);
+		if (T_NET_ASYNC_SELECT_SHARDS_shard(moved) == shard)
+		{
+			(void)close(fd);
+			fd = moved;
+		}
+		else
+		{
+			(void)close(moved);
+			target = moved + 1;
+		}
+	}
+	return fd;
+}
+
+static void T_NET_ASYNC_SELECT_SHARDS_setUp(void)
+{
+	X_NET_HOST_reset();
+	X_NET_ASYNC_SELECT_reset();
+}
+
+static void T_NET_ASYNC_SELECT_SHARDS_tearDown(void)
+{
+
+}
+
+static void T_NET_ASYNC_SELECT_SHARDS_distribution(void)
+{
+	async_select_shard_statistics_t statistics;
+	uint32_t used[ASYNC_SELECT_SHARD_COUNT] = { 0 };
+	uint32_t ready[ASYNC_SELECT_SHARD_COUNT] = { 0 };
+
+	for (int32_t i = 0; i < 8; i++)
+	{
+		int32_t fd = T_NET_ASYNC_SELECT_SHARDS_FD + i;
+		TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_SHARDS_request(i + 1, fd, SELECT_READ, 0));
+		used[T_NET_ASYNC_SELECT_SHARDS_shard(fd)]++;
+	}
+	for (int32_t i = 0; i < 8; i += 2)
+	{
+		int32_t fd = T_NET_ASYNC_SELECT_SHARDS_FD + i;
+		async_select_update_notified_requests(fd, 1, 0, 0);
+		used[T_NET_ASYNC_SELECT_SHARDS_shard(fd)]--;
+		ready[T_NET_ASYNC_SELECT_SHARDS_shard(fd)]++;
+	}
+
+	for (int32_t s = 0; s < ASYNC_SELECT_SHARD_COUNT; s++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, async_select_get_shard_statistics(s, &statistics, 0));
+		TEST_ASSERT_EQUAL_INT(used[s], statistics.used);
+		TEST_ASSERT_EQUAL_INT(ready[s], statistics.ready);
+		uint32_t requests = used[s] + ready[s];
+		TEST_ASSERT_EQUAL_INT(requests, statistics.requests);
+	}
+	TEST_ASSERT_EQUAL_INT(-1, async_select_get_shard_statistics(-1, &statistics, 0));
+	TEST_ASSERT_EQUAL_INT(-1, async_select_get_shard_statistics(ASYNC_SELECT_SHARD_COUNT, &statistics, 0));
+}
+
+/*
+ * A ready socket is found by the task of its shard only.
+ */
+static void T_NET_ASYNC_SELECT_SHARDS_tasks(void)
+{
+	async_select_shard_statistics_t statistics;
+	int32_t resumed[X_NET_HOST_RESUMES];
+	int a[2];
+	int b[2];
+
+	TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, a));
+	TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, b));
+	int32_t shard_a = T_NET_ASYNC_SELECT_SHARDS_shard(a[0]);
+	int32_t shard_b = (shard_a + 1) % ASYNC_SELECT_SHARD_COUNT;
+	b[0] = T_NET_ASYNC_SELECT_SHARDS_move(b[0], shard_b);
+
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_SHARDS_request(1, a[0], SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_SHARDS_request(2, b[0], SELECT_READ, 0));
+	TEST_ASSERT_EQUAL_INT(1, write(a[1], "x", 1));
+	TEST_ASSERT_EQUAL_INT(1, write(b[1], "x", 1));
+
+	X_NET_ASYNC_SELECT_wakeup(shard_b);
+	if (shard_a != shard_b)
+	{
+		TEST_ASSERT_EQUAL_INT(1, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+		TEST_ASSERT_EQUAL_INT(2, resumed[0]);
+		TEST_ASSERT_EQUAL_INT(0, async_select_get_shard_statistics(shard_a, &statistics, 0));
+		TEST_ASSERT_EQUAL_INT(0, statistics.selects);
+		TEST_ASSERT_EQUAL_INT(1, statistics.used);
+
+		X_NET_ASYNC_SELECT_wakeup(shard_a);
+	}
+	// a single shard: both sockets are found by the same task
+	TEST_ASSERT_EQUAL_INT(2, X_NET_HOST_get_resumed(resumed, X_NET_HOST_RESUMES));
+
+	(void)close(a[0]);
+	(void)close(a[1]);
+	(void)close(b[0]);
+	(void)close(b[1]);
+}
+
+static void T_NET_ASYNC_SELECT_SHARDS_statistics(void)
+{
+	async_select_shard_statistics_t statistics;
+	int32_t fd = T_NET_ASYNC_SELECT_SHARDS_FD;
+	int32_t shard = T_NET_ASYNC_SELECT_SHARDS_shard(fd);
+
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_SHARDS_request(1, fd, SELECT_READ, 10));
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_SHARDS_request(2, fd, SELECT_WRITE, 20));
+	TEST_ASSERT_EQUAL_INT(0, T_NET_ASYNC_SELECT_SHARDS_request(3, fd + ASYNC_SELECT_SHARD_COUNT, SELECT_READ, 0));
+
+	X_NET_HOST_set_time(15);
+	async_select_update_notified_requests(fd + ASYNC_SELECT_SHARD_COUNT, 1, 0, 0);
+
+	TEST_ASSERT_EQUAL_INT(0, async_select_get_shard_statistics(shard, &statistics, 1));
+	TEST_ASSERT_EQUAL_INT(3, statistics.requests);
+	TEST_ASSERT_EQUAL_INT(1, statistics.ready);
+	TEST_ASSERT_EQUAL_INT(1, statistics.timeouts);
+	TEST_ASSERT_EQUAL_INT(1, statistics.used);
+	TEST_ASSERT_EQUAL_INT(3, statistics.max_used);
+
+	// the reset keeps the waiting requests
+	TEST_ASSERT_EQUAL_INT(0, async_select_get_shard_statistics(shard, &statistics, 0));
+	TEST_ASSERT_EQUAL_INT(0, statistics.requests);
+	TEST_ASSERT_EQUAL_INT(0, statistics.ready);
+	TEST_ASSERT_EQUAL_INT(0, statistics.timeouts);
+	TEST_ASSERT_EQUAL_INT(1, statistics.used);
+	TEST_ASSERT_EQUAL_INT(1, statistics.max_used);
+
+	X_NET_HOST_set_time(25);
+	async_select_update_notified_requests(-1, 0, 0, 0);
+	TEST_ASSERT_EQUAL_INT(0, async_select_get_shard_statistics(shard, &statistics, 0));
+	TEST_ASSERT_EQUAL_INT(1, statistics.timeouts);
+	TEST_ASSERT_EQUAL_INT(0, statistics.used);
+	TEST_ASSERT_EQUAL_INT(1, statistics.max_used);
+}
+
+/*
+ * A Java thread waiting in loop on an always ready socket of the shard 0.
+ */
+static void* T_NET_ASYNC_SELECT_SHARDS_flooder(void* arg)
+{
+	int32_t flooder = (int32_t)(uintptr_t)arg;
+	int32_t thread = flooder + 1;
+
+	X_NET_HOST_set_thread(thread);
+	while (atomic_load(&flooding))
+	{
+		(void)async_select(flood_fds[flooder][0], SELECT_READ, 0, NULL, NULL);
+		X_NET_HOST_wait_resumed(thread);
+	}
+	return NULL;
+}
+
+static int T_NET_ASYNC_SELECT_SHARDS_compare(const void* a, const void* b)
+{
+	uint32_t latency_a = *(const uint32_t*)a;
+	uint32_t latency_b = *(const uint32_t*)b;
+	return (latency_a > latency_b) - (latency_a < latency_b);
+}
+
+/*
+ * The latency of a probe socket of the shard 1 (the shard 0 with a single shard) while
+ * the sockets of the shard 0 are always ready: from the write on the peer to the resume
+ * of the Java thread.
+ */
+static void T_NET_ASYNC_SELECT_SHARDS_benchmark(void)
+{
+	pthread_t flooders[T_NET_ASYNC_SELECT_SHARDS_FLOODERS];
+	static uint32_t latencies[T_NET_ASYNC_SELECT_SHARDS_PROBES];
+	async_select_shard_statistics_t statistics;
+	int probe[2];
+	char byte = 0;
+
+	for (int32_t i = 0; i < T_NET_ASYNC_SELECT_SHARDS_FLOODERS; i++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, flood_fds[i]));
+		flood_fds[i][0] = T_NET_ASYNC_SELECT_SHARDS_move(flood_fds[i][0], 0);
+		TEST_ASSERT_EQUAL_INT(1, write(flood_fds[i][1], "x", 1));
+	}
+	TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, probe));
+	probe[0] = T_NET_ASYNC_SELECT_SHARDS_move(probe[0], 1 % ASYNC_SELECT_SHARD_COUNT);
+
+	X_NET_ASYNC_SELECT_start_tasks();
+	atomic_store(&flooding, true);
+	for (int32_t i = 0; i < T_NET_ASYNC_SELECT_SHARDS_FLOODERS; i++)
+	{
+		(void)pthread_create(&flooders[i], NULL, T_NET_ASYNC_SELECT_SHARDS_flooder, (void*)(uintptr_t)i);
+	}
+
+	// the tasks are stopped before the results are checked
+	uint32_t probes = 0;
+	while ((probes < T_NET_ASYNC_SELECT_SHARDS_PROBES)
+			&& (0 == T_NET_ASYNC_SELECT_SHARDS_request(T_NET_ASYNC_SELECT_SHARDS_PROBE_THREAD, probe[0], SELECT_READ, 0)))
+	{
+		uint64_t t0 = X_NET_HOST_get_time_ns();
+		(void)write(probe[1], &byte, 1);
+		X_NET_HOST_wait_resumed(T_NET_ASYNC_SELECT_SHARDS_PROBE_THREAD);
+		latencies[probes] = (uint32_t)((X_NET_HOST_get_time_ns() - t0) / 1000U);
+		(void)read(probe[0], &byte, 1);
+		probes++;
+	}
+
+	atomic_store(&flooding, false);
+	for (int32_t i = 0; i < T_NET_ASYNC_SELECT_SHARDS_FLOODERS; i++)
+	{
+		(void)pthread_join(flooders[i], NULL);
+	}
+	X_NET_ASYNC_SELECT_stop_tasks();
+	TEST_ASSERT_EQUAL_INT(T_NET_ASYNC_SELECT_SHARDS_PROBES, probes);
+
+	qsort(latencies, T_NET_ASYNC_SELECT_SHARDS_PROBES, sizeof(latencies[0]), T_NET_ASYNC_SELECT_SHARDS_compare);
+	printf("async_select probe latency, %d shard(s), %d always ready sockets in the shard 0: p50 %u us, p99 %u us\n",
+			ASYNC_SELECT_SHARD_COUNT, T_NET_ASYNC_SELECT_SHARDS_FLOODERS, (unsigned int)latencies[T_NET_ASYNC_SELECT_SHARDS_PROBES / 2U],
+			(unsigned int)latencies[(T_NET_ASYNC_SELECT_SHARDS_PROBES * 99U) / 100U]);
+	for (int32_t s = 0; s < ASYNC_SELECT_SHARD_COUNT; s++)
+	{
+		(void)async_select_get_shard_statistics(s, &statistics, 0);
+		printf("shard %d: %u selects, %u requests, %u ready, %u timeouts, %u waiting at most\n", (int)s,
+				(unsigned int)statistics.selects, (unsigned int)statistics.requests, (unsigned int)statistics.ready,
+				(unsigned int)statistics.timeouts, (unsigned int)statistics.max_used);
+		TEST_ASSERT_EQUAL_INT(0, statistics.used);
+	}
+
+	for (int32_t i = 0; i < T_NET_ASYNC_SELECT_SHARDS_FLOODERS; i++)
+	{
+		(void)close(flood_fds[i][0]);
+		(void)close(flood_fds[i][1]);
+	}
+	(void)close(probe[0]);
+	(void)close(probe[1]);
+}
+
+TestRef T_NET_ASYNC_SELECT_SHARDS_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Distribution", T_NET_ASYNC_SELECT_SHARDS_distribution),
+		new_TestFixture("Tasks", T_NET_ASYNC_SELECT_SHARDS_tasks),
+		new_TestFixture("Statistics", T_NET_ASYNC_SELECT_SHARDS_statistics),
+		new_TestFixture("Probe latency benchmark", T_NET_ASYNC_SELECT_SHARDS_benchmark),
+	};
+
+	EMB_UNIT_TESTCALLER(asyncSelectShardsTest, "Async_select_shards_tests", T_NET_ASYNC_SELECT_SHARDS_setUp, T_NET_ASYNC_SELECT_SHARDS_tearDown, fixtures);
+
+	return (TestRef)&asyncSelectShardsTest;
+}
@@ -0,0 +1,20 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_net_main.h"
+#include "t_net_async_select.h"
+#include "t_net_async_select_shards.h"
+
+
+
+void T_NET_main(void) {
+	TestRunner_start();
+	TestRunner_runTest(T_NET_ASYNC_SELECT_tests());
+	TestRunner_runTest(T_NET_ASYNC_SELECT_SHARDS_tests());
+	TestRunner_end();
+	return;
+}
@@ -0,0 +1,99 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdbool.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/select.h>
+#include "x_net_async_select.h"
+
+static bool select_stubbed;
+static fd_set stub_ready_fds;
+static int32_t stub_ready_count;
+static pthread_t tasks[X_NET_ASYNC_SELECT_SHARD_COUNT];
+
+static int X_NET_ASYNC_SELECT_select(int nfds, fd_set* read_fds, fd_set* write_fds, fd_set* except_fds, struct timeval* timeout)
+{
+	if (select_stubbed)
+	{
+		*read_fds = stub_ready_fds;
+		FD_ZERO(write_fds);
+		return stub_ready_count;
+	}
+	return select(nfds, read_fds, write_fds, except_fds, timeout);
+}
+
+/*
+ * The tests call the static functions of the implementation (the loop of the tasks).
+ */
+#define select X_NET_ASYNC_SELECT_select
+#include "../../../../../net/src/async_select.c"
+#undef select
+
+void X_NET_ASYNC_SELECT_reset(void)
+{
+	async_select_lock();
+	for (int32_t i = 0; i < ASYNC_SELECT_SHARD_COUNT; i++)
+	{
+		async_select_Shard* shard = &shards[i];
+		if (1 == shard->pipe_fds_initialized)
+		{
+			(void)close(shard->pipe_fds[0]);
+			(void)close(shard->pipe_fds[1]);
+		}
+	}
+	async_select_fifo_initialized = 0;
+	async_select_unlock();
+
+	async_select_request_fifo_init();
+}
+
+void X_NET_ASYNC_SELECT_wakeup(int32_t shard)
+{
+	async_select_Shard* s = &shards[shard];
+
+	if (!select_stubbed && (-1 != async_select_get_notify_fd(s)))
+	{
+		async_select_notify_select(s);
+	}
+	async_select_do_select(s);
+	async_select_update_selected_requests(s);
+}
+
+void X_NET_ASYNC_SELECT_stub_select(const fd_set* ready_fds, int32_t ready_count)
+{
+	stub_ready_fds = *ready_fds;
+	stub_ready_count = ready_count;
+	select_stubbed = true;
+}
+
+void X_NET_ASYNC_SELECT_release_select(void)
+{
+	select_stubbed = false;
+}
+
+static void* X_NET_ASYNC_SELECT_task(void* shard)
+{
+	async_select_task_main(shard);
+	return NULL;
+}
+
+void X_NET_ASYNC_SELECT_start_tasks(void)
+{
+	for (int32_t i = 0; i < ASYNC_SELECT_SHARD_COUNT; i++)
+	{
+		(void)pthread_create(&tasks[i], NULL, X_NET_ASYNC_SELECT_task, (void*)(uintptr_t)i);
+	}
+}
+
+void X_NET_ASYNC_SELECT_stop_tasks(void)
+{
+	for (int32_t i = 0; i < ASYNC_SELECT_SHARD_COUNT; i++)
+	{
+		(void)pthread_cancel(tasks[i]);
+		(void)pthread_join(tasks[i], NULL);
+	}
+}
@@ -0,0 +1,229 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include "t_net_main.h"
+#include "x_net_host.h"
+#include "LLNET_Common.h"
+
+/*
+ * Host entry point and stubs of the VM (SNI, LLMJVM) and of the OSAL functions called by
+ * async_select.c. The SNI stubs are thread safe: the async_select tasks resume the Java
+ * threads of the other host threads.
+ */
+
+/*
+ * The Java thread run by the host thread.
+ */
+static _Thread_local int32_t current_thread;
+
+static pthread_mutex_t host_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t host_resumed = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t async_select_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int32_t resumed[X_NET_HOST_RESUMES];
+static uint32_t resumes;
+static uint32_t pending_resumes[X_NET_HOST_THREADS];
+static uint32_t exceptions;
+static bool suspend_error;
+static volatile int64_t time_ms;
+
+static struct
+{
+	void* resource;
+	SNI_closeFunction close;
+} scoped_resources[X_NET_HOST_THREADS];
+
+static bool is_thread(int32_t thread)
+{
+	return (thread >= 0) && (thread < X_NET_HOST_THREADS);
+}
+
+void X_NET_HOST_reset(void)
+{
+	pthread_mutex_lock(&host_mutex);
+	resumes = 0;
+	exceptions = 0;
+	suspend_error = false;
+	time_ms = 0;
+	(void)memset(pending_resumes, 0, sizeof(pending_resumes));
+	(void)memset(scoped_resources, 0, sizeof(scoped_resources));
+	pthread_mutex_unlock(&host_mutex);
+}
+
+void X_NET_HOST_set_thread(int32_t thread)
+{
+	current_thread = thread;
+}
+
+void X_NET_HOST_set_time(int64_t time)
+{
+	time_ms = time;
+}
+
+void X_NET_HOST_set_suspend_error(bool error)
+{
+	suspend_error = error;
+}
+
+void X_NET_HOST_close_scoped_resource(int32_t thread)
+{
+	void* resource = NULL;
+	SNI_closeFunction close = NULL;
+
+	pthread_mutex_lock(&host_mutex);
+	if (is_thread(thread))
+	{
+		resource = scoped_resources[thread].resource;
+		close = scoped_resources[thread].close;
+		scoped_resources[thread].close = NULL;
+	}
+	pthread_mutex_unlock(&host_mutex);
+
+	if (NULL != close)
+	{
+		close(resource);
+	}
+}
+
+uint32_t X_NET_HOST_get_resumed(int32_t* threads, uint32_t size)
+{
+	pthread_mutex_lock(&host_mutex);
+	uint32_t count = resumes;
+	for (uint32_t i = 0; (i < count) && (i < size) && (i < X_NET_HOST_RESUMES); i++)
+	{
+		threads[i] = resumed[i];
+	}
+	pthread_mutex_unlock(&host_mutex);
+	return count;
+}
+
+void X_NET_HOST_wait_resumed(int32_t thread)
+{
+	pthread_mutex_lock(&host_mutex);
+	while (0U == pending_resumes[thread])
+	{
+		pthread_cond_wait(&host_resumed, &host_mutex);
+	}
+	pending_resumes[thread]--;
+	pthread_mutex_unlock(&host_mutex);
+}
+
+uint32_t X_NET_HOST_get_exceptions(void)
+{
+	return exceptions;
+}
+
+uint64_t X_NET_HOST_get_time_ns(void)
+{
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+int32_t SNI_getCurrentJavaThreadID(void)
+{
+	return current_thread;
+}
+
+int32_t SNI_throwNativeIOException(int32_t errorCode, const char* message)
+{
+	(void)errorCode;
+	(void)message;
+	pthread_mutex_lock(&host_mutex);
+	exceptions++;
+	pthread_mutex_unlock(&host_mutex);
+	return SNI_OK;
+}
+
+bool SNI_clearCurrentJavaThreadPendingResumeFlag(void)
+{
+	return false;
+}
+
+int32_t SNI_registerScopedResource(void* resource, SNI_closeFunction close, SNI_getDescriptionFunction getDescription)
+{
+	int32_t result = SNI_ERROR;
+	(void)getDescription;
+
+	pthread_mutex_lock(&host_mutex);
+	// like the VM: one scoped resource per native context
+	if (is_thread(current_thread) && (NULL == scoped_resources[current_thread].close))
+	{
+		scoped_resources[current_thread].resource = resource;
+		scoped_resources[current_thread].close = close;
+		result = SNI_OK;
+	}
+	pthread_mutex_unlock(&host_mutex);
+	return result;
+}
+
+int32_t SNI_unregisterScopedResource(void)
+{
+	pthread_mutex_lock(&host_mutex);
+	if (is_thread(current_thread))
+	{
+		scoped_resources[current_thread].close = NULL;
+	}
+	pthread_mutex_unlock(&host_mutex);
+	return SNI_OK;
+}
+
+int32_t SNI_suspendCurrentJavaThreadWithCallback(int64_t timeout, SNI_callback sniCallback, void* callbackSuspendArg)
+{
+	(void)timeout;
+	(void)sniCallback;
+	(void)callbackSuspendArg;
+	return suspend_error ? SNI_ERROR : SNI_OK;
+}
+
+int32_t SNI_resumeJavaThread(int32_t javaThreadID)
+{
+	pthread_mutex_lock(&host_mutex);
+	if (resumes < X_NET_HOST_RESUMES)
+	{
+		resumed[resumes] = javaThreadID;
+	}
+	resumes++;
+	if (is_thread(javaThreadID))
+	{
+		pending_resumes[javaThreadID]++;
+	}
+	pthread_cond_broadcast(&host_resumed);
+	pthread_mutex_unlock(&host_mutex);
+	return SNI_OK;
+}
+
+int64_t LLMJVM_IMPL_getCurrentTime__Z(uint8_t system)
+{
+	(void)system;
+	return time_ms;
+}
+
+int32_t LLNET_set_non_blocking(int32_t fd)
+{
+	int flags = fcntl(fd, F_GETFL, 0);
+	return ((flags == -1) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)) ? -1 : 0;
+}
+
+void async_select_lock(void)
+{
+	pthread_mutex_lock(&async_select_mutex);
+}
+
+void async_select_unlock(void)
+{
+	pthread_mutex_unlock(&async_select_mutex);
+}
+
+int main(void)
+{
+	T_NET_main();
+	return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the FreeRTOS header: the tested modules run in a single thread,
+ * the kernel calls do nothing.
+ */
+
+typedef long BaseType_t;
+typedef BaseType_t portBASE_TYPE;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define portMAX_DELAY ((TickType_t)0xffffffffU)
+
+#define portYIELD_FROM_ISR(woken) do { (void)(woken); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stddef.h>
+#include "FreeRTOS.h"
+
+/*
+ * Host replacement of the FreeRTOS semaphores (see FreeRTOS.h).
+ */
+
+typedef void* SemaphoreHandle_t;
+typedef SemaphoreHandle_t xSemaphoreHandle;
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+	return NULL;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+	(void)sem;
+	(void)ticks;
+	return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+	(void)sem;
+	return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken)
+{
+	(void)sem;
+	(void)woken;
+	return pdTRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
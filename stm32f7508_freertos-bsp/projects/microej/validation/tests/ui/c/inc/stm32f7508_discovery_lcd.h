@@ -0,0 +1,36 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __STM32F7508_DISCOVERY_LCD_H
+#define __STM32F7508_DISCOVERY_LCD_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include "stm32f7xx_hal.h"
+
+/*
+ * Host replacement of the LCD BSP header (simulated by x_ui_display.c).
+ */
+
+#define RK043FN48H_WIDTH ((uint16_t)480)
+#define RK043FN48H_HEIGHT ((uint16_t)272)
+
+#define LTDC_ACTIVE_LAYER ((uint16_t)1)
+
+uint8_t BSP_LCD_Init(void);
+void BSP_LCD_LayerDefaultInit(uint16_t LayerIndex, uint32_t FB_Address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __STM32F7xx_HAL_H
+#define __STM32F7xx_HAL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the HAL header: the CMSIS functions called by the tested modules
+ * that do not use the peripherals, and the LTDC functions called by the display driver
+ * (simulated by x_ui_display.c).
+ */
+
+/**
+ * @brief Data memory barrier: a full fence on the host (also a compiler barrier).
+ */
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+typedef enum
+{
+	HAL_OK = 0,
+	HAL_ERROR = 1,
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+	LTDC_IRQn = 88,
+} IRQn_Type;
+
+typedef struct
+{
+	uint32_t ErrorCode;
+} LTDC_HandleTypeDef;
+
+#define HAL_LTDC_ERROR_TE 0x01U
+#define HAL_LTDC_ERROR_FU 0x02U
+
+#define LTDC_IT_FU 0x02U
+#define LTDC_IT_TE 0x04U
+#define LTDC_IT_RR 0x08U
+
+#define LTDC_RELOAD_IMMEDIATE 0x01U
+#define LTDC_RELOAD_VERTICAL_BLANKING 0x02U
+
+#define LTDC_PIXEL_FORMAT_ARGB8888 0x00U
+#define LTDC_PIXEL_FORMAT_RGB888 0x01U
+#define LTDC_PIXEL_FORMAT_RGB565 0x02U
+
+#define __HAL_LTDC_ENABLE_IT(handle, it) do { (void)(handle); (void)(it); } while (0)
+
+HAL_StatusTypeDef HAL_LTDC_SetPixelFormat(LTDC_HandleTypeDef* hltdc, uint32_t Pixelformat, uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_SetAddress(LTDC_HandleTypeDef* hltdc, uint32_t Address, uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_SetAddress_NoReload(LTDC_HandleTypeDef* hltdc, uint32_t Address, uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_Reload(LTDC_HandleTypeDef* hltdc, uint32_t ReloadType);
+void HAL_LTDC_IRQHandler(LTDC_HandleTypeDef* hltdc);
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
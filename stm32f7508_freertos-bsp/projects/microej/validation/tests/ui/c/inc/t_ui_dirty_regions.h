@@ -0,0 +1,31 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_DIRTY_REGIONS_H
+#define __T_UI_DIRTY_REGIONS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the merge logic of the dirty regions tracker (display_dirty_regions.c):
+ *  overlapping and cheap merges, full list, clipping to the flush bounding box and fallback
+ *  on the bounding box when some drawings have not been reported.
+ */
+TestRef T_UI_DIRTY_REGIONS_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_DISPLAY_BUFFERS_H
+#define __T_UI_DISPLAY_BUFFERS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test compares the double and the triple buffering of the display driver
+ *  (LLUI_DISPLAY.c) over a simulated LTDC and DMA2D (x_ui_display.c): for several render
+ *  times, it prints the frames per second and the framerate metrics (FRAMERATE_ENABLED),
+ *  checks no buffer is drawn or restored while it is scanned out and checks the triple
+ *  buffering delivers at least as many frames as the double buffering.
+ */
+TestRef T_UI_DISPLAY_BUFFERS_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
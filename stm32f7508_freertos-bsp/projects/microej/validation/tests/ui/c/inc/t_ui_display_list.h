@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_DISPLAY_LIST_H
+#define __T_UI_DISPLAY_LIST_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the display list (ui_display_list.c) with a painter stub: a region
+ *  is recorded then copied back with the same pixels, redrawn when its drawings, its clip or
+ *  its pixels change, recorded again after an invalidation, drawn as usual when it holds a
+ *  drawing which is not hashed or when it is too small, and the least recently used region
+ *  is replaced. The counters are checked at each step.
+ */
+TestRef T_UI_DISPLAY_LIST_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_DMA2D_SHAPES_H
+#define __T_UI_DMA2D_SHAPES_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the filled shapes of the DMA2D drawer (ui_drawing_dma2d_shapes.c):
+ *  the rounded rectangles, circles and ellipses drawn by the DMA2D and the software must
+ *  be pixel-exact with the shapes drawn by the software only, clipped or not, with a
+ *  software drawer rounding the edges like the shapes decomposition expects or not.
+ */
+TestRef T_UI_DMA2D_SHAPES_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_DMA2D_TRANSFORM_H
+#define __T_UI_DMA2D_TRANSFORM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the scaled and rotated image drawings of the DMA2D drawer
+ *  (ui_drawing_dma2d_transform.c), the DMA2D blending of the tiles being simulated by the
+ *  CPU: the drawings are compared with a software-only reference which samples and
+ *  blends each destination pixel. It also prints the time of the reference (before) and
+ *  the time the CPU spends sampling the tiles (after, the blending being done by the
+ *  DMA2D on the target).
+ */
+TestRef T_UI_DMA2D_TRANSFORM_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
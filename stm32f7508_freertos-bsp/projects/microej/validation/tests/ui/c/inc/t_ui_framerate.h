@@ -0,0 +1,34 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_FRAMERATE_H
+#define __T_UI_FRAMERATE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the frame-time metrics and the adaptive pacing (framerate.c) with
+ *  the simulated time of the host: percentiles of the rolling histograms, the window which
+ *  forgets the oldest frames, the last bucket, the invalid arguments, then the pacing
+ *  divisor which follows the render and restore times (capped to
+ *  FRAMERATE_PACING_MAX_DIVISOR) and the sleep which delivers the frames at a regular
+ *  period.
+ */
+TestRef T_UI_FRAMERATE_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_GLYPH_ATLAS_SHEET_H
+#define __T_UI_GLYPH_ATLAS_SHEET_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the font sheets of the glyph atlas (ui_glyph_atlas_sheet.c):
+ *  glyphs metrics and alpha values read from A8 and A4 images, and registration.
+ */
+TestRef T_UI_GLYPH_ATLAS_SHEET_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
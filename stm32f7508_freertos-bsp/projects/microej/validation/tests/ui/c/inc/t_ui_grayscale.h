@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_GRAYSCALE_H
+#define __T_UI_GRAYSCALE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the grayscale converter (grayscale.c) with the CPU: gray levels of
+ *  the three algorithms against a floating point reference, RGB565 lines with an odd width,
+ *  levels formats, a decoded image of the images heap cache converted in place and errors.
+ *  It prints the conversion times of a 480x272 image with each algorithm (see
+ *  GRAYSCALE_BENCHMARK) next to the time of the baseline per-pixel conversion.
+ */
+TestRef T_UI_GRAYSCALE_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_IMAGE_HEAP_H
+#define __T_UI_IMAGE_HEAP_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the decoded images cache of the images heap
+ *  (LLUI_DISPLAY_HEAP_impl.c): hits, key (address of the resources, hash of the images
+ *  in RAM), modified images, tracked blocks limit, budget, eviction under pressure,
+ *  eviction of a cached image while the Graphics Engine reuses it and compaction (the
+ *  moved images keep their pixels).
+ */
+TestRef T_UI_IMAGE_HEAP_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_IMAGE_HEAP_BENCHMARK_H
+#define __T_UI_IMAGE_HEAP_BENCHMARK_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test replays a synthetic decoding trace (image buffers and decoders scratch
+ *  blocks) on the images heap (LLUI_DISPLAY_HEAP_impl.c) and on a plain best fit heap of
+ *  the same size, prints the fragmentation of both heaps and checks the images heap is not
+ *  more fragmented.
+ */
+TestRef T_UI_IMAGE_HEAP_BENCHMARK_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_INPUT_RING_H
+#define __T_UI_INPUT_RING_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the input events rings (input_ring.c): two producer threads push
+ *  300000 events each in their own ring while the consumer merges the rings; each event
+ *  is read complete and in order, and the pushed and dropped events are accounted. It also
+ *  checks the time order of the merge when the time wraps around and the full ring.
+ */
+TestRef T_UI_INPUT_RING_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
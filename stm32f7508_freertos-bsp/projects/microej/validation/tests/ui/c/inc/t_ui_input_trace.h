@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_INPUT_TRACE_H
+#define __T_UI_INPUT_TRACE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the latency tracing of the touch events (input_trace.c): the
+ *  histograms of the read, helper, queue and total stages, the events traced at the same
+ *  time (more than INPUT_TRACE_EVENTS_IN_FLIGHT, reused queue indexes), the statistics of
+ *  the MicroUI queue and their reset, the rolling window and its last bucket, the invalid
+ *  arguments and the time which wraps around.
+ */
+TestRef T_UI_INPUT_TRACE_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
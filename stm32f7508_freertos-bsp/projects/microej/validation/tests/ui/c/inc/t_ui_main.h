@@ -0,0 +1,57 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_MAIN_H
+#define __T_UI_MAIN_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* public function declaration */
+
+/**
+ * @brief this function is the entry point for the UI port test suite. The tests check the
+ * algorithms of the UI port which do not depend on the hardware; they run on the host
+ * (see x_ui_host.c and stm32f7xx_hal.h); libwebp is built without its SSE2 functions (not
+ * part of the BSP):
+ *
+ * W=../../../../thirdparty/libwebp
+ * gcc -U__SSE2__ -pthread -I inc -I ../../../../ui/inc -I ../../../../core/inc
+ *     -I ../../../../SW4STM32/platform/inc -I $W -I $W/src/microej
+ *     $(find src ../../../framework/c/embunit/embUnit $W/src/dec $W/src/dsp $W/src/utils -name "*.c")
+ *     $W/src/microej/microej_decode.c $W/src/microej/microej_utils.c
+ *     ../../../../ui/src/LLUI_DISPLAY_HEAP_impl.c ../../../../ui/src/ui_glyph_atlas_sheet.c
+ *     ../../../../ui/src/ui_drawing_dma2d_shapes.c ../../../../ui/src/framerate.c -lm -o t_ui && ./t_ui
+ *
+ * By default, the executed test sequence is :
+ *		-# the dirty regions tests
+ *		-# the WebP decoder tests
+ *		-# the WebP chunked loader tests and benchmark
+ *		-# the images heap tests
+ *		-# the images heap fragmentation benchmark
+ *		-# the glyph atlas font sheets tests
+ *		-# the DMA2D shapes tests
+ *		-# the DMA2D scaled and rotated images tests and benchmark
+ *		-# the grayscale converter tests and benchmark
+ *		-# the input events rings tests (producer threads)
+ *		-# the display buffers simulation (double and triple buffering)
+ *		-# the display list tests
+ *		-# the framerate metrics and pacing tests (simulated time)
+ *		-# the FT5336 touch sampling tests (simulated controller)
+ *		-# the gesture recognizer tests
+ *		-# the touch events latency tracing tests
+ */
+void T_UI_main(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
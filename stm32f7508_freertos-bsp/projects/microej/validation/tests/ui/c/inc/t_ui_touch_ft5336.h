@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_TOUCH_FT5336_H
+#define __T_UI_TOUCH_FT5336_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the sampling state machine of the FT5336 touch controller
+ *  (touch_ft5336.c) against a simulated FT5336 register model (x_ui_ft5336.c) with the
+ *  interrupts, the I2C reads and the IO task of the touch manager: decoding of the
+ *  sample registers, the press and the release read at once, the reads limited to
+ *  TOUCH_SAMPLING_RATE_HZ while a finger moves (also when the time wraps around), the
+ *  sample signaled during a read, the failed reads, the lost "put up" sample and the
+ *  resynchronization after a touch ring overflow.
+ */
+TestRef T_UI_TOUCH_FT5336_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
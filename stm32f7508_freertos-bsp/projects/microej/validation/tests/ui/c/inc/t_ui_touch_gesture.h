@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_TOUCH_GESTURE_H
+#define __T_UI_TOUCH_GESTURE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the gesture recognizer (touch_gesture.c) with the touch samples of
+ *  a simulated finger: the long press of a finger held in the slop, the fling (velocity
+ *  over the last TOUCH_GESTURE_FLING_WINDOW_MS, clamped to 16 bits) and the too slow
+ *  moves, the pinch scale steps and its end when a finger is released, the gestures
+ *  excluded by a long press or a pinch and the time which wraps around.
+ */
+TestRef T_UI_TOUCH_GESTURE_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_WEBP_DECODE_H
+#define __T_UI_WEBP_DECODE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the WebP decoder (microej_decode.c) against the reference ARGB
+ *  decoding of libwebp: output format selection and pixels of each supported format, for
+ *  lossless and lossy images with and without alpha. The lossless images are also
+ *  compared with their original pixels.
+ */
+TestRef T_UI_WEBP_DECODE_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
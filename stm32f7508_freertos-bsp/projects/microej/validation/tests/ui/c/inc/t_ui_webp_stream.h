@@ -0,0 +1,34 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_UI_WEBP_STREAM_H
+#define __T_UI_WEBP_STREAM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+/* Public function declarations */
+/**
+ *@brief This test checks the WebP chunked loader (MICROEJ_DECODE_webp_read() and the
+ *  streaming decoder of microej_decode.c): the images read in chunks of any size are
+ *  identical to the images decoded in one call, the decoded rows are reported while the
+ *  data is received and the image buffer is freed on truncated, unreadable or invalid
+ *  data. The benchmark compares the decoding time and the memory held with the decoding
+ *  in one call.
+ */
+TestRef T_UI_WEBP_STREAM_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
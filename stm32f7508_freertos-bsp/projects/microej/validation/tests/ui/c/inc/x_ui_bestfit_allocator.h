@@ -0,0 +1,33 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_UI_BESTFIT_ALLOCATOR_H
+#define __X_UI_BESTFIT_ALLOCATOR_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include "BESTFIT_ALLOCATOR.h"
+
+/**
+ * @brief Walks the heap of the host best fit allocator and retrieves its free blocks.
+ *
+ * @param[out] largest the size of the largest free block (without header and footer)
+ *
+ * @return the number of free blocks
+ */
+uint32_t X_UI_BESTFIT_ALLOCATOR_free_blocks(BESTFIT_ALLOCATOR* env, uint32_t* largest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
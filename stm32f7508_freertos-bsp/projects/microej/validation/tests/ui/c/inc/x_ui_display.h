@@ -0,0 +1,76 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_UI_DISPLAY_H
+#define __X_UI_DISPLAY_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include "LLUI_DISPLAY_impl.h"
+#include "stm32f7xx_hal.h"
+
+/**
+ * @brief Refresh period of the simulated panel in microseconds (see FRAMERATE_PANEL_REFRESH_US).
+ */
+#define X_UI_DISPLAY_REFRESH_US 16862U
+
+/**
+ * @brief Bandwidth of the simulated DMA2D restore copy (SDRAM to SDRAM, RGB565), in bytes
+ * per microsecond: a full screen copy lasts 3.3ms.
+ */
+#define X_UI_DISPLAY_COPY_BYTES_PER_US 80U
+
+/**
+ * @brief A build of the display driver (LLUI_DISPLAY.c): x_ui_display_double.c and
+ * x_ui_display_triple.c build it with the double and the triple buffering.
+ */
+typedef struct
+{
+	const char* name;
+	void (*initialize)(LLUI_DISPLAY_SInitData* init_data);
+	uint8_t* (*flush)(MICROUI_GraphicsContext* gc, uint8_t* srcAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax);
+	void (*reload_callback)(LTDC_HandleTypeDef* hltdc);
+} X_UI_DISPLAY_driver_t;
+
+/**
+ * @brief Result of a simulation (see X_UI_DISPLAY_run()).
+ */
+typedef struct
+{
+	uint32_t flushes; // frames flushed by the Graphics Engine
+	uint32_t displayed; // buffers switched by the LTDC at vertical blanking
+	uint32_t errors; // buffer drawn or restored while the LTDC scans it out
+} X_UI_DISPLAY_result_t;
+
+extern const X_UI_DISPLAY_driver_t X_UI_DISPLAY_double_buffering;
+extern const X_UI_DISPLAY_driver_t X_UI_DISPLAY_triple_buffering;
+
+/**
+ * @brief Runs the Graphics Engine over the display driver with a simulated LTDC (vertical
+ * blanking every X_UI_DISPLAY_REFRESH_US) and a simulated DMA2D restore copy. The engine
+ * draws each frame during render_us in the buffer given by the previous flush (once the
+ * flush is done) and flushes the given area. The cycles counter of the host follows the
+ * simulated time: the framerate metrics (framerate.c) are recorded by the driver.
+ *
+ * @param driver the driver
+ * @param render_us the drawing time of a frame
+ * @param xmin, ymin, xmax, ymax the area flushed at each frame
+ * @param duration_us the simulated time
+ * @param result the counters
+ */
+void X_UI_DISPLAY_run(const X_UI_DISPLAY_driver_t* driver, uint32_t render_us, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t duration_us, X_UI_DISPLAY_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
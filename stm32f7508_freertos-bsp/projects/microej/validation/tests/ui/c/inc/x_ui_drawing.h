@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_UI_DRAWING_H
+#define __X_UI_DRAWING_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Reduces the width and the height of the shapes drawn by the software drawer of
+ * the host (in pixels; 0 by default). The shapes keep their center: an inset of 1 moves
+ * the edges of half a pixel, like a software drawer which rounds differently.
+ */
+void X_UI_DRAWING_set_inset(uint32_t inset);
+
+/**
+ * @brief Returns the number of rectangles filled by the DMA2D stub.
+ */
+uint32_t X_UI_DRAWING_get_filled_tiles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_UI_FT5336_H
+#define __X_UI_FT5336_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include "touch_gesture.h"
+
+/**
+ * @brief Size of the simulated register map (DEV_MODE to P5_MISC).
+ */
+#define X_UI_FT5336_REGS 0x21U
+
+/**
+ * @brief Resets the simulated FT5336: no touch point, all the registers cleared.
+ */
+void X_UI_FT5336_reset(void);
+
+/**
+ * @brief Updates the sample registers like the FT5336 does for a new sample (the caller
+ * raises the interrupt). The points are given in display coordinates; the new points
+ * are "put down", the points already pressed are "contact". When count is 0, the
+ * previous points are reported "put up" at their last position.
+ *
+ * @param points the fingers on the panel
+ * @param count the number of fingers (5 at most)
+ */
+void X_UI_FT5336_sample(const TOUCH_GESTURE_point_t* points, uint32_t count);
+
+/**
+ * @brief Writes a register (corrupted samples, invalid TD_STATUS).
+ */
+void X_UI_FT5336_write(uint8_t reg, uint8_t value);
+
+/**
+ * @brief Reads consecutive registers like an I2C memory read.
+ */
+void X_UI_FT5336_read(uint8_t first, uint8_t* data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_UI_HOST_H
+#define __X_UI_HOST_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include "ui_glyph_atlas.h"
+
+/**
+ * @brief Size of the images heap of the host (LLUI_DISPLAY_HEAP_impl.c).
+ */
+#define X_UI_HOST_HEAP_SIZE (2560U * 1024U)
+
+/**
+ * @brief Maps a memory area below 4GB: the heaps implementations store the addresses
+ * on 32 bits.
+ *
+ * @return the area or NULL
+ */
+uint8_t* X_UI_HOST_map(uint32_t size);
+
+/**
+ * @brief Maps a writable memory area at the address of the application resources
+ * (MICROUI_HEAP_CACHE_RESOURCES_START): the encoded images copied in this area are
+ * resources for the images heap cache. The area is mapped once.
+ *
+ * @return the area or NULL
+ */
+uint8_t* X_UI_HOST_map_resources(uint32_t size);
+
+/**
+ * @brief Frees the closed images kept by the images heap cache.
+ */
+void X_UI_HOST_flush_heap(void);
+
+/**
+ * @brief Sets the number of bytes the Graphics Engine stub adds to each image buffer
+ * (a custom header for instance).
+ */
+void X_UI_HOST_set_image_header(uint32_t size);
+
+/**
+ * @brief Drives the cycles counter of the host (framerate_impl_get_cycles()) from a
+ * simulation: the counter stays at the given time (in microseconds) until the next call
+ * and framerate_impl_sleep() moves it forward.
+ */
+void X_UI_HOST_set_time(uint64_t us);
+
+/**
+ * @brief Returns the simulated time (see X_UI_HOST_set_time()).
+ */
+uint64_t X_UI_HOST_get_time(void);
+
+/**
+ * @brief Gives the cycles counter of the host back to the real time.
+ */
+void X_UI_HOST_release_time(void);
+
+/**
+ * @brief Returns the font registered in the glyph atlas stub with the given identifier.
+ *
+ * @return the font or NULL
+ */
+const UI_GLYPH_ATLAS_font_t* X_UI_HOST_get_font(int32_t font);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
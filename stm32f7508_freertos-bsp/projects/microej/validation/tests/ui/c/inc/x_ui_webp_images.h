@@ -0,0 +1,58 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __X_UI_WEBP_IMAGES_H
+#define __X_UI_WEBP_IMAGES_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define X_UI_WEBP_WIDTH 17
+#define X_UI_WEBP_HEIGHT 9
+#define X_UI_WEBP_IMAGES 4
+
+#define X_UI_WEBP_SCREEN_WIDTH 480
+#define X_UI_WEBP_SCREEN_HEIGHT 272
+#define X_UI_WEBP_SCREEN_IMAGES 2
+
+typedef struct
+{
+	const char* name;
+	const uint8_t* data;
+	uint32_t size;
+	bool alpha;
+	bool lossless;
+} X_UI_WEBP_image_t;
+
+/**
+ * @brief The encoded test images.
+ */
+extern const X_UI_WEBP_image_t X_UI_WEBP_images[X_UI_WEBP_IMAGES];
+
+/**
+ * @brief The encoded images of the display size (benchmarks).
+ */
+extern const X_UI_WEBP_image_t X_UI_WEBP_screen_images[X_UI_WEBP_SCREEN_IMAGES];
+
+/**
+ * @brief Returns the ARGB8888 pixel of the original image at (x,y).
+ *
+ * @param alpha false for the opaque images
+ */
+uint32_t X_UI_WEBP_pixel(uint32_t x, uint32_t y, bool alpha);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
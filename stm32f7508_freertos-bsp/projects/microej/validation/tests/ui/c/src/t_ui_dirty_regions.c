@@ -0,0 +1,205 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_dirty_regions.h"
+
+/*
+ * The tracker is built with the tracking enabled and without the engine drawings
+ * fallback, whatever the BSP configuration.
+ */
+#include "LLDISPLAY_configuration.h"
+#undef DISPLAY_DIRTY_REGIONS_ENGINE_DRAWINGS
+#ifndef DISPLAY_DIRTY_REGIONS_ENABLED
+#define DISPLAY_DIRTY_REGIONS_ENABLED
+#endif
+#include "../../../../../ui/src/display_dirty_regions.c"
+
+#define WIDTH 480
+#define HEIGHT 272
+
+static DISPLAY_DIRTY_REGIONS_rect_t rects[DISPLAY_DIRTY_REGIONS_MAX];
+
+static bool T_UI_DIRTY_REGIONS_is(DISPLAY_DIRTY_REGIONS_rect_t* r, uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2)
+{
+	return (r->x1 == x1) && (r->y1 == y1) && (r->x2 == x2) && (r->y2 == y2);
+}
+
+/*
+ * Checks the flushed rectangles are the expected ones (in any order).
+ */
+static bool T_UI_DIRTY_REGIONS_list(uint32_t count, const DISPLAY_DIRTY_REGIONS_rect_t* expected, uint32_t expected_count)
+{
+	bool ret = count == expected_count;
+	for (uint32_t e = 0; ret && (e < expected_count); e++)
+	{
+		bool found = false;
+		for (uint32_t r = 0; r < count; r++)
+		{
+			found |= T_UI_DIRTY_REGIONS_is(&rects[r], expected[e].x1, expected[e].y1, expected[e].x2, expected[e].y2);
+		}
+		ret = found;
+	}
+	return ret;
+}
+
+static bool T_UI_DIRTY_REGIONS_contains(DISPLAY_DIRTY_REGIONS_rect_t* r, uint32_t x1, uint32_t y1, uint32_t x2, uint32_t y2)
+{
+	return (r->x1 <= x1) && (r->y1 <= y1) && (r->x2 >= x2) && (r->y2 >= y2);
+}
+
+static void T_UI_DIRTY_REGIONS_setUp(void)
+{
+	// start a new frame
+	(void)DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects);
+}
+
+static void T_UI_DIRTY_REGIONS_tearDown(void)
+{
+
+}
+
+static void T_UI_DIRTY_REGIONS_overlap(void)
+{
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 19, 19);
+	DISPLAY_DIRTY_REGIONS_add(10, 10, 30, 30);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 0, 0, 30, 30 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, 30, 30, rects), expected, 1));
+}
+
+static void T_UI_DIRTY_REGIONS_cheapMerge(void)
+{
+	// the union adds 20 pixels only
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 9, 9);
+	DISPLAY_DIRTY_REGIONS_add(12, 0, 21, 9);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 0, 0, 21, 9 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, 21, 9, rects), expected, 1));
+}
+
+static void T_UI_DIRTY_REGIONS_distant(void)
+{
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 19, 19);
+	DISPLAY_DIRTY_REGIONS_add(WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 0, 0, 19, 19 }, { WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects), expected, 2));
+}
+
+static void T_UI_DIRTY_REGIONS_fullList(void)
+{
+	uint32_t n = (2 * DISPLAY_DIRTY_REGIONS_MAX) + 4;
+	uint32_t step_x = (WIDTH - 6) / (n - 1);
+	uint32_t step_y = (HEIGHT - 6) / (n - 1);
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		DISPLAY_DIRTY_REGIONS_add(i * step_x, i * step_y, (i * step_x) + 5, (i * step_y) + 5);
+	}
+
+	uint32_t count = DISPLAY_DIRTY_REGIONS_flush(0, 0, ((n - 1) * step_x) + 5, ((n - 1) * step_y) + 5, rects);
+	TEST_ASSERT(count > 1);
+	TEST_ASSERT(count <= DISPLAY_DIRTY_REGIONS_MAX);
+
+	// each drawing is covered
+	for (uint32_t i = 0; i < n; i++)
+	{
+		bool covered = false;
+		for (uint32_t r = 0; r < count; r++)
+		{
+			covered |= T_UI_DIRTY_REGIONS_contains(&rects[r], i * step_x, i * step_y, (i * step_x) + 5, (i * step_y) + 5);
+		}
+		TEST_ASSERT(covered);
+	}
+
+	// the rectangles do not overlap
+	for (uint32_t a = 0; a < count; a++)
+	{
+		for (uint32_t b = a + 1; b < count; b++)
+		{
+			TEST_ASSERT(!_overlap(&rects[a], &rects[b]));
+		}
+	}
+}
+
+static void T_UI_DIRTY_REGIONS_clip(void)
+{
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 99, 99);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 10, 10, 99, 99 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(10, 10, 99, 99, rects), expected, 1));
+}
+
+static void T_UI_DIRTY_REGIONS_covered(void)
+{
+	// the rectangles cover the corners of the bounding box but not the whole box
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 19, 19);
+	DISPLAY_DIRTY_REGIONS_add(200, 100, 219, 119);
+	DISPLAY_DIRTY_REGIONS_add(WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 0, 0, 19, 19 }, { 200, 100, 219, 119 }, { WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects), expected, 3));
+}
+
+static void T_UI_DIRTY_REGIONS_notCovered(void)
+{
+	// the Graphics Engine has drawn outside the tracked rectangles
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 9, 9);
+	DISPLAY_DIRTY_REGIONS_add(100, 100, 109, 109);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 0, 0, 200, 200 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, 200, 200, rects), expected, 1));
+}
+
+static void T_UI_DIRTY_REGIONS_unreported(void)
+{
+	// the tracked rectangles cover the bounding box but a drawing has not been reported
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 19, 19);
+	DISPLAY_DIRTY_REGIONS_add(WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1);
+	DISPLAY_DIRTY_REGIONS_add_unreported();
+
+	const DISPLAY_DIRTY_REGIONS_rect_t bounding_box[] = { { 0, 0, WIDTH - 1, HEIGHT - 1 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects), bounding_box, 1));
+
+	// the next frame uses the tracked rectangles again
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 19, 19);
+	DISPLAY_DIRTY_REGIONS_add(WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1);
+
+	const DISPLAY_DIRTY_REGIONS_rect_t expected[] = { { 0, 0, 19, 19 }, { WIDTH - 20, HEIGHT - 20, WIDTH - 1, HEIGHT - 1 } };
+	TEST_ASSERT(T_UI_DIRTY_REGIONS_list(DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects), expected, 2));
+}
+
+static void T_UI_DIRTY_REGIONS_account(void)
+{
+	DISPLAY_DIRTY_REGIONS_add(0, 0, 9, 9);
+	DISPLAY_DIRTY_REGIONS_add(WIDTH - 10, HEIGHT - 10, WIDTH - 1, HEIGHT - 1);
+
+	uint32_t count = DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects);
+	DISPLAY_DIRTY_REGIONS_account(rects, count, 16);
+
+	TEST_ASSERT_EQUAL_INT(2, DISPLAY_DIRTY_REGIONS_get_copied_rects());
+	TEST_ASSERT_EQUAL_INT(2 * 10 * 10 * 2, DISPLAY_DIRTY_REGIONS_get_copied_bytes());
+}
+
+TestRef T_UI_DIRTY_REGIONS_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Overlapping rectangles", T_UI_DIRTY_REGIONS_overlap),
+		new_TestFixture("Cheap merge", T_UI_DIRTY_REGIONS_cheapMerge),
+		new_TestFixture("Distant rectangles", T_UI_DIRTY_REGIONS_distant),
+		new_TestFixture("Full list", T_UI_DIRTY_REGIONS_fullList),
+		new_TestFixture("Clip to the bounding box", T_UI_DIRTY_REGIONS_clip),
+		new_TestFixture("Bounding box covered", T_UI_DIRTY_REGIONS_covered),
+		new_TestFixture("Bounding box not covered", T_UI_DIRTY_REGIONS_notCovered),
+		new_TestFixture("Unreported drawing", T_UI_DIRTY_REGIONS_unreported),
+		new_TestFixture("Copied bytes", T_UI_DIRTY_REGIONS_account),
+	};
+
+	EMB_UNIT_TESTCALLER(dirtyRegionsTest, "Dirty_regions_tests", T_UI_DIRTY_REGIONS_setUp, T_UI_DIRTY_REGIONS_tearDown, fixtures);
+
+	return (TestRef)&dirtyRegionsTest;
+}
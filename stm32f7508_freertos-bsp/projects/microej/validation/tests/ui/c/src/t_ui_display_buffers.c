@@ -0,0 +1,82 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "x_ui_display.h"
+#include "framerate.h"
+#include "t_ui_display_buffers.h"
+
+#define T_UI_DISPLAY_BUFFERS_DURATION_US 10000000U
+
+static const uint32_t render_us[] = { 5000U, 10000U, 14000U, 20000U, 30000U };
+
+/*
+ * Runs a driver and prints its metrics: frames per second, p50 of the render time, of
+ * the flush latency and of the restore copy (last FRAMERATE_HISTOGRAM_FRAMES frames).
+ */
+static void T_UI_DISPLAY_BUFFERS_run(const X_UI_DISPLAY_driver_t* driver, uint32_t render, uint32_t xmax, uint32_t ymax, X_UI_DISPLAY_result_t* result)
+{
+	X_UI_DISPLAY_run(driver, render, 0, 0, xmax, ymax, T_UI_DISPLAY_BUFFERS_DURATION_US, result);
+
+	uint32_t fps10 = (result->flushes * 10U) / (T_UI_DISPLAY_BUFFERS_DURATION_US / 1000000U);
+	printf("%-16s render %2ums: %3u.%u fps, render p50 %5uus, flush latency p50 %5uus, restore p50 %4uus, %u errors\n",
+			driver->name, (unsigned int)(render / 1000U), (unsigned int)(fps10 / 10U), (unsigned int)(fps10 % 10U),
+			(unsigned int)framerate_get_percentile(FRAMERATE_METRIC_RENDER, 50),
+			(unsigned int)framerate_get_percentile(FRAMERATE_METRIC_FLUSH_LATENCY, 50),
+			(unsigned int)framerate_get_percentile(FRAMERATE_METRIC_RESTORE, 50),
+			(unsigned int)result->errors);
+
+	TEST_ASSERT_EQUAL_INT(0, result->errors);
+	// each flushed frame is displayed (the last ones may be pending)
+	TEST_ASSERT(result->displayed + 2U >= result->flushes);
+}
+
+static void T_UI_DISPLAY_BUFFERS_compare(uint32_t xmax, uint32_t ymax)
+{
+	for (uint32_t i = 0; i < (sizeof(render_us) / sizeof(render_us[0])); i++)
+	{
+		X_UI_DISPLAY_result_t double_result;
+		X_UI_DISPLAY_result_t triple_result;
+		T_UI_DISPLAY_BUFFERS_run(&X_UI_DISPLAY_double_buffering, render_us[i], xmax, ymax, &double_result);
+		T_UI_DISPLAY_BUFFERS_run(&X_UI_DISPLAY_triple_buffering, render_us[i], xmax, ymax, &triple_result);
+		TEST_ASSERT(triple_result.flushes >= double_result.flushes);
+	}
+}
+
+static void T_UI_DISPLAY_BUFFERS_setUp(void)
+{
+	(void)framerate_init(1000);
+	(void)framerate_set_pacing(FRAMERATE_PACING_OFF);
+}
+
+static void T_UI_DISPLAY_BUFFERS_tearDown(void)
+{
+
+}
+
+static void T_UI_DISPLAY_BUFFERS_fullScreen(void)
+{
+	T_UI_DISPLAY_BUFFERS_compare(479, 271);
+}
+
+static void T_UI_DISPLAY_BUFFERS_partial(void)
+{
+	// a quarter of the screen
+	T_UI_DISPLAY_BUFFERS_compare(239, 135);
+}
+
+TestRef T_UI_DISPLAY_BUFFERS_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Full screen flushes", T_UI_DISPLAY_BUFFERS_fullScreen),
+		new_TestFixture("Partial flushes", T_UI_DISPLAY_BUFFERS_partial),
+	};
+
+	EMB_UNIT_TESTCALLER(displayBuffersTest, "Display_buffers_tests", T_UI_DISPLAY_BUFFERS_setUp, T_UI_DISPLAY_BUFFERS_tearDown, fixtures);
+
+	return (TestRef)&displayBuffersTest;
+}
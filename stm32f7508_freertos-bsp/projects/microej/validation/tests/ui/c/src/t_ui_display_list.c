@@ -0,0 +1,380 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_display_list.h"
+#include "display_dirty_regions.h"
+
+/*
+ * The display list is built with the pixels check (see UI_DISPLAY_LIST_CHECK_PIXELS). The
+ * display format is the RGB565 format of the board (project global define).
+ */
+#ifndef DRAWING_DMA2D_BPP
+#define DRAWING_DMA2D_BPP 16
+#endif
+#include "ui_display_list_configuration.h"
+#ifndef UI_DISPLAY_LIST_CHECK_PIXELS
+#define UI_DISPLAY_LIST_CHECK_PIXELS
+#endif
+#include "../../../../../ui/src/ui_display_list.c"
+
+#define WIDTH 200
+#define HEIGHT 100
+
+// the region drawn by the application
+#define REGION_X 10
+#define REGION_Y 10
+#define REGION_WIDTH 100
+#define REGION_HEIGHT 50
+
+// painter stub: drawing identifier of a filled rectangle
+#define T_UI_DISPLAY_LIST_FILL 1U
+
+static MICROUI_GraphicsContext gc;
+static uint16_t snapshot[WIDTH * HEIGHT];
+static DISPLAY_DIRTY_REGIONS_rect_t rects[DISPLAY_DIRTY_REGIONS_MAX];
+
+// drawings performed by the painter stub, regions copied by the DMA2D stub and last
+// drawing status
+static uint32_t fills;
+static uint32_t copies;
+static DRAWING_Status drawing_status;
+
+/* Graphics Engine and DMA2D stubs -------------------------------------------*/
+
+bool LLUI_DISPLAY_requestDrawing(MICROUI_GraphicsContext* gc, SNI_callback callback)
+{
+	(void)gc;
+	(void)callback;
+	return true;
+}
+
+void LLUI_DISPLAY_setDrawingStatus(DRAWING_Status status)
+{
+	drawing_status = status;
+}
+
+bool LLUI_DISPLAY_setDrawingLimits(jint xmin, jint ymin, jint xmax, jint ymax)
+{
+	(void)xmin;
+	(void)ymin;
+	(void)xmax;
+	(void)ymax;
+	return true;
+}
+
+bool LLUI_DISPLAY_isDisplayFormat(jbyte format)
+{
+	return MICROUI_IMAGE_FORMAT_DISPLAY == (uint8_t)format;
+}
+
+bool LLUI_DISPLAY_clipRectangle(MICROUI_GraphicsContext* gc, jint* x1, jint* y1, jint* x2, jint* y2)
+{
+	*x1 = (*x1 < gc->clip_x1) ? gc->clip_x1 : *x1;
+	*y1 = (*y1 < gc->clip_y1) ? gc->clip_y1 : *y1;
+	*x2 = (*x2 > gc->clip_x2) ? gc->clip_x2 : *x2;
+	*y2 = (*y2 > gc->clip_y2) ? gc->clip_y2 : *y2;
+	return (*x1 <= *x2) && (*y1 <= *y2);
+}
+
+DRAWING_Status UI_DRAWING_DMA2D_copy_region(uint8_t* dest, uint32_t dest_stride, jint x_dest, jint y_dest, uint8_t* src, uint32_t src_stride, jint x_src, jint y_src, jint width, jint height)
+{
+	for (jint y = 0; y < height; y++)
+	{
+		uint16_t* d = (uint16_t*)dest + (((uint32_t)(y_dest + y) * dest_stride) + (uint32_t)x_dest);
+		const uint16_t* s = (const uint16_t*)src + (((uint32_t)(y_src + y) * src_stride) + (uint32_t)x_src);
+		(void)memcpy(d, s, (uint32_t)width * sizeof(uint16_t));
+	}
+	copies++;
+	return DRAWING_RUNNING;
+}
+
+/* Painter stub --------------------------------------------------------------*/
+
+static uint16_t* T_UI_DISPLAY_LIST_pixels(void)
+{
+	return (uint16_t*)LLUI_DISPLAY_getBufferAddress(&gc.image);
+}
+
+/*
+ * Fills a rectangle with the foreground color (RGB565 value) like a painter: the drawing
+ * is requested to the display list.
+ */
+static void T_UI_DISPLAY_LIST_fill(jint x, jint y, jint width, jint height)
+{
+	jint args[4] = { x, y, width, height };
+	if (UI_DISPLAY_LIST_request_drawing(&gc, NULL, T_UI_DISPLAY_LIST_FILL, args, 4))
+	{
+		uint16_t* pixels = T_UI_DISPLAY_LIST_pixels();
+		for (jint py = (y < gc.clip_y1) ? gc.clip_y1 : y; (py < (y + height)) && (py <= gc.clip_y2); py++)
+		{
+			for (jint px = (x < gc.clip_x1) ? gc.clip_x1 : x; (px < (x + width)) && (px <= gc.clip_x2); px++)
+			{
+				pixels[(py * WIDTH) + px] = (uint16_t)gc.foreground_color;
+			}
+		}
+		fills++;
+		LLUI_DISPLAY_setDrawingStatus(DRAWING_DONE);
+	}
+}
+
+/*
+ * Draws a region like an application: a background and a square of the given color.
+ *
+ * @return the value returned by the end of the region (false when it must be drawn again)
+ */
+static bool T_UI_DISPLAY_LIST_draw(jint x, jint y, jint width, jint height, uint16_t color)
+{
+	DRAWING_Status status;
+	UI_DISPLAY_LIST_begin(&gc, x, y, width, height);
+	gc.foreground_color = 0x1234;
+	T_UI_DISPLAY_LIST_fill(x, y, width, height);
+	gc.foreground_color = color;
+	T_UI_DISPLAY_LIST_fill(x + 4, y + 4, 16, 16);
+	bool drawn = UI_DISPLAY_LIST_end(&gc, &status);
+	drawing_status = status;
+	return drawn;
+}
+
+static void T_UI_DISPLAY_LIST_clip(jint x, jint y, jint width, jint height)
+{
+	gc.clip_x1 = (jshort)x;
+	gc.clip_y1 = (jshort)y;
+	gc.clip_x2 = (jshort)((x + width) - 1);
+	gc.clip_y2 = (jshort)((y + height) - 1);
+}
+
+static void T_UI_DISPLAY_LIST_check(uint32_t hits, uint32_t renders, uint32_t misses, uint32_t uncached, uint32_t invalidations)
+{
+	UI_DISPLAY_LIST_statistics_t statistics;
+	UI_DISPLAY_LIST_get_statistics(&statistics);
+	TEST_ASSERT_EQUAL_INT(hits, statistics.hits);
+	TEST_ASSERT_EQUAL_INT(renders, statistics.renders);
+	TEST_ASSERT_EQUAL_INT(misses, statistics.misses);
+	TEST_ASSERT_EQUAL_INT(uncached, statistics.uncached);
+	TEST_ASSERT_EQUAL_INT(invalidations, statistics.invalidations);
+}
+
+static void T_UI_DISPLAY_LIST_setUp(void)
+{
+	(void)memset(&gc, 0, sizeof(gc));
+	gc.image.width = WIDTH;
+	gc.image.height = HEIGHT;
+	gc.image.format = MICROUI_IMAGE_FORMAT_DISPLAY;
+	(void)LLUI_DISPLAY_allocateImageBuffer(&gc.image, 4);
+	(void)memset(T_UI_DISPLAY_LIST_pixels(), 0, WIDTH * HEIGHT * sizeof(uint16_t));
+	T_UI_DISPLAY_LIST_clip(0, 0, WIDTH, HEIGHT);
+	UI_DISPLAY_LIST_reset_statistics();
+	fills = 0;
+	copies = 0;
+	// start a new frame
+	(void)DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects);
+}
+
+static void T_UI_DISPLAY_LIST_tearDown(void)
+{
+	// forget the regions and give back their buffers to the images heap
+	for (uint32_t i = 0; i < UI_DISPLAY_LIST_REGIONS; i++)
+	{
+		_display_list_free(&g_regions[i]);
+	}
+	(void)memset(g_regions, 0, sizeof(g_regions));
+	g_mode = DISPLAY_LIST_IDLE;
+	g_region = NULL;
+	LLUI_DISPLAY_freeImageBuffer(&gc.image);
+}
+
+static void T_UI_DISPLAY_LIST_record(void)
+{
+	// first time: drawn and recorded
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	TEST_ASSERT_EQUAL_INT(2, fills);
+	TEST_ASSERT_EQUAL_INT(1, copies);
+	T_UI_DISPLAY_LIST_check(0, 1, 0, 0, 0);
+	(void)memcpy(snapshot, T_UI_DISPLAY_LIST_pixels(), sizeof(snapshot));
+
+	// next times: only hashed, the buffer is copied back
+	(void)DISPLAY_DIRTY_REGIONS_flush(0, 0, WIDTH - 1, HEIGHT - 1, rects);
+	(void)memset(T_UI_DISPLAY_LIST_pixels(), 0, WIDTH * HEIGHT * sizeof(uint16_t));
+	for (uint32_t i = 0; i < 3U; i++)
+	{
+		TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	}
+	TEST_ASSERT_EQUAL_INT(2, fills);
+	TEST_ASSERT_EQUAL_INT(4, copies);
+	TEST_ASSERT_EQUAL_INT(DRAWING_RUNNING, drawing_status);
+	T_UI_DISPLAY_LIST_check(3, 1, 0, 0, 0);
+	TEST_ASSERT(0 == memcmp(snapshot, T_UI_DISPLAY_LIST_pixels(), sizeof(snapshot)));
+
+	// the copied region is the dirty region of the frame
+	uint32_t count = DISPLAY_DIRTY_REGIONS_flush(REGION_X, REGION_Y, REGION_X + REGION_WIDTH - 1, REGION_Y + REGION_HEIGHT - 1, rects);
+	TEST_ASSERT_EQUAL_INT(1, count);
+	TEST_ASSERT_EQUAL_INT(REGION_X, rects[0].x1);
+	TEST_ASSERT_EQUAL_INT(REGION_Y, rects[0].y1);
+	TEST_ASSERT_EQUAL_INT(REGION_X + REGION_WIDTH - 1, rects[0].x2);
+	TEST_ASSERT_EQUAL_INT(REGION_Y + REGION_HEIGHT - 1, rects[0].y2);
+}
+
+static void T_UI_DISPLAY_LIST_changed(void)
+{
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+
+	// another color: the drawings are skipped, the application draws the region again
+	TEST_ASSERT(!T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0x07e0));
+	TEST_ASSERT_EQUAL_INT(2, fills);
+	T_UI_DISPLAY_LIST_check(0, 1, 1, 0, 0);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0x07e0));
+	TEST_ASSERT_EQUAL_INT(4, fills);
+	T_UI_DISPLAY_LIST_check(0, 2, 1, 0, 0);
+	(void)memcpy(snapshot, T_UI_DISPLAY_LIST_pixels(), sizeof(snapshot));
+
+	// the new drawings are copied back
+	(void)memset(T_UI_DISPLAY_LIST_pixels(), 0, WIDTH * HEIGHT * sizeof(uint16_t));
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0x07e0));
+	T_UI_DISPLAY_LIST_check(1, 2, 1, 0, 0);
+	TEST_ASSERT(0 == memcmp(snapshot, T_UI_DISPLAY_LIST_pixels(), sizeof(snapshot)));
+}
+
+static void T_UI_DISPLAY_LIST_invalidation(void)
+{
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+
+	// a rectangle outside the region
+	UI_DISPLAY_LIST_invalidate(REGION_X + REGION_WIDTH, 0, 10, 10);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	T_UI_DISPLAY_LIST_check(1, 1, 0, 0, 0);
+
+	// a rectangle which overlaps the region's corner: drawn and recorded again
+	UI_DISPLAY_LIST_invalidate(REGION_X + REGION_WIDTH - 1, REGION_Y + REGION_HEIGHT - 1, 10, 10);
+	T_UI_DISPLAY_LIST_check(1, 1, 0, 0, 1);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	TEST_ASSERT_EQUAL_INT(4, fills);
+	T_UI_DISPLAY_LIST_check(1, 2, 0, 0, 1);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	T_UI_DISPLAY_LIST_check(2, 2, 0, 0, 1);
+}
+
+static void T_UI_DISPLAY_LIST_clipChange(void)
+{
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+
+	// the buffer does not hold the pixels of the new clip: the region is recorded again
+	// (the clip is folded in the hash too)
+	T_UI_DISPLAY_LIST_clip(0, 0, WIDTH, REGION_Y + 40);
+	(void)memset(T_UI_DISPLAY_LIST_pixels(), 0, WIDTH * HEIGHT * sizeof(uint16_t));
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	TEST_ASSERT_EQUAL_INT(4, fills);
+	T_UI_DISPLAY_LIST_check(0, 2, 0, 0, 0);
+	(void)memcpy(snapshot, T_UI_DISPLAY_LIST_pixels(), sizeof(snapshot));
+
+	// the pixels outside the clip are not copied back
+	(void)memset(T_UI_DISPLAY_LIST_pixels(), 0, WIDTH * HEIGHT * sizeof(uint16_t));
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	T_UI_DISPLAY_LIST_check(1, 2, 0, 0, 0);
+	TEST_ASSERT(0 == memcmp(snapshot, T_UI_DISPLAY_LIST_pixels(), sizeof(snapshot)));
+}
+
+static void T_UI_DISPLAY_LIST_unhashed(void)
+{
+	DRAWING_Status status;
+
+	// a BSP drawing in the region: not recorded
+	UI_DISPLAY_LIST_begin(&gc, REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	T_UI_DISPLAY_LIST_fill(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	UI_DISPLAY_LIST_notify_drawing(&gc.image, REGION_X + 20, REGION_Y + 20, REGION_X + 30, REGION_Y + 30);
+	TEST_ASSERT(UI_DISPLAY_LIST_end(&gc, &status));
+	T_UI_DISPLAY_LIST_check(0, 0, 0, 1, 0);
+
+	// drawn as usual until it is invalidated
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	TEST_ASSERT_EQUAL_INT(3, fills);
+	T_UI_DISPLAY_LIST_check(0, 0, 0, 2, 0);
+	UI_DISPLAY_LIST_invalidate(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	T_UI_DISPLAY_LIST_check(0, 1, 0, 2, 1);
+
+	// a drawing of the Graphics Engine (a string) changes the pixels of the verified region:
+	// the region is drawn again, then as usual
+	UI_DISPLAY_LIST_begin(&gc, REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	gc.foreground_color = 0x1234;
+	T_UI_DISPLAY_LIST_fill(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	gc.foreground_color = 0xf800;
+	T_UI_DISPLAY_LIST_fill(REGION_X + 4, REGION_Y + 4, 16, 16);
+	T_UI_DISPLAY_LIST_pixels()[((REGION_Y + 30) * WIDTH) + REGION_X + 30] ^= 0xffffU;
+	TEST_ASSERT(!UI_DISPLAY_LIST_end(&gc, &status));
+	T_UI_DISPLAY_LIST_check(0, 1, 1, 2, 1);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	T_UI_DISPLAY_LIST_check(0, 1, 1, 3, 1);
+
+	// a drawing outside the region does not matter
+	UI_DISPLAY_LIST_invalidate(0, 0, WIDTH, HEIGHT);
+	UI_DISPLAY_LIST_begin(&gc, REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	T_UI_DISPLAY_LIST_fill(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	UI_DISPLAY_LIST_notify_drawing(&gc.image, 0, 0, REGION_X - 1, REGION_Y - 1);
+	TEST_ASSERT(UI_DISPLAY_LIST_end(&gc, &status));
+	T_UI_DISPLAY_LIST_check(0, 2, 1, 3, 2);
+}
+
+static void T_UI_DISPLAY_LIST_notRecorded(void)
+{
+	// too small: drawn as usual
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, 30, 30, 0xf800));
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, 30, 30, 0xf800));
+	TEST_ASSERT_EQUAL_INT(4, fills);
+	TEST_ASSERT_EQUAL_INT(0, copies);
+	T_UI_DISPLAY_LIST_check(0, 0, 0, 2, 0);
+
+	// outside the clip: nothing to record
+	T_UI_DISPLAY_LIST_clip(REGION_X + REGION_WIDTH, 0, 10, 10);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT, 0xf800));
+	T_UI_DISPLAY_LIST_check(0, 0, 0, 2, 0);
+
+	// nested regions: an error is reported and the started region goes on
+	T_UI_DISPLAY_LIST_clip(0, 0, WIDTH, HEIGHT);
+	UI_DISPLAY_LIST_begin(&gc, REGION_X, REGION_Y, REGION_WIDTH, REGION_HEIGHT);
+	UI_DISPLAY_LIST_begin(&gc, REGION_X, REGION_Y, 50, 50);
+	TEST_ASSERT(0 != (gc.drawing_log_flags & DRAWING_LOG_LIBRARY_INCIDENT));
+	DRAWING_Status status;
+	TEST_ASSERT(UI_DISPLAY_LIST_end(&gc, &status));
+	T_UI_DISPLAY_LIST_check(0, 1, 0, 2, 0);
+}
+
+static void T_UI_DISPLAY_LIST_leastRecentlyUsed(void)
+{
+	// one region more than the entries: the first region is replaced by the last one
+	for (jint i = 0; i <= (jint)UI_DISPLAY_LIST_REGIONS; i++)
+	{
+		TEST_ASSERT(T_UI_DISPLAY_LIST_draw((i % 4) * 50, (i / 4) * 34, 50, 33, 0xf800));
+	}
+	T_UI_DISPLAY_LIST_check(0, UI_DISPLAY_LIST_REGIONS + 1U, 0, 0, 0);
+
+	// the other regions are kept
+	for (jint i = 1; i <= (jint)UI_DISPLAY_LIST_REGIONS; i++)
+	{
+		TEST_ASSERT(T_UI_DISPLAY_LIST_draw((i % 4) * 50, (i / 4) * 34, 50, 33, 0xf800));
+	}
+	T_UI_DISPLAY_LIST_check(UI_DISPLAY_LIST_REGIONS, UI_DISPLAY_LIST_REGIONS + 1U, 0, 0, 0);
+	TEST_ASSERT(T_UI_DISPLAY_LIST_draw(0, 0, 50, 33, 0xf800));
+	T_UI_DISPLAY_LIST_check(UI_DISPLAY_LIST_REGIONS, UI_DISPLAY_LIST_REGIONS + 2U, 0, 0, 0);
+}
+
+TestRef T_UI_DISPLAY_LIST_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Record and copy", T_UI_DISPLAY_LIST_record),
+		new_TestFixture("Changed drawings", T_UI_DISPLAY_LIST_changed),
+		new_TestFixture("Invalidation", T_UI_DISPLAY_LIST_invalidation),
+		new_TestFixture("Clip change", T_UI_DISPLAY_LIST_clipChange),
+		new_TestFixture("Drawings not hashed", T_UI_DISPLAY_LIST_unhashed),
+		new_TestFixture("Regions not recorded", T_UI_DISPLAY_LIST_notRecorded),
+		new_TestFixture("Least recently used region", T_UI_DISPLAY_LIST_leastRecentlyUsed),
+	};
+
+	EMB_UNIT_TESTCALLER(displayListTest, "Display_list_tests", T_UI_DISPLAY_LIST_setUp, T_UI_DISPLAY_LIST_tearDown, fixtures);
+
+	return (TestRef)&displayListTest;
+}
@@ -0,0 +1,185 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "LLUI_DISPLAY.h"
+#include "ui_drawing_soft.h"
+#include "ui_drawing_dma2d.h"
+#include "x_ui_drawing.h"
+#include "t_ui_dma2d_shapes.h"
+
+#define T_UI_DMA2D_SHAPES_WIDTH 240
+#define T_UI_DMA2D_SHAPES_HEIGHT 180
+#define T_UI_DMA2D_SHAPES_BACKGROUND 0xa5U
+
+typedef enum
+{
+	T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE,
+	T_UI_DMA2D_SHAPES_ELLIPSE,
+	T_UI_DMA2D_SHAPES_CIRCLE,
+} T_UI_DMA2D_SHAPES_kind_t;
+
+static MICROUI_GraphicsContext dma2d_gc;
+static MICROUI_GraphicsContext soft_gc;
+
+static void T_UI_DMA2D_SHAPES_init_gc(MICROUI_GraphicsContext* gc)
+{
+	(void)memset(gc, 0, sizeof(MICROUI_GraphicsContext));
+	gc->image.width = T_UI_DMA2D_SHAPES_WIDTH;
+	gc->image.height = T_UI_DMA2D_SHAPES_HEIGHT;
+	gc->image.format = MICROUI_IMAGE_FORMAT_RGB565;
+	gc->foreground_color = (jint)0xff3c9a5eU;
+	(void)LLUI_DISPLAY_allocateImageBuffer(&gc->image, 0);
+}
+
+/*
+ * Draws a shape with the DMA2D drawer and with the software drawer in the given clip.
+ *
+ * @return true when both drawings give the same pixels
+ */
+static bool T_UI_DMA2D_SHAPES_compare(T_UI_DMA2D_SHAPES_kind_t kind, jint x, jint y, jint width, jint height, jint corner_width, jint corner_height, jint clip_x, jint clip_y, jint clip_width, jint clip_height)
+{
+	MICROUI_GraphicsContext* gcs[2] = { &dma2d_gc, &soft_gc };
+	// the clip is inside the graphics context
+	jint clip_x2 = (((clip_x + clip_width) - 1) < (T_UI_DMA2D_SHAPES_WIDTH - 1)) ? ((clip_x + clip_width) - 1) : (T_UI_DMA2D_SHAPES_WIDTH - 1);
+	jint clip_y2 = (((clip_y + clip_height) - 1) < (T_UI_DMA2D_SHAPES_HEIGHT - 1)) ? ((clip_y + clip_height) - 1) : (T_UI_DMA2D_SHAPES_HEIGHT - 1);
+	clip_x = (clip_x > 0) ? clip_x : 0;
+	clip_y = (clip_y > 0) ? clip_y : 0;
+	clip_width = (clip_x2 - clip_x) + 1;
+	clip_height = (clip_y2 - clip_y) + 1;
+	if ((clip_width <= 0) || (clip_height <= 0))
+	{
+		// nothing to draw
+		return true;
+	}
+	uint32_t size = LLUI_DISPLAY_getStrideInBytes(&dma2d_gc.image) * T_UI_DMA2D_SHAPES_HEIGHT;
+
+	for (uint32_t i = 0; i < 2U; i++)
+	{
+		MICROUI_GraphicsContext* gc = gcs[i];
+		(void)memset(LLUI_DISPLAY_getBufferAddress(&gc->image), T_UI_DMA2D_SHAPES_BACKGROUND, size);
+		LLUI_DISPLAY_setClip(gc, clip_x, clip_y, clip_width, clip_height);
+		LLUI_DISPLAY_configureClip(gc, true);
+		gc->drawing_log_flags = 0;
+
+		switch (kind)
+		{
+		case T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE:
+			(void)((0U == i) ? UI_DRAWING_fillRoundedRectangle(gc, x, y, width, height, corner_width, corner_height) : UI_DRAWING_SOFT_fillRoundedRectangle(gc, x, y, width, height, corner_width, corner_height));
+			break;
+		case T_UI_DMA2D_SHAPES_ELLIPSE:
+			(void)((0U == i) ? UI_DRAWING_fillEllipse(gc, x, y, width, height) : UI_DRAWING_SOFT_fillEllipse(gc, x, y, width, height));
+			break;
+		default:
+			(void)((0U == i) ? UI_DRAWING_fillCircle(gc, x, y, width) : UI_DRAWING_SOFT_fillCircle(gc, x, y, width));
+			break;
+		}
+	}
+
+	// same pixels and same clip
+	return (0 == memcmp(LLUI_DISPLAY_getBufferAddress(&dma2d_gc.image), LLUI_DISPLAY_getBufferAddress(&soft_gc.image), size))
+			&& (dma2d_gc.clip_x1 == clip_x) && (dma2d_gc.clip_y1 == clip_y)
+			&& (dma2d_gc.clip_x2 == clip_x2) && (dma2d_gc.clip_y2 == clip_y2);
+}
+
+/*
+ * Compares a shape in the whole graphics context and in some clips (inside the shape,
+ * across its edges, outside of it).
+ */
+static bool T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_kind_t kind, jint x, jint y, jint width, jint height, jint corner_width, jint corner_height)
+{
+	jint w2 = width / 2;
+	jint h2 = height / 2;
+	bool ret = T_UI_DMA2D_SHAPES_compare(kind, x, y, width, height, corner_width, corner_height, 0, 0, T_UI_DMA2D_SHAPES_WIDTH, T_UI_DMA2D_SHAPES_HEIGHT);
+	ret &= T_UI_DMA2D_SHAPES_compare(kind, x, y, width, height, corner_width, corner_height, x + 3, y + 5, w2, h2);
+	ret &= T_UI_DMA2D_SHAPES_compare(kind, x, y, width, height, corner_width, corner_height, x + (width / 4), y + (height / 4), w2, h2);
+	ret &= T_UI_DMA2D_SHAPES_compare(kind, x, y, width, height, corner_width, corner_height, x + w2, y - 2, width, h2 + 1);
+	ret &= T_UI_DMA2D_SHAPES_compare(kind, x, y, width, height, corner_width, corner_height, x + width, y, 10, 10);
+	return ret;
+}
+
+static void T_UI_DMA2D_SHAPES_setUp(void)
+{
+	T_UI_DMA2D_SHAPES_init_gc(&dma2d_gc);
+	T_UI_DMA2D_SHAPES_init_gc(&soft_gc);
+	X_UI_DRAWING_set_inset(0);
+}
+
+static void T_UI_DMA2D_SHAPES_tearDown(void)
+{
+	X_UI_DRAWING_set_inset(0);
+	LLUI_DISPLAY_freeImageBuffer(&soft_gc.image);
+	LLUI_DISPLAY_freeImageBuffer(&dma2d_gc.image);
+}
+
+static void T_UI_DMA2D_SHAPES_roundedRectangles(void)
+{
+	uint32_t tiles = X_UI_DRAWING_get_filled_tiles();
+	for (uint32_t inset = 0; inset < 2U; inset++)
+	{
+		X_UI_DRAWING_set_inset(inset);
+		for (jint corner = 0; corner <= 80; corner += 3)
+		{
+			// even and odd sizes, corners which join, corner ellipse larger than the rectangle
+			TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE, 20, 10, 120, 90, corner, corner));
+			TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE, 21, 11, 121, 91, corner, (corner / 2) + 1));
+			TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE, 5, 40, 200, 50, corner + 1, corner));
+			TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE, 30, 5, 50, 160, corner, corner + 2));
+		}
+		// partially outside of the graphics context
+		TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE, -30, -20, 120, 90, 24, 30));
+		TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ROUNDED_RECTANGLE, 180, 130, 120, 90, 31, 17));
+	}
+	// the interior has been filled by the DMA2D
+	TEST_ASSERT(X_UI_DRAWING_get_filled_tiles() > tiles);
+}
+
+static void T_UI_DMA2D_SHAPES_circles(void)
+{
+	uint32_t tiles = X_UI_DRAWING_get_filled_tiles();
+	for (uint32_t inset = 0; inset < 2U; inset++)
+	{
+		X_UI_DRAWING_set_inset(inset);
+		for (jint diameter = 1; diameter <= 170; diameter++)
+		{
+			TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_CIRCLE, 4 + (diameter % 7), 3 + (diameter % 5), diameter, diameter, 0, 0));
+		}
+		TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_CIRCLE, -40, -30, 120, 120, 0, 0));
+		TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_CIRCLE, 170, 110, 101, 101, 0, 0));
+	}
+	TEST_ASSERT(X_UI_DRAWING_get_filled_tiles() > tiles);
+}
+
+static void T_UI_DMA2D_SHAPES_ellipses(void)
+{
+	uint32_t tiles = X_UI_DRAWING_get_filled_tiles();
+	for (uint32_t inset = 0; inset < 2U; inset++)
+	{
+		X_UI_DRAWING_set_inset(inset);
+		for (jint width = 2; width <= 230; width += 7)
+		{
+			for (jint height = 2; height <= 170; height += 9)
+			{
+				TEST_ASSERT(T_UI_DMA2D_SHAPES_compare_clips(T_UI_DMA2D_SHAPES_ELLIPSE, 3, 4, width, height, 0, 0));
+			}
+		}
+	}
+	TEST_ASSERT(X_UI_DRAWING_get_filled_tiles() > tiles);
+}
+
+TestRef T_UI_DMA2D_SHAPES_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Rounded rectangles", T_UI_DMA2D_SHAPES_roundedRectangles),
+		new_TestFixture("Circles", T_UI_DMA2D_SHAPES_circles),
+		new_TestFixture("Ellipses", T_UI_DMA2D_SHAPES_ellipses),
+	};
+
+	EMB_UNIT_TESTCALLER(dma2dShapesTest, "DMA2D_shapes_tests", T_UI_DMA2D_SHAPES_setUp, T_UI_DMA2D_SHAPES_tearDown, fixtures);
+
+	return (TestRef)&dma2dShapesTest;
+}
@@ -0,0 +1,383 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_dma2d_transform.h"
+#include "framerate_impl.h"
+
+/*
+ * The transform engine is built with the tiles aligned like on the target (the CMSIS
+ * macro is not defined on the host).
+ */
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+#include "../../../../../ui/src/ui_drawing_dma2d_transform.c"
+
+#define T_UI_DMA2D_TRANSFORM_WIDTH 480
+#define T_UI_DMA2D_TRANSFORM_HEIGHT 272
+#define T_UI_DMA2D_TRANSFORM_IMAGE 128
+#define T_UI_DMA2D_TRANSFORM_LOOPS 20U
+#define T_UI_DMA2D_TRANSFORM_BACKGROUND 0x5a5aU
+
+typedef enum
+{
+	T_UI_DMA2D_TRANSFORM_SCALED_NEAREST,
+	T_UI_DMA2D_TRANSFORM_SCALED_BILINEAR,
+	T_UI_DMA2D_TRANSFORM_ROTATED_NEAREST,
+	T_UI_DMA2D_TRANSFORM_ROTATED_BILINEAR,
+} T_UI_DMA2D_TRANSFORM_kind_t;
+
+static const char* const kind_names[] = { "scaled nearest neighbor", "scaled bilinear", "rotated nearest neighbor", "rotated bilinear" };
+
+static MICROUI_GraphicsContext dma2d_gc;
+static MICROUI_GraphicsContext reference_gc;
+static MICROUI_Image image;
+
+/*
+ * The tiles blended by the DMA2D stub and the time spent in the stub (done by the
+ * DMA2D on the target while the CPU samples the next tile).
+ */
+static uint32_t blended_tiles;
+static uint32_t blend_cycles;
+
+/*
+ * Blends an ARGB8888 pixel with an opacity in a RGB565 pixel, like the DMA2D blender.
+ */
+static void T_UI_DMA2D_TRANSFORM_blend(uint16_t* dest, uint32_t pixel, jint alpha)
+{
+	uint32_t a = (((pixel >> 24) * (uint32_t)alpha) + 127U) / 255U;
+	if (0U == a)
+	{
+		return;
+	}
+	uint32_t d = *dest;
+	uint32_t dr = (((d >> 11) & 0x1fU) << 3) | ((d >> 13) & 0x7U);
+	uint32_t dg = (((d >> 5) & 0x3fU) << 2) | ((d >> 9) & 0x3U);
+	uint32_t db = ((d & 0x1fU) << 3) | ((d >> 2) & 0x7U);
+	uint32_t r = (((((pixel >> 16) & 0xffU) * a) + (dr * (255U - a))) + 127U) / 255U;
+	uint32_t g = (((((pixel >> 8) & 0xffU) * a) + (dg * (255U - a))) + 127U) / 255U;
+	uint32_t b = ((((pixel & 0xffU) * a) + (db * (255U - a))) + 127U) / 255U;
+	*dest = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+static uint16_t* T_UI_DMA2D_TRANSFORM_pixel(MICROUI_GraphicsContext* gc, jint x, jint y)
+{
+	uint16_t* pixels = (uint16_t*)LLUI_DISPLAY_getBufferAddress(&gc->image);
+	return &pixels[(y * T_UI_DMA2D_TRANSFORM_WIDTH) + x];
+}
+
+uint32_t UI_DRAWING_DMA2D_blend_tile(MICROUI_GraphicsContext* gc, uint32_t* tile, jint x, jint y, jint width, jint height, jint alpha, bool last)
+{
+	(void)last;
+	uint32_t t0 = framerate_impl_get_cycles();
+	for (jint j = 0; j < height; j++)
+	{
+		for (jint i = 0; i < width; i++)
+		{
+			T_UI_DMA2D_TRANSFORM_blend(T_UI_DMA2D_TRANSFORM_pixel(gc, x + i, y + j), tile[(j * width) + i], alpha);
+		}
+	}
+	blend_cycles += framerate_impl_get_cycles() - t0;
+	blended_tiles++;
+	return blended_tiles;
+}
+
+void UI_DRAWING_DMA2D_wait_job(uint32_t job)
+{
+	// the DMA2D stub blends the tile at once
+	(void)job;
+}
+
+/*
+ * The software drawer is used for the custom formats only (not tested).
+ */
+DRAWING_Status DW_DRAWING_SOFT_drawRotatedImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha)
+{
+	(void)gc;
+	(void)img;
+	(void)x;
+	(void)y;
+	(void)rotationX;
+	(void)rotationY;
+	(void)angle;
+	(void)alpha;
+	return DRAWING_DONE;
+}
+
+DRAWING_Status DW_DRAWING_SOFT_drawRotatedImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jint rotationX, jint rotationY, jfloat angle, jint alpha)
+{
+	return DW_DRAWING_SOFT_drawRotatedImageNearestNeighbor(gc, img, x, y, rotationX, rotationY, angle, alpha);
+}
+
+DRAWING_Status DW_DRAWING_SOFT_drawScaledImageNearestNeighbor(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha)
+{
+	(void)gc;
+	(void)img;
+	(void)x;
+	(void)y;
+	(void)factorX;
+	(void)factorY;
+	(void)alpha;
+	return DRAWING_DONE;
+}
+
+DRAWING_Status DW_DRAWING_SOFT_drawScaledImageBilinear(MICROUI_GraphicsContext* gc, MICROUI_Image* img, jint x, jint y, jfloat factorX, jfloat factorY, jint alpha)
+{
+	return DW_DRAWING_SOFT_drawScaledImageNearestNeighbor(gc, img, x, y, factorX, factorY, alpha);
+}
+
+static void T_UI_DMA2D_TRANSFORM_init_gc(MICROUI_GraphicsContext* gc)
+{
+	(void)memset(gc, 0, sizeof(MICROUI_GraphicsContext));
+	gc->image.width = T_UI_DMA2D_TRANSFORM_WIDTH;
+	gc->image.height = T_UI_DMA2D_TRANSFORM_HEIGHT;
+	gc->image.format = MICROUI_IMAGE_FORMAT_RGB565;
+	gc->clip_x1 = 0;
+	gc->clip_y1 = 0;
+	gc->clip_x2 = T_UI_DMA2D_TRANSFORM_WIDTH - 1;
+	gc->clip_y2 = T_UI_DMA2D_TRANSFORM_HEIGHT - 1;
+	(void)LLUI_DISPLAY_allocateImageBuffer(&gc->image, 0);
+}
+
+static void T_UI_DMA2D_TRANSFORM_clear(MICROUI_GraphicsContext* gc)
+{
+	for (jint y = 0; y < T_UI_DMA2D_TRANSFORM_HEIGHT; y++)
+	{
+		for (jint x = 0; x < T_UI_DMA2D_TRANSFORM_WIDTH; x++)
+		{
+			*T_UI_DMA2D_TRANSFORM_pixel(gc, x, y) = T_UI_DMA2D_TRANSFORM_BACKGROUND;
+		}
+	}
+}
+
+/*
+ * Configures the inverse transformation with the functions of the DMA2D drawer (drawing
+ * in an empty clip) and returns the destination region.
+ */
+static void T_UI_DMA2D_TRANSFORM_configure(T_UI_DMA2D_TRANSFORM_kind_t kind, DRAWING_DMA2D_transform_t* transform, jint* x1, jint* y1, jint* x2, jint* y2)
+{
+	MICROUI_GraphicsContext empty_gc;
+	(void)memset(&empty_gc, 0, sizeof(empty_gc));
+	empty_gc.clip_x1 = 1;
+	empty_gc.clip_x2 = 0;
+	(void)_transform_initialize(transform, &empty_gc, &image, (T_UI_DMA2D_TRANSFORM_SCALED_BILINEAR == kind) || (T_UI_DMA2D_TRANSFORM_ROTATED_BILINEAR == kind));
+	if ((T_UI_DMA2D_TRANSFORM_SCALED_NEAREST == kind) || (T_UI_DMA2D_TRANSFORM_SCALED_BILINEAR == kind))
+	{
+		(void)_transform_draw_scaled(&empty_gc, transform, 40, 10, 2.5f, 1.75f, 0);
+		*x1 = 40;
+		*y1 = 10;
+		*x2 = 40 + (jint)(T_UI_DMA2D_TRANSFORM_IMAGE * 2.5f) - 1;
+		*y2 = 10 + (jint)(T_UI_DMA2D_TRANSFORM_IMAGE * 1.75f) - 1;
+	}
+	else
+	{
+		(void)_transform_draw_rotated(&empty_gc, transform, 176, 72, 240, 136, 30.f, 0);
+		// bounding box of the rotated image (margin of the bilinear sampling included)
+		*x1 = T_UI_DMA2D_TRANSFORM_WIDTH;
+		*y1 = T_UI_DMA2D_TRANSFORM_HEIGHT;
+		*x2 = 0;
+		*y2 = 0;
+		for (uint32_t corner = 0; corner < 4U; corner++)
+		{
+			float dx = (float)(176 + (((corner & 1U) != 0U) ? T_UI_DMA2D_TRANSFORM_IMAGE : 0) - 240);
+			float dy = (float)(72 + (((corner & 2U) != 0U) ? T_UI_DMA2D_TRANSFORM_IMAGE : 0) - 136);
+			jint px = (jint)(240.f + (dx * transform->du_dx) - (dy * transform->du_dy));
+			jint py = (jint)(136.f - (dx * transform->dv_dx) + (dy * transform->dv_dy));
+			*x1 = ((px - 2) < *x1) ? (px - 2) : *x1;
+			*y1 = ((py - 2) < *y1) ? (py - 2) : *y1;
+			*x2 = ((px + 2) > *x2) ? (px + 2) : *x2;
+			*y2 = ((py + 2) > *y2) ? (py + 2) : *y2;
+		}
+	}
+}
+
+/*
+ * The software-only reference: each destination pixel is sampled and blended at once,
+ * its source position being computed in floating point.
+ */
+static void T_UI_DMA2D_TRANSFORM_reference(T_UI_DMA2D_TRANSFORM_kind_t kind, jint alpha)
+{
+	DRAWING_DMA2D_transform_t transform;
+	jint x1;
+	jint y1;
+	jint x2;
+	jint y2;
+	T_UI_DMA2D_TRANSFORM_configure(kind, &transform, &x1, &y1, &x2, &y2);
+
+	for (jint y = (y1 > 0) ? y1 : 0; (y <= y2) && (y < T_UI_DMA2D_TRANSFORM_HEIGHT); y++)
+	{
+		for (jint x = (x1 > 0) ? x1 : 0; (x <= x2) && (x < T_UI_DMA2D_TRANSFORM_WIDTH); x++)
+		{
+			float u = transform.u0 + ((float)x * transform.du_dx) + ((float)y * transform.du_dy);
+			float v = transform.v0 + ((float)x * transform.dv_dx) + ((float)y * transform.dv_dy);
+			T_UI_DMA2D_TRANSFORM_blend(T_UI_DMA2D_TRANSFORM_pixel(&reference_gc, x, y), _transform_sample(&transform, _transform_to_fixed(u), _transform_to_fixed(v)), alpha);
+		}
+	}
+}
+
+static void T_UI_DMA2D_TRANSFORM_draw(T_UI_DMA2D_TRANSFORM_kind_t kind, jint alpha)
+{
+	switch (kind)
+	{
+	case T_UI_DMA2D_TRANSFORM_SCALED_NEAREST:
+		(void)UI_DRAWING_DMA2D_drawScaledImageNearestNeighbor(&dma2d_gc, &image, 40, 10, 2.5f, 1.75f, alpha);
+		break;
+	case T_UI_DMA2D_TRANSFORM_SCALED_BILINEAR:
+		(void)UI_DRAWING_DMA2D_drawScaledImageBilinear(&dma2d_gc, &image, 40, 10, 2.5f, 1.75f, alpha);
+		break;
+	case T_UI_DMA2D_TRANSFORM_ROTATED_NEAREST:
+		(void)UI_DRAWING_DMA2D_drawRotatedImageNearestNeighbor(&dma2d_gc, &image, 176, 72, 240, 136, 30.f, alpha);
+		break;
+	default:
+		(void)UI_DRAWING_DMA2D_drawRotatedImageBilinear(&dma2d_gc, &image, 176, 72, 240, 136, 30.f, alpha);
+		break;
+	}
+}
+
+/*
+ * Draws the image with the DMA2D drawer and with the reference.
+ *
+ * @return the number of pixels that differ by more than one step of a channel
+ */
+static uint32_t T_UI_DMA2D_TRANSFORM_compare(T_UI_DMA2D_TRANSFORM_kind_t kind, jint alpha)
+{
+	T_UI_DMA2D_TRANSFORM_clear(&dma2d_gc);
+	T_UI_DMA2D_TRANSFORM_clear(&reference_gc);
+	T_UI_DMA2D_TRANSFORM_draw(kind, alpha);
+	T_UI_DMA2D_TRANSFORM_reference(kind, alpha);
+
+	uint32_t errors = 0;
+	for (jint y = 0; y < T_UI_DMA2D_TRANSFORM_HEIGHT; y++)
+	{
+		for (jint x = 0; x < T_UI_DMA2D_TRANSFORM_WIDTH; x++)
+		{
+			uint32_t a = *T_UI_DMA2D_TRANSFORM_pixel(&dma2d_gc, x, y);
+			uint32_t b = *T_UI_DMA2D_TRANSFORM_pixel(&reference_gc, x, y);
+			int32_t dr = (int32_t)((a >> 11) & 0x1fU) - (int32_t)((b >> 11) & 0x1fU);
+			int32_t dg = (int32_t)((a >> 5) & 0x3fU) - (int32_t)((b >> 5) & 0x3fU);
+			int32_t db = (int32_t)(a & 0x1fU) - (int32_t)(b & 0x1fU);
+			// the positions of the DMA2D drawer are stepped in fixed point along the lines
+			if ((dr > 1) || (dr < -1) || (dg > 1) || (dg < -1) || (db > 1) || (db < -1))
+			{
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+static void T_UI_DMA2D_TRANSFORM_setUp(void)
+{
+	T_UI_DMA2D_TRANSFORM_init_gc(&dma2d_gc);
+	T_UI_DMA2D_TRANSFORM_init_gc(&reference_gc);
+
+	// an ARGB8888 image: color gradients, transparent border and a translucent disc
+	(void)memset(&image, 0, sizeof(image));
+	image.width = T_UI_DMA2D_TRANSFORM_IMAGE;
+	image.height = T_UI_DMA2D_TRANSFORM_IMAGE;
+	image.format = MICROUI_IMAGE_FORMAT_ARGB8888;
+	(void)LLUI_DISPLAY_allocateImageBuffer(&image, 0);
+	uint32_t* pixels = (uint32_t*)LLUI_DISPLAY_getBufferAddress(&image);
+	for (uint32_t y = 0; y < T_UI_DMA2D_TRANSFORM_IMAGE; y++)
+	{
+		for (uint32_t x = 0; x < T_UI_DMA2D_TRANSFORM_IMAGE; x++)
+		{
+			int32_t dx = (int32_t)x - (T_UI_DMA2D_TRANSFORM_IMAGE / 2);
+			int32_t dy = (int32_t)y - (T_UI_DMA2D_TRANSFORM_IMAGE / 2);
+			uint32_t a = (((dx * dx) + (dy * dy)) < (40 * 40)) ? 0x80U : 0xffU;
+			a = ((x < 4U) || (y < 4U)) ? 0U : a;
+			pixels[(y * T_UI_DMA2D_TRANSFORM_IMAGE) + x] = (a << 24) | ((x * 2U) << 16) | ((y * 2U) << 8) | ((x + y) & 0xffU);
+		}
+	}
+}
+
+static void T_UI_DMA2D_TRANSFORM_tearDown(void)
+{
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	LLUI_DISPLAY_freeImageBuffer(&dma2d_gc.image);
+	LLUI_DISPLAY_freeImageBuffer(&reference_gc.image);
+}
+
+/*
+ * At most 0.5% of the pixels may differ (the sampled position is rounded differently).
+ */
+static void T_UI_DMA2D_TRANSFORM_check(T_UI_DMA2D_TRANSFORM_kind_t kind)
+{
+	const uint32_t max_errors = (T_UI_DMA2D_TRANSFORM_WIDTH * T_UI_DMA2D_TRANSFORM_HEIGHT) / 200;
+	TEST_ASSERT(T_UI_DMA2D_TRANSFORM_compare(kind, 0xff) <= max_errors);
+	TEST_ASSERT(T_UI_DMA2D_TRANSFORM_compare(kind, 0x80) <= max_errors);
+}
+
+static void T_UI_DMA2D_TRANSFORM_scaledNearest(void)
+{
+	T_UI_DMA2D_TRANSFORM_check(T_UI_DMA2D_TRANSFORM_SCALED_NEAREST);
+}
+
+static void T_UI_DMA2D_TRANSFORM_scaledBilinear(void)
+{
+	T_UI_DMA2D_TRANSFORM_check(T_UI_DMA2D_TRANSFORM_SCALED_BILINEAR);
+}
+
+static void T_UI_DMA2D_TRANSFORM_rotatedNearest(void)
+{
+	T_UI_DMA2D_TRANSFORM_check(T_UI_DMA2D_TRANSFORM_ROTATED_NEAREST);
+}
+
+static void T_UI_DMA2D_TRANSFORM_rotatedBilinear(void)
+{
+	T_UI_DMA2D_TRANSFORM_check(T_UI_DMA2D_TRANSFORM_ROTATED_BILINEAR);
+}
+
+/*
+ * Before: the software-only reference samples and blends each pixel. After: the CPU
+ * samples the tiles (the time of the DMA2D stub is removed: the DMA2D blends a tile
+ * while the CPU samples the next one).
+ */
+static void T_UI_DMA2D_TRANSFORM_benchmark(void)
+{
+	printf("Transform benchmark: %dx%d ARGB8888 image, %u drawings (us per drawing)\n", T_UI_DMA2D_TRANSFORM_IMAGE, T_UI_DMA2D_TRANSFORM_IMAGE, (unsigned int)T_UI_DMA2D_TRANSFORM_LOOPS);
+	for (int32_t kind = T_UI_DMA2D_TRANSFORM_SCALED_NEAREST; kind <= T_UI_DMA2D_TRANSFORM_ROTATED_BILINEAR; kind++)
+	{
+		uint32_t t0 = framerate_impl_get_cycles();
+		for (uint32_t i = 0; i < T_UI_DMA2D_TRANSFORM_LOOPS; i++)
+		{
+			T_UI_DMA2D_TRANSFORM_reference((T_UI_DMA2D_TRANSFORM_kind_t)kind, 0xff);
+		}
+		uint32_t t1 = framerate_impl_get_cycles();
+		blend_cycles = 0;
+		blended_tiles = 0;
+		for (uint32_t i = 0; i < T_UI_DMA2D_TRANSFORM_LOOPS; i++)
+		{
+			T_UI_DMA2D_TRANSFORM_draw((T_UI_DMA2D_TRANSFORM_kind_t)kind, 0xff);
+		}
+		uint32_t t2 = framerate_impl_get_cycles();
+
+		uint32_t reference_us = framerate_impl_cycles_to_us(t1 - t0) / T_UI_DMA2D_TRANSFORM_LOOPS;
+		uint32_t sampling_us = framerate_impl_cycles_to_us((t2 - t1) - blend_cycles) / T_UI_DMA2D_TRANSFORM_LOOPS;
+		uint32_t blend_us = framerate_impl_cycles_to_us(blend_cycles) / T_UI_DMA2D_TRANSFORM_LOOPS;
+		printf("%-24s: software reference %5u us, CPU sampling %5u us (%u tiles, blending %u us on the CPU of the host)\n", kind_names[kind],
+				(unsigned int)reference_us, (unsigned int)sampling_us, (unsigned int)(blended_tiles / T_UI_DMA2D_TRANSFORM_LOOPS), (unsigned int)blend_us);
+		TEST_ASSERT(blended_tiles > 0U);
+	}
+}
+
+TestRef T_UI_DMA2D_TRANSFORM_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Scaled nearest neighbor", T_UI_DMA2D_TRANSFORM_scaledNearest),
+		new_TestFixture("Scaled bilinear", T_UI_DMA2D_TRANSFORM_scaledBilinear),
+		new_TestFixture("Rotated nearest neighbor", T_UI_DMA2D_TRANSFORM_rotatedNearest),
+		new_TestFixture("Rotated bilinear", T_UI_DMA2D_TRANSFORM_rotatedBilinear),
+		new_TestFixture("Benchmark", T_UI_DMA2D_TRANSFORM_benchmark),
+	};
+
+	EMB_UNIT_TESTCALLER(dma2dTransformTest, "DMA2D_transform_tests", T_UI_DMA2D_TRANSFORM_setUp, T_UI_DMA2D_TRANSFORM_tearDown, fixtures);
+
+	return (TestRef)&dma2dTransformTest;
+}
@@ -0,0 +1,171 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "x_ui_host.h"
+#include "framerate.h"
+#include "t_ui_framerate.h"
+
+// flush latency of the simulated frames
+#define T_UI_FRAMERATE_LATENCY_US 3000U
+
+/*
+ * Draws a frame during render_us from the current simulated time and flushes it; the
+ * frame is displayed T_UI_FRAMERATE_LATENCY_US after the flush (the pacing may have
+ * moved the time forward). The restore copy of the previous frame lasted restore_us.
+ */
+static void T_UI_FRAMERATE_frame(uint32_t render_us, uint32_t restore_us)
+{
+	framerate_frame_drawing();
+	X_UI_HOST_set_time(X_UI_HOST_get_time() + render_us);
+	framerate_frame_flush(restore_us * 1000U);
+	uint64_t end = X_UI_HOST_get_time();
+	X_UI_HOST_set_time(end + T_UI_FRAMERATE_LATENCY_US);
+	framerate_frame_vsync();
+	X_UI_HOST_set_time(end);
+}
+
+static void T_UI_FRAMERATE_frames(uint32_t count, uint32_t render_us, uint32_t restore_us)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		T_UI_FRAMERATE_frame(render_us, restore_us);
+	}
+}
+
+static void T_UI_FRAMERATE_setUp(void)
+{
+	X_UI_HOST_set_time(0);
+	(void)framerate_set_pacing(FRAMERATE_PACING_OFF);
+	// forget the frame drawn and the vertical blanking of the previous tests
+	T_UI_FRAMERATE_frame(0, 0);
+}
+
+static void T_UI_FRAMERATE_tearDown(void)
+{
+	(void)framerate_set_pacing(FRAMERATE_PACING_OFF);
+	X_UI_HOST_release_time();
+}
+
+static void T_UI_FRAMERATE_histogram(void)
+{
+	// a full window
+	T_UI_FRAMERATE_frames(60, 1000, 2000);
+	T_UI_FRAMERATE_frames(54, 5000, 2000);
+	T_UI_FRAMERATE_frames(6, 12000, 2000);
+
+	// nearest rank, upper bound of the bucket
+	TEST_ASSERT_EQUAL_INT(1250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 1));
+	TEST_ASSERT_EQUAL_INT(1250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 50));
+	TEST_ASSERT_EQUAL_INT(5250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 51));
+	TEST_ASSERT_EQUAL_INT(5250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 95));
+	TEST_ASSERT_EQUAL_INT(12250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 96));
+	TEST_ASSERT_EQUAL_INT(12250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 100));
+	TEST_ASSERT_EQUAL_INT(2250, framerate_get_percentile(FRAMERATE_METRIC_RESTORE, 50));
+	TEST_ASSERT_EQUAL_INT(T_UI_FRAMERATE_LATENCY_US + 250U, framerate_get_percentile(FRAMERATE_METRIC_FLUSH_LATENCY, 50));
+
+	// an unknown restore time is not recorded
+	T_UI_FRAMERATE_frames(FRAMERATE_HISTOGRAM_FRAMES, 2000, 0);
+	TEST_ASSERT_EQUAL_INT(2250, framerate_get_percentile(FRAMERATE_METRIC_RESTORE, 100));
+
+	// the window forgets the oldest frames
+	TEST_ASSERT_EQUAL_INT(2250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 1));
+	TEST_ASSERT_EQUAL_INT(2250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 100));
+
+	// the longer times are counted in the last bucket
+	T_UI_FRAMERATE_frame(100000, 100000);
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_HISTOGRAM_BUCKETS * FRAMERATE_HISTOGRAM_BUCKET_US, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 100));
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_HISTOGRAM_BUCKETS * FRAMERATE_HISTOGRAM_BUCKET_US, framerate_get_percentile(FRAMERATE_METRIC_RESTORE, 100));
+	TEST_ASSERT_EQUAL_INT(2250, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 99));
+}
+
+static void T_UI_FRAMERATE_errors(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, framerate_get_percentile(-1, 50));
+	TEST_ASSERT_EQUAL_INT(0, framerate_get_percentile(FRAMERATE_METRICS, 50));
+	TEST_ASSERT_EQUAL_INT(0, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 0));
+	TEST_ASSERT_EQUAL_INT(0, framerate_get_percentile(FRAMERATE_METRIC_RENDER, 101));
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_ERROR, framerate_set_pacing(FRAMERATE_PACING_ADAPTIVE + 1));
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_ERROR, framerate_set_pacing(-1));
+}
+
+static void T_UI_FRAMERATE_pacing(void)
+{
+	// the frames fit in the refresh period: no pacing
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_OK, framerate_set_pacing(FRAMERATE_PACING_ADAPTIVE));
+	T_UI_FRAMERATE_frames(FRAMERATE_HISTOGRAM_FRAMES, 5000, 1000);
+	TEST_ASSERT_EQUAL_INT(1, framerate_get_pacing_divisor());
+	uint64_t start = X_UI_HOST_get_time();
+	T_UI_FRAMERATE_frame(5000, 1000);
+	TEST_ASSERT_EQUAL_INT(5000, X_UI_HOST_get_time() - start);
+
+	// more than 5% of the frames miss the vertical blanking: two refresh periods per frame
+	T_UI_FRAMERATE_frames(FRAMERATE_PACING_PERIOD - 2U, 20000, 1000);
+	TEST_ASSERT_EQUAL_INT(1, framerate_get_pacing_divisor());
+	T_UI_FRAMERATE_frame(20000, 1000);
+	TEST_ASSERT_EQUAL_INT(2, framerate_get_pacing_divisor());
+
+	// the flush sleeps until the end of the period (waking up less than 1ms before)
+	for (uint32_t i = 0; i < 10U; i++)
+	{
+		start = X_UI_HOST_get_time();
+		T_UI_FRAMERATE_frame(20000, 1000);
+		uint64_t period = X_UI_HOST_get_time() - start;
+		TEST_ASSERT(period <= (2U * FRAMERATE_PANEL_REFRESH_US));
+		TEST_ASSERT(period > ((2U * FRAMERATE_PANEL_REFRESH_US) - 1000U));
+	}
+
+	// the divisor is capped (the histograms saturate at their last bucket)
+	T_UI_FRAMERATE_frames(FRAMERATE_HISTOGRAM_FRAMES, 100000, 100000);
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_PACING_MAX_DIVISOR, framerate_get_pacing_divisor());
+
+	// faster frames: one step at a time, once per pacing period
+	T_UI_FRAMERATE_frames(FRAMERATE_HISTOGRAM_FRAMES, 5000, 1000);
+	uint32_t divisor = framerate_get_pacing_divisor();
+	uint32_t frames = 0;
+	uint32_t last_step = 0;
+	while ((divisor > 1U) && (frames < (FRAMERATE_PACING_MAX_DIVISOR * FRAMERATE_PACING_PERIOD)))
+	{
+		T_UI_FRAMERATE_frame(5000, 1000);
+		frames++;
+		uint32_t d = framerate_get_pacing_divisor();
+		TEST_ASSERT((d == divisor) || ((d + 1U) == divisor));
+		if ((d != divisor) && (0U != last_step))
+		{
+			TEST_ASSERT_EQUAL_INT(FRAMERATE_PACING_PERIOD, frames - last_step);
+		}
+		last_step = (d != divisor) ? frames : last_step;
+		divisor = d;
+	}
+	TEST_ASSERT_EQUAL_INT(1, divisor);
+
+	// no sleep anymore
+	start = X_UI_HOST_get_time();
+	T_UI_FRAMERATE_frame(5000, 1000);
+	TEST_ASSERT_EQUAL_INT(5000, X_UI_HOST_get_time() - start);
+
+	// the pacing is reset when it is disabled
+	T_UI_FRAMERATE_frames(FRAMERATE_HISTOGRAM_FRAMES, 40000, 1000);
+	TEST_ASSERT(framerate_get_pacing_divisor() > 1U);
+	TEST_ASSERT_EQUAL_INT(FRAMERATE_OK, framerate_set_pacing(FRAMERATE_PACING_OFF));
+	TEST_ASSERT_EQUAL_INT(1, framerate_get_pacing_divisor());
+	start = X_UI_HOST_get_time();
+	T_UI_FRAMERATE_frame(40000, 1000);
+	TEST_ASSERT_EQUAL_INT(40000, X_UI_HOST_get_time() - start);
+}
+
+TestRef T_UI_FRAMERATE_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Histograms", T_UI_FRAMERATE_histogram),
+		new_TestFixture("Errors", T_UI_FRAMERATE_errors),
+		new_TestFixture("Adaptive pacing", T_UI_FRAMERATE_pacing),
+	};
+
+	EMB_UNIT_TESTCALLER(framerateTest, "Framerate_tests", T_UI_FRAMERATE_setUp, T_UI_FRAMERATE_tearDown, fixtures);
+
+	return (TestRef)&framerateTest;
+}
@@ -0,0 +1,210 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "LLUI_DISPLAY.h"
+#include "ui_glyph_atlas_sheet.h"
+#include "x_ui_host.h"
+#include "t_ui_glyph_atlas_sheet.h"
+
+/*
+ * The sheet holds 4 cells of 7x5 pixels on 2 lines: 'A' is a 3x2 box at (2, 1), 'B' is
+ * the full cell, 'C' is blank and 'D' is a single pixel at (6, 4).
+ */
+#define T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH 7U
+#define T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT 5U
+
+static MICROUI_Image sheet_image;
+
+static uint8_t T_UI_GLYPH_ATLAS_SHEET_expected(uint32_t x, uint32_t y)
+{
+	uint32_t cell = ((y / T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT) * 2U) + (x / T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH);
+	uint32_t cx = x % T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH;
+	uint32_t cy = y % T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT;
+	bool set;
+	switch (cell)
+	{
+	case 0:
+		set = (cx >= 2U) && (cx <= 4U) && (cy >= 1U) && (cy <= 2U);
+		break;
+	case 1:
+		set = true;
+		break;
+	case 3:
+		set = (6U == cx) && (4U == cy);
+		break;
+	default:
+		set = false;
+		break;
+	}
+	// A4: a multiple of 0x11
+	return set ? (uint8_t)(0x11U * (1U + ((x + y) % 15U))) : 0U;
+}
+
+/*
+ * Allocates the sheet image in the given format and draws the cells.
+ */
+static void T_UI_GLYPH_ATLAS_SHEET_draw(jbyte format)
+{
+	sheet_image.width = (jchar)(2U * T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH);
+	sheet_image.height = (jchar)(2U * T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT);
+	sheet_image.format = format;
+	(void)LLUI_DISPLAY_allocateImageBuffer(&sheet_image, 0);
+
+	uint8_t* pixels = LLUI_DISPLAY_getBufferAddress(&sheet_image);
+	uint32_t stride = LLUI_DISPLAY_getStrideInBytes(&sheet_image);
+	(void)memset(pixels, 0, stride * sheet_image.height);
+	for (uint32_t y = 0; y < sheet_image.height; y++)
+	{
+		for (uint32_t x = 0; x < sheet_image.width; x++)
+		{
+			uint8_t alpha = T_UI_GLYPH_ATLAS_SHEET_expected(x, y);
+			if ((uint8_t)MICROUI_IMAGE_FORMAT_A8 == (uint8_t)format)
+			{
+				pixels[(y * stride) + x] = alpha;
+			}
+			else
+			{
+				pixels[(y * stride) + (x / 2U)] |= (uint8_t)((alpha & 0xfU) << ((x & 1U) * 4U));
+			}
+		}
+	}
+}
+
+static bool T_UI_GLYPH_ATLAS_SHEET_is(const UI_GLYPH_ATLAS_metrics_t* metrics, uint32_t width, uint32_t height, int32_t left, int32_t top)
+{
+	return (metrics->width == width) && (metrics->height == height) && (metrics->left == left) && (metrics->top == top)
+			&& (T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH == metrics->advance);
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_setUp(void)
+{
+
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_tearDown(void)
+{
+	LLUI_DISPLAY_freeImageBuffer(&sheet_image);
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_metrics(void)
+{
+	UI_GLYPH_ATLAS_SHEET_t sheet;
+	UI_GLYPH_ATLAS_metrics_t metrics;
+
+	T_UI_GLYPH_ATLAS_SHEET_draw(MICROUI_IMAGE_FORMAT_A8);
+	TEST_ASSERT(UI_GLYPH_ATLAS_SHEET_initialize(&sheet, &sheet_image, 'A', 2, 2));
+	TEST_ASSERT_EQUAL_INT(8, sheet.font.bpp);
+
+	TEST_ASSERT(sheet.font.get_metrics(sheet.font.data, 'A', &metrics));
+	TEST_ASSERT(T_UI_GLYPH_ATLAS_SHEET_is(&metrics, 3, 2, 2, 1));
+	TEST_ASSERT(sheet.font.get_metrics(sheet.font.data, 'B', &metrics));
+	TEST_ASSERT(T_UI_GLYPH_ATLAS_SHEET_is(&metrics, T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH, T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT, 0, 0));
+	TEST_ASSERT(sheet.font.get_metrics(sheet.font.data, 'C', &metrics));
+	TEST_ASSERT(T_UI_GLYPH_ATLAS_SHEET_is(&metrics, 0, 0, 0, 0));
+	TEST_ASSERT(sheet.font.get_metrics(sheet.font.data, 'D', &metrics));
+	TEST_ASSERT(T_UI_GLYPH_ATLAS_SHEET_is(&metrics, 1, 1, 6, 4));
+
+	// characters outside the sheet
+	TEST_ASSERT(!sheet.font.get_metrics(sheet.font.data, '@', &metrics));
+	TEST_ASSERT(!sheet.font.get_metrics(sheet.font.data, 'E', &metrics));
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_check_render(jbyte format)
+{
+	UI_GLYPH_ATLAS_SHEET_t sheet;
+	UI_GLYPH_ATLAS_metrics_t metrics;
+	uint8_t alpha[T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT][16];
+
+	T_UI_GLYPH_ATLAS_SHEET_draw(format);
+	TEST_ASSERT(UI_GLYPH_ATLAS_SHEET_initialize(&sheet, &sheet_image, 'A', 2, 2));
+
+	for (uint32_t c = 0; c < 4U; c++)
+	{
+		uint32_t cell_x = (c % 2U) * T_UI_GLYPH_ATLAS_SHEET_CELL_WIDTH;
+		uint32_t cell_y = (c / 2U) * T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT;
+		(void)memset(alpha, 0xaa, sizeof(alpha));
+		TEST_ASSERT(sheet.font.get_metrics(sheet.font.data, 'A' + c, &metrics));
+		sheet.font.render(sheet.font.data, 'A' + c, &alpha[0][0], sizeof(alpha[0]));
+		for (uint32_t y = 0; y < T_UI_GLYPH_ATLAS_SHEET_CELL_HEIGHT; y++)
+		{
+			for (uint32_t x = 0; x < sizeof(alpha[0]); x++)
+			{
+				// the pixels outside the glyph's box are not written
+				uint8_t expected = ((x < metrics.width) && (y < metrics.height)) ? T_UI_GLYPH_ATLAS_SHEET_expected(cell_x + metrics.left + x, cell_y + metrics.top + y) : 0xaaU;
+				TEST_ASSERT_EQUAL_INT(expected, alpha[y][x]);
+			}
+		}
+	}
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_renderA8(void)
+{
+	T_UI_GLYPH_ATLAS_SHEET_check_render(MICROUI_IMAGE_FORMAT_A8);
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_renderA4(void)
+{
+	T_UI_GLYPH_ATLAS_SHEET_check_render(MICROUI_IMAGE_FORMAT_A4);
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_invalid(void)
+{
+	UI_GLYPH_ATLAS_SHEET_t sheet;
+
+	T_UI_GLYPH_ATLAS_SHEET_draw(MICROUI_IMAGE_FORMAT_RGB565);
+	TEST_ASSERT(!UI_GLYPH_ATLAS_SHEET_initialize(&sheet, &sheet_image, 'A', 2, 2));
+	TEST_ASSERT_EQUAL_INT(-1, Java_com_microej_ui_GlyphAtlas_registerFont(&sheet_image, 'A', 2, 2));
+	LLUI_DISPLAY_freeImageBuffer(&sheet_image);
+
+	T_UI_GLYPH_ATLAS_SHEET_draw(MICROUI_IMAGE_FORMAT_A8);
+	TEST_ASSERT(!UI_GLYPH_ATLAS_SHEET_initialize(&sheet, &sheet_image, 'A', 0, 2));
+	TEST_ASSERT(!UI_GLYPH_ATLAS_SHEET_initialize(&sheet, &sheet_image, 'A', 2, sheet_image.height + 1));
+	TEST_ASSERT_EQUAL_INT(-1, Java_com_microej_ui_GlyphAtlas_registerFont(&sheet_image, -1, 2, 2));
+}
+
+static void T_UI_GLYPH_ATLAS_SHEET_register(void)
+{
+	jint fonts[UI_GLYPH_ATLAS_FONTS];
+
+	T_UI_GLYPH_ATLAS_SHEET_draw(MICROUI_IMAGE_FORMAT_A4);
+	for (uint32_t i = 0; i < UI_GLYPH_ATLAS_FONTS; i++)
+	{
+		fonts[i] = Java_com_microej_ui_GlyphAtlas_registerFont(&sheet_image, 'A', 2, 2);
+		TEST_ASSERT(fonts[i] >= 0);
+		TEST_ASSERT(X_UI_HOST_get_font(fonts[i])->bpp == 4U);
+	}
+
+	// all the atlases are used
+	TEST_ASSERT_EQUAL_INT(-1, Java_com_microej_ui_GlyphAtlas_registerFont(&sheet_image, 'A', 2, 2));
+
+	Java_com_microej_ui_GlyphAtlas_unregisterFont(fonts[0]);
+	TEST_ASSERT(NULL == X_UI_HOST_get_font(fonts[0]));
+	fonts[0] = Java_com_microej_ui_GlyphAtlas_registerFont(&sheet_image, 'A', 2, 2);
+	TEST_ASSERT(fonts[0] >= 0);
+
+	for (uint32_t i = 0; i < UI_GLYPH_ATLAS_FONTS; i++)
+	{
+		Java_com_microej_ui_GlyphAtlas_unregisterFont(fonts[i]);
+		TEST_ASSERT(NULL == X_UI_HOST_get_font(fonts[i]));
+	}
+}
+
+TestRef T_UI_GLYPH_ATLAS_SHEET_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Glyphs metrics", T_UI_GLYPH_ATLAS_SHEET_metrics),
+		new_TestFixture("A8 glyphs", T_UI_GLYPH_ATLAS_SHEET_renderA8),
+		new_TestFixture("A4 glyphs", T_UI_GLYPH_ATLAS_SHEET_renderA4),
+		new_TestFixture("Invalid sheets", T_UI_GLYPH_ATLAS_SHEET_invalid),
+		new_TestFixture("Registration", T_UI_GLYPH_ATLAS_SHEET_register),
+	};
+
+	EMB_UNIT_TESTCALLER(glyphAtlasSheetTest, "Glyph_atlas_sheet_tests", T_UI_GLYPH_ATLAS_SHEET_setUp, T_UI_GLYPH_ATLAS_SHEET_tearDown, fixtures);
+
+	return (TestRef)&glyphAtlasSheetTest;
+}
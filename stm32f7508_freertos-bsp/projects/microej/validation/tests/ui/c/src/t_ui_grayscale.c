@@ -0,0 +1,241 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_grayscale.h"
+
+/*
+ * The converter is built with the CPU only and with its benchmark, whatever the BSP
+ * configuration. The display format is the RGB565 format of the board (project global
+ * define).
+ */
+#ifndef DRAWING_DMA2D_BPP
+#define DRAWING_DMA2D_BPP 16
+#endif
+#include "grayscale_conf.h"
+#undef GRAYSCALE_DMA2D_ENABLED
+#ifndef GRAYSCALE_BENCHMARK
+#define GRAYSCALE_BENCHMARK
+#endif
+#include "../../../../../ui/src/grayscale.c"
+
+#define WIDTH 480
+#define HEIGHT 272
+
+static uint16_t src_565[WIDTH * HEIGHT];
+static uint16_t dest_565[WIDTH * HEIGHT];
+static uint16_t odd_565[WIDTH * HEIGHT];
+static uint32_t src_8888[WIDTH * HEIGHT];
+static uint32_t dest_8888[WIDTH * HEIGHT];
+
+static void T_UI_GRAYSCALE_image(grayscale_image_t* image, void* buffer, uint32_t pixel_size, uint8_t format)
+{
+	image->buffer = (uint8_t*)buffer;
+	image->lut = NULL;
+	image->stride = WIDTH * pixel_size;
+	image->width = WIDTH;
+	image->height = HEIGHT;
+	image->format = format;
+}
+
+/*
+ * The conversion of a RGB565 image pixel per pixel (algorithm 3, 14 bits weights).
+ */
+static void T_UI_GRAYSCALE_per_pixel(void)
+{
+	for (uint32_t i = 0; i < (WIDTH * HEIGHT); i++)
+	{
+		uint32_t p = src_565[i];
+		uint32_t r = (p >> 8) & 0xf8U;
+		uint32_t g = (p >> 3) & 0xfcU;
+		uint32_t b = (p << 3) & 0xf8U;
+		uint32_t v = ((r * 3483U) + (g * 11718U) + (b * 1183U)) >> 14;
+		dest_565[i] = (uint16_t)(((v & 0xf8U) << 8) | ((v & 0xfcU) << 3) | (v >> 3));
+	}
+}
+
+static void T_UI_GRAYSCALE_setUp(void)
+{
+	srand(1);
+	for (uint32_t i = 0; i < (WIDTH * HEIGHT); i++)
+	{
+		src_565[i] = (uint16_t)rand();
+		src_8888[i] = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+	}
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_OK, grayscale_set_algorithm(GRAYSCALE_ALGO));
+}
+
+static void T_UI_GRAYSCALE_tearDown(void)
+{
+
+}
+
+static void T_UI_GRAYSCALE_benchmark(void)
+{
+	grayscale_image_t s565;
+	grayscale_image_t d565;
+	grayscale_image_t s8888;
+	grayscale_image_t d8888;
+	T_UI_GRAYSCALE_image(&s565, src_565, 2, MICROUI_IMAGE_FORMAT_RGB565);
+	T_UI_GRAYSCALE_image(&d565, dest_565, 2, MICROUI_IMAGE_FORMAT_RGB565);
+	T_UI_GRAYSCALE_image(&s8888, src_8888, 4, MICROUI_IMAGE_FORMAT_ARGB8888);
+	T_UI_GRAYSCALE_image(&d8888, dest_8888, 4, MICROUI_IMAGE_FORMAT_ARGB8888);
+
+	grayscale_benchmark(&s565, &d565);
+	grayscale_benchmark(&s8888, &d8888);
+	grayscale_benchmark(&s8888, &d565);
+
+	uint32_t t0 = framerate_impl_get_cycles();
+	for (uint32_t i = 0; i < (uint32_t)GRAYSCALE_BENCHMARK_LOOPS; i++)
+	{
+		T_UI_GRAYSCALE_per_pixel();
+	}
+	uint32_t t1 = framerate_impl_get_cycles();
+	printf("per-pixel conversion (RGB565): %u us\n", (unsigned int)(framerate_impl_cycles_to_us(t1 - t0) / (uint32_t)GRAYSCALE_BENCHMARK_LOOPS));
+
+	// the benchmark keeps the selected algorithm
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_ALGO, current_algorithm);
+}
+
+static void T_UI_GRAYSCALE_accuracy(void)
+{
+	static const double weights_reference[3][3] = {
+		{ 1.0 / 3.0, 1.0 / 3.0, 1.0 / 3.0 },
+		{ 0.299, 0.587, 0.114 },
+		{ 0.2126, 0.7152, 0.0722 },
+	};
+	grayscale_image_t s8888;
+	grayscale_image_t d8888;
+	T_UI_GRAYSCALE_image(&s8888, src_8888, 4, MICROUI_IMAGE_FORMAT_ARGB8888);
+	T_UI_GRAYSCALE_image(&d8888, dest_8888, 4, MICROUI_IMAGE_FORMAT_ARGB8888);
+
+	for (int32_t algorithm = GRAYSCALE_ALGO_1; algorithm <= GRAYSCALE_ALGO_3; algorithm++)
+	{
+		const double* w = weights_reference[algorithm - GRAYSCALE_ALGO_1];
+		TEST_ASSERT_EQUAL_INT(GRAYSCALE_OK, grayscale_set_algorithm(algorithm));
+		TEST_ASSERT_EQUAL_INT(GRAYSCALE_OK, grayscale_convert(&s8888, &d8888, WIDTH, HEIGHT));
+
+		for (uint32_t i = 0; i < (WIDTH * HEIGHT); i++)
+		{
+			uint32_t p = src_8888[i];
+			uint32_t gray = dest_8888[i] & 0xffU;
+			double reference = (w[0] * (double)((p >> 16) & 0xffU)) + (w[1] * (double)((p >> 8) & 0xffU)) + (w[2] * (double)(p & 0xffU));
+			int32_t error = (int32_t)gray - (int32_t)(reference + 0.5);
+
+			// the alpha is kept, the three channels are the gray level (rounded)
+			TEST_ASSERT_EQUAL_INT((int)(p >> 24), (int)(dest_8888[i] >> 24));
+			TEST_ASSERT_EQUAL_INT((int)(gray * 0x010101U), (int)(dest_8888[i] & 0xffffffU));
+			TEST_ASSERT((error >= -1) && (error <= 1));
+		}
+	}
+}
+
+static void T_UI_GRAYSCALE_oddWidth(void)
+{
+	grayscale_image_t s565;
+	grayscale_image_t d565;
+	grayscale_image_t o565;
+	T_UI_GRAYSCALE_image(&s565, src_565, 2, MICROUI_IMAGE_FORMAT_RGB565);
+	T_UI_GRAYSCALE_image(&d565, dest_565, 2, MICROUI_IMAGE_FORMAT_RGB565);
+	T_UI_GRAYSCALE_image(&o565, odd_565, 2, MICROUI_IMAGE_FORMAT_RGB565);
+
+	// the RGB565 pixels are converted two by two: the last pixel of a line is alone
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_OK, grayscale_convert(&s565, &d565, WIDTH, HEIGHT));
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_OK, grayscale_convert(&s565, &o565, WIDTH - 1, HEIGHT));
+
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < (WIDTH - 1); x++)
+		{
+			TEST_ASSERT_EQUAL_INT(dest_565[(y * WIDTH) + x], odd_565[(y * WIDTH) + x]);
+		}
+	}
+}
+
+static void T_UI_GRAYSCALE_levels(void)
+{
+	uint8_t a4[4] = { 0x10, 0xf0, 0x00, 0xff };
+	uint8_t a8[8];
+	grayscale_image_t s4 = { a4, NULL, 4, 8, 1, MICROUI_IMAGE_FORMAT_A4 };
+	grayscale_image_t d8 = { a8, NULL, 8, 8, 1, MICROUI_IMAGE_FORMAT_A8 };
+
+	// an alpha mask becomes a white on black image (A4: first pixel in the low nibble)
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_OK, grayscale_convert(&s4, &d8, 8, 1));
+	TEST_ASSERT_EQUAL_INT(0x00, a8[0]);
+	TEST_ASSERT_EQUAL_INT(0x11, a8[1]);
+	TEST_ASSERT_EQUAL_INT(0x00, a8[2]);
+	TEST_ASSERT_EQUAL_INT(0xff, a8[3]);
+	TEST_ASSERT_EQUAL_INT(0x00, a8[4]);
+	TEST_ASSERT_EQUAL_INT(0x00, a8[5]);
+	TEST_ASSERT_EQUAL_INT(0xff, a8[6]);
+	TEST_ASSERT_EQUAL_INT(0xff, a8[7]);
+}
+
+static void T_UI_GRAYSCALE_cachedImage(void)
+{
+	uint8_t encoded[4] = { 0x47, 0x52, 0x41, 0x59 };
+	MICROUI_Image image;
+	bool is_fully_opaque;
+	uint32_t hits = MICROUI_HEAP_cache_hits();
+
+	// decoded image kept by the images heap cache once closed
+	(void)memset(&image, 0, sizeof(image));
+	TEST_ASSERT(!MICROUI_HEAP_cache_get(encoded, sizeof(encoded), MICROUI_IMAGE_FORMAT_RGB565, &image, &is_fully_opaque));
+	MICROUI_HEAP_cache_start(encoded, sizeof(encoded), MICROUI_IMAGE_FORMAT_RGB565);
+	image.width = 16;
+	image.height = 8;
+	image.format = MICROUI_IMAGE_FORMAT_RGB565;
+	TEST_ASSERT(LLUI_DISPLAY_allocateImageBuffer(&image, 0));
+	uint16_t* pixels = (uint16_t*)LLUI_DISPLAY_getBufferAddress(&image);
+	for (uint32_t i = 0; i < (16U * 8U); i++)
+	{
+		pixels[i] = src_565[i];
+	}
+	MICROUI_HEAP_cache_stop(&image, true, true);
+
+	// converted in place, then closed: the cache does not give back the gray pixels
+	Java_com_is2t_microui_util_Grayscale_convertToGrayScale(&image, &image, 16, 8);
+	TEST_ASSERT(pixels[0] != src_565[0]);
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_cache_size());
+	TEST_ASSERT(!MICROUI_HEAP_cache_get(encoded, sizeof(encoded), MICROUI_IMAGE_FORMAT_RGB565, &image, &is_fully_opaque));
+	TEST_ASSERT_EQUAL_INT(hits, MICROUI_HEAP_cache_hits());
+}
+
+static void T_UI_GRAYSCALE_errors(void)
+{
+	uint8_t a4[4] = { 0 };
+	uint8_t a8[8];
+	grayscale_image_t s4 = { a4, NULL, 4, 8, 1, MICROUI_IMAGE_FORMAT_A4 };
+	grayscale_image_t d8 = { a8, NULL, 8, 8, 1, MICROUI_IMAGE_FORMAT_A8 };
+	grayscale_image_t unknown = { a8, NULL, 8, 8, 1, 0xf8 };
+
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_ERROR_FORMAT, grayscale_convert(&d8, &unknown, 1, 1));
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_ERROR_SIZE, grayscale_convert(&s4, &d8, 9, 1));
+
+	// an unknown algorithm keeps the selected one
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_ERROR_ALGORITHM, grayscale_set_algorithm(GRAYSCALE_ALGO_3 + 1));
+	TEST_ASSERT_EQUAL_INT(GRAYSCALE_ALGO, current_algorithm);
+}
+
+TestRef T_UI_GRAYSCALE_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Benchmark", T_UI_GRAYSCALE_benchmark),
+		new_TestFixture("Accuracy", T_UI_GRAYSCALE_accuracy),
+		new_TestFixture("Odd width", T_UI_GRAYSCALE_oddWidth),
+		new_TestFixture("Levels", T_UI_GRAYSCALE_levels),
+		new_TestFixture("Cached image converted in place", T_UI_GRAYSCALE_cachedImage),
+		new_TestFixture("Errors", T_UI_GRAYSCALE_errors),
+	};
+
+	EMB_UNIT_TESTCALLER(grayscaleTest, "Grayscale_tests", T_UI_GRAYSCALE_setUp, T_UI_GRAYSCALE_tearDown, fixtures);
+
+	return (TestRef)&grayscaleTest;
+}
@@ -0,0 +1,482 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "LLUI_DISPLAY.h"
+#include "LLUI_DISPLAY_impl.h"
+#include "microui_heap.h"
+#include "framerate_impl.h"
+#include "x_ui_host.h"
+#include "t_ui_image_heap.h"
+
+#define T_UI_IMAGE_HEAP_HEIGHT 100U
+#define T_UI_IMAGE_HEAP_FILL_BLOCKS 32U
+#define T_UI_IMAGE_HEAP_COMPACTION_IMAGES 48U
+#define T_UI_IMAGE_HEAP_COMPACTION_BUFFER (50U * 1024U)
+#define T_UI_IMAGE_HEAP_STRESS_STEPS 5000U
+#define T_UI_IMAGE_HEAP_STRESS_IMAGES 24U
+#define T_UI_IMAGE_HEAP_STRESS_BUFFERS 16U
+#define T_UI_IMAGE_HEAP_RESOURCES_SIZE (512U * 1024U)
+#define T_UI_IMAGE_HEAP_LOOKUP_LOOPS 100U
+
+static uint32_t free_space;
+static uint32_t seed;
+
+static uint32_t T_UI_IMAGE_HEAP_random(uint32_t max)
+{
+	seed = (seed * 1103515245U) + 12345U;
+	return (seed >> 16) % max;
+}
+
+/*
+ * Decodes the encoded image like LLUI_DISPLAY_IMPL_decodeImage(): the pixels depend on
+ * the key.
+ */
+static bool T_UI_IMAGE_HEAP_decode_encoded(uint8_t* encoded, uint32_t length, uint8_t key, uint8_t format, MICROUI_Image* image, uint32_t width)
+{
+	bool is_fully_opaque;
+	bool ret = MICROUI_HEAP_cache_get(encoded, length, format, image, &is_fully_opaque);
+
+	if (!ret)
+	{
+		MICROUI_HEAP_cache_start(encoded, length, format);
+		image->width = (jchar)width;
+		image->height = (jchar)T_UI_IMAGE_HEAP_HEIGHT;
+		image->format = (jbyte)MICROUI_IMAGE_FORMAT_RGB565;
+		ret = LLUI_DISPLAY_allocateImageBuffer(image, 0);
+		if (ret)
+		{
+			uint8_t* pixels = LLUI_DISPLAY_getBufferAddress(image);
+			for (uint32_t i = 0; i < (LLUI_DISPLAY_getStrideInBytes(image) * T_UI_IMAGE_HEAP_HEIGHT); i++)
+			{
+				pixels[i] = (uint8_t)(key + i);
+			}
+		}
+		MICROUI_HEAP_cache_stop(image, true, ret);
+	}
+	return ret;
+}
+
+/*
+ * Decodes the "encoded image" key (4 bytes).
+ */
+static bool T_UI_IMAGE_HEAP_decode(uint8_t key, uint8_t format, MICROUI_Image* image, uint32_t width)
+{
+	uint8_t encoded[4] = { key, 1, 2, 3 };
+	return T_UI_IMAGE_HEAP_decode_encoded(encoded, sizeof(encoded), key, format, image, width);
+}
+
+static bool T_UI_IMAGE_HEAP_check(uint8_t key, MICROUI_Image* image)
+{
+	uint8_t* pixels = LLUI_DISPLAY_getBufferAddress(image);
+	bool ret = true;
+	for (uint32_t i = 0; i < (LLUI_DISPLAY_getStrideInBytes(image) * T_UI_IMAGE_HEAP_HEIGHT); i++)
+	{
+		ret &= pixels[i] == (uint8_t)(key + i);
+	}
+	return ret;
+}
+
+static void T_UI_IMAGE_HEAP_setUp(void)
+{
+	X_UI_HOST_set_image_header(0);
+	X_UI_HOST_flush_heap();
+	free_space = MICROUI_HEAP_free_space();
+}
+
+static void T_UI_IMAGE_HEAP_tearDown(void)
+{
+	X_UI_HOST_set_image_header(0);
+	X_UI_HOST_flush_heap();
+}
+
+/*
+ * Checks the test has freed all its blocks (the assertions are not available in tearDown).
+ */
+static bool T_UI_IMAGE_HEAP_isReleased(void)
+{
+	X_UI_HOST_flush_heap();
+	return (0U == MICROUI_HEAP_cache_size()) && (free_space == MICROUI_HEAP_free_space());
+}
+
+static void T_UI_IMAGE_HEAP_hit(void)
+{
+	MICROUI_Image image;
+	uint32_t hits = MICROUI_HEAP_cache_hits();
+	uint32_t misses = MICROUI_HEAP_cache_misses();
+
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(1, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 100));
+	uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(&image);
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT(MICROUI_HEAP_cache_size() > 0U);
+
+	// the closed image is given back with its pixels
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(1, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 0));
+	TEST_ASSERT(buffer == LLUI_DISPLAY_getBufferAddress(&image));
+	TEST_ASSERT_EQUAL_INT(100, image.width);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_check(1, &image));
+	TEST_ASSERT_EQUAL_INT(hits + 1U, MICROUI_HEAP_cache_hits());
+	TEST_ASSERT_EQUAL_INT(misses + 1U, MICROUI_HEAP_cache_misses());
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_cache_size());
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_opened(void)
+{
+	MICROUI_Image first;
+	MICROUI_Image second;
+	uint32_t hits = MICROUI_HEAP_cache_hits();
+
+	// an image still opened is decoded again
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(2, MICROUI_IMAGE_FORMAT_ARGB8888, &first, 100));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(2, MICROUI_IMAGE_FORMAT_ARGB8888, &second, 100));
+	TEST_ASSERT(LLUI_DISPLAY_getBufferAddress(&first) != LLUI_DISPLAY_getBufferAddress(&second));
+	TEST_ASSERT_EQUAL_INT(hits, MICROUI_HEAP_cache_hits());
+	LLUI_DISPLAY_freeImageBuffer(&second);
+	LLUI_DISPLAY_freeImageBuffer(&first);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_key(void)
+{
+	MICROUI_Image image;
+	uint32_t hits = MICROUI_HEAP_cache_hits();
+
+	// the expected format is part of the key
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(3, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 100));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(3, MICROUI_IMAGE_FORMAT_RGB565, &image, 100));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(4, MICROUI_IMAGE_FORMAT_RGB565, &image, 100));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT_EQUAL_INT(hits, MICROUI_HEAP_cache_hits());
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_resources(void)
+{
+	MICROUI_Image image;
+	uint8_t* resources = X_UI_HOST_map_resources(T_UI_IMAGE_HEAP_RESOURCES_SIZE);
+	TEST_ASSERT(NULL != resources);
+
+	uint8_t* first = resources;
+	uint8_t* second = resources + (T_UI_IMAGE_HEAP_RESOURCES_SIZE / 2U);
+	const uint32_t length = T_UI_IMAGE_HEAP_RESOURCES_SIZE / 2U;
+	for (uint32_t i = 0; i < length; i++)
+	{
+		first[i] = (uint8_t)(i * 7U);
+		second[i] = (uint8_t)(i * 7U);
+	}
+	uint8_t* ram = LLUI_DISPLAY_IMPL_image_heap_allocate(length);
+	TEST_ASSERT(NULL != ram);
+	(void)memcpy(ram, first, length);
+
+	uint32_t hits = MICROUI_HEAP_cache_hits();
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode_encoded(first, length, 6, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 100));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+
+	// a resource is found by its address: its content is not read again
+	uint32_t t0 = framerate_impl_get_cycles();
+	for (uint32_t l = 0; l < T_UI_IMAGE_HEAP_LOOKUP_LOOPS; l++)
+	{
+		TEST_ASSERT(T_UI_IMAGE_HEAP_decode_encoded(first, length, 6, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 0));
+		LLUI_DISPLAY_freeImageBuffer(&image);
+	}
+	uint32_t t1 = framerate_impl_get_cycles();
+
+	// the same encoded image at another address (a copy in RAM) is found by its hash
+	for (uint32_t l = 0; l < T_UI_IMAGE_HEAP_LOOKUP_LOOPS; l++)
+	{
+		TEST_ASSERT(T_UI_IMAGE_HEAP_decode_encoded(ram, length, 6, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 0));
+		LLUI_DISPLAY_freeImageBuffer(&image);
+	}
+	uint32_t t2 = framerate_impl_get_cycles();
+	printf("%u cache hits of a %u KB encoded image: resource %u us, copy in RAM %u us\n", (unsigned int)T_UI_IMAGE_HEAP_LOOKUP_LOOPS,
+			(unsigned int)(length / 1024U), (unsigned int)framerate_impl_cycles_to_us(t1 - t0), (unsigned int)framerate_impl_cycles_to_us(t2 - t1));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode_encoded(second, length, 6, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 0));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_check(6, &image));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT_EQUAL_INT(hits + (2U * T_UI_IMAGE_HEAP_LOOKUP_LOOPS) + 1U, MICROUI_HEAP_cache_hits());
+
+	// a RAM buffer reused for another encoded image is not found
+	ram[0]++;
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode_encoded(ram, length, 7, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 100));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_check(7, &image));
+	TEST_ASSERT_EQUAL_INT(hits + (2U * T_UI_IMAGE_HEAP_LOOKUP_LOOPS) + 1U, MICROUI_HEAP_cache_hits());
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	LLUI_DISPLAY_IMPL_image_heap_free(ram);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_modified(void)
+{
+	MICROUI_Image image;
+	uint32_t hits = MICROUI_HEAP_cache_hits();
+
+	// the pixels of an opened image are modified: the closed image is not cached
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(8, MICROUI_IMAGE_FORMAT_RGB565, &image, 100));
+	LLUI_DISPLAY_getBufferAddress(&image)[0]++;
+	MICROUI_HEAP_cache_modified(&image);
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_cache_size());
+
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(8, MICROUI_IMAGE_FORMAT_RGB565, &image, 100));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_check(8, &image));
+	TEST_ASSERT_EQUAL_INT(hits, MICROUI_HEAP_cache_hits());
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_trackedBlocks(void)
+{
+	static uint8_t* blocks[MICROUI_HEAP_TRACKED_BLOCKS + 1U];
+	uint32_t histogram[MICROUI_HEAP_HISTOGRAM_SIZE];
+	uint32_t allocated = MICROUI_HEAP_number_of_allocated_blocks();
+
+	// the blocks of the best fit allocator (larger than the small blocks)
+	for (uint32_t i = 0; i < (MICROUI_HEAP_TRACKED_BLOCKS + 1U - allocated); i++)
+	{
+		blocks[i] = LLUI_DISPLAY_IMPL_image_heap_allocate(2048U);
+		TEST_ASSERT(NULL != blocks[i]);
+	}
+
+	// one block more than MICROUI_HEAP_TRACKED_BLOCKS: the metrics are not available
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_largest_free_block());
+	TEST_ASSERT(!MICROUI_HEAP_free_blocks_histogram(histogram));
+
+	LLUI_DISPLAY_IMPL_image_heap_free(blocks[MICROUI_HEAP_TRACKED_BLOCKS - allocated]);
+	TEST_ASSERT(MICROUI_HEAP_largest_free_block() > 0U);
+	TEST_ASSERT(MICROUI_HEAP_free_blocks_histogram(histogram));
+
+	for (uint32_t i = 0; i < (MICROUI_HEAP_TRACKED_BLOCKS - allocated); i++)
+	{
+		LLUI_DISPLAY_IMPL_image_heap_free(blocks[i]);
+	}
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_budget(void)
+{
+	MICROUI_Image image;
+	uint32_t evictions = MICROUI_HEAP_cache_evictions();
+
+	// 20KB per image
+	for (uint8_t key = 0; key < 10U; key++)
+	{
+		TEST_ASSERT(T_UI_IMAGE_HEAP_decode(key, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 100));
+		LLUI_DISPLAY_freeImageBuffer(&image);
+		TEST_ASSERT(MICROUI_HEAP_cache_size() <= MICROUI_HEAP_CACHE_BUDGET);
+	}
+	TEST_ASSERT(MICROUI_HEAP_cache_evictions() > evictions);
+
+	// the last closed image is still cached
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(9, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 0));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_check(9, &image));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_pressure(void)
+{
+	MICROUI_Image image;
+
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(5, MICROUI_IMAGE_FORMAT_ARGB8888, &image, 100));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+	uint32_t evictions = MICROUI_HEAP_cache_evictions();
+
+	// the closed image is freed to make room
+	uint8_t* block = LLUI_DISPLAY_IMPL_image_heap_allocate(MICROUI_HEAP_largest_free_block() + 1U);
+	TEST_ASSERT(NULL != block);
+	TEST_ASSERT_EQUAL_INT(evictions + 1U, MICROUI_HEAP_cache_evictions());
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_cache_size());
+	LLUI_DISPLAY_IMPL_image_heap_free(block);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_evictReused(void)
+{
+	MICROUI_Image small;
+	MICROUI_Image large;
+	uint8_t* fill[T_UI_IMAGE_HEAP_FILL_BLOCKS];
+	uint32_t fill_number = 0;
+	uint32_t largest;
+
+	// two closed images, the smallest is the least recently used
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(6, MICROUI_IMAGE_FORMAT_ARGB8888, &small, 100));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(7, MICROUI_IMAGE_FORMAT_ARGB8888, &large, 200));
+	LLUI_DISPLAY_freeImageBuffer(&small);
+	LLUI_DISPLAY_freeImageBuffer(&large);
+	uint32_t evictions = MICROUI_HEAP_cache_evictions();
+
+	// no room left for an image
+	while ((fill_number < T_UI_IMAGE_HEAP_FILL_BLOCKS) && ((largest = MICROUI_HEAP_largest_free_block()) >= 2048U))
+	{
+		fill[fill_number] = LLUI_DISPLAY_IMPL_image_heap_allocate(largest);
+		TEST_ASSERT(NULL != fill[fill_number]);
+		fill_number++;
+	}
+	TEST_ASSERT_EQUAL_INT(evictions, MICROUI_HEAP_cache_evictions());
+
+	// the Graphics Engine asks for a larger buffer than the cached one: the cached image
+	// is evicted (least recently used) before the large one makes room
+	X_UI_HOST_set_image_header(64);
+	TEST_ASSERT(T_UI_IMAGE_HEAP_decode(6, MICROUI_IMAGE_FORMAT_ARGB8888, &small, 100));
+	TEST_ASSERT(T_UI_IMAGE_HEAP_check(6, &small));
+	TEST_ASSERT_EQUAL_INT(evictions + 2U, MICROUI_HEAP_cache_evictions());
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_cache_size());
+	LLUI_DISPLAY_freeImageBuffer(&small);
+
+	for (uint32_t i = 0; i < fill_number; i++)
+	{
+		LLUI_DISPLAY_IMPL_image_heap_free(fill[i]);
+	}
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_compaction(void)
+{
+	static MICROUI_Image images[T_UI_IMAGE_HEAP_COMPACTION_IMAGES];
+	uint8_t* buffers[T_UI_IMAGE_HEAP_COMPACTION_IMAGES];
+	uint32_t number = 0;
+
+	// fill the heap with images (25KB) separated by buffers (50KB, like BufferedImage)
+	while ((number < T_UI_IMAGE_HEAP_COMPACTION_IMAGES) && T_UI_IMAGE_HEAP_decode((uint8_t)number, MICROUI_IMAGE_FORMAT_ARGB8888, &images[number], 128))
+	{
+		buffers[number] = LLUI_DISPLAY_IMPL_image_heap_allocate(T_UI_IMAGE_HEAP_COMPACTION_BUFFER);
+		number++;
+		if (NULL == buffers[number - 1U])
+		{
+			break;
+		}
+	}
+	TEST_ASSERT(number < T_UI_IMAGE_HEAP_COMPACTION_IMAGES);
+
+	// the closed images kept by the cache split the free space; a free moves a bounded
+	// number of images
+	for (uint32_t i = 0; i < number; i++)
+	{
+		LLUI_DISPLAY_freeImageBuffer(&images[i]);
+		if (NULL != buffers[i])
+		{
+			uint32_t before = MICROUI_HEAP_compaction_moves();
+			LLUI_DISPLAY_IMPL_image_heap_free(buffers[i]);
+			TEST_ASSERT((MICROUI_HEAP_compaction_moves() - before) <= MICROUI_HEAP_COMPACTION_MOVES_PER_FREE);
+		}
+	}
+	uint32_t moves = MICROUI_HEAP_compaction_moves();
+	uint32_t evictions = MICROUI_HEAP_cache_evictions();
+
+	// the images are moved instead of being evicted
+	uint8_t* block = LLUI_DISPLAY_IMPL_image_heap_allocate(MICROUI_HEAP_largest_free_block() + 1U);
+	TEST_ASSERT(NULL != block);
+	TEST_ASSERT(MICROUI_HEAP_compaction_moves() > moves);
+	TEST_ASSERT_EQUAL_INT(evictions, MICROUI_HEAP_cache_evictions());
+	LLUI_DISPLAY_IMPL_image_heap_free(block);
+
+	// the moved images are given back with their pixels; the images which are not cached
+	// are not decoded again (the decoding would evict the cached ones)
+	uint32_t cached = 0;
+	for (uint32_t i = 0; i < number; i++)
+	{
+		uint8_t encoded[4] = { (uint8_t)i, 1, 2, 3 };
+		bool is_fully_opaque;
+		if (MICROUI_HEAP_cache_get(encoded, sizeof(encoded), MICROUI_IMAGE_FORMAT_ARGB8888, &images[i], &is_fully_opaque))
+		{
+			TEST_ASSERT(T_UI_IMAGE_HEAP_check((uint8_t)i, &images[i]));
+			cached++;
+		}
+	}
+	TEST_ASSERT(cached > 0U);
+	TEST_ASSERT_EQUAL_INT(0, MICROUI_HEAP_cache_size());
+	for (uint32_t i = 0; i < number; i++)
+	{
+		LLUI_DISPLAY_freeImageBuffer(&images[i]);
+	}
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+static void T_UI_IMAGE_HEAP_compactionStress(void)
+{
+	static MICROUI_Image images[T_UI_IMAGE_HEAP_STRESS_IMAGES];
+	bool opened[T_UI_IMAGE_HEAP_STRESS_IMAGES] = { false };
+	uint8_t* buffers[T_UI_IMAGE_HEAP_STRESS_BUFFERS] = { NULL };
+	uint32_t moves = MICROUI_HEAP_compaction_moves();
+
+	// the application opens and closes images and allocates buffers; the images given
+	// back by the cache (moved or not) must keep their pixels
+	seed = 1U;
+	for (uint32_t step = 0; step < T_UI_IMAGE_HEAP_STRESS_STEPS; step++)
+	{
+		uint32_t i = T_UI_IMAGE_HEAP_random(T_UI_IMAGE_HEAP_STRESS_IMAGES);
+		uint32_t b = T_UI_IMAGE_HEAP_random(T_UI_IMAGE_HEAP_STRESS_BUFFERS);
+
+		if (opened[i])
+		{
+			LLUI_DISPLAY_freeImageBuffer(&images[i]);
+			opened[i] = false;
+		}
+		else
+		{
+			uint32_t hits = MICROUI_HEAP_cache_hits();
+			opened[i] = T_UI_IMAGE_HEAP_decode((uint8_t)i, MICROUI_IMAGE_FORMAT_ARGB8888, &images[i], 32U + (i * 8U));
+			TEST_ASSERT(opened[i]);
+			TEST_ASSERT((MICROUI_HEAP_cache_hits() == hits) || T_UI_IMAGE_HEAP_check((uint8_t)i, &images[i]));
+		}
+
+		if (NULL != buffers[b])
+		{
+			LLUI_DISPLAY_IMPL_image_heap_free(buffers[b]);
+			buffers[b] = NULL;
+		}
+		else
+		{
+			// may fail: the heap is full
+			buffers[b] = LLUI_DISPLAY_IMPL_image_heap_allocate(1024U + (T_UI_IMAGE_HEAP_random(64U) * 4096U));
+		}
+	}
+	TEST_ASSERT(MICROUI_HEAP_compaction_moves() > moves);
+
+	for (uint32_t i = 0; i < T_UI_IMAGE_HEAP_STRESS_IMAGES; i++)
+	{
+		if (opened[i])
+		{
+			TEST_ASSERT(T_UI_IMAGE_HEAP_check((uint8_t)i, &images[i]));
+			LLUI_DISPLAY_freeImageBuffer(&images[i]);
+		}
+	}
+	for (uint32_t b = 0; b < T_UI_IMAGE_HEAP_STRESS_BUFFERS; b++)
+	{
+		if (NULL != buffers[b])
+		{
+			LLUI_DISPLAY_IMPL_image_heap_free(buffers[b]);
+		}
+	}
+	TEST_ASSERT(T_UI_IMAGE_HEAP_isReleased());
+}
+
+TestRef T_UI_IMAGE_HEAP_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Cache hit", T_UI_IMAGE_HEAP_hit),
+		new_TestFixture("Opened image", T_UI_IMAGE_HEAP_opened),
+		new_TestFixture("Cache key", T_UI_IMAGE_HEAP_key),
+		new_TestFixture("Resources key", T_UI_IMAGE_HEAP_resources),
+		new_TestFixture("Modified image", T_UI_IMAGE_HEAP_modified),
+		new_TestFixture("Tracked blocks limit", T_UI_IMAGE_HEAP_trackedBlocks),
+		new_TestFixture("Cache budget", T_UI_IMAGE_HEAP_budget),
+		new_TestFixture("Heap pressure", T_UI_IMAGE_HEAP_pressure),
+		new_TestFixture("Eviction of the reused image", T_UI_IMAGE_HEAP_evictReused),
+		new_TestFixture("Compaction", T_UI_IMAGE_HEAP_compaction),
+		new_TestFixture("Compaction stress", T_UI_IMAGE_HEAP_compactionStress),
+	};
+
+	EMB_UNIT_TESTCALLER(imageHeapTest, "Image_heap_tests", T_UI_IMAGE_HEAP_setUp, T_UI_IMAGE_HEAP_tearDown, fixtures);
+
+	return (TestRef)&imageHeapTest;
+}
@@ -0,0 +1,200 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "LLUI_DISPLAY_impl.h"
+#include "microui_heap.h"
+#include "x_ui_bestfit_allocator.h"
+#include "x_ui_host.h"
+#include "t_ui_image_heap_benchmark.h"
+
+#define T_UI_IMAGE_HEAP_BENCHMARK_STEPS 20000U
+#define T_UI_IMAGE_HEAP_BENCHMARK_IMAGES 64U
+#define T_UI_IMAGE_HEAP_BENCHMARK_KEPT 48U
+#define T_UI_IMAGE_HEAP_BENCHMARK_SCRATCH 20U
+
+/*
+ * A heap under test.
+ */
+typedef struct {
+	void* (*allocate)(uint32_t size);
+	void (*free)(void* block);
+	uint32_t allocations;
+	uint32_t failures;
+} T_UI_IMAGE_HEAP_BENCHMARK_heap_t;
+
+static BESTFIT_ALLOCATOR bestfit;
+static uint32_t seed;
+
+/*
+ * Pseudo-random generator: the same trace is replayed on both heaps.
+ */
+static uint32_t T_UI_IMAGE_HEAP_BENCHMARK_random(uint32_t max)
+{
+	seed = (seed * 1103515245U) + 12345U;
+	return (seed >> 16) % max;
+}
+
+static void* T_UI_IMAGE_HEAP_BENCHMARK_image_heap_allocate(uint32_t size)
+{
+	return LLUI_DISPLAY_IMPL_image_heap_allocate(size);
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_image_heap_free(void* block)
+{
+	LLUI_DISPLAY_IMPL_image_heap_free(block);
+}
+
+static void* T_UI_IMAGE_HEAP_BENCHMARK_bestfit_allocate(uint32_t size)
+{
+	return BESTFIT_ALLOCATOR_allocate(&bestfit, (int32_t)size);
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_bestfit_free(void* block)
+{
+	BESTFIT_ALLOCATOR_free(&bestfit, block);
+}
+
+static void* T_UI_IMAGE_HEAP_BENCHMARK_allocate(T_UI_IMAGE_HEAP_BENCHMARK_heap_t* heap, uint32_t size)
+{
+	void* block = heap->allocate(size);
+	heap->allocations++;
+	heap->failures += (NULL == block) ? 1U : 0U;
+	return block;
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_free(T_UI_IMAGE_HEAP_BENCHMARK_heap_t* heap, void** block)
+{
+	if (NULL != *block)
+	{
+		heap->free(*block);
+		*block = NULL;
+	}
+}
+
+/*
+ * Replays the trace: each step frees an image or decodes one. A decoding allocates some
+ * scratch blocks (decoder context, tables), the image buffer, then frees the scratch
+ * blocks except a few ones which are kept (cached tables). Everything is freed at the end
+ * when "release" is set.
+ */
+static void T_UI_IMAGE_HEAP_BENCHMARK_replay(T_UI_IMAGE_HEAP_BENCHMARK_heap_t* heap, void* images[T_UI_IMAGE_HEAP_BENCHMARK_IMAGES], void* kept[T_UI_IMAGE_HEAP_BENCHMARK_KEPT])
+{
+	seed = 1U;
+	for (uint32_t step = 0; step < T_UI_IMAGE_HEAP_BENCHMARK_STEPS; step++)
+	{
+		uint32_t i = T_UI_IMAGE_HEAP_BENCHMARK_random(T_UI_IMAGE_HEAP_BENCHMARK_IMAGES);
+		if (NULL != images[i])
+		{
+			T_UI_IMAGE_HEAP_BENCHMARK_free(heap, &images[i]);
+		}
+		else
+		{
+			void* scratch[T_UI_IMAGE_HEAP_BENCHMARK_SCRATCH];
+			uint32_t n = T_UI_IMAGE_HEAP_BENCHMARK_random(T_UI_IMAGE_HEAP_BENCHMARK_SCRATCH);
+			for (uint32_t s = 0; s < n; s++)
+			{
+				scratch[s] = T_UI_IMAGE_HEAP_BENCHMARK_allocate(heap, 16U + T_UI_IMAGE_HEAP_BENCHMARK_random(1000U));
+			}
+
+			uint32_t width = 8U + T_UI_IMAGE_HEAP_BENCHMARK_random(120U);
+			uint32_t height = 8U + T_UI_IMAGE_HEAP_BENCHMARK_random(120U);
+			images[i] = T_UI_IMAGE_HEAP_BENCHMARK_allocate(heap, width * height * 2U);
+
+			for (uint32_t s = 0; s < n; s++)
+			{
+				if (0U == T_UI_IMAGE_HEAP_BENCHMARK_random(32U))
+				{
+					uint32_t k = T_UI_IMAGE_HEAP_BENCHMARK_random(T_UI_IMAGE_HEAP_BENCHMARK_KEPT);
+					T_UI_IMAGE_HEAP_BENCHMARK_free(heap, &kept[k]);
+					kept[k] = scratch[s];
+				}
+				else
+				{
+					T_UI_IMAGE_HEAP_BENCHMARK_free(heap, &scratch[s]);
+				}
+			}
+		}
+	}
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_release(T_UI_IMAGE_HEAP_BENCHMARK_heap_t* heap, void* images[T_UI_IMAGE_HEAP_BENCHMARK_IMAGES], void* kept[T_UI_IMAGE_HEAP_BENCHMARK_KEPT])
+{
+	for (uint32_t i = 0; i < T_UI_IMAGE_HEAP_BENCHMARK_IMAGES; i++)
+	{
+		T_UI_IMAGE_HEAP_BENCHMARK_free(heap, &images[i]);
+	}
+	for (uint32_t k = 0; k < T_UI_IMAGE_HEAP_BENCHMARK_KEPT; k++)
+	{
+		T_UI_IMAGE_HEAP_BENCHMARK_free(heap, &kept[k]);
+	}
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_setUp(void)
+{
+	X_UI_HOST_flush_heap();
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_tearDown(void)
+{
+
+}
+
+static void T_UI_IMAGE_HEAP_BENCHMARK_fragmentation(void)
+{
+	static uint8_t* bestfit_heap = NULL;
+	void* images[T_UI_IMAGE_HEAP_BENCHMARK_IMAGES] = { NULL };
+	void* kept[T_UI_IMAGE_HEAP_BENCHMARK_KEPT] = { NULL };
+	uint32_t histogram[MICROUI_HEAP_HISTOGRAM_SIZE];
+	uint32_t free_space = MICROUI_HEAP_free_space();
+
+	// images heap
+	T_UI_IMAGE_HEAP_BENCHMARK_heap_t image_heap = { T_UI_IMAGE_HEAP_BENCHMARK_image_heap_allocate, T_UI_IMAGE_HEAP_BENCHMARK_image_heap_free, 0, 0 };
+	T_UI_IMAGE_HEAP_BENCHMARK_replay(&image_heap, images, kept);
+	uint32_t image_heap_largest = MICROUI_HEAP_largest_free_block();
+	TEST_ASSERT(MICROUI_HEAP_free_blocks_histogram(histogram));
+	printf("\nimages heap: %u/%u failed allocations, largest free block %u bytes, free blocks histogram:", image_heap.failures, image_heap.allocations, image_heap_largest);
+	for (uint32_t i = 0; i < MICROUI_HEAP_HISTOGRAM_SIZE; i++)
+	{
+		printf(" %u", histogram[i]);
+	}
+	printf(" (%u slab pages)\n", MICROUI_HEAP_number_of_used_pages());
+	T_UI_IMAGE_HEAP_BENCHMARK_release(&image_heap, images, kept);
+	TEST_ASSERT_EQUAL_INT(free_space, MICROUI_HEAP_free_space());
+
+	// plain best fit heap of the same size
+	if (NULL == bestfit_heap)
+	{
+		bestfit_heap = X_UI_HOST_map(X_UI_HOST_HEAP_SIZE);
+	}
+	TEST_ASSERT(NULL != bestfit_heap);
+	BESTFIT_ALLOCATOR_new(&bestfit);
+	BESTFIT_ALLOCATOR_initialize(&bestfit, (int32_t)(uintptr_t)bestfit_heap, (int32_t)(uintptr_t)(bestfit_heap + X_UI_HOST_HEAP_SIZE));
+	T_UI_IMAGE_HEAP_BENCHMARK_heap_t plain_heap = { T_UI_IMAGE_HEAP_BENCHMARK_bestfit_allocate, T_UI_IMAGE_HEAP_BENCHMARK_bestfit_free, 0, 0 };
+	T_UI_IMAGE_HEAP_BENCHMARK_replay(&plain_heap, images, kept);
+	uint32_t bestfit_largest;
+	uint32_t bestfit_blocks = X_UI_BESTFIT_ALLOCATOR_free_blocks(&bestfit, &bestfit_largest);
+	printf("best fit heap: %u/%u failed allocations, largest free block %u bytes, %u free blocks\n", plain_heap.failures, plain_heap.allocations, bestfit_largest, bestfit_blocks);
+	T_UI_IMAGE_HEAP_BENCHMARK_release(&plain_heap, images, kept);
+	uint32_t largest;
+	TEST_ASSERT_EQUAL_INT(1, X_UI_BESTFIT_ALLOCATOR_free_blocks(&bestfit, &largest));
+
+	TEST_ASSERT_EQUAL_INT(0, image_heap.failures);
+	TEST_ASSERT_EQUAL_INT(image_heap.allocations, plain_heap.allocations);
+	TEST_ASSERT(image_heap_largest >= bestfit_largest);
+}
+
+TestRef T_UI_IMAGE_HEAP_BENCHMARK_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Fragmentation", T_UI_IMAGE_HEAP_BENCHMARK_fragmentation),
+	};
+
+	EMB_UNIT_TESTCALLER(imageHeapBenchmarkTest, "Image_heap_benchmark", T_UI_IMAGE_HEAP_BENCHMARK_setUp, T_UI_IMAGE_HEAP_BENCHMARK_tearDown, fixtures);
+
+	return (TestRef)&imageHeapBenchmarkTest;
+}
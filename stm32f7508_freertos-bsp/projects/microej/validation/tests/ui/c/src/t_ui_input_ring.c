@@ -0,0 +1,226 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_input_ring.h"
+
+/*
+ * The rings are built with the host data memory barrier (see stm32f7xx_hal.h).
+ */
+#include "../../../../../ui/src/input_ring.c"
+
+#define RINGS 2
+#define EVENTS 300000U
+
+static INPUT_RING_t rings[RINGS];
+static INPUT_RING_t* const rings_list[RINGS] = { &rings[0], &rings[1] };
+
+/*
+ * The time of the events: shared by the producers like the BSP time base.
+ */
+static atomic_uint clock_us;
+static atomic_int producers_done;
+
+/*
+ * Written by the producer of the ring only.
+ */
+static uint32_t pushed[RINGS];
+static uint32_t dropped[RINGS];
+
+/*
+ * The event number i of the ring r: the payload is checked by the consumer.
+ */
+static void T_UI_INPUT_RING_event(INPUT_RING_event_t* event, uint32_t r, uint32_t i)
+{
+	event->read_time = i;
+	event->type = (uint8_t)r;
+	event->id = (uint8_t)(i * 7U);
+	event->points[0].x = (uint16_t)i;
+	event->points[0].y = (uint16_t)(i >> 16);
+	event->points[1].x = (uint16_t)~i;
+	event->points[1].y = (uint16_t)(r * 1000U);
+}
+
+static bool T_UI_INPUT_RING_check(const INPUT_RING_event_t* event, uint32_t r)
+{
+	INPUT_RING_event_t expected;
+	T_UI_INPUT_RING_event(&expected, r, event->read_time);
+	return (event->type == expected.type) && (event->id == expected.id)
+			&& (event->points[0].x == expected.points[0].x) && (event->points[0].y == expected.points[0].y)
+			&& (event->points[1].x == expected.points[1].x) && (event->points[1].y == expected.points[1].y);
+}
+
+/*
+ * One producer per ring (an input interrupt on the target): the full ring drops the
+ * events; the producer yields to let the consumer run on a single core host.
+ */
+static void* T_UI_INPUT_RING_producer(void* arg)
+{
+	uint32_t r = (uint32_t)(uintptr_t)arg;
+	for (uint32_t i = 0; i < EVENTS; i++)
+	{
+		INPUT_RING_event_t event;
+		event.time = atomic_fetch_add(&clock_us, 1U);
+		T_UI_INPUT_RING_event(&event, r, i);
+		if (INPUT_RING_push(&rings[r], &event))
+		{
+			pushed[r]++;
+		}
+		else
+		{
+			dropped[r]++;
+			if ((i & 1U) != 0U)
+			{
+				(void)sched_yield();
+			}
+		}
+		if ((i & 1023U) == 0U)
+		{
+			(void)sched_yield();
+		}
+	}
+	(void)atomic_fetch_add(&producers_done, 1);
+	return NULL;
+}
+
+static void T_UI_INPUT_RING_setUp(void)
+{
+	for (uint32_t r = 0; r < RINGS; r++)
+	{
+		INPUT_RING_initialize(&rings[r]);
+		pushed[r] = 0;
+		dropped[r] = 0;
+	}
+	atomic_store(&clock_us, 0U);
+	atomic_store(&producers_done, 0);
+}
+
+static void T_UI_INPUT_RING_tearDown(void)
+{
+
+}
+
+static void T_UI_INPUT_RING_threads(void)
+{
+	pthread_t threads[RINGS];
+	uint32_t consumed[RINGS] = { 0 };
+	int64_t last[RINGS] = { -1, -1 };
+	uint32_t overflows = 0;
+	bool complete = true;
+	bool ordered = true;
+
+	for (uint32_t r = 0; r < RINGS; r++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[r], NULL, T_UI_INPUT_RING_producer, (void*)(uintptr_t)r));
+	}
+
+	// the consumer (the IO task on the target) runs until the producers have finished
+	// and the rings are empty
+	bool finished;
+	do
+	{
+		finished = atomic_load(&producers_done) == RINGS;
+		int32_t r;
+		while ((r = INPUT_RING_oldest(rings_list, RINGS)) >= 0)
+		{
+			INPUT_RING_event_t* event = INPUT_RING_peek(rings_list[r]);
+			// never read while written, first in first out per ring
+			complete &= T_UI_INPUT_RING_check(event, (uint32_t)r);
+			ordered &= (int64_t)event->read_time > last[r];
+			last[r] = (int64_t)event->read_time;
+			consumed[r]++;
+			INPUT_RING_pop(rings_list[r]);
+		}
+		for (uint32_t k = 0; k < RINGS; k++)
+		{
+			overflows += INPUT_RING_overflowed(&rings[k]) ? 1U : 0U;
+		}
+	} while (!finished);
+
+	for (uint32_t r = 0; r < RINGS; r++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[r], NULL));
+		printf("ring %u: %u events pushed, %u dropped\n", (unsigned int)r, (unsigned int)pushed[r], (unsigned int)dropped[r]);
+	}
+	printf("overflow notifications: %u\n", (unsigned int)overflows);
+
+	TEST_ASSERT(complete);
+	TEST_ASSERT(ordered);
+	for (uint32_t r = 0; r < RINGS; r++)
+	{
+		TEST_ASSERT_EQUAL_INT(pushed[r], consumed[r]);
+		TEST_ASSERT_EQUAL_INT(EVENTS, pushed[r] + dropped[r]);
+		TEST_ASSERT_EQUAL_INT(dropped[r], rings[r].dropped);
+	}
+	// a drop is notified once at least
+	TEST_ASSERT((0U == (dropped[0] + dropped[1])) == (0U == overflows));
+}
+
+static void T_UI_INPUT_RING_timeWrap(void)
+{
+	INPUT_RING_event_t event;
+	(void)memset(&event, 0, sizeof(event));
+
+	// the events are spread over the two rings, the time wraps around
+	for (uint32_t k = 0; k < 10U; k++)
+	{
+		event.time = 0xfffffff0U + (3U * k);
+		event.read_time = 3U * k;
+		TEST_ASSERT(INPUT_RING_push(&rings[k & 1U], &event));
+	}
+
+	uint32_t count = 0;
+	int32_t r;
+	while ((r = INPUT_RING_oldest(rings_list, RINGS)) >= 0)
+	{
+		TEST_ASSERT_EQUAL_INT(3U * count, INPUT_RING_peek(rings_list[r])->read_time);
+		INPUT_RING_pop(rings_list[r]);
+		count++;
+	}
+	TEST_ASSERT_EQUAL_INT(10, count);
+	TEST_ASSERT(NULL == INPUT_RING_peek(&rings[0]));
+	TEST_ASSERT(NULL == INPUT_RING_peek(&rings[1]));
+}
+
+static void T_UI_INPUT_RING_full(void)
+{
+	INPUT_RING_event_t event;
+	(void)memset(&event, 0, sizeof(event));
+
+	for (uint32_t k = 0; k < INPUT_RING_SIZE; k++)
+	{
+		TEST_ASSERT(INPUT_RING_push(&rings[0], &event));
+	}
+	TEST_ASSERT(!INPUT_RING_overflowed(&rings[0]));
+
+	// the event is dropped and notified once
+	TEST_ASSERT(!INPUT_RING_push(&rings[0], &event));
+	TEST_ASSERT(INPUT_RING_overflowed(&rings[0]));
+	TEST_ASSERT(!INPUT_RING_overflowed(&rings[0]));
+
+	// a popped event releases its slot
+	INPUT_RING_pop(&rings[0]);
+	TEST_ASSERT(INPUT_RING_push(&rings[0], &event));
+	TEST_ASSERT_EQUAL_INT(1, rings[0].dropped);
+}
+
+TestRef T_UI_INPUT_RING_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Producer threads", T_UI_INPUT_RING_threads),
+		new_TestFixture("Time wrap around", T_UI_INPUT_RING_timeWrap),
+		new_TestFixture("Full ring", T_UI_INPUT_RING_full),
+	};
+
+	EMB_UNIT_TESTCALLER(inputRingTest, "Input_ring_tests", T_UI_INPUT_RING_setUp, T_UI_INPUT_RING_tearDown, fixtures);
+
+	return (TestRef)&inputRingTest;
+}
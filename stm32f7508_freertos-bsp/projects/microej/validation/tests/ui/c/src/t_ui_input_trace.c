@@ -0,0 +1,213 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_input_trace.h"
+
+/*
+ * The traces are built with the BSP configuration (input_trace_conf.h); the time of the
+ * touch helper is given by the tests.
+ */
+#include "../../../../../ui/src/input_trace.c"
+
+#define T_UI_INPUT_TRACE_QUEUE_SIZE 64U
+
+static uint32_t trace_time;
+
+uint32_t TOUCH_HELPER_get_time(void)
+{
+	return trace_time;
+}
+
+void LLUI_INPUT_IMPL_enterCriticalSection(void)
+{
+}
+
+void LLUI_INPUT_IMPL_leaveCriticalSection(void)
+{
+}
+
+/*
+ * A touch event sampled at the given time, read read_us later, added to the MicroUI
+ * queue helper_us later and read by the MicroUI pump queue_us later.
+ */
+static void T_UI_INPUT_TRACE_event(uint32_t index, uint32_t sample_time, uint32_t read_us, uint32_t helper_us, uint32_t queue_us)
+{
+	trace_time = sample_time + read_us + helper_us;
+	INPUT_TRACE_event_added(index, sample_time, sample_time + read_us);
+	trace_time += queue_us;
+	INPUT_TRACE_event_read(index);
+}
+
+static void T_UI_INPUT_TRACE_setUp(void)
+{
+	INPUT_TRACE_queue_statistics_t queue;
+	trace_time = 0;
+	INPUT_TRACE_queue_init(T_UI_INPUT_TRACE_QUEUE_SIZE);
+	INPUT_TRACE_reset();
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_TRUE);
+}
+
+static void T_UI_INPUT_TRACE_tearDown(void)
+{
+
+}
+
+static void T_UI_INPUT_TRACE_stages(void)
+{
+	uint16_t buckets[INPUT_TRACE_HISTOGRAM_BUCKETS];
+
+	for (uint32_t i = 0; i < 10U; i++)
+	{
+		T_UI_INPUT_TRACE_event(i, 10000U * i, 2000, 1000, 500);
+	}
+
+	// upper bounds of the buckets
+	TEST_ASSERT_EQUAL_INT(2250, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_READ, 50));
+	TEST_ASSERT_EQUAL_INT(1250, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_HELPER, 50));
+	TEST_ASSERT_EQUAL_INT(750, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_QUEUE, 50));
+	TEST_ASSERT_EQUAL_INT(3750, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 99));
+
+	TEST_ASSERT_EQUAL_INT(10, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+	TEST_ASSERT_EQUAL_INT(10, buckets[3500U / INPUT_TRACE_HISTOGRAM_BUCKET_US]);
+
+	// an event read twice is traced once
+	INPUT_TRACE_event_read(9);
+	TEST_ASSERT_EQUAL_INT(10, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+
+	INPUT_TRACE_reset();
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 50));
+}
+
+static void T_UI_INPUT_TRACE_in_flight(void)
+{
+	INPUT_TRACE_queue_statistics_t queue;
+	uint16_t buckets[INPUT_TRACE_HISTOGRAM_BUCKETS];
+
+	// one more event than the traces: it is not traced
+	for (uint32_t i = 0; i <= (uint32_t)INPUT_TRACE_EVENTS_IN_FLIGHT; i++)
+	{
+		INPUT_TRACE_event_added(i, 0, 0);
+	}
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_FALSE);
+	TEST_ASSERT_EQUAL_INT(1, queue.untraced);
+	INPUT_TRACE_event_read(INPUT_TRACE_EVENTS_IN_FLIGHT);
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+
+	// the events which are not traced are ignored
+	INPUT_TRACE_event_read(T_UI_INPUT_TRACE_QUEUE_SIZE - 1U);
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+
+	// a queue index reused by a new event replaces the obsolete trace
+	trace_time = 20000;
+	INPUT_TRACE_event_added(0, 19000, 19500);
+	trace_time = 21000;
+	INPUT_TRACE_event_read(0);
+	TEST_ASSERT_EQUAL_INT(1, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+	TEST_ASSERT_EQUAL_INT(1, buckets[2000U / INPUT_TRACE_HISTOGRAM_BUCKET_US]);
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_FALSE);
+	TEST_ASSERT_EQUAL_INT(1, queue.untraced);
+
+	// the queue initialization forgets the traces
+	INPUT_TRACE_queue_init(T_UI_INPUT_TRACE_QUEUE_SIZE);
+	INPUT_TRACE_event_read(1);
+	TEST_ASSERT_EQUAL_INT(1, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, INPUT_TRACE_HISTOGRAM_BUCKETS));
+}
+
+static void T_UI_INPUT_TRACE_queue(void)
+{
+	INPUT_TRACE_queue_statistics_t queue;
+
+	INPUT_TRACE_queue_add(1);
+	INPUT_TRACE_queue_add(5);
+	INPUT_TRACE_queue_add(3);
+	INPUT_TRACE_queue_full();
+	INPUT_TRACE_queue_full();
+	TEST_ASSERT_EQUAL_INT(5, javaInputTraceGetQueueHighWaterMark());
+
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_TRUE);
+	TEST_ASSERT_EQUAL_INT(T_UI_INPUT_TRACE_QUEUE_SIZE, queue.size);
+	TEST_ASSERT_EQUAL_INT(5, queue.high_water_mark);
+	TEST_ASSERT_EQUAL_INT(2, queue.full);
+	TEST_ASSERT_EQUAL_INT(0, queue.untraced);
+
+	// the size is kept by the reset
+	INPUT_TRACE_get_queue_statistics(&queue, MICROEJ_FALSE);
+	TEST_ASSERT_EQUAL_INT(T_UI_INPUT_TRACE_QUEUE_SIZE, queue.size);
+	TEST_ASSERT_EQUAL_INT(0, queue.high_water_mark);
+	TEST_ASSERT_EQUAL_INT(0, queue.full);
+
+	// the Java reset clears the histograms and the queue statistics
+	INPUT_TRACE_queue_add(2);
+	T_UI_INPUT_TRACE_event(0, 0, 100, 100, 100);
+	javaInputTraceReset();
+	TEST_ASSERT_EQUAL_INT(0, javaInputTraceGetQueueHighWaterMark());
+	TEST_ASSERT_EQUAL_INT(0, javaInputTraceGetPercentile(INPUT_TRACE_STAGE_TOTAL, 100));
+}
+
+static void T_UI_INPUT_TRACE_window(void)
+{
+	for (uint32_t i = 0; i < (uint32_t)INPUT_TRACE_HISTOGRAM_EVENTS; i++)
+	{
+		T_UI_INPUT_TRACE_event(i % T_UI_INPUT_TRACE_QUEUE_SIZE, 100000U * i, 500, 250, 250);
+	}
+	TEST_ASSERT_EQUAL_INT(1250, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 100));
+
+	// half of the window is replaced by events longer than the last bucket
+	for (uint32_t i = 0; i < ((uint32_t)INPUT_TRACE_HISTOGRAM_EVENTS / 2U); i++)
+	{
+		T_UI_INPUT_TRACE_event(i % T_UI_INPUT_TRACE_QUEUE_SIZE, 100000000U + (1000000U * i), 500, 250, 100000);
+	}
+	TEST_ASSERT_EQUAL_INT(1250, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 50));
+	TEST_ASSERT_EQUAL_INT(INPUT_TRACE_HISTOGRAM_BUCKETS * INPUT_TRACE_HISTOGRAM_BUCKET_US, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 51));
+	TEST_ASSERT_EQUAL_INT(INPUT_TRACE_HISTOGRAM_BUCKETS * INPUT_TRACE_HISTOGRAM_BUCKET_US, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_QUEUE, 100));
+	TEST_ASSERT_EQUAL_INT(750, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_READ, 100));
+}
+
+static void T_UI_INPUT_TRACE_errors(void)
+{
+	uint16_t buckets[5] = { 0xffff, 0xffff, 0xffff, 0xffff, 0xffff };
+
+	T_UI_INPUT_TRACE_event(0, 0, 100, 100, 100);
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_percentile(-1, 50));
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGES, 50));
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 0));
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 101));
+	TEST_ASSERT_EQUAL_INT(0, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGES, buckets, 4));
+
+	// the copy of the histogram is limited to the given length
+	TEST_ASSERT_EQUAL_INT(1, INPUT_TRACE_get_histogram(INPUT_TRACE_STAGE_TOTAL, buckets, 4));
+	TEST_ASSERT_EQUAL_INT(1, buckets[1]);
+	TEST_ASSERT_EQUAL_INT(0, buckets[3]);
+	TEST_ASSERT_EQUAL_INT(0xffff, buckets[4]);
+}
+
+static void T_UI_INPUT_TRACE_wrap(void)
+{
+	// the time wraps around between the sample and the read by the MicroUI pump
+	T_UI_INPUT_TRACE_event(0, UINT32_MAX - 999U, 500, 500, 1000);
+	TEST_ASSERT_EQUAL_INT(750, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_READ, 100));
+	TEST_ASSERT_EQUAL_INT(1250, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_QUEUE, 100));
+	TEST_ASSERT_EQUAL_INT(2250, INPUT_TRACE_get_percentile(INPUT_TRACE_STAGE_TOTAL, 100));
+}
+
+TestRef T_UI_INPUT_TRACE_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Stages", T_UI_INPUT_TRACE_stages),
+		new_TestFixture("Events in flight", T_UI_INPUT_TRACE_in_flight),
+		new_TestFixture("Queue statistics", T_UI_INPUT_TRACE_queue),
+		new_TestFixture("Window", T_UI_INPUT_TRACE_window),
+		new_TestFixture("Errors", T_UI_INPUT_TRACE_errors),
+		new_TestFixture("Time wrap", T_UI_INPUT_TRACE_wrap),
+	};
+
+	EMB_UNIT_TESTCALLER(inputTraceTest, "Input_trace_tests", T_UI_INPUT_TRACE_setUp, T_UI_INPUT_TRACE_tearDown, fixtures);
+
+	return (TestRef)&inputTraceTest;
+}
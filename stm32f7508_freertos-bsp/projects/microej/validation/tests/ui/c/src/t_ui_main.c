@@ -0,0 +1,48 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_main.h"
+#include "t_ui_dirty_regions.h"
+#include "t_ui_webp_decode.h"
+#include "t_ui_webp_stream.h"
+#include "t_ui_image_heap.h"
+#include "t_ui_image_heap_benchmark.h"
+#include "t_ui_glyph_atlas_sheet.h"
+#include "t_ui_dma2d_shapes.h"
+#include "t_ui_dma2d_transform.h"
+#include "t_ui_grayscale.h"
+#include "t_ui_input_ring.h"
+#include "t_ui_display_buffers.h"
+#include "t_ui_display_list.h"
+#include "t_ui_framerate.h"
+#include "t_ui_touch_ft5336.h"
+#include "t_ui_touch_gesture.h"
+#include "t_ui_input_trace.h"
+
+
+
+void T_UI_main(void) {
+	TestRunner_start();
+	TestRunner_runTest(T_UI_DIRTY_REGIONS_tests());
+	TestRunner_runTest(T_UI_WEBP_DECODE_tests());
+	TestRunner_runTest(T_UI_WEBP_STREAM_tests());
+	TestRunner_runTest(T_UI_IMAGE_HEAP_tests());
+	TestRunner_runTest(T_UI_IMAGE_HEAP_BENCHMARK_tests());
+	TestRunner_runTest(T_UI_GLYPH_ATLAS_SHEET_tests());
+	TestRunner_runTest(T_UI_DMA2D_SHAPES_tests());
+	TestRunner_runTest(T_UI_DMA2D_TRANSFORM_tests());
+	TestRunner_runTest(T_UI_GRAYSCALE_tests());
+	TestRunner_runTest(T_UI_INPUT_RING_tests());
+	TestRunner_runTest(T_UI_DISPLAY_BUFFERS_tests());
+	TestRunner_runTest(T_UI_DISPLAY_LIST_tests());
+	TestRunner_runTest(T_UI_FRAMERATE_tests());
+	TestRunner_runTest(T_UI_TOUCH_FT5336_tests());
+	TestRunner_runTest(T_UI_TOUCH_GESTURE_tests());
+	TestRunner_runTest(T_UI_INPUT_TRACE_tests());
+	TestRunner_end();
+	return;
+}
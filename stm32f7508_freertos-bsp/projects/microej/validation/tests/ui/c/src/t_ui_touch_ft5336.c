@@ -0,0 +1,327 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "x_ui_ft5336.h"
+#include "t_ui_touch_ft5336.h"
+
+#include "../../../../../ui/src/touch_ft5336.c"
+
+/*
+ * The state machine is run like the touch manager runs it (touch_manager.c): the
+ * interrupt line calls TOUCH_FT5336_data_ready(), a read of the registers of the
+ * simulated FT5336 lasts T_UI_TOUCH_FT5336_READ_US then calls TOUCH_FT5336_read_done()
+ * and wakes the IO task up, the IO task calls TOUCH_FT5336_work() and sleeps for the
+ * returned delay. The events are processed in time order.
+ */
+
+// I2C read of the 13 sample registers at 400 kHz
+#define T_UI_TOUCH_FT5336_READ_US 400U
+
+#define T_UI_TOUCH_FT5336_MAX_READS 512U
+#define NO_EVENT UINT64_MAX
+
+static uint64_t now;
+static uint32_t time_base;		// time of the state machine when the simulation starts
+static uint64_t read_end;		// NO_EVENT when no read is in progress
+static uint64_t task_time;		// NO_EVENT when the IO task waits for a wake up
+static uint32_t failing_reads;	// next reads which cannot be started
+
+static uint32_t reads;
+static uint64_t read_starts[T_UI_TOUCH_FT5336_MAX_READS];
+static INPUT_RING_event_t samples[T_UI_TOUCH_FT5336_MAX_READS];
+
+static inline uint32_t T_UI_TOUCH_FT5336_time(void)
+{
+	return time_base + (uint32_t)now;
+}
+
+static void T_UI_TOUCH_FT5336_perform(TOUCH_FT5336_action_t action)
+{
+	while (TOUCH_FT5336_READ == action)
+	{
+		if (failing_reads > 0U)
+		{
+			failing_reads--;
+			action = TOUCH_FT5336_read_error();
+		}
+		else
+		{
+			TEST_ASSERT(NO_EVENT == read_end);
+			TEST_ASSERT(reads < T_UI_TOUCH_FT5336_MAX_READS);
+			read_starts[reads] = now;
+			read_end = now + T_UI_TOUCH_FT5336_READ_US;
+			action = TOUCH_FT5336_NONE;
+		}
+	}
+
+	if (TOUCH_FT5336_WAKE == action)
+	{
+		task_time = now;
+	}
+}
+
+static void T_UI_TOUCH_FT5336_run_until(uint64_t end)
+{
+	for (;;)
+	{
+		uint64_t next = (read_end < task_time) ? read_end : task_time;
+		if (next > end)
+		{
+			break;
+		}
+		now = next;
+
+		if (read_end == now)
+		{
+			uint8_t regs[TOUCH_FT5336_REG_COUNT];
+			read_end = NO_EVENT;
+			X_UI_FT5336_read(TOUCH_FT5336_REG_FIRST, regs, TOUCH_FT5336_REG_COUNT);
+			TOUCH_FT5336_action_t action = TOUCH_FT5336_read_done(regs, T_UI_TOUCH_FT5336_time(), &samples[reads]);
+			reads++;
+			T_UI_TOUCH_FT5336_perform(action);
+			task_time = now;
+		}
+		else
+		{
+			uint32_t delay;
+			task_time = NO_EVENT;
+			T_UI_TOUCH_FT5336_perform(TOUCH_FT5336_work(T_UI_TOUCH_FT5336_time(), &delay));
+			if ((TOUCH_FT5336_NO_DELAY != delay) && ((now + delay) < task_time))
+			{
+				task_time = now + delay;
+			}
+		}
+	}
+	now = end;
+}
+
+/*
+ * A new sample of the simulated FT5336 at the given time: the interrupt line is raised.
+ */
+static void T_UI_TOUCH_FT5336_touch(uint64_t time, const TOUCH_GESTURE_point_t* points, uint32_t count)
+{
+	T_UI_TOUCH_FT5336_run_until(time);
+	X_UI_FT5336_sample(points, count);
+	T_UI_TOUCH_FT5336_perform(TOUCH_FT5336_data_ready(T_UI_TOUCH_FT5336_time()));
+}
+
+static void T_UI_TOUCH_FT5336_press(uint64_t time, uint16_t x, uint16_t y)
+{
+	TOUCH_GESTURE_point_t point = { x, y };
+	T_UI_TOUCH_FT5336_touch(time, &point, 1);
+}
+
+static void T_UI_TOUCH_FT5336_setUp(void)
+{
+	X_UI_FT5336_reset();
+	TOUCH_FT5336_initialize();
+	now = 0;
+	time_base = 0;
+	read_end = NO_EVENT;
+	task_time = NO_EVENT;
+	failing_reads = 0;
+	reads = 0;
+}
+
+static void T_UI_TOUCH_FT5336_tearDown(void)
+{
+
+}
+
+static void T_UI_TOUCH_FT5336_decode(void)
+{
+	uint8_t regs[TOUCH_FT5336_REG_COUNT];
+	TOUCH_GESTURE_point_t points[TOUCH_GESTURE_MAX_POINTS];
+	const TOUCH_GESTURE_point_t fingers[5] = { { 10, 20 }, { 479, 271 }, { 1, 2 }, { 3, 4 }, { 5, 6 } };
+
+	// two fingers: the controller axes are swapped back
+	X_UI_FT5336_sample(fingers, 2);
+	X_UI_FT5336_read(TOUCH_FT5336_REG_FIRST, regs, TOUCH_FT5336_REG_COUNT);
+	TEST_ASSERT_EQUAL_INT(2, TOUCH_FT5336_decode(regs, points));
+	TEST_ASSERT_EQUAL_INT(10, points[0].x);
+	TEST_ASSERT_EQUAL_INT(20, points[0].y);
+	TEST_ASSERT_EQUAL_INT(479, points[1].x);
+	TEST_ASSERT_EQUAL_INT(271, points[1].y);
+
+	// the points above TOUCH_GESTURE_MAX_POINTS are not read
+	X_UI_FT5336_sample(fingers, 5);
+	X_UI_FT5336_read(TOUCH_FT5336_REG_FIRST, regs, TOUCH_FT5336_REG_COUNT);
+	TEST_ASSERT_EQUAL_INT(2, TOUCH_FT5336_decode(regs, points));
+
+	// the "put up" points are released
+	X_UI_FT5336_sample(NULL, 0);
+	X_UI_FT5336_read(TOUCH_FT5336_REG_FIRST, regs, TOUCH_FT5336_REG_COUNT);
+	TEST_ASSERT_EQUAL_INT(5, regs[0]);
+	TEST_ASSERT_EQUAL_INT(0, TOUCH_FT5336_decode(regs, points));
+
+	// more than 5 points is an invalid sample
+	X_UI_FT5336_sample(fingers, 1);
+	X_UI_FT5336_write(TOUCH_FT5336_REG_FIRST, 0x0f);
+	X_UI_FT5336_read(TOUCH_FT5336_REG_FIRST, regs, TOUCH_FT5336_REG_COUNT);
+	TEST_ASSERT_EQUAL_INT(0, TOUCH_FT5336_decode(regs, points));
+}
+
+static void T_UI_TOUCH_FT5336_press_release(void)
+{
+	// the press is read at once
+	T_UI_TOUCH_FT5336_press(1000, 100, 50);
+	TEST_ASSERT_EQUAL_INT(1000, read_end - T_UI_TOUCH_FT5336_READ_US);
+	T_UI_TOUCH_FT5336_run_until(2000);
+	TEST_ASSERT_EQUAL_INT(1, reads);
+	TEST_ASSERT_EQUAL_INT(INPUT_RING_TOUCH, samples[0].type);
+	TEST_ASSERT_EQUAL_INT(1, samples[0].id);
+	TEST_ASSERT_EQUAL_INT(1000, samples[0].time);
+	TEST_ASSERT_EQUAL_INT(1000 + T_UI_TOUCH_FT5336_READ_US, samples[0].read_time);
+	TEST_ASSERT_EQUAL_INT(100, samples[0].points[0].x);
+	TEST_ASSERT_EQUAL_INT(50, samples[0].points[0].y);
+
+	// the IO task checks the pressed touch after TOUCH_RELEASE_TIMEOUT_MS
+	TEST_ASSERT_EQUAL_INT(1000 + T_UI_TOUCH_FT5336_READ_US + RELEASE_TIMEOUT, task_time);
+
+	// the release is read at once (after the sampling period)
+	T_UI_TOUCH_FT5336_touch(20000, NULL, 0);
+	T_UI_TOUCH_FT5336_run_until(30000);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+	TEST_ASSERT_EQUAL_INT(20000, read_starts[1]);
+	TEST_ASSERT_EQUAL_INT(0, samples[1].id);
+
+	// nothing is read while the touch is released
+	T_UI_TOUCH_FT5336_run_until(1000000);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+	TEST_ASSERT(NO_EVENT == task_time);
+}
+
+/*
+ * A finger moves for one second while the FT5336 signals a sample every millisecond.
+ */
+static void T_UI_TOUCH_FT5336_move(uint32_t base)
+{
+	time_base = base;
+	uint64_t start = 1000;
+	uint32_t moves = 1000;
+
+	for (uint32_t i = 0; i < moves; i++)
+	{
+		T_UI_TOUCH_FT5336_press(start + (i * 1000U), (uint16_t)i, 10);
+	}
+	T_UI_TOUCH_FT5336_run_until(start + (moves * 1000U) + SAMPLING_PERIOD);
+
+	// the reads are limited to TOUCH_SAMPLING_RATE_HZ
+	TEST_ASSERT(reads <= (((moves * 1000U) / SAMPLING_PERIOD) + 2U));
+	for (uint32_t i = 1; i < reads; i++)
+	{
+		TEST_ASSERT((read_starts[i] - read_starts[i - 1U]) >= SAMPLING_PERIOD);
+	}
+
+	// each read gives the last sample; its time is the time of the oldest sample not read
+	for (uint32_t i = 0; i < reads; i++)
+	{
+		uint32_t age = samples[i].read_time - samples[i].time;
+		TEST_ASSERT_EQUAL_INT(1, samples[i].id);
+		TEST_ASSERT(age <= (SAMPLING_PERIOD + T_UI_TOUCH_FT5336_READ_US));
+		// the registers hold the last sample signaled before the end of the read
+		uint32_t last = (uint32_t)(read_starts[i] + T_UI_TOUCH_FT5336_READ_US - start - 1U) / 1000U;
+		last = (last < moves) ? last : (moves - 1U);
+		TEST_ASSERT_EQUAL_INT(last, samples[i].points[0].x);
+	}
+	TEST_ASSERT_EQUAL_INT(moves - 1U, samples[reads - 1U].points[0].x);
+}
+
+static void T_UI_TOUCH_FT5336_sampling(void)
+{
+	T_UI_TOUCH_FT5336_move(0);
+}
+
+static void T_UI_TOUCH_FT5336_wrap(void)
+{
+	// the time of the state machine wraps around in the middle of the moves
+	T_UI_TOUCH_FT5336_move(UINT32_MAX - 300000U);
+}
+
+static void T_UI_TOUCH_FT5336_data_ready_during_read(void)
+{
+	T_UI_TOUCH_FT5336_press(1000, 100, 50);
+
+	// the new sample is read at the end of the sampling period
+	T_UI_TOUCH_FT5336_press(1200, 110, 50);
+	T_UI_TOUCH_FT5336_run_until(1000 + SAMPLING_PERIOD + T_UI_TOUCH_FT5336_READ_US);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+	TEST_ASSERT_EQUAL_INT(1000 + SAMPLING_PERIOD, read_starts[1]);
+	TEST_ASSERT_EQUAL_INT(1200, samples[1].time);
+	TEST_ASSERT_EQUAL_INT(110, samples[1].points[0].x);
+}
+
+static void T_UI_TOUCH_FT5336_read_error(void)
+{
+	// the read cannot be started: the IO task retries at the end of the sampling period
+	failing_reads = 1;
+	T_UI_TOUCH_FT5336_press(1000, 100, 50);
+	TEST_ASSERT(NO_EVENT == read_end);
+	TEST_ASSERT_EQUAL_INT(1000, task_time);
+	T_UI_TOUCH_FT5336_run_until(1000 + SAMPLING_PERIOD + T_UI_TOUCH_FT5336_READ_US);
+	TEST_ASSERT_EQUAL_INT(1, reads);
+	TEST_ASSERT_EQUAL_INT(1000 + SAMPLING_PERIOD, read_starts[0]);
+	TEST_ASSERT_EQUAL_INT(1000, samples[0].time);
+
+	// the failed read of a pressed touch keeps the touch pressed
+	failing_reads = 1;
+	T_UI_TOUCH_FT5336_press(20000, 120, 50);
+	T_UI_TOUCH_FT5336_run_until(20000 + SAMPLING_PERIOD + T_UI_TOUCH_FT5336_READ_US);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+	TEST_ASSERT_EQUAL_INT(20000 + SAMPLING_PERIOD, read_starts[1]);
+	TEST_ASSERT_EQUAL_INT(120, samples[1].points[0].x);
+}
+
+static void T_UI_TOUCH_FT5336_lost_release(void)
+{
+	T_UI_TOUCH_FT5336_press(1000, 100, 50);
+	T_UI_TOUCH_FT5336_run_until(2000);
+
+	// the "put up" sample is not signaled: the touch is read after TOUCH_RELEASE_TIMEOUT_MS
+	X_UI_FT5336_sample(NULL, 0);
+	uint64_t check = 1000 + T_UI_TOUCH_FT5336_READ_US + RELEASE_TIMEOUT;
+	T_UI_TOUCH_FT5336_run_until(check + T_UI_TOUCH_FT5336_READ_US);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+	TEST_ASSERT_EQUAL_INT(check, read_starts[1]);
+	TEST_ASSERT_EQUAL_INT(0, samples[1].id);
+
+	T_UI_TOUCH_FT5336_run_until(1000000);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+}
+
+static void T_UI_TOUCH_FT5336_resync(void)
+{
+	T_UI_TOUCH_FT5336_press(1000, 100, 50);
+	T_UI_TOUCH_FT5336_run_until(50000);
+
+	// the touch ring has overflowed: the IO task reads the current sample again
+	X_UI_FT5336_sample(NULL, 0);
+	TOUCH_FT5336_resync(T_UI_TOUCH_FT5336_time());
+	task_time = now;
+	T_UI_TOUCH_FT5336_run_until(50000 + T_UI_TOUCH_FT5336_READ_US);
+	TEST_ASSERT_EQUAL_INT(2, reads);
+	TEST_ASSERT_EQUAL_INT(50000, read_starts[1]);
+	TEST_ASSERT_EQUAL_INT(0, samples[1].id);
+}
+
+TestRef T_UI_TOUCH_FT5336_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Decode", T_UI_TOUCH_FT5336_decode),
+		new_TestFixture("Press and release", T_UI_TOUCH_FT5336_press_release),
+		new_TestFixture("Sampling rate", T_UI_TOUCH_FT5336_sampling),
+		new_TestFixture("Time wrap", T_UI_TOUCH_FT5336_wrap),
+		new_TestFixture("Sample during a read", T_UI_TOUCH_FT5336_data_ready_during_read),
+		new_TestFixture("Read error", T_UI_TOUCH_FT5336_read_error),
+		new_TestFixture("Lost release", T_UI_TOUCH_FT5336_lost_release),
+		new_TestFixture("Resync", T_UI_TOUCH_FT5336_resync),
+	};
+
+	EMB_UNIT_TESTCALLER(touchFT5336Test, "Touch_FT5336_tests", T_UI_TOUCH_FT5336_setUp, T_UI_TOUCH_FT5336_tearDown, fixtures);
+
+	return (TestRef)&touchFT5336Test;
+}
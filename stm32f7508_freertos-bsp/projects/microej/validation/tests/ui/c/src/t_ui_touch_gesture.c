@@ -0,0 +1,237 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "t_ui_touch_gesture.h"
+
+/*
+ * The recognizer is built whatever the BSP configuration; the gestures are sent to the
+ * stub of the generic event generator below.
+ */
+#ifndef TOUCH_GESTURE_ENABLED
+#define TOUCH_GESTURE_ENABLED
+#endif
+#ifndef MICROUI_EVENTGEN_GESTURES
+#define MICROUI_EVENTGEN_GESTURES 9
+#endif
+#include "../../../../../ui/src/touch_gesture.c"
+
+#define T_UI_TOUCH_GESTURE_EVENTS 16U
+
+// one sample every 10 ms
+#define T_UI_TOUCH_GESTURE_PERIOD_US 10000U
+
+static int32_t events[T_UI_TOUCH_GESTURE_EVENTS][TOUCH_GESTURE_EVENT_SIZE];
+static uint32_t event_count;
+
+int32_t EVENT_GENERATOR_gesture(int32_t* event, int32_t length)
+{
+	// an event of another size is not counted (the tests check the number of events)
+	if ((TOUCH_GESTURE_EVENT_SIZE == length) && (event_count < T_UI_TOUCH_GESTURE_EVENTS))
+	{
+		for (uint32_t i = 0; i < (uint32_t)TOUCH_GESTURE_EVENT_SIZE; i++)
+		{
+			events[event_count][i] = event[i];
+		}
+		event_count++;
+	}
+	return 0;
+}
+
+static uint32_t T_UI_TOUCH_GESTURE_type(uint32_t e)
+{
+	return (uint32_t)events[e][0] >> 24;
+}
+
+static uint32_t T_UI_TOUCH_GESTURE_flags(uint32_t e)
+{
+	return (uint32_t)events[e][0] & 0xffffffU;
+}
+
+static uint32_t T_UI_TOUCH_GESTURE_x(uint32_t e)
+{
+	return (uint32_t)events[e][1] >> 16;
+}
+
+static uint32_t T_UI_TOUCH_GESTURE_y(uint32_t e)
+{
+	return (uint32_t)events[e][1] & 0xffffU;
+}
+
+static void T_UI_TOUCH_GESTURE_one(uint16_t x, uint16_t y, uint32_t time)
+{
+	TOUCH_GESTURE_point_t point = { x, y };
+	TOUCH_GESTURE_update(&point, 1, time);
+}
+
+static void T_UI_TOUCH_GESTURE_two(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t time)
+{
+	TOUCH_GESTURE_point_t points[2] = { { x1, y1 }, { x2, y2 } };
+	TOUCH_GESTURE_update(points, 2, time);
+}
+
+/*
+ * A finger moves from (x, y) by (dx, dy) per sample during count samples from the
+ * given time, then is released.
+ */
+static void T_UI_TOUCH_GESTURE_drag(uint16_t x, uint16_t y, int32_t dx, int32_t dy, uint32_t count, uint32_t time)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		T_UI_TOUCH_GESTURE_one((uint16_t)((int32_t)x + ((int32_t)i * dx)), (uint16_t)((int32_t)y + ((int32_t)i * dy)), time + (i * T_UI_TOUCH_GESTURE_PERIOD_US));
+	}
+	TOUCH_GESTURE_update(NULL, 0, time + (count * T_UI_TOUCH_GESTURE_PERIOD_US));
+}
+
+static void T_UI_TOUCH_GESTURE_setUp(void)
+{
+	TOUCH_GESTURE_initialize();
+	event_count = 0;
+}
+
+static void T_UI_TOUCH_GESTURE_tearDown(void)
+{
+
+}
+
+static void T_UI_TOUCH_GESTURE_long_press(void)
+{
+	// the finger shakes in the slop
+	uint32_t time = 0;
+	for (; time < LONG_PRESS_DELAY; time += T_UI_TOUCH_GESTURE_PERIOD_US)
+	{
+		T_UI_TOUCH_GESTURE_one((uint16_t)(100U + ((time / T_UI_TOUCH_GESTURE_PERIOD_US) % (uint32_t)TOUCH_GESTURE_SLOP)), 200, time);
+	}
+	TEST_ASSERT_EQUAL_INT(0, event_count);
+
+	// one long press at the press point
+	T_UI_TOUCH_GESTURE_one(105, 200, time);
+	T_UI_TOUCH_GESTURE_one(105, 200, time + LONG_PRESS_DELAY);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_LONG_PRESS, T_UI_TOUCH_GESTURE_type(0));
+	TEST_ASSERT_EQUAL_INT(100, T_UI_TOUCH_GESTURE_x(0));
+	TEST_ASSERT_EQUAL_INT(200, T_UI_TOUCH_GESTURE_y(0));
+	TEST_ASSERT_EQUAL_INT(0, events[0][2]);
+
+	// no fling after a long press
+	T_UI_TOUCH_GESTURE_one(400, 200, time + LONG_PRESS_DELAY + 1000U);
+	TOUCH_GESTURE_update(NULL, 0, time + LONG_PRESS_DELAY + 2000U);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+
+	// the finger left the slop: no long press
+	T_UI_TOUCH_GESTURE_one(100, 200, 0);
+	T_UI_TOUCH_GESTURE_one(100, 200 + TOUCH_GESTURE_SLOP + 1, T_UI_TOUCH_GESTURE_PERIOD_US);
+	T_UI_TOUCH_GESTURE_one(100, 200, 2U * LONG_PRESS_DELAY);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+}
+
+static void T_UI_TOUCH_GESTURE_fling(void)
+{
+	// 20 pixels every 10 ms to the left and 5 down: 2000 and 500 pixels per second
+	T_UI_TOUCH_GESTURE_drag(300, 100, -20, 5, 6, 1000);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_FLING, T_UI_TOUCH_GESTURE_type(0));
+	TEST_ASSERT_EQUAL_INT(0, T_UI_TOUCH_GESTURE_flags(0));
+	TEST_ASSERT_EQUAL_INT(200, T_UI_TOUCH_GESTURE_x(0));
+	TEST_ASSERT_EQUAL_INT(125, T_UI_TOUCH_GESTURE_y(0));
+	TEST_ASSERT_EQUAL_INT(-2000, (int16_t)((uint32_t)events[0][2] >> 16));
+	TEST_ASSERT_EQUAL_INT(500, (int16_t)((uint32_t)events[0][2] & 0xffffU));
+
+	// too slow: 2 pixels every 10 ms
+	T_UI_TOUCH_GESTURE_drag(300, 100, 2, 0, 6, 1000000);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+
+	// the finger stops before the release: the velocity is computed over the last
+	// TOUCH_GESTURE_FLING_WINDOW_MS only
+	for (uint32_t i = 0; i < 5U; i++)
+	{
+		T_UI_TOUCH_GESTURE_one((uint16_t)(i * 40U), 100, 2000000U + (i * T_UI_TOUCH_GESTURE_PERIOD_US));
+	}
+	T_UI_TOUCH_GESTURE_one(160, 100, 2000000U + FLING_WINDOW + (5U * T_UI_TOUCH_GESTURE_PERIOD_US));
+	TOUCH_GESTURE_update(NULL, 0, 2000000U + FLING_WINDOW + (6U * T_UI_TOUCH_GESTURE_PERIOD_US));
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+
+	// the velocity is clamped to 16 bits
+	T_UI_TOUCH_GESTURE_one(0, 100, 3000000);
+	T_UI_TOUCH_GESTURE_one(400, 100, 3000001);
+	TOUCH_GESTURE_update(NULL, 0, 3000002);
+	TEST_ASSERT_EQUAL_INT(2, event_count);
+	TEST_ASSERT_EQUAL_INT(INT16_MAX, (int16_t)((uint32_t)events[1][2] >> 16));
+}
+
+static void T_UI_TOUCH_GESTURE_pinch(void)
+{
+	// the start of the pinch is not sent
+	T_UI_TOUCH_GESTURE_one(100, 100, 0);
+	T_UI_TOUCH_GESTURE_two(100, 100, 200, 100, 10000);
+	TEST_ASSERT_EQUAL_INT(0, event_count);
+
+	// the fingers move apart: scale 1.5 at the center
+	T_UI_TOUCH_GESTURE_two(50, 100, 200, 100, 20000);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_PINCH, T_UI_TOUCH_GESTURE_type(0));
+	TEST_ASSERT_EQUAL_INT(0, T_UI_TOUCH_GESTURE_flags(0));
+	TEST_ASSERT_EQUAL_INT(125, T_UI_TOUCH_GESTURE_x(0));
+	TEST_ASSERT_EQUAL_INT(100, T_UI_TOUCH_GESTURE_y(0));
+	TEST_ASSERT_EQUAL_INT(384, events[0][2]);
+
+	// less than TOUCH_GESTURE_PINCH_STEP: no event
+	T_UI_TOUCH_GESTURE_two(49, 100, 200, 100, 30000);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+
+	// the fingers move together
+	T_UI_TOUCH_GESTURE_two(150, 100, 200, 100, 40000);
+	TEST_ASSERT_EQUAL_INT(2, event_count);
+	TEST_ASSERT_EQUAL_INT(128, events[1][2]);
+
+	// a finger is released: end of the pinch with the last scale, then no fling
+	T_UI_TOUCH_GESTURE_one(150, 100, 50000);
+	TEST_ASSERT_EQUAL_INT(3, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_PINCH, T_UI_TOUCH_GESTURE_type(2));
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_FLAG_END, T_UI_TOUCH_GESTURE_flags(2));
+	TEST_ASSERT_EQUAL_INT(128, events[2][2]);
+	T_UI_TOUCH_GESTURE_one(400, 100, 60000);
+	TOUCH_GESTURE_update(NULL, 0, 70000);
+	TEST_ASSERT_EQUAL_INT(3, event_count);
+
+	// no long press after a pinch (only the end of the pinch is sent)
+	T_UI_TOUCH_GESTURE_one(100, 100, 100000);
+	T_UI_TOUCH_GESTURE_two(100, 100, 200, 100, 110000);
+	T_UI_TOUCH_GESTURE_one(100, 100, 120000);
+	T_UI_TOUCH_GESTURE_one(100, 100, 120000 + (2U * LONG_PRESS_DELAY));
+	TEST_ASSERT_EQUAL_INT(4, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_FLAG_END, T_UI_TOUCH_GESTURE_flags(3));
+}
+
+static void T_UI_TOUCH_GESTURE_wrap(void)
+{
+	// the time wraps around during the long press and the fling
+	uint32_t time = UINT32_MAX - (LONG_PRESS_DELAY / 2U);
+	T_UI_TOUCH_GESTURE_one(100, 100, time);
+	T_UI_TOUCH_GESTURE_one(100, 100, time + LONG_PRESS_DELAY);
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_LONG_PRESS, T_UI_TOUCH_GESTURE_type(0));
+	TOUCH_GESTURE_update(NULL, 0, time + LONG_PRESS_DELAY);
+
+	T_UI_TOUCH_GESTURE_drag(100, 100, 20, 0, 6, UINT32_MAX - 25000U);
+	TEST_ASSERT_EQUAL_INT(2, event_count);
+	TEST_ASSERT_EQUAL_INT(TOUCH_GESTURE_FLING, T_UI_TOUCH_GESTURE_type(1));
+	TEST_ASSERT_EQUAL_INT(2000, (int16_t)((uint32_t)events[1][2] >> 16));
+}
+
+TestRef T_UI_TOUCH_GESTURE_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Long press", T_UI_TOUCH_GESTURE_long_press),
+		new_TestFixture("Fling", T_UI_TOUCH_GESTURE_fling),
+		new_TestFixture("Pinch", T_UI_TOUCH_GESTURE_pinch),
+		new_TestFixture("Time wrap", T_UI_TOUCH_GESTURE_wrap),
+	};
+
+	EMB_UNIT_TESTCALLER(touchGestureTest, "Touch_gesture_tests", T_UI_TOUCH_GESTURE_setUp, T_UI_TOUCH_GESTURE_tearDown, fixtures);
+
+	return (TestRef)&touchGestureTest;
+}
@@ -0,0 +1,189 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "src/microej/microej_decode.h"
+#include "src/webp/decode.h"
+#include "x_ui_webp_images.h"
+#include "t_ui_webp_decode.h"
+
+/*
+ * Reference decoding of the current image (BGRA, 4 bytes per pixel).
+ */
+static uint8_t* reference;
+
+static void T_UI_WEBP_DECODE_setUp(void)
+{
+	reference = NULL;
+}
+
+static void T_UI_WEBP_DECODE_tearDown(void)
+{
+	WebPFree(reference);
+}
+
+/*
+ * Returns the ARGB8888 pixel at (x,y) of the reference decoding.
+ */
+static uint32_t T_UI_WEBP_DECODE_get_reference(uint32_t x, uint32_t y)
+{
+	const uint8_t* bgra = &reference[((y * X_UI_WEBP_WIDTH) + x) * 4U];
+	return ((uint32_t)bgra[3] << 24) | ((uint32_t)bgra[2] << 16) | ((uint32_t)bgra[1] << 8) | bgra[0];
+}
+
+/*
+ * Converts an ARGB8888 pixel in the given MicroUI format.
+ */
+static uint32_t T_UI_WEBP_DECODE_convert(uint32_t argb, MICROUI_ImageFormat format)
+{
+	uint32_t a = argb >> 24;
+	uint32_t r = (argb >> 16) & 0xffU;
+	uint32_t g = (argb >> 8) & 0xffU;
+	uint32_t b = argb & 0xffU;
+	uint32_t pixel;
+
+	switch (format)
+	{
+	case MICROUI_IMAGE_FORMAT_RGB565:
+		pixel = ((r & 0xf8U) << 8) | ((g & 0xfcU) << 3) | (b >> 3);
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB4444:
+		pixel = ((a & 0xf0U) << 8) | ((r & 0xf0U) << 4) | (g & 0xf0U) | (b >> 4);
+		break;
+	case MICROUI_IMAGE_FORMAT_ARGB1555:
+		pixel = ((a >= 0x80U) ? 0x8000U : 0U) | ((r & 0xf8U) << 7) | ((g & 0xf8U) << 2) | (b >> 3);
+		break;
+	default:
+		pixel = argb;
+		break;
+	}
+	return pixel;
+}
+
+/*
+ * Decodes all the test images requesting the given format and compares the decoded
+ * pixels with the reference decoding converted in the format.
+ */
+static void T_UI_WEBP_DECODE_check(MICROUI_ImageFormat expected_format, MICROUI_ImageFormat opaque_format, MICROUI_ImageFormat alpha_format)
+{
+	for (uint32_t i = 0; i < X_UI_WEBP_IMAGES; i++)
+	{
+		const X_UI_WEBP_image_t* test = &X_UI_WEBP_images[i];
+		MICROUI_Image image;
+		bool is_fully_opaque = false;
+		int width;
+		int height;
+
+		memset(&image, 0, sizeof(image));
+		reference = WebPDecodeBGRA(test->data, test->size, &width, &height);
+		TEST_ASSERT(NULL != reference);
+		TEST_ASSERT_EQUAL_INT(X_UI_WEBP_WIDTH, width);
+		TEST_ASSERT_EQUAL_INT(X_UI_WEBP_HEIGHT, height);
+
+		TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_OK, MICROEJ_DECODE_webp((uint8_t*)test->data, test->size, expected_format, &image, &is_fully_opaque));
+		TEST_ASSERT_EQUAL_INT(X_UI_WEBP_WIDTH, image.width);
+		TEST_ASSERT_EQUAL_INT(X_UI_WEBP_HEIGHT, image.height);
+
+		MICROUI_ImageFormat format = test->alpha ? alpha_format : opaque_format;
+		TEST_ASSERT_EQUAL_INT(format, image.format);
+		TEST_ASSERT(is_fully_opaque == (!test->alpha || (MICROUI_IMAGE_FORMAT_RGB565 == format)));
+
+		const uint8_t* buffer = LLUI_DISPLAY_getBufferAddress(&image);
+		const uint32_t stride = LLUI_DISPLAY_getStrideInBytes(&image);
+		for (uint32_t y = 0; y < X_UI_WEBP_HEIGHT; y++)
+		{
+			for (uint32_t x = 0; x < X_UI_WEBP_WIDTH; x++)
+			{
+				uint32_t pixel;
+				if (MICROUI_IMAGE_FORMAT_ARGB8888 == format)
+				{
+					pixel = ((const uint32_t*)(buffer + (y * stride)))[x];
+				}
+				else
+				{
+					pixel = ((const uint16_t*)(buffer + (y * stride)))[x];
+				}
+				uint32_t expected = T_UI_WEBP_DECODE_get_reference(x, y);
+				TEST_ASSERT_EQUAL_INT(T_UI_WEBP_DECODE_convert(expected, format), pixel);
+
+				if (test->lossless)
+				{
+					// the lossless images are decoded without loss
+					TEST_ASSERT_EQUAL_INT(X_UI_WEBP_pixel(x, y, test->alpha), expected);
+				}
+			}
+		}
+
+		LLUI_DISPLAY_freeImageBuffer(&image);
+		WebPFree(reference);
+		reference = NULL;
+	}
+}
+
+static void T_UI_WEBP_DECODE_rgb565(void)
+{
+	// the alpha channel is dropped
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_RGB565, MICROUI_IMAGE_FORMAT_RGB565, MICROUI_IMAGE_FORMAT_RGB565);
+}
+
+static void T_UI_WEBP_DECODE_argb4444(void)
+{
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_ARGB4444, MICROUI_IMAGE_FORMAT_ARGB4444, MICROUI_IMAGE_FORMAT_ARGB4444);
+}
+
+static void T_UI_WEBP_DECODE_argb1555(void)
+{
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_ARGB1555, MICROUI_IMAGE_FORMAT_ARGB1555, MICROUI_IMAGE_FORMAT_ARGB1555);
+}
+
+static void T_UI_WEBP_DECODE_argb8888(void)
+{
+	// requested format: the opaque images are not decoded in RGB565
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_ARGB8888, MICROUI_IMAGE_FORMAT_ARGB8888, MICROUI_IMAGE_FORMAT_ARGB8888);
+}
+
+static void T_UI_WEBP_DECODE_rgb888(void)
+{
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_RGB888, MICROUI_IMAGE_FORMAT_ARGB8888, MICROUI_IMAGE_FORMAT_ARGB8888);
+}
+
+static void T_UI_WEBP_DECODE_display(void)
+{
+#ifdef MICROEJ_DECODE_WEBP_OPAQUE_RGB565
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_DISPLAY, MICROUI_IMAGE_FORMAT_RGB565, MICROUI_IMAGE_FORMAT_ARGB8888);
+#else
+	T_UI_WEBP_DECODE_check(MICROUI_IMAGE_FORMAT_DISPLAY, MICROUI_IMAGE_FORMAT_ARGB8888, MICROUI_IMAGE_FORMAT_ARGB8888);
+#endif
+}
+
+static void T_UI_WEBP_DECODE_invalid(void)
+{
+	const X_UI_WEBP_image_t* test = &X_UI_WEBP_images[0];
+	MICROUI_Image image;
+	bool is_fully_opaque;
+
+	memset(&image, 0, sizeof(image));
+	TEST_ASSERT(LLUI_DISPLAY_OK != MICROEJ_DECODE_webp((uint8_t*)test->data, test->size / 2U, MICROUI_IMAGE_FORMAT_RGB565, &image, &is_fully_opaque));
+	LLUI_DISPLAY_freeImageBuffer(&image);
+}
+
+TestRef T_UI_WEBP_DECODE_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("RGB565", T_UI_WEBP_DECODE_rgb565),
+		new_TestFixture("ARGB4444", T_UI_WEBP_DECODE_argb4444),
+		new_TestFixture("ARGB1555", T_UI_WEBP_DECODE_argb1555),
+		new_TestFixture("ARGB8888", T_UI_WEBP_DECODE_argb8888),
+		new_TestFixture("RGB888", T_UI_WEBP_DECODE_rgb888),
+		new_TestFixture("Display format", T_UI_WEBP_DECODE_display),
+		new_TestFixture("Truncated image", T_UI_WEBP_DECODE_invalid),
+	};
+
+	EMB_UNIT_TESTCALLER(webpDecodeTest, "WebP_decode_tests", T_UI_WEBP_DECODE_setUp, T_UI_WEBP_DECODE_tearDown, fixtures);
+
+	return (TestRef)&webpDecodeTest;
+}
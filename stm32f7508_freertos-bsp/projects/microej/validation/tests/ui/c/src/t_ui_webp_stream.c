@@ -0,0 +1,275 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "src/microej/microej_decode.h"
+#include "microui_heap.h"
+#include "framerate_impl.h"
+#include "x_ui_webp_images.h"
+#include "t_ui_webp_stream.h"
+
+#define T_UI_WEBP_STREAM_CHUNK_MAX 4096U
+#define T_UI_WEBP_STREAM_BENCHMARK_LOOPS 20U
+
+/*
+ * A file read in chunks (LLFS_File_IMPL_read() on the target): the reader gives at most
+ * "available" bytes (truncated file) and fails at "error" (read error). The heap used
+ * between two reads is sampled.
+ */
+typedef struct
+{
+	const uint8_t* data;
+	uint32_t offset;
+	uint32_t available;
+	uint32_t error;
+	uint32_t reads;
+	uint32_t heap_peak;
+} T_UI_WEBP_STREAM_file_t;
+
+static uint8_t chunk[T_UI_WEBP_STREAM_CHUNK_MAX];
+static uint32_t allocated_blocks;
+
+static uint32_t T_UI_WEBP_STREAM_heap_used(void)
+{
+	return MICROUI_HEAP_total_space() - MICROUI_HEAP_free_space();
+}
+
+static int32_t T_UI_WEBP_STREAM_read(void* context, uint8_t* buffer, uint32_t length)
+{
+	T_UI_WEBP_STREAM_file_t* file = (T_UI_WEBP_STREAM_file_t*)context;
+	uint32_t used = T_UI_WEBP_STREAM_heap_used();
+	file->heap_peak = (used > file->heap_peak) ? used : file->heap_peak;
+
+	if (file->offset >= file->error)
+	{
+		return -1;
+	}
+	uint32_t remaining = file->available - file->offset;
+	uint32_t size = (length < remaining) ? length : remaining;
+	(void)memcpy(buffer, file->data + file->offset, size);
+	file->offset += size;
+	file->reads++;
+	return (int32_t)size;
+}
+
+static void T_UI_WEBP_STREAM_open(T_UI_WEBP_STREAM_file_t* file, const X_UI_WEBP_image_t* image)
+{
+	(void)memset(file, 0, sizeof(T_UI_WEBP_STREAM_file_t));
+	file->data = image->data;
+	file->available = image->size;
+	file->error = UINT32_MAX;
+}
+
+static void T_UI_WEBP_STREAM_setUp(void)
+{
+	allocated_blocks = MICROUI_HEAP_number_of_allocated_blocks();
+}
+
+static void T_UI_WEBP_STREAM_tearDown(void)
+{
+
+}
+
+/*
+ * Decodes the image in one call and read in chunks of the given size, and compares the
+ * two decoded images.
+ */
+static void T_UI_WEBP_STREAM_compare(const X_UI_WEBP_image_t* test, MICROUI_ImageFormat expected_format, uint32_t chunk_size)
+{
+	MICROUI_Image whole;
+	MICROUI_Image streamed;
+	bool whole_opaque = false;
+	bool streamed_opaque = false;
+	T_UI_WEBP_STREAM_file_t file;
+
+	(void)memset(&whole, 0, sizeof(whole));
+	(void)memset(&streamed, 0, sizeof(streamed));
+	T_UI_WEBP_STREAM_open(&file, test);
+
+	TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_OK, MICROEJ_DECODE_webp((uint8_t*)test->data, test->size, expected_format, &whole, &whole_opaque));
+	TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_OK, MICROEJ_DECODE_webp_read(T_UI_WEBP_STREAM_read, &file, chunk, chunk_size, expected_format, &streamed, &streamed_opaque));
+
+	TEST_ASSERT_EQUAL_INT(whole.width, streamed.width);
+	TEST_ASSERT_EQUAL_INT(whole.height, streamed.height);
+	TEST_ASSERT_EQUAL_INT(whole.format, streamed.format);
+	TEST_ASSERT(whole_opaque == streamed_opaque);
+	// the trailing bytes (RIFF padding) are not read once the image is decoded
+	TEST_ASSERT(file.offset <= test->size);
+
+	uint32_t size = LLUI_DISPLAY_getStrideInBytes(&whole) * whole.height;
+	TEST_ASSERT(0 == memcmp(LLUI_DISPLAY_getBufferAddress(&whole), LLUI_DISPLAY_getBufferAddress(&streamed), size));
+
+	LLUI_DISPLAY_freeImageBuffer(&whole);
+	LLUI_DISPLAY_freeImageBuffer(&streamed);
+}
+
+static void T_UI_WEBP_STREAM_chunks(void)
+{
+	static const MICROUI_ImageFormat formats[] = {
+		MICROUI_IMAGE_FORMAT_RGB565, MICROUI_IMAGE_FORMAT_ARGB4444, MICROUI_IMAGE_FORMAT_ARGB1555,
+		MICROUI_IMAGE_FORMAT_ARGB8888, MICROUI_IMAGE_FORMAT_DISPLAY,
+	};
+	static const uint32_t chunk_sizes[] = { 1U, 7U, 64U, T_UI_WEBP_STREAM_CHUNK_MAX };
+
+	for (uint32_t i = 0; i < X_UI_WEBP_IMAGES; i++)
+	{
+		for (uint32_t f = 0; f < (sizeof(formats) / sizeof(formats[0])); f++)
+		{
+			for (uint32_t c = 0; c < (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); c++)
+			{
+				T_UI_WEBP_STREAM_compare(&X_UI_WEBP_images[i], formats[f], chunk_sizes[c]);
+			}
+		}
+	}
+	for (uint32_t i = 0; i < X_UI_WEBP_SCREEN_IMAGES; i++)
+	{
+		T_UI_WEBP_STREAM_compare(&X_UI_WEBP_screen_images[i], MICROUI_IMAGE_FORMAT_DISPLAY, 512U);
+	}
+	TEST_ASSERT_EQUAL_INT(allocated_blocks, MICROUI_HEAP_number_of_allocated_blocks());
+}
+
+static void T_UI_WEBP_STREAM_progress(void)
+{
+	for (uint32_t i = 0; i < X_UI_WEBP_SCREEN_IMAGES; i++)
+	{
+		const X_UI_WEBP_image_t* test = &X_UI_WEBP_screen_images[i];
+		MICROEJ_DECODE_webp_stream stream;
+		MICROEJ_DECODE_webp_status status;
+		MICROUI_Image image;
+		bool is_fully_opaque = false;
+		uint32_t offset = 0;
+		uint32_t rows = 0;
+		uint32_t partial = 0;
+
+		(void)memset(&image, 0, sizeof(image));
+		MICROEJ_DECODE_webp_stream_start(&stream, MICROUI_IMAGE_FORMAT_RGB565, &image);
+		do
+		{
+			uint32_t length = ((test->size - offset) < 256U) ? (test->size - offset) : 256U;
+			status = MICROEJ_DECODE_webp_stream_append(&stream, test->data + offset, length);
+			offset += length;
+
+			// the decoded rows are available while the data is received
+			uint32_t new_rows = MICROEJ_DECODE_webp_stream_get_rows(&stream);
+			TEST_ASSERT(new_rows >= rows);
+			rows = new_rows;
+			partial += ((rows > 0U) && (rows < X_UI_WEBP_SCREEN_HEIGHT)) ? 1U : 0U;
+		} while ((MICROEJ_DECODE_WEBP_SUSPENDED == status) && (offset < test->size));
+
+		TEST_ASSERT_EQUAL_INT(MICROEJ_DECODE_WEBP_DONE, status);
+		TEST_ASSERT_EQUAL_INT(X_UI_WEBP_SCREEN_HEIGHT, rows);
+		printf("%s: %u bytes in %u chunks, partial progress reported %u times\n", test->name, (unsigned int)test->size, (unsigned int)((test->size + 255U) / 256U), (unsigned int)partial);
+		TEST_ASSERT(partial > 0U);
+		TEST_ASSERT(MICROEJ_DECODE_webp_stream_end(&stream, &is_fully_opaque));
+		TEST_ASSERT(is_fully_opaque);
+		LLUI_DISPLAY_freeImageBuffer(&image);
+	}
+}
+
+static void T_UI_WEBP_STREAM_errors(void)
+{
+	MICROUI_Image image;
+	bool is_fully_opaque = false;
+	T_UI_WEBP_STREAM_file_t file;
+
+	for (uint32_t i = 0; i < X_UI_WEBP_SCREEN_IMAGES; i++)
+	{
+		const X_UI_WEBP_image_t* test = &X_UI_WEBP_screen_images[i];
+
+		// truncated file: the image buffer (allocated after the header) is freed
+		(void)memset(&image, 0, sizeof(image));
+		T_UI_WEBP_STREAM_open(&file, test);
+		file.available = test->size / 2U;
+		TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_NOK, MICROEJ_DECODE_webp_read(T_UI_WEBP_STREAM_read, &file, chunk, 256U, MICROUI_IMAGE_FORMAT_DISPLAY, &image, &is_fully_opaque));
+		TEST_ASSERT_EQUAL_INT(allocated_blocks, MICROUI_HEAP_number_of_allocated_blocks());
+
+		// read error
+		(void)memset(&image, 0, sizeof(image));
+		T_UI_WEBP_STREAM_open(&file, test);
+		file.error = test->size / 2U;
+		TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_NOK, MICROEJ_DECODE_webp_read(T_UI_WEBP_STREAM_read, &file, chunk, 256U, MICROUI_IMAGE_FORMAT_DISPLAY, &image, &is_fully_opaque));
+		TEST_ASSERT_EQUAL_INT(allocated_blocks, MICROUI_HEAP_number_of_allocated_blocks());
+	}
+
+	// not a WebP image
+	(void)memset(&image, 0, sizeof(image));
+	(void)memset(&file, 0, sizeof(file));
+	file.data = chunk;
+	file.available = 128U;
+	file.error = UINT32_MAX;
+	(void)memset(chunk, 0x55, 128U);
+	TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_NOK, MICROEJ_DECODE_webp_read(T_UI_WEBP_STREAM_read, &file, chunk, 16U, MICROUI_IMAGE_FORMAT_DISPLAY, &image, &is_fully_opaque));
+	TEST_ASSERT_EQUAL_INT(allocated_blocks, MICROUI_HEAP_number_of_allocated_blocks());
+}
+
+/*
+ * Decoding time and memory held while decoding an image of the display size: the caller
+ * holds the whole encoded image (one call) or a chunk. The heap used by the incremental
+ * decoder besides the image buffer (data not consumed yet and decoding buffers, the latter
+ * being allocated by the decoding in one call too) is sampled at each read.
+ */
+static void T_UI_WEBP_STREAM_benchmark(void)
+{
+	static const uint32_t chunk_sizes[] = { 256U, 512U, 1024U };
+
+	printf("WebP streaming benchmark: %dx%d RGB565 image, %u decodings (us per decoding)\n", X_UI_WEBP_SCREEN_WIDTH, X_UI_WEBP_SCREEN_HEIGHT, (unsigned int)T_UI_WEBP_STREAM_BENCHMARK_LOOPS);
+	for (uint32_t i = 0; i < X_UI_WEBP_SCREEN_IMAGES; i++)
+	{
+		const X_UI_WEBP_image_t* test = &X_UI_WEBP_screen_images[i];
+		const uint32_t image_size = X_UI_WEBP_SCREEN_WIDTH * X_UI_WEBP_SCREEN_HEIGHT * 2U;
+		const uint32_t heap_used = T_UI_WEBP_STREAM_heap_used();
+		MICROUI_Image image;
+		bool is_fully_opaque;
+
+		uint32_t t0 = framerate_impl_get_cycles();
+		for (uint32_t l = 0; l < T_UI_WEBP_STREAM_BENCHMARK_LOOPS; l++)
+		{
+			(void)memset(&image, 0, sizeof(image));
+			TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_OK, MICROEJ_DECODE_webp((uint8_t*)test->data, test->size, MICROUI_IMAGE_FORMAT_RGB565, &image, &is_fully_opaque));
+			LLUI_DISPLAY_freeImageBuffer(&image);
+		}
+		uint32_t whole_us = framerate_impl_cycles_to_us(framerate_impl_get_cycles() - t0) / T_UI_WEBP_STREAM_BENCHMARK_LOOPS;
+		printf("%-16s: one call      %5u us, encoded image held %5u bytes\n", test->name, (unsigned int)whole_us, (unsigned int)test->size);
+
+		for (uint32_t c = 0; c < (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); c++)
+		{
+			T_UI_WEBP_STREAM_file_t file;
+			uint32_t decoder = 0;
+
+			t0 = framerate_impl_get_cycles();
+			for (uint32_t l = 0; l < T_UI_WEBP_STREAM_BENCHMARK_LOOPS; l++)
+			{
+				(void)memset(&image, 0, sizeof(image));
+				T_UI_WEBP_STREAM_open(&file, test);
+				TEST_ASSERT_EQUAL_INT(LLUI_DISPLAY_OK, MICROEJ_DECODE_webp_read(T_UI_WEBP_STREAM_read, &file, chunk, chunk_sizes[c], MICROUI_IMAGE_FORMAT_RGB565, &image, &is_fully_opaque));
+				LLUI_DISPLAY_freeImageBuffer(&image);
+				uint32_t used = file.heap_peak - heap_used;
+				used = (used > image_size) ? (used - image_size) : 0U;
+				decoder = (used > decoder) ? used : decoder;
+			}
+			uint32_t chunked_us = framerate_impl_cycles_to_us(framerate_impl_get_cycles() - t0) / T_UI_WEBP_STREAM_BENCHMARK_LOOPS;
+			printf("%-16s: %4u B chunks %5u us, chunk held %5u bytes, decoder heap %6u bytes (%u reads)\n", test->name, (unsigned int)chunk_sizes[c],
+					(unsigned int)chunked_us, (unsigned int)chunk_sizes[c], (unsigned int)decoder, (unsigned int)file.reads);
+		}
+	}
+	TEST_ASSERT_EQUAL_INT(allocated_blocks, MICROUI_HEAP_number_of_allocated_blocks());
+}
+
+TestRef T_UI_WEBP_STREAM_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixtures) {
+		new_TestFixture("Chunked reader", T_UI_WEBP_STREAM_chunks),
+		new_TestFixture("Partial progress", T_UI_WEBP_STREAM_progress),
+		new_TestFixture("Truncated and invalid data", T_UI_WEBP_STREAM_errors),
+		new_TestFixture("Benchmark", T_UI_WEBP_STREAM_benchmark),
+	};
+
+	EMB_UNIT_TESTCALLER(webpStreamTest, "WebP_stream_tests", T_UI_WEBP_STREAM_setUp, T_UI_WEBP_STREAM_tearDown, fixtures);
+
+	return (TestRef)&webpStreamTest;
+}
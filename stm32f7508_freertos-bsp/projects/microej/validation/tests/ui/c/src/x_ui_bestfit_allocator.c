@@ -0,0 +1,118 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "x_ui_bestfit_allocator.h"
+
+/*
+ * Host implementation of the best fit allocator (the BSP links the library of the
+ * platform). The heap layout is the one LLUI_DISPLAY_HEAP_impl.c relies on: a main header
+ * of 68 bytes, then blocks with a header and a footer word holding the block full size
+ * (bit 31 set when the block is used). The heap bounds are stored in the allocator
+ * (the heaps are below 4GB).
+ */
+
+#define X_UI_BESTFIT_HEADER_SIZE (68U)
+#define X_UI_BESTFIT_USED (0x80000000U)
+#define X_UI_BESTFIT_MIN_BLOCK (16U)
+#define X_UI_BESTFIT_WORD(p) (*(uint32_t*)(p))
+#define X_UI_BESTFIT_SIZE(p) (X_UI_BESTFIT_WORD(p) & 0x7ffffffU)
+#define X_UI_BESTFIT_START(env) ((uint8_t*)(uintptr_t)(uint32_t)(env)->_reserved0)
+#define X_UI_BESTFIT_LIMIT(env) ((uint8_t*)(uintptr_t)(uint32_t)(env)->_reserved1)
+
+static void set_block(uint8_t* block, uint32_t size, uint32_t used)
+{
+	X_UI_BESTFIT_WORD(block) = size | used;
+	X_UI_BESTFIT_WORD(block + size - sizeof(uint32_t)) = size | used;
+}
+
+void BESTFIT_ALLOCATOR_new(BESTFIT_ALLOCATOR* env)
+{
+	env->_reserved0 = 0;
+	env->_reserved1 = 0;
+}
+
+void BESTFIT_ALLOCATOR_initialize(BESTFIT_ALLOCATOR* env, int32_t startAddress, int32_t endAddress)
+{
+	env->_reserved0 = startAddress + (int32_t)X_UI_BESTFIT_HEADER_SIZE;
+	env->_reserved1 = endAddress;
+	set_block(X_UI_BESTFIT_START(env), (uint32_t)(endAddress - env->_reserved0) & ~3U, 0);
+}
+
+void* BESTFIT_ALLOCATOR_allocate(BESTFIT_ALLOCATOR* env, int32_t size)
+{
+	uint8_t* heap_start = X_UI_BESTFIT_START(env);
+	uint8_t* heap_limit = X_UI_BESTFIT_LIMIT(env);
+	uint32_t needed = (((uint32_t)size + 3U) & ~3U) + (2U * sizeof(uint32_t));
+	uint8_t* best = NULL;
+	uint32_t best_size = UINT32_MAX;
+
+	needed = (needed < X_UI_BESTFIT_MIN_BLOCK) ? X_UI_BESTFIT_MIN_BLOCK : needed;
+	for (uint8_t* block = heap_start; block < heap_limit; block += X_UI_BESTFIT_SIZE(block))
+	{
+		uint32_t block_size = X_UI_BESTFIT_SIZE(block);
+		if ((0U == (X_UI_BESTFIT_WORD(block) & X_UI_BESTFIT_USED)) && (block_size >= needed) && (block_size < best_size))
+		{
+			best = block;
+			best_size = block_size;
+		}
+	}
+
+	if (NULL != best)
+	{
+		if ((best_size - needed) >= X_UI_BESTFIT_MIN_BLOCK)
+		{
+			// split the free block
+			set_block(best + needed, best_size - needed, 0);
+		}
+		else
+		{
+			needed = best_size;
+		}
+		set_block(best, needed, X_UI_BESTFIT_USED);
+		best += sizeof(uint32_t);
+	}
+	return best;
+}
+
+void BESTFIT_ALLOCATOR_free(BESTFIT_ALLOCATOR* env, void* block)
+{
+	uint8_t* heap_start = X_UI_BESTFIT_START(env);
+	uint8_t* heap_limit = X_UI_BESTFIT_LIMIT(env);
+	uint8_t* header = (uint8_t*)block - sizeof(uint32_t);
+	uint32_t size = X_UI_BESTFIT_SIZE(header);
+	uint8_t* next = header + size;
+
+	// merge with the free neighbors
+	if ((next < heap_limit) && (0U == (X_UI_BESTFIT_WORD(next) & X_UI_BESTFIT_USED)))
+	{
+		size += X_UI_BESTFIT_SIZE(next);
+	}
+	if ((header > heap_start) && (0U == (X_UI_BESTFIT_WORD(header - sizeof(uint32_t)) & X_UI_BESTFIT_USED)))
+	{
+		uint32_t previous_size = X_UI_BESTFIT_SIZE(header - sizeof(uint32_t));
+		header -= previous_size;
+		size += previous_size;
+	}
+	set_block(header, size, 0);
+}
+
+uint32_t X_UI_BESTFIT_ALLOCATOR_free_blocks(BESTFIT_ALLOCATOR* env, uint32_t* largest)
+{
+	uint32_t number = 0;
+	*largest = 0;
+	for (uint8_t* block = X_UI_BESTFIT_START(env); block < X_UI_BESTFIT_LIMIT(env); block += X_UI_BESTFIT_SIZE(block))
+	{
+		uint32_t size = X_UI_BESTFIT_SIZE(block) - (2U * sizeof(uint32_t));
+		if (0U == (X_UI_BESTFIT_WORD(block) & X_UI_BESTFIT_USED))
+		{
+			number++;
+			*largest = (size > *largest) ? size : *largest;
+		}
+	}
+	return number;
+}
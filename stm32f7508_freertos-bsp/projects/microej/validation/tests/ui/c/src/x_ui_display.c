@@ -0,0 +1,317 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "x_ui_display.h"
+#include "x_ui_host.h"
+#include "stm32f7508_discovery_lcd.h"
+#include "LLUI_DISPLAY.h"
+#include "ui_drawing_dma2d.h"
+#include "display_line_scheduler.h"
+#include "framerate.h"
+
+/*
+ * Simulation of the LTDC, of the DMA2D restore copy and of the Graphics Engine around
+ * the display driver (LLUI_DISPLAY.c). The events (vertical blanking, end of the copy,
+ * end of the drawing of a frame) are processed in time order; the interrupts call the
+ * driver at once (they preempt the Graphics Engine).
+ */
+
+#define BUFFER_SIZE ((uint32_t)RK043FN48H_WIDTH * (uint32_t)RK043FN48H_HEIGHT * 2U)
+#define NO_EVENT UINT64_MAX
+
+LTDC_HandleTypeDef hLtdcHandler;
+
+static const X_UI_DISPLAY_driver_t* driver;
+static X_UI_DISPLAY_result_t* counters;
+
+// LTDC: address of the buffer scanned out and address given for the next reload
+static uint32_t ltdc_address;
+static uint32_t ltdc_shadow_address;
+static bool ltdc_reload;
+
+// DMA2D: configured and running restore copy
+static uint32_t dma2d_count;
+static DRAWING_DMA2D_memcpy* dma2d_list;
+static uint64_t dma2d_start;
+static uint64_t dma2d_end;
+static uint32_t dma2d_cycles;
+
+// Graphics Engine: buffer drawn, end of the drawing (NO_EVENT while waiting for the flush)
+// and end of the flush (LLUI_DISPLAY_flushDone() called)
+static uint8_t* engine_buffer;
+static uint64_t engine_end;
+static uint32_t engine_render_us;
+static bool engine_flush_done;
+
+static inline uint32_t _address(const uint8_t* buffer)
+{
+	// the LTDC registers hold 32 bits addresses
+	return (uint32_t)(uintptr_t)buffer;
+}
+
+/*
+ * Counts an error when the LTDC scans out the given address (the panel would show a
+ * partial frame).
+ */
+static void _check_scan_out(const uint8_t* address)
+{
+	if ((_address(address) - ltdc_address) < BUFFER_SIZE)
+	{
+		counters->errors++;
+	}
+}
+
+/*
+ * Checks the buffers written by the Graphics Engine and by the running restore copy.
+ */
+static void _check(void)
+{
+	if (NO_EVENT != engine_end)
+	{
+		_check_scan_out(engine_buffer);
+	}
+	if (NO_EVENT != dma2d_end)
+	{
+		for (uint32_t i = 0; i < dma2d_count; i++)
+		{
+			_check_scan_out(dma2d_list[i].dest_address);
+		}
+	}
+}
+
+/*
+ * Draws the next frame once the flush is done.
+ */
+static void _engine_draw(uint64_t now)
+{
+	if ((NO_EVENT == engine_end) && engine_flush_done)
+	{
+		engine_flush_done = false;
+		framerate_frame_drawing();
+		engine_end = now + engine_render_us;
+		_check();
+	}
+}
+
+static void _vsync(void)
+{
+	if (ltdc_reload)
+	{
+		ltdc_reload = false;
+		if (ltdc_address != ltdc_shadow_address)
+		{
+			counters->displayed++;
+		}
+		ltdc_address = ltdc_shadow_address;
+		driver->reload_callback(&hLtdcHandler);
+	}
+}
+
+/* LTDC and BSP ----------------------------------------------------------------*/
+
+uint8_t BSP_LCD_Init(void)
+{
+	return 0;
+}
+
+void BSP_LCD_LayerDefaultInit(uint16_t LayerIndex, uint32_t FB_Address)
+{
+	(void)LayerIndex;
+	ltdc_address = FB_Address;
+	ltdc_shadow_address = FB_Address;
+}
+
+HAL_StatusTypeDef HAL_LTDC_SetPixelFormat(LTDC_HandleTypeDef* hltdc, uint32_t Pixelformat, uint32_t LayerIdx)
+{
+	(void)hltdc;
+	(void)Pixelformat;
+	(void)LayerIdx;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_SetAddress(LTDC_HandleTypeDef* hltdc, uint32_t Address, uint32_t LayerIdx)
+{
+	(void)hltdc;
+	(void)LayerIdx;
+	// immediate reload (the reload interrupt is raised by the vertical blanking reloads only)
+	if (ltdc_address != Address)
+	{
+		counters->displayed++;
+	}
+	ltdc_address = Address;
+	ltdc_shadow_address = Address;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_SetAddress_NoReload(LTDC_HandleTypeDef* hltdc, uint32_t Address, uint32_t LayerIdx)
+{
+	(void)hltdc;
+	(void)LayerIdx;
+	ltdc_shadow_address = Address;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_Reload(LTDC_HandleTypeDef* hltdc, uint32_t ReloadType)
+{
+	(void)hltdc;
+	(void)ReloadType;
+	ltdc_reload = true;
+	return HAL_OK;
+}
+
+void HAL_LTDC_IRQHandler(LTDC_HandleTypeDef* hltdc)
+{
+	(void)hltdc;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	(void)IRQn;
+	(void)PreemptPriority;
+	(void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	(void)IRQn;
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	(void)IRQn;
+}
+
+/* DMA2D restore copy --------------------------------------------------------*/
+
+void UI_DRAWING_DMA2D_initialize(void* binary_semaphore_handle)
+{
+	(void)binary_semaphore_handle;
+}
+
+void UI_DRAWING_DMA2D_IRQHandler(void)
+{
+}
+
+void UI_DRAWING_DMA2D_prepare_memcpy(uint8_t* srcAddr, uint8_t* destAddr, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t stride, DRAWING_DMA2D_memcpy* memcpy_data)
+{
+	uint32_t offset = ((ymin * stride) + xmin) * 2U;
+	memcpy_data->src_address = srcAddr + offset;
+	memcpy_data->dest_address = destAddr + offset;
+	memcpy_data->width = (uint16_t)(xmax - xmin + 1U);
+	memcpy_data->height = (uint16_t)(ymax - ymin + 1U);
+	memcpy_data->offset = (uint16_t)(stride - memcpy_data->width);
+}
+
+void UI_DRAWING_DMA2D_configure_memcpy_list(DRAWING_DMA2D_memcpy* memcpy_data, uint32_t count)
+{
+	(void)memcpy_data;
+	dma2d_count = count;
+}
+
+void UI_DRAWING_DMA2D_start_memcpy(DRAWING_DMA2D_memcpy* memcpy_data)
+{
+	uint32_t bytes = 0;
+	for (uint32_t i = 0; i < dma2d_count; i++)
+	{
+		bytes += (uint32_t)memcpy_data[i].width * (uint32_t)memcpy_data[i].height * 2U;
+	}
+	dma2d_list = memcpy_data;
+	dma2d_start = X_UI_HOST_get_time();
+	dma2d_end = dma2d_start + (bytes / X_UI_DISPLAY_COPY_BYTES_PER_US);
+	_check();
+}
+
+void UI_DRAWING_DMA2D_get_statistics(DRAWING_DMA2D_statistics_t* statistics)
+{
+	(void)memset(statistics, 0, sizeof(DRAWING_DMA2D_statistics_t));
+	statistics->memcpy_cycles = dma2d_cycles;
+}
+
+/* Graphics Engine -----------------------------------------------------------*/
+
+void LLUI_DISPLAY_flushDone(bool from_isr)
+{
+	(void)from_isr;
+	engine_flush_done = true;
+}
+
+bool DISPLAY_LINE_SCHEDULER_is_front_buffer_drawing(void)
+{
+	return false;
+}
+
+void DISPLAY_LINE_SCHEDULER_line_event(void)
+{
+}
+
+/* API -----------------------------------------------------------------------*/
+
+void X_UI_DISPLAY_run(const X_UI_DISPLAY_driver_t* d, uint32_t render_us, uint32_t xmin, uint32_t ymin, uint32_t xmax, uint32_t ymax, uint32_t duration_us, X_UI_DISPLAY_result_t* result)
+{
+	LLUI_DISPLAY_SInitData init_data;
+	MICROUI_GraphicsContext gc;
+	uint64_t now = 0;
+	uint64_t vsync = X_UI_DISPLAY_REFRESH_US;
+
+	(void)memset(result, 0, sizeof(X_UI_DISPLAY_result_t));
+	(void)memset(&gc, 0, sizeof(gc));
+	driver = d;
+	counters = result;
+	ltdc_reload = false;
+	dma2d_count = 0;
+	dma2d_end = NO_EVENT;
+	dma2d_cycles = 0;
+	engine_end = NO_EVENT;
+	engine_render_us = render_us;
+	X_UI_HOST_set_time(now);
+
+	driver->initialize(&init_data);
+	engine_buffer = init_data.back_buffer_address;
+	engine_flush_done = true;
+	_engine_draw(now);
+
+	// the simulation stops while the engine draws: the driver does not wait for an event
+	// (the next simulation starts from this state)
+	while ((now < duration_us) || (NO_EVENT == engine_end))
+	{
+		uint64_t next = vsync;
+		next = (dma2d_end < next) ? dma2d_end : next;
+		next = (engine_end < next) ? engine_end : next;
+		now = next;
+		X_UI_HOST_set_time(now);
+
+		if (dma2d_end <= now)
+		{
+			// end of the restore copy: the DMA2D interrupt notifies the Graphics Engine
+			dma2d_end = NO_EVENT;
+			dma2d_cycles = (uint32_t)(now - dma2d_start) * 1000U;
+			LLUI_DISPLAY_flushDone(true);
+		}
+
+		while (vsync <= now)
+		{
+			vsync += X_UI_DISPLAY_REFRESH_US;
+			_vsync();
+			_check();
+		}
+
+		if (engine_end == now)
+		{
+			// end of the drawing: the Graphics Engine flushes the frame (the pacing may sleep)
+			engine_end = NO_EVENT;
+			result->flushes++;
+			engine_buffer = driver->flush(&gc, engine_buffer, xmin, ymin, xmax, ymax);
+			now = X_UI_HOST_get_time();
+		}
+
+		_engine_draw(now);
+	}
+
+	X_UI_HOST_release_time();
+}
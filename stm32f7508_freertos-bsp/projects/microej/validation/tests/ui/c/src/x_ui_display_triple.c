@@ -0,0 +1,39 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/*
+ * The display driver built with the triple buffering (see x_ui_display.h). The
+ * functions of the driver are renamed: the double buffering build is linked too.
+ */
+#include "x_ui_display.h"
+#ifndef DRAWING_DMA2D_BPP
+#define DRAWING_DMA2D_BPP 16
+#endif
+#include "LLDISPLAY_configuration.h"
+#ifndef LLDISPLAY_TRIPLE_BUFFERING
+#define LLDISPLAY_TRIPLE_BUFFERING
+#endif
+#define display_mem x_ui_display_triple_mem
+#define DMA2D_IRQHandler X_UI_DISPLAY_TRIPLE_DMA2D_IRQHandler
+#define LTDC_IRQHandler X_UI_DISPLAY_TRIPLE_LTDC_IRQHandler
+#define LTDC_ER_IRQHandler X_UI_DISPLAY_TRIPLE_LTDC_ER_IRQHandler
+#define HAL_LTDC_ErrorCallback X_UI_DISPLAY_TRIPLE_ErrorCallback
+#define HAL_LTDC_LineEventCallback X_UI_DISPLAY_TRIPLE_LineEventCallback
+#define HAL_LTDC_ReloadEventCallback X_UI_DISPLAY_TRIPLE_ReloadEventCallback
+#define LLUI_DISPLAY_IMPL_initialize X_UI_DISPLAY_TRIPLE_initialize
+#define LLUI_DISPLAY_IMPL_binarySemaphoreTake X_UI_DISPLAY_TRIPLE_binarySemaphoreTake
+#define LLUI_DISPLAY_IMPL_binarySemaphoreGive X_UI_DISPLAY_TRIPLE_binarySemaphoreGive
+#define LLUI_DISPLAY_IMPL_flush X_UI_DISPLAY_TRIPLE_flush
+#define LLUI_DISPLAY_IMPL_decodeImage X_UI_DISPLAY_TRIPLE_decodeImage
+#include "../../../../../ui/src/LLUI_DISPLAY.c"
+
+const X_UI_DISPLAY_driver_t X_UI_DISPLAY_triple_buffering = {
+	"triple buffering",
+	X_UI_DISPLAY_TRIPLE_initialize,
+	X_UI_DISPLAY_TRIPLE_flush,
+	X_UI_DISPLAY_TRIPLE_ReloadEventCallback,
+};
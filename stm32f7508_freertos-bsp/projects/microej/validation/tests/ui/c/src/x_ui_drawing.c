@@ -0,0 +1,165 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include "LLUI_DISPLAY.h"
+#include "ui_drawing_soft.h"
+#include "ui_drawing_dma2d.h"
+#include "x_ui_drawing.h"
+
+/*
+ * Host implementation of the software drawer of the filled shapes, of the DMA2D tiles and
+ * of the Graphics Engine clip functions. The graphics contexts are RGB565 images
+ * allocated by LLUI_DISPLAY_allocateImageBuffer(). A pixel is drawn when its center is
+ * inside the shape.
+ */
+
+static uint32_t inset;
+static uint32_t filled_tiles;
+static bool clip_enabled = true;
+
+static void set_pixel(MICROUI_GraphicsContext* gc, jint x, jint y)
+{
+	if (!clip_enabled || ((x >= gc->clip_x1) && (x <= gc->clip_x2) && (y >= gc->clip_y1) && (y <= gc->clip_y2)))
+	{
+		uint32_t color = (uint32_t)gc->foreground_color;
+		uint16_t* line = (uint16_t*)(LLUI_DISPLAY_getBufferAddress(&gc->image) + ((uint32_t)y * LLUI_DISPLAY_getStrideInBytes(&gc->image)));
+		line[x] = (uint16_t)(((color >> 8) & 0xf800U) | ((color >> 5) & 0x07e0U) | ((color >> 3) & 0x001fU));
+	}
+}
+
+/*
+ * Tells whether the center of a pixel is inside the ellipse inscribed in a box.
+ */
+static bool is_inside(jint px, jint py, jint x, jint y, jint width, jint height)
+{
+	int64_t w = (int64_t)width - inset;
+	int64_t h = (int64_t)height - inset;
+	int64_t dx = ((2 * (int64_t)(px - x)) + 1) - width;
+	int64_t dy = ((2 * (int64_t)(py - y)) + 1) - height;
+	return (w > 0) && (h > 0) && (((dx * dx * h * h) + (dy * dy * w * w)) <= (w * w * h * h));
+}
+
+/*
+ * Gets the box of the corner ellipse of a pixel on an axis.
+ *
+ * @return false when the pixel is between the corners.
+ */
+static bool get_corner(jint p, jint origin, jint size, jint corner, jint* corner_origin)
+{
+	bool ret = true;
+	if (p < (origin + (corner / 2)))
+	{
+		*corner_origin = origin;
+	}
+	else if (p >= ((origin + size) - (corner / 2)))
+	{
+		*corner_origin = (origin + size) - corner;
+	}
+	else
+	{
+		ret = false;
+	}
+	return ret;
+}
+
+DRAWING_Status UI_DRAWING_SOFT_fillRoundedRectangle(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height, jint cornerEllipseWidth, jint cornerEllipseHeight)
+{
+	jint corner_width = (cornerEllipseWidth < width) ? cornerEllipseWidth : width;
+	jint corner_height = (cornerEllipseHeight < height) ? cornerEllipseHeight : height;
+	for (jint py = y; py < (y + height); py++)
+	{
+		for (jint px = x; px < (x + width); px++)
+		{
+			jint cx;
+			jint cy;
+			if ((corner_width <= 0) || (corner_height <= 0)
+					|| !get_corner(px, x, width, corner_width, &cx) || !get_corner(py, y, height, corner_height, &cy)
+					|| is_inside(px, py, cx, cy, corner_width, corner_height))
+			{
+				set_pixel(gc, px, py);
+			}
+		}
+	}
+	return DRAWING_DONE;
+}
+
+DRAWING_Status UI_DRAWING_SOFT_fillEllipse(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height)
+{
+	for (jint py = y; py < (y + height); py++)
+	{
+		for (jint px = x; px < (x + width); px++)
+		{
+			if (is_inside(px, py, x, y, width, height))
+			{
+				set_pixel(gc, px, py);
+			}
+		}
+	}
+	return DRAWING_DONE;
+}
+
+DRAWING_Status UI_DRAWING_SOFT_fillCircle(MICROUI_GraphicsContext* gc, jint x, jint y, jint diameter)
+{
+	return UI_DRAWING_SOFT_fillEllipse(gc, x, y, diameter, diameter);
+}
+
+void UI_DRAWING_DMA2D_start_tiles(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2)
+{
+	(void)gc;
+	(void)x1;
+	(void)y1;
+	(void)x2;
+	(void)y2;
+}
+
+uint32_t UI_DRAWING_DMA2D_fill_tile(MICROUI_GraphicsContext* gc, jint x1, jint y1, jint x2, jint y2, bool last)
+{
+	(void)last;
+	// the DMA2D does not clip
+	bool enabled = clip_enabled;
+	clip_enabled = false;
+	for (jint py = y1; py <= y2; py++)
+	{
+		for (jint px = x1; px <= x2; px++)
+		{
+			set_pixel(gc, px, py);
+		}
+	}
+	clip_enabled = enabled;
+	filled_tiles++;
+	return filled_tiles;
+}
+
+void LLUI_DISPLAY_setClip(MICROUI_GraphicsContext* gc, jint x, jint y, jint width, jint height)
+{
+	gc->clip_x1 = (jshort)x;
+	gc->clip_y1 = (jshort)y;
+	gc->clip_x2 = (jshort)((x + width) - 1);
+	gc->clip_y2 = (jshort)((y + height) - 1);
+	gc->drawing_log_flags |= DRAWING_LOG_CLIP_MODIFIED;
+}
+
+void LLUI_DISPLAY_configureClip(MICROUI_GraphicsContext* gc, bool enable)
+{
+	(void)gc;
+	clip_enabled = enable;
+}
+
+bool LLUI_DISPLAY_isClipEnabled(MICROUI_GraphicsContext* gc)
+{
+	(void)gc;
+	return clip_enabled;
+}
+
+void X_UI_DRAWING_set_inset(uint32_t value)
+{
+	inset = value;
+}
+
+uint32_t X_UI_DRAWING_get_filled_tiles(void)
+{
+	return filled_tiles;
+}
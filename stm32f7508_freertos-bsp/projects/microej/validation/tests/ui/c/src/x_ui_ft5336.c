@@ -0,0 +1,77 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <string.h>
+#include "x_ui_ft5336.h"
+
+/*
+ * Register map of the FT5336 in working mode: DEV_MODE, GEST_ID, TD_STATUS then six
+ * registers per touch point (Pn_XH, Pn_XL, Pn_YH, Pn_YL, Pn_WEIGHT, Pn_MISC). The
+ * controller X axis is the display Y axis.
+ */
+
+#define REG_TD_STATUS 0x02U
+#define REG_P1 0x03U
+#define POINT_REGS 6U
+#define MAX_POINTS 5U
+
+// event flag of Pn_XH (bits 7-6)
+#define EVENT_PUT_DOWN 0U
+#define EVENT_PUT_UP 1U
+#define EVENT_CONTACT 2U
+
+static uint8_t regs[X_UI_FT5336_REGS];
+static uint32_t pressed;
+
+void X_UI_FT5336_reset(void)
+{
+	(void)memset(regs, 0, sizeof(regs));
+	pressed = 0;
+}
+
+void X_UI_FT5336_sample(const TOUCH_GESTURE_point_t* points, uint32_t count)
+{
+	if (0U == count)
+	{
+		// the registers of the released points are kept, only their event flag changes
+		for (uint32_t i = 0; i < pressed; i++)
+		{
+			uint8_t* point = &regs[REG_P1 + (i * POINT_REGS)];
+			point[0] = (uint8_t)((EVENT_PUT_UP << 6) | (point[0] & 0x0fU));
+		}
+		regs[REG_TD_STATUS] = (uint8_t)pressed;
+	}
+	else
+	{
+		for (uint32_t i = 0; (i < count) && (i < MAX_POINTS); i++)
+		{
+			uint8_t* point = &regs[REG_P1 + (i * POINT_REGS)];
+			uint32_t event = (i < pressed) ? EVENT_CONTACT : EVENT_PUT_DOWN;
+			point[0] = (uint8_t)((event << 6) | ((uint32_t)points[i].y >> 8));
+			point[1] = (uint8_t)points[i].y;
+			point[2] = (uint8_t)((i << 4) | ((uint32_t)points[i].x >> 8));
+			point[3] = (uint8_t)points[i].x;
+			point[4] = 0x40U;
+			point[5] = 0x10U;
+		}
+		regs[REG_TD_STATUS] = (uint8_t)count;
+	}
+	pressed = count;
+}
+
+void X_UI_FT5336_write(uint8_t reg, uint8_t value)
+{
+	regs[reg] = value;
+}
+
+void X_UI_FT5336_read(uint8_t first, uint8_t* data, uint32_t size)
+{
+	for (uint32_t i = 0; i < size; i++)
+	{
+		uint32_t reg = (uint32_t)first + i;
+		data[i] = (reg < X_UI_FT5336_REGS) ? regs[reg] : 0U;
+	}
+}
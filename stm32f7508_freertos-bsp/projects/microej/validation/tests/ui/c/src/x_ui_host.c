@@ -0,0 +1,279 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "t_ui_main.h"
+#include "x_ui_host.h"
+#include "LLUI_DISPLAY.h"
+#include "LLUI_DISPLAY_impl.h"
+#include "ui_drawing_dma2d.h"
+#include "framerate_impl.h"
+#include "microej_time.h"
+#include "microui_heap_conf.h"
+
+/*
+ * Host entry point and stubs of the Graphics Engine and BSP functions called by the
+ * tested modules. The image buffers are allocated in the images heap
+ * (LLUI_DISPLAY_HEAP_impl.c) like on the target.
+ */
+
+#define X_UI_HOST_IMAGES 64
+
+static uint32_t image_header;
+
+/*
+ * The time of the cycles counter when it is driven by a simulation (see X_UI_HOST_set_time()).
+ */
+static bool simulated_time;
+static uint64_t simulated_us;
+
+/*
+ * The fonts registered in the glyph atlas (the atlases are drawn by the DMA2D).
+ */
+static const UI_GLYPH_ATLAS_font_t* fonts[UI_GLYPH_ATLAS_FONTS];
+
+/*
+ * The image buffers allocated by the decoders (one per MICROUI_Image).
+ */
+static struct
+{
+	MICROUI_Image* image;
+	uint8_t* block;
+} images[X_UI_HOST_IMAGES];
+
+static uint32_t get_bpp(jbyte format)
+{
+	uint32_t bpp;
+	switch ((uint8_t)format)
+	{
+	case MICROUI_IMAGE_FORMAT_ARGB8888:
+		bpp = 32;
+		break;
+	case MICROUI_IMAGE_FORMAT_RGB888:
+		bpp = 24;
+		break;
+	case MICROUI_IMAGE_FORMAT_A8:
+		bpp = 8;
+		break;
+	case MICROUI_IMAGE_FORMAT_A4:
+		bpp = 4;
+		break;
+	default:
+		bpp = 16;
+		break;
+	}
+	return bpp;
+}
+
+uint8_t* X_UI_HOST_map(uint32_t size)
+{
+	void* area = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+	return (MAP_FAILED == area) ? NULL : (uint8_t*)area;
+}
+
+uint8_t* X_UI_HOST_map_resources(uint32_t size)
+{
+	static uint8_t* resources;
+	if (NULL == resources)
+	{
+		void* address = (void*)(uintptr_t)MICROUI_HEAP_CACHE_RESOURCES_START;
+		void* area = mmap(address, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+		resources = (address == area) ? (uint8_t*)area : NULL;
+	}
+	return resources;
+}
+
+void X_UI_HOST_flush_heap(void)
+{
+	// the allocation fails once all the closed images have been evicted
+	(void)LLUI_DISPLAY_IMPL_image_heap_allocate(2U * X_UI_HOST_HEAP_SIZE);
+}
+
+void X_UI_HOST_set_image_header(uint32_t size)
+{
+	image_header = size;
+}
+
+bool LLUI_DISPLAY_allocateImageBuffer(MICROUI_Image* img, uint8_t rowAlignmentInBytes)
+{
+	(void)rowAlignmentInBytes;
+	for (uint32_t i = 0; i < X_UI_HOST_IMAGES; i++)
+	{
+		if (NULL == images[i].image)
+		{
+			images[i].block = LLUI_DISPLAY_IMPL_image_heap_allocate(image_header + (LLUI_DISPLAY_getStrideInBytes(img) * img->height));
+			if (NULL != images[i].block)
+			{
+				images[i].image = img;
+			}
+			return NULL != images[i].block;
+		}
+	}
+	return false;
+}
+
+void LLUI_DISPLAY_freeImageBuffer(MICROUI_Image* img)
+{
+	for (uint32_t i = 0; i < X_UI_HOST_IMAGES; i++)
+	{
+		if (img == images[i].image)
+		{
+			LLUI_DISPLAY_IMPL_image_heap_free(images[i].block);
+			images[i].image = NULL;
+			images[i].block = NULL;
+		}
+	}
+}
+
+uint8_t* LLUI_DISPLAY_getBufferAddress(MICROUI_Image* image)
+{
+	for (uint32_t i = 0; i < X_UI_HOST_IMAGES; i++)
+	{
+		if (image == images[i].image)
+		{
+			return images[i].block + image_header;
+		}
+	}
+	return NULL;
+}
+
+uint32_t LLUI_DISPLAY_getStrideInBytes(MICROUI_Image* image)
+{
+	return (((uint32_t)image->width * get_bpp(image->format)) + 7U) / 8U;
+}
+
+uint32_t LLUI_DISPLAY_getStrideInPixels(MICROUI_Image* image)
+{
+	return image->width;
+}
+
+bool LLUI_DISPLAY_isLCD(MICROUI_Image* image)
+{
+	(void)image;
+	return true;
+}
+
+void UI_DRAWING_DMA2D_move(uint8_t* dest, uint8_t* src, uint32_t size)
+{
+	(void)memcpy(dest, src, size);
+}
+
+void X_UI_HOST_set_time(uint64_t us)
+{
+	simulated_time = true;
+	simulated_us = us;
+}
+
+uint64_t X_UI_HOST_get_time(void)
+{
+	return simulated_us;
+}
+
+void X_UI_HOST_release_time(void)
+{
+	simulated_time = false;
+}
+
+uint32_t framerate_impl_get_cycles(void)
+{
+	// one cycle per nanosecond
+	uint64_t ns;
+	if (simulated_time)
+	{
+		ns = simulated_us * 1000U;
+	}
+	else
+	{
+		struct timespec now;
+		(void)clock_gettime(CLOCK_MONOTONIC, &now);
+		ns = ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+	}
+	return (uint32_t)ns;
+}
+
+uint32_t framerate_impl_cycles_to_us(uint32_t cycles)
+{
+	return cycles / 1000U;
+}
+
+int32_t framerate_impl_start_task(void)
+{
+	// framerate_get() is not updated: the simulations count their frames
+	return FRAMERATE_OK;
+}
+
+void framerate_impl_sleep(uint32_t ms)
+{
+	if (simulated_time)
+	{
+		simulated_us += (uint64_t)ms * 1000U;
+	}
+	else
+	{
+		struct timespec delay = { (time_t)(ms / 1000U), (long)(ms % 1000U) * 1000000L };
+		(void)nanosleep(&delay, NULL);
+	}
+}
+
+int64_t microej_time_get_time_nanos(void)
+{
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((int64_t)now.tv_sec * 1000000000) + (int64_t)now.tv_nsec;
+}
+
+bool LLUI_DISPLAY_isClosed(MICROUI_Image* image)
+{
+	(void)image;
+	return false;
+}
+
+uint32_t LLUI_DISPLAY_getLUTSize(MICROUI_Image* image)
+{
+	(void)image;
+	return 0;
+}
+
+int32_t UI_GLYPH_ATLAS_register_font(const UI_GLYPH_ATLAS_font_t* font)
+{
+	for (int32_t i = 0; i < (int32_t)UI_GLYPH_ATLAS_FONTS; i++)
+	{
+		if (NULL == fonts[i])
+		{
+			fonts[i] = font;
+			return i;
+		}
+	}
+	return -1;
+}
+
+void UI_GLYPH_ATLAS_unregister_font(int32_t font)
+{
+	fonts[font] = NULL;
+}
+
+const UI_GLYPH_ATLAS_font_t* X_UI_HOST_get_font(int32_t font)
+{
+	return ((font >= 0) && (font < (int32_t)UI_GLYPH_ATLAS_FONTS)) ? fonts[font] : NULL;
+}
+
+int main(void)
+{
+	uint8_t* heap = X_UI_HOST_map(X_UI_HOST_HEAP_SIZE);
+	if (NULL == heap)
+	{
+		printf("cannot map the images heap\n");
+		return 1;
+	}
+	LLUI_DISPLAY_IMPL_image_heap_initialize(heap, heap + X_UI_HOST_HEAP_SIZE);
+
+	T_UI_main();
+	return 0;
+}
@@ -0,0 +1,446 @@
+/*
+ * C
+ *
+ * Copyright 2024 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <stdint.h>
+#include "x_ui_webp_images.h"
+
+/*
+ * WebP images of X_UI_WEBP_WIDTH x X_UI_WEBP_HEIGHT pixels filled with X_UI_WEBP_pixel()
+ * (encoded with libwebp 1.x, lossless images encoded with the "exact" option).
+ */
+
+static const uint8_t lossless_opaque[] = {
+	0x52, 0x49, 0x46, 0x46, 0x66, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x4c,
+	0x59, 0x00, 0x00, 0x00, 0x2f, 0x10, 0x00, 0x02, 0x00, 0xb9, 0x32, 0x44, 0xf4, 0x3f, 0x76, 0xc5,
+	0x8f, 0xe8, 0x7f, 0x40, 0x41, 0xdb, 0x36, 0x8c, 0x81, 0x94, 0x3f, 0xd2, 0x5d, 0x06, 0xf3, 0xc0,
+	0xc4, 0xb6, 0x6d, 0x25, 0xbf, 0xed, 0xf6, 0x91, 0x66, 0x4d, 0x33, 0x33, 0xf9, 0x8d, 0x46, 0xd6,
+	0x4c, 0xb3, 0xa1, 0xc7, 0x04, 0x10, 0x0c, 0xeb, 0x80, 0xf5, 0x17, 0xe5, 0x82, 0x0a, 0xe0, 0x1a,
+	0x51, 0x81, 0x15, 0x00, 0x88, 0x1d, 0x13, 0x09, 0x00, 0xe8, 0xc0, 0xdd, 0x30, 0xb1, 0x00, 0xa0,
+	0x05, 0x0f, 0x40, 0x51, 0x50, 0x91, 0x00, 0x30, 0xb3, 0x01, 0x14, 0xe0, 0x07, 0x00,
+};
+
+static const uint8_t lossless_alpha[] = {
+	0x52, 0x49, 0x46, 0x46, 0x7c, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x4c,
+	0x70, 0x00, 0x00, 0x00, 0x2f, 0x10, 0x00, 0x02, 0x10, 0xb9, 0x32, 0x44, 0xf4, 0x3f, 0x76, 0xc5,
+	0x8f, 0xe8, 0x7f, 0x28, 0x10, 0xb4, 0x6d, 0x1b, 0x03, 0x39, 0x7f, 0xa4, 0xdb, 0x4f, 0xe1, 0x52,
+	0xe6, 0x81, 0x85, 0x24, 0xdb, 0xae, 0xae, 0x8d, 0xbd, 0x64, 0xc9, 0x22, 0xbf, 0x9d, 0x3c, 0xfb,
+	0xf6, 0x39, 0xf2, 0xb7, 0xb4, 0x74, 0x33, 0x6d, 0xdb, 0xc6, 0xdc, 0x6f, 0x67, 0x28, 0x6d, 0x02,
+	0xbe, 0xa2, 0x94, 0x57, 0xba, 0x3e, 0x00, 0x0a, 0xae, 0xeb, 0x27, 0x18, 0xf4, 0x80, 0x53, 0xdd,
+	0xe0, 0x81, 0xb8, 0xc0, 0xa0, 0x0b, 0x3c, 0xc0, 0xaa, 0x0a, 0x65, 0xa3, 0x63, 0xaa, 0x22, 0x0f,
+	0xe2, 0xb6, 0xd0, 0xb1, 0xa8, 0x48, 0xe2, 0x01, 0xc2, 0x1a, 0xf0, 0x98, 0x40, 0x31, 0xb0, 0x81,
+	0x41, 0x1f, 0xf0, 0x03,
+};
+
+static const uint8_t lossy_opaque[] = {
+	0x52, 0x49, 0x46, 0x46, 0xa6, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x20,
+	0x9a, 0x00, 0x00, 0x00, 0xb0, 0x04, 0x00, 0x9d, 0x01, 0x2a, 0x11, 0x00, 0x09, 0x00, 0x3e, 0x6d,
+	0x2c, 0x92, 0x45, 0xa4, 0x22, 0xa1, 0x98, 0x04, 0x00, 0x40, 0x06, 0xc4, 0xb6, 0x00, 0x4e, 0x99,
+	0x42, 0x38, 0x1b, 0xc8, 0x19, 0x5c, 0x77, 0x70, 0x00, 0x60, 0x53, 0x61, 0x49, 0x97, 0xac, 0x57,
+	0x67, 0x00, 0x00, 0xfe, 0xfc, 0x6b, 0xcd, 0x35, 0xbe, 0x6e, 0xfa, 0xfa, 0x2c, 0x81, 0xfe, 0x0f,
+	0x71, 0x29, 0x87, 0xd1, 0x32, 0x67, 0xd9, 0xf6, 0x70, 0x0f, 0x74, 0x01, 0xe7, 0xf9, 0x38, 0xf1,
+	0x33, 0xe1, 0x4f, 0x6f, 0xdc, 0x54, 0x17, 0xf3, 0x8c, 0x03, 0xb7, 0x52, 0x73, 0x3f, 0x86, 0xe4,
+	0x09, 0x7d, 0xb5, 0xd4, 0xff, 0x9f, 0xff, 0x26, 0xfc, 0x5f, 0xc6, 0x47, 0xf2, 0xa1, 0xfd, 0xee,
+	0x36, 0x2c, 0x50, 0x7a, 0xd6, 0x6e, 0xfc, 0xfc, 0x46, 0x52, 0xb3, 0x3a, 0x00, 0xa4, 0xfb, 0x0c,
+	0x69, 0xbc, 0xfc, 0xfe, 0x82, 0x88, 0xf1, 0x3f, 0xe5, 0x17, 0xcf, 0xbb, 0x6f, 0xf9, 0x46, 0x25,
+	0xfb, 0xf1, 0x7e, 0x7f, 0xd8, 0x00, 0xdf, 0xea, 0x2f, 0x9a, 0xc1, 0x80, 0x00, 0x00,
+};
+
+static const uint8_t lossy_alpha[] = {
+	0x52, 0x49, 0x46, 0x46, 0xea, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x58,
+	0x0a, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x08, 0x00, 0x00, 0x41, 0x4c,
+	0x50, 0x48, 0x26, 0x00, 0x00, 0x00, 0x09, 0x27, 0x40, 0x98, 0x6d, 0xb4, 0xe7, 0x86, 0x73, 0xfe,
+	0x70, 0xa7, 0x11, 0x11, 0xc1, 0x73, 0x30, 0x90, 0xb6, 0xcd, 0xf6, 0x3b, 0xa9, 0x85, 0xde, 0xbf,
+	0xc1, 0x1b, 0x88, 0xe8, 0x7f, 0x34, 0xa7, 0xea, 0x26, 0x00, 0x30, 0xef, 0x56, 0x50, 0x38, 0x20,
+	0x9e, 0x00, 0x00, 0x00, 0x50, 0x04, 0x00, 0x9d, 0x01, 0x2a, 0x11, 0x00, 0x09, 0x00, 0x3e, 0x6d,
+	0x2c, 0x92, 0x45, 0xa4, 0x22, 0xa1, 0x98, 0x04, 0x00, 0x40, 0x06, 0xc4, 0xb6, 0x00, 0x4e, 0x99,
+	0x42, 0x38, 0x0a, 0xfe, 0x30, 0x1e, 0x41, 0x55, 0x76, 0x1a, 0x8a, 0x6c, 0xb2, 0x5c, 0x80, 0x00,
+	0xfe, 0xfc, 0x6b, 0xcd, 0x35, 0xbe, 0x6e, 0xfa, 0xfa, 0x2c, 0x81, 0xfe, 0x0f, 0x71, 0x29, 0x87,
+	0xd1, 0x32, 0x61, 0x74, 0x4f, 0x86, 0xd0, 0xbb, 0x2e, 0x5c, 0x73, 0xc3, 0xb9, 0xee, 0x98, 0x08,
+	0xe8, 0xaf, 0xac, 0x9f, 0x8a, 0x98, 0xfa, 0xef, 0xd8, 0xc0, 0x3b, 0x76, 0x31, 0xc7, 0xcd, 0xc3,
+	0x9d, 0xaa, 0x39, 0x9d, 0x40, 0xff, 0x3f, 0xfe, 0x4d, 0xf6, 0xfe, 0xa5, 0x5f, 0xa1, 0x3f, 0xef,
+	0x71, 0xb1, 0x76, 0xa8, 0x3d, 0x6b, 0x53, 0xff, 0xcf, 0xc4, 0x65, 0x2b, 0x33, 0xa1, 0x05, 0x17,
+	0xe4, 0xd8, 0x3e, 0x79, 0x01, 0xc6, 0x8d, 0xca, 0xeb, 0x21, 0x65, 0xe9, 0x7d, 0xfc, 0x1c, 0x06,
+	0x79, 0x5f, 0x92, 0xa1, 0xe5, 0x47, 0xf3, 0x60, 0xfa, 0xa9, 0x20, 0xd5, 0x38, 0xab, 0x6e, 0x68,
+	0x40, 0x00,
+};
+
+/*
+ * WebP images of X_UI_WEBP_SCREEN_WIDTH x X_UI_WEBP_SCREEN_HEIGHT pixels (the display
+ * size): opaque sine waves r = 128 + 127 sin(x / 23), g = 128 + 127 sin(y / 17) and
+ * b = 128 + 127 sin((x + y) / 31).
+ */
+
+static const uint8_t screen_lossless[] = {
+	0x52, 0x49, 0x46, 0x46, 0xe6, 0x05, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x4c,
+	0xda, 0x05, 0x00, 0x00, 0x2f, 0xdf, 0xc1, 0x43, 0x00, 0x09, 0x21, 0x09, 0x02, 0x66, 0xff, 0x2f,
+	0xf6, 0x82, 0x10, 0xd1, 0xff, 0x24, 0x0e, 0x7f, 0xe1, 0x44, 0x92, 0x24, 0xd5, 0xca, 0xc7, 0xa0,
+	0xbe, 0x7a, 0xf1, 0xef, 0x7f, 0xb2, 0x27, 0xbf, 0x62, 0x06, 0xf7, 0x64, 0x7f, 0xb0, 0x6e, 0x23,
+	0x49, 0x52, 0xa4, 0x3c, 0xe6, 0xbb, 0x8d, 0x97, 0xde, 0x7f, 0xab, 0x5e, 0x5c, 0xe9, 0x99, 0x99,
+	0x84, 0xe8, 0xff, 0x04, 0x00, 0xef, 0xf7, 0xfd, 0x7f, 0x9e, 0x23, 0xd7, 0x0b, 0x66, 0x00, 0xd6,
+	0xee, 0xfe, 0xa8, 0x05, 0x96, 0x96, 0xf6, 0xf6, 0xf6, 0x20, 0x5a, 0x5b, 0xdb, 0xdb, 0xdb, 0x8b,
+	0x16, 0xce, 0x02, 0xb8, 0xba, 0x5a, 0xb3, 0x14, 0xd4, 0xf8, 0xbb, 0x8b, 0x30, 0xe1, 0x17, 0xdf,
+	0x8b, 0xba, 0x8b, 0xca, 0xae, 0x45, 0x8d, 0xa2, 0xd6, 0xa2, 0xb2, 0x37, 0xa2, 0xb6, 0xa2, 0xf6,
+	0x7e, 0xb2, 0x59, 0x54, 0x2f, 0x2a, 0xfb, 0x29, 0xea, 0x2a, 0x6a, 0x2f, 0x6a, 0x16, 0xf5, 0xbd,
+	0x27, 0x51, 0x2b, 0x7f, 0x57, 0x76, 0x2d, 0xaa, 0xf7, 0xb5, 0x9c, 0x61, 0xb4, 0x6d, 0x9b, 0xf8,
+	0xff, 0xb3, 0x07, 0x8b, 0x27, 0x45, 0xc4, 0x04, 0x90, 0x92, 0x22, 0x54, 0x44, 0x15, 0xe9, 0x12,
+	0x55, 0x04, 0x85, 0x54, 0x56, 0xb3, 0xfc, 0x44, 0x49, 0x88, 0x24, 0xc9, 0x91, 0x24, 0xe7, 0xcf,
+	0xfa, 0x47, 0xec, 0x1f, 0x84, 0x68, 0x31, 0x33, 0x0c, 0xdb, 0xb6, 0x8d, 0xc4, 0x7e, 0xb7, 0xff,
+	0xbc, 0xf1, 0x21, 0x51, 0xd8, 0xb6, 0x6d, 0x23, 0xa5, 0xed, 0xff, 0x0f, 0x0f, 0x85, 0x03, 0xb7,
+	0x6d, 0x1c, 0x09, 0xde, 0xde, 0x8e, 0xe7, 0xfc, 0xc2, 0x91, 0x64, 0xdb, 0x4e, 0x72, 0xc9, 0x2e,
+	0xdb, 0x65, 0x63, 0x00, 0xab, 0xb2, 0xd3, 0x33, 0xe3, 0x85, 0xff, 0x3f, 0x03, 0xb7, 0x6d, 0xe3,
+	0x30, 0x47, 0xf7, 0xee, 0xbd, 0x7b, 0x6b, 0x5a, 0x87, 0x6d, 0xdb, 0x06, 0x92, 0x9c, 0xf8, 0xf7,
+	0xfe, 0xc1, 0xd3, 0x53, 0x30, 0x52, 0xdc, 0x36, 0x10, 0x66, 0xca, 0x9e, 0x16, 0xd7, 0xfd, 0xc5,
+	0xf9, 0xfd, 0x6b, 0x55, 0x4f, 0x4b, 0x89, 0x12, 0xe5, 0x19, 0xad, 0xd5, 0xaa, 0xba, 0xc5, 0x5d,
+	0x1d, 0x5b, 0x67, 0xcd, 0xa9, 0x6a, 0x28, 0x1b, 0xca, 0x55, 0xb4, 0x28, 0x76, 0x64, 0x0d, 0x33,
+	0x06, 0x66, 0x96, 0x19, 0xbd, 0x8c, 0xef, 0xab, 0xe7, 0xd1, 0xf0, 0x8c, 0x36, 0x1a, 0x0f, 0x6d,
+	0x4b, 0x48, 0x5a, 0x7b, 0x47, 0x84, 0xbe, 0x84, 0x3e, 0xbe, 0x9c, 0x7b, 0x7d, 0x7b, 0xaf, 0xb1,
+	0x87, 0xfe, 0xd3, 0xbe, 0x67, 0x34, 0x97, 0x35, 0x75, 0x2e, 0xcd, 0xcc, 0x74, 0xef, 0x08, 0xf7,
+	0x08, 0x4f, 0x71, 0xa1, 0x78, 0xca, 0xcb, 0x43, 0xf9, 0x54, 0x4f, 0xa9, 0x8a, 0xd6, 0xd4, 0xa8,
+	0x92, 0xea, 0xa4, 0x5a, 0x2d, 0xd2, 0xb5, 0x92, 0xe1, 0x6b, 0xce, 0xe9, 0x63, 0xfa, 0x9c, 0xdf,
+	0x65, 0xdb, 0xbc, 0x66, 0x6d, 0xcf, 0xcc, 0x54, 0x45, 0x9d, 0x43, 0xb5, 0xae, 0x1c, 0x57, 0xee,
+	0xfb, 0x10, 0x6c, 0xd6, 0x5a, 0x53, 0xb7, 0x99, 0xa9, 0xd3, 0xd6, 0x9a, 0xa6, 0xcd, 0x4c, 0xfb,
+	0x67, 0xda, 0x7d, 0x45, 0xf6, 0xb7, 0x65, 0x7d, 0xc2, 0x52, 0x2d, 0x49, 0xb1, 0x6f, 0x3d, 0xec,
+	0xf5, 0xad, 0x7d, 0xe6, 0x68, 0x42, 0x1b, 0x33, 0x0d, 0xa6, 0x51, 0x13, 0x0d, 0x55, 0x87, 0x88,
+	0xd0, 0x45, 0x67, 0x82, 0x41, 0xf1, 0x53, 0xa8, 0x40, 0x61, 0x51, 0x52, 0x94, 0xaa, 0x32, 0x1d,
+	0xbe, 0x8e, 0x26, 0xb6, 0xdb, 0xde, 0x67, 0x11, 0x73, 0xce, 0xe3, 0xcf, 0x9f, 0x1d, 0x78, 0x5d,
+	0x9b, 0x98, 0xdf, 0x9c, 0x73, 0x3e, 0x33, 0x43, 0x9d, 0x4c, 0x15, 0xf9, 0x2c, 0x79, 0x28, 0x39,
+	0x5c, 0x81, 0x5b, 0xdf, 0xea, 0xdf, 0x96, 0x7f, 0x46, 0x17, 0xd3, 0xe1, 0x88, 0x08, 0x1d, 0x35,
+	0xbe, 0xbd, 0xcc, 0x91, 0xdf, 0xc4, 0xb1, 0xf7, 0x3e, 0x26, 0xb1, 0x15, 0x97, 0xd9, 0x88, 0xdf,
+	0xfa, 0xf6, 0xb7, 0xd6, 0x56, 0xad, 0xb1, 0xb6, 0x76, 0xf5, 0x6f, 0x66, 0xa6, 0xa6, 0x96, 0xcf,
+	0xdd, 0x5a, 0x6b, 0xcd, 0x6c, 0x73, 0xf6, 0x66, 0xaf, 0xb5, 0x64, 0x15, 0x35, 0x53, 0x56, 0xb1,
+	0x55, 0xb9, 0xaa, 0x16, 0xd5, 0x86, 0xab, 0xd7, 0xd5, 0xa3, 0x4e, 0x51, 0x53, 0xb4, 0x78, 0x2d,
+	0x11, 0x7a, 0xe2, 0xf1, 0x1c, 0x60, 0x75, 0x19, 0xce, 0x6c, 0xad, 0x39, 0xd7, 0xf4, 0x2a, 0x91,
+	0x6f, 0x43, 0xa8, 0x72, 0x1c, 0x4a, 0x95, 0xb4, 0x50, 0x7c, 0xca, 0xa7, 0x78, 0x99, 0x72, 0xf2,
+	0x6a, 0x79, 0xcc, 0x3b, 0x26, 0xad, 0x9f, 0xbe, 0x63, 0xd1, 0x6f, 0x59, 0x6c, 0x6b, 0xad, 0x9e,
+	0xdb, 0x23, 0x37, 0x43, 0x7d, 0x6f, 0x73, 0x63, 0x9c, 0x22, 0xe1, 0x19, 0x51, 0x22, 0x7e, 0xf9,
+	0xd3, 0x8f, 0x02, 0x11, 0x02, 0xc1, 0xa1, 0xf8, 0x7b, 0xf0, 0x54, 0x3d, 0xcf, 0xcf, 0x16, 0x92,
+	0x57, 0xd3, 0xf7, 0x2a, 0x77, 0xc8, 0xdf, 0x7f, 0x40, 0x94, 0x7c, 0xad, 0x4d, 0xf8, 0xeb, 0x32,
+	0xdf, 0xae, 0xdd, 0xe9, 0xba, 0x17, 0x71, 0x11, 0xfc, 0x00, 0xfc, 0x98, 0xea, 0xd0, 0xde, 0x38,
+	0x3f, 0xe6, 0x22, 0xfc, 0x81, 0xb9, 0x8b, 0xff, 0x58, 0xdd, 0x7b, 0x1f, 0x89, 0xf8, 0xc7, 0x44,
+	0xc7, 0xc7, 0xa6, 0xbf, 0x9a, 0xbc, 0x15, 0x76, 0x96, 0xf5, 0x7f, 0xf7, 0x3f, 0xe3, 0x91, 0xe4,
+	0x63, 0xa5, 0xcf, 0x61, 0x7e, 0xbd, 0xee, 0xef, 0xe9, 0xfe, 0xe2, 0xfa, 0xba, 0xe2, 0xe5, 0xfa,
+	0xdf, 0xde, 0x0f, 0xf5, 0xb6, 0xbe, 0xb7, 0xf5, 0xc5, 0xa5, 0x93, 0x7e, 0xe6, 0x64, 0xcd, 0xec,
+	0x78, 0x9d, 0x97, 0x5c, 0x05, 0x76, 0x9c, 0xcc, 0x18, 0xa3, 0x0b, 0x66, 0x5c, 0x45, 0xb8, 0xf4,
+	0xef, 0xf7, 0xfb, 0xbe, 0x7f, 0x2f, 0xa6, 0x5e, 0x8f, 0xdf, 0xe7, 0xbb, 0x89, 0x70, 0xe9, 0x6f,
+	0xcf, 0x87, 0x7a, 0x5b, 0x7f, 0x88, 0x70, 0xe9, 0x6f, 0xef, 0x87, 0x7a, 0x5b, 0x7f, 0x80, 0x70,
+	0xa1, 0xbf, 0x3d, 0x1f, 0xca, 0x6d, 0x7d, 0xee, 0x20, 0x5c, 0x70, 0xc1, 0xf7, 0x47, 0xf9, 0x31,
+	0xa4, 0x9b, 0xfc, 0xa2, 0x7c, 0xb5, 0xfd, 0x72, 0x41, 0x5e, 0x20, 0xe8, 0x6a, 0x06, 0x5d, 0x39,
+	0x5d, 0xcd, 0xa4, 0xab, 0x49, 0xe8, 0x6a, 0x06, 0x5d, 0x19, 0x5d, 0x8d, 0x96, 0xae, 0x46, 0xa5,
+	0x2b, 0xa3, 0x2b, 0xa7, 0xab, 0xc1, 0xd2, 0x55, 0x6f, 0xe9, 0xc2, 0x46, 0x17, 0x75, 0x96, 0x2e,
+	0xa8, 0x74, 0x61, 0xd2, 0x45, 0xb2, 0x74, 0xa1, 0xd3, 0x45, 0x32, 0x74, 0xe1, 0xc3, 0xd2, 0x05,
+	0x0f, 0x43, 0x57, 0xbb, 0xa1, 0xab, 0xa0, 0xab, 0x5d, 0xe8, 0x6a, 0x03, 0x5d, 0x6d, 0x42, 0x57,
+	0x77, 0xd0, 0x85, 0x95, 0x2e, 0xba, 0x91, 0x2e, 0xbc, 0x93, 0x2e, 0xb8, 0x09, 0x5d, 0x74, 0x05,
+	0x5d, 0x18, 0x74, 0xc1, 0x95, 0x74, 0xe1, 0x15, 0x74, 0x51, 0xd0, 0x05, 0x17, 0xd2, 0x85, 0x4e,
+	0x17, 0x5c, 0x40, 0x17, 0x19, 0x5d, 0x68, 0x74, 0xc1, 0x0a, 0xba, 0xd0, 0xe8, 0x22, 0xa7, 0x0b,
+	0x1a, 0x5d, 0xe8, 0x74, 0x41, 0xa3, 0x2b, 0xa3, 0x2b, 0xa3, 0xab, 0x46, 0x57, 0x4e, 0x57, 0x41,
+	0x17, 0x3a, 0x5d, 0x74, 0x25, 0x5d, 0x78, 0x11, 0xba, 0xe0, 0x0a, 0xba, 0xba, 0x81, 0xae, 0x82,
+	0x2e, 0x4c, 0xba, 0xe8, 0x4e, 0xba, 0x20, 0xe9, 0xc2, 0x46, 0x17, 0x6c, 0xa0, 0xab, 0x4a, 0x57,
+	0x3b, 0xe9, 0x6a, 0x03, 0x5d, 0x39, 0x5d, 0x3d, 0x7c, 0x74, 0xa1, 0xd3, 0x45, 0x72, 0x74, 0xa1,
+	0x3c, 0xba, 0xa0, 0xd2, 0x55, 0xa1, 0xab, 0xce, 0xd1, 0x55, 0xef, 0xd1, 0x55, 0xef, 0xe8, 0xca,
+	0xe8, 0x6a, 0x70, 0x74, 0xe1, 0x40, 0xba, 0xa8, 0xd0, 0x85, 0x23, 0xe9, 0xa2, 0x09, 0x74, 0x61,
+	0xa3, 0x0b, 0x26, 0xd0, 0x45, 0xb3, 0xd0, 0x85, 0x13, 0xe8, 0x82, 0x19, 0x74, 0xe5, 0x74, 0xb5,
+	0x80, 0xae, 0x9c, 0xae, 0x82, 0xae, 0x82, 0xae, 0x82, 0xae, 0x82, 0xae, 0x4e, 0xa0, 0xab, 0xa0,
+	0xab, 0xa0, 0xab, 0x42, 0x57, 0x41, 0x57, 0x85, 0xae, 0x82, 0x2e, 0x5c, 0x84, 0x2e, 0x2a, 0x74,
+	0x41, 0xd0, 0x55, 0xd2, 0xd5, 0x4c, 0xba, 0x28, 0xe9, 0x42, 0xa7, 0x0b, 0x66, 0xd0, 0x95, 0xd3,
+	0xd5, 0x04, 0xba, 0xc8, 0xe9, 0xc2, 0x46, 0x17, 0x4c, 0xa0, 0x8b, 0x1a, 0x5d, 0x30, 0x82, 0x2e,
+	0x1c, 0x48, 0x17, 0x0d, 0xa0, 0x0b, 0x06, 0xa1, 0xab, 0x9e, 0x74, 0xd5, 0x83, 0xae, 0x3a, 0xd2,
+	0x95, 0xd3, 0x95, 0x88, 0x97, 0x7c, 0x74, 0xa1, 0x88, 0xd7, 0x83, 0x74, 0xe1, 0x03, 0x74, 0xd1,
+	0x0e, 0xba, 0xc0, 0xe8, 0x6a, 0x03, 0x5d, 0x6d, 0xa0, 0x8b, 0x36, 0xa1, 0x0b, 0xef, 0xa0, 0x0b,
+	0x2a, 0x5d, 0x54, 0xe9, 0x82, 0x1b, 0xe8, 0x2a, 0xe9, 0xea, 0x0a, 0xba, 0x0a, 0xba, 0xba, 0x0a,
+	0x5d, 0x14, 0x74, 0x61, 0xd0, 0x45, 0x17, 0xd0, 0x05, 0x46, 0x57, 0x46, 0x57, 0x46, 0x57, 0x2b,
+	0xe8, 0xea, 0x22, 0x74, 0x91, 0xd1, 0x85, 0x8d, 0x2e, 0x32, 0xba, 0xa0, 0xd1, 0x95, 0xd1, 0x95,
+	0xd1, 0x55, 0xa3, 0x2b, 0xa7, 0x8b, 0x8c, 0x2e, 0x34, 0xba, 0x28, 0xe8, 0x82, 0x0b, 0xe9, 0x2a,
+	0xe8, 0x2a, 0xe8, 0xea, 0x26, 0x74, 0x51, 0xd2, 0x85, 0x85, 0x2e, 0xb8, 0x93, 0x2e, 0xaa, 0x74,
+	0x41, 0xa3, 0xab, 0x4a, 0x57, 0x1b, 0xe8, 0x6a, 0x13, 0xba, 0xda, 0x0d, 0x5d, 0xed, 0x42, 0x57,
+	0xbb, 0xd2, 0xd5, 0x43, 0xe9, 0x22, 0x29, 0x5d, 0x18, 0x74, 0x51, 0xd0, 0x85, 0x41, 0x17, 0xf5,
+	0x4a, 0x17, 0x74, 0x4a, 0x57, 0x8d, 0x2e, 0x1c, 0x94, 0x2e, 0x6a, 0x74, 0xc1, 0xa8, 0x74, 0x35,
+	0xf8, 0xd1, 0x95, 0xd3, 0xd5, 0xa4, 0x74, 0xe5, 0x74, 0x35, 0x09, 0x5d, 0xcd, 0xa0, 0x2b, 0xa3,
+	0x8b, 0x9c, 0x2e, 0x74, 0xba, 0x60, 0x01, 0x5d, 0xcd, 0xa4, 0xab, 0xa0, 0xab, 0x45, 0xe8, 0x2a,
+	0xe9, 0xea, 0x44, 0xba, 0x4a, 0xba, 0x0a, 0xba, 0x3a, 0x81, 0xae, 0x82, 0xae, 0x0a, 0x5d, 0x18,
+	0x74, 0x51, 0xa5, 0x0b, 0x82, 0xae, 0x82, 0x2e, 0x0c, 0xba, 0x28, 0xe8, 0xc2, 0x85, 0x74, 0xc1,
+	0x0c, 0xba, 0x68, 0x26, 0x5d, 0x38, 0x83, 0x2e, 0x98, 0x49, 0x57, 0x13, 0xe8, 0xca, 0xe9, 0x6a,
+	0x04, 0x5d, 0x4d, 0xa0, 0x0b, 0x47, 0xd2, 0x45, 0x95, 0x2e, 0x1c, 0x40, 0x17, 0x0d, 0x42, 0x17,
+	0xf6, 0xa0, 0x0b, 0x82, 0xae, 0x82, 0xae, 0x3a, 0xa1, 0xab, 0x0e, 0x74, 0x21, 0x5e, 0x24, 0xd0,
+	0x85, 0x78, 0xd1, 0x03, 0x74, 0x61, 0xd0, 0x05, 0x3b, 0xe8, 0xca, 0xe8, 0x6a, 0x03, 0x5d, 0xb8,
+	0x81, 0x2e, 0xba, 0x83, 0x2e, 0xdc, 0x84, 0x2e, 0xb8, 0x81, 0xae, 0x2a, 0x5d, 0x25, 0x5d, 0xdd,
+	0x48, 0x57, 0x57, 0xd0, 0x55, 0xd0, 0x85, 0x57, 0xa1, 0x0b, 0x82, 0x2e, 0xba, 0x80, 0x2e, 0x0c,
+	0xba, 0xc0, 0xe8, 0xc2, 0x0b, 0xe9, 0xa2, 0x15, 0x74, 0x81, 0xd1, 0x85, 0x4e, 0x17, 0xad, 0xa4,
+	0x0b, 0x8d, 0x2e, 0x58, 0x49, 0x57, 0x4e, 0x57, 0x2b, 0xe9, 0x42, 0xa7, 0x8b, 0x00,
+};
+
+static const uint8_t screen_lossy[] = {
+	0x52, 0x49, 0x46, 0x46, 0x92, 0x0f, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x20,
+	0x86, 0x0f, 0x00, 0x00, 0xb0, 0x6d, 0x00, 0x9d, 0x01, 0x2a, 0xe0, 0x01, 0x10, 0x01, 0x3e, 0x7d,
+	0x2e, 0x90, 0x47, 0xbb, 0x2c, 0xa5, 0xa5, 0x39, 0x9a, 0xbd, 0xbb, 0x60, 0x0f, 0x89, 0x68, 0x6e,
+	0xf8, 0x16, 0x8c, 0x0c, 0x4f, 0x64, 0x8c, 0x60, 0x0d, 0xb5, 0x64, 0xa3, 0xd0, 0x54, 0x7e, 0xb5,
+	0x1d, 0xc3, 0xfc, 0xfb, 0x97, 0x97, 0x32, 0xdb, 0x7d, 0xf3, 0x6b, 0xe4, 0x26, 0xe9, 0xff, 0xe5,
+	0xdd, 0x7f, 0xe4, 0xb7, 0xff, 0xff, 0x3f, 0xfb, 0x95, 0xa8, 0xe5, 0xbd, 0xeb, 0xa7, 0xf0, 0xff,
+	0x35, 0x7f, 0xbf, 0x7c, 0x01, 0xde, 0xbc, 0x3c, 0xc9, 0x7b, 0xe3, 0x7f, 0xff, 0x33, 0x01, 0xff,
+	0xf3, 0xcc, 0x07, 0xff, 0xed, 0xff, 0xee, 0x29, 0x5b, 0xb7, 0xb3, 0xff, 0x68, 0x0b, 0xff, 0x75,
+	0x74, 0x01, 0xdf, 0xfd, 0x3e, 0x98, 0x51, 0xd8, 0xa1, 0x22, 0x8e, 0xb0, 0xb0, 0x69, 0xfe, 0x17,
+	0x43, 0x76, 0xab, 0xf7, 0x96, 0xab, 0x53, 0xa1, 0x8c, 0x6c, 0xd9, 0xc0, 0xff, 0xdf, 0x5e, 0xe5,
+	0xa3, 0x7a, 0xf5, 0xed, 0x1c, 0x81, 0x84, 0xda, 0xe7, 0x61, 0xed, 0x0d, 0xda, 0x5d, 0x34, 0x17,
+	0xef, 0xc4, 0x3e, 0xc2, 0xfe, 0x27, 0xa7, 0xff, 0xff, 0xff, 0xb3, 0xc6, 0x2b, 0x85, 0x29, 0x09,
+	0x8f, 0xb3, 0xee, 0xb7, 0xcb, 0xac, 0x02, 0xe6, 0x4f, 0x59, 0xd9, 0xdc, 0x91, 0x07, 0x73, 0x67,
+	0xfe, 0x36, 0x9f, 0x6f, 0xee, 0xbd, 0x85, 0x3d, 0xbf, 0x05, 0xec, 0x7b, 0x8f, 0xff, 0xff, 0xfa,
+	0x7c, 0x95, 0xfb, 0xd2, 0x87, 0xd3, 0xf6, 0x20, 0xff, 0x03, 0xf0, 0x05, 0x13, 0x6b, 0xc3, 0xc6,
+	0x6b, 0xf7, 0xb9, 0x25, 0xa0, 0x98, 0xf6, 0x69, 0x21, 0x7d, 0xf4, 0xc5, 0xb4, 0x64, 0xe7, 0x2b,
+	0x38, 0xbd, 0x0d, 0x2d, 0x9f, 0xfc, 0x45, 0xa5, 0x76, 0x20, 0xec, 0x6d, 0x10, 0x93, 0xbb, 0xbe,
+	0x3e, 0x5a, 0xa2, 0xe1, 0x99, 0x48, 0x6b, 0x0b, 0x80, 0x50, 0xf3, 0xb6, 0x17, 0xf9, 0x6a, 0x8b,
+	0x84, 0x55, 0x0d, 0x8e, 0xfc, 0x1c, 0xd5, 0x55, 0xde, 0x42, 0x96, 0xd1, 0x09, 0x3b, 0x61, 0x7f,
+	0xd1, 0xd1, 0x5d, 0xe4, 0x29, 0x6b, 0x45, 0x47, 0xf9, 0x3d, 0x3d, 0xf2, 0x15, 0x85, 0x67, 0xae,
+	0x11, 0xca, 0xd2, 0x6e, 0xf9, 0x3d, 0x3e, 0xdf, 0xd5, 0x7b, 0xe4, 0xf4, 0xfb, 0x7e, 0x1f, 0x3f,
+	0xb1, 0xde, 0xf2, 0x73, 0x95, 0x9c, 0x5e, 0x87, 0x63, 0x68, 0x84, 0xd4, 0xf9, 0xf1, 0xa6, 0xa3,
+	0xc5, 0x50, 0xa1, 0xdd, 0xfc, 0xdf, 0x4b, 0x73, 0x97, 0xbd, 0xe4, 0xf5, 0x3b, 0x9f, 0x7b, 0xe1,
+	0x28, 0x50, 0x11, 0x36, 0xd7, 0x93, 0xf3, 0xbe, 0x53, 0x91, 0xb0, 0x2d, 0xcf, 0x39, 0x54, 0xc1,
+	0x7b, 0xa8, 0x25, 0x82, 0xfb, 0xff, 0x87, 0xe4, 0xd9, 0xde, 0x82, 0x79, 0x19, 0xd8, 0x9f, 0x1b,
+	0x8e, 0x67, 0x11, 0x53, 0xaa, 0xd4, 0x3f, 0x8c, 0x91, 0x4a, 0x58, 0xe0, 0xf3, 0x3c, 0x63, 0xc4,
+	0xcf, 0x54, 0x9f, 0x08, 0xc1, 0xe2, 0xd7, 0xfe, 0x3a, 0x8e, 0xd1, 0x09, 0x3b, 0x61, 0x7f, 0x96,
+	0xa8, 0xb8, 0x45, 0x50, 0xd9, 0x60, 0xe6, 0xaa, 0xae, 0xbf, 0xe3, 0xa8, 0xed, 0x10, 0x93, 0xb6,
+	0x17, 0xf9, 0x66, 0xc5, 0xf0, 0x16, 0x60, 0xf6, 0x83, 0xe9, 0x4a, 0x8b, 0x18, 0x66, 0x86, 0xcb,
+	0x07, 0x35, 0x55, 0x77, 0x90, 0x9c, 0xf4, 0x42, 0x4e, 0xee, 0xf8, 0xe1, 0x6b, 0xd8, 0x8b, 0x44,
+	0x60, 0xea, 0x88, 0x49, 0xdb, 0x0e, 0x3e, 0x5a, 0xa3, 0xee, 0x2a, 0xdf, 0x21, 0xcd, 0x4d, 0xaa,
+	0xd6, 0xc5, 0xff, 0xaf, 0x9e, 0x0c, 0x8c, 0xf4, 0xcf, 0xba, 0xf0, 0x7f, 0xed, 0x2c, 0x9d, 0x51,
+	0x54, 0xe6, 0xcf, 0xba, 0xf0, 0x7f, 0xff, 0xff, 0xf0, 0x9c, 0x31, 0x47, 0x6e, 0x68, 0xf3, 0x7b,
+	0x1e, 0x0b, 0x58, 0xfe, 0x6f, 0xa1, 0x3b, 0x76, 0xf8, 0xc4, 0xc5, 0xa0, 0x7a, 0x12, 0x9f, 0xb0,
+	0xd7, 0x87, 0xf1, 0xbf, 0xff, 0xfd, 0x03, 0xb5, 0x87, 0xbd, 0x31, 0x61, 0x7f, 0xff, 0xa5, 0xc2,
+	0x7d, 0x31, 0xe6, 0xae, 0xf2, 0x14, 0xb6, 0x8c, 0x9c, 0xe5, 0x65, 0xea, 0x43, 0x63, 0x68, 0x84,
+	0x9d, 0xa9, 0x3f, 0xcb, 0x54, 0x5c, 0x22, 0xa8, 0x6c, 0xb0, 0x73, 0x55, 0x57, 0x71, 0x99, 0x1c,
+	0x7b, 0xc6, 0x6e, 0x4b, 0x5a, 0x1c, 0x76, 0x92, 0x2f, 0x52, 0x14, 0xb6, 0x88, 0x49, 0xdb, 0x0b,
+	0xfc, 0xb4, 0xfb, 0xcb, 0x84, 0x55, 0x0d, 0x96, 0x0e, 0x6a, 0xaa, 0xef, 0x21, 0x4b, 0x68, 0x84,
+	0x9d, 0xb0, 0xbf, 0xcb, 0x54, 0x6c, 0x90, 0x3f, 0xff, 0xe1, 0xdb, 0x3a, 0xad, 0x03, 0xea, 0x18,
+	0xfd, 0x5f, 0x63, 0xdc, 0x6f, 0x12, 0xe0, 0xe0, 0xc4, 0xc6, 0x9f, 0xe3, 0x6d, 0xa8, 0x3b, 0x3b,
+	0x3c, 0x3e, 0x7f, 0x63, 0xfe, 0x5f, 0xda, 0xd8, 0xed, 0x2c, 0xa1, 0x67, 0x0e, 0xe7, 0xd1, 0xf5,
+	0xbd, 0x58, 0x7a, 0x1f, 0x26, 0x29, 0x1c, 0x1f, 0xd3, 0xda, 0xe9, 0x76, 0xd8, 0xf6, 0x26, 0x3c,
+	0x93, 0xdd, 0x06, 0x1c, 0xbe, 0x73, 0x72, 0x6d, 0xec, 0x6b, 0x6f, 0xdb, 0x57, 0xfe, 0xcf, 0x78,
+	0x0c, 0xff, 0x13, 0xcf, 0x3a, 0x3f, 0x54, 0x9c, 0x22, 0x69, 0x42, 0x97, 0x7b, 0x84, 0x9d, 0xb0,
+	0xe3, 0xf4, 0x75, 0x57, 0x79, 0x0d, 0x8d, 0xa2, 0x12, 0x76, 0xc3, 0x8e, 0x17, 0x29, 0x51, 0xc1,
+	0xe6, 0x75, 0xb6, 0x58, 0x3d, 0x3b, 0x20, 0xc8, 0xcd, 0x13, 0xb0, 0xbf, 0xcb, 0x54, 0x5c, 0x22,
+	0xa8, 0x6c, 0xb0, 0x73, 0x55, 0x57, 0x79, 0x0a, 0x5a, 0xd2, 0x24, 0xed, 0x85, 0xc6, 0xdc, 0xa5,
+	0x45, 0xc2, 0x2a, 0x86, 0xcb, 0x07, 0x34, 0xd7, 0x6d, 0x3f, 0x6b, 0xd8, 0x60, 0x7d, 0xef, 0x27,
+	0xa9, 0xdc, 0xfb, 0xc7, 0xe7, 0x7c, 0x9e, 0x9f, 0x6f, 0xc3, 0xe7, 0xf0, 0x7d, 0x24, 0x2e, 0xb8,
+	0x67, 0x8b, 0x92, 0xa5, 0xde, 0xf2, 0x76, 0x09, 0x0c, 0xed, 0x04, 0x53, 0x2f, 0x5e, 0x47, 0x27,
+	0x8b, 0xed, 0xbd, 0xc8, 0x9d, 0xb0, 0xe3, 0xf4, 0x76, 0xe5, 0xd4, 0x8f, 0x54, 0xe3, 0xff, 0x29,
+	0xd0, 0x01, 0xf3, 0xf4, 0xbb, 0xdf, 0x83, 0xe4, 0x6a, 0x77, 0x7e, 0xff, 0xfb, 0x1d, 0x51, 0xee,
+	0xf8, 0xff, 0x2b, 0x5b, 0xbb, 0xf8, 0x3e, 0x45, 0x39, 0xf8, 0x07, 0x27, 0x77, 0xff, 0xfe, 0x8d,
+	0x9c, 0xc6, 0x13, 0x54, 0x9d, 0xbe, 0xc7, 0xff, 0xab, 0xbd, 0x18, 0x4e, 0x6a, 0xaa, 0xef, 0x21,
+	0x4b, 0x68, 0x84, 0x9d, 0xb0, 0xbf, 0x0b, 0x94, 0xa8, 0xb8, 0x45, 0x50, 0xd9, 0x60, 0xe6, 0xaa,
+	0xae, 0xf2, 0x1b, 0x1a, 0xd2, 0x24, 0xed, 0x85, 0xf3, 0xc0, 0x00, 0xfd, 0x7b, 0x12, 0x0f, 0x7a,
+	0xd7, 0x1a, 0xb7, 0x18, 0xe2, 0x03, 0x10, 0x46, 0x18, 0x28, 0x67, 0x5c, 0x79, 0x45, 0xa3, 0xe4,
+	0x33, 0x0a, 0x41, 0x18, 0xd9, 0x65, 0x49, 0x94, 0x22, 0xed, 0x9d, 0x87, 0x36, 0x0b, 0xe5, 0x5a,
+	0x5c, 0xa2, 0xcc, 0x10, 0xab, 0x85, 0x2b, 0xfa, 0x9b, 0x07, 0x7e, 0x39, 0x6c, 0x17, 0xe1, 0x89,
+	0x0b, 0xab, 0x08, 0x42, 0x98, 0xcd, 0x96, 0x7a, 0x59, 0xb1, 0xee, 0x74, 0xae, 0x84, 0xcf, 0x5a,
+	0x45, 0xff, 0x54, 0xc2, 0x8a, 0xf3, 0xb0, 0xc9, 0x94, 0xdb, 0x78, 0x00, 0xb7, 0x08, 0x93, 0xf4,
+	0x2a, 0x34, 0x11, 0xbb, 0xf8, 0x31, 0xe6, 0x89, 0x18, 0x26, 0x58, 0x3c, 0xf5, 0xab, 0x8d, 0x83,
+	0x59, 0x36, 0xce, 0xa0, 0xa5, 0x02, 0x8b, 0xb3, 0x91, 0xbd, 0x14, 0xb7, 0xa5, 0x2d, 0xb9, 0xd2,
+	0x56, 0xea, 0x68, 0x42, 0x60, 0x6b, 0x1d, 0xce, 0x49, 0x1d, 0x1c, 0x04, 0x35, 0x6e, 0x61, 0x1f,
+	0x21, 0xa2, 0xec, 0xcb, 0xff, 0x6f, 0x4f, 0x5c, 0xc7, 0x5f, 0xf9, 0x3c, 0xcd, 0x73, 0x20, 0xc3,
+	0x19, 0x88, 0x69, 0xfc, 0xc4, 0xf1, 0x21, 0x3c, 0x34, 0x13, 0xfc, 0x6a, 0x4a, 0x0b, 0x64, 0x3d,
+	0x90, 0xaa, 0x78, 0x91, 0xd2, 0x12, 0x84, 0xb0, 0xd9, 0x09, 0xe6, 0x75, 0x84, 0xb4, 0x87, 0x23,
+	0x87, 0xfb, 0xeb, 0x40, 0x9e, 0xd7, 0xeb, 0xe0, 0x3f, 0xeb, 0xd9, 0x0d, 0xf6, 0x69, 0x5e, 0x39,
+	0x97, 0x1f, 0x8e, 0x80, 0xc4, 0x3c, 0xa2, 0xd8, 0x4a, 0x50, 0xf2, 0x10, 0xbe, 0x46, 0x69, 0x8c,
+	0x74, 0x9c, 0x95, 0xb8, 0x57, 0x1c, 0xc9, 0x7c, 0xf1, 0x90, 0x66, 0x1c, 0x33, 0x89, 0xe4, 0xf7,
+	0x05, 0xc3, 0xea, 0x0e, 0x07, 0xea, 0xe6, 0xd0, 0xfb, 0x81, 0xb1, 0x50, 0xc6, 0x81, 0x81, 0x56,
+	0x9e, 0x33, 0xb6, 0x01, 0xc2, 0x24, 0xd8, 0xe5, 0xcc, 0x50, 0x8c, 0xa4, 0x84, 0x81, 0xa3, 0xf5,
+	0x66, 0x0e, 0xd1, 0xc5, 0x3b, 0x2b, 0x00, 0x27, 0x60, 0x6b, 0x8f, 0x4b, 0x5a, 0xb8, 0xab, 0x06,
+	0xf5, 0x54, 0x58, 0x60, 0x05, 0x87, 0xf8, 0x5b, 0x73, 0x87, 0x4a, 0x43, 0x91, 0xf2, 0xb5, 0x4d,
+	0x6b, 0x95, 0x17, 0x08, 0x3d, 0xc6, 0xce, 0xa5, 0x5f, 0x24, 0x6e, 0x45, 0xf8, 0xda, 0x2f, 0x49,
+	0x79, 0x9d, 0x73, 0x56, 0xe3, 0x02, 0x33, 0x31, 0x4c, 0x36, 0xdc, 0xef, 0x31, 0x49, 0x4b, 0x4a,
+	0x5c, 0x6d, 0xdf, 0x7a, 0x8d, 0x42, 0x13, 0xec, 0x7a, 0x22, 0xd7, 0x00, 0xd8, 0x41, 0x57, 0x6f,
+	0x4a, 0xa2, 0xd6, 0x52, 0xbb, 0xd0, 0x61, 0x1b, 0xdc, 0x08, 0xc7, 0x7b, 0x42, 0x09, 0x09, 0xa9,
+	0x4d, 0x62, 0x61, 0xa4, 0xeb, 0xbb, 0x8d, 0x79, 0x25, 0x22, 0x2f, 0x5e, 0x6f, 0x84, 0x60, 0xe6,
+	0x77, 0x83, 0x49, 0x64, 0x83, 0x64, 0x0c, 0xf9, 0xa3, 0x90, 0x98, 0xd3, 0xe6, 0x0e, 0x2b, 0x04,
+	0x60, 0xa3, 0x6e, 0xbb, 0x17, 0xb3, 0x63, 0x4b, 0xc5, 0x9c, 0xdb, 0x0d, 0x0b, 0x6e, 0x9e, 0xc1,
+	0xe4, 0x25, 0xf3, 0xd0, 0xe3, 0xac, 0xf9, 0x37, 0x6e, 0x74, 0xbd, 0xc3, 0xbf, 0xa1, 0x81, 0xd4,
+	0x5b, 0x99, 0x6f, 0xa9, 0x51, 0xd4, 0x1a, 0x4b, 0xc3, 0x62, 0x33, 0x91, 0x81, 0xda, 0x02, 0xa8,
+	0xcc, 0xd1, 0xc3, 0x25, 0xc0, 0x15, 0xe6, 0x21, 0x26, 0x52, 0x78, 0xb7, 0xc1, 0x63, 0xd1, 0x36,
+	0xd2, 0x36, 0x6f, 0xfa, 0x23, 0x59, 0xf4, 0x05, 0x76, 0x22, 0x0d, 0x82, 0x4f, 0xef, 0x26, 0x38,
+	0xfa, 0x06, 0x33, 0x2f, 0xbd, 0x76, 0x10, 0x90, 0x3b, 0x79, 0x4b, 0x4d, 0x94, 0xa5, 0x2b, 0x27,
+	0x94, 0x2b, 0x2f, 0x65, 0x43, 0xdd, 0x6e, 0xf1, 0x86, 0x38, 0x60, 0x07, 0x67, 0xcd, 0x72, 0xa9,
+	0x6e, 0x36, 0x98, 0xc5, 0x18, 0xe2, 0x7a, 0x6c, 0x23, 0x75, 0x04, 0x3c, 0x63, 0xbc, 0xe0, 0x15,
+	0x71, 0xaa, 0x2a, 0x68, 0x81, 0xef, 0xc0, 0xa0, 0x9d, 0xd8, 0x61, 0x79, 0x6d, 0x47, 0x46, 0x45,
+	0x58, 0xc4, 0x81, 0xb2, 0x17, 0x83, 0xea, 0x83, 0x71, 0x38, 0xae, 0xb7, 0x5e, 0xeb, 0x34, 0x73,
+	0xac, 0x54, 0xd4, 0xc7, 0x4d, 0x5d, 0x98, 0x97, 0x5c, 0x54, 0x57, 0x6c, 0xcf, 0x34, 0xa3, 0xe5,
+	0x8f, 0x77, 0x5b, 0x0b, 0x80, 0x2a, 0x51, 0x4f, 0xbc, 0x0c, 0xd4, 0x52, 0x57, 0xdc, 0xfa, 0xd3,
+	0x5d, 0x44, 0x87, 0x40, 0x3d, 0x75, 0xf1, 0xbe, 0x0f, 0x06, 0xea, 0x4b, 0x86, 0x08, 0x86, 0x28,
+	0x28, 0x34, 0x9d, 0x1e, 0x53, 0xed, 0x06, 0x45, 0x95, 0x81, 0x05, 0x90, 0xf5, 0x1f, 0x7a, 0x26,
+	0x90, 0x59, 0x20, 0x23, 0x56, 0x02, 0x86, 0x35, 0x13, 0x2a, 0xfa, 0xac, 0x28, 0x85, 0x27, 0x5d,
+	0x90, 0x11, 0xdb, 0x83, 0x20, 0x4a, 0xf0, 0xde, 0xff, 0x39, 0x42, 0x5f, 0xf4, 0x36, 0x7c, 0xaa,
+	0xd9, 0xcd, 0x39, 0xc0, 0x2b, 0xe4, 0x0f, 0xa5, 0x5f, 0x0c, 0xce, 0xf5, 0xed, 0xd3, 0x6c, 0x7d,
+	0xf4, 0x30, 0xc3, 0x00, 0x17, 0x22, 0xfe, 0xa5, 0x91, 0x55, 0x65, 0x4c, 0x72, 0xae, 0x66, 0xd5,
+	0xbb, 0x79, 0x9c, 0x72, 0x7a, 0xd7, 0x44, 0x8a, 0x49, 0xf9, 0x1c, 0x9f, 0x8e, 0xd2, 0x6f, 0x16,
+	0x42, 0x9c, 0x1b, 0x84, 0x14, 0xc0, 0xd1, 0x99, 0xbf, 0x19, 0xe8, 0xf0, 0xb2, 0x1b, 0x36, 0x69,
+	0x3d, 0x16, 0x00, 0x37, 0x05, 0x62, 0xc6, 0xb9, 0xf0, 0x90, 0xda, 0xcc, 0x10, 0x87, 0xf5, 0x97,
+	0x53, 0x94, 0x73, 0xe2, 0xbb, 0xac, 0xb4, 0x0d, 0x27, 0x63, 0x4c, 0x70, 0xc8, 0xd7, 0x83, 0xd5,
+	0x7f, 0x09, 0x75, 0xf0, 0x45, 0xde, 0xd8, 0xaa, 0xcf, 0x0d, 0x8b, 0xc4, 0xf1, 0xcf, 0xc9, 0x04,
+	0xc5, 0x64, 0x67, 0xf3, 0xda, 0xbb, 0x98, 0xf7, 0x15, 0x1f, 0xef, 0xd3, 0xc2, 0x8c, 0xfa, 0x5e,
+	0x62, 0x84, 0xb4, 0x53, 0xea, 0x92, 0xa5, 0xca, 0xde, 0x0b, 0xdc, 0xc1, 0xf8, 0x1a, 0xa4, 0xa7,
+	0xe2, 0xec, 0xfd, 0xc5, 0x3a, 0x8f, 0xbd, 0x2e, 0x9b, 0xb6, 0xf4, 0x69, 0x81, 0x76, 0x01, 0x59,
+	0xff, 0x78, 0x17, 0xaf, 0x27, 0x70, 0x8a, 0xef, 0xbf, 0xc8, 0xa5, 0x4f, 0xa0, 0x67, 0x52, 0x4b,
+	0x6b, 0xd7, 0x62, 0xe8, 0x9f, 0x06, 0xba, 0x87, 0x60, 0xa9, 0xe6, 0x21, 0x31, 0xb5, 0x3b, 0xe6,
+	0xfe, 0x42, 0x0c, 0x9e, 0xa0, 0xd0, 0x9b, 0xb4, 0x1a, 0x8a, 0x82, 0xce, 0x1e, 0xa8, 0xc5, 0x3e,
+	0x44, 0x3c, 0x0a, 0xf2, 0x28, 0xb3, 0x9c, 0x8e, 0xba, 0xa5, 0xd1, 0x37, 0x17, 0x5a, 0x9e, 0x02,
+	0xdd, 0xd1, 0x6d, 0x14, 0x13, 0xd8, 0x67, 0xc3, 0x1f, 0x8d, 0xd8, 0x82, 0x5e, 0x7e, 0x7c, 0xfd,
+	0xba, 0x4b, 0xf8, 0x69, 0x4f, 0xf0, 0xb8, 0x40, 0x12, 0x52, 0xc6, 0x8c, 0x3f, 0x88, 0xea, 0x64,
+	0xac, 0x8d, 0xb0, 0xd6, 0x0b, 0xd2, 0x43, 0x73, 0xcb, 0x9a, 0xfe, 0x6b, 0x60, 0xdb, 0xad, 0xbe,
+	0xaf, 0x2d, 0xb3, 0x44, 0x88, 0x27, 0xce, 0xfa, 0xe8, 0xe3, 0x42, 0x25, 0x5d, 0x1a, 0xce, 0xdd,
+	0xeb, 0xd8, 0xa9, 0x9c, 0x5f, 0xa4, 0x5c, 0xa5, 0x81, 0x10, 0xab, 0x4b, 0x36, 0x51, 0x9a, 0xc6,
+	0x3f, 0xc1, 0x79, 0xbc, 0x5e, 0x35, 0x77, 0x73, 0xec, 0xf2, 0x0e, 0x76, 0x65, 0x01, 0x19, 0x58,
+	0xd8, 0x02, 0x46, 0xbf, 0xc3, 0x4f, 0xdd, 0xcb, 0x87, 0x75, 0xf4, 0x77, 0x56, 0xd8, 0x41, 0x76,
+	0x7e, 0x06, 0xdb, 0x3e, 0xaf, 0xbb, 0x95, 0x68, 0x74, 0x13, 0xc2, 0x20, 0x44, 0xa9, 0x4e, 0xcf,
+	0x38, 0xe1, 0x7a, 0x28, 0xd8, 0x25, 0x95, 0x2a, 0x38, 0xa6, 0x0e, 0x89, 0xad, 0x7d, 0x4c, 0x19,
+	0xee, 0x8f, 0x12, 0x1d, 0xe2, 0x0a, 0xbf, 0xfa, 0x5b, 0x66, 0xb2, 0x2b, 0x43, 0xd8, 0xf1, 0x10,
+	0xa7, 0x31, 0x4a, 0xe2, 0x6a, 0xe9, 0xf2, 0xcb, 0xa0, 0x26, 0xf3, 0x8f, 0xd4, 0xc9, 0xe5, 0x02,
+	0xa7, 0x81, 0x4e, 0x25, 0xd4, 0x27, 0x37, 0xec, 0x80, 0x0f, 0x51, 0x67, 0x5e, 0x21, 0x59, 0x0d,
+	0x88, 0xaf, 0x04, 0xfc, 0x98, 0xd7, 0x1b, 0x41, 0x32, 0x5d, 0x2d, 0x61, 0x1e, 0x71, 0x8b, 0x19,
+	0x6a, 0xc4, 0x09, 0x3f, 0x06, 0xeb, 0xdd, 0x20, 0x30, 0xa8, 0x2f, 0x72, 0x73, 0xf4, 0x0d, 0x6c,
+	0xda, 0xf3, 0x7e, 0x70, 0xb1, 0xa5, 0x87, 0x97, 0xda, 0x7e, 0x75, 0xef, 0x1a, 0xc8, 0x29, 0x50,
+	0x35, 0x27, 0x46, 0x0c, 0x92, 0x99, 0x92, 0x0b, 0xbe, 0xd9, 0x9b, 0x27, 0x4c, 0x60, 0xee, 0x88,
+	0xf7, 0xf8, 0xaa, 0x78, 0x6b, 0x66, 0x0a, 0x43, 0xbd, 0xbd, 0xa6, 0xff, 0x81, 0xbd, 0x28, 0xb0,
+	0xc9, 0x5a, 0xca, 0x4d, 0x57, 0x46, 0x1b, 0x16, 0x16, 0x40, 0x78, 0x20, 0xe6, 0x15, 0x81, 0x4e,
+	0x0d, 0xee, 0x0d, 0x87, 0x71, 0x66, 0xc9, 0x09, 0x22, 0xb0, 0xdb, 0x7e, 0x1a, 0x13, 0x68, 0x3e,
+	0xfa, 0xbd, 0x1b, 0x3f, 0xb5, 0x8d, 0x4d, 0x86, 0x02, 0x3a, 0x75, 0x90, 0x51, 0x69, 0xb6, 0x40,
+	0xd1, 0xd2, 0x4f, 0x53, 0x6b, 0x43, 0xb6, 0xbf, 0x52, 0xb2, 0xce, 0x3e, 0xb6, 0xb8, 0xa7, 0x4f,
+	0xf8, 0x44, 0x8e, 0x72, 0xa9, 0x9a, 0x4c, 0x79, 0x7e, 0x5f, 0x9b, 0x9c, 0x0a, 0xfc, 0xb8, 0x60,
+	0x64, 0x58, 0x5f, 0x33, 0x85, 0x86, 0x9c, 0xe2, 0x11, 0xc5, 0x3f, 0xb9, 0x88, 0xda, 0xce, 0x82,
+	0x5a, 0xb3, 0xe1, 0x8e, 0x40, 0xed, 0x93, 0xd2, 0xe5, 0x04, 0x0a, 0xbf, 0x7b, 0x03, 0xfa, 0xb9,
+	0x05, 0xe6, 0xbe, 0xd9, 0x7b, 0x5b, 0x10, 0xbc, 0xe8, 0x80, 0x7a, 0xb5, 0x16, 0x54, 0x28, 0x48,
+	0xee, 0x65, 0x3c, 0x00, 0xd6, 0x1d, 0xb3, 0x8b, 0xd9, 0x38, 0xae, 0x6b, 0xe7, 0x73, 0x5f, 0x25,
+	0x46, 0xde, 0xa5, 0xa7, 0xb3, 0xca, 0x8c, 0x13, 0x94, 0x7f, 0x0a, 0x83, 0xe9, 0x3f, 0x67, 0x73,
+	0x50, 0x3a, 0x1a, 0x19, 0x69, 0x3f, 0x45, 0x05, 0x84, 0x6a, 0x8c, 0xc6, 0xbd, 0xec, 0x66, 0xa7,
+	0x31, 0xe1, 0xe9, 0x94, 0xa8, 0x81, 0x8a, 0x8c, 0x88, 0x56, 0x69, 0x82, 0x4e, 0xee, 0x00, 0xab,
+	0xa3, 0x7a, 0x93, 0x16, 0xf5, 0xf0, 0xc3, 0x07, 0xf1, 0xe8, 0x2b, 0x7f, 0x31, 0x4b, 0x9a, 0xd3,
+	0x58, 0x13, 0x7c, 0xfd, 0x0c, 0x3c, 0xf4, 0x1b, 0x5e, 0xb1, 0x9a, 0x77, 0xb1, 0x11, 0x3c, 0x2c,
+	0xbe, 0x9d, 0xfa, 0x01, 0xcc, 0x27, 0x31, 0x3f, 0x41, 0x90, 0xf5, 0xa0, 0x3b, 0xd4, 0x5f, 0x51,
+	0xd9, 0xad, 0x93, 0x52, 0xcc, 0x86, 0x87, 0x62, 0x48, 0x9e, 0xf1, 0x34, 0xd4, 0x2f, 0x32, 0xe6,
+	0xa9, 0xbf, 0x61, 0xb1, 0xa4, 0x43, 0x78, 0x25, 0x9e, 0xec, 0x1a, 0x52, 0xd1, 0xfa, 0x40, 0x30,
+	0x05, 0xc0, 0x37, 0xbd, 0xc2, 0xbf, 0x5f, 0x46, 0xd1, 0xb7, 0x59, 0x16, 0x17, 0x5e, 0xad, 0xa2,
+	0x91, 0x03, 0xe5, 0x82, 0x9b, 0xa7, 0x97, 0x05, 0xd1, 0xf7, 0xcf, 0xc7, 0x42, 0xd7, 0x1f, 0x77,
+	0x01, 0xfe, 0x1e, 0x5f, 0x9b, 0xdd, 0x12, 0x87, 0x7e, 0x8c, 0xa4, 0x7d, 0x2b, 0x2c, 0xb5, 0x8b,
+	0xcb, 0xc3, 0x6b, 0xe8, 0xd1, 0x72, 0x95, 0xdd, 0xea, 0xe8, 0x8c, 0x32, 0x4b, 0xba, 0xd2, 0x3b,
+	0xa9, 0x52, 0x37, 0x61, 0x0a, 0x1b, 0xb0, 0x1d, 0x8b, 0x1a, 0x43, 0x1d, 0x5f, 0x95, 0xdf, 0x28,
+	0xd2, 0xef, 0x9d, 0xca, 0x6e, 0xec, 0xf5, 0xa5, 0x68, 0x8d, 0xed, 0xf0, 0x7e, 0x79, 0x64, 0x37,
+	0xff, 0x78, 0x86, 0x12, 0x66, 0xfb, 0x01, 0xaa, 0x5d, 0x46, 0x37, 0x13, 0x19, 0xe3, 0xb0, 0xa6,
+	0xbd, 0x63, 0x34, 0x7a, 0x47, 0xdd, 0x24, 0x04, 0xc4, 0xf7, 0xab, 0xbe, 0xce, 0x7f, 0x8a, 0xb5,
+	0xc2, 0x20, 0x09, 0x7a, 0x95, 0xf8, 0xe6, 0x6d, 0xcd, 0xa0, 0x11, 0x0c, 0xbf, 0xec, 0x58, 0x9a,
+	0x35, 0x86, 0xb0, 0xed, 0x80, 0x59, 0x1f, 0xe5, 0x6e, 0xee, 0x02, 0xb7, 0xb9, 0xb5, 0x91, 0x3c,
+	0xed, 0xd6, 0xdc, 0xa3, 0x15, 0xa5, 0xcd, 0xb7, 0x2b, 0xac, 0xb6, 0x0e, 0xc0, 0xd2, 0x69, 0x73,
+	0x69, 0xbb, 0x72, 0x3a, 0xec, 0xea, 0x97, 0xd2, 0x69, 0x0e, 0xd1, 0x3f, 0x83, 0xb5, 0x35, 0x3e,
+	0xcb, 0x8a, 0x2f, 0xeb, 0x09, 0x68, 0x97, 0x08, 0x93, 0xc7, 0xbd, 0xac, 0xa8, 0xf2, 0xdf, 0x1a,
+	0x3e, 0xb3, 0xce, 0x64, 0xfe, 0x86, 0xf2, 0xf0, 0x38, 0x5b, 0x4a, 0x23, 0x8c, 0x4d, 0x1b, 0x7a,
+	0xf9, 0x04, 0xc0, 0x68, 0x59, 0x09, 0x37, 0xe5, 0x7f, 0xa8, 0xdf, 0x06, 0x6a, 0xbf, 0xb2, 0xaf,
+	0xdc, 0xe9, 0x26, 0x33, 0x56, 0x1c, 0x5d, 0xea, 0xf7, 0x1b, 0x12, 0x4e, 0x2c, 0x02, 0x83, 0x2c,
+	0xcd, 0xf3, 0x5e, 0xce, 0xc2, 0x15, 0x18, 0x52, 0x35, 0x03, 0xb5, 0x3d, 0x6e, 0x83, 0x8a, 0xc2,
+	0xf8, 0x8b, 0x1d, 0x91, 0x1d, 0x75, 0xfa, 0x5b, 0x05, 0x2f, 0xbe, 0x1a, 0xdc, 0xdb, 0x3d, 0x8c,
+	0x0b, 0x69, 0xf0, 0x5f, 0x41, 0x6f, 0x78, 0x30, 0xaa, 0xed, 0x8c, 0xde, 0x05, 0xeb, 0x5c, 0xe2,
+	0x56, 0x0e, 0xe4, 0x04, 0x32, 0x3f, 0x93, 0xa3, 0x1a, 0xae, 0xd5, 0x2e, 0xb0, 0x7e, 0x34, 0xab,
+	0x39, 0x35, 0xff, 0x83, 0xa5, 0x1c, 0x91, 0x88, 0x1c, 0xd0, 0xce, 0xe6, 0x88, 0xb3, 0xcb, 0x58,
+	0x32, 0x27, 0x3a, 0xa4, 0x15, 0x4d, 0xcf, 0xb5, 0xbf, 0x41, 0xd0, 0x85, 0x1c, 0xfa, 0x4e, 0xb3,
+	0x79, 0x47, 0x72, 0x64, 0x01, 0x38, 0x72, 0x9f, 0x5d, 0xd8, 0x74, 0x7a, 0xc3, 0xb5, 0x3a, 0xbb,
+	0x94, 0xe5, 0x60, 0x7c, 0x31, 0x7e, 0x9e, 0x45, 0x81, 0xbd, 0x97, 0xbf, 0xb9, 0xc4, 0x35, 0x40,
+	0xa6, 0xb3, 0xf2, 0x86, 0xf4, 0xab, 0x2e, 0x75, 0x08, 0xba, 0x1d, 0x27, 0x80, 0xd9, 0x20, 0xdf,
+	0x42, 0xf5, 0x17, 0xfe, 0xd7, 0x93, 0x39, 0x29, 0xcc, 0x0f, 0x6d, 0x86, 0x0a, 0x19, 0xc4, 0xec,
+	0xfd, 0x48, 0x50, 0x6a, 0xd9, 0x87, 0x85, 0x55, 0x46, 0x95, 0x13, 0x02, 0x7d, 0x2f, 0xb2, 0xea,
+	0xe0, 0x34, 0x83, 0xaf, 0xed, 0xa4, 0x03, 0x1a, 0x75, 0xf5, 0x60, 0x17, 0xd3, 0x9f, 0x7c, 0xc3,
+	0x03, 0x6f, 0xb3, 0x26, 0x1c, 0xd7, 0x13, 0x83, 0x19, 0x40, 0xa0, 0x81, 0x52, 0x75, 0x33, 0xa1,
+	0x0f, 0xb8, 0xba, 0x35, 0xeb, 0x9d, 0xd6, 0x12, 0x00, 0x35, 0xa8, 0x33, 0xbd, 0xcd, 0x5b, 0x28,
+	0x48, 0xe0, 0xdb, 0xdc, 0xb6, 0x52, 0x08, 0xcc, 0x7e, 0x3d, 0x40, 0xb0, 0x3f, 0x32, 0xfe, 0x29,
+	0x5e, 0xf5, 0xb9, 0x80, 0xcc, 0x0f, 0x64, 0x0d, 0x55, 0xea, 0xc4, 0x81, 0xab, 0xdf, 0x09, 0xaf,
+	0x53, 0x95, 0x84, 0xfb, 0x5e, 0x59, 0x48, 0x5a, 0xcc, 0x15, 0xea, 0x21, 0xe9, 0x9d, 0x83, 0x42,
+	0x14, 0x06, 0x9e, 0x95, 0x15, 0xee, 0xd2, 0x23, 0x5f, 0x06, 0x53, 0x97, 0xcf, 0x35, 0x13, 0x0d,
+	0x70, 0xae, 0x5d, 0x0a, 0x45, 0x5b, 0x10, 0x60, 0x7e, 0x46, 0xa4, 0x23, 0x2d, 0xe5, 0x3d, 0x0f,
+	0xbc, 0x6c, 0x9e, 0x92, 0x5c, 0xe7, 0x45, 0x64, 0xf3, 0x4e, 0x85, 0x3e, 0xe9, 0x66, 0xff, 0x56,
+	0x54, 0x48, 0x56, 0x74, 0x8c, 0x4d, 0x49, 0x4f, 0xc7, 0xe6, 0xce, 0x2e, 0xc1, 0x80, 0xbe, 0x0b,
+	0x17, 0x16, 0xe9, 0x50, 0x31, 0xa0, 0x05, 0xcf, 0x8e, 0x08, 0x93, 0x6c, 0xeb, 0x57, 0x47, 0x61,
+	0x8f, 0xd1, 0x5c, 0x26, 0x95, 0x4e, 0xca, 0x7b, 0xab, 0x0f, 0x38, 0x5f, 0xe8, 0x66, 0x33, 0x8f,
+	0x93, 0xff, 0xfd, 0x92, 0x00, 0x75, 0xad, 0x01, 0x6d, 0x8d, 0xc2, 0x1c, 0xcb, 0x10, 0x9a, 0x05,
+	0x25, 0x7e, 0xeb, 0x4c, 0x60, 0x29, 0x51, 0x2b, 0x19, 0x39, 0x55, 0x8a, 0x43, 0xa6, 0xef, 0x1a,
+	0xfc, 0x01, 0xef, 0x57, 0x91, 0x7c, 0xb5, 0x34, 0x25, 0x66, 0x3b, 0x32, 0x9a, 0x63, 0xb2, 0x94,
+	0xd9, 0x3b, 0xfc, 0xb0, 0xc4, 0x27, 0x94, 0x99, 0xb1, 0x21, 0x85, 0xe6, 0xbf, 0xc9, 0x4d, 0xb0,
+	0x02, 0x49, 0xc7, 0x49, 0x03, 0xab, 0xaa, 0x78, 0x6c, 0x8c, 0x1f, 0x3a, 0x17, 0xfe, 0xbf, 0xe2,
+	0x44, 0x7f, 0x0a, 0xff, 0xfd, 0x96, 0xd8, 0xdd, 0xf5, 0xa7, 0x80, 0xde, 0x27, 0x2e, 0xa5, 0x33,
+	0x5f, 0xc6, 0xfe, 0x07, 0xd5, 0xc7, 0xd4, 0x98, 0x0a, 0x11, 0xd9, 0x54, 0xd2, 0xc3, 0xe8, 0x2c,
+	0x85, 0x5b, 0x5c, 0x99, 0x76, 0x55, 0x9f, 0x97, 0xe6, 0x13, 0x3c, 0xfc, 0xe6, 0x8f, 0xd5, 0x99,
+	0x17, 0xdb, 0x71, 0x0a, 0xb2, 0x98, 0x3c, 0x18, 0xed, 0x09, 0x68, 0xe0, 0x31, 0xc2, 0x0e, 0xc3,
+	0xa8, 0x05, 0x38, 0x15, 0x8c, 0xf7, 0x95, 0x97, 0x0c, 0x7e, 0x41, 0x3c, 0x81, 0x47, 0x19, 0x17,
+	0x09, 0xac, 0x17, 0x9b, 0xc4, 0x18, 0xc1, 0x9f, 0x07, 0x55, 0xd1, 0x69, 0x19, 0xb4, 0xf8, 0x4c,
+	0x6e, 0x33, 0xd6, 0xd9, 0x39, 0x0e, 0xca, 0x76, 0x95, 0xd9, 0xe6, 0xd0, 0xc3, 0x00, 0x2a, 0xed,
+	0x2a, 0x22, 0xc3, 0x14, 0x5b, 0x5a, 0xaf, 0xc2, 0xbf, 0x4a, 0x12, 0xd5, 0xd2, 0xaa, 0x6c, 0xa9,
+	0x1b, 0xd1, 0xea, 0x60, 0xd9, 0x29, 0xa2, 0x1f, 0x9e, 0x2f, 0xff, 0x8d, 0xac, 0x23, 0x2b, 0xc9,
+	0xcf, 0x21, 0x2d, 0x30, 0x7b, 0x7b, 0xff, 0x50, 0x44, 0xb3, 0x13, 0xfe, 0xcc, 0xd2, 0x13, 0xad,
+	0xbc, 0x98, 0x61, 0xef, 0x0a, 0x82, 0xac, 0xc9, 0xad, 0xe1, 0x2c, 0x4c, 0x9f, 0x7d, 0x93, 0x18,
+	0x82, 0xa4, 0xd1, 0x52, 0x8d, 0xdd, 0x24, 0xef, 0x11, 0x8d, 0x97, 0x0b, 0x3c, 0x24, 0x53, 0xff,
+	0xd8, 0x2c, 0x57, 0x44, 0x4e, 0x28, 0xac, 0xbf, 0x42, 0xac, 0x6c, 0x9a, 0x39, 0xff, 0x85, 0xf2,
+	0xb9, 0x82, 0x64, 0xb5, 0x76, 0x8e, 0x8d, 0xfc, 0x21, 0xf8, 0x44, 0xee, 0x91, 0x59, 0x46, 0x53,
+	0xed, 0xc5, 0xe9, 0x0a, 0xad, 0xe1, 0xbd, 0x5b, 0xce, 0x6a, 0xc8, 0x60, 0x61, 0x45, 0x5f, 0xfc,
+	0xb1, 0xe2, 0x74, 0x62, 0x70, 0x64, 0xec, 0xd5, 0x95, 0x45, 0xc1, 0xe2, 0xeb, 0xf0, 0xd6, 0xfc,
+	0x9b, 0xa4, 0x31, 0x37, 0x01, 0x4b, 0x2d, 0xfa, 0x29, 0x61, 0x62, 0x74, 0x42, 0x7f, 0x74, 0xf6,
+	0xf9, 0x71, 0x00, 0x1c, 0x9b, 0x63, 0x47, 0x94, 0x01, 0x08, 0x13, 0xf6, 0x95, 0x8b, 0x0e, 0xf8,
+	0x77, 0xf5, 0x73, 0xb4, 0xa2, 0x81, 0x3a, 0x6b, 0x9c, 0xca, 0x6e, 0xa7, 0x70, 0x44, 0x46, 0x29,
+	0xe7, 0x94, 0xec, 0x0a, 0x29, 0x97, 0x3c, 0x48, 0x03, 0x3f, 0xc8, 0x83, 0x37, 0xe0, 0x0f, 0xc5,
+	0x60, 0xb0, 0x0b, 0x00, 0x9c, 0xad, 0x49, 0x18, 0x70, 0x0b, 0xe0, 0x3f, 0x6a, 0x06, 0x65, 0x5a,
+	0x0a, 0x22, 0xfd, 0x69, 0xd7, 0x07, 0xde, 0x94, 0x4d, 0xcb, 0x46, 0x04, 0x6d, 0x30, 0x49, 0xc6,
+	0xc5, 0x67, 0x46, 0x01, 0x6e, 0xa5, 0x10, 0x7a, 0x46, 0x8b, 0xc4, 0x69, 0x5d, 0xa7, 0x83, 0xe2,
+	0x9b, 0x90, 0x96, 0x0d, 0x60, 0x09, 0xc3, 0xc7, 0x05, 0x6a, 0xc4, 0x20, 0xc3, 0x93, 0x6e, 0xbe,
+	0x3f, 0xba, 0xfc, 0x70, 0xae, 0xa0, 0xbd, 0x52, 0xe7, 0x14, 0x2b, 0xc1, 0x18, 0xa3, 0x2d, 0x7f,
+	0xcb, 0xfa, 0x20, 0x88, 0x3b, 0x0a, 0xcc, 0x31, 0x4c, 0xd0, 0x8b, 0x16, 0xa4, 0xd5, 0x0a, 0x05,
+	0x0b, 0x57, 0x23, 0x3a, 0xe2, 0xac, 0xc4, 0x05, 0x38, 0x6b, 0x6f, 0x3e, 0xf3, 0xf3, 0xde, 0x0c,
+	0x57, 0x72, 0xa1, 0xab, 0x80, 0x3c, 0x42, 0x91, 0x57, 0x65, 0x14, 0xe4, 0x41, 0x74, 0xc9, 0xe6,
+	0xd3, 0x7a, 0x0c, 0x16, 0x44, 0x83, 0x49, 0x75, 0xd8, 0x85, 0xba, 0x5c, 0x3c, 0x34, 0x4e, 0x26,
+	0xd3, 0xa1, 0xb2, 0x12, 0xc7, 0x17, 0x76, 0x5b, 0xd1, 0xff, 0xdf, 0x1f, 0x6c, 0x50, 0x73, 0xba,
+	0xd7, 0x76, 0x92, 0xee, 0x07, 0xf1, 0x2d, 0x28, 0x68, 0xb6, 0xa8, 0x83, 0x88, 0xec, 0x1c, 0xb3,
+	0xc5, 0x60, 0x30, 0x49, 0x28, 0x71, 0x9c, 0x10, 0x4a, 0x41, 0xfa, 0xb4, 0xb5, 0x0b, 0x26, 0x54,
+	0xf7, 0x5f, 0x8a, 0x88, 0x90, 0x5e, 0x84, 0xb3, 0xd3, 0x11, 0x7c, 0xd3, 0xa5, 0xb7, 0x1b, 0x3e,
+	0xcf, 0xfb, 0x12, 0x89, 0x3d, 0xf8, 0xd9, 0x4f, 0x76, 0x58, 0x62, 0xd7, 0xb1, 0xe8, 0x33, 0x8b,
+	0xb8, 0x13, 0x2b, 0x06, 0xa4, 0x51, 0xaa, 0x8e, 0x09, 0x48, 0xd6, 0x20, 0x44, 0x48, 0x07, 0xd9,
+	0x69, 0x85, 0x15, 0x73, 0x07, 0xd1, 0x53, 0x96, 0x25, 0xdc, 0x53, 0x20, 0x1d, 0x4a, 0x2d, 0x28,
+	0xf4, 0x92, 0x9e, 0xea, 0x4c, 0x5b, 0x55, 0x08, 0x41, 0x76, 0x89, 0xb2, 0x79, 0x6b, 0xec, 0x28,
+	0xaa, 0x2c, 0x33, 0x5f, 0xae, 0x86, 0x8b, 0x1c, 0xc9, 0xab, 0x9b, 0x7e, 0xf0, 0x68, 0xe2, 0x46,
+	0x3b, 0xbc, 0x3e, 0x57, 0xa3, 0x65, 0x13, 0x35, 0xc4, 0xab, 0x61, 0x04, 0xbf, 0xcb, 0x93, 0xa2,
+	0x84, 0x13, 0x7b, 0xcd, 0x2c, 0x62, 0x49, 0x48, 0x5e, 0x0d, 0x39, 0x91, 0xa1, 0x0d, 0x51, 0x9c,
+	0x49, 0x10, 0x89, 0xaf, 0xbd, 0xaf, 0x07, 0x45, 0xf2, 0x45, 0xe4, 0x39, 0x4b, 0xfb, 0x06, 0x99,
+	0x02, 0xce, 0xe0, 0xf6, 0x60, 0xdc, 0xd6, 0xa8, 0x31, 0x54, 0x86, 0x90, 0x48, 0x2a, 0xca, 0x85,
+	0x91, 0x43, 0x7e, 0xb4, 0x51, 0x70, 0x7b, 0x8f, 0xe2, 0x17, 0x56, 0x47, 0x8d, 0xdb, 0xae, 0xd4,
+	0x9b, 0x5f, 0xa1, 0xce, 0xcc, 0x54, 0xd7, 0x95, 0x50, 0xb1, 0x47, 0xa2, 0xd2, 0xd3, 0xc2, 0x77,
+	0xd9, 0x3b, 0x18, 0xd9, 0xa5, 0x33, 0x52, 0x68, 0x36, 0x6f, 0x8a, 0xec, 0xfb, 0xda, 0x4a, 0xb8,
+	0xd7, 0x10, 0xcc, 0x77, 0x60, 0xa6, 0x51, 0x29, 0xee, 0xa7, 0x99, 0x58, 0xfc, 0x82, 0xf7, 0x6f,
+	0xb7, 0xbc, 0x8f, 0x01, 0xfb, 0xba, 0x1c, 0x62, 0xfa, 0xa6, 0xe4, 0x9c, 0x53, 0x4f, 0x63, 0x17,
+	0xbc, 0x35, 0x4d, 0x0f, 0x38, 0xe7, 0x26, 0xfc, 0xb9, 0xcd, 0x91, 0x1f, 0x4c, 0x87, 0x5a, 0xfd,
+	0x8e, 0x2f, 0x64, 0x50, 0x97, 0x72, 0x9d, 0xed, 0x00, 0x0f, 0x7f, 0x74, 0x3a, 0xd6, 0x1a, 0x73,
+	0xf9, 0xe1, 0x24, 0xd1, 0x83, 0x0d, 0xc9, 0x6d, 0x91, 0x18, 0x75, 0xc5, 0xfe, 0xf8, 0x90, 0x1e,
+	0xa2, 0xfd, 0x40, 0xb2, 0xcd, 0xdf, 0xf6, 0xcf, 0x58, 0x77, 0x87, 0x38, 0xef, 0x58, 0x96, 0xb7,
+	0x1b, 0xe3, 0x92, 0x5f, 0x9c, 0xf3, 0x04, 0x2f, 0xf9, 0xf9, 0x67, 0x1c, 0xa7, 0x4f, 0x21, 0x87,
+	0xe6, 0x03, 0xc7, 0x2c, 0xb5, 0xaa, 0x18, 0x4b, 0x2f, 0x53, 0x3b, 0x00, 0x6c, 0x1c, 0x0c, 0x76,
+	0xd2, 0xda, 0x49, 0x18, 0xac, 0x04, 0x9d, 0xae, 0x35, 0xaf, 0x62, 0x4c, 0xb4, 0x96, 0x68, 0x7b,
+	0x09, 0x5f, 0x9e, 0xac, 0x38, 0x66, 0xe0, 0x09, 0x68, 0xdb, 0x8f, 0x8e, 0xf2, 0x43, 0x0c, 0x51,
+	0xea, 0x5e, 0xf8, 0x74, 0x84, 0xcd, 0xdc, 0xa7, 0x42, 0xb3, 0xc9, 0xcb, 0x36, 0x38, 0x05, 0xa3,
+	0x78, 0x16, 0x4b, 0xed, 0x33, 0xcd, 0x1a, 0xba, 0x8e, 0x11, 0xb2, 0x60, 0xbf, 0x98, 0xf3, 0xf6,
+	0xc5, 0xaf, 0x84, 0x7b, 0x29, 0xde, 0x16, 0xf0, 0x33, 0xbd, 0x18, 0x40, 0x34, 0x30, 0xae, 0xfe,
+	0xcd, 0x68, 0x7f, 0xfa, 0xa4, 0x39, 0xe0, 0x90, 0x0e, 0x10, 0x0d, 0xc6, 0xc1, 0x74, 0xcb, 0x85,
+	0x22, 0xe4, 0xe3, 0xb1, 0x96, 0xad, 0xaa, 0xf1, 0x1e, 0x5a, 0xcd, 0xc4, 0x0c, 0x7c, 0x43, 0x9a,
+	0xfb, 0xe3, 0xf0, 0xa5, 0x3f, 0xa7, 0xaa, 0x01, 0x00, 0x00,
+};
+
+const X_UI_WEBP_image_t X_UI_WEBP_images[X_UI_WEBP_IMAGES] = {
+	{ "lossless opaque", lossless_opaque, sizeof(lossless_opaque), false, true },
+	{ "lossless alpha", lossless_alpha, sizeof(lossless_alpha), true, true },
+	{ "lossy opaque", lossy_opaque, sizeof(lossy_opaque), false, false },
+	{ "lossy alpha", lossy_alpha, sizeof(lossy_alpha), true, false },
+};
+
+const X_UI_WEBP_image_t X_UI_WEBP_screen_images[X_UI_WEBP_SCREEN_IMAGES] = {
+	{ "screen lossless", screen_lossless, sizeof(screen_lossless), false, true },
+	{ "screen lossy", screen_lossy, sizeof(screen_lossy), false, false },
+};
+
+uint32_t X_UI_WEBP_pixel(uint32_t x, uint32_t y, bool alpha)
+{
+	uint32_t r = (x * 15U) & 0xffU;
+	uint32_t g = (y * 28U) & 0xffU;
+	uint32_t b = (x * y * 7U) & 0xffU;
+	uint32_t a = (!alpha || (x < 4U)) ? 0xffU : (((x * 16U) + (y * 8U)) & 0xffU);
+	return (a << 24) | (r << 16) | (g << 8) | b;
+}